@@ -64,6 +64,10 @@ public final class AudioConfig extends RtpConfig {
     private byte mDtmfTxPayloadTypeNumber;
     private byte mDtmfRxPayloadTypeNumber;
     private byte dtmfSamplingRateKHz;
+    private byte redPayloadTypeNumber;
+    private byte redundancyLevel;
+    private byte redundancyDistance;
+    private byte playoutDelayPercentile;
     @Nullable
     private AmrParams amrParams;
     @Nullable
@@ -79,6 +83,10 @@ public final class AudioConfig extends RtpConfig {
         mDtmfTxPayloadTypeNumber = in.readByte();
         mDtmfRxPayloadTypeNumber = in.readByte();
         dtmfSamplingRateKHz = in.readByte();
+        redPayloadTypeNumber = in.readByte();
+        redundancyLevel = in.readByte();
+        redundancyDistance = in.readByte();
+        playoutDelayPercentile = in.readByte();
         amrParams = in.readParcelable(AmrParams.class.getClassLoader(), AmrParams.class);
         evsParams = in.readParcelable(EvsParams.class.getClassLoader(), EvsParams.class);
     }
@@ -93,6 +101,10 @@ public final class AudioConfig extends RtpConfig {
         this.mDtmfTxPayloadTypeNumber = builder.mDtmfTxPayloadTypeNumber;
         this.mDtmfRxPayloadTypeNumber = builder.mDtmfRxPayloadTypeNumber;
         this.dtmfSamplingRateKHz = builder.dtmfSamplingRateKHz;
+        this.redPayloadTypeNumber = builder.redPayloadTypeNumber;
+        this.redundancyLevel = builder.redundancyLevel;
+        this.redundancyDistance = builder.redundancyDistance;
+        this.playoutDelayPercentile = builder.playoutDelayPercentile;
         this.amrParams = builder.amrParams;
         this.evsParams = builder.evsParams;
     }
@@ -167,6 +179,26 @@ public final class AudioConfig extends RtpConfig {
         this.dtmfSamplingRateKHz = dtmfSamplingRateKHz;
     }
 
+    /** @hide **/
+    public byte getRedPayloadTypeNumber() {
+        return redPayloadTypeNumber;
+    }
+
+    /** @hide **/
+    public byte getRedundancyLevel() {
+        return redundancyLevel;
+    }
+
+    /** @hide **/
+    public byte getRedundancyDistance() {
+        return redundancyDistance;
+    }
+
+    /** @hide **/
+    public byte getPlayoutDelayPercentile() {
+        return playoutDelayPercentile;
+    }
+
     /** @hide **/
     public AmrParams getAmrParams() {
         return amrParams;
@@ -187,6 +219,10 @@ public final class AudioConfig extends RtpConfig {
                 + ", mDtmfTxPayloadTypeNumber=" + mDtmfTxPayloadTypeNumber
                 + ", mDtmfRxPayloadTypeNumber=" + mDtmfRxPayloadTypeNumber
                 + ", dtmfSamplingRateKHz=" + dtmfSamplingRateKHz
+                + ", redPayloadTypeNumber=" + redPayloadTypeNumber
+                + ", redundancyLevel=" + redundancyLevel
+                + ", redundancyDistance=" + redundancyDistance
+                + ", playoutDelayPercentile=" + playoutDelayPercentile
                 + ", amrParams=" + amrParams
                 + ", evsParams=" + evsParams
                 + " }";
@@ -196,7 +232,9 @@ public final class AudioConfig extends RtpConfig {
     public int hashCode() {
         return Objects.hash(super.hashCode(), pTimeMillis, maxPtimeMillis,
                 dtxEnabled, codecType, mDtmfTxPayloadTypeNumber,
-                mDtmfRxPayloadTypeNumber, dtmfSamplingRateKHz, amrParams, evsParams);
+                mDtmfRxPayloadTypeNumber, dtmfSamplingRateKHz, redPayloadTypeNumber,
+                redundancyLevel, redundancyDistance, playoutDelayPercentile, amrParams,
+                evsParams);
     }
 
     @Override
@@ -222,6 +260,10 @@ public final class AudioConfig extends RtpConfig {
                 && mDtmfTxPayloadTypeNumber == s.mDtmfTxPayloadTypeNumber
                 && mDtmfRxPayloadTypeNumber == s.mDtmfRxPayloadTypeNumber
                 && dtmfSamplingRateKHz == s.dtmfSamplingRateKHz
+                && redPayloadTypeNumber == s.redPayloadTypeNumber
+                && redundancyLevel == s.redundancyLevel
+                && redundancyDistance == s.redundancyDistance
+                && playoutDelayPercentile == s.playoutDelayPercentile
                 && Objects.equals(amrParams, s.amrParams)
                 && Objects.equals(evsParams, s.evsParams));
     }
@@ -245,6 +287,10 @@ public final class AudioConfig extends RtpConfig {
         dest.writeByte(mDtmfTxPayloadTypeNumber);
         dest.writeByte(mDtmfRxPayloadTypeNumber);
         dest.writeByte(dtmfSamplingRateKHz);
+        dest.writeByte(redPayloadTypeNumber);
+        dest.writeByte(redundancyLevel);
+        dest.writeByte(redundancyDistance);
+        dest.writeByte(playoutDelayPercentile);
         dest.writeParcelable(amrParams, 0);
         dest.writeParcelable(evsParams, 0);
     }
@@ -273,6 +319,10 @@ public final class AudioConfig extends RtpConfig {
         private byte mDtmfTxPayloadTypeNumber;
         private byte mDtmfRxPayloadTypeNumber;
         private byte dtmfSamplingRateKHz;
+    private byte redPayloadTypeNumber;
+    private byte redundancyLevel;
+    private byte redundancyDistance;
+    private byte playoutDelayPercentile;
         @Nullable
         private AmrParams amrParams;
         @Nullable
@@ -372,6 +422,55 @@ public final class AudioConfig extends RtpConfig {
             return this;
         }
 
+        /**
+         * Set the dynamic payload type number of the redundant audio data packets, see RFC 2198.
+         * The redundancy is not used when it is not set.
+         *
+         * @param redPayloadTypeNumber Payload type number for the redundant audio packets
+         * @return The same instance of the builder
+         */
+        public Builder setRedPayloadTypeNumber(final byte redPayloadTypeNumber) {
+            this.redPayloadTypeNumber = redPayloadTypeNumber;
+            return this;
+        }
+
+        /**
+         * Set the number of the previous payloads carried as the redundant blocks in each packet
+         *
+         * @param redundancyLevel Number of the redundant blocks
+         * @return The same instance of the builder
+         */
+        public Builder setRedundancyLevel(final byte redundancyLevel) {
+            this.redundancyLevel = redundancyLevel;
+            return this;
+        }
+
+        /**
+         * Set the distance in packets between the primary payload and the nearest redundant
+         * payload
+         *
+         * @param redundancyDistance Distance of the redundant payload in packets
+         * @return The same instance of the builder
+         */
+        public Builder setRedundancyDistance(final byte redundancyDistance) {
+            this.redundancyDistance = redundancyDistance;
+            return this;
+        }
+
+        /**
+         * Set the percentile of the packet delay covered by the playout delay of the jitter
+         * buffer. The jitter buffer is sized by the mean and the deviation of the jitter when it
+         * is not set.
+         *
+         * @param playoutDelayPercentile Percentile of the packet delay, 97 for the late loss of
+         *        3 percent
+         * @return The same instance of the builder
+         */
+        public Builder setPlayoutDelayPercentile(final byte playoutDelayPercentile) {
+            this.playoutDelayPercentile = playoutDelayPercentile;
+            return this;
+        }
+
         /**
          * Set the AMR codec parameters, see {@link AmrParams}
          *
@@ -102,21 +102,38 @@ public final class RtcpConfig implements Parcelable {
     /** Bitmask of RTCP-XR blocks to be enabled */
     private final @RtcpXrBlockType int rtcpXrBlockTypes;
 
+    /**
+     * Whether RTP and RTCP are multiplexed on the RTP port as specified in
+     * RFC 5761
+     */
+    private final boolean rtcpMuxEnabled;
+
+    /**
+     * Whether the reduced-size RTCP is negotiated as specified in RFC 5506,
+     * the feedback messages are sent without SR, RR and SDES
+     */
+    private final boolean rtcpReducedSizeEnabled;
+
     /** @hide **/
     private RtcpConfig(Parcel in) {
         canonicalName = in.readString();
         transmitPort = in.readInt();
         intervalSec = in.readInt();
         rtcpXrBlockTypes = in.readInt();
+        rtcpMuxEnabled = in.readBoolean();
+        rtcpReducedSizeEnabled = in.readBoolean();
     }
 
     /** @hide **/
     private RtcpConfig(final String canonicalName, final int transmitPort, final int intervalSec,
-            final @RtcpXrBlockType int rtcpXrBlockTypes) {
+            final @RtcpXrBlockType int rtcpXrBlockTypes, final boolean rtcpMuxEnabled,
+            final boolean rtcpReducedSizeEnabled) {
         this.canonicalName = canonicalName;
         this.transmitPort = transmitPort;
         this.intervalSec = intervalSec;
         this.rtcpXrBlockTypes = rtcpXrBlockTypes;
+        this.rtcpMuxEnabled = rtcpMuxEnabled;
+        this.rtcpReducedSizeEnabled = rtcpReducedSizeEnabled;
     }
 
     /** @hide **/
@@ -139,6 +156,16 @@ public final class RtcpConfig implements Parcelable {
         return rtcpXrBlockTypes;
     }
 
+    /** @hide **/
+    public boolean getRtcpMuxEnabled() {
+        return rtcpMuxEnabled;
+    }
+
+    /** @hide **/
+    public boolean getRtcpReducedSizeEnabled() {
+        return rtcpReducedSizeEnabled;
+    }
+
     @NonNull
     @Override
     public String toString() {
@@ -146,12 +173,15 @@ public final class RtcpConfig implements Parcelable {
                 + ", transmitPort=" + transmitPort
                 + ", intervalSec=" + intervalSec
                 + ", rtcpXrBlockTypes=" + rtcpXrBlockTypes
+                + ", rtcpMuxEnabled=" + rtcpMuxEnabled
+                + ", rtcpReducedSizeEnabled=" + rtcpReducedSizeEnabled
                 + " }";
     }
 
     @Override
     public int hashCode() {
-        return Objects.hash(canonicalName, transmitPort, intervalSec, rtcpXrBlockTypes);
+        return Objects.hash(canonicalName, transmitPort, intervalSec, rtcpXrBlockTypes,
+                rtcpMuxEnabled, rtcpReducedSizeEnabled);
     }
 
     @Override
@@ -169,7 +199,9 @@ public final class RtcpConfig implements Parcelable {
         return (Objects.equals(canonicalName, s.canonicalName)
                 && transmitPort == s.transmitPort
                 && intervalSec == s.intervalSec
-                && rtcpXrBlockTypes == s.rtcpXrBlockTypes);
+                && rtcpXrBlockTypes == s.rtcpXrBlockTypes
+                && rtcpMuxEnabled == s.rtcpMuxEnabled
+                && rtcpReducedSizeEnabled == s.rtcpReducedSizeEnabled);
     }
 
     /**
@@ -187,6 +219,8 @@ public final class RtcpConfig implements Parcelable {
         dest.writeInt(transmitPort);
         dest.writeInt(intervalSec);
         dest.writeInt(rtcpXrBlockTypes);
+        dest.writeBoolean(rtcpMuxEnabled);
+        dest.writeBoolean(rtcpReducedSizeEnabled);
     }
 
     public static final @NonNull Parcelable.Creator<RtcpConfig>
@@ -210,6 +244,8 @@ public final class RtcpConfig implements Parcelable {
         private int transmitPort;
         private int intervalSec;
         private @RtcpXrBlockType int rtcpXrBlockTypes;
+        private boolean rtcpMuxEnabled;
+        private boolean rtcpReducedSizeEnabled;
 
         /**
          * Default constructor for Builder.
@@ -262,6 +298,29 @@ public final class RtcpConfig implements Parcelable {
             return this;
         }
 
+        /**
+         * Set whether RTP and RTCP are multiplexed on the RTP port, See RFC 5761.
+         *
+         * @param rtcpMuxEnabled {@code true} to send and receive RTCP on the RTP port.
+         * @return The same instance of the builder.
+         */
+        public @NonNull Builder setRtcpMuxEnabled(final boolean rtcpMuxEnabled) {
+            this.rtcpMuxEnabled = rtcpMuxEnabled;
+            return this;
+        }
+
+        /**
+         * Set whether the reduced-size RTCP is used, See RFC 5506.
+         *
+         * @param rtcpReducedSizeEnabled {@code true} to send the feedback messages without
+         *        SR, RR and SDES.
+         * @return The same instance of the builder.
+         */
+        public @NonNull Builder setRtcpReducedSizeEnabled(final boolean rtcpReducedSizeEnabled) {
+            this.rtcpReducedSizeEnabled = rtcpReducedSizeEnabled;
+            return this;
+        }
+
         /**
          * Build the RtcpConfig.
          *
@@ -269,7 +328,8 @@ public final class RtcpConfig implements Parcelable {
          */
         public @NonNull RtcpConfig build() {
             // TODO validation
-            return new RtcpConfig(canonicalName, transmitPort, intervalSec, rtcpXrBlockTypes);
+            return new RtcpConfig(canonicalName, transmitPort, intervalSec, rtcpXrBlockTypes,
+                    rtcpMuxEnabled, rtcpReducedSizeEnabled);
         }
     }
 }
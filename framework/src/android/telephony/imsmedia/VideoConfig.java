@@ -241,6 +241,11 @@ public final class VideoConfig extends RtpConfig {
     * value PT=PSFB and FMT=4. RFC 5104.
     */
     public static final int PSFB_FIR = 1 << 4;
+    /**
+     * The transport-wide congestion control feedback is identified by RTCP packet type
+     * value PT=RTPFB and FMT=15. draft-holmer-rmcat-transport-wide-cc-extensions-01.
+     */
+    public static final int RTPFB_TRANSPORT_CC = 1 << 5;
 
     /** @hide */
     @IntDef(
@@ -252,6 +257,7 @@ public final class VideoConfig extends RtpConfig {
             RTPFB_TMMBN,
             PSFB_PLI,
             PSFB_FIR,
+            RTPFB_TRANSPORT_CC,
         })
     @Retention(RetentionPolicy.SOURCE)
     public @interface RtcpFbTypes {}
@@ -274,6 +280,8 @@ public final class VideoConfig extends RtpConfig {
     private final int mCvoValue;
     private final int mMaxMtuBytes;
     private final @RtcpFbTypes int mRtcpFbTypes;
+    private final int mTransportSeqValue;
+    private final int mFecPayloadType;
 
     /** @hide */
     VideoConfig(Parcel in) {
@@ -295,6 +303,8 @@ public final class VideoConfig extends RtpConfig {
         mDeviceOrientationDegree = in.readInt();
         mCvoValue = in.readInt();
         mRtcpFbTypes = in.readInt();
+        mTransportSeqValue = in.readInt();
+        mFecPayloadType = in.readInt();
     }
 
     /** @hide */
@@ -317,6 +327,8 @@ public final class VideoConfig extends RtpConfig {
         mDeviceOrientationDegree = builder.mDeviceOrientationDegree;
         mCvoValue = builder.mCvoValue;
         mRtcpFbTypes = builder.mRtcpFbTypes;
+        mTransportSeqValue = builder.mTransportSeqValue;
+        mFecPayloadType = builder.mFecPayloadType;
     }
 
     /** @hide **/
@@ -399,6 +411,16 @@ public final class VideoConfig extends RtpConfig {
         return this.mRtcpFbTypes;
     }
 
+    /** @hide **/
+    public int getTransportSeqValue() {
+        return this.mTransportSeqValue;
+    }
+
+    /** @hide **/
+    public int getFecPayloadType() {
+        return this.mFecPayloadType;
+    }
+
     /** @hide **/
     public int getMaxMtuBytes() {
         return mMaxMtuBytes;
@@ -424,6 +446,8 @@ public final class VideoConfig extends RtpConfig {
             + ", mDeviceOrientationDegree=" + mDeviceOrientationDegree
             + ", mCvoValue=" + mCvoValue
             + ", rtcpFb=" + mRtcpFbTypes
+            + ", mTransportSeqValue=" + mTransportSeqValue
+            + ", mFecPayloadType=" + mFecPayloadType
             + " }";
     }
 
@@ -432,7 +456,8 @@ public final class VideoConfig extends RtpConfig {
         return Objects.hash(super.hashCode(), mVideoMode, mCodecType, mFramerate, mBitrate,
             mMaxMtuBytes, mCodecProfile, mCodecLevel, mIntraFrameIntervalSec,
             mPacketizationMode, mCameraId, mCameraZoom, mResolutionWidth, mResolutionHeight,
-            mPauseImagePath, mDeviceOrientationDegree, mCvoValue, mRtcpFbTypes);
+            mPauseImagePath, mDeviceOrientationDegree, mCvoValue, mRtcpFbTypes,
+            mTransportSeqValue, mFecPayloadType);
     }
 
     @Override
@@ -467,7 +492,9 @@ public final class VideoConfig extends RtpConfig {
             && Objects.equals(mPauseImagePath, s.mPauseImagePath)
             && mDeviceOrientationDegree == s.mDeviceOrientationDegree
             && mCvoValue == s.mCvoValue
-            && mRtcpFbTypes == s.mRtcpFbTypes);
+            && mRtcpFbTypes == s.mRtcpFbTypes
+            && mTransportSeqValue == s.mTransportSeqValue
+            && mFecPayloadType == s.mFecPayloadType);
     }
 
     /**
@@ -499,6 +526,8 @@ public final class VideoConfig extends RtpConfig {
         dest.writeInt(mDeviceOrientationDegree);
         dest.writeInt(mCvoValue);
         dest.writeInt(mRtcpFbTypes);
+        dest.writeInt(mTransportSeqValue);
+        dest.writeInt(mFecPayloadType);
     }
 
     public static final @NonNull Parcelable.Creator<VideoConfig>
@@ -536,6 +565,8 @@ public final class VideoConfig extends RtpConfig {
         private int mDeviceOrientationDegree;
         private int mCvoValue;
         private int mRtcpFbTypes;
+        private int mTransportSeqValue;
+        private int mFecPayloadType;
 
         /**
          * Default constructor for Builder.
@@ -705,6 +736,31 @@ public final class VideoConfig extends RtpConfig {
             return this;
         }
 
+        /**
+         * Sets a value to identify the transport wide sequence number RTP header extension id
+         * defined by the SDP negotiation. When the value is greater than 0, MediaStack sends the
+         * extension in every RTP packet, and sends the transport feedback back when
+         * {@link #RTPFB_TRANSPORT_CC} is set in the RTCP feedback types.
+         * @param transportSeqValue It is the local identifier of extension. valid range is 1-14.
+         */
+        public Builder setTransportSeqValue(final int transportSeqValue) {
+            this.mTransportSeqValue = transportSeqValue;
+            return this;
+        }
+
+        /**
+         * Sets the RTP payload type of the forward error correction packets defined by the SDP
+         * negotiation. When the value is greater than 0, MediaStack sends the XOR parity packets
+         * of RFC 5109 with the payload type to protect the video RTP packets, and recovers the
+         * lost video RTP packets from the received parity packets. The parity packets use the SSRC
+         * and the port of the video stream, so the peer has to be another MediaStack.
+         * @param fecPayloadType The dynamic payload type, valid range is 96-127.
+         */
+        public Builder setFecPayloadType(final int fecPayloadType) {
+            this.mFecPayloadType = fecPayloadType;
+            return this;
+        }
+
         /**
          * Build the VideoConfig.
          *
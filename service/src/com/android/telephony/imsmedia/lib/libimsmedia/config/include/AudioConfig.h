@@ -78,6 +78,14 @@ public:
     int8_t getRxDtmfPayloadTypeNumber();
     void setDtmfsamplingRateKHz(const int8_t sampling);
     int8_t getDtmfsamplingRateKHz();
+    void setRedPayloadTypeNumber(const int8_t num);
+    int8_t getRedPayloadTypeNumber();
+    void setRedundancyLevel(const int8_t level);
+    int8_t getRedundancyLevel();
+    void setRedundancyDistance(const int8_t distance);
+    int8_t getRedundancyDistance();
+    void setPlayoutDelayPercentile(const int8_t percentile);
+    int8_t getPlayoutDelayPercentile();
     void setAmrParams(const AmrParams& param);
     AmrParams getAmrParams();
     void setEvsParams(const EvsParams& param);
@@ -119,6 +127,25 @@ protected:
      * @brief Sampling rate for DTMF tone in kHz
      */
     int8_t dtmfsamplingRateKHz;
+    /**
+     * @brief Dynamic payload type number of the redundant audio data packets of RFC 2198,
+     * 0 when the redundancy is not negotiated
+     */
+    int8_t redPayloadTypeNumber;
+    /**
+     * @brief Number of the previous payloads carried as the redundant blocks in each packet
+     */
+    int8_t redundancyLevel;
+    /**
+     * @brief Distance in packets between the primary payload and the nearest redundant
+     * payload. The distance larger than 1 protects against the longer burst of loss.
+     */
+    int8_t redundancyDistance;
+    /**
+     * @brief Percentile of the packet delay covered by the playout delay of the jitter buffer,
+     * 0 to size the jitter buffer by the mean and the deviation of the jitter
+     */
+    int8_t playoutDelayPercentile;
     /**
      * @brief Negotiated AMR codec parameters
      */
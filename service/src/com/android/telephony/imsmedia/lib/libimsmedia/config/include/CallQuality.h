@@ -132,6 +132,8 @@ public:
     void setNumRtpSidPacketsReceived(const int32_t num);
     int32_t getNumRtpDuplicatePackets();
     void setNumRtpDuplicatePackets(const int32_t num);
+    int32_t getNumHeaderBytesSaved();
+    void setNumHeaderBytesSaved(const int32_t num);
 
 private:
     /** The Downlink call quality level measured in 5 sec monitoring*/
@@ -180,6 +182,10 @@ private:
     int32_t mNumRtpSidPacketsReceived;
     /** The total number of RTP duplicate packets received by this device for an ongoing call. */
     int32_t mNumRtpDuplicatePackets;
+    /** The number of IP/UDP/RTP header bytes saved by sending multiple frames in a RTP packet
+     * instead of one frame per packet. It is not carried in the parcel as
+     * android.telephony.CallQuality does not have the matching field. */
+    int32_t mNumHeaderBytesSaved;
 };
 
 }  // namespace imsmedia
@@ -87,6 +87,8 @@ public:
     const int32_t kTransmitPort = 0;
     const int32_t kIntervalSec = 0;
     const int32_t kRtcpXrBlockTypes = FLAG_RTCPXR_NONE;
+    const bool kRtcpMuxEnabled = false;
+    const bool kRtcpReducedSizeEnabled = false;
 
     RtcpConfig();
     RtcpConfig(const RtcpConfig& config);
@@ -104,6 +106,10 @@ public:
     int32_t getIntervalSec();
     void setRtcpXrBlockTypes(const int32_t type);
     int32_t getRtcpXrBlockTypes();
+    void setRtcpMuxEnabled(const bool enable);
+    bool getRtcpMuxEnabled();
+    void setRtcpReducedSizeEnabled(const bool enable);
+    bool getRtcpReducedSizeEnabled();
     void setDefaultRtcpConfig();
 
 private:
@@ -121,6 +127,18 @@ private:
 
     /** Bitmask of RTCP-XR blocks to enable as in RtcpXrReportBlockType */
     int32_t rtcpXrBlockTypes;
+
+    /**
+     * Whether RTP and RTCP are multiplexed on the RTP port as in RFC 5761. The RTCP packets are
+     * sent to and received from the RTP port instead of the port next to it.
+     */
+    bool rtcpMuxEnabled;
+
+    /**
+     * Whether the reduced-size RTCP is negotiated as in RFC 5506. The feedback messages are sent
+     * without SR, RR and SDES following the early feedback rules of RFC 4585.
+     */
+    bool rtcpReducedSizeEnabled;
 };
 
 }  // namespace imsmedia
@@ -76,6 +76,8 @@ public:
     int32_t getRemotePort();
     void setRtcpConfig(const RtcpConfig& config);
     RtcpConfig getRtcpConfig();
+    /** The peer port of RTCP, the RTP port when rtcp-mux is enabled and the next port otherwise */
+    int32_t getRemoteRtcpPort();
     void setDscp(const int8_t dscp);
     int8_t getDscp();
     void setRxPayloadTypeNumber(const int8_t num);
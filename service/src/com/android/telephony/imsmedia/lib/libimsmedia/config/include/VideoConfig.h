@@ -171,6 +171,11 @@ public:
          * value PT=PSFB and FMT=4. RFC 5104.
          */
         PSFB_FIR = 1 << 4,
+        /**
+         * The transport-wide congestion control feedback is identified by RTCP packet type
+         * value PT=RTPFB and FMT=15. draft-holmer-rmcat-transport-wide-cc-extensions-01.
+         */
+        RTP_FB_TRANSPORT_CC = 1 << 5,
     };
 
     VideoConfig();
@@ -216,6 +221,10 @@ public:
     int32_t getCvoValue();
     void setRtcpFbType(const int32_t types);
     int32_t getRtcpFbType();
+    void setTransportSeqValue(const int32_t value);
+    int32_t getTransportSeqValue();
+    void setFecPayloadType(const int32_t type);
+    int32_t getFecPayloadType();
 
 protected:
     /* Sets video mode. */
@@ -257,6 +266,15 @@ protected:
     int32_t cvoValue;
     /* The RTPFB, PSFB configuration with RTCP Protocol */
     int32_t rtcpFbTypes;
+    /* The local identifier of the transport wide sequence number RTP header extension negotiated
+     * by the SDP. The extension is sent in every RTP packet when the value is greater than 0, and
+     * the transport feedback is sent back when RTP_FB_TRANSPORT_CC is also set. */
+    int32_t transportSeqValue;
+    /* The RTP payload type of the XOR parity packets of RFC 5109 negotiated by the SDP. The video
+     * RTP packets are protected by the forward error correction when the value is greater than 0.
+     * The parity packets share the ssrc and the port of the video stream, so the peer has to be
+     * this implementation. */
+    int32_t fecPayloadType;
 };
 
 }  // namespace imsmedia
@@ -38,6 +38,10 @@ AudioConfig::AudioConfig() :
     mDtmfTxPayloadTypeNumber = 0;
     mDtmfRxPayloadTypeNumber = 0;
     dtmfsamplingRateKHz = 0;
+    redPayloadTypeNumber = 0;
+    redundancyLevel = 0;
+    redundancyDistance = 0;
+    playoutDelayPercentile = 0;
 }
 
 AudioConfig::AudioConfig(AudioConfig* config) :
@@ -52,6 +56,10 @@ AudioConfig::AudioConfig(AudioConfig* config) :
         mDtmfTxPayloadTypeNumber = config->mDtmfTxPayloadTypeNumber;
         mDtmfRxPayloadTypeNumber = config->mDtmfRxPayloadTypeNumber;
         dtmfsamplingRateKHz = config->dtmfsamplingRateKHz;
+        redPayloadTypeNumber = config->redPayloadTypeNumber;
+        redundancyLevel = config->redundancyLevel;
+        redundancyDistance = config->redundancyDistance;
+        playoutDelayPercentile = config->playoutDelayPercentile;
         amrParams = config->amrParams;
         evsParams = config->evsParams;
     }
@@ -67,6 +75,10 @@ AudioConfig::AudioConfig(const AudioConfig& config) :
     mDtmfTxPayloadTypeNumber = config.mDtmfTxPayloadTypeNumber;
     mDtmfRxPayloadTypeNumber = config.mDtmfRxPayloadTypeNumber;
     dtmfsamplingRateKHz = config.dtmfsamplingRateKHz;
+    redPayloadTypeNumber = config.redPayloadTypeNumber;
+    redundancyLevel = config.redundancyLevel;
+    redundancyDistance = config.redundancyDistance;
+    playoutDelayPercentile = config.playoutDelayPercentile;
     amrParams = config.amrParams;
     evsParams = config.evsParams;
 }
@@ -85,6 +97,10 @@ AudioConfig& AudioConfig::operator=(const AudioConfig& config)
         mDtmfTxPayloadTypeNumber = config.mDtmfTxPayloadTypeNumber;
         mDtmfRxPayloadTypeNumber = config.mDtmfRxPayloadTypeNumber;
         dtmfsamplingRateKHz = config.dtmfsamplingRateKHz;
+        redPayloadTypeNumber = config.redPayloadTypeNumber;
+        redundancyLevel = config.redundancyLevel;
+        redundancyDistance = config.redundancyDistance;
+        playoutDelayPercentile = config.playoutDelayPercentile;
         amrParams = config.amrParams;
         evsParams = config.evsParams;
     }
@@ -99,6 +115,10 @@ bool AudioConfig::operator==(const AudioConfig& config) const
             this->mDtmfTxPayloadTypeNumber == config.mDtmfTxPayloadTypeNumber &&
             this->mDtmfRxPayloadTypeNumber == config.mDtmfRxPayloadTypeNumber &&
             this->dtmfsamplingRateKHz == config.dtmfsamplingRateKHz &&
+            this->redPayloadTypeNumber == config.redPayloadTypeNumber &&
+            this->redundancyLevel == config.redundancyLevel &&
+            this->redundancyDistance == config.redundancyDistance &&
+            this->playoutDelayPercentile == config.playoutDelayPercentile &&
             this->amrParams == config.amrParams && this->evsParams == config.evsParams);
 }
 
@@ -110,6 +130,10 @@ bool AudioConfig::operator!=(const AudioConfig& config) const
             this->mDtmfTxPayloadTypeNumber != config.mDtmfTxPayloadTypeNumber ||
             this->mDtmfRxPayloadTypeNumber != config.mDtmfRxPayloadTypeNumber ||
             this->dtmfsamplingRateKHz != config.dtmfsamplingRateKHz ||
+            this->redPayloadTypeNumber != config.redPayloadTypeNumber ||
+            this->redundancyLevel != config.redundancyLevel ||
+            this->redundancyDistance != config.redundancyDistance ||
+            this->playoutDelayPercentile != config.playoutDelayPercentile ||
             this->amrParams != config.amrParams || this->evsParams != config.evsParams);
 }
 
@@ -171,6 +195,30 @@ status_t AudioConfig::writeToParcel(Parcel* out) const
         return err;
     }
 
+    err = out->writeByte(redPayloadTypeNumber);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = out->writeByte(redundancyLevel);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = out->writeByte(redundancyDistance);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = out->writeByte(playoutDelayPercentile);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
     String16 classNameAmr(kClassNameAmrParams);
     err = out->writeString16(classNameAmr);
     if (err != NO_ERROR)
@@ -261,6 +309,30 @@ status_t AudioConfig::readFromParcel(const Parcel* in)
         return err;
     }
 
+    err = in->readByte(&redPayloadTypeNumber);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = in->readByte(&redundancyLevel);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = in->readByte(&redundancyDistance);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = in->readByte(&playoutDelayPercentile);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
     String16 className;
     err = in->readString16(&className);
 
@@ -374,6 +446,46 @@ int8_t AudioConfig::getDtmfsamplingRateKHz()
     return dtmfsamplingRateKHz;
 }
 
+void AudioConfig::setRedPayloadTypeNumber(const int8_t num)
+{
+    redPayloadTypeNumber = num;
+}
+
+int8_t AudioConfig::getRedPayloadTypeNumber()
+{
+    return redPayloadTypeNumber;
+}
+
+void AudioConfig::setRedundancyLevel(const int8_t level)
+{
+    redundancyLevel = level;
+}
+
+int8_t AudioConfig::getRedundancyLevel()
+{
+    return redundancyLevel;
+}
+
+void AudioConfig::setRedundancyDistance(const int8_t distance)
+{
+    redundancyDistance = distance;
+}
+
+int8_t AudioConfig::getRedundancyDistance()
+{
+    return redundancyDistance;
+}
+
+void AudioConfig::setPlayoutDelayPercentile(const int8_t percentile)
+{
+    playoutDelayPercentile = percentile;
+}
+
+int8_t AudioConfig::getPlayoutDelayPercentile()
+{
+    return playoutDelayPercentile;
+}
+
 void AudioConfig::setAmrParams(const AmrParams& param)
 {
     amrParams = param;
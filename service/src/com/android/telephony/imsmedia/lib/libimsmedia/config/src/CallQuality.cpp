@@ -50,6 +50,7 @@ CallQuality::CallQuality()
     mMaxPlayoutDelayMillis = 0;
     mNumRtpSidPacketsReceived = 0;
     mNumRtpDuplicatePackets = 0;
+    mNumHeaderBytesSaved = 0;
 }
 
 CallQuality::CallQuality(const CallQuality& quality)
@@ -75,6 +76,7 @@ CallQuality::CallQuality(const CallQuality& quality)
     mMaxPlayoutDelayMillis = quality.mMaxPlayoutDelayMillis;
     mNumRtpSidPacketsReceived = quality.mNumRtpSidPacketsReceived;
     mNumRtpDuplicatePackets = quality.mNumRtpDuplicatePackets;
+    mNumHeaderBytesSaved = quality.mNumHeaderBytesSaved;
 }
 
 CallQuality::~CallQuality() {}
@@ -104,6 +106,7 @@ CallQuality& CallQuality::operator=(const CallQuality& quality)
         mMaxPlayoutDelayMillis = quality.mMaxPlayoutDelayMillis;
         mNumRtpSidPacketsReceived = quality.mNumRtpSidPacketsReceived;
         mNumRtpDuplicatePackets = quality.mNumRtpDuplicatePackets;
+        mNumHeaderBytesSaved = quality.mNumHeaderBytesSaved;
     }
     return *this;
 }
@@ -130,7 +133,8 @@ bool CallQuality::operator==(const CallQuality& quality) const
             mMinPlayoutDelayMillis == quality.mMinPlayoutDelayMillis &&
             mMaxPlayoutDelayMillis == quality.mMaxPlayoutDelayMillis &&
             mNumRtpSidPacketsReceived == quality.mNumRtpSidPacketsReceived &&
-            mNumRtpDuplicatePackets == quality.mNumRtpDuplicatePackets);
+            mNumRtpDuplicatePackets == quality.mNumRtpDuplicatePackets &&
+            mNumHeaderBytesSaved == quality.mNumHeaderBytesSaved);
 }
 
 bool CallQuality::operator!=(const CallQuality& quality) const
@@ -155,7 +159,8 @@ bool CallQuality::operator!=(const CallQuality& quality) const
             mMinPlayoutDelayMillis != quality.mMinPlayoutDelayMillis ||
             mMaxPlayoutDelayMillis != quality.mMaxPlayoutDelayMillis ||
             mNumRtpSidPacketsReceived != quality.mNumRtpSidPacketsReceived ||
-            mNumRtpDuplicatePackets != quality.mNumRtpDuplicatePackets);
+            mNumRtpDuplicatePackets != quality.mNumRtpDuplicatePackets ||
+            mNumHeaderBytesSaved != quality.mNumHeaderBytesSaved);
 }
 
 status_t CallQuality::writeToParcel(Parcel* out) const
@@ -643,6 +648,16 @@ void CallQuality::setNumRtpDuplicatePackets(const int num)
     mNumRtpDuplicatePackets = num;
 }
 
+int CallQuality::getNumHeaderBytesSaved()
+{
+    return mNumHeaderBytesSaved;
+}
+
+void CallQuality::setNumHeaderBytesSaved(const int num)
+{
+    mNumHeaderBytesSaved = num;
+}
+
 }  // namespace imsmedia
 
 }  // namespace telephony
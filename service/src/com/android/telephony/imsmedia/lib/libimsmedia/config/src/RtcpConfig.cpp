@@ -14,7 +14,9 @@ RtcpConfig::RtcpConfig() :
         canonicalName(""),
         transmitPort(0),
         intervalSec(0),
-        rtcpXrBlockTypes(0)
+        rtcpXrBlockTypes(0),
+        rtcpMuxEnabled(false),
+        rtcpReducedSizeEnabled(false)
 {
 }
 
@@ -24,6 +26,8 @@ RtcpConfig::RtcpConfig(const RtcpConfig& config)
     this->transmitPort = config.transmitPort;
     this->intervalSec = config.intervalSec;
     this->rtcpXrBlockTypes = config.rtcpXrBlockTypes;
+    this->rtcpMuxEnabled = config.rtcpMuxEnabled;
+    this->rtcpReducedSizeEnabled = config.rtcpReducedSizeEnabled;
 }
 
 RtcpConfig::~RtcpConfig() {}
@@ -36,6 +40,8 @@ RtcpConfig& RtcpConfig::operator=(const RtcpConfig& config)
         this->transmitPort = config.transmitPort;
         this->intervalSec = config.intervalSec;
         this->rtcpXrBlockTypes = config.rtcpXrBlockTypes;
+        this->rtcpMuxEnabled = config.rtcpMuxEnabled;
+        this->rtcpReducedSizeEnabled = config.rtcpReducedSizeEnabled;
     }
     return *this;
 }
@@ -44,14 +50,18 @@ bool RtcpConfig::operator==(const RtcpConfig& config) const
 {
     return (this->canonicalName == config.canonicalName &&
             this->transmitPort == config.transmitPort && this->intervalSec == config.intervalSec &&
-            this->rtcpXrBlockTypes == config.rtcpXrBlockTypes);
+            this->rtcpXrBlockTypes == config.rtcpXrBlockTypes &&
+            this->rtcpMuxEnabled == config.rtcpMuxEnabled &&
+            this->rtcpReducedSizeEnabled == config.rtcpReducedSizeEnabled);
 }
 
 bool RtcpConfig::operator!=(const RtcpConfig& config) const
 {
     return (this->canonicalName != config.canonicalName ||
             this->transmitPort != config.transmitPort || this->intervalSec != config.intervalSec ||
-            this->rtcpXrBlockTypes != config.rtcpXrBlockTypes);
+            this->rtcpXrBlockTypes != config.rtcpXrBlockTypes ||
+            this->rtcpMuxEnabled != config.rtcpMuxEnabled ||
+            this->rtcpReducedSizeEnabled != config.rtcpReducedSizeEnabled);
 }
 
 status_t RtcpConfig::writeToParcel(Parcel* out) const
@@ -87,6 +97,18 @@ status_t RtcpConfig::writeToParcel(Parcel* out) const
         return err;
     }
 
+    err = out->writeInt32(rtcpMuxEnabled ? 1 : 0);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = out->writeInt32(rtcpReducedSizeEnabled ? 1 : 0);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
     return NO_ERROR;
 }
 
@@ -125,6 +147,23 @@ status_t RtcpConfig::readFromParcel(const Parcel* in)
         return err;
     }
 
+    int32_t value = 0;
+    err = in->readInt32(&value);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    rtcpMuxEnabled = (value != 0);
+
+    err = in->readInt32(&value);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    rtcpReducedSizeEnabled = (value != 0);
+
     return NO_ERROR;
 }
 
@@ -168,12 +207,34 @@ int32_t RtcpConfig::getRtcpXrBlockTypes()
     return rtcpXrBlockTypes;
 }
 
+void RtcpConfig::setRtcpMuxEnabled(const bool enable)
+{
+    rtcpMuxEnabled = enable;
+}
+
+bool RtcpConfig::getRtcpMuxEnabled()
+{
+    return rtcpMuxEnabled;
+}
+
+void RtcpConfig::setRtcpReducedSizeEnabled(const bool enable)
+{
+    rtcpReducedSizeEnabled = enable;
+}
+
+bool RtcpConfig::getRtcpReducedSizeEnabled()
+{
+    return rtcpReducedSizeEnabled;
+}
+
 void RtcpConfig::setDefaultRtcpConfig()
 {
     canonicalName = android::String8("");
     transmitPort = kTransmitPort;
     intervalSec = kIntervalSec;
     rtcpXrBlockTypes = kRtcpXrBlockTypes;
+    rtcpMuxEnabled = kRtcpMuxEnabled;
+    rtcpReducedSizeEnabled = kRtcpReducedSizeEnabled;
 }
 
 }  // namespace imsmedia
@@ -338,6 +338,11 @@ RtcpConfig RtpConfig::getRtcpConfig()
     return rtcpConfig;
 }
 
+int32_t RtpConfig::getRemoteRtcpPort()
+{
+    return rtcpConfig.getRtcpMuxEnabled() ? remotePort : remotePort + 1;
+}
+
 void RtpConfig::setDscp(const int8_t dscp)
 {
     this->dscp = dscp;
@@ -47,6 +47,8 @@ VideoConfig::VideoConfig() :
     deviceOrientationDegree = 0;
     cvoValue = CVO_DEFINE_NONE;
     rtcpFbTypes = RTP_FB_NONE;
+    transportSeqValue = 0;
+    fecPayloadType = 0;
 }
 
 VideoConfig::VideoConfig(VideoConfig* config) :
@@ -71,6 +73,8 @@ VideoConfig::VideoConfig(VideoConfig* config) :
     deviceOrientationDegree = config->deviceOrientationDegree;
     cvoValue = config->cvoValue;
     rtcpFbTypes = config->rtcpFbTypes;
+    transportSeqValue = config->transportSeqValue;
+    fecPayloadType = config->fecPayloadType;
 }
 
 VideoConfig::VideoConfig(const VideoConfig& config) :
@@ -93,6 +97,8 @@ VideoConfig::VideoConfig(const VideoConfig& config) :
     deviceOrientationDegree = config.deviceOrientationDegree;
     cvoValue = config.cvoValue;
     rtcpFbTypes = config.rtcpFbTypes;
+    transportSeqValue = config.transportSeqValue;
+    fecPayloadType = config.fecPayloadType;
 }
 
 VideoConfig::~VideoConfig() {}
@@ -119,6 +125,8 @@ VideoConfig& VideoConfig::operator=(const VideoConfig& config)
         deviceOrientationDegree = config.deviceOrientationDegree;
         cvoValue = config.cvoValue;
         rtcpFbTypes = config.rtcpFbTypes;
+        transportSeqValue = config.transportSeqValue;
+        fecPayloadType = config.fecPayloadType;
     }
     return *this;
 }
@@ -136,7 +144,9 @@ bool VideoConfig::operator==(const VideoConfig& config) const
             this->resolutionHeight == config.resolutionHeight &&
             this->pauseImagePath == config.pauseImagePath &&
             this->deviceOrientationDegree == config.deviceOrientationDegree &&
-            this->cvoValue == config.cvoValue && this->rtcpFbTypes == config.rtcpFbTypes);
+            this->cvoValue == config.cvoValue && this->rtcpFbTypes == config.rtcpFbTypes &&
+            this->transportSeqValue == config.transportSeqValue &&
+            this->fecPayloadType == config.fecPayloadType);
 }
 
 bool VideoConfig::operator!=(const VideoConfig& config) const
@@ -152,7 +162,9 @@ bool VideoConfig::operator!=(const VideoConfig& config) const
             this->resolutionHeight != config.resolutionHeight ||
             this->pauseImagePath != config.pauseImagePath ||
             this->deviceOrientationDegree != config.deviceOrientationDegree ||
-            this->cvoValue != config.cvoValue || this->rtcpFbTypes != config.rtcpFbTypes);
+            this->cvoValue != config.cvoValue || this->rtcpFbTypes != config.rtcpFbTypes ||
+            this->transportSeqValue != config.transportSeqValue ||
+            this->fecPayloadType != config.fecPayloadType);
 }
 
 status_t VideoConfig::writeToParcel(Parcel* out) const
@@ -271,6 +283,18 @@ status_t VideoConfig::writeToParcel(Parcel* out) const
         return err;
     }
 
+    err = out->writeInt32(transportSeqValue);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = out->writeInt32(fecPayloadType);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
     return NO_ERROR;
 }
 
@@ -393,6 +417,18 @@ status_t VideoConfig::readFromParcel(const Parcel* in)
         return err;
     }
 
+    err = in->readInt32(&transportSeqValue);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
+    err = in->readInt32(&fecPayloadType);
+    if (err != NO_ERROR)
+    {
+        return err;
+    }
+
     return NO_ERROR;
 }
 
@@ -566,6 +602,26 @@ int32_t VideoConfig::getRtcpFbType()
     return rtcpFbTypes;
 }
 
+void VideoConfig::setTransportSeqValue(const int32_t value)
+{
+    transportSeqValue = value;
+}
+
+int32_t VideoConfig::getTransportSeqValue()
+{
+    return transportSeqValue;
+}
+
+void VideoConfig::setFecPayloadType(const int32_t type)
+{
+    fecPayloadType = type;
+}
+
+int32_t VideoConfig::getFecPayloadType()
+{
+    return fecPayloadType;
+}
+
 }  // namespace imsmedia
 
 }  // namespace telephony
@@ -35,12 +35,6 @@ IRtpSession* IRtpSession::GetInstance(
         }
     }
 
-    if (mListRtpSession.size() == 0)
-    {
-        IMLOGI0("[GetInstance] Initialize Rtp Stack");
-        IMS_RtpSvc_Initialize();
-    }
-
     IRtpSession* pSession = new IRtpSession(type, localAddress, peerAddress);
     mListRtpSession.push_back(pSession);
     pSession->increaseRefCounter();
@@ -63,19 +57,14 @@ void IRtpSession::ReleaseInstance(IRtpSession* session)
         mListRtpSession.remove(session);
         delete session;
     }
-
-    if (mListRtpSession.size() == 0)
-    {
-        IMLOGI0("[ReleaseInstance] Deinitialize Rtp Stack");
-        IMS_RtpSvc_Deinitialize();
-    }
 }
 
 IRtpSession::IRtpSession(
         ImsMediaType mediatype, const RtpAddress& localAddress, const RtpAddress& peerAddress)
 {
     mMediaType = mediatype;
-    mRtpSessionId = 0;
+    mRtpStackId = nullptr;
+    mRtpSessionId = {};
     mRefCount = 0;
     mLocalAddress = localAddress;
     mPeerAddress = peerAddress;
@@ -101,11 +90,19 @@ IRtpSession::IRtpSession(
     mNumRtpDataToSend = 0;
     mNumRtpPacketSent = 0;
     mNumRtcpPacketSent = 0;
-    mRttd = -1;
+    mNumNackRetransmission = 0;
+    mSumNackLatency = 0;
+    mMaxNackLatency = 0;
+    for (int32_t i = 0; i < MAX_TRANSPORT_SEQ_HISTORY; i++)
+    {
+        mTransportSeqNums[i] = 0;
+        mTransportSendTimes[i] = -1;
+    }
 
-    // create rtp stack session
-    IMS_RtpSvc_CreateSession(
-            mLocalAddress.ipAddress, mLocalAddress.port, this, &mLocalRtpSsrc, &mRtpSessionId);
+    // each session runs in its own stack instance, the sessions do not share the stack state
+    IMS_RtpSvc_CreateStack(&mRtpStackId);
+    IMS_RtpSvc_CreateSession(mRtpStackId, mLocalAddress.ipAddress, mLocalAddress.port, this,
+            &mLocalRtpSsrc, &mRtpSessionId);
     IMLOGD6("[IRtpSession] media[%d], localIp[%s], localPort[%d], peerIp[%s], peerPort[%d], "
             "sessionId[%d]",
             mMediaType, mLocalAddress.ipAddress, mLocalAddress.port, mPeerAddress.ipAddress,
@@ -115,6 +112,7 @@ IRtpSession::IRtpSession(
 IRtpSession::~IRtpSession()
 {
     IMS_RtpSvc_DeleteSession(mRtpSessionId);
+    IMS_RtpSvc_DeleteStack(mRtpStackId);
     mRtpEncoderListener = nullptr;
     mRtpDecoderListener = nullptr;
     mRtcpEncoderListener = nullptr;
@@ -169,7 +167,7 @@ void IRtpSession::SetRtcpDecoderListener(IRtcpDecoderListener* pRtcpDecoderListe
 
 void IRtpSession::SetRtpPayloadParam(int32_t payloadNumTx, int32_t payloadNumRx,
         int32_t samplingRate, int32_t subTxPayloadTypeNum, int32_t subRxPayloadTypeNum,
-        int32_t subSamplingRate)
+        int32_t subSamplingRate, int32_t redPayloadTypeNum)
 {
     mNumPayloadParam = 0;
     std::memset(mPayloadParam, 0, sizeof(tRtpSvc_SetPayloadParam) * MAX_NUM_PAYLOAD_PARAM);
@@ -225,6 +223,24 @@ void IRtpSession::SetRtpPayloadParam(int32_t payloadNumTx, int32_t payloadNumRx,
         }
     }
 
+    // the redundant audio data of RFC 2198 shares the clock rate of the primary payload
+    if (mMediaType == IMS_MEDIA_AUDIO && redPayloadTypeNum != 0)
+    {
+        IMLOGD1("[SetRtpPayloadParam] red payload[%d]", redPayloadTypeNum);
+
+        if (mNumPayloadParam >= MAX_NUM_PAYLOAD_PARAM)
+        {
+            IMLOGE1("[SetRtpPayloadParam] overflow[%d]", mNumPayloadParam);
+        }
+        else
+        {
+            mPayloadParam[mNumPayloadParam].frameInterval = 100;  // not used in stack
+            mPayloadParam[mNumPayloadParam].payloadType = redPayloadTypeNum;
+            mPayloadParam[mNumPayloadParam].samplingRate = samplingRate;
+            mNumPayloadParam++;
+        }
+    }
+
     IMS_RtpSvc_SetPayload(mRtpSessionId, mPayloadParam,
             mMediaType == IMS_MEDIA_VIDEO ? eRTP_TRUE : eRTP_FALSE, mNumPayloadParam);
 }
@@ -235,6 +251,24 @@ void IRtpSession::SetRtcpInterval(int32_t nInterval)
     IMS_RtpSvc_SetRTCPInterval(mRtpSessionId, nInterval);
 }
 
+void IRtpSession::SetRtcpReducedSize(bool enable)
+{
+    IMLOGD1("[SetRtcpReducedSize] enable[%d]", enable);
+    IMS_RtpSvc_SetRtcpReducedSize(mRtpSessionId, enable ? eRTP_TRUE : eRTP_FALSE);
+}
+
+void IRtpSession::SetRtcpXrRttBlocks(bool rrt, bool dlrr)
+{
+    IMLOGD2("[SetRtcpXrRttBlocks] rrt[%d], dlrr[%d]", rrt, dlrr);
+    IMS_RtpSvc_SetRtcpXrRttBlocks(
+            mRtpSessionId, rrt ? eRTP_TRUE : eRTP_FALSE, dlrr ? eRTP_TRUE : eRTP_FALSE);
+}
+
+RttEstimator* IRtpSession::GetRttEstimator()
+{
+    return &mRttEstimator;
+}
+
 void IRtpSession::StartRtp()
 {
     IMLOGD1("[StartRtp] RtpStarted[%d]", mRtpStarted);
@@ -452,12 +486,42 @@ void IRtpSession::OnPeerInd(tRtpSvc_IndicationFromStack type, void* pMsg)
             }
             break;
         case RTPSVC_RECEIVE_RTCP_FB_IND:
+        {
+            tRtpSvcIndSt_ReceiveRtcpFeedbackInd* ind =
+                    reinterpret_cast<tRtpSvcIndSt_ReceiveRtcpFeedbackInd*>(pMsg);
+
+            if (ind->wFmt == TransportFeedback::kTransportFeedbackFmt)
+            {
+                OnTransportFeedback(ind);
+            }
+            else if (mRtcpDecoderListener)
+            {
+                mRtcpDecoderListener->OnRtcpInd(type, pMsg);
+            }
+        }
+        break;
         case RTPSVC_RECEIVE_RTCP_PAYLOAD_FB_IND:
             if (mRtcpDecoderListener)
             {
                 mRtcpDecoderListener->OnRtcpInd(type, pMsg);
             }
             break;
+        case RTPSVC_NACK_RETRANSMISSION_IND:
+        {
+            tRtpSvcIndSt_NackRetransmissionInd* ind =
+                    reinterpret_cast<tRtpSvcIndSt_NackRetransmissionInd*>(pMsg);
+            mNumNackRetransmission++;
+            mSumNackLatency += ind->dwLatency;
+
+            if (ind->dwLatency > mMaxNackLatency)
+            {
+                mMaxNackLatency = ind->dwLatency;
+            }
+
+            IMLOGD_PACKET2(IM_PACKET_LOG_RTCP, "[OnPeerInd] retransmitted seq[%u], latency[%u]",
+                    ind->wSeqNum, ind->dwLatency);
+        }
+        break;
         default:
             IMLOGD1("[OnPeerInd] unhandled[%d]", type);
             break;
@@ -468,10 +532,25 @@ void IRtpSession::OnPeerRtcpComponents(void* nMsg)
 {
     IMLOGD0("[OnPeerRtcpComponents]");
 
-    if (nMsg != nullptr && mRtcpDecoderListener != nullptr)
+    if (nMsg == nullptr)
+    {
+        return;
+    }
+
+    // the round trip time delay is in the unit of 1/65536 seconds, 0 when it is not measured
+    uint32_t roundTripTimeDelay = *reinterpret_cast<uint32_t*>(nMsg);
+
+    if (roundTripTimeDelay != 0)
     {
-        int32_t roundTripTimeDelay = *reinterpret_cast<int32_t*>(nMsg);
-        mRtcpDecoderListener->OnEvent(kRequestRoundTripTimeDelayUpdate, roundTripTimeDelay);
+        mRttEstimator.Update(static_cast<uint64_t>(roundTripTimeDelay) * 1000 >> 16);
+    }
+
+    if (mRtcpDecoderListener != nullptr)
+    {
+        // notifies the smoothed round trip time in the same unit
+        uint32_t smoothedDelay =
+                (static_cast<uint64_t>(mRttEstimator.GetSmoothedRtt()) << 16) / 1000;
+        mRtcpDecoderListener->OnEvent(kRequestRoundTripTimeDelayUpdate, smoothedDelay);
     }
 }
 
@@ -482,6 +561,13 @@ void IRtpSession::OnTimer()
             mMediaType, mNumRtpProcPacket, mNumRtpPacket, mNumRtcpProcPacket,
             mNumSRPacket + mNumRRPacket, mNumRtpDataToSend, mNumRtpPacketSent, mNumRtcpPacketSent);
 
+    if (mNumNackRetransmission > 0)
+    {
+        IMLOGI3("[OnTimer] NACK retransmission count[%u], average latency[%u], max latency[%u]",
+                mNumNackRetransmission, mSumNackLatency / mNumNackRetransmission,
+                mMaxNackLatency);
+    }
+
     std::lock_guard<std::mutex> guard(mutexDecoder);
 
     if (mRtpDecoderListener)
@@ -502,16 +588,16 @@ void IRtpSession::OnTimer()
     mNumRtpDataToSend = 0;
     mNumRtpPacketSent = 0;
     mNumRtcpPacketSent = 0;
+    mNumNackRetransmission = 0;
+    mSumNackLatency = 0;
+    mMaxNackLatency = 0;
 }
 
 void IRtpSession::SendRtcpXr(uint8_t* pPayload, uint32_t nSize)
 {
     IMLOGD1("[SendRtcpXr] nSize[%d]", nSize);
 
-    if (mRtpSessionId)
-    {
-        IMS_RtpSvc_SendRtcpXrPacket(mRtpSessionId, pPayload, nSize);
-    }
+    IMS_RtpSvc_SendRtcpXrPacket(mRtpSessionId, pPayload, nSize);
 }
 
 bool IRtpSession::SendRtcpFeedback(int32_t type, uint8_t* pFic, uint32_t nFicSize)
@@ -550,6 +636,66 @@ bool IRtpSession::SendRtcpFeedback(int32_t type, uint8_t* pFic, uint32_t nFicSiz
     return true;
 }
 
+void IRtpSession::OnTransportFeedback(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* ind)
+{
+    // pMsg points to the FCI in the received packet, after the sender and media source SSRC
+    const uint32_t kFciOffset = 8;
+    TransportFeedbackResult result;
+
+    if (ind->wMsgLen < kFciOffset ||
+            !TransportFeedback::Parse(ind->pMsg, ind->wMsgLen - kFciOffset, &result))
+    {
+        IMLOGE1("[OnTransportFeedback] invalid feedback, length[%d]", ind->wMsgLen);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(mutexTransportSeq);
+
+        for (auto& packet : result.packets)
+        {
+            uint32_t index = packet.seqNum % MAX_TRANSPORT_SEQ_HISTORY;
+
+            if (mTransportSeqNums[index] == packet.seqNum)
+            {
+                packet.sendTimeMs = mTransportSendTimes[index];
+            }
+        }
+    }
+
+    if (mRtcpDecoderListener)
+    {
+        mRtcpDecoderListener->OnTransportFeedback(result);
+    }
+}
+
+bool IRtpSession::SendRtcpTransportFeedback(uint8_t* fci, uint32_t size)
+{
+    IMLOGD_PACKET1(IM_PACKET_LOG_RTCP, "[SendRtcpTransportFeedback] size[%u]", size);
+
+    if (!mRtcpStarted || fci == nullptr)
+    {
+        return false;
+    }
+
+    if (IMS_RtpSvc_SendRtcpRtpFbPacket(mRtpSessionId, TransportFeedback::kTransportFeedbackFmt,
+                reinterpret_cast<char*>(fci), size, mPeerRtpSsrc) != eRTP_TRUE)
+    {
+        IMLOGE0("[SendRtcpTransportFeedback] error");
+        return false;
+    }
+
+    return true;
+}
+
+void IRtpSession::SetTransportSeqSent(uint16_t seqNum, uint32_t sendTime)
+{
+    std::lock_guard<std::mutex> guard(mutexTransportSeq);
+    uint32_t index = seqNum % MAX_TRANSPORT_SEQ_HISTORY;
+    mTransportSeqNums[index] = seqNum;
+    mTransportSendTimes[index] = sendTime;
+}
+
 ImsMediaType IRtpSession::getMediaType()
 {
     return mMediaType;
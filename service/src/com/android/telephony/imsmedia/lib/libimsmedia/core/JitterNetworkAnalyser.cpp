@@ -18,9 +18,6 @@
 #include <JitterNetworkAnalyser.h>
 #include <ImsMediaTimer.h>
 #include <ImsMediaTrace.h>
-#include <numeric>
-#include <cmath>
-#include <algorithm>
 
 #define MAX_JITTER_LIST_SIZE     (500)
 #define PACKET_INTERVAL          (20)  // milliseconds
@@ -29,13 +26,16 @@
 #define BUFFER_IN_DECREASE_SIZE  (2)
 #define STATUS_INTERVAL          (1000)  // milliseconds
 
-JitterNetworkAnalyser::JitterNetworkAnalyser()
+JitterNetworkAnalyser::JitterNetworkAnalyser() :
+        mJitterStats(MAX_JITTER_LIST_SIZE),
+        mJitterQuantile(0)
 {
     mMinJitterBufferSize = 0;
     mMaxJitterBufferSize = 0;
     mBufferReduceTH = BUFFER_REDUCE_TH;
     mBufferStepSize = BUFFER_IN_DECREASE_SIZE;
     mBufferZValue = STD_DISTRIBUTION_Z_VALUE;
+    mUseQuantile = false;
     Reset();
 }
 
@@ -50,7 +50,8 @@ void JitterNetworkAnalyser::Reset()
     mBadStatusChangedTime = 0;
 
     std::lock_guard<std::mutex> guard(mMutex);
-    mListJitters.clear();
+    mJitterStats.Reset();
+    mJitterQuantile.Reset();
 }
 
 void JitterNetworkAnalyser::SetMinMaxJitterBufferSize(
@@ -70,6 +71,14 @@ void JitterNetworkAnalyser::SetJitterOptions(uint32_t nReduceTH, uint32_t nStepS
             mBufferStepSize, mBufferZValue);
 }
 
+void JitterNetworkAnalyser::SetJitterQuantile(double quantile)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mUseQuantile = quantile > 0;
+    mJitterQuantile.SetQuantile(quantile);
+    IMLOGD1("[SetJitterQuantile] quantile[%.3lf]", quantile);
+}
+
 int32_t JitterNetworkAnalyser::CalculateTransitTimeDifference(
         uint32_t timestamp, uint32_t arrivalTime)
 {
@@ -83,53 +92,16 @@ int32_t JitterNetworkAnalyser::CalculateTransitTimeDifference(
     int32_t jitter = inputTimeGap - inputTimestampGap;
 
     std::lock_guard<std::mutex> guard(mMutex);
-    mListJitters.push_back(jitter);
+    mJitterStats.Add(jitter);
 
-    if (mListJitters.size() > MAX_JITTER_LIST_SIZE)
+    if (mUseQuantile)
     {
-        mListJitters.pop_front();
+        mJitterQuantile.Add(jitter);
     }
 
     return jitter;
 }
 
-double JitterNetworkAnalyser::CalculateDeviation(double* pMean)
-{
-    std::lock_guard<std::mutex> guard(mMutex);
-
-    if (mListJitters.empty())
-    {
-        *pMean = 0;
-        return 0.0f;
-    }
-
-    double mean =
-            std::accumulate(mListJitters.begin(), mListJitters.end(), 0.0f) / mListJitters.size();
-
-    *pMean = mean;
-
-    double dev = sqrt(std::accumulate(mListJitters.begin(), mListJitters.end(), 0.0f,
-                              [mean](int x, int y)
-                              {
-                                  return x + std::pow(y - mean, 2);
-                              }) /
-            mListJitters.size());
-
-    return dev;
-}
-
-int32_t JitterNetworkAnalyser::GetMaxJitterValue()
-{
-    std::lock_guard<std::mutex> guard(mMutex);
-
-    if (mListJitters.empty())
-    {
-        return 0;
-    }
-
-    return *std::max_element(mListJitters.begin(), mListJitters.end());
-}
-
 void JitterNetworkAnalyser::UpdateBaseTimestamp(uint32_t packetTime, uint32_t arrivalTime)
 {
     IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[UpdateBaseTimestamp] packetTime[%d], arrivalTime[%u]",
@@ -147,9 +119,24 @@ uint32_t JitterNetworkAnalyser::GetNextJitterBufferSize(
     double dev, mean;
     // calcuatation of jitterSize
     double calcJitterSize = 0;
-    int32_t maxJitter = GetMaxJitterValue();
-    dev = CalculateDeviation(&mean);
-    calcJitterSize = mean + mBufferZValue * dev;
+    int32_t maxJitter;
+
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+        maxJitter = mJitterStats.GetMax();
+        mean = mJitterStats.GetMean();
+        dev = mJitterStats.GetDeviation();
+
+        if (mUseQuantile && mJitterQuantile.GetCount() > 0)
+        {
+            calcJitterSize = mJitterQuantile.GetEstimation();
+        }
+        else
+        {
+            calcJitterSize = mean + mBufferZValue * dev;
+        }
+    }
+
     IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
             "[GetNextJitterBufferSize] size[%4.2f], dev[%lf], curr[%d], max jitter[%d]",
             calcJitterSize, dev, nCurrJitterBufferSize, maxJitter);
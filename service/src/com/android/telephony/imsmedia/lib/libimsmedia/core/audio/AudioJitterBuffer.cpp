@@ -18,6 +18,7 @@
 #include <ImsMediaDataQueue.h>
 #include <ImsMediaTimer.h>
 #include <ImsMediaTrace.h>
+#include <algorithm>
 
 #define AUDIO_JITTER_BUFFER_MIN_SIZE   (3)
 #define AUDIO_JITTER_BUFFER_MAX_SIZE   (9)
@@ -28,21 +29,34 @@
 #define ALLOWABLE_ERROR                (10)     // ms unit
 #define RESET_THRESHOLD                (10000)  // ms unit
 #define TS_ROUND_QUARD                 (3000)   // ms unit
+#define TRANSIT_WINDOW_SIZE            (100)    // packets, two seconds of 20 ms frames
+#define CATCH_UP_DELAY_STEP            (200)    // ms unit
+#define CATCH_UP_STEP_PACKETS          (3)      // consecutive packets over the delay step
+#define CATCH_UP_MAX_EXCESS            (200)    // ms unit
+#define CATCH_UP_STOP_EXCESS           (40)     // ms unit, left to the time stretching
+#define CATCH_UP_TIMEOUT               (2000)   // ms unit
 #define USHORT_TS_ROUND_COMPARE(a, b)                                             \
     (((a) >= (b) && (b) >= TS_ROUND_QUARD) || ((a) <= 0xffff - TS_ROUND_QUARD) || \
             ((a) <= TS_ROUND_QUARD && (b) >= 0xffff - TS_ROUND_QUARD))
 
-AudioJitterBuffer::AudioJitterBuffer()
+AudioJitterBuffer::AudioJitterBuffer() :
+        mTransitTimes(TRANSIT_WINDOW_SIZE)
 {
     mInitJitterBufferSize = AUDIO_JITTER_BUFFER_START_SIZE;
     mMinJitterBufferSize = AUDIO_JITTER_BUFFER_MIN_SIZE;
     mMaxJitterBufferSize = AUDIO_JITTER_BUFFER_MAX_SIZE;
+    mCurrJitterBufferSize = mInitJitterBufferSize;
+    mEvsRedundantFrameOffset = 0;
     AudioJitterBuffer::Reset();
-    mBufferIgnoreSIDPacket = false;
 }
 
 AudioJitterBuffer::~AudioJitterBuffer() {}
 
+uint32_t AudioJitterBuffer::GetCount()
+{
+    return mRingQueue.GetCount();
+}
+
 void AudioJitterBuffer::Reset()
 {
     mFirstFrameReceived = false;
@@ -54,26 +68,30 @@ void AudioJitterBuffer::Reset()
     mSIDCount = 0;
     mWaiting = true;
     mDeleteCount = 0;
-    mBaseTimestamp = 0;
-    mBaseArrivalTime = 0;
     mCannotGetCount = 0;
     mCheckUpdateJitterPacketCnt = 0;
     mEnforceUpdate = false;
-    mNeedToUpdateBasePacket = false;
+    mPartialCopyPlayed = false;
+    mCatchUp = false;
+    mCatchUpStarted = false;
+    mCatchUpStartTime = 0;
+    mCatchUpStartDelay = 0;
+    mDelayStepCount = 0;
 
     mMutex.lock();
     DataEntry* entry = nullptr;
 
-    while (mDataQueue.Get(&entry))
+    while (mRingQueue.Get(&entry))
     {
         CollectRxRtpStatus(entry->nSeqNum, kRtpStatusDiscarded);
-        mDataQueue.Delete();
+        mRingQueue.Delete();
     }
 
     mMutex.unlock();
 
     mJitterAnalyzer.Reset();
     mJitterAnalyzer.SetMinMaxJitterBufferSize(mMinJitterBufferSize, mMaxJitterBufferSize);
+    mDelayEstimator.Reset();
 }
 
 void AudioJitterBuffer::SetJitterBufferSize(uint32_t nInit, uint32_t nMin, uint32_t nMax)
@@ -113,12 +131,26 @@ void AudioJitterBuffer::SetJitterBufferSize(uint32_t nInit, uint32_t nMin, uint3
 void AudioJitterBuffer::SetJitterOptions(
         uint32_t nReduceTH, uint32_t nStepSize, double zValue, bool bIgnoreSID)
 {
-    mBufferIgnoreSIDPacket = bIgnoreSID;
+    // the SID frames are always excluded from the jitter statistics
+    (void)bIgnoreSID;
     mJitterAnalyzer.SetJitterOptions(nReduceTH, nStepSize, zValue);
 }
 
+void AudioJitterBuffer::SetPlayoutDelayOptions(
+        double percentile, double attackRate, double decayRate)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mDelayEstimator.SetOptions(percentile, attackRate, decayRate);
+}
+
+void AudioJitterBuffer::SetEvsRedundantFrameOffset(int32_t offset)
+{
+    IMLOGD1("[SetEvsRedundantFrameOffset] offset[%d]", offset);
+    mEvsRedundantFrameOffset = offset;
+}
+
 void AudioJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t nBufferSize,
-        uint32_t nTimestamp, bool bMark, uint32_t nSeqNum, ImsMediaSubType /*nDataType*/,
+        uint32_t nTimestamp, bool bMark, uint32_t nSeqNum, ImsMediaSubType nDataType,
         uint32_t arrivalTime)
 {
     DataEntry currEntry = DataEntry();
@@ -131,8 +163,26 @@ void AudioJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
     currEntry.bHeader = true;
     currEntry.bValid = true;
     currEntry.arrivalTime = arrivalTime;
+    currEntry.eDataType = nDataType;
 
     int32_t jitter = 0;
+    // the frame recovered from the redundant data of the later packet is not a packet arrival
+    bool recovered = (nDataType == MEDIASUBTYPE_AUDIO_RED);
+
+    // the packets held by the network in the handover are played faster to catch up instead of
+    // resetting the jitter buffer by the frames not played
+    if (!recovered && arrivalTime != 0)
+    {
+        std::lock_guard<std::mutex> guard(mMutex);
+
+        if (CheckDelayStep(nTimestamp, arrivalTime) && mFirstFrameReceived && !mCatchUp)
+        {
+            IMLOGD2("[Add] catch up - seq[%d], TS[%u]", nSeqNum, nTimestamp);
+            mCatchUp = true;
+            mCatchUpStarted = false;
+            mCannotGetCount = 0;
+        }
+    }
 
     if (mCannotGetCount > mMaxJitterBufferSize)
     {
@@ -140,73 +190,48 @@ void AudioJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
         Reset();
     }
 
-    if (!mBufferIgnoreSIDPacket)
+    // the SID frames are sent at the long interval in the silence, their transit times do not
+    // tell the jitter of the speech frames
+    bool sid = IsSID(nBufferSize);
+
+    if (recovered)
+    {
+        IMLOGD_PACKET2(
+                IM_PACKET_LOG_JITTER, "[Add] recovered seq[%d], TS[%u]", nSeqNum, nTimestamp);
+    }
+    else if (!sid)
     {
         jitter = mJitterAnalyzer.CalculateTransitTimeDifference(nTimestamp, arrivalTime);
-        mBaseTimestamp = currEntry.nTimestamp;
-        mBaseArrivalTime = currEntry.arrivalTime;
-        mJitterAnalyzer.UpdateBaseTimestamp(mBaseTimestamp, mBaseArrivalTime);
+        mJitterAnalyzer.UpdateBaseTimestamp(nTimestamp, arrivalTime);
     }
-    // TODO: remove mBufferIgnoreSIDPacket logic and the statements
-    else if (mBufferIgnoreSIDPacket && !IsSID(currEntry.nBufferSize))
+
+    if (!recovered)
     {
-        // first packet delay compensation
-        if ((mBaseTimestamp == 0 && mBaseArrivalTime == 0) || mNeedToUpdateBasePacket)
-        {
-            mBaseTimestamp = currEntry.nTimestamp;
-            mBaseArrivalTime = currEntry.arrivalTime;
-            mJitterAnalyzer.UpdateBaseTimestamp(mBaseTimestamp, mBaseArrivalTime);
-            mNeedToUpdateBasePacket = false;
-        }
-        else if (mBaseTimestamp > currEntry.nTimestamp || mBaseArrivalTime > currEntry.arrivalTime)
+        RtpPacket* packet = new RtpPacket();
+
+        if (nBufferSize == 0)
         {
-            // rounding case (more consider case)
-            mBaseTimestamp = currEntry.nTimestamp;
-            mBaseArrivalTime = currEntry.arrivalTime;
-            mJitterAnalyzer.UpdateBaseTimestamp(mBaseTimestamp, mBaseArrivalTime);
+            packet->rtpDataType = kRtpDataTypeNoData;
         }
         else
         {
-            // update case
-            if (currEntry.nTimestamp - mBaseTimestamp > currEntry.arrivalTime - mBaseArrivalTime)
-            {
-                mBaseTimestamp = currEntry.nTimestamp;
-                mBaseArrivalTime = currEntry.arrivalTime;
-                mJitterAnalyzer.UpdateBaseTimestamp(mBaseTimestamp, mBaseArrivalTime);
-            }
-            else
-            {
-                // compensation case
-                uint32_t temp = currEntry.arrivalTime;
-                IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "Before compensation[%u], nSeqNum[%d]", temp,
-                        currEntry.nSeqNum);
-                currEntry.arrivalTime = mBaseArrivalTime + (currEntry.nTimestamp - mBaseTimestamp);
-                IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "After compensation[%u], delay[%u]",
-                        currEntry.arrivalTime, temp - currEntry.arrivalTime);
-            }
+            packet->rtpDataType = sid ? kRtpDataTypeSid : kRtpDataTypeNormal;
         }
 
-        jitter = mJitterAnalyzer.CalculateTransitTimeDifference(nTimestamp, arrivalTime);
-    }
+        packet->ssrc = mSsrc;
+        packet->seqNum = nSeqNum;
+        packet->jitter = jitter;
+        packet->arrival = arrivalTime;
+        mCallback->SendEvent(kCollectPacketInfo, kStreamRtpRx, reinterpret_cast<uint64_t>(packet));
 
-    RtpPacket* packet = new RtpPacket();
+        std::lock_guard<std::mutex> guard(mMutex);
 
-    if (nBufferSize == 0)
-    {
-        packet->rtpDataType = kRtpDataTypeNoData;
-    }
-    else
-    {
-        IsSID(currEntry.nBufferSize) ? packet->rtpDataType = kRtpDataTypeSid
-                                     : packet->rtpDataType = kRtpDataTypeNormal;
+        if (mDelayEstimator.IsEnabled() && !sid)
+        {
+            mDelayEstimator.Update(nTimestamp, arrivalTime);
+        }
     }
 
-    packet->ssrc = mSsrc;
-    packet->seqNum = nSeqNum;
-    packet->jitter = jitter;
-    packet->arrival = arrivalTime;
-    mCallback->SendEvent(kCollectPacketInfo, kStreamRtpRx, reinterpret_cast<uint64_t>(packet));
-
     if (nBufferSize == 0)
     {
         return;
@@ -216,43 +241,31 @@ void AudioJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
 
     IMLOGD_PACKET7(IM_PACKET_LOG_JITTER,
             "[Add] seq[%d], bMark[%d], TS[%d], size[%d] subtype[%d] queueSize[%d], arrivalTime[%u]",
-            nSeqNum, bMark, nTimestamp, nBufferSize, subtype, mDataQueue.GetCount() + 1,
+            nSeqNum, bMark, nTimestamp, nBufferSize, subtype, mRingQueue.GetCount() + 1,
             arrivalTime);
 
-    if (mDataQueue.GetCount() == 0)
-    {  // jitter buffer is empty
-        mDataQueue.Add(&currEntry);
-    }
-    else
+    DataEntry* pEntry = nullptr;
+
+    // the frame already recovered from the redundant data or arrived
+    if (mRingQueue.Find(nSeqNum, nTimestamp, &pEntry) && IsDuplicated(pEntry, &currEntry))
     {
-        DataEntry* pEntry;
-        mDataQueue.GetLast(&pEntry);
+        return;
+    }
 
-        if (pEntry == nullptr)
-        {
-            return;
-        }
+    // the late arrival packet is inserted to its slot and discarded when it is played
+    std::list<uint16_t> droppedSeqs;
 
-        // current data is the latest data
-        if (USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
-        {
-            mDataQueue.Add(&currEntry);
-        }
-        else
-        {
-            // find the position of current data and insert current data to the correct position
-            mDataQueue.SetReadPosFirst();
+    if (!mRingQueue.Insert(&currEntry, &droppedSeqs))
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Add] discard too old seq[%d], TS[%u]", nSeqNum,
+                nTimestamp);
+        CollectRxRtpStatus(nSeqNum, kRtpStatusDiscarded);
+    }
 
-            for (int32_t i = 0; mDataQueue.GetNext(&pEntry); i++)
-            {
-                // late arrival packet
-                if (!USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
-                {
-                    mDataQueue.InsertAt(i, &currEntry);
-                    break;
-                }
-            }
-        }
+    // the frames dropped by the jump of the sequence number are not played
+    for (uint16_t seq : droppedSeqs)
+    {
+        CollectRxRtpStatus(seq, kRtpStatusDiscarded);
     }
 }
 
@@ -264,15 +277,32 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
     DataEntry* pEntry = nullptr;
     bool bForceToPlay = false;
     mCheckUpdateJitterPacketCnt++;
+    mPartialCopyPlayed = false;
 
     // update jitter buffer size
-    if (mCheckUpdateJitterPacketCnt * FRAME_INTERVAL > JITTER_BUFFER_UPDATE_INTERVAL)
+    if (mDelayEstimator.IsEnabled())
     {
-        mCurrJitterBufferSize =
+        // the frames of the target delay and the frame playing
+        uint32_t targetSize =
+                (mDelayEstimator.GetTargetDelay() + FRAME_INTERVAL - 1) / FRAME_INTERVAL + 1;
+        mNextJitterBufferSize =
+                std::min(std::max(targetSize, mMinJitterBufferSize), mMaxJitterBufferSize);
+    }
+    else if (mCheckUpdateJitterPacketCnt * FRAME_INTERVAL > JITTER_BUFFER_UPDATE_INTERVAL)
+    {
+        mNextJitterBufferSize =
                 mJitterAnalyzer.GetNextJitterBufferSize(mCurrJitterBufferSize, currentTime);
         mCheckUpdateJitterPacketCnt = 0;
     }
 
+    // the size changes in the talk spurt are held until the silence when the dtx is used
+    if (mNextJitterBufferSize != mCurrJitterBufferSize && (!mDtxOn || IsSilence()))
+    {
+        IMLOGD_PACKET3(IM_PACKET_LOG_JITTER, "[Get] dtx[%d], size[%u -> %u]", mDtxOn,
+                mCurrJitterBufferSize, mNextJitterBufferSize);
+        mCurrJitterBufferSize = mNextJitterBufferSize;
+    }
+
     // enforce update when breach the reset threshold
     if (mCannotGetCount * FRAME_INTERVAL > RESET_THRESHOLD)
     {
@@ -282,7 +312,7 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
         mCannotGetCount = 0;
     }
 
-    if (mDataQueue.GetCount() == 0)
+    if (mRingQueue.GetCount() == 0)
     {
         IMLOGD_PACKET0(IM_PACKET_LOG_JITTER, "[Get] fail - empty");
 
@@ -293,7 +323,7 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
 
         return false;
     }
-    else if (mDataQueue.Get(&pEntry) && mWaiting)
+    else if (mRingQueue.Get(&pEntry) && mWaiting)
     {
         uint32_t jitterDelay = currentTime - pEntry->arrivalTime;
 
@@ -314,7 +344,7 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
 
             IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
                     "[Get] Wait - seq[%u], CurrJBSize[%u], delay[%u], QueueCount[%u]",
-                    pEntry->nSeqNum, mCurrJitterBufferSize, jitterDelay, mDataQueue.GetCount());
+                    pEntry->nSeqNum, mCurrJitterBufferSize, jitterDelay, mRingQueue.GetCount());
             return false;
         }
         else
@@ -328,14 +358,24 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
             {
                 IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
                         "[Get] Wait - seq[%u], CurrJBSize[%u], delay[%u], QueueCount[%u]",
-                        pEntry->nSeqNum, mCurrJitterBufferSize, jitterDelay, mDataQueue.GetCount());
+                        pEntry->nSeqNum, mCurrJitterBufferSize, jitterDelay, mRingQueue.GetCount());
                 return false;
             }
         }
     }
 
+    if (mCatchUp)
+    {
+        CatchUp(currentTime);
+    }
+    else if (IsSilence() && mRingQueue.Get(&pEntry) && IsTalkSpurtStart(pEntry))
+    {
+        // the new size is applied in the silence before the talk spurt
+        PlaceTalkSpurt(pEntry, currentTime);
+    }
+
     // adjust the playing timestamp
-    if (mDataQueue.Get(&pEntry) && pEntry->nTimestamp != mCurrPlayingTS &&
+    if (mRingQueue.Get(&pEntry) && pEntry->nTimestamp != mCurrPlayingTS &&
             ((mCurrPlayingTS - ALLOWABLE_ERROR) < pEntry->nTimestamp) &&
             (pEntry->nTimestamp < (mCurrPlayingTS + ALLOWABLE_ERROR)))
     {
@@ -344,25 +384,24 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
                 pEntry->nSeqNum);
     }
 
-    while (mDataQueue.Get(&pEntry))
+    while (mRingQueue.Get(&pEntry))
     {
         if (mDeleteCount > mMinJitterBufferSize &&
-                mDataQueue.GetCount() < mCurrJitterBufferSize + 1)
+                mRingQueue.GetCount() < mCurrJitterBufferSize + 1)
         {
             IMLOGD0("[Get] resync");
             uint32_t nTempBuferSize = (mCurrJitterBufferSize + AUDIO_JITTER_BUFFER_MIN_SIZE) / 2;
 
-            if (mDataQueue.GetCount() >= nTempBuferSize)
+            if (mRingQueue.GetCount() >= nTempBuferSize)
             {
                 mCurrPlayingTS = pEntry->nTimestamp;
             }
             else
             {
                 mCurrPlayingTS = pEntry->nTimestamp -
-                        (nTempBuferSize - mDataQueue.GetCount()) * FRAME_INTERVAL;
+                        (nTempBuferSize - mRingQueue.GetCount()) * FRAME_INTERVAL;
             }
 
-            mNeedToUpdateBasePacket = true;
             mDeleteCount = 0;
             break;
         }
@@ -396,50 +435,50 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
 
             CollectRxRtpStatus(pEntry->nSeqNum, kRtpStatusLate);
             mDeleteCount++;
-            mDataQueue.Delete();
+            mRingQueue.Delete();
             IMLOGD_PACKET0(IM_PACKET_LOG_JITTER, "[Get] delete late arrival");
         }
     }
 
     // decrease jitter buffer
-    if (mDtxOn && mSIDCount > 4 && mDataQueue.GetCount() > mCurrJitterBufferSize)
+    if (mDtxOn && mSIDCount > 4 && mRingQueue.GetCount() > mCurrJitterBufferSize)
     {
-        if (mDataQueue.Get(&pEntry) && IsSID(pEntry->nBufferSize))
+        if (mRingQueue.Get(&pEntry) && IsSID(pEntry->nBufferSize))
         {
             IMLOGD_PACKET5(IM_PACKET_LOG_JITTER,
                     "[Get] delete SID - seq[%d], mark[%d], TS[%u], currTS[%u], queue[%d]",
                     pEntry->nSeqNum, pEntry->bMark, pEntry->nTimestamp, mCurrPlayingTS,
-                    mDataQueue.GetCount());
+                    mRingQueue.GetCount());
 
             mSIDCount++;
             mDtxOn = true;
             CollectRxRtpStatus(pEntry->nSeqNum, kRtpStatusDiscarded);
             mDeleteCount++;
-            mDataQueue.Delete();
+            mRingQueue.Delete();
             bForceToPlay = true;
         }
     }
 
     // add condition in case of changing Seq# & TS
-    if (mDataQueue.Get(&pEntry) && (pEntry->nTimestamp - mCurrPlayingTS) > TS_ROUND_QUARD)
+    if (mRingQueue.Get(&pEntry) && (pEntry->nTimestamp - mCurrPlayingTS) > TS_ROUND_QUARD)
     {
         IMLOGD4("[Get] TS changing case, enforce play [ %d / %u / %u / %d ]", pEntry->nSeqNum,
-                pEntry->nTimestamp, mCurrPlayingTS, mDataQueue.GetCount());
+                pEntry->nTimestamp, mCurrPlayingTS, mRingQueue.GetCount());
         bForceToPlay = true;
     }
 
     if (mEnforceUpdate)
     {
         // removing delete packet in min JitterBuffer size
-        if (mDataQueue.GetCount() > mCurrJitterBufferSize + 1)
+        if (mRingQueue.GetCount() > mCurrJitterBufferSize + 1)
         {
-            if (mDataQueue.Get(&pEntry))
+            if (mRingQueue.Get(&pEntry))
             {
                 IMLOGD_PACKET5(IM_PACKET_LOG_JITTER,
                         "[Get] Delete Packets - seq[%d], bMark[%d], TS[%u], curTS[%u], "
                         "size[%d]",
                         pEntry->nSeqNum, pEntry->bMark, pEntry->nTimestamp, mCurrPlayingTS,
-                        mDataQueue.GetCount());
+                        mRingQueue.GetCount());
 
                 if (IsSID(pEntry->nBufferSize))
                 {
@@ -455,15 +494,15 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
                 }
 
                 CollectRxRtpStatus(pEntry->nSeqNum, kRtpStatusDiscarded);
-                mDataQueue.Delete();
+                mRingQueue.Delete();
                 bForceToPlay = true;
             }
         }
 
         mEnforceUpdate = false;
 
-        if ((mDataQueue.GetCount() < 2) ||
-                (mDataQueue.GetCount() < mCurrJitterBufferSize - mMinJitterBufferSize))
+        if ((mRingQueue.GetCount() < 2) ||
+                (mRingQueue.GetCount() < mCurrJitterBufferSize - mMinJitterBufferSize))
         {
             IMLOGD_PACKET0(IM_PACKET_LOG_JITTER, "[Get] wait stacking");
             return false;
@@ -471,18 +510,18 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
     }
 
     // discard duplicated packet
-    if (mDataQueue.Get(&pEntry) && mFirstFrameReceived && pEntry->nSeqNum == mLastPlayedSeqNum)
+    if (mRingQueue.Get(&pEntry) && mFirstFrameReceived && pEntry->nSeqNum == mLastPlayedSeqNum)
     {
         IMLOGD_PACKET6(IM_PACKET_LOG_JITTER,
                 "[Get] duplicate - curTS[%u], seq[%d], Mark[%d], TS[%u], size[%d], queue[%d]",
                 mCurrPlayingTS, pEntry->nSeqNum, pEntry->bMark, pEntry->nTimestamp,
-                pEntry->nBufferSize, mDataQueue.GetCount());
+                pEntry->nBufferSize, mRingQueue.GetCount());
         CollectRxRtpStatus(pEntry->nSeqNum, kRtpStatusDuplicated);
-        mDataQueue.Delete();
+        mRingQueue.Delete();
         mDeleteCount++;
     }
 
-    if (mDataQueue.Get(&pEntry) &&
+    if (mRingQueue.Get(&pEntry) &&
             (pEntry->nTimestamp == mCurrPlayingTS || bForceToPlay ||
                     (pEntry->nTimestamp < TS_ROUND_QUARD && mCurrPlayingTS > 0xFFFF)))
     {
@@ -526,7 +565,7 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
         IMLOGD_PACKET7(IM_PACKET_LOG_JITTER,
                 "[Get] OK - dtx[%d], curTS[%u], seq[%u], TS[%u], size[%u], delay[%u], queue[%u]",
                 mDtxOn, mCurrPlayingTS, pEntry->nSeqNum, pEntry->nTimestamp, pEntry->nBufferSize,
-                currentTime - pEntry->arrivalTime, mDataQueue.GetCount());
+                currentTime - pEntry->arrivalTime, mRingQueue.GetCount());
 
         mCurrPlayingTS = pEntry->nTimestamp + FRAME_INTERVAL;
         mFirstFrameReceived = true;
@@ -537,10 +576,34 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
                 mCurrJitterBufferSize * FRAME_INTERVAL, mMaxJitterBufferSize * FRAME_INTERVAL);
         return true;
     }
-    else
+    else if (!mDtxOn && FindPartialCopy(mCurrPlayingTS, &pEntry))
     {
-        // TODO: check EVS redundancy in channel aware mode
+        // the recovery is reported by the player once the partial copy is decoded, the sequence
+        // number of the lost frame is not known when the packets carry several frames
+        if (psubtype)
+            *psubtype = MEDIASUBTYPE_AUDIO_PARTIAL_COPY;
+        if (ppData)
+            *ppData = pEntry->pbBuffer;
+        if (pnDataSize)
+            *pnDataSize = pEntry->nBufferSize;
+        if (pnTimestamp)
+            *pnTimestamp = mCurrPlayingTS;
+        if (pbMark)
+            *pbMark = false;
+        if (pnSeqNum)
+            *pnSeqNum = pEntry->nSeqNum;
 
+        IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
+                "[Get] partial copy - curTS[%u], from seq[%u], queue[%u]", mCurrPlayingTS,
+                pEntry->nSeqNum, mRingQueue.GetCount());
+
+        mCurrPlayingTS += FRAME_INTERVAL;
+        mCannotGetCount = 0;
+        mPartialCopyPlayed = true;
+        return true;
+    }
+    else
+    {
         if (!mDtxOn)
         {
             mCannotGetCount++;
@@ -569,6 +632,85 @@ bool AudioJitterBuffer::Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_
     return false;
 }
 
+void AudioJitterBuffer::Delete()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mPartialCopyPlayed)
+    {
+        mPartialCopyPlayed = false;
+        return;
+    }
+
+    mRingQueue.Delete();
+}
+
+int32_t AudioJitterBuffer::GetDepthError()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    // the frames queued in the silence are the SID frames sent at the long interval
+    if (mWaiting || IsSilence())
+    {
+        return 0;
+    }
+
+    return static_cast<int32_t>(mRingQueue.GetCount()) -
+            static_cast<int32_t>(mCurrJitterBufferSize);
+}
+
+bool AudioJitterBuffer::FindPartialCopy(uint32_t timestamp, DataEntry** entry)
+{
+    if (mCodecType != kAudioCodecEvs || mEvsRedundantFrameOffset <= 0 || !mFirstFrameReceived)
+    {
+        return false;
+    }
+
+    uint32_t partialCopyTimestamp = timestamp + mEvsRedundantFrameOffset * FRAME_INTERVAL;
+    DataEntry* pEntry = nullptr;
+    mRingQueue.SetReadPosFirst();
+
+    while (mRingQueue.GetNext(&pEntry))
+    {
+        if (pEntry->nTimestamp == partialCopyTimestamp)
+        {
+            if (IsSID(pEntry->nBufferSize))
+            {
+                return false;
+            }
+
+            *entry = pEntry;
+            return true;
+        }
+
+        // the queue is ordered by the sequence number
+        if (static_cast<int32_t>(pEntry->nTimestamp - partialCopyTimestamp) > 0)
+        {
+            break;
+        }
+    }
+
+    return false;
+}
+
+bool AudioJitterBuffer::IsDuplicated(DataEntry* entry, DataEntry* newEntry)
+{
+    // the duplicated packets are counted when they are played
+    if (entry->eDataType != MEDIASUBTYPE_AUDIO_RED && newEntry->eDataType != MEDIASUBTYPE_AUDIO_RED)
+    {
+        return false;
+    }
+
+    if (entry->nSeqNum == newEntry->nSeqNum && entry->nTimestamp == newEntry->nTimestamp)
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[IsDuplicated] discard seq[%d], TS[%u]",
+                newEntry->nSeqNum, newEntry->nTimestamp);
+        return true;
+    }
+
+    return false;
+}
+
 bool AudioJitterBuffer::IsSID(uint32_t frameSize)
 {
     switch (mCodecType)
@@ -597,14 +739,14 @@ bool AudioJitterBuffer::Resync(uint32_t currentTime)
     IMLOGD0("[Resync]");
     DataEntry* entry = nullptr;
 
-    while (mDataQueue.Get(&entry))
+    while (mRingQueue.Get(&entry))
     {
         uint32_t timeDiff = currentTime - entry->arrivalTime;
 
         if (timeDiff > mCurrJitterBufferSize * FRAME_INTERVAL + ALLOWABLE_ERROR)
         {
             CollectRxRtpStatus(entry->nSeqNum, kRtpStatusDiscarded);
-            mDataQueue.Delete();
+            mRingQueue.Delete();
         }
         else
         {
@@ -623,6 +765,220 @@ bool AudioJitterBuffer::Resync(uint32_t currentTime)
     return false;
 }
 
+bool AudioJitterBuffer::IsSilence()
+{
+    return mDtxOn && mSIDCount > 0;
+}
+
+bool AudioJitterBuffer::IsTalkSpurtStart(DataEntry* entry)
+{
+    // the marker bit is set to the first frame of the talk spurt, the speech frame after the SID
+    // frame is the start of the talk spurt when the packet of the marker bit is lost
+    return entry->bMark || !IsSID(entry->nBufferSize);
+}
+
+void AudioJitterBuffer::PlaceTalkSpurt(DataEntry* entry, uint32_t currentTime)
+{
+    // the first frame of the talk spurt is played the jitter buffer size after its arrival
+    int32_t waitTime =
+            entry->arrivalTime + (mCurrJitterBufferSize - 1) * FRAME_INTERVAL - currentTime;
+    uint32_t waitFrames = waitTime > 0 ? (waitTime + FRAME_INTERVAL - 1) / FRAME_INTERVAL : 0;
+    uint32_t playingTs = entry->nTimestamp - waitFrames * FRAME_INTERVAL;
+
+    if (playingTs != mCurrPlayingTS)
+    {
+        IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
+                "[PlaceTalkSpurt] seq[%u], TS[%u], currTS[%u -> %u]", entry->nSeqNum,
+                entry->nTimestamp, mCurrPlayingTS, playingTs);
+        mCurrPlayingTS = playingTs;
+    }
+}
+
+bool AudioJitterBuffer::CheckDelayStep(uint32_t timestamp, uint32_t arrivalTime)
+{
+    int32_t transitTime = arrivalTime - timestamp;
+    bool step = false;
+
+    if (mTransitTimes.GetCount() > 0)
+    {
+        // the maximum of the negative transit times is the minimum transit time
+        int32_t delayStep = transitTime + mTransitTimes.GetMax();
+
+        // the larger step is the change of the timestamp, not the delay
+        if (delayStep >= CATCH_UP_DELAY_STEP && delayStep < RESET_THRESHOLD)
+        {
+            mDelayStepCount++;
+        }
+        else
+        {
+            mDelayStepCount = 0;
+        }
+
+        // a single late packet is the jitter, the packets held by the network keep the step
+        if (mDelayStepCount >= CATCH_UP_STEP_PACKETS)
+        {
+            IMLOGD2("[CheckDelayStep] step[%d], TS[%u]", delayStep, timestamp);
+            step = true;
+            mDelayStepCount = 0;
+            // the minimum is measured again in the new path
+            mTransitTimes.Reset();
+        }
+    }
+
+    mTransitTimes.Add(-transitTime);
+    return step;
+}
+
+void AudioJitterBuffer::CatchUp(uint32_t currentTime)
+{
+    DataEntry* entry = nullptr;
+
+    if (!mCatchUpStarted)
+    {
+        // the queue is played from the oldest frame, the frames over the maximum excess are late
+        if (!mRingQueue.Get(&entry))
+        {
+            return;
+        }
+
+        uint32_t playingTs = mCurrPlayingTS;
+        mCurrPlayingTS = entry->nTimestamp;
+
+        // the step is the higher delay of the path, not the frames held, when they are not queued
+        if (GetExcessDelay() <= CATCH_UP_DELAY_STEP)
+        {
+            IMLOGD1("[CatchUp] cancel - excess[%d]", GetExcessDelay());
+            mCurrPlayingTS = playingTs;
+            mCatchUp = false;
+            return;
+        }
+
+        mCatchUpStarted = true;
+        mCatchUpStartTime = currentTime;
+        mCatchUpStartDelay = GetExcessDelay();
+
+        // the silence in the whole queue is skipped first when it is played, the oldest frames
+        // are discarded only for the excess the silence does not cover
+        while (GetExcessDelay() - GetSilenceDelay() > CATCH_UP_MAX_EXCESS &&
+                mRingQueue.GetCount() > 1)
+        {
+            CollectRxRtpStatus(entry->nSeqNum, kRtpStatusDiscarded);
+            mRingQueue.Delete();
+            mRingQueue.Get(&entry);
+            mCurrPlayingTS = entry->nTimestamp;
+        }
+
+        mWaiting = false;
+        mDeleteCount = 0;
+        IMLOGD3("[CatchUp] start - delay[%d], excess[%d], queue[%u]", mCatchUpStartDelay,
+                GetExcessDelay(), mRingQueue.GetCount());
+    }
+
+    int32_t excessDelay = GetExcessDelay();
+
+    if (excessDelay <= CATCH_UP_STOP_EXCESS)
+    {
+        StopCatchUp(currentTime);
+        return;
+    }
+
+    if (currentTime - mCatchUpStartTime > CATCH_UP_TIMEOUT)
+    {
+        // the excess not played out in time is discarded to converge in the bounded time
+        while (GetExcessDelay() > 0 && mRingQueue.GetCount() > 1 && mRingQueue.Get(&entry))
+        {
+            CollectRxRtpStatus(entry->nSeqNum, kRtpStatusDiscarded);
+            mRingQueue.Delete();
+            mRingQueue.Get(&entry);
+            mCurrPlayingTS = entry->nTimestamp;
+        }
+
+        StopCatchUp(currentTime);
+        return;
+    }
+
+    // the SID frames and the silence between them are skipped at once, it is not heard
+    while (mRingQueue.Get(&entry) && IsSID(entry->nBufferSize) && mRingQueue.GetCount() > 1 &&
+            excessDelay > CATCH_UP_STOP_EXCESS)
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[CatchUp] delete SID - seq[%d], TS[%u]",
+                entry->nSeqNum, entry->nTimestamp);
+        CollectRxRtpStatus(entry->nSeqNum, kRtpStatusDiscarded);
+        mRingQueue.Delete();
+        mRingQueue.Get(&entry);
+        SkipSilence(entry, excessDelay);
+        excessDelay = GetExcessDelay();
+    }
+
+    // the speech frames are played faster by the time stretching of the player
+    SkipSilence(entry, excessDelay);
+}
+
+void AudioJitterBuffer::SkipSilence(DataEntry* entry, int32_t excessDelay)
+{
+    int32_t gap = entry->nTimestamp - mCurrPlayingTS;
+
+    if (gap > 0 && excessDelay > 0)
+    {
+        mCurrPlayingTS += std::min(gap, excessDelay);
+    }
+}
+
+int32_t AudioJitterBuffer::GetExcessDelay()
+{
+    DataEntry* entry = nullptr;
+    int32_t targetDelay = mCurrJitterBufferSize * FRAME_INTERVAL;
+
+    if (!mRingQueue.GetLast(&entry))
+    {
+        return -targetDelay;
+    }
+
+    return static_cast<int32_t>(entry->nTimestamp + FRAME_INTERVAL - mCurrPlayingTS) - targetDelay;
+}
+
+int32_t AudioJitterBuffer::GetSilenceDelay()
+{
+    DataEntry* entry = nullptr;
+    int32_t silence = 0;
+    uint32_t prevEnd = mCurrPlayingTS;
+    mRingQueue.SetReadPosFirst();
+
+    while (mRingQueue.GetNext(&entry))
+    {
+        int32_t gap = entry->nTimestamp - prevEnd;
+
+        if (gap > 0)
+        {
+            silence += gap;
+        }
+
+        if (IsSID(entry->nBufferSize))
+        {
+            silence += FRAME_INTERVAL;
+        }
+
+        prevEnd = entry->nTimestamp + FRAME_INTERVAL;
+    }
+
+    return silence;
+}
+
+void AudioJitterBuffer::StopCatchUp(uint32_t currentTime)
+{
+    int32_t recovered = mCatchUpStartDelay - std::max(GetExcessDelay(), 0);
+    uint32_t duration = currentTime - mCatchUpStartTime;
+    IMLOGD2("[StopCatchUp] recovered[%d], duration[%u]", recovered, duration);
+    mCatchUp = false;
+
+    if (mCallback != nullptr)
+    {
+        SessionCallbackParameter* param =
+                new SessionCallbackParameter(kReportCatchUp, duration, std::max(recovered, 0));
+        mCallback->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+    }
+}
+
 void AudioJitterBuffer::CollectRxRtpStatus(int32_t seq, kRtpPacketStatus status)
 {
     IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[CollectRxRtpStatus] seq[%d], status[%d]", seq, status);
@@ -432,6 +432,7 @@ void AudioManager::RequestHandler::processEvent(
         break;
         case kRequestAudioCmr:
         case kRequestSendRtcpXrReport:
+        case kRequestAudioFrameAggregation:
             sManager->SendInternalEvent(event, static_cast<int>(sessionId), paramA, paramB);
             break;
         default:
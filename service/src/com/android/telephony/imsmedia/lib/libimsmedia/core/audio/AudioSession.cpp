@@ -223,7 +223,9 @@ ImsMediaResult AudioSession::startGraph(RtpConfig* config)
     }
     else
     {
-        mListGraphRtcp.push_back(new AudioStreamGraphRtcp(this, mRtcpFd));
+        // with rtcp-mux, rtcp shares the socket of rtp
+        int rtcpFd = config->getRtcpConfig().getRtcpMuxEnabled() ? mRtpFd : mRtcpFd;
+        mListGraphRtcp.push_back(new AudioStreamGraphRtcp(this, rtcpFd));
 
         if (mListGraphRtcp.back()->create(config) == RESULT_SUCCESS)
         {
@@ -495,6 +497,7 @@ void AudioSession::onEvent(int32_t type, uint64_t param1, uint64_t param2)
             break;
         case kRequestAudioCmr:
         case kRequestSendRtcpXrReport:
+        case kRequestAudioFrameAggregation:
             ImsMediaEventHandler::SendEvent(
                     "AUDIO_REQUEST_EVENT", type, mSessionId, param1, param2);
             break;
@@ -602,6 +605,18 @@ void AudioSession::SendInternalEvent(int32_t type, uint64_t param1, uint64_t par
                 }
             }
             break;
+        case kRequestAudioFrameAggregation:
+            for (std::list<AudioStreamGraphRtpTx*>::iterator iter = mListGraphRtpTx.begin();
+                    iter != mListGraphRtpTx.end(); iter++)
+            {
+                AudioStreamGraphRtpTx* graph = *iter;
+
+                if (graph != nullptr && graph->getState() == kStreamStateRunning)
+                {
+                    graph->processFrameAggregation(static_cast<uint32_t>(param1));
+                }
+            }
+            break;
         case kRequestSendRtcpXrReport:
             for (std::list<AudioStreamGraphRtcp*>::iterator iter = mListGraphRtcp.begin();
                     iter != mListGraphRtcp.end(); iter++)
@@ -45,7 +45,9 @@ ImsMediaResult AudioStreamGraphRtcp::create(RtpConfig* config)
     char localIp[MAX_IP_LEN];
     uint32_t localPort = 0;
     ImsMediaNetworkUtil::getLocalIpPortFromSocket(mLocalFd, localIp, MAX_IP_LEN, localPort);
-    RtpAddress localAddress(localIp, localPort - 1);
+    // the rtp session is bound to the rtp port, which is the socket port itself with rtcp-mux
+    uint32_t rtpPort = config->getRtcpConfig().getRtcpMuxEnabled() ? localPort : localPort - 1;
+    RtpAddress localAddress(localIp, rtpPort);
     (static_cast<RtcpEncoderNode*>(pNodeRtcpEncoder))->SetLocalAddress(localAddress);
     pNodeRtcpEncoder->SetConfig(config);
     AddNode(pNodeRtcpEncoder);
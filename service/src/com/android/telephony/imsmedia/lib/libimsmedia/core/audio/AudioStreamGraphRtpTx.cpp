@@ -74,7 +74,7 @@ ImsMediaResult AudioStreamGraphRtpTx::create(RtpConfig* config)
     pNodeRtpEncoder->ConnectRearNode(pNodeSocketWriter);
     setState(StreamState::kStreamStateCreated);
 
-    if (!createDtmfGraph(mConfig, pNodeRtpEncoder))
+    if (!createDtmfGraph(mConfig, pNodeRtpEncoder, pNodeRtpPayloadEncoder))
     {
         IMLOGE0("[create] fail to create dtmf graph");
     }
@@ -171,7 +171,8 @@ ImsMediaResult AudioStreamGraphRtpTx::start()
     return RESULT_SUCCESS;
 }
 
-bool AudioStreamGraphRtpTx::createDtmfGraph(RtpConfig* config, BaseNode* rtpEncoderNode)
+bool AudioStreamGraphRtpTx::createDtmfGraph(
+        RtpConfig* config, BaseNode* rtpEncoderNode, BaseNode* payloadEncoderNode)
 {
     if (config == nullptr)
     {
@@ -201,6 +202,11 @@ bool AudioStreamGraphRtpTx::createDtmfGraph(RtpConfig* config, BaseNode* rtpEnco
         pDtmfEncoderNode->ConnectRearNode(rtpEncoderNode);
     }
 
+    if (payloadEncoderNode != nullptr)
+    {
+        pDtmfEncoderNode->ConnectRearNode(payloadEncoderNode);
+    }
+
     return true;
 }
 
@@ -245,6 +251,16 @@ void AudioStreamGraphRtpTx::processCmr(const uint32_t cmr)
     }
 }
 
+void AudioStreamGraphRtpTx::processFrameAggregation(const uint32_t numFrames)
+{
+    BaseNode* node = findNode(kNodeIdAudioPayloadEncoder);
+
+    if (node != nullptr)
+    {
+        (reinterpret_cast<AudioRtpPayloadEncoderNode*>(node))->SetNumFramesPerPacket(numFrames);
+    }
+}
+
 void AudioStreamGraphRtpTx::sendRtpHeaderExtension(std::list<RtpHeaderExtension>* listExtension)
 {
     BaseNode* node = findNode(kNodeIdRtpEncoder);
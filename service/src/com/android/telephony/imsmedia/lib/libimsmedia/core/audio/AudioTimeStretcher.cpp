@@ -0,0 +1,169 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <AudioTimeStretcher.h>
+#include <ImsMediaTrace.h>
+#include <algorithm>
+#include <cmath>
+
+#define DEFAULT_SAMPLING_RATE (8000)
+#define MIN_RATE              (0.9)
+#define MAX_RATE              (1.1)
+#define OVERLAP_DURATION      (10)  // milliseconds
+#define SEARCH_RANGE_DURATION (5)   // milliseconds
+
+AudioTimeStretcher::AudioTimeStretcher()
+{
+    mRate = 1.0;
+    SetSamplingRate(DEFAULT_SAMPLING_RATE);
+}
+
+AudioTimeStretcher::~AudioTimeStretcher() {}
+
+void AudioTimeStretcher::SetSamplingRate(uint32_t samplingRate)
+{
+    mSamplingRate = samplingRate > 0 ? samplingRate : DEFAULT_SAMPLING_RATE;
+    mOverlap = mSamplingRate * OVERLAP_DURATION / 1000;
+    mSearchRange = mSamplingRate * SEARCH_RANGE_DURATION / 1000;
+    mFadeIn.resize(mOverlap);
+
+    // the raised cosine, the fade out is 1 - the fade in
+    for (int32_t i = 0; i < mOverlap; i++)
+    {
+        mFadeIn[i] = 0.5f - 0.5f * cosf(M_PI * (i + 0.5f) / mOverlap);
+    }
+
+    Reset();
+}
+
+void AudioTimeStretcher::SetRate(double rate)
+{
+    mRate = std::min(std::max(rate, MIN_RATE), MAX_RATE);
+}
+
+double AudioTimeStretcher::GetRate()
+{
+    return mRate;
+}
+
+void AudioTimeStretcher::Reset()
+{
+    mInput.clear();
+    // the continuation of the previous segment is the start of the input
+    mPrevPos = -mOverlap;
+    mNominalPos = 0;
+}
+
+uint32_t AudioTimeStretcher::Process(
+        const int16_t* input, uint32_t numInput, int16_t* output, uint32_t maxOutput)
+{
+    if (input != nullptr && numInput > 0)
+    {
+        mInput.insert(mInput.end(), input, input + numInput);
+    }
+
+    uint32_t numOutput = 0;
+
+    while (numOutput + mOverlap <= maxOutput)
+    {
+        int32_t templatePos = mPrevPos + mOverlap;
+        int32_t nominalPos = static_cast<int32_t>(mNominalPos + 0.5);
+
+        if (templatePos + mOverlap > static_cast<int32_t>(mInput.size()) ||
+                nominalPos + mSearchRange + mOverlap > static_cast<int32_t>(mInput.size()))
+        {
+            break;
+        }
+
+        int32_t pos = FindBestPosition(templatePos, nominalPos);
+
+        for (int32_t i = 0; i < mOverlap; i++)
+        {
+            float sample = mInput[templatePos + i] * (1.0f - mFadeIn[i]) +
+                    mInput[pos + i] * mFadeIn[i];
+            output[numOutput++] = static_cast<int16_t>(lrintf(sample));
+        }
+
+        mPrevPos = pos;
+        mNominalPos += mOverlap * mRate;
+    }
+
+    // the samples not used by the next segments
+    int32_t numUsed = std::min(mPrevPos + mOverlap,
+            static_cast<int32_t>(mNominalPos + 0.5) - mSearchRange);
+
+    if (numUsed > 2 * mOverlap)
+    {
+        mInput.erase(mInput.begin(), mInput.begin() + numUsed);
+        mPrevPos -= numUsed;
+        mNominalPos -= numUsed;
+    }
+
+    return numOutput;
+}
+
+uint32_t AudioTimeStretcher::GetNumBuffered()
+{
+    int32_t numBuffered = static_cast<int32_t>(mInput.size()) - (mPrevPos + mOverlap);
+    return numBuffered > 0 ? numBuffered : 0;
+}
+
+int32_t AudioTimeStretcher::FindBestPosition(int32_t templatePos, int32_t nominalPos)
+{
+    int32_t minPos = std::max(nominalPos - mSearchRange, 0);
+    int32_t maxPos = nominalPos + mSearchRange;
+
+    // the natural continuation is kept when there is no better one, the output is the input
+    // itself with the rate of 1
+    int32_t naturalPos = std::min(std::max(templatePos, minPos), maxPos);
+    int32_t bestPos = naturalPos;
+    double bestScore = -1;
+    const int16_t* templ = &mInput[templatePos];
+
+    // the energy of the candidate segment sliding by a sample
+    double energy = 0;
+
+    for (int32_t i = 0; i < mOverlap; i++)
+    {
+        energy += static_cast<double>(mInput[minPos + i]) * mInput[minPos + i];
+    }
+
+    for (int32_t pos = minPos; pos <= maxPos; pos++)
+    {
+        if (pos > minPos)
+        {
+            double removed = mInput[pos - 1];
+            double added = mInput[pos + mOverlap - 1];
+            energy += added * added - removed * removed;
+        }
+
+        int64_t correlation = 0;
+
+        for (int32_t i = 0; i < mOverlap; i++)
+        {
+            correlation += static_cast<int32_t>(templ[i]) * mInput[pos + i];
+        }
+
+        double score = correlation / sqrt(std::max(energy, 1.0));
+
+        if (score > bestScore || (pos == naturalPos && score >= bestScore))
+        {
+            bestScore = score;
+            bestPos = pos;
+        }
+    }
+
+    return bestPos;
+}
@@ -36,6 +36,11 @@ using namespace android::telephony::imsmedia;
 #define TIMER_INTERVAL                           (1000)   // 1 sec
 #define STOP_TIMEOUT                             (1000)   // 1 sec
 #define MESSAGE_PROCESSING_INTERVAL              (20000)  // 20 msec
+#define AUDIO_FRAME_INTERVAL                     (20)     // 20 msec
+#define MAX_FRAMES_PER_PACKET                    (4)
+#define FRACTION_LOST_AGGREGATION_UP             (13)   // about 5 % in 1/256 unit
+#define FRACTION_LOST_AGGREGATION_DOWN           (5)    // about 2 % in 1/256 unit
+#define MAX_ONE_WAY_DELAY_FOR_AGGREGATION        (150)  // 150 msec
 #define MEDIA_DIRECTION_CONTAINS_RECEIVE(a)            \
     ((a) == RtpConfig::MEDIA_DIRECTION_SEND_RECEIVE || \
             (a) == RtpConfig::MEDIA_DIRECTION_RECEIVE_ONLY)
@@ -61,6 +66,8 @@ MediaQualityAnalyzer::MediaQualityAnalyzer()
     mCountRtpInactivity = 0;
     mCountRtcpInactivity = 0;
     mNumRtcpPacketReceived = 0;
+    mBaseFramesPerPacket = 1;
+    mMaxFramesPerPacket = 1;
     reset();
 }
 
@@ -74,11 +81,18 @@ MediaQualityAnalyzer::~MediaQualityAnalyzer()
 
 void MediaQualityAnalyzer::setConfig(AudioConfig* config)
 {
+    int32_t ptime = config->getPtimeMillis();
+    int32_t maxPtime = std::max(config->getMaxPtimeMillis(), ptime);
+    mBaseFramesPerPacket = std::max(ptime / AUDIO_FRAME_INTERVAL, 1);
+    mMaxFramesPerPacket = std::max(std::min(maxPtime / AUDIO_FRAME_INTERVAL, MAX_FRAMES_PER_PACKET),
+            static_cast<int32_t>(mBaseFramesPerPacket));
+
     if (!isSameConfig(config))
     {
         reset();
     }
 
+    mFramesPerPacket = std::min(mFramesPerPacket, mMaxFramesPerPacket);
     mIsRxRtpEnabled = MEDIA_DIRECTION_CONTAINS_RECEIVE(config->getMediaDirection());
     mCodecType = config->getCodecType();
     mCodecAttribute = config->getEvsParams().getEvsBandwidth();
@@ -188,15 +202,22 @@ void MediaQualityAnalyzer::collectInfo(const int32_t streamType, RtpPacket* pack
     {
         // for call quality report
         mCallQuality.setNumRtpPacketsReceived(mCallQuality.getNumRtpPacketsReceived() + 1);
-        mCallQualitySumRelativeJitter += packet->jitter;
+        // the relative jitter is of the speech packets only
+        bool sid = packet->rtpDataType == kRtpDataTypeSid;
 
-        if (mCallQuality.getMaxRelativeJitter() < packet->jitter)
+        if (!sid)
         {
-            mCallQuality.setMaxRelativeJitter(packet->jitter);
-        }
+            mCallQualityNumJitterPacket++;
+            mCallQualitySumRelativeJitter += packet->jitter;
+
+            if (mCallQuality.getMaxRelativeJitter() < packet->jitter)
+            {
+                mCallQuality.setMaxRelativeJitter(packet->jitter);
+            }
 
-        mCallQuality.setAverageRelativeJitter(
-                mCallQualitySumRelativeJitter / mCallQuality.getNumRtpPacketsReceived());
+            mCallQuality.setAverageRelativeJitter(
+                    mCallQualitySumRelativeJitter / mCallQualityNumJitterPacket);
+        }
 
         switch (packet->rtpDataType)
         {
@@ -215,11 +236,11 @@ void MediaQualityAnalyzer::collectInfo(const int32_t streamType, RtpPacket* pack
         // for jitter check
         if (mSSRC != packet->ssrc)  // stream is reset
         {
-            mJitterRxPacket = std::abs(packet->jitter);
+            mJitterRxPacket = sid ? 0 : std::abs(packet->jitter);
             // update rtcp-xr params
             mRtcpXrEncoder->setSsrc(packet->ssrc);
         }
-        else
+        else if (!sid)
         {
             mJitterRxPacket =
                     mJitterRxPacket + (double)(std::abs(packet->jitter) - mJitterRxPacket) * 0.0625;
@@ -264,6 +285,9 @@ void MediaQualityAnalyzer::collectOptionalInfo(
         mCallQuality.setAverageRoundTripTime(mSumRoundTripTime / mCountRoundTripTime);
 
         mRtcpXrEncoder->setRoundTripDelay(value);
+
+        // the delay is in 1/65536 seconds unit
+        mRoundTripTime = (static_cast<uint64_t>(value) * 1000) >> 16;
     }
     else if (optionType == kReportPacketLossGap)
     {
@@ -287,6 +311,29 @@ void MediaQualityAnalyzer::collectOptionalInfo(
                 "[collectOptionalInfo] lost packet seq[%d], value[%d], list size[%d]", seq, value,
                 mListLostPacket.size());
     }
+    else if (optionType == kReportPartialCopyRecovered)
+    {
+        mNumPartialCopyRecovered += value;
+        // the timestamp of the frame recovered is given, frames of a packet share a seq number
+        IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[collectOptionalInfo] partial copy TS[%u], total[%u]",
+                seq, mNumPartialCopyRecovered);
+    }
+    else if (optionType == kReportFractionLost)
+    {
+        mFractionLost = value;
+    }
+    else if (optionType == kReportHeaderBytesSaved)
+    {
+        mCallQuality.setNumHeaderBytesSaved(mCallQuality.getNumHeaderBytesSaved() + value);
+    }
+    else if (optionType == kReportCatchUp)
+    {
+        // the duration of the catch-up of the jitter buffer and the latency recovered
+        mNumCatchUp++;
+        mCatchUpLatencyRecovered += value;
+        IMLOGD3("[collectOptionalInfo] catch up duration[%d], recovered[%d], total[%u]", seq,
+                value, mCatchUpLatencyRecovered);
+    }
 }
 
 void MediaQualityAnalyzer::collectRxRtpStatus(
@@ -417,6 +464,7 @@ void MediaQualityAnalyzer::processData(const int32_t timeCount)
     }
 
     processMediaQuality();
+    processFrameAggregation();
 }
 
 void MediaQualityAnalyzer::processMediaQuality()
@@ -561,6 +609,47 @@ void MediaQualityAnalyzer::processMediaQuality()
     }
 }
 
+void MediaQualityAnalyzer::processFrameAggregation()
+{
+    uint32_t frames = mFramesPerPacket;
+
+    // the uplink loss is taken as the congestion of the packet rate, the radio uplink grants
+    // the resources per packet and the headers are larger than a frame of the low rate codecs.
+    // Packing more frames cuts the packets and the header bytes, a lost packet costs more frames
+    // but the loss is expected to drop with the load. A frame is added per report, the ptime is
+    // restored when the loss clears and the delay is limited below.
+    if (mFractionLost >= FRACTION_LOST_AGGREGATION_UP)
+    {
+        frames = std::min(frames + 1, mMaxFramesPerPacket);
+    }
+    else if (mFractionLost < FRACTION_LOST_AGGREGATION_DOWN && frames != mBaseFramesPerPacket)
+    {
+        frames = frames > mBaseFramesPerPacket ? frames - 1 : frames + 1;
+    }
+
+    // the packetization delay is limited when the network and the jitter buffer delay is high
+    while (frames > 1 &&
+            mRoundTripTime / 2 + mCurrentBufferSize + (frames - 1) * AUDIO_FRAME_INTERVAL >
+                    MAX_ONE_WAY_DELAY_FOR_AGGREGATION)
+    {
+        frames--;
+    }
+
+    if (frames == mFramesPerPacket)
+    {
+        return;
+    }
+
+    IMLOGD5("[processFrameAggregation] frames[%u -> %u], fractionLost[%u], rtt[%u], buffer[%u]",
+            mFramesPerPacket, frames, mFractionLost, mRoundTripTime, mCurrentBufferSize);
+    mFramesPerPacket = frames;
+
+    if (mCallback != nullptr)
+    {
+        mCallback->SendEvent(kRequestAudioFrameAggregation, mFramesPerPacket);
+    }
+}
+
 void MediaQualityAnalyzer::notifyCallQuality()
 {
     if (mCallback != nullptr)
@@ -632,6 +721,26 @@ uint32_t MediaQualityAnalyzer::getLostPacketSize()
             });
 }
 
+uint32_t MediaQualityAnalyzer::getPartialCopyRecoveredSize()
+{
+    return mNumPartialCopyRecovered;
+}
+
+uint32_t MediaQualityAnalyzer::getCatchUpCount()
+{
+    return mNumCatchUp;
+}
+
+uint32_t MediaQualityAnalyzer::getCatchUpLatencyRecovered()
+{
+    return mCatchUpLatencyRecovered;
+}
+
+uint32_t MediaQualityAnalyzer::getFramesPerPacket()
+{
+    return mFramesPerPacket;
+}
+
 void MediaQualityAnalyzer::SendEvent(uint32_t event, uint64_t paramA, uint64_t paramB)
 {
     AddEvent(event, paramA, paramB);
@@ -772,12 +881,19 @@ void MediaQualityAnalyzer::reset()
 
     mCallQuality = CallQuality();
     mCallQualitySumRelativeJitter = 0;
+    mCallQualityNumJitterPacket = 0;
     mSumRoundTripTime = 0;
     mCountRoundTripTime = 0;
     mCurrentBufferSize = 0;
     mMaxBufferSize = 0;
     mCallQualityNumRxPacket = 0;
     mCallQualityNumLostPacket = 0;
+    mNumPartialCopyRecovered = 0;
+    mNumCatchUp = 0;
+    mCatchUpLatencyRecovered = 0;
+    mRoundTripTime = 0;
+    mFractionLost = 0;
+    mFramesPerPacket = mBaseFramesPerPacket;
     clearPacketList(mListRxPacket, DELETE_ALL);
     clearPacketList(mListTxPacket, DELETE_ALL);
     clearLostPacketList(DELETE_ALL);
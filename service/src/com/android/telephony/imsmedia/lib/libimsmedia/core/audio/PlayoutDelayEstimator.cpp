@@ -0,0 +1,136 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <PlayoutDelayEstimator.h>
+#include <ImsMediaTrace.h>
+
+#define DEFAULT_PERCENTILE    (0.97)
+#define DEFAULT_ATTACK_RATE   (0.5)
+#define DEFAULT_DECAY_RATE    (0.02)
+#define FORGETTING_FACTOR     (0.998)  // per packet
+#define TRANSIT_WINDOW_SIZE   (100)    // packets, two seconds of 20 ms frames
+
+PlayoutDelayEstimator::PlayoutDelayEstimator() :
+        mTransitTimes(TRANSIT_WINDOW_SIZE)
+{
+    mPercentile = 0;
+    mAttackRate = DEFAULT_ATTACK_RATE;
+    mDecayRate = DEFAULT_DECAY_RATE;
+    Reset();
+}
+
+PlayoutDelayEstimator::~PlayoutDelayEstimator() {}
+
+void PlayoutDelayEstimator::SetOptions(double percentile, double attackRate, double decayRate)
+{
+    mPercentile = percentile > 1 ? DEFAULT_PERCENTILE : percentile;
+    mAttackRate = (attackRate > 0 && attackRate <= 1) ? attackRate : DEFAULT_ATTACK_RATE;
+    mDecayRate = (decayRate > 0 && decayRate <= 1) ? decayRate : DEFAULT_DECAY_RATE;
+    IMLOGD3("[SetOptions] percentile[%.3lf], attack[%.3lf], decay[%.3lf]", mPercentile,
+            mAttackRate, mDecayRate);
+    Reset();
+}
+
+bool PlayoutDelayEstimator::IsEnabled()
+{
+    return mPercentile > 0;
+}
+
+void PlayoutDelayEstimator::Reset()
+{
+    mTransitTimes.Reset();
+
+    for (int32_t i = 0; i < kNumBuckets; i++)
+    {
+        mHistogram[i] = 0;
+    }
+
+    mTargetDelay = 0;
+    mFirstPacket = true;
+}
+
+void PlayoutDelayEstimator::Update(uint32_t timestamp, uint32_t arrivalTime)
+{
+    int32_t transitTime = arrivalTime - timestamp;
+    mTransitTimes.Add(-transitTime);
+    uint32_t delay = transitTime + mTransitTimes.GetMax();
+    uint32_t bucket = delay / kBucketSize;
+
+    if (bucket >= kNumBuckets)
+    {
+        bucket = kNumBuckets - 1;
+    }
+
+    for (int32_t i = 0; i < kNumBuckets; i++)
+    {
+        mHistogram[i] *= FORGETTING_FACTOR;
+    }
+
+    mHistogram[bucket] += 1 - FORGETTING_FACTOR;
+
+    double percentileDelay = GetPercentileDelay();
+
+    if (mFirstPacket)
+    {
+        mTargetDelay = percentileDelay;
+        mFirstPacket = false;
+    }
+    else if (percentileDelay > mTargetDelay)
+    {
+        mTargetDelay += mAttackRate * (percentileDelay - mTargetDelay);
+    }
+    else
+    {
+        mTargetDelay += mDecayRate * (percentileDelay - mTargetDelay);
+    }
+
+    IMLOGD_PACKET3(IM_PACKET_LOG_JITTER, "[Update] delay[%u], percentile[%.1lf], target[%.1lf]",
+            delay, percentileDelay, mTargetDelay);
+}
+
+uint32_t PlayoutDelayEstimator::GetPercentileDelay()
+{
+    double total = 0;
+
+    for (int32_t i = 0; i < kNumBuckets; i++)
+    {
+        total += mHistogram[i];
+    }
+
+    if (total <= 0)
+    {
+        return 0;
+    }
+
+    double sum = 0;
+
+    for (int32_t i = 0; i < kNumBuckets; i++)
+    {
+        sum += mHistogram[i];
+
+        if (sum >= mPercentile * total)
+        {
+            // the upper edge of the bucket
+            return (i + 1) * kBucketSize;
+        }
+    }
+
+    return kNumBuckets * kBucketSize;
+}
+
+uint32_t PlayoutDelayEstimator::GetTargetDelay()
+{
+    return static_cast<uint32_t>(mTargetDelay + 0.5);
+}
@@ -47,6 +47,7 @@ ImsMediaAudioPlayer::ImsMediaAudioPlayer()
     mEvsChAwOffset = 0;
     mEvsBandwidth = kEvsBandwidthNone;
     memset(mBuffer, 0, sizeof(mBuffer));
+    memset(mStretchedBuffer, 0, sizeof(mStretchedBuffer));
     mEvsBitRate = 0;
     mEvsCodecHeaderMode = kRtpPyaloadHeaderModeEvsHeaderFull;
     mIsFirstFrame = false;
@@ -104,6 +105,17 @@ void ImsMediaAudioPlayer::SetOctetAligned(bool isOctetAligned)
     mIsOctetAligned = isOctetAligned;
 }
 
+void ImsMediaAudioPlayer::SetPlaybackRate(double rate)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (rate != mTimeStretcher.GetRate())
+    {
+        IMLOGD_PACKET1(IM_PACKET_LOG_AUDIO, "[SetPlaybackRate] rate[%.2lf]", rate);
+        mTimeStretcher.SetRate(rate);
+    }
+}
+
 bool ImsMediaAudioPlayer::Start()
 {
     char kMimeType[128] = {'\0'};
@@ -127,6 +139,7 @@ bool ImsMediaAudioPlayer::Start()
     }
 
     openAudioStream();
+    mTimeStretcher.SetSamplingRate(mSamplingRate);
 
     if (mAudioStream == nullptr)
     {
@@ -266,7 +279,7 @@ void ImsMediaAudioPlayer::Stop()
     IMLOGD0("[Stop] exit ");
 }
 
-bool ImsMediaAudioPlayer::onDataFrame(uint8_t* buffer, uint32_t size)
+bool ImsMediaAudioPlayer::onDataFrame(uint8_t* buffer, uint32_t size, bool isPartialCopy)
 {
     std::lock_guard<std::mutex> guard(mMutex);
 
@@ -290,7 +303,7 @@ bool ImsMediaAudioPlayer::onDataFrame(uint8_t* buffer, uint32_t size)
     else if (mCodecType == kAudioCodecEvs)
     {
         // TODO: Integration with libEVS is required.
-        return decodeEvs(buffer, size);
+        return decodeEvs(buffer, size, isPartialCopy);
     }
     return false;
 }
@@ -339,7 +352,7 @@ bool ImsMediaAudioPlayer::decodeAmr(uint8_t* buffer, uint32_t size)
             {
                 memcpy(mBuffer, buf, info.size);
                 // call audio write
-                AAudioStream_write(mAudioStream, mBuffer, info.size / 2, 0);
+                writePcm(reinterpret_cast<int16_t*>(mBuffer), info.size / 2);
             }
         }
 
@@ -372,7 +385,7 @@ bool ImsMediaAudioPlayer::decodeAmr(uint8_t* buffer, uint32_t size)
 }
 
 // TODO: Integration with libEVS is required.
-bool ImsMediaAudioPlayer::decodeEvs(uint8_t* buffer, uint32_t size)
+bool ImsMediaAudioPlayer::decodeEvs(uint8_t* buffer, uint32_t size, bool isPartialCopy)
 {
     uint16_t output[PCM_BUFFER_SIZE];
     int decodeSize = 0;
@@ -381,6 +394,14 @@ bool ImsMediaAudioPlayer::decodeEvs(uint8_t* buffer, uint32_t size)
     (void)buffer;
     (void)size;
 
+    if (isPartialCopy)
+    {
+        // TODO: decode the partial copy of the channel aware mode frame with libEVS, it is not
+        // played until then
+        IMLOGD_PACKET1(IM_PACKET_LOG_AUDIO, "[decodeEvs] partial copy not decoded, size[%u]", size);
+        return false;
+    }
+
     if (!mIsEvsInitialized)
     {
         IMLOGD0("[decodeEvs] Decoder has been initialised");
@@ -393,12 +414,26 @@ bool ImsMediaAudioPlayer::decodeEvs(uint8_t* buffer, uint32_t size)
         mIsFirstFrame = true;
     }
 
-    AAudioStream_write(mAudioStream, output, (decodeSize / 2), 0);
+    writePcm(reinterpret_cast<int16_t*>(output), decodeSize / 2);
     memset(output, 0, PCM_BUFFER_SIZE);
 
     return true;
 }
 
+void ImsMediaAudioPlayer::writePcm(int16_t* samples, uint32_t numSamples)
+{
+    // the stretcher keeps the samples of the overlap once it is used
+    if (mTimeStretcher.GetRate() == 1.0 && mTimeStretcher.GetNumBuffered() == 0)
+    {
+        AAudioStream_write(mAudioStream, samples, numSamples, 0);
+        return;
+    }
+
+    uint32_t numOutput = mTimeStretcher.Process(
+            samples, numSamples, mStretchedBuffer, sizeof(mStretchedBuffer) / sizeof(int16_t));
+    AAudioStream_write(mAudioStream, mStretchedBuffer, numOutput, 0);
+}
+
 void ImsMediaAudioPlayer::openAudioStream()
 {
     AAudioStreamBuilder* builder = nullptr;
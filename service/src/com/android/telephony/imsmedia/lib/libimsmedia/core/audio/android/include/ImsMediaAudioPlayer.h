@@ -18,6 +18,7 @@
 #define IMSMEDIA_AUDIO_PLAYER_INCLUDED
 
 #include <ImsMediaAudioDefine.h>
+#include <AudioTimeStretcher.h>
 #include <aaudio/AAudio.h>
 #include <media/NdkMediaCodec.h>
 #include <media/NdkMediaFormat.h>
@@ -96,6 +97,14 @@ public:
      */
     void SetOctetAligned(bool isOctetAligned);
 
+    /**
+     * @brief Sets the playout speed of the decoded audio, the speech is stretched without
+     * changing the pitch to grow or shrink the jitter buffer gradually
+     *
+     * @param rate The playout speed between 0.9 and 1.1, 1 to play as it is
+     */
+    void SetPlaybackRate(double rate);
+
     /**
      * @brief Starts audio player to play the decoded audio frame and ndk audio decoder to decode
      * the given data
@@ -118,17 +127,20 @@ public:
      *
      * @param buffer The audio frames to decode and play
      * @param size The size of encoded audio frame
-     * @return true
-     * @return false
+     * @param isPartialCopy Set true to decode the partial copy of the previous frame carried in
+     * the evs channel aware mode frame instead of the frame itself
+     * @return true The frame is decoded and played
+     * @return false The frame is not decoded
      */
-    virtual bool onDataFrame(uint8_t* buffer, uint32_t size);
+    virtual bool onDataFrame(uint8_t* buffer, uint32_t size, bool isPartialCopy = false);
 
 private:
     void openAudioStream();
     void restartAudioStream();
     static void audioErrorCallback(AAudioStream* stream, void* userData, aaudio_result_t error);
     bool decodeAmr(uint8_t* buffer, uint32_t size);
-    bool decodeEvs(uint8_t* buffer, uint32_t size);
+    bool decodeEvs(uint8_t* buffer, uint32_t size, bool isPartialCopy);
+    void writePcm(int16_t* samples, uint32_t numSamples);
 
     AAudioStream* mAudioStream;
     AMediaCodec* mCodec;
@@ -139,6 +151,8 @@ private:
     int32_t mEvsChAwOffset;
     kEvsBandwidth mEvsBandwidth;
     uint16_t mBuffer[PCM_BUFFER_SIZE];
+    AudioTimeStretcher mTimeStretcher;
+    int16_t mStretchedBuffer[PCM_BUFFER_SIZE * 2];
     std::mutex mMutex;
     int32_t mEvsBitRate;
     kRtpPyaloadHeaderMode mEvsCodecHeaderMode;
@@ -34,6 +34,10 @@ AudioRtpPayloadDecoderNode::AudioRtpPayloadDecoderNode(BaseSessionCallback* call
     mCoreEvsMode = 0;
     mEvsOffset = 0;
     EvsChAOffset = 0;
+    mSamplingRate = 0;
+    mRedundancyDistance = 0;
+    mPrimaryReceived = false;
+    mLastPrimaryTimestamp = 0;
 }
 
 AudioRtpPayloadDecoderNode::~AudioRtpPayloadDecoderNode() {}
@@ -51,6 +55,8 @@ ImsMediaResult AudioRtpPayloadDecoderNode::Start()
 
     mPrevCMR = mCodecType == kAudioCodecEvs ? 127 : 15;
     mListFrameType.clear();
+    mPrimaryReceived = false;
+    mLastPrimaryTimestamp = 0;
     mNodeState = kNodeStateRunning;
     return RESULT_SUCCESS;
 }
@@ -89,6 +95,9 @@ void AudioRtpPayloadDecoderNode::SetConfig(void* config)
                     (kRtpPyaloadHeaderMode)pConfig->getEvsParams().getUseHeaderFullOnly();
             mEvsOffset = pConfig->getEvsParams().getChannelAwareMode();
         }
+
+        mSamplingRate = pConfig->getSamplingRateKHz();
+        mRedundancyDistance = pConfig->getRedundancyDistance();
     }
 }
 
@@ -98,6 +107,12 @@ bool AudioRtpPayloadDecoderNode::IsSameConfig(void* config)
         return true;
     AudioConfig* pConfig = reinterpret_cast<AudioConfig*>(config);
 
+    if (mSamplingRate != pConfig->getSamplingRateKHz() ||
+            mRedundancyDistance != pConfig->getRedundancyDistance())
+    {
+        return false;
+    }
+
     if (mCodecType == ImsMediaAudioUtil::ConvertCodecType(pConfig->getCodecType()))
     {
         if (mCodecType == kAudioCodecAmr || mCodecType == kAudioCodecAmrWb)
@@ -129,11 +144,31 @@ void AudioRtpPayloadDecoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, ui
         return;
     }
 
+    if (subtype == MEDIASUBTYPE_AUDIO_RED)
+    {
+        DecodeRedundantPayload(pData, nDataSize, nTimestamp, bMark, nSeqNum, arrivalTime);
+        return;
+    }
+
+    DecodePayload(pData, nDataSize, nTimestamp, bMark, nSeqNum, nDataType, arrivalTime);
+}
+
+void AudioRtpPayloadDecoderNode::DecodePayload(uint8_t* pData, uint32_t nDataSize,
+        uint32_t nTimestamp, bool bMark, uint32_t nSeqNum, ImsMediaSubType nDataType,
+        uint32_t arrivalTime)
+{
+    if (nDataType != MEDIASUBTYPE_AUDIO_RED &&
+            (!mPrimaryReceived || static_cast<int32_t>(nTimestamp - mLastPrimaryTimestamp) > 0))
+    {
+        mLastPrimaryTimestamp = nTimestamp;
+        mPrimaryReceived = true;
+    }
+
     switch (mCodecType)
     {
         case kAudioCodecAmr:
         case kAudioCodecAmrWb:
-            DecodePayloadAmr(pData, nDataSize, nTimestamp, nSeqNum, arrivalTime);
+            DecodePayloadAmr(pData, nDataSize, nTimestamp, nSeqNum, nDataType, arrivalTime);
             break;
         case kAudioCodecPcmu:
         case kAudioCodecPcma:
@@ -141,7 +176,7 @@ void AudioRtpPayloadDecoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, ui
                     MEDIASUBTYPE_RTPPAYLOAD, pData, nDataSize, nTimestamp, bMark, nSeqNum);
             break;
         case kAudioCodecEvs:
-            DecodePayloadEvs(pData, nDataSize, nTimestamp, bMark, nSeqNum, arrivalTime);
+            DecodePayloadEvs(pData, nDataSize, nTimestamp, bMark, nSeqNum, nDataType, arrivalTime);
             break;
         default:
             IMLOGE1("[OnDataFromFrontNode] invalid codec type[%d]", mCodecType);
@@ -151,8 +186,78 @@ void AudioRtpPayloadDecoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, ui
     }
 }
 
+void AudioRtpPayloadDecoderNode::DecodeRedundantPayload(uint8_t* pData, uint32_t nDataSize,
+        uint32_t nTimestamp, bool bMark, uint32_t nSeqNum, uint32_t arrivalTime)
+{
+    if (pData == nullptr || nDataSize == 0)
+    {
+        return;
+    }
+
+    uint32_t offsets[AUDIO_RED_MAX_LEVEL];
+    uint32_t lengths[AUDIO_RED_MAX_LEVEL];
+    uint32_t numBlocks = 0;
+    uint32_t pos = 0;
+
+    // the block headers of RFC 2198 followed by the one byte header of the primary data
+    while (pos < nDataSize && (pData[pos] & 0x80) != 0)
+    {
+        if (pos + AUDIO_RED_HEADER_SIZE > nDataSize || numBlocks == AUDIO_RED_MAX_LEVEL)
+        {
+            IMLOGE2("[DecodeRedundantPayload] invalid header, size[%d], blocks[%d]", nDataSize,
+                    numBlocks);
+            return;
+        }
+
+        offsets[numBlocks] = (pData[pos + 1] << 6) | (pData[pos + 2] >> 2);
+        lengths[numBlocks] = ((pData[pos + 2] & 0x03) << 8) | pData[pos + 3];
+        numBlocks++;
+        pos += AUDIO_RED_HEADER_SIZE;
+    }
+
+    pos++;
+
+    uint32_t totalLength = pos;
+
+    for (uint32_t i = 0; i < numBlocks; i++)
+    {
+        totalLength += lengths[i];
+    }
+
+    if (totalLength > nDataSize)
+    {
+        IMLOGE2("[DecodeRedundantPayload] invalid length[%d], size[%d]", totalLength, nDataSize);
+        return;
+    }
+
+    uint32_t distance = mRedundancyDistance > 0 ? mRedundancyDistance : 1;
+
+    // the blocks are in the order of the timestamp, the last block is the nearest one
+    for (uint32_t i = 0; i < numBlocks; i++)
+    {
+        uint32_t timestamp = nTimestamp - offsets[i] / (mSamplingRate > 0 ? mSamplingRate : 1);
+        uint16_t seqNum = nSeqNum - (numBlocks - i) * distance;
+
+        // the redundant data is used only when the packet carrying its primary data is missing
+        if (lengths[i] > 0 && offsets[i] > 0 &&
+                (!mPrimaryReceived || static_cast<int32_t>(timestamp - mLastPrimaryTimestamp) > 0))
+        {
+            IMLOGD_PACKET3(IM_PACKET_LOG_PH,
+                    "[DecodeRedundantPayload] recover seq[%d], TS[%u], size[%d]", seqNum,
+                    timestamp, lengths[i]);
+            DecodePayload(pData + pos, lengths[i], timestamp, false, seqNum,
+                    MEDIASUBTYPE_AUDIO_RED, arrivalTime);
+        }
+
+        pos += lengths[i];
+    }
+
+    DecodePayload(pData + pos, nDataSize - pos, nTimestamp, bMark, nSeqNum,
+            MEDIASUBTYPE_UNDEFINED, arrivalTime);
+}
+
 void AudioRtpPayloadDecoderNode::DecodePayloadAmr(uint8_t* pData, uint32_t nDataSize,
-        uint32_t nTimestamp, uint32_t nSeqNum, uint32_t arrivalTime)
+        uint32_t nTimestamp, uint32_t nSeqNum, ImsMediaSubType nDataType, uint32_t arrivalTime)
 {
     if (pData == nullptr || nDataSize == 0)
     {
@@ -179,7 +284,8 @@ void AudioRtpPayloadDecoderNode::DecodePayloadAmr(uint8_t* pData, uint32_t nData
         mBitReader.Read(4);
     }
 
-    if (cmr != mPrevCMR)
+    // the codec mode request in the redundant block is outdated
+    if (nDataType != MEDIASUBTYPE_AUDIO_RED && cmr != mPrevCMR)
     {
         if ((mCodecType == kAudioCodecAmr && cmr <= 7) ||
                 (mCodecType == kAudioCodecAmrWb && cmr <= 8))
@@ -249,14 +355,15 @@ void AudioRtpPayloadDecoderNode::DecodePayloadAmr(uint8_t* pData, uint32_t nData
                 mPayload[1], mPayload[2], mPayload[3], bufferSize, eRate);
         // send remaining packet number in bundle as bMark value
         SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload, bufferSize, timestamp,
-                mListFrameType.size(), nSeqNum, MEDIASUBTYPE_UNDEFINED, arrivalTime);
+                mListFrameType.size(), nSeqNum, nDataType, arrivalTime);
 
         timestamp += 20;
     }
 }
 
 void AudioRtpPayloadDecoderNode::DecodePayloadEvs(uint8_t* pData, uint32_t nDataSize,
-        uint32_t nTimeStamp, bool bMark, uint32_t nSeqNum, uint32_t arrivalTime)
+        uint32_t nTimeStamp, bool bMark, uint32_t nSeqNum, ImsMediaSubType nDataType,
+        uint32_t arrivalTime)
 {
     if (pData == nullptr || nDataSize == 0)
     {
@@ -324,7 +431,7 @@ void AudioRtpPayloadDecoderNode::DecodePayloadEvs(uint8_t* pData, uint32_t nData
                     mPayload[0], mPayload[1], mPayload[2], mPayload[3], nDataSize, nFrameType);
 
             SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload, nDataSize, timestamp, bMark,
-                    nSeqNum, MEDIASUBTYPE_UNDEFINED, arrivalTime);
+                    nSeqNum, nDataType, arrivalTime);
         }
         else if (kEvsCodecMode == kEvsCodecModeAmrIo)
         {
@@ -339,7 +446,7 @@ void AudioRtpPayloadDecoderNode::DecodePayloadEvs(uint8_t* pData, uint32_t nData
             {
                 uint32_t cmr = mBitReader.Read(3);
 
-                if (cmr != mPrevCMR)
+                if (nDataType != MEDIASUBTYPE_AUDIO_RED && cmr != mPrevCMR)
                 {
                     if (cmr != kEvsCmrCodeTypeNoReq)
                     {
@@ -477,7 +584,7 @@ void AudioRtpPayloadDecoderNode::DecodePayloadEvs(uint8_t* pData, uint32_t nData
                     mPayload[0], mPayload[1], mPayload[2], mPayload[3], nDataSize, nFrameType);
 
             SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload, nDataSize, timestamp, bMark,
-                    nSeqNum, MEDIASUBTYPE_UNDEFINED, arrivalTime);
+                    nSeqNum, nDataType, arrivalTime);
         }
         else
         {
@@ -498,7 +605,7 @@ void AudioRtpPayloadDecoderNode::DecodePayloadEvs(uint8_t* pData, uint32_t nData
                 cmr_d = mBitReader.Read(4);
                 uint32_t currCmr = (cmr_t << 4) + cmr_d;
 
-                if (currCmr != mPrevCMR)
+                if (nDataType != MEDIASUBTYPE_AUDIO_RED && currCmr != mPrevCMR)
                 {
                     // process cmr
                     if (currCmr != 127)
@@ -656,7 +763,7 @@ void AudioRtpPayloadDecoderNode::DecodePayloadEvs(uint8_t* pData, uint32_t nData
                     mPayload[0], mPayload[1], mPayload[2], mPayload[3], bufferSize, toc_ft_b);
 
             SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload, bufferSize, timestamp,
-                    mListFrameType.size(), nSeqNum, MEDIASUBTYPE_UNDEFINED, arrivalTime);
+                    mListFrameType.size(), nSeqNum, nDataType, arrivalTime);
 
             timestamp += 20;
         }
@@ -19,6 +19,13 @@
 #include <ImsMediaTrace.h>
 #include <AudioConfig.h>
 #include <EvsParams.h>
+#include <RtpEncoderNode.h>
+#include <algorithm>
+#include <string.h>
+
+#define AUDIO_FRAME_INTERVAL      20
+#define IPV4_UDP_RTP_HEADER_SIZE  40
+#define IPV6_UDP_RTP_HEADER_SIZE  60
 
 AudioRtpPayloadEncoderNode::AudioRtpPayloadEncoderNode(BaseSessionCallback* callback) :
         BaseNode(callback)
@@ -26,10 +33,13 @@ AudioRtpPayloadEncoderNode::AudioRtpPayloadEncoderNode(BaseSessionCallback* call
     mCodecType = 0;
     mOctetAligned = false;
     mPtime = 0;
+    mMaxPtime = 0;
     memset(mPayload, 0, sizeof(mPayload));
     mFirstFrame = false;
     mTimestamp = 0;
     mMaxNumOfFrame = 0;
+    mNextNumOfFrame = 0;
+    mHeaderOverhead = IPV4_UDP_RTP_HEADER_SIZE;
     mCurrNumOfFrame = 0;
     mCurrFramePos = 0;
     mTotalPayloadSize = 0;
@@ -40,6 +50,14 @@ AudioRtpPayloadEncoderNode::AudioRtpPayloadEncoderNode(BaseSessionCallback* call
     mEvsMode = kEvsAmrIoModeBitrate00660;
     mCoreEvsMode = 0;
     mEvsPayloadHeaderMode = kRtpPyaloadHeaderModeEvsCompact;
+    mSamplingRate = 0;
+    mRtpPayloadTx = 0;
+    mRedPayloadType = 0;
+    mRedundancyLevel = 0;
+    mRedundancyDistance = 0;
+    mDtmfMode = false;
+    mRedundancyReset = false;
+    memset(mRedPayload, 0, sizeof(mRedPayload));
 }
 
 AudioRtpPayloadEncoderNode::~AudioRtpPayloadEncoderNode() {}
@@ -51,7 +69,8 @@ kBaseNodeId AudioRtpPayloadEncoderNode::GetNodeId()
 
 ImsMediaResult AudioRtpPayloadEncoderNode::Start()
 {
-    mMaxNumOfFrame = mPtime / 20;
+    mMaxNumOfFrame = mPtime / AUDIO_FRAME_INTERVAL;
+    mNextNumOfFrame = mMaxNumOfFrame;
     mEvsMode = (kEvsBitrate)ImsMediaAudioUtil::GetMaximumEvsMode(mCoreEvsMode);
     mEvsCodecMode = (kEvsCodecMode)ImsMediaAudioUtil::ConvertEvsCodecMode(mEvsMode);
 
@@ -68,6 +87,9 @@ ImsMediaResult AudioRtpPayloadEncoderNode::Start()
     mCurrFramePos = 0;
     mFirstFrame = true;
     mTotalPayloadSize = 0;
+    mRedundantPayloads.clear();
+    mDtmfMode = false;
+    mRedundancyReset = false;
     mNodeState = kNodeStateRunning;
     return RESULT_SUCCESS;
 }
@@ -88,10 +110,22 @@ bool AudioRtpPayloadEncoderNode::IsSourceNode()
     return false;
 }
 
-void AudioRtpPayloadEncoderNode::OnDataFromFrontNode(ImsMediaSubType /*subtype*/, uint8_t* pData,
+void AudioRtpPayloadEncoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData,
         uint32_t nDataSize, uint32_t nTimestamp, bool bMark, uint32_t nSeqNum,
         ImsMediaSubType nDataType, uint32_t arrivalTime)
 {
+    // the start and the end of dtmf from DtmfEncoderNode
+    if (subtype == MEDIASUBTYPE_DTMFSTART || subtype == MEDIASUBTYPE_DTMFEND)
+    {
+        mDtmfMode = (subtype == MEDIASUBTYPE_DTMFSTART);
+        mRedundancyReset = true;
+        return;
+    }
+    else if (subtype == MEDIASUBTYPE_DTMF_PAYLOAD)
+    {
+        return;
+    }
+
     switch (mCodecType)
     {
         case kAudioCodecAmr:
@@ -136,6 +170,15 @@ void AudioRtpPayloadEncoderNode::SetConfig(void* config)
         }
 
         mPtime = pConfig->getPtimeMillis();
+        mMaxPtime = pConfig->getMaxPtimeMillis();
+        mHeaderOverhead = (strstr(pConfig->getRemoteAddress().c_str(), ":") == nullptr)
+                ? IPV4_UDP_RTP_HEADER_SIZE
+                : IPV6_UDP_RTP_HEADER_SIZE;
+        mSamplingRate = pConfig->getSamplingRateKHz();
+        mRtpPayloadTx = pConfig->getTxPayloadTypeNumber();
+        mRedPayloadType = pConfig->getRedPayloadTypeNumber();
+        mRedundancyLevel = pConfig->getRedundancyLevel();
+        mRedundancyDistance = pConfig->getRedundancyDistance();
     }
 }
 
@@ -145,6 +188,15 @@ bool AudioRtpPayloadEncoderNode::IsSameConfig(void* config)
         return true;
     AudioConfig* pConfig = reinterpret_cast<AudioConfig*>(config);
 
+    if (mSamplingRate != pConfig->getSamplingRateKHz() ||
+            mRtpPayloadTx != pConfig->getTxPayloadTypeNumber() ||
+            mRedPayloadType != pConfig->getRedPayloadTypeNumber() ||
+            mRedundancyLevel != pConfig->getRedundancyLevel() ||
+            mRedundancyDistance != pConfig->getRedundancyDistance())
+    {
+        return false;
+    }
+
     if (mCodecType == ImsMediaAudioUtil::ConvertCodecType(pConfig->getCodecType()))
     {
         if (mCodecType == kAudioCodecAmr || mCodecType == kAudioCodecAmrWb)
@@ -166,6 +218,17 @@ bool AudioRtpPayloadEncoderNode::IsSameConfig(void* config)
     return false;
 }
 
+void AudioRtpPayloadEncoderNode::SetNumFramesPerPacket(uint32_t numFrames)
+{
+    uint32_t maxNumOfFrame = std::min(
+            static_cast<uint32_t>(std::max(mMaxPtime, static_cast<int32_t>(mPtime))) /
+                    AUDIO_FRAME_INTERVAL,
+            static_cast<uint32_t>(MAX_FRAME_IN_PACKET));
+    uint32_t nextNumOfFrame = std::max(std::min(numFrames, maxNumOfFrame), 1U);
+    mNextNumOfFrame = nextNumOfFrame;
+    IMLOGD2("[SetNumFramesPerPacket] requested[%u], applied[%u]", numFrames, nextNumOfFrame);
+}
+
 void AudioRtpPayloadEncoderNode::EncodePayloadAmr(
         uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp)
 {
@@ -185,6 +248,12 @@ void AudioRtpPayloadEncoderNode::EncodePayloadAmr(
     IMLOGD_PACKET2(IM_PACKET_LOG_PH, "[EncodePayloadAmr] codectype[%d], octetAligned[%d]",
             mCodecType, mOctetAligned);
 
+    // the number of frames is changed only between the packets
+    if (mCurrNumOfFrame == 0)
+    {
+        mMaxNumOfFrame = mNextNumOfFrame;
+    }
+
     mCurrNumOfFrame++;
     f = (mCurrNumOfFrame == mMaxNumOfFrame) ? 0 : 1;
 
@@ -260,8 +329,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadAmr(
 
         if (mTotalPayloadSize > 0)
         {
-            SendDataToRearNode(
-                    MEDIASUBTYPE_RTPPAYLOAD, mPayload, nTotalSize, mTimestamp, mFirstFrame, 0);
+            SendPayload(mPayload, nTotalSize, mTimestamp, mFirstFrame);
         }
 
         mCurrNumOfFrame = 0;
@@ -286,6 +354,13 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
     // compact or header-full format, default is compact formats
     // primary or amr-wb io mode, default is primary mode
     // primary or amr-wb io mode base on frameSize.
+    // the compact format carries one frame always, the number of frames in the header-full format
+    // is changed only between the packets
+    if (mCurrNumOfFrame == 0 && mEvsPayloadHeaderMode == kRtpPyaloadHeaderModeEvsHeaderFull)
+    {
+        mMaxNumOfFrame = mNextNumOfFrame;
+    }
+
     mCurrNumOfFrame++;
 
     if (mEvsPayloadHeaderMode == kRtpPyaloadHeaderModeEvsCompact)
@@ -334,8 +409,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
 
             if (mTotalPayloadSize > 0)
             {
-                SendDataToRearNode(
-                        MEDIASUBTYPE_RTPPAYLOAD, mPayload, nTotalSize, mTimestamp, mFirstFrame, 0);
+                SendPayload(mPayload, nTotalSize, mTimestamp, mFirstFrame);
             }
 
             mCurrNumOfFrame = 0;
@@ -421,8 +495,7 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
 
             if (mTotalPayloadSize > 0)
             {
-                SendDataToRearNode(
-                        MEDIASUBTYPE_RTPPAYLOAD, mPayload, nTotalSize, mTimestamp, mFirstFrame, 0);
+                SendPayload(mPayload, nTotalSize, mTimestamp, mFirstFrame);
             }
 
             mCurrNumOfFrame = 0;
@@ -522,8 +595,8 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
 
                 if (mTotalPayloadSize > 0)
                 {
-                    SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload,
-                            CheckPaddingNecessity(nTotalSize), mTimestamp, mFirstFrame, 0);
+                    SendPayload(mPayload, CheckPaddingNecessity(nTotalSize), mTimestamp,
+                            mFirstFrame);
                 }
 
                 mCurrNumOfFrame = 0;
@@ -603,8 +676,8 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
 
                 if (mTotalPayloadSize > 0)
                 {
-                    SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, mPayload,
-                            CheckPaddingNecessity(nTotalSize), mTimestamp, mFirstFrame, 0);
+                    SendPayload(mPayload, CheckPaddingNecessity(nTotalSize), mTimestamp,
+                            mFirstFrame);
                 }
 
                 mCurrNumOfFrame = 0;
@@ -628,6 +701,111 @@ void AudioRtpPayloadEncoderNode::EncodePayloadEvs(
     return;
 }
 
+void AudioRtpPayloadEncoderNode::SendPayload(
+        uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, bool bMark)
+{
+    // the headers saved against the packets of the negotiated ptime
+    uint32_t baseNumOfFrame = std::max(mPtime / AUDIO_FRAME_INTERVAL, 1);
+
+    if (mCallback != nullptr && mCurrNumOfFrame > baseNumOfFrame)
+    {
+        SessionCallbackParameter* param = new SessionCallbackParameter(kReportHeaderBytesSaved, 0,
+                (mCurrNumOfFrame - baseNumOfFrame) * mHeaderOverhead / baseNumOfFrame);
+        mCallback->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+    }
+
+    SetNumFramesToRearNode(mCurrNumOfFrame);
+
+    if (mRedPayloadType <= 0 || mRedundancyLevel <= 0)
+    {
+        SendDataToRearNode(MEDIASUBTYPE_RTPPAYLOAD, pData, nDataSize, nTimestamp, bMark, 0);
+        return;
+    }
+
+    if (mRedundancyReset.exchange(false))
+    {
+        mRedundantPayloads.clear();
+    }
+
+    int32_t maxLevel = std::min(static_cast<int32_t>(mRedundancyLevel), AUDIO_RED_MAX_LEVEL);
+    int32_t distance = std::max(static_cast<int32_t>(mRedundancyDistance), 1);
+
+    // find the previous payloads to carry from the nearest one, the blocks are contiguous to be
+    // matched with the sequence number in the receiver
+    int32_t numBlocks = 0;
+    uint32_t totalSize = nDataSize + 1;
+
+    for (int32_t level = 1; level <= maxLevel; level++)
+    {
+        uint32_t index = level * distance - 1;
+
+        if (index >= mRedundantPayloads.size())
+        {
+            break;
+        }
+
+        const RedundantPayload& block = mRedundantPayloads[index];
+        uint32_t offset = (nTimestamp - block.timestamp) * mSamplingRate;
+
+        if (offset == 0 || offset > AUDIO_RED_MAX_TIMESTAMP_OFFSET ||
+                block.data.size() > AUDIO_RED_MAX_BLOCK_LENGTH ||
+                totalSize + block.data.size() + AUDIO_RED_HEADER_SIZE > MAX_AUDIO_PAYLOAD_SIZE)
+        {
+            break;
+        }
+
+        totalSize += block.data.size() + AUDIO_RED_HEADER_SIZE;
+        numBlocks++;
+    }
+
+    // the headers and the data of the blocks in the order of the timestamp, RFC 2198
+    uint32_t pos = numBlocks * AUDIO_RED_HEADER_SIZE + 1;
+    mBWHeader.SetBuffer(mRedPayload, MAX_AUDIO_PAYLOAD_SIZE);
+
+    for (int32_t level = numBlocks; level > 0; level--)
+    {
+        const RedundantPayload& block = mRedundantPayloads[level * distance - 1];
+        mBWHeader.Write(1, 1);
+        mBWHeader.Write(mRtpPayloadTx, 7);
+        mBWHeader.Write((nTimestamp - block.timestamp) * mSamplingRate, 14);
+        mBWHeader.Write(block.data.size(), 10);
+        memcpy(mRedPayload + pos, block.data.data(), block.data.size());
+        pos += block.data.size();
+    }
+
+    mBWHeader.Write(0, 1);
+    mBWHeader.Write(mRtpPayloadTx, 7);
+    mBWHeader.Flush();
+    memcpy(mRedPayload + pos, pData, nDataSize);
+
+    IMLOGD_PACKET3(IM_PACKET_LOG_PH, "[SendPayload] redundant blocks[%d], size[%d], TS[%u]",
+            numBlocks, totalSize, nTimestamp);
+    SendDataToRearNode(MEDIASUBTYPE_AUDIO_RED, mRedPayload, totalSize, nTimestamp, bMark, 0);
+
+    if (mDtmfMode)
+    {
+        return;
+    }
+
+    mRedundantPayloads.push_front({nTimestamp, std::vector<uint8_t>(pData, pData + nDataSize)});
+
+    while (mRedundantPayloads.size() > static_cast<size_t>(maxLevel * distance))
+    {
+        mRedundantPayloads.pop_back();
+    }
+}
+
+void AudioRtpPayloadEncoderNode::SetNumFramesToRearNode(uint32_t numFrames)
+{
+    for (auto& node : mListRearNodes)
+    {
+        if (node != nullptr && node->GetNodeId() == kNodeIdRtpEncoder)
+        {
+            (reinterpret_cast<RtpEncoderNode*>(node))->SetNumFramesOfNextPayload(numFrames);
+        }
+    }
+}
+
 uint32_t AudioRtpPayloadEncoderNode::CheckPaddingNecessity(uint32_t nTotalSize)
 {
     kEvsCodecMode evsCodecMode;
@@ -23,6 +23,15 @@
 #include <RtpConfig.h>
 #include <string.h>
 
+#define FRAME_INTERVAL_US      (20000)
+// the playout speed to shrink or grow the jitter buffer by stretching the speech
+#define SPEED_UP_RATE          (1.1)
+#define SLOW_DOWN_RATE         (0.9)
+// the number of the frames over or under the jitter buffer size to start stretching
+#define STRETCH_START_FRAMES   (2)
+#define PLAYOUT_DELAY_ATTACK_RATE   (0.5)
+#define PLAYOUT_DELAY_DECAY_RATE    (0.02)
+
 IAudioPlayerNode::IAudioPlayerNode(BaseSessionCallback* callback) :
         JitterBufferControlNode(callback, IMS_MEDIA_AUDIO)
 {
@@ -31,6 +40,8 @@ IAudioPlayerNode::IAudioPlayerNode(BaseSessionCallback* callback) :
     mConfig = nullptr;
     mIsOctetAligned = false;
     mIsDtxEnabled = false;
+    mEvsChannelAwOffset = 0;
+    mPlayoutDelayPercentile = 0;
 }
 
 IAudioPlayerNode::~IAudioPlayerNode()
@@ -54,6 +65,8 @@ ImsMediaResult IAudioPlayerNode::ProcessStart()
         mJitterBuffer->SetCodecType(mCodecType);
     }
 
+    SetEvsRedundantFrameOffset(mCodecType == kAudioCodecEvs ? mEvsChannelAwOffset : 0);
+
     // reset the jitter
     Reset();
 
@@ -146,10 +159,12 @@ void IAudioPlayerNode::SetConfig(void* config)
 
     mSamplingRate = mConfig->getSamplingRateKHz();
     mIsDtxEnabled = mConfig->getDtxEnabled();
+    mPlayoutDelayPercentile = mConfig->getPlayoutDelayPercentile();
     SetJitterBufferSize(3, 3, 9);
-    SetJitterOptions(
-            80, 1, (double)25 / 10, false /** TODO: when enable DTX, set this true on condition*/
-    );
+    SetJitterOptions(80, 1, (double)25 / 10, false);
+    // the jitter options size the buffer unless the percentile is configured
+    SetPlayoutDelayOptions(mPlayoutDelayPercentile / 100.0, PLAYOUT_DELAY_ATTACK_RATE,
+            PLAYOUT_DELAY_DECAY_RATE);
 }
 
 bool IAudioPlayerNode::IsSameConfig(void* config)
@@ -168,7 +183,8 @@ bool IAudioPlayerNode::IsSameConfig(void* config)
             return (mMode == pConfig->getAmrParams().getAmrMode() &&
                     mSamplingRate == pConfig->getSamplingRateKHz() &&
                     mIsDtxEnabled == pConfig->getDtxEnabled() &&
-                    mIsOctetAligned == pConfig->getAmrParams().getOctetAligned());
+                    mIsOctetAligned == pConfig->getAmrParams().getOctetAligned() &&
+                    mPlayoutDelayPercentile == pConfig->getPlayoutDelayPercentile());
         }
         else if (mCodecType == kAudioCodecEvs)
         {
@@ -179,7 +195,8 @@ bool IAudioPlayerNode::IsSameConfig(void* config)
                     mEvsChannelAwOffset == pConfig->getEvsParams().getChannelAwareMode() &&
                     mSamplingRate == pConfig->getSamplingRateKHz() &&
                     mEvsPayloadHeaderMode == pConfig->getEvsParams().getUseHeaderFullOnly() &&
-                    mIsDtxEnabled == pConfig->getDtxEnabled());
+                    mIsDtxEnabled == pConfig->getDtxEnabled() &&
+                    mPlayoutDelayPercentile == pConfig->getPlayoutDelayPercentile());
         }
     }
 
@@ -198,6 +215,7 @@ void* IAudioPlayerNode::run()
     uint32_t nSeqNum = 0;
     uint64_t nNextTime = ImsMediaTimer::GetTimeInMicroSeconds();
     bool isFirstFrameReceived = false;
+    double playbackRate = 1.0;
 
     while (true)
     {
@@ -214,8 +232,19 @@ void* IAudioPlayerNode::run()
                     nTimestamp);
             if (nDataSize != 0)
             {
-                if (mAudioPlayer->onDataFrame(pData, nDataSize))
+                bool isPartialCopy = subtype == MEDIASUBTYPE_AUDIO_PARTIAL_COPY;
+
+                if (mAudioPlayer->onDataFrame(pData, nDataSize, isPartialCopy))
                 {
+                    // the lost frame is recovered only when the partial copy is decoded
+                    if (isPartialCopy)
+                    {
+                        SessionCallbackParameter* param = new SessionCallbackParameter(
+                                kReportPartialCopyRecovered, nTimestamp, 1);
+                        mCallback->SendEvent(
+                                kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+                    }
+
                     // send buffering complete message to client
                     if (isFirstFrameReceived == false)
                     {
@@ -233,7 +262,14 @@ void* IAudioPlayerNode::run()
             mAudioPlayer->onDataFrame(nullptr, 0);
         }
 
-        nNextTime += 20000;
+        if (isFirstFrameReceived)
+        {
+            playbackRate = GetPlaybackRate(playbackRate);
+            mAudioPlayer->SetPlaybackRate(playbackRate);
+        }
+
+        // the frames are pulled as fast as they are played
+        nNextTime += static_cast<uint64_t>(FRAME_INTERVAL_US / playbackRate);
         uint64_t nCurrTime = ImsMediaTimer::GetTimeInMicroSeconds();
         int64_t nTime = nNextTime - nCurrTime;
 
@@ -246,3 +282,24 @@ void* IAudioPlayerNode::run()
     }
     return nullptr;
 }
+
+double IAudioPlayerNode::GetPlaybackRate(double currentRate)
+{
+    int32_t depthError = GetJitterBufferDepthError();
+
+    // stretches until the jitter buffer is back to its size
+    if (depthError >= STRETCH_START_FRAMES)
+    {
+        return SPEED_UP_RATE;
+    }
+    else if (depthError <= -STRETCH_START_FRAMES)
+    {
+        return SLOW_DOWN_RATE;
+    }
+    else if ((currentRate > 1.0 && depthError <= 0) || (currentRate < 1.0 && depthError >= 0))
+    {
+        return 1.0;
+    }
+
+    return currentRate;
+}
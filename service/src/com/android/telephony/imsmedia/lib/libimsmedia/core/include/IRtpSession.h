@@ -20,6 +20,8 @@
 #include <ImsMediaDefine.h>
 #include <AudioConfig.h>
 #include <RtpService.h>
+#include <TransportFeedback.h>
+#include <RttEstimator.h>
 #include <list>
 #include <atomic>
 #include <stdint.h>
@@ -72,9 +74,16 @@ public:
     virtual void OnRtcpInd(tRtpSvc_IndicationFromStack eIndType, void* pMsg) = 0;
     virtual void OnNumReceivedPacket(uint32_t nNumRtcpSRPacket, uint32_t nNumRtcpRRPacket) = 0;
     virtual void OnEvent(uint32_t event, uint32_t param) = 0;
+    /**
+     * @brief Invoked when the transport feedback is received. The send time of the packets sent
+     * by IRtpSession::SetTransportSeqSent() is filled.
+     */
+    virtual void OnTransportFeedback(const TransportFeedbackResult& feedback) = 0;
 };
 
-#define MAX_NUM_PAYLOAD_PARAM 4
+#define MAX_NUM_PAYLOAD_PARAM 5
+// the number of the transport wide sequence numbers to keep the send time
+#define MAX_TRANSPORT_SEQ_HISTORY 1024
 
 /*!
  * @class        IRtpSession
@@ -97,8 +106,21 @@ public:
     void SetRtcpDecoderListener(IRtcpDecoderListener* pRtcpDecoderListener);
     void SetRtpPayloadParam(int32_t payloadNumTx, int32_t payloadNumRx, int32_t samplingRate,
             int32_t subTxPayloadTypeNum = 0, int32_t subRxPayloadTypeNum = 0,
-            int32_t subSamplingRate = 0);
+            int32_t subSamplingRate = 0, int32_t redPayloadTypeNum = 0);
     void SetRtcpInterval(int32_t nInterval);
+    /**
+     * @brief Enables the reduced-size RTCP (RFC 5506) sending the feedback without SR, RR and SDES
+     */
+    void SetRtcpReducedSize(bool enable);
+    /**
+     * @brief Sends the RTCP XR receiver reference time and DLRR blocks (RFC 3611) to measure the
+     * round trip time when the peer does not send the sender report
+     */
+    void SetRtcpXrRttBlocks(bool rrt, bool dlrr);
+    /**
+     * @brief Gets the round trip time estimation of the session shared by the nodes using it
+     */
+    RttEstimator* GetRttEstimator();
     void StartRtp();
     void StopRtp();
     void StartRtcp(bool bSendRtcpBye = false);
@@ -110,6 +132,18 @@ public:
     void OnTimer();
     void SendRtcpXr(uint8_t* pPayload, uint32_t nSize);
     bool SendRtcpFeedback(int32_t type, uint8_t* pFic, uint32_t nFicSize);
+    /**
+     * @brief Sends the transport feedback, the FCI is encoded by TransportFeedback::Build()
+     */
+    bool SendRtcpTransportFeedback(uint8_t* fci, uint32_t size);
+    /**
+     * @brief Keeps the send time of the packet having the transport wide sequence number to fill
+     * it in the received transport feedback
+     *
+     * @param seqNum The transport wide sequence number
+     * @param sendTime The send time in milliseconds
+     */
+    void SetTransportSeqSent(uint16_t seqNum, uint32_t sendTime);
     ImsMediaType getMediaType();
     void increaseRefCounter();
     void decreaseRefCounter();
@@ -124,8 +158,11 @@ public:
     virtual void OnPeerRtcpComponents(void* nMsg);
 
 private:
+    void OnTransportFeedback(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* ind);
+
     static std::list<IRtpSession*> mListRtpSession;
     ImsMediaType mMediaType;
+    RTPSTACKID mRtpStackId;
     RTPSESSIONID mRtpSessionId;
     std::atomic<int32_t> mRefCount;
     RtpAddress mLocalAddress;
@@ -156,7 +193,15 @@ private:
     uint32_t mNumRtpDataToSend;
     uint32_t mNumRtpPacketSent;
     uint32_t mNumRtcpPacketSent;
-    int32_t mRttd;
+    // retransmitted packets received after sending NACK and the latency in milliseconds
+    uint32_t mNumNackRetransmission;
+    uint32_t mSumNackLatency;
+    uint32_t mMaxNackLatency;
+    RttEstimator mRttEstimator;
+    // the send time of the transport wide sequence numbers indexed by the lower bits
+    uint16_t mTransportSeqNums[MAX_TRANSPORT_SEQ_HISTORY];
+    int64_t mTransportSendTimes[MAX_TRANSPORT_SEQ_HISTORY];
+    std::mutex mutexTransportSeq;
     std::mutex mutexDecoder;
     std::mutex mutexEncoder;
 };
@@ -26,6 +26,8 @@
 #define USHORT_SEQ_ROUND_COMPARE(a, b)                                                      \
     ((((a) >= (b)) && (((b) >= SEQ_ROUND_QUARD) || (((a) <= 0xffff - SEQ_ROUND_QUARD)))) || \
             (((a) <= SEQ_ROUND_QUARD) && ((b) >= 0xffff - SEQ_ROUND_QUARD)))
+// the distance of the sequence numbers with the 16 bit wrap around
+#define SEQ_DIFF(a, b) static_cast<int16_t>(static_cast<uint16_t>((a) - (b)))
 #define IMS_MEDIA_WORD_SIZE 4
 
 using namespace android::telephony::imsmedia;
@@ -75,6 +77,10 @@ enum kImsMediaInternalRequestType
     kCollectJitterBufferSize,
     kGetRtcpXrReportBlock,
     kRequestSendRtcpXrReport,
+    kRequestVideoSendTransportFeedback,
+    kRequestVideoRetransmission,
+    kRequestVideoLossFractionUpdate,
+    kRequestAudioFrameAggregation,
 };
 
 enum kImsMediaErrorNotify
@@ -279,6 +285,10 @@ enum ImsMediaSubType
     // Jitter Buffer GetData not ready
     MEDIASUBTYPE_NOT_READY,
     MEDIASUBTYPE_BITSTREAM_CODECCONFIG,
+    // audio rtp payload of the redundant audio data format of RFC 2198
+    MEDIASUBTYPE_AUDIO_RED,
+    // evs channel aware mode frame played to decode the partial copy of the missing frame
+    MEDIASUBTYPE_AUDIO_PARTIAL_COPY,
     MEDIASUBTYPE_MAX
 };
 
@@ -485,6 +495,10 @@ enum kRtpOptionalType
     kTimeToLive,
     kRoundTripDelay,
     kReportPacketLossGap,
+    kReportPartialCopyRecovered,
+    kReportFractionLost,
+    kReportHeaderBytesSaved,
+    kReportCatchUp,
 };
 
 /** TODO: change the name to avoid confusion by similarity */
@@ -18,7 +18,8 @@
 #define JITTERNETWORKANALYSER_H_INCLUDED
 
 #include <stdint.h>
-#include <list>
+#include <P2QuantileEstimator.h>
+#include <SlidingWindowStatistics.h>
 #include <mutex>
 
 enum NETWORK_STATUS
@@ -38,6 +39,14 @@ public:
     void SetMinMaxJitterBufferSize(uint32_t nMinBufferSize, uint32_t nMaxBufferSize);
     void SetJitterOptions(uint32_t nReduceTH, uint32_t nStepSize, double zValue);
 
+    /**
+     * @brief Sets the percentile of the jitter to size the jitter buffer instead of the mean
+     * and the deviation of the jitter, mean + zValue * deviation
+     *
+     * @param quantile The quantile of the jitter between 0 and 1, 0 to use the deviation
+     */
+    void SetJitterQuantile(double quantile);
+
     /**
      * @brief Update the base timestamp
      *
@@ -65,15 +74,16 @@ public:
     int32_t CalculateTransitTimeDifference(uint32_t timestamp, uint32_t arrivalTime);
 
 private:
-    double CalculateDeviation(double* pMean);
-    int32_t GetMaxJitterValue();
-
     std::mutex mMutex;
     uint32_t mMinJitterBufferSize;
     uint32_t mMaxJitterBufferSize;
     uint32_t mBasePacketTime;
     uint32_t mBaseArrivalTime;
-    std::list<int32_t> mListJitters;
+    // the jitters of the last packets
+    SlidingWindowStatistics mJitterStats;
+    // the jitters of all the packets after Reset()
+    P2QuantileEstimator mJitterQuantile;
+    bool mUseQuantile;
     NETWORK_STATUS mNetworkStatus;
     uint32_t mGoodStatusEnteringTime;
     uint32_t mBadStatusChangedTime;
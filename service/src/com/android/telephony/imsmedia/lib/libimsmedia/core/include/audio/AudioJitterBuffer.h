@@ -19,43 +19,145 @@
 
 #include <BaseJitterBuffer.h>
 #include <JitterNetworkAnalyser.h>
+#include <JitterRingQueue.h>
+#include <PlayoutDelayEstimator.h>
+#include <SlidingWindowStatistics.h>
 
 class AudioJitterBuffer : public BaseJitterBuffer
 {
 public:
     AudioJitterBuffer();
     virtual ~AudioJitterBuffer();
+    virtual uint32_t GetCount();
     virtual void Reset();
     virtual void SetJitterBufferSize(uint32_t nInit, uint32_t nMin, uint32_t nMax);
     void SetJitterOptions(uint32_t nReduceTH, uint32_t nStepSize, double zValue, bool bIgnoreSID);
+
+    /**
+     * @brief Sets the jitter buffer size to follow the percentile of the packet delay instead of
+     * the steps by the network status of the jitter options
+     *
+     * @param percentile The percentile of the packet delay to cover, 0.97 for the late loss of 3
+     * percent. The jitter options are used when it is not positive.
+     * @param attackRate The ratio of the gap applied per packet when the delay goes up
+     * @param decayRate The ratio of the gap applied per packet when the delay goes down
+     */
+    void SetPlayoutDelayOptions(double percentile, double attackRate, double decayRate);
+
+    /**
+     * @brief Sets the offset of the partial copy in the evs channel aware mode. The partial copy
+     * of a frame is carried in the frame sent the offset number of frames later.
+     *
+     * @param offset The offset in the number of frames, 2, 3, 5 or 7. The partial copy is not
+     * used when it is not positive.
+     */
+    void SetEvsRedundantFrameOffset(int32_t offset);
     virtual void Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t nBufferSize,
             uint32_t nTimestamp, bool bMark, uint32_t nSeqNum,
             ImsMediaSubType nDataType = ImsMediaSubType::MEDIASUBTYPE_UNDEFINED,
             uint32_t arrivalTime = 0);
     virtual bool Get(ImsMediaSubType* psubtype, uint8_t** ppData, uint32_t* pnDataSize,
             uint32_t* pnTimestamp, bool* pbMark, uint32_t* pnSeqNum, uint32_t currentTime);
+    virtual void Delete();
+
+    /**
+     * @brief Gets the number of the frames queued over the jitter buffer size to play them
+     * faster, it is negative when the frames queued are less than the jitter buffer size. It is 0
+     * until the playing starts and in the silence of the dtx.
+     */
+    int32_t GetDepthError();
 
 private:
     bool IsSID(uint32_t nBufferSize);
+    /**
+     * @brief Checks the new frame is the same one in the queue. The frame recovered from the
+     * redundant data can be received again by the late packet or the next redundant data.
+     */
+    bool IsDuplicated(DataEntry* entry, DataEntry* newEntry);
+    /**
+     * @brief Finds the frame carrying the partial copy of the missing frame in the queue
+     *
+     * @param timestamp The timestamp of the missing frame
+     * @param entry The frame found
+     * @return true when the frame carrying the partial copy is in the queue
+     */
+    bool FindPartialCopy(uint32_t timestamp, DataEntry** entry);
     bool Resync(uint32_t currentTime);
+    /**
+     * @brief Checks the SID frame is played last in the dtx, the jitter buffer size is changed
+     * in the silence where the change is not heard
+     */
+    bool IsSilence();
+    bool IsTalkSpurtStart(DataEntry* entry);
+    /**
+     * @brief Sets the playing timestamp to play the first frame of the talk spurt after the
+     * jitter buffer size from its arrival. The silence before the talk spurt is stretched or
+     * shortened by the change of the jitter buffer size instead of the speech.
+     */
+    void PlaceTalkSpurt(DataEntry* entry, uint32_t currentTime);
+    /**
+     * @brief Checks the step of the transit time of the packet over the minimum of the recent
+     * packets, the packets held by the network in the handover arrive late at once
+     *
+     * @return true when the step is large enough for the consecutive packets to start the
+     * catch-up
+     */
+    bool CheckDelayStep(uint32_t timestamp, uint32_t arrivalTime);
+    /**
+     * @brief Plays the frames faster until the delay queued is back to the jitter buffer size.
+     * The SID frames are discarded first with the silence between them and the speech frames
+     * are left to the time stretching of the player. The oldest frames are discarded at the start
+     * only for the excess over the maximum the silence queued does not cover. The excess delay
+     * left after the timeout is discarded. The catch-up is cancelled when the frames queued do
+     * not exceed the jitter buffer size by the delay step.
+     */
+    void CatchUp(uint32_t currentTime);
+    /**
+     * @brief Gets the delay of the frames queued from the playing timestamp over the jitter
+     * buffer size in milliseconds
+     */
+    int32_t GetExcessDelay();
+    /**
+     * @brief Gets the duration of the silence queued in milliseconds, the SID frames and the gaps
+     * between the frames skipped at once when they are played
+     */
+    int32_t GetSilenceDelay();
+    /**
+     * @brief Moves the playing timestamp toward the timestamp of the entry by the excess delay at
+     * most, the gap between them is the silence not sent
+     */
+    void SkipSilence(DataEntry* entry, int32_t excessDelay);
+    void StopCatchUp(uint32_t currentTime);
     void CollectRxRtpStatus(int32_t seq, kRtpPacketStatus status);
     void CollectJitterBufferStatus(int32_t currSize, int32_t maxSize);
 
     JitterNetworkAnalyser mJitterAnalyzer;
+    PlayoutDelayEstimator mDelayEstimator;
+    // the frames ordered by the sequence number
+    JitterRingQueue mRingQueue;
     bool mDtxOn;
-    bool mBufferIgnoreSIDPacket;
-    bool mNeedToUpdateBasePacket;
     bool mWaiting;
     bool mEnforceUpdate;
     uint32_t mCannotGetCount;
     uint32_t mCurrPlayingTS;
-    uint32_t mBaseTimestamp;
-    uint32_t mBaseArrivalTime;
     uint32_t mCheckUpdateJitterPacketCnt;
     uint32_t mCurrJitterBufferSize;
     uint32_t mSIDCount;
     uint32_t mDeleteCount;
+    // the size applied in the next silence when the dtx is used
     uint32_t mNextJitterBufferSize;
+    int32_t mEvsRedundantFrameOffset;
+    // the frame played for the partial copy is kept in the queue to play its primary copy
+    bool mPartialCopyPlayed;
+    // the negative of the transit times of the recent packets to find the minimum
+    SlidingWindowStatistics mTransitTimes;
+    // the number of the consecutive packets over the delay step
+    uint32_t mDelayStepCount;
+    bool mCatchUp;
+    // the frames too late are discarded at the first Get() of the catch-up
+    bool mCatchUpStarted;
+    uint32_t mCatchUpStartTime;
+    int32_t mCatchUpStartDelay;
 };
 
 #endif
\ No newline at end of file
@@ -36,10 +36,13 @@ public:
      * @param config AudioConfig for setting the parameters for nodes
      * @param rtpEncoderNode The RtpEncoderNode instance to connect as a rear node after the
      * DtmfEncoderNode, if it is null, no dtmf packet will be delivered to RtpEncoderNode.
+     * @param payloadEncoderNode The AudioRtpPayloadEncoderNode instance to notify the start and
+     * the end of the dtmf, the audio payloads are not sent by RtpEncoderNode in between.
      * @return true Returns when the graph created without error
      * @return false Returns when the given parameters are invalid.
      */
-    bool createDtmfGraph(RtpConfig* config, BaseNode* rtpEncoderNode);
+    bool createDtmfGraph(
+            RtpConfig* config, BaseNode* rtpEncoderNode, BaseNode* payloadEncoderNode = nullptr);
 
     /**
      * @brief Creates and send dtmf packet to the network through the node created
@@ -58,6 +61,13 @@ public:
      */
     void processCmr(const uint32_t cmr);
 
+    /**
+     * @brief Set the number of audio frames to pack in a rtp packet within the maxptime
+     *
+     * @param numFrames The number of audio frames per rtp packet
+     */
+    void processFrameAggregation(const uint32_t numFrames);
+
     /**
      * @brief Send rtp header extension to the audio rtp
      *
@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef AUDIO_TIME_STRETCHER_H
+#define AUDIO_TIME_STRETCHER_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Changes the playout speed of the decoded 16 bit mono PCM without changing the pitch by
+ * WSOLA, the waveform similarity overlap-add.
+ *
+ * The output is made of 10 ms segments of the input overlapped by the half. The segment of every
+ * output hop is taken around the position advanced by the hop times the rate, at the offset in the
+ * search range of 5 ms where it is the most similar to the continuation of the previous segment,
+ * so the overlap-add does not break the pitch period. The output equals the input delayed when the
+ * rate is 1.
+ */
+class AudioTimeStretcher
+{
+public:
+    AudioTimeStretcher();
+    ~AudioTimeStretcher();
+
+    /**
+     * @brief Sets the sampling rate of the PCM and clears the samples buffered
+     *
+     * @param samplingRate The sampling rate in Hz
+     */
+    void SetSamplingRate(uint32_t samplingRate);
+
+    /**
+     * @brief Sets the playout speed, the rate is limited between 0.9 and 1.1
+     *
+     * @param rate The ratio of the input consumed to the output, larger than 1 to play faster and
+     * shrink the buffer, smaller than 1 to play slower and grow the buffer
+     */
+    void SetRate(double rate);
+    double GetRate();
+
+    /**
+     * @brief Clears the samples buffered
+     */
+    void Reset();
+
+    /**
+     * @brief Adds the input samples and gets the output samples ready to play
+     *
+     * @param input The input samples
+     * @param numInput The number of the input samples
+     * @param output The buffer of the output samples
+     * @param maxOutput The number of the samples the output buffer can hold
+     * @return uint32_t The number of the output samples
+     */
+    uint32_t Process(const int16_t* input, uint32_t numInput, int16_t* output, uint32_t maxOutput);
+
+    /**
+     * @brief Gets the number of the input samples buffered and not played yet
+     */
+    uint32_t GetNumBuffered();
+
+private:
+    int32_t FindBestPosition(int32_t templatePos, int32_t nominalPos);
+
+    uint32_t mSamplingRate;
+    double mRate;
+    // the number of the samples of the output hop, the half of the segment
+    int32_t mOverlap;
+    int32_t mSearchRange;
+    std::vector<float> mFadeIn;
+    std::vector<int16_t> mInput;
+    // the start of the previous segment in mInput
+    int32_t mPrevPos;
+    // the position of the next segment without the offset in mInput
+    double mNominalPos;
+};
+
+#endif
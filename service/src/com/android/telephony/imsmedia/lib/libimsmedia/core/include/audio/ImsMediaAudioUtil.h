@@ -28,6 +28,12 @@
 
 #define AUDIO_STOP_TIMEOUT              1000
 
+// RFC 2198 redundant audio data
+#define AUDIO_RED_MAX_LEVEL             3
+#define AUDIO_RED_MAX_TIMESTAMP_OFFSET  0x3FFF
+#define AUDIO_RED_MAX_BLOCK_LENGTH      0x3FF
+#define AUDIO_RED_HEADER_SIZE           4
+
 enum kImsAudioFrameEntype
 {
     kImsAudioFrameGsmSid = 0,        /* GSM HR, FR or EFR : silence descriptor   */
@@ -212,6 +212,26 @@ public:
      */
     uint32_t getLostPacketSize();
 
+    /**
+     * @brief Get number of frames recovered from the partial copy of evs channel aware mode
+     */
+    uint32_t getPartialCopyRecoveredSize();
+
+    /**
+     * @brief Get the number of the catch-up of the jitter buffer after the delay step
+     */
+    uint32_t getCatchUpCount();
+
+    /**
+     * @brief Get the sum of the latency recovered by the catch-up in milliseconds unit
+     */
+    uint32_t getCatchUpLatencyRecovered();
+
+    /**
+     * @brief Get the number of the audio frames per rtp packet requested to the encoder
+     */
+    uint32_t getFramesPerPacket();
+
     /**
      * @brief Send message event to event handler
      *
@@ -229,6 +249,7 @@ protected:
      */
     void processData(const int32_t timeCount);
     void processMediaQuality();
+    void processFrameAggregation();
     void notifyCallQuality();
     void notifyMediaQualityStatus();
     void AddEvent(uint32_t event, uint64_t paramA, uint64_t paramB);
@@ -268,6 +289,8 @@ protected:
     CallQuality mCallQuality;
     /** The sum of the relative jitter of rx packet for call quality */
     int64_t mCallQualitySumRelativeJitter;
+    /** The number of rx packets of the relative jitter, the SID packets are not counted */
+    uint32_t mCallQualityNumJitterPacket;
     /** The sum of the round trip delay of the session for call quality */
     uint64_t mSumRoundTripTime;
     /** The number of the round trip delay of the session for call quality */
@@ -280,6 +303,22 @@ protected:
     uint32_t mCallQualityNumRxPacket;
     /** The number of lost rx packet for call quality calculation */
     uint32_t mCallQualityNumLostPacket;
+    /** The number of lost frames recovered from the partial copy of evs channel aware mode */
+    uint32_t mNumPartialCopyRecovered;
+    /** The number of the catch-up of the jitter buffer after the delay step */
+    uint32_t mNumCatchUp;
+    /** The sum of the latency recovered by the catch-up in milliseconds unit */
+    uint32_t mCatchUpLatencyRecovered;
+    /** The latest round trip time of the session in milliseconds unit */
+    uint32_t mRoundTripTime;
+    /** The latest fraction lost of the uplink reported by the peer in 1/256 unit */
+    uint32_t mFractionLost;
+    /** The number of audio frames per rtp packet negotiated by the ptime */
+    uint32_t mBaseFramesPerPacket;
+    /** The maximum number of audio frames per rtp packet allowed by the maxptime */
+    uint32_t mMaxFramesPerPacket;
+    /** The number of audio frames per rtp packet currently requested to the encoder */
+    uint32_t mFramesPerPacket;
 
     // MediaQualityThreshold parameters
     std::vector<int32_t> mBaseRtpInactivityTimes;
@@ -0,0 +1,85 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef PLAYOUT_DELAY_ESTIMATOR_H
+#define PLAYOUT_DELAY_ESTIMATOR_H
+
+#include <SlidingWindowStatistics.h>
+#include <stdint.h>
+
+/**
+ * @brief The target playout delay of the audio jitter buffer set to the percentile of the packet
+ * delay distribution, the late loss rate is 1 - percentile.
+ *
+ * The delay of a packet is relative to the fastest packet of the last two seconds. The delays are
+ * counted in a histogram of 10 ms buckets with the exponential forgetting, the old packets fade
+ * out in about ten seconds. The target follows the percentile of the histogram with the attack
+ * rate when it goes up and the decay rate when it goes down.
+ */
+class PlayoutDelayEstimator
+{
+public:
+    enum
+    {
+        kBucketSize = 10,  // milliseconds
+        kNumBuckets = 100,
+    };
+
+    PlayoutDelayEstimator();
+    ~PlayoutDelayEstimator();
+
+    /**
+     * @brief Sets the options and clears the histogram
+     *
+     * @param percentile The percentile of the delay to cover between 0 and 1, 0.97 for the late
+     * loss of 3 percent. The estimator is disabled when it is not positive.
+     * @param attackRate The ratio of the gap to the percentile applied to the target per packet
+     * when the percentile is larger than the target, between 0 and 1
+     * @param decayRate The ratio of the gap applied when the percentile is smaller than the target
+     */
+    void SetOptions(double percentile, double attackRate, double decayRate);
+    bool IsEnabled();
+    void Reset();
+
+    /**
+     * @brief Adds the delay of the packet received to the histogram and updates the target
+     *
+     * @param timestamp The rtp timestamp of the packet in milliseconds
+     * @param arrivalTime The arrival time of the packet in milliseconds
+     */
+    void Update(uint32_t timestamp, uint32_t arrivalTime);
+
+    /**
+     * @brief Gets the delay of the percentile in the histogram in milliseconds
+     */
+    uint32_t GetPercentileDelay();
+
+    /**
+     * @brief Gets the target playout delay in milliseconds, 0 when there is no packet
+     */
+    uint32_t GetTargetDelay();
+
+private:
+    double mPercentile;
+    double mAttackRate;
+    double mDecayRate;
+    // the negative of the transit times to find the minimum by the maximum of the window
+    SlidingWindowStatistics mTransitTimes;
+    double mHistogram[kNumBuckets];
+    double mTargetDelay;
+    bool mFirstPacket;
+};
+
+#endif
@@ -45,10 +45,19 @@ public:
             uint32_t arrivalTime = 0);
 
 private:
+    void DecodePayload(uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, bool bMark,
+            uint32_t nSeqNum, ImsMediaSubType nDataType, uint32_t arrivalTime);
+    /**
+     * @brief Splits the redundant audio data of RFC 2198 into the blocks. The redundant blocks
+     * are decoded with their original timestamp and sequence number when the packet carrying
+     * them as the primary data has not been received.
+     */
+    void DecodeRedundantPayload(uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp,
+            bool bMark, uint32_t nSeqNum, uint32_t arrivalTime);
     void DecodePayloadAmr(uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, uint32_t nSeqNum,
-            uint32_t arrivalTime);
+            ImsMediaSubType nDataType, uint32_t arrivalTime);
     void DecodePayloadEvs(uint8_t* pData, uint32_t nDataSize, uint32_t nTimeStamp, bool bMark,
-            uint32_t nSeqNum, uint32_t arrivalTime);
+            uint32_t nSeqNum, ImsMediaSubType nDataType, uint32_t arrivalTime);
     bool ProcessCMRForEVS(kRtpPyaloadHeaderMode eEVSPayloadHeaderMode, kEvsCmrCodeType cmr_t,
             kEvsCmrCodeDefine cmr_d);
 
@@ -67,6 +76,11 @@ private:
     int32_t mCoreEvsMode;
     int8_t mEvsOffset;
     int32_t EvsChAOffset;
+    int8_t mSamplingRate;
+    int8_t mRedundancyDistance;
+    // the latest timestamp of the primary data received
+    bool mPrimaryReceived;
+    uint32_t mLastPrimaryTimestamp;
 };
 
 #endif
@@ -19,6 +19,9 @@
 
 #include <BaseNode.h>
 #include <ImsMediaBitWriter.h>
+#include <atomic>
+#include <deque>
+#include <vector>
 
 class AudioRtpPayloadEncoderNode : public BaseNode
 {
@@ -37,18 +40,49 @@ public:
     virtual void SetConfig(void* config);
     virtual bool IsSameConfig(void* config);
 
+    /**
+     * @brief Sets the number of audio frames to pack in a rtp packet. The number is limited by
+     * the maxptime and applied from the next packet to keep the packet being packed intact.
+     *
+     * @param numFrames The number of audio frames per rtp packet
+     */
+    void SetNumFramesPerPacket(uint32_t numFrames);
+
 private:
     void EncodePayloadAmr(uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp);
     void EncodePayloadEvs(uint8_t* pData, uint32_t nDataSize, uint32_t nTimeStamp);
+    /**
+     * @brief Sends the payload to the rear node. The payload is sent with the previous payloads
+     * as the redundant audio data of RFC 2198 when the redundancy is configured, the payloads
+     * sent in the dtmf mode are not kept for the redundancy as they are dropped.
+     */
+    void SendPayload(uint8_t* pData, uint32_t nDataSize, uint32_t nTimestamp, bool bMark);
+    /**
+     * @brief Passes the number of frames in the payload to send to the rtp encoder node, it keeps
+     * the rtp timestamp continuous when the number of frames per packet is changed.
+     */
+    void SetNumFramesToRearNode(uint32_t numFrames);
     uint32_t CheckPaddingNecessity(uint32_t nTotalSize);
 
+    struct RedundantPayload
+    {
+        uint32_t timestamp;
+        std::vector<uint8_t> data;
+    };
+
     int32_t mCodecType;
     bool mOctetAligned;
     int8_t mPtime;
+    int32_t mMaxPtime;
     uint8_t mPayload[MAX_AUDIO_PAYLOAD_SIZE];
     bool mFirstFrame;
     uint32_t mTimestamp;
     uint32_t mMaxNumOfFrame;
+    // the number of frames per packet applied when the next packet starts, it is set by the
+    // session thread
+    std::atomic<uint32_t> mNextNumOfFrame;
+    // the size of the ip, udp and rtp header to count the bytes saved by the frame aggregation
+    uint32_t mHeaderOverhead;
     uint32_t mCurrNumOfFrame;
     uint32_t mCurrFramePos;
     uint32_t mTotalPayloadSize;
@@ -61,6 +95,18 @@ private:
     kEvsBitrate mEvsMode;
     int32_t mCoreEvsMode;
     kRtpPyaloadHeaderMode mEvsPayloadHeaderMode;
+    int8_t mSamplingRate;
+    int8_t mRtpPayloadTx;
+    int8_t mRedPayloadType;
+    int8_t mRedundancyLevel;
+    int8_t mRedundancyDistance;
+    // the previous payloads sent, the latest one is at the front
+    std::deque<RedundantPayload> mRedundantPayloads;
+    // the payloads are dropped by the rtp encoder while the dtmf is sent
+    std::atomic<bool> mDtmfMode;
+    // the previous payloads are not contiguous to the next one after the start or the end of dtmf
+    std::atomic<bool> mRedundancyReset;
+    uint8_t mRedPayload[MAX_AUDIO_PAYLOAD_SIZE];
 };
 
 #endif
@@ -44,6 +44,14 @@ public:
     virtual void* run();
 
 private:
+    /**
+     * @brief Gets the playout speed to move the audio jitter buffer toward its size
+     *
+     * @param currentRate The playout speed of the previous frame
+     * @return double The playout speed of the next frame between 0.9 and 1.1
+     */
+    double GetPlaybackRate(double currentRate);
+
     AudioConfig* mConfig;
     std::unique_ptr<ImsMediaAudioPlayer> mAudioPlayer;
     int32_t mCodecType;
@@ -55,6 +63,7 @@ private:
     int32_t mEvsPayloadHeaderMode;
     bool mIsDtxEnabled;
     bool mIsOctetAligned;
+    int8_t mPlayoutDelayPercentile;
 };
 
 #endif
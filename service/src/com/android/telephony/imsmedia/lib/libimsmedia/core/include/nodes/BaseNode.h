@@ -56,6 +56,8 @@ enum kBaseNodeId
     kNodeIdVideoRenderer,
     kNodeIdVideoPayloadEncoder,
     kNodeIdVideoPayloadDecoder,
+    kNodeIdVideoFecEncoder,
+    kNodeIdVideoFecDecoder,
     // for Text
     kNodeIdTextSource,
     kNodeIdTextRenderer,
@@ -28,6 +28,20 @@ public:
     virtual ~JitterBufferControlNode();
     void SetJitterBufferSize(uint32_t nInit, uint32_t nMin, uint32_t nMax);
     void SetJitterOptions(uint32_t nReduceTH, uint32_t nStepSize, double zValue, bool bIgnoreSID);
+    /**
+     * @brief Sets the audio jitter buffer size to follow the percentile of the packet delay
+     */
+    void SetPlayoutDelayOptions(double percentile, double attackRate, double decayRate);
+    /**
+     * @brief Gets the number of the audio frames queued over the jitter buffer size, 0 for the
+     * other media
+     */
+    int32_t GetJitterBufferDepthError();
+    /**
+     * @brief Sets the offset of the partial copy of the evs channel aware mode to the audio
+     * jitter buffer
+     */
+    void SetEvsRedundantFrameOffset(int32_t offset);
     void Reset();
     virtual uint32_t GetDataCount();
     virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
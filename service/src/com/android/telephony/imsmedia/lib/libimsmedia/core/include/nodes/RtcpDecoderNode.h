@@ -20,6 +20,7 @@
 #include <BaseNode.h>
 #include <IRtpSession.h>
 #include <ImsMediaBitReader.h>
+#include <BandwidthEstimator.h>
 
 class RtcpDecoderNode : public BaseNode, public IRtcpDecoderListener
 {
@@ -40,6 +41,13 @@ public:
     virtual void OnNumReceivedPacket(uint32_t nNumRTCPSRPacket, uint32_t nNumRTCPRRPacket);
     virtual void OnEvent(uint32_t event, uint32_t param);
 
+    /**
+     * @brief Invokes when the transport feedback is received. The delay gradient of the packets
+     * reported updates the bandwidth estimation and the bitrate of the encoder is changed when the
+     * estimation moves enough.
+     */
+    virtual void OnTransportFeedback(const TransportFeedbackResult& feedback);
+
     /**
      * @brief Set the local ip address and port number
      */
@@ -63,6 +71,14 @@ public:
      */
     void ReceiveTmmbr(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* pstRtcp);
 
+    /**
+     * @brief Invokes when the generic NACK received from the RtpStack. This methods requests to
+     * retransmit the packets of each FCI entry to the encoder.
+     *
+     * @param pstRtcp The payload object set received.
+     */
+    void ReceiveNack(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* pstRtcp);
+
     /**
      * @brief Requests to send event to send IDR frame set to encoder
      */
@@ -75,6 +91,8 @@ private:
     uint32_t mInactivityTime;
     uint32_t mNoRtcpTime;
     ImsMediaBitReader mBitReader;
+    BandwidthEstimator mBandwidthEstimator;
+    uint32_t mNotifiedBitrate;
 };
 
 #endif  // RTCPDECODERNODE_H
@@ -58,11 +58,13 @@ public:
     void SetPeerAddress(const RtpAddress& address);
 
     /**
-     * @brief Creates NACK payload and request RtpStack to send it
+     * @brief Creates NACK payload and request RtpStack to send it. The generic NACK FCIs are
+     * packed in the feedback messages of up to 64 FCIs each.
      *
-     * @param param The parameters to packetize the payload
+     * @param param The parameters to packetize the payload, a PID and BLP of each FCI
+     * @param count The number of the FCIs in the param
      */
-    bool SendNack(NackParams* param);
+    bool SendNack(NackParams* param, uint32_t count = 1);
 
     /**
      * @brief Create PLI/FIR payload and request RtpStack to send it
@@ -87,6 +89,15 @@ public:
      */
     bool SendRtcpXr(uint8_t* data, uint32_t size);
 
+    /**
+     * @brief Send the transport feedback built by the RtpDecoderNode when RTP_FB_TRANSPORT_CC is
+     * negotiated. The data is deleted after sending.
+     *
+     * @param data The FCI of the transport feedback
+     * @param size The size of the FCI
+     */
+    bool SendTransportFeedback(uint8_t* data, uint32_t size);
+
 private:
     IRtpSession* mRtpSession;
     RtpAddress mLocalAddress;
@@ -95,6 +106,7 @@ private:
     uint8_t* mRtcpXrPayload;
     bool mEnableRtcpBye;
     uint32_t mRtcpXrBlockTypes;
+    bool mRtcpReducedSize;
     int32_t mRtcpXrCounter;
     int32_t mRtcpFbTypes;
     hTimerHandler mTimer;
@@ -20,6 +20,8 @@
 #include <BaseNode.h>
 #include <IRtpSession.h>
 #include <RtpHeaderExtension.h>
+#include <RtpHeaderExtensionRegistry.h>
+#include <TransportFeedback.h>
 
 // #define DEBUG_JITTER_GEN_SIMULATION_DELAY
 // #define DEBUG_JITTER_GEN_SIMULATION_REORDER
@@ -72,6 +74,7 @@ private:
     void processDtmf(uint8_t* data);
     std::list<RtpHeaderExtension>* DecodeRtpHeaderExtension(
             const RtpHeaderExtensionInfo& extensionInfo);
+    void SendTransportFeedback();
 
     IRtpSession* mRtpSession;
     RtpAddress mLocalAddress;
@@ -83,6 +86,11 @@ private:
     int8_t mRtpRxDtmfPayload;
     int8_t mDtmfSamplingRate;
     int32_t mCvoValue;
+    RtpHeaderExtensionRegistry mExtensionRegistry;
+    int32_t mTransportSeqValue;
+    bool mTransportCcEnabled;
+    TransportFeedback mTransportFeedback;
+    uint32_t mLastTransportFeedbackTime;
     uint32_t mReceivingSSRC;
     uint32_t mInactivityTime;
     uint32_t mNoRtpTime;
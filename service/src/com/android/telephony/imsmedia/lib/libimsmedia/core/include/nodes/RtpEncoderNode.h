@@ -20,6 +20,8 @@
 #include <BaseNode.h>
 #include <IRtpSession.h>
 #include <RtpHeaderExtension.h>
+#include <RtpHeaderExtensionRegistry.h>
+#include <RtpPacketHistory.h>
 #include <mutex>
 
 class RtpEncoderNode : public BaseNode, public IRtpEncoderListener
@@ -63,7 +65,31 @@ public:
      */
     void SetRtpHeaderExtension(std::list<RtpHeaderExtension>* listExtension);
 
+    /**
+     * @brief Retransmits the video packets requested by the generic NACK (RFC 4585) from the
+     * history of the packets sent. The packets are retransmitted in the stream with the original
+     * sequence number and a packet is not retransmitted again within the round trip time.
+     *
+     * @param pid The packet identifier of the lost packet
+     * @param blp The bitmask of the following lost packets
+     */
+    void RetransmitPackets(uint16_t pid, uint16_t blp);
+
+    /**
+     * @brief Sets the number of audio frames in the audio payload passed next to this node. The
+     * numbers are kept in the order of the payloads to keep the rtp timestamp continuous when the
+     * number of frames per packet is changed.
+     *
+     * @param numFrames The number of audio frames in the payload
+     */
+    void SetNumFramesOfNextPayload(uint32_t numFrames);
+
 private:
+    /**
+     * @brief Updates the cvo extension in the header extension template, the caller shall hold
+     * mMutex.
+     */
+    bool UpdateCvoExtension(const int64_t facing, const int64_t orientation);
     bool ProcessAudioData(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize);
     void ProcessVideoData(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
             uint32_t timestamp, bool mark);
@@ -77,6 +103,10 @@ private:
     bool mDTMFMode;
     bool mMark;
     uint32_t mPrevTimestamp;
+    // the number of audio frames in the previous packet
+    uint32_t mPrevNumOfFrames;
+    // the number of audio frames in the payloads not processed yet, guarded by mMutex
+    std::list<uint32_t> mListNumOfFrames;
     int8_t mSamplingRate;
     int8_t mRtpPayloadTx;
     int8_t mRtpPayloadRx;
@@ -88,6 +118,14 @@ private:
     int8_t mRedundantPayload;
     int8_t mRedundantLevel;
     std::list<RtpHeaderExtensionInfo> mListRtpExtension;
+    // cvo and the transport wide sequence number for the last packet of the IDR frame
+    RtpHeaderExtensionRegistry mExtensionRegistry;
+    // the transport wide sequence number only for the other packets
+    RtpHeaderExtensionRegistry mTransportSeqRegistry;
+    int32_t mTransportSeqValue;
+    uint16_t mTransportSeqNum;
+    // the video packets sent to answer the NACK
+    RtpPacketHistory mPacketHistory;
 };
 
 #endif
@@ -57,6 +57,8 @@ public:
     void SetProtocolType(kProtocolType type) { mProtocolType = type; }
 
 private:
+    bool IsRtcpMuxReader();
+
     int mLocalFd;
     kProtocolType mProtocolType;
     ISocket* mSocket;
@@ -66,6 +68,7 @@ private:
     std::mutex mMutex;
     uint8_t mBuffer[DEFAULT_MTU];
     bool mReceiveTtl;
+    bool mRtcpMuxEnabled;
 };
 
 #endif
\ No newline at end of file
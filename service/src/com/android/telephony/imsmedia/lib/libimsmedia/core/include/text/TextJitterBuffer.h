@@ -18,12 +18,14 @@
 #define TEXT_JITTER_BUFFER_INCLUDED
 
 #include <BaseJitterBuffer.h>
+#include <JitterRingQueue.h>
 
 class TextJitterBuffer : public BaseJitterBuffer
 {
 public:
     TextJitterBuffer();
     virtual ~TextJitterBuffer();
+    virtual uint32_t GetCount();
     virtual void Reset();
     virtual void Add(ImsMediaSubType subtype, uint8_t* buffer, uint32_t size, uint32_t timestamp,
             bool mark, uint32_t seqNum,
@@ -32,6 +34,10 @@ public:
     virtual bool Get(ImsMediaSubType* subtype, uint8_t** data, uint32_t* dataSize,
             uint32_t* timestamp, bool* mark, uint32_t* seqNum, uint32_t currentTime);
     virtual void Delete();
+
+private:
+    // the text packets ordered by the sequence number
+    JitterRingQueue mRingQueue;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,148 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BANDWIDTH_ESTIMATOR_H
+#define BANDWIDTH_ESTIMATOR_H
+
+#include <stdint.h>
+#include <deque>
+
+enum kBandwidthUsage
+{
+    kBandwidthNormal = 0,
+    kBandwidthUnderusing,
+    kBandwidthOverusing,
+};
+
+/**
+ * @brief The delay based bandwidth estimator modeled on the google congestion control of
+ * draft-ietf-rmcat-gcc-02.
+ *
+ * The packets sent in a burst are grouped and the variation of the inter-group delay is smoothed
+ * by the trendline filter. The slope of the trendline is compared with the adaptive threshold to
+ * detect the queue building up before the packets are lost. The target bitrate is controlled by
+ * AIMD with the detected bandwidth usage and capped by the packet loss and the round trip time.
+ */
+class BandwidthEstimator
+{
+public:
+    BandwidthEstimator();
+    ~BandwidthEstimator();
+
+    /**
+     * @brief Clears the delay and the loss statistics and sets the target bitrate to the start
+     * bitrate
+     */
+    void Reset();
+
+    /**
+     * @brief Sets the range of the target bitrate
+     *
+     * @param minBitrate The minimum bitrate in bps, limited by the maximum bitrate
+     * @param maxBitrate The maximum bitrate in bps, 0 when it is not limited
+     * @param startBitrate The initial target bitrate in bps, 0 to keep the current target bitrate
+     */
+    void SetBitrateRange(uint32_t minBitrate, uint32_t maxBitrate, uint32_t startBitrate);
+
+    /**
+     * @brief Sets the round trip time used to pace the rate decrease and the additive increase
+     *
+     * @param rtt The round trip time in milliseconds
+     */
+    void SetRoundTripTime(uint32_t rtt);
+
+    /**
+     * @brief Updates the delay gradient with the arrival of the packet. The send time and the
+     * arrival time can be on the different clocks, only the difference between the packets is
+     * used.
+     *
+     * @param sendTimeUs The send time of the packet in microseconds
+     * @param arrivalTimeUs The arrival time of the packet in microseconds
+     * @return kBandwidthUsage The bandwidth usage detected after the packet is applied
+     */
+    kBandwidthUsage OnPacketArrival(int64_t sendTimeUs, int64_t arrivalTimeUs);
+
+    /**
+     * @brief Accumulates the number of the lost packets until the next Update()
+     *
+     * @param numLost The number of the lost packets
+     * @param numPackets The number of the packets expected including the lost packets
+     */
+    void OnPacketLoss(uint32_t numLost, uint32_t numPackets);
+
+    /**
+     * @brief Updates the target bitrate with the bandwidth usage, the loss accumulated and the
+     * incoming bitrate
+     *
+     * @param currentTime The current time in milliseconds
+     * @param incomingBitrate The bitrate measured at the receiver in bps, 0 when it is not known
+     * @return uint32_t The target bitrate in bps
+     */
+    uint32_t Update(uint32_t currentTime, uint32_t incomingBitrate);
+
+    kBandwidthUsage GetUsage();
+    uint32_t GetTargetBitrate();
+
+private:
+    void OnGroupComplete(double delayVariation, int64_t arrivalTimeMs);
+    void DetectUsage(double trend, double timeDelta);
+    void UpdateThreshold(double modifiedTrend, double timeDelta);
+    uint32_t GetResponseTime();
+    uint32_t ClampBitrate(uint32_t bitrate);
+
+    struct PacketGroup
+    {
+        int64_t firstSendTimeUs;
+        int64_t lastSendTimeUs;
+        int64_t lastArrivalTimeUs;
+    };
+
+    uint32_t mMinBitrate;
+    uint32_t mMaxBitrate;
+    uint32_t mStartBitrate;
+    uint32_t mTargetBitrate;
+    uint32_t mRoundTripTime;
+
+    // the packet groups
+    PacketGroup mCurrentGroup;
+    PacketGroup mPreviousGroup;
+    bool mCurrentGroupValid;
+    bool mPreviousGroupValid;
+
+    // the trendline filter
+    std::deque<std::pair<double, double>> mDelayHistory;
+    int64_t mFirstArrivalTimeMs;
+    int64_t mLastGroupArrivalTimeMs;
+    double mAccumulatedDelay;
+    double mSmoothedDelay;
+    uint32_t mNumDeltas;
+
+    // the overuse detector
+    kBandwidthUsage mUsage;
+    double mThreshold;
+    double mPreviousTrend;
+    double mOverusingTime;
+    uint32_t mOverusingCount;
+
+    // the rate controller
+    uint32_t mLastUpdateTime;
+    uint32_t mLastDecreaseTime;
+    uint32_t mLastDecreaseBitrate;
+    uint32_t mNumLostPackets;
+    uint32_t mNumExpectedPackets;
+};
+
+#endif
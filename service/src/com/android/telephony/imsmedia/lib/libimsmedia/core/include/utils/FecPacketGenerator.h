@@ -0,0 +1,111 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FEC_PACKET_GENERATOR_H
+#define FEC_PACKET_GENERATOR_H
+
+#include <stdint.h>
+#include <list>
+#include <vector>
+
+enum kFecMaskType
+{
+    // the media packet i is protected by the fec packet (i % numFec), good for the burst loss
+    kFecMaskInterleaved = 0,
+    // the media packets are protected in the consecutive groups, good for the random loss
+    kFecMaskConsecutive,
+};
+
+/**
+ * @brief Generates the XOR parity packets of the generic forward error correction of RFC 5109
+ * over the rtp packets of the media stream.
+ *
+ * The media packets of a video frame are added one by one and the fec packets are generated at
+ * the end of the frame. The number of the fec packets is the fec rate of the number of the media
+ * packets and each fec packet protects the media packets selected by the mask type.
+ */
+class FecPacketGenerator
+{
+public:
+    enum
+    {
+        // the size of the fec header without the level header
+        kFecHeaderSize = 10,
+        // the size of the level 0 header with the 16 bits mask
+        kShortLevelHeaderSize = 4,
+        // the size of the level 0 header with the 48 bits mask
+        kLongLevelHeaderSize = 8,
+        // the maximum number of the media packets protected together
+        kMaxMediaPackets = 48,
+        kShortMaskBits = 16,
+    };
+
+    FecPacketGenerator();
+    ~FecPacketGenerator();
+
+    /**
+     * @brief Removes the media packets not protected yet
+     */
+    void Reset();
+
+    /**
+     * @brief Sets the protection level of the next fec packets generated
+     *
+     * @param fecRate The number of the fec packets per the number of the media packets in
+     * percent, 0 not to generate the fec packets
+     * @param maskType The packet mask type defined in kFecMaskType
+     */
+    void SetProtection(uint32_t fecRate, kFecMaskType maskType);
+
+    uint32_t GetFecRate();
+
+    /**
+     * @brief Adds the rtp packet to protect. The packet having the sequence number not newer than
+     * the last one added, such as the retransmitted packet, is not added.
+     *
+     * @param packet The rtp packet including the rtp header
+     * @param size The size of the packet in bytes
+     * @return true The packet is added
+     * @return false The packet is not valid or not newer than the last one
+     */
+    bool AddMediaPacket(const uint8_t* packet, uint32_t size);
+
+    /**
+     * @brief Gets the number of the media packets added but not protected yet
+     */
+    uint32_t GetNumMediaPackets();
+
+    /**
+     * @brief Generates the fec packets protecting the media packets added and removes the media
+     * packets
+     *
+     * @param fecPackets The list to append the fec payloads, the fec header, the level header and
+     * the parity, without the rtp header
+     * @return uint32_t The number of the fec packets generated
+     */
+    uint32_t Generate(std::list<std::vector<uint8_t>>& fecPackets);
+
+private:
+    void GenerateFecPacket(const std::vector<uint32_t>& indexes, std::vector<uint8_t>& fec);
+
+    std::vector<std::vector<uint8_t>> mMediaPackets;
+    uint32_t mFecRate;
+    kFecMaskType mMaskType;
+    bool mHasLastSeqNum;
+    uint16_t mLastSeqNum;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef FEC_PACKET_RECOVERY_H
+#define FEC_PACKET_RECOVERY_H
+
+#include <stdint.h>
+#include <deque>
+#include <list>
+#include <vector>
+
+/**
+ * @brief Recovers the lost rtp packets from the XOR parity packets of the generic forward error
+ * correction of RFC 5109 generated by FecPacketGenerator.
+ *
+ * The recent media packets received are kept to rebuild the lost one. A fec packet recovers the
+ * media packet when it is the only one missing among the media packets protected by the fec
+ * packet, the recovered packet is used for the other fec packets in turn. The fec packets are sent
+ * as a separate stream with its own ssrc and sequence numbers, it is associated with the media
+ * stream received as there is one in the session. The packets kept are dropped when the ssrc of the
+ * media packets or the fec packets changes.
+ */
+class FecPacketRecovery
+{
+public:
+    enum
+    {
+        // the number of the recent media packets kept
+        kMaxMediaPackets = 192,
+        // the number of the fec packets waiting for the media packets
+        kMaxFecPackets = 48,
+    };
+
+    FecPacketRecovery();
+    ~FecPacketRecovery();
+
+    /**
+     * @brief Removes all the media packets and the fec packets kept
+     */
+    void Reset();
+
+    /**
+     * @brief Keeps the media rtp packet received
+     *
+     * @param packet The rtp packet including the rtp header
+     * @param size The size of the packet in bytes
+     */
+    void OnMediaPacket(const uint8_t* packet, uint32_t size);
+
+    /**
+     * @brief Keeps the fec packet received and recovers the lost media packets
+     *
+     * @param fec The fec payload following the rtp header of the fec packet
+     * @param size The size of the fec payload in bytes
+     * @param ssrc The ssrc of the fec stream
+     * @return bool false when the fec payload is not valid
+     */
+    bool OnFecPacket(const uint8_t* fec, uint32_t size, uint32_t ssrc);
+
+    /**
+     * @brief Gets the media rtp packet recovered and removes it from the list of recovered packets
+     *
+     * @param packet The rtp packet recovered including the rtp header
+     * @return true A packet is recovered
+     * @return false There is no packet recovered
+     */
+    bool GetRecoveredPacket(std::vector<uint8_t>& packet);
+
+    /**
+     * @brief Gets the total number of the media packets recovered
+     */
+    uint32_t GetNumRecovered();
+
+private:
+    struct FecPacket
+    {
+        uint16_t seqBase;
+        uint16_t protectionLength;
+        std::vector<uint16_t> protectedSeqNums;
+        std::vector<uint8_t> data;
+    };
+
+    void SetMediaSsrc(uint32_t ssrc);
+    void SetFecSsrc(uint32_t ssrc);
+    const std::vector<uint8_t>* FindMediaPacket(uint16_t seqNum);
+    void StoreMediaPacket(uint16_t seqNum, const uint8_t* packet, uint32_t size);
+    void Recover();
+    bool RecoverPacket(const FecPacket& fec, uint16_t seqNum);
+
+    std::deque<std::pair<uint16_t, std::vector<uint8_t>>> mMediaPackets;
+    std::list<FecPacket> mFecPackets;
+    std::list<std::vector<uint8_t>> mRecoveredPackets;
+    bool mHasNewestSeqNum;
+    uint16_t mNewestSeqNum;
+    bool mHasMediaSsrc;
+    uint32_t mMediaSsrc;
+    bool mHasFecSsrc;
+    uint32_t mFecSsrc;
+    uint32_t mNumRecovered;
+};
+
+#endif
@@ -70,6 +70,7 @@ public:
     virtual char* GetPeerIPAddress() = 0;
     virtual bool Open(int localFd = 0) = 0;
     virtual void Listen(ISocketListener* listener) = 0;
+    virtual void ListenRtcpMux(ISocketListener* listener) = 0;
     virtual int32_t SendTo(uint8_t* pData, uint32_t nDataSize) = 0;
     virtual int32_t ReceiveFrom(uint8_t* pData, uint32_t nBufferSize) = 0;
     virtual bool RetrieveOptionMsg(uint32_t type, int32_t& value) = 0;
@@ -77,6 +77,18 @@ public:
      * @param socketFd The socket file descriptor
      */
     static void closeSocket(int& socketFd);
+
+    /**
+     * @brief Check whether the packet received on the port multiplexing RTP and RTCP is a RTCP
+     * packet. As in RFC 5761 section 4, the second byte of RTCP packet is the packet type in range
+     * of 192 to 223, which does not overlap the marker bit and payload type of the RTP packet.
+     *
+     * @param data The received packet
+     * @param size The size of the packet
+     * @return true Returns when the packet is RTCP packet
+     * @return false Returns when the packet is RTP packet or too short to classify
+     */
+    static bool isRtcpPacket(const uint8_t* data, const uint32_t size);
 };
 
 #endif  // IMS_MEDIA_NW_UTIL_H
\ No newline at end of file
@@ -39,6 +39,8 @@ private:
     static void SocketMonitorThread();
     static uint32_t SetSocketFD(void* pReadFds, void* pWriteFds, void* pExceptFds);
     static void ReadDataFromSocket(void* pReadfds);
+    void UpdateRxSocketList(bool wasListening);
+    void NotifyListener();
 
 public:
     /**
@@ -73,6 +75,16 @@ public:
      */
     virtual void Listen(ISocketListener* listener);
 
+    /**
+     * @brief Add the listener of the RTCP packets multiplexed with RTP on this socket as in
+     * RFC 5761. When it is set, the received packets are classified by the packet type and only the
+     * RTCP packets are notified to this listener, the others are notified to the listener set by
+     * Listen(). The socket stays in the rx socket list while any of the listeners is set.
+     *
+     * @param listener The listener of the RTCP packets, null to remove it
+     */
+    virtual void ListenRtcpMux(ISocketListener* listener);
+
     /**
      * @brief Send data to registered socket
      *
@@ -130,6 +142,7 @@ private:
     int32_t mSocketFd;
     int32_t mRefCount;
     ISocketListener* mListener;
+    ISocketListener* mRtcpMuxListener;
     kIpVersion mLocalIPVersion;
     kIpVersion mPeerIPVersion;
     char mLocalIP[MAX_IP_LEN]{};
@@ -0,0 +1,132 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef JITTER_RING_QUEUE_H
+#define JITTER_RING_QUEUE_H
+
+#include <ImsMediaDataQueue.h>
+#include <deque>
+#include <list>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief The storage of the jitter buffer ordered by the rtp sequence number.
+ *
+ * The entries are kept in a ring indexed by the sequence number modulo the capacity, the slot of
+ * the out of order packet is found without walking the queue. The sequence numbers are compared
+ * with the 16 bit wrap around. The entries of the same sequence number, the frames of a packet
+ * carrying multiple frames, are kept in the slot in the order of the insertion. The ring grows
+ * when the range of the sequence numbers in the queue exceeds the capacity.
+ */
+class JitterRingQueue
+{
+public:
+    enum
+    {
+        // the initial number of the slots, a power of 2
+        kDefaultCapacity = 64,
+        // the maximum range of the sequence numbers kept in the queue
+        kMaxCapacity = 4096,
+    };
+
+    JitterRingQueue();
+    ~JitterRingQueue();
+
+    /**
+     * @brief Inserts the copy of the entry in the order of the sequence number. When the entry is
+     * newer than the range allowed, the oldest entries are removed to keep the range.
+     *
+     * @param entry The entry to insert, the buffer is copied
+     * @param droppedSeqs The sequence numbers of the entries removed to keep the range, one per
+     * entry removed
+     * @return true when inserted, false when the entry is older than the range allowed
+     */
+    bool Insert(DataEntry* entry, std::list<uint16_t>* droppedSeqs = nullptr);
+
+    /**
+     * @brief Finds the entry of the sequence number and the timestamp
+     *
+     * @param seq The sequence number to find
+     * @param timestamp The timestamp to find
+     * @param entry The entry found
+     * @return true when the entry is in the queue
+     */
+    bool Find(uint16_t seq, uint32_t timestamp, DataEntry** entry);
+
+    /**
+     * @brief Checks there is any entry of the sequence number in the queue
+     */
+    bool Contains(uint16_t seq);
+
+    /**
+     * @brief Checks the sequence number is older than the first entry in the queue
+     */
+    bool IsOlderThanFirst(uint16_t seq);
+
+    /**
+     * @brief Removes the first entry and deletes its buffer
+     */
+    void Delete();
+
+    /**
+     * @brief Removes all the entries
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the first entry, the oldest sequence number
+     */
+    bool Get(DataEntry** entry);
+
+    /**
+     * @brief Gets the last entry, the newest sequence number
+     */
+    bool GetLast(DataEntry** entry);
+
+    uint32_t GetCount();
+    uint32_t GetCapacity();
+
+    /**
+     * @brief Sets the position to read by GetNext() to the first entry
+     */
+    void SetReadPosFirst();
+
+    /**
+     * @brief Gets the entry at the read position and moves the position to the next entry
+     */
+    bool GetNext(DataEntry** entry);
+
+private:
+    JitterRingQueue(const JitterRingQueue& obj);
+    JitterRingQueue& operator=(const JitterRingQueue& obj);
+
+    uint32_t GetIndex(uint16_t seq) { return seq & (mSlots.size() - 1); }
+    void Grow(uint32_t range);
+    void DeleteFirst();
+
+    std::vector<std::deque<DataEntry*>> mSlots;
+    uint16_t mFirstSeq;
+    uint16_t mLastSeq;
+    uint32_t mCount;
+    // the read position of GetNext()
+    uint16_t mReadSeq;
+    uint32_t mReadIndex;
+    uint32_t mNumRead;
+    std::mutex mMutex;
+};
+
+#endif
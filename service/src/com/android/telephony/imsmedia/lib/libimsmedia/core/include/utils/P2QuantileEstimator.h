@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef P2_QUANTILE_ESTIMATOR_H
+#define P2_QUANTILE_ESTIMATOR_H
+
+#include <stdint.h>
+
+/**
+ * @brief The quantile of the samples estimated by the P-square algorithm of Jain and Chlamtac,
+ * five markers are adjusted per sample without storing the samples.
+ *
+ * The estimation covers all the samples added after Reset(). It is not thread safe, the owner
+ * locks.
+ */
+class P2QuantileEstimator
+{
+public:
+    enum
+    {
+        kNumMarkers = 5,
+    };
+
+    /**
+     * @param quantile The quantile to estimate between 0 and 1, 0.95 for the 95th percentile
+     */
+    explicit P2QuantileEstimator(double quantile);
+    ~P2QuantileEstimator();
+
+    /**
+     * @brief Sets the quantile to estimate and clears the samples
+     */
+    void SetQuantile(double quantile);
+    double GetQuantile();
+
+    /**
+     * @brief Clears the samples
+     */
+    void Reset();
+
+    void Add(double value);
+    uint32_t GetCount();
+
+    /**
+     * @brief Gets the estimated value of the quantile, the exact one until the markers are
+     * initialized by the first five samples, 0 when there is no sample
+     */
+    double GetEstimation();
+
+private:
+    double CalculateParabolic(int32_t i, int32_t d);
+    double CalculateLinear(int32_t i, int32_t d);
+
+    double mQuantile;
+    uint32_t mCount;
+    // the heights, the positions and the desired positions of the markers
+    double mHeights[kNumMarkers];
+    double mPositions[kNumMarkers];
+    double mDesiredPositions[kNumMarkers];
+    double mIncrements[kNumMarkers];
+};
+
+#endif
@@ -0,0 +1,149 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTP_HEADER_EXTENSION_REGISTRY_H
+#define RTP_HEADER_EXTENSION_REGISTRY_H
+
+#include <ImsMediaDefine.h>
+#include <stdint.h>
+
+/** The rtp header extensions handled by the media stack */
+enum kRtpHeaderExtensionType
+{
+    // 3GPP TS 26.114 coordination of video orientation, 1 byte
+    kRtpHeaderExtensionCvo = 0,
+    // RFC 6464 client to mixer audio level, 1 byte
+    kRtpHeaderExtensionAudioLevel,
+    // transport wide sequence number, 2 bytes
+    kRtpHeaderExtensionTransportSeq,
+    kRtpHeaderExtensionMax,
+};
+
+/** The view of a single element of the rtp header extension, it points into the packet */
+struct RtpHeaderExtensionView
+{
+    uint8_t id;
+    uint8_t size;
+    const uint8_t* data;
+};
+
+/**
+ * @brief The registry of the rtp header extensions keyed by the negotiated local identifiers.
+ *
+ * On the transmitting side, the extension block of the registered extensions is encoded once into
+ * a template when the registry is compiled. Only the bytes of the changing values are patched in
+ * place per packet afterwards, the template is passed to IRtpSession::SendRtpPacket as it is.
+ *
+ * On the receiving side, Parse() splits the extension block into views pointing into the received
+ * packet without any allocation.
+ */
+class RtpHeaderExtensionRegistry
+{
+public:
+    enum
+    {
+        // RFC 8285 one byte header allows the local identifier 1 to 14
+        kMaxOneByteHeaderId = 14,
+        kMaxId = 255,
+        // the number of views filled by Parse() at most
+        kMaxViews = 16,
+    };
+
+    RtpHeaderExtensionRegistry();
+    ~RtpHeaderExtensionRegistry();
+
+    /**
+     * @brief Registers the negotiated local identifier of the extension type, the template has to
+     * be compiled again to apply the change.
+     *
+     * @param type The type of the extension
+     * @param id The local identifier in range of 1 to 255
+     * @return true Returns when the identifier is valid and not used by other type
+     */
+    bool Register(kRtpHeaderExtensionType type, uint8_t id);
+
+    /**
+     * @brief Removes all the registered extensions and the template
+     */
+    void Clear();
+
+    /**
+     * @brief Gets the local identifier of the extension type, 0 when it is not registered
+     */
+    uint8_t GetId(kRtpHeaderExtensionType type);
+
+    /**
+     * @brief Gets the extension type of the local identifier, kRtpHeaderExtensionMax when it is
+     * not registered
+     */
+    kRtpHeaderExtensionType GetType(uint8_t id);
+
+    /**
+     * @brief Encodes the extension block of the registered extensions with zero values. The two
+     * byte header format is used when any of the identifiers does not fit in the one byte header.
+     *
+     * @return true Returns when at least one extension is registered
+     */
+    bool Compile();
+
+    /**
+     * @brief Gets the compiled template, nullptr when it is not compiled
+     */
+    RtpHeaderExtensionInfo* GetTemplate();
+
+    /**
+     * @brief Patches the value of the extension in the compiled template
+     *
+     * @param type The type of the extension
+     * @param value The value to write in network byte order, the size follows the type
+     * @return true Returns when the extension is in the template
+     */
+    bool SetValue(kRtpHeaderExtensionType type, uint32_t value);
+
+    /**
+     * @brief Finds the element of the extension type from the views parsed from a packet
+     *
+     * @return const RtpHeaderExtensionView* The view, nullptr when it is not found
+     */
+    const RtpHeaderExtensionView* Find(kRtpHeaderExtensionType type,
+            const RtpHeaderExtensionView* views, int32_t numViews);
+
+    /**
+     * @brief Splits the rtp header extension block into the views of the elements. The views
+     * point into the extension data and no memory is allocated.
+     *
+     * @param extensionInfo The received rtp header extension
+     * @param views The array of the views to fill
+     * @param maxViews The size of the views array
+     * @return int32_t The number of the views filled, -1 when the block is malformed
+     */
+    static int32_t Parse(const RtpHeaderExtensionInfo& extensionInfo,
+            RtpHeaderExtensionView* views, int32_t maxViews);
+
+    /**
+     * @brief Gets the size of the extension data of the type in bytes
+     */
+    static uint8_t GetDataSize(kRtpHeaderExtensionType type);
+
+private:
+    uint8_t mIds[kRtpHeaderExtensionMax];
+    kRtpHeaderExtensionType mTypes[kMaxId + 1];
+    // offset of the value of the extension type in the template, -1 when it is not compiled
+    int32_t mOffsets[kRtpHeaderExtensionMax];
+    RtpHeaderExtensionInfo mTemplate;
+};
+
+#endif
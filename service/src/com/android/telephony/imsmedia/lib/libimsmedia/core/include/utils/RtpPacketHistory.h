@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTP_PACKET_HISTORY_H
+#define RTP_PACKET_HISTORY_H
+
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief The bounded history of the rtp packets sent, keyed by the sequence number to answer the
+ * generic NACK (RFC 4585) with the retransmission.
+ *
+ * The packets are kept in a ring indexed by the lower bits of the sequence number, the oldest
+ * packet is overwritten when the ring is full. The buffers are reused once they are allocated.
+ */
+class RtpPacketHistory
+{
+public:
+    enum
+    {
+        // the number of packets kept, a power of 2
+        kMaxHistorySize = 256,
+        // the packets older than it are not retransmitted, the receiver gives up on them
+        kMaxPacketAge = 1000,  // milliseconds
+    };
+
+    RtpPacketHistory();
+    ~RtpPacketHistory();
+
+    /**
+     * @brief Removes all the packets
+     */
+    void Reset();
+
+    /**
+     * @brief Keeps the rtp packet sent
+     *
+     * @param packet The rtp packet including the rtp header
+     * @param size The size of the packet in bytes
+     * @param sentTime The time sent in milliseconds
+     */
+    void Add(const uint8_t* packet, uint32_t size, uint32_t sentTime);
+
+    /**
+     * @brief Gets the packet to retransmit. The same packet is not retransmitted again within the
+     * interval and the packet older than kMaxPacketAge is not retransmitted.
+     *
+     * @param seqNum The sequence number requested
+     * @param currentTime The current time in milliseconds
+     * @param interval The minimum interval between the retransmissions of the packet in
+     * milliseconds, the round trip time is used to ignore the NACK sent before the last
+     * retransmission arrives
+     * @param size The size of the packet returned
+     * @return const uint8_t* The packet to retransmit, nullptr when it is not available
+     */
+    const uint8_t* GetPacketToRetransmit(
+            uint16_t seqNum, uint32_t currentTime, uint32_t interval, uint32_t* size);
+
+    /**
+     * @brief Gets the number of the packets retransmitted
+     */
+    uint32_t GetNumRetransmitted();
+
+private:
+    struct HistoryEntry
+    {
+        bool valid;
+        uint16_t seqNum;
+        uint32_t sentTime;
+        uint32_t retransmitTime;
+        std::vector<uint8_t> packet;
+    };
+
+    HistoryEntry mEntries[kMaxHistorySize];
+    uint32_t mNumRetransmitted;
+};
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RTT_ESTIMATOR_H
+#define RTT_ESTIMATOR_H
+
+#include <stdint.h>
+#include <atomic>
+
+/**
+ * @brief The round trip time estimator of a RTP session. The samples measured from the report
+ * blocks of SR/RR or the DLRR blocks of RTCP XR are smoothed as RFC 6298 does.
+ *
+ * It is updated by the thread receiving the RTCP packets only, the other threads read the
+ * estimation without locking.
+ */
+class RttEstimator
+{
+public:
+    RttEstimator();
+    ~RttEstimator();
+
+    /**
+     * @brief Clears the samples
+     */
+    void Reset();
+
+    /**
+     * @brief Updates the estimation with the round trip time measured
+     *
+     * @param rtt The round trip time in milliseconds
+     */
+    void Update(uint32_t rtt);
+
+    /**
+     * @brief Gets the smoothed round trip time in milliseconds, 0 when there is no sample
+     */
+    uint32_t GetSmoothedRtt();
+
+    /**
+     * @brief Gets the variation of the round trip time in milliseconds
+     */
+    uint32_t GetRttVariation();
+
+    /**
+     * @brief Gets the last round trip time measured in milliseconds
+     */
+    uint32_t GetLatestRtt();
+
+    /**
+     * @brief Gets the time to wait for the response of the request before it is sent again,
+     * SRTT + max(G, 4 * RTTVAR) of RFC 6298
+     *
+     * @param granularity The minimum margin over the smoothed round trip time in milliseconds
+     * @return uint32_t The timeout in milliseconds, 0 when there is no sample
+     */
+    uint32_t GetRetransmissionTimeout(uint32_t granularity);
+
+private:
+    // in microseconds
+    std::atomic<uint32_t> mSmoothedRtt;
+    std::atomic<uint32_t> mRttVariation;
+    std::atomic<uint32_t> mLatestRtt;
+};
+
+#endif
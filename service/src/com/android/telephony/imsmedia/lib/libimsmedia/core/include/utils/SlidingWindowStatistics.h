@@ -0,0 +1,80 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef SLIDING_WINDOW_STATISTICS_H
+#define SLIDING_WINDOW_STATISTICS_H
+
+#include <stdint.h>
+#include <deque>
+#include <utility>
+
+/**
+ * @brief The mean, the standard deviation and the maximum of the last samples in the window,
+ * updated in constant time per sample.
+ *
+ * The mean and the variance are updated as Welford does and the sample evicted from the window is
+ * removed by the inverse update. The maximum is kept at the front of a deque of the samples which
+ * can still become the maximum, in decreasing order. It is not thread safe, the owner locks.
+ */
+class SlidingWindowStatistics
+{
+public:
+    /**
+     * @param windowSize The number of the last samples in the statistics
+     */
+    explicit SlidingWindowStatistics(uint32_t windowSize);
+    ~SlidingWindowStatistics();
+
+    /**
+     * @brief Clears the samples
+     */
+    void Reset();
+
+    /**
+     * @brief Adds the sample, the oldest one is evicted when the window is full
+     */
+    void Add(int32_t value);
+
+    uint32_t GetCount();
+
+    /**
+     * @brief Gets the mean of the samples in the window, 0 when there is no sample
+     */
+    double GetMean();
+
+    /**
+     * @brief Gets the population standard deviation of the samples in the window
+     */
+    double GetDeviation();
+
+    /**
+     * @brief Gets the maximum of the samples in the window, 0 when there is no sample
+     */
+    int32_t GetMax();
+
+private:
+    void Remove(int32_t value);
+
+    uint32_t mWindowSize;
+    std::deque<int32_t> mValues;
+    // the index of the sample and the value, the values are decreasing from the front
+    std::deque<std::pair<uint64_t, int32_t>> mMaxCandidates;
+    uint64_t mNumAdded;
+    double mMean;
+    // the sum of the squared differences from the mean
+    double mSquaredSum;
+};
+
+#endif
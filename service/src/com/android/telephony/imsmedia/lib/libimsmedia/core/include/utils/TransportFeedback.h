@@ -0,0 +1,114 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRANSPORT_FEEDBACK_H
+#define TRANSPORT_FEEDBACK_H
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+
+/** The result of a single packet reported in the transport feedback */
+struct TransportPacketResult
+{
+    uint16_t seqNum;
+    bool received;
+    // the arrival time in microseconds on the clock of the receiver, valid when received
+    int64_t arrivalTimeUs;
+    // the send time in milliseconds on the clock of the sender, -1 when it is not known
+    int64_t sendTimeMs;
+};
+
+/** The transport feedback parsed from the received rtcp packet */
+struct TransportFeedbackResult
+{
+    uint8_t feedbackCount;
+    std::vector<TransportPacketResult> packets;
+};
+
+/**
+ * @brief The transport-wide congestion control feedback of
+ * draft-holmer-rmcat-transport-wide-cc-extensions-01.
+ *
+ * On the receiving side, the arrival time of the packets carrying the transport wide sequence
+ * number header extension are collected by OnPacketReceived() and Build() encodes the FCI of the
+ * RTPFB packet with FMT 15 reporting them. Parse() decodes the FCI received from the peer.
+ */
+class TransportFeedback
+{
+public:
+    enum
+    {
+        // FMT of the transport feedback in the RTPFB packet
+        kTransportFeedbackFmt = 15,
+        // the number of packets reported in a feedback at most
+        kMaxStatusCount = 128,
+        // header, status vector chunks of 7 packets and 2 byte deltas, rounded up to the word size
+        kMaxFciSize = 8 + (kMaxStatusCount + 6) / 7 * 2 + kMaxStatusCount * 2 + 2,
+    };
+
+    TransportFeedback();
+    ~TransportFeedback();
+
+    /**
+     * @brief Clears the received packets and the sequence number state
+     */
+    void Reset();
+
+    /**
+     * @brief Records the arrival time of the received packet
+     *
+     * @param seqNum The transport wide sequence number in the rtp header extension
+     * @param arrivalTime The arrival time in milliseconds
+     */
+    void OnPacketReceived(uint16_t seqNum, uint32_t arrivalTime);
+
+    /**
+     * @brief Gets the number of the packets recorded after the last feedback built
+     */
+    uint32_t GetNumPendingPackets();
+
+    /**
+     * @brief Encodes the FCI of the transport feedback reporting the packets from the next one of
+     * the last reported packet and removes them from the pending list.
+     *
+     * @param buffer The buffer to write the FCI
+     * @param size The size of the buffer, kMaxFciSize is enough
+     * @return uint32_t The size of the FCI in bytes, 0 when there is nothing to report
+     */
+    uint32_t Build(uint8_t* buffer, uint32_t size);
+
+    /**
+     * @brief Decodes the FCI of the received transport feedback. The send time of the packets is
+     * not filled.
+     *
+     * @param fci The FCI of the received RTPFB packet after the media source ssrc
+     * @param size The size of the FCI
+     * @param result The result to fill
+     * @return true Returns when the FCI is decoded without error
+     */
+    static bool Parse(const uint8_t* fci, uint32_t size, TransportFeedbackResult* result);
+
+private:
+    // the unwrapped sequence number and the arrival time in milliseconds
+    std::map<int64_t, uint32_t> mPackets;
+    int64_t mLastSeqNum;
+    // the unwrapped sequence number to report next, -1 when no feedback is built yet
+    int64_t mNextBaseSeqNum;
+    uint8_t mFeedbackCount;
+};
+
+#endif
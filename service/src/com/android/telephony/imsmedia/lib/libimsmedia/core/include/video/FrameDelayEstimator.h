@@ -0,0 +1,110 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef FRAME_DELAY_ESTIMATOR_H
+#define FRAME_DELAY_ESTIMATOR_H
+
+#include <SlidingWindowStatistics.h>
+#include <stdint.h>
+
+/**
+ * @brief The jitter of the video frames and the target render delay of the video jitter buffer.
+ *
+ * The delay of a frame is the inter-frame arrival delta minus the rtp timestamp delta, it is
+ * modeled as the size of the frame over the channel rate plus the queuing noise:
+ *
+ *     delay = (size - prevSize) / channelRate + queuingDelay + noise
+ *
+ * The slope and the offset are tracked by a Kalman filter and the noise by its exponential mean
+ * and variance. The jitter is the delay of the largest frame over the average one plus the upper
+ * bound of the noise. The target render delay follows the jitter at once when it goes up and
+ * slowly when it goes down, in the range of the minimum and the maximum delay. The render time of
+ * a frame is its rtp timestamp mapped to the local clock by the fastest frame of the last seconds
+ * plus the target delay.
+ */
+class FrameDelayEstimator
+{
+public:
+    FrameDelayEstimator();
+    ~FrameDelayEstimator();
+
+    /**
+     * @brief Sets the range of the target render delay
+     *
+     * @param minDelay The minimum delay in milliseconds
+     * @param maxDelay The maximum delay in milliseconds
+     */
+    void SetDelayRange(uint32_t minDelay, uint32_t maxDelay);
+    void Reset();
+
+    /**
+     * @brief Updates the estimation by the frame completed
+     *
+     * @param timestamp The rtp timestamp of the frame in 90 kHz
+     * @param arrivalTime The arrival time of the last packet of the frame in milliseconds
+     * @param frameSize The size of the frame in bytes
+     */
+    void Update(uint32_t timestamp, uint32_t arrivalTime, uint32_t frameSize);
+
+    /**
+     * @brief Checks a frame is updated since the reset, the render time is known
+     */
+    bool IsReady();
+
+    /**
+     * @brief Gets the jitter of the frame delay in milliseconds
+     */
+    uint32_t GetJitter();
+
+    /**
+     * @brief Gets the target render delay in milliseconds
+     */
+    uint32_t GetTargetDelay();
+
+    /**
+     * @brief Gets the time to render the frame of the rtp timestamp in the clock of the arrival
+     * time, 0 when no frame is updated
+     */
+    uint32_t GetRenderTime(uint32_t timestamp);
+
+private:
+    void UpdateFrameSize(uint32_t frameSize);
+    void UpdateKalman(double frameDelay, double deltaSize);
+    void UpdateNoise(double residual);
+
+    uint32_t mMinDelay;
+    uint32_t mMaxDelay;
+    uint32_t mNumFrames;
+    uint32_t mLastTimestamp;
+    uint32_t mLastArrivalTime;
+    uint32_t mLastFrameSize;
+    // the rtp timestamp of the last frame unwrapped in 90 kHz
+    int64_t mUnwrappedTimestamp;
+    // the negative of the transit times to find the minimum by the maximum of the window
+    SlidingWindowStatistics mTransitTimes;
+    // the milliseconds per byte and the queuing delay
+    double mTheta[2];
+    double mThetaCov[2][2];
+    double mAvgNoise;
+    double mVarNoise;
+    double mAvgFrameSize;
+    double mVarFrameSize;
+    double mMaxFrameSize;
+    double mTargetDelay;
+};
+
+#endif
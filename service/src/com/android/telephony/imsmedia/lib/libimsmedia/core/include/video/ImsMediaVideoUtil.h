@@ -82,14 +82,6 @@ enum kRtcpFeedbackType
     kPsfbVbcm = 17,  // Video Back Channel Message
 };
 
-enum kNackRequestType
-{
-    kRequestSendNackNone = 0,
-    kRequestInitialNack,
-    kRequestSecondNack,
-    kRequestPli,
-};
-
 struct NackParams
 {
 public:
@@ -100,13 +92,6 @@ public:
             bNackReport(false)
     {
     }
-    NackParams(const NackParams& p)
-    {
-        PID = p.PID;
-        BLP = p.BLP;
-        nSecNackCnt = p.nSecNackCnt;
-        bNackReport = p.bNackReport;
-    }
     NackParams(uint16_t f, uint16_t b, uint16_t cnt, bool r) :
             PID(f),
             BLP(b),
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef LOST_PACKET_TRACKER_H
+#define LOST_PACKET_TRACKER_H
+
+#include <ImsMediaVideoUtil.h>
+#include <stdint.h>
+#include <vector>
+
+/**
+ * @brief Tracks the lost rtp packets to request the retransmission by the generic NACK.
+ *
+ * The lost sequence numbers are kept in a bitmap of a sliding window ending at the newest sequence
+ * number received, the time and the number of the requests of each lost packet are kept in the flat
+ * arrays indexed by the sequence number modulo the window size. The packets skipped more than
+ * kMaxLossGap at once are not tracked, it is regarded as the restart of the stream.
+ */
+class LostPacketTracker
+{
+public:
+    enum
+    {
+        // the range of the sequence numbers tracked, a power of 2
+        kWindowSize = 1024,
+        // the largest gap of the sequence numbers regarded as the packet loss
+        kMaxLossGap = 256,
+        // the number of the retransmission requests of a lost packet before the picture loss
+        kMaxNackCount = 2,
+    };
+
+    LostPacketTracker();
+    ~LostPacketTracker();
+
+    /**
+     * @brief Clears the lost packets and the sequence number received
+     */
+    void Reset();
+
+    /**
+     * @brief Updates the lost packets by the packet received. The sequence numbers skipped after
+     * the newest one received are marked lost and the packet received is not lost any more.
+     *
+     * @param seq The rtp sequence number of the packet received
+     * @param time The time of the reception in milliseconds unit
+     * @return The number of the packets newly found lost
+     */
+    uint32_t OnPacketReceived(uint16_t seq, uint32_t time);
+
+    /**
+     * @brief Stops tracking the lost packets older than the sequence number, the frames of them
+     * are played or discarded already.
+     */
+    void RemoveOlderThan(uint16_t seq);
+
+    /**
+     * @brief Checks the packet of the sequence number is lost and not received yet
+     */
+    bool IsLost(uint16_t seq);
+
+    /**
+     * @brief Checks the lost packet of the sequence number is requested to retransmit, the packet
+     * received is the retransmission when it is called before OnPacketReceived()
+     */
+    bool IsRequested(uint16_t seq);
+
+    /**
+     * @brief Gets the number of the lost packets tracked
+     */
+    uint32_t GetNumLost() { return mNumLost; }
+
+    /**
+     * @brief Collects the lost packets to request the retransmission at the time. A lost packet
+     * is requested first after the wait time for the reordered packet, and again in every retry
+     * interval up to kMaxNackCount times. The picture loss is reported when the packet is not
+     * received in the retry interval after the last request.
+     *
+     * @param time The current time in milliseconds unit
+     * @param waitTime The time to wait for the reordered packet before the first request
+     * @param retryInterval The time to wait for the retransmission before the next request
+     * @param nacks The generic NACK FCIs, PID and BLP, packing the packets to request in the order
+     * of the sequence number
+     * @param pictureLost Set true when a lost packet is not recovered by the retransmission
+     * @return The number of the packets to request
+     */
+    uint32_t GetNackRequests(uint32_t time, uint32_t waitTime, uint32_t retryInterval,
+            std::vector<NackParams>* nacks, bool* pictureLost);
+
+private:
+    uint32_t GetIndex(uint16_t seq) { return seq & (kWindowSize - 1); }
+    bool TestBit(uint16_t seq);
+    void SetBit(uint16_t seq);
+    void ClearBit(uint16_t seq);
+    void ClearRange(uint16_t from, uint16_t to);
+
+    bool mStarted;
+    // the oldest sequence number possibly lost
+    uint16_t mFirstSeq;
+    // the newest sequence number received
+    uint16_t mLastSeq;
+    uint32_t mNumLost;
+    uint64_t mLostBits[kWindowSize / 64];
+    // the time of the loss found or the last request of each lost packet
+    uint32_t mLostTime[kWindowSize];
+    uint8_t mNackCount[kWindowSize];
+};
+
+#endif
@@ -21,8 +21,13 @@
 #include <BaseJitterBuffer.h>
 #include <ImsMediaVideoUtil.h>
 #include <ImsMediaTimer.h>
+#include <BandwidthEstimator.h>
+#include <FrameDelayEstimator.h>
+#include <JitterRingQueue.h>
+#include <LostPacketTracker.h>
 #include <mutex>
-#include <list>
+#include <unordered_map>
+#include <vector>
 
 class VideoJitterBuffer : public BaseJitterBuffer
 {
@@ -69,6 +74,13 @@ public:
      */
     void SetResponseWaitTime(const uint32_t time);
 
+    /**
+     * @brief Set the round trip time to pace the bitrate adaptation
+     *
+     * @param rtt The round trip time in milliseconds unit
+     */
+    void SetRoundTripTime(const uint32_t rtt);
+
     /**
      * @brief Start the packet loss monitoring timer to check the packet loss rate
      *
@@ -82,23 +94,54 @@ public:
      */
     void StopTimer();
 
+    /**
+     * @brief Gets the time to render the frame in the clock of the arrival time of the packets.
+     * The frame is released by Get() a frame interval earlier to be decoded in time.
+     *
+     * @param timestamp The rtp timestamp of the frame
+     * @return The render time in milliseconds, 0 when the packets have no arrival time
+     */
+    uint32_t GetRenderTime(uint32_t timestamp);
+
 private:
+    /**
+     * @brief The assembly state of a frame in the queue. It is updated when a packet of the frame
+     * is added or removed, the completeness of the frame is known without walking the queue.
+     */
+    struct FrameState
+    {
+        // the range of the sequence numbers of the packets received
+        uint16_t firstSeq;
+        uint16_t lastSeq;
+        // the number of the distinct sequence numbers received
+        uint32_t numReceived;
+        // the number of the packets of the frame in the queue
+        uint32_t numPackets;
+        uint16_t headerSeq;
+        uint16_t markerSeq;
+        // the sum of the sizes of the packets and the arrival time of the last one
+        uint32_t size;
+        uint32_t arrivalTime;
+        bool header;
+        bool marker;
+        bool idr;
+        // all the packets from the header to the marker are received
+        bool complete;
+    };
+
     bool CheckHeader(uint8_t* pbBuffer);
-    void CheckValidIDR(DataEntry* pIDREntry);
-    void InitLostPktList();
-    void RemovePacketFromLostList(uint16_t seqNum, bool bRemOldPkt = false);
-    void CheckPacketLoss(uint16_t seqNum, uint16_t nLastRecvPkt);
-    bool UpdateLostPacketList(uint16_t mLossRateThreshold, uint16_t* countSecondNack,
-            uint16_t* nPLIPkt, bool* bPLIPkt);
-    bool UpdateNackStatus(LostPacket* pTempEntry, uint16_t mLossRateThreshold,
-            uint16_t* countSecondNack, uint16_t* nPLIPkt, bool* bPLIPkt);
-    void RequestSendNack(
-            uint16_t nLossGap, uint16_t PID, uint16_t countSecondNack, bool bNACK = true);
+    void CheckValidIDR(uint32_t timestamp);
+    void AddToFrame(DataEntry* entry, bool newSeq);
+    void DeleteFirst();
+    bool IsValid(DataEntry* entry);
+    void CheckPacketLoss(uint16_t seqNum, uint32_t currentTime);
+    void RequestSendNack(const std::vector<NackParams>& nacks);
     void RequestToSendPictureLost(uint32_t eType);
     void RequestToSendTmmbr(uint32_t bitrate);
     static void OnTimer(hTimerHandler hTimer, void* pUserData);
     void ProcessTimer();
-    void CheckBitrateAdaptation(double lossRate);
+    void CheckBitrateAdaptation();
+    void CheckDelayGradient(uint32_t timestamp, uint32_t arrivalTime);
 
 private:
     uint32_t mFramerate;
@@ -107,13 +150,17 @@ private:
     uint32_t mSavedFrameNum;
     uint32_t mMarkedFrameNum;
     uint32_t mLastPlayedTime;
+    uint32_t mSavedIdrFrameNum;
+    uint32_t mLastIdrTimestamp;
     uint32_t mNumAddedPacket;
     uint32_t mNumLossPacket;
     uint64_t mAccumulatedPacketSize;
     uint32_t mLastAddedTimestamp;
     uint32_t mLastAddedSeqNum;
     uint32_t mResponseWaitTime;
-    std::list<LostPacket*> mLostPktList;
+    uint32_t mRoundTripTime;
+    LostPacketTracker mLostPackets;
+    std::vector<NackParams> mNacks;
     uint32_t mIDRCheckCnt;
     uint32_t mFirTimeStamp;
     uint32_t mMaxBitrate;
@@ -122,6 +169,15 @@ private:
     uint32_t mLossDuration;
     uint32_t mLossRateThreshold;
     uint32_t mCountTimerExpired;
+    BandwidthEstimator mBandwidthEstimator;
+    int64_t mUnwrappedTimestamp;
+    uint32_t mLastEstimatedTimestamp;
+    // the jitter of the frames completed and the render delay
+    FrameDelayEstimator mFrameDelay;
+    // the packets ordered by the sequence number
+    JitterRingQueue mRingQueue;
+    // the assembly state of the frames in the queue keyed by the rtp timestamp
+    std::unordered_map<uint32_t, FrameState> mFrames;
     hTimerHandler mTimer;
     std::mutex mMutexTimer;
 };
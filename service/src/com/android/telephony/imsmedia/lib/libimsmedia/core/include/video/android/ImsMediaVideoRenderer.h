@@ -25,12 +25,13 @@
 #include <media/NdkMediaFormat.h>
 #include <mutex>
 #include <list>
+#include <utility>
 
 struct FrameData
 {
 public:
     FrameData(uint8_t* data = nullptr, uint32_t size = 0, uint32_t timestamp = 0,
-            bool isConfig = false)
+            bool isConfig = false, uint32_t renderTime = 0)
     {
         this->data = nullptr;
 
@@ -43,6 +44,7 @@ public:
         this->size = size;
         this->timestamp = timestamp;
         this->isConfig = isConfig;
+        this->renderTime = renderTime;
     }
 
     ~FrameData()
@@ -57,6 +59,8 @@ public:
     uint32_t size;
     uint32_t timestamp;
     bool isConfig;
+    // the time to render the frame decoded in milliseconds, 0 to render at once
+    uint32_t renderTime;
 };
 
 /**
@@ -74,19 +78,42 @@ public:
     void SetSurface(ANativeWindow* window);
     bool Start();
     void Stop();
-    void OnDataFrame(uint8_t* data, uint32_t size, uint32_t timestamp, bool isConfigFrame);
+
+    /**
+     * @brief Queues the frame to decode
+     *
+     * @param data The frame data
+     * @param size The size of the frame
+     * @param timestamp The timestamp of the frame
+     * @param isConfigFrame The frame is the codec configuration
+     * @param renderTime The time to render the frame decoded in ImsMediaTimer milliseconds, 0 to
+     * render it as soon as it is decoded
+     */
+    void OnDataFrame(uint8_t* data, uint32_t size, uint32_t timestamp, bool isConfigFrame,
+            uint32_t renderTime = 0);
+
+    /**
+     * @brief The thread of the decoder. The output is held until its render time, the thread
+     * waits for the render time or the next frame.
+     */
     void processBuffers();
     void UpdateDeviceOrientation(uint32_t degree);
     void UpdatePeerOrientation(uint32_t degree);
 
 private:
+    bool QueueInputBuffer();
+    int32_t DequeueOutputBuffer(uint32_t* renderTime);
+
     BaseSessionCallback* mCallback;
     ANativeWindow* mWindow;
     AMediaCodec* mCodec;
     AMediaFormat* mFormat;
     std::list<FrameData*> mFrameDatas;
+    // the presentation time of the frames queued to the decoder and their render time
+    std::list<std::pair<int64_t, uint32_t>> mRenderTimes;
     std::mutex mMutex;
     ImsMediaCondition mConditionExit;
+    ImsMediaCondition mConditionFrame;
     int32_t mCodecType;
     uint32_t mWidth;
     uint32_t mHeight;
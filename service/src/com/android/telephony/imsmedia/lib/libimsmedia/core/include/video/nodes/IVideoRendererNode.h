@@ -66,9 +66,10 @@ public:
     /**
      * @brief Update network round trip time delay to the VideoJitterBuffer
      *
-     * @param delay time delay in ntp timestamp unit
+     * @param delay smoothed time delay in ntp timestamp unit
+     * @param variation variation of the time delay in ntp timestamp unit
      */
-    void UpdateRoundTripTimeDelay(int32_t delay);
+    void UpdateRoundTripTimeDelay(int32_t delay, int32_t variation);
 
     /**
      * @brief Set the packet loss monitoring duration and packet loss rate threshold
@@ -0,0 +1,51 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIDEO_FEC_DECODER_NODE_H_INCLUDED
+#define VIDEO_FEC_DECODER_NODE_H_INCLUDED
+
+#include <ImsMediaDefine.h>
+#include <BaseNode.h>
+#include <FecPacketRecovery.h>
+
+/**
+ * @brief The node takes out the XOR parity packets of RFC 5109 from the video rtp packets received
+ * when the fec payload type is negotiated, and passes the media packets recovered with them to
+ * the rtp decoder before the jitter buffer. The fec packets are the separate stream of the own ssrc
+ * as VideoFecEncoderNode sends them, it protects the media stream received in the session.
+ */
+class VideoFecDecoderNode : public BaseNode
+{
+public:
+    VideoFecDecoderNode(BaseSessionCallback* callback = nullptr);
+    virtual ~VideoFecDecoderNode();
+    virtual kBaseNodeId GetNodeId();
+    virtual ImsMediaResult Start();
+    virtual void Stop();
+    virtual bool IsRunTime();
+    virtual bool IsSourceNode();
+    virtual void SetConfig(void* config);
+    virtual bool IsSameConfig(void* config);
+    virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
+            uint32_t nTimeStamp, bool bMark, uint32_t nSeqNum,
+            ImsMediaSubType nDataType = MEDIASUBTYPE_UNDEFINED, uint32_t arrivalTime = 0);
+
+private:
+    FecPacketRecovery mRecovery;
+    int32_t mFecPayloadType;
+};
+
+#endif  // VIDEO_FEC_DECODER_NODE_H_INCLUDED
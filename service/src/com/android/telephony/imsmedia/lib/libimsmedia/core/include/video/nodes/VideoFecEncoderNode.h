@@ -0,0 +1,66 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VIDEO_FEC_ENCODER_NODE_H_INCLUDED
+#define VIDEO_FEC_ENCODER_NODE_H_INCLUDED
+
+#include <ImsMediaDefine.h>
+#include <BaseNode.h>
+#include <FecPacketGenerator.h>
+#include <mutex>
+
+/**
+ * @brief The node sends the XOR parity packets of RFC 5109 after the video rtp packets of each
+ * frame when the fec payload type is negotiated. The fec packets are sent on the same port as a
+ * separate stream with the own ssrc and sequence numbers, the receiver not supporting the fec
+ * ignores them as the unknown payload type without breaking the sequence of the media stream. The
+ * fec rate follows the loss fraction reported by the peer.
+ */
+class VideoFecEncoderNode : public BaseNode
+{
+public:
+    VideoFecEncoderNode(BaseSessionCallback* callback = nullptr);
+    virtual ~VideoFecEncoderNode();
+    virtual kBaseNodeId GetNodeId();
+    virtual ImsMediaResult Start();
+    virtual void Stop();
+    virtual bool IsRunTime();
+    virtual bool IsSourceNode();
+    virtual void SetConfig(void* config);
+    virtual bool IsSameConfig(void* config);
+    virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData, uint32_t nDataSize,
+            uint32_t nTimeStamp, bool bMark, uint32_t nSeqNum,
+            ImsMediaSubType nDataType = MEDIASUBTYPE_UNDEFINED, uint32_t arrivalTime = 0);
+
+    /**
+     * @brief Updates the fec rate with the fraction of the packets lost reported in the RTCP
+     * receiver report
+     *
+     * @param fractionLost The fraction lost of the report block in the unit of 1/256
+     */
+    void UpdateLossFraction(uint32_t fractionLost);
+
+private:
+    void SendFecPackets(const uint8_t* mediaPacket);
+
+    std::mutex mMutex;
+    FecPacketGenerator mGenerator;
+    int32_t mFecPayloadType;
+    uint16_t mFecSeqNum;
+    uint32_t mFecSsrc;
+};
+
+#endif  // VIDEO_FEC_ENCODER_NODE_H_INCLUDED
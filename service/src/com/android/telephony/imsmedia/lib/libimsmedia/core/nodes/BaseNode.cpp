@@ -36,6 +36,8 @@ static std::vector<NODE_ID_PAIR> vectorNodeId{
         std::make_pair(kNodeIdVideoRenderer, "VideoRenderer"),
         std::make_pair(kNodeIdVideoPayloadEncoder, "VideoPayloadEncoder"),
         std::make_pair(kNodeIdVideoPayloadDecoder, "VideoPayloadDecoder"),
+        std::make_pair(kNodeIdVideoFecEncoder, "VideoFecEncoder"),
+        std::make_pair(kNodeIdVideoFecDecoder, "VideoFecDecoder"),
         std::make_pair(kNodeIdTextSource, "TextSource"),
         std::make_pair(kNodeIdTextRenderer, "TextRenderer"),
         std::make_pair(kNodeIdTextPayloadEncoder, "TextPayloadEncoder"),
@@ -65,6 +65,34 @@ void JitterBufferControlNode::SetJitterOptions(
     }
 }
 
+void JitterBufferControlNode::SetPlayoutDelayOptions(
+        double percentile, double attackRate, double decayRate)
+{
+    if (mJitterBuffer && mMediaType == IMS_MEDIA_AUDIO)
+    {
+        static_cast<AudioJitterBuffer*>(mJitterBuffer)
+                ->SetPlayoutDelayOptions(percentile, attackRate, decayRate);
+    }
+}
+
+int32_t JitterBufferControlNode::GetJitterBufferDepthError()
+{
+    if (mJitterBuffer && mMediaType == IMS_MEDIA_AUDIO)
+    {
+        return static_cast<AudioJitterBuffer*>(mJitterBuffer)->GetDepthError();
+    }
+
+    return 0;
+}
+
+void JitterBufferControlNode::SetEvsRedundantFrameOffset(int32_t offset)
+{
+    if (mJitterBuffer && mMediaType == IMS_MEDIA_AUDIO)
+    {
+        static_cast<AudioJitterBuffer*>(mJitterBuffer)->SetEvsRedundantFrameOffset(offset);
+    }
+}
+
 void JitterBufferControlNode::Reset()
 {
     if (mJitterBuffer)
@@ -17,6 +17,11 @@
 #include <RtcpDecoderNode.h>
 #include <ImsMediaTrace.h>
 #include <ImsMediaVideoUtil.h>
+#include <ImsMediaTimer.h>
+#include <VideoConfig.h>
+
+#define MIN_ADAPTIVE_BITRATE  64000  // bps
+#define BITRATE_CHANGE_RATIO  0.05
 
 #ifdef DEBUG_BITRATE_CHANGE_SIMULATION
 static int32_t gTestBitrate = 384000;
@@ -28,6 +33,7 @@ RtcpDecoderNode::RtcpDecoderNode(BaseSessionCallback* callback) :
     mRtpSession = nullptr;
     mInactivityTime = 0;
     mNoRtcpTime = 0;
+    mNotifiedBitrate = 0;
 }
 
 RtcpDecoderNode::~RtcpDecoderNode()
@@ -114,6 +120,15 @@ void RtcpDecoderNode::SetConfig(void* config)
     RtpConfig* pConfig = reinterpret_cast<RtpConfig*>(config);
     mPeerAddress = RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemotePort());
     IMLOGD2("[SetConfig] peer Ip[%s], port[%d]", mPeerAddress.ipAddress, mPeerAddress.port);
+
+    if (mMediaType == IMS_MEDIA_VIDEO)
+    {
+        // the configured bitrate in kbps is the upper limit of the estimation
+        VideoConfig* videoConfig = reinterpret_cast<VideoConfig*>(config);
+        mNotifiedBitrate = videoConfig->getBitrate() * 1000;
+        mBandwidthEstimator.SetBitrateRange(
+                MIN_ADAPTIVE_BITRATE, mNotifiedBitrate, mNotifiedBitrate);
+    }
 }
 
 bool RtcpDecoderNode::IsSameConfig(void* config)
@@ -148,14 +163,29 @@ void RtcpDecoderNode::OnRtcpInd(tRtpSvc_IndicationFromStack type, void* data)
             if (mMediaType == IMS_MEDIA_AUDIO)
             {
                 mCallback->SendEvent(kCollectPacketInfo, kStreamRtcp);
+
+                // the uplink loss reported by the peer drives the frame aggregation
+                if (payload->stRecvRpt.ssrc != 0)
+                {
+                    SessionCallbackParameter* param = new SessionCallbackParameter(
+                            kReportFractionLost, 0, payload->stRecvRpt.fractionLost);
+                    mCallback->SendEvent(
+                            kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+                }
             }
-#ifdef DEBUG_BITRATE_CHANGE_SIMULATION
             else if (mMediaType == IMS_MEDIA_VIDEO)
             {
+                // the fec rate follows the loss reported by the peer in the report block
+                if (payload->stRecvRpt.ssrc != 0)
+                {
+                    mCallback->SendEvent(
+                            kRequestVideoLossFractionUpdate, payload->stRecvRpt.fractionLost);
+                }
+#ifdef DEBUG_BITRATE_CHANGE_SIMULATION
                 gTestBitrate *= 0.8;
                 mCallback->SendEvent(kRequestVideoBitrateChange, gTestBitrate);
-            }
 #endif
+            }
         }
         break;
         case RTPSVC_RECEIVE_RTCP_RR_IND:
@@ -167,14 +197,29 @@ void RtcpDecoderNode::OnRtcpInd(tRtpSvc_IndicationFromStack type, void* data)
             if (mMediaType == IMS_MEDIA_AUDIO)
             {
                 mCallback->SendEvent(kCollectPacketInfo, kStreamRtcp);
+
+                // the uplink loss reported by the peer drives the frame aggregation
+                if (payload->stRecvRpt.ssrc != 0)
+                {
+                    SessionCallbackParameter* param = new SessionCallbackParameter(
+                            kReportFractionLost, 0, payload->stRecvRpt.fractionLost);
+                    mCallback->SendEvent(
+                            kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+                }
             }
-#ifdef DEBUG_BITRATE_CHANGE_SIMULATION
             else if (mMediaType == IMS_MEDIA_VIDEO)
             {
+                // the fec rate follows the loss reported by the peer in the report block
+                if (payload->stRecvRpt.ssrc != 0)
+                {
+                    mCallback->SendEvent(
+                            kRequestVideoLossFractionUpdate, payload->stRecvRpt.fractionLost);
+                }
+#ifdef DEBUG_BITRATE_CHANGE_SIMULATION
                 gTestBitrate *= 0.8;
                 mCallback->SendEvent(kRequestVideoBitrateChange, gTestBitrate);
-            }
 #endif
+            }
         }
         break;
         case RTPSVC_RECEIVE_RTCP_FB_IND:
@@ -196,7 +241,7 @@ void RtcpDecoderNode::OnRtcpInd(tRtpSvc_IndicationFromStack type, void* data)
             switch (feedbackType)
             {
                 case kRtpFbNack:
-                    /** do nothing */
+                    ReceiveNack(payload);
                     break;
                 case kRtpFbTmmbr:
                     ReceiveTmmbr(payload);
@@ -246,9 +291,78 @@ void RtcpDecoderNode::OnNumReceivedPacket(uint32_t nNumRtcpSRPacket, uint32_t nN
 
 void RtcpDecoderNode::OnEvent(uint32_t event, uint32_t param)
 {
+    if (event == kRequestRoundTripTimeDelayUpdate && mRtpSession != nullptr)
+    {
+        // the variation of the smoothed round trip time follows in the unit of 1/65536 seconds
+        uint64_t variation = mRtpSession->GetRttEstimator()->GetRttVariation();
+        mCallback->SendEvent(event, param, (variation << 16) / 1000);
+        return;
+    }
+
     mCallback->SendEvent(event, param);
 }
 
+void RtcpDecoderNode::OnTransportFeedback(const TransportFeedbackResult& feedback)
+{
+    uint32_t numReceived = 0;
+    uint32_t numReported = 0;
+    uint32_t numLostReported = 0;
+
+    for (const auto& packet : feedback.packets)
+    {
+        if (packet.received)
+        {
+            numReceived++;
+        }
+
+        // the packet sent before the send history kept is not used for the estimation
+        if (packet.sendTimeMs < 0)
+        {
+            continue;
+        }
+
+        numReported++;
+
+        if (packet.received)
+        {
+            mBandwidthEstimator.OnPacketArrival(packet.sendTimeMs * 1000, packet.arrivalTimeUs);
+        }
+        else
+        {
+            numLostReported++;
+        }
+    }
+
+    IMLOGD_PACKET3(IM_PACKET_LOG_RTCP, "[OnTransportFeedback] fbCount[%d], packets[%d], lost[%d]",
+            feedback.feedbackCount, feedback.packets.size(), feedback.packets.size() - numReceived);
+
+    if (mMediaType != IMS_MEDIA_VIDEO || numReported == 0 || mCallback == nullptr)
+    {
+        return;
+    }
+
+    mBandwidthEstimator.OnPacketLoss(numLostReported, numReported);
+
+    if (mRtpSession != nullptr)
+    {
+        mBandwidthEstimator.SetRoundTripTime(mRtpSession->GetRttEstimator()->GetSmoothedRtt());
+    }
+
+    // the size of the packets is not reported, the decrease is based on the current target
+    uint32_t bitrate = mBandwidthEstimator.Update(ImsMediaTimer::GetTimeInMilliSeconds(), 0);
+    uint32_t difference =
+            bitrate > mNotifiedBitrate ? bitrate - mNotifiedBitrate : mNotifiedBitrate - bitrate;
+
+    // not to reconfigure the encoder for the small change
+    if (difference >= mNotifiedBitrate * BITRATE_CHANGE_RATIO)
+    {
+        IMLOGD3("[OnTransportFeedback] usage[%d], bitrate[%u] -> [%u]",
+                mBandwidthEstimator.GetUsage(), mNotifiedBitrate, bitrate);
+        mNotifiedBitrate = bitrate;
+        mCallback->SendEvent(kRequestVideoBitrateChange, bitrate);
+    }
+}
+
 void RtcpDecoderNode::SetLocalAddress(const RtpAddress& address)
 {
     mLocalAddress = address;
@@ -273,8 +387,18 @@ void RtcpDecoderNode::ReceiveTmmbr(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* pa
         return;
     }
 
+    // pMsg points to the FCI in the received packet, after the sender and media source SSRC
+    const uint32_t kFciOffset = 8;
+    const uint32_t kTmmbrFciSize = 8;
+
+    if (payload->wMsgLen < kFciOffset + kTmmbrFciSize)
+    {
+        IMLOGE1("[ReceiveTmmbr] invalid length[%d]", payload->wMsgLen);
+        return;
+    }
+
     // Read bitrate from TMMBR
-    mBitReader.SetBuffer(payload->pMsg, 64);
+    mBitReader.SetBuffer(payload->pMsg, payload->wMsgLen - kFciOffset);
     /** read 16 bit and combine it */
     uint32_t receivedSsrc = mBitReader.Read(16);
     receivedSsrc = (receivedSsrc << 16) | mBitReader.Read(16);
@@ -286,7 +410,9 @@ void RtcpDecoderNode::ReceiveTmmbr(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* pa
     IMLOGD3("[ReceiveTmmbr] received TMMBR, exp[%d], mantissa[%d], bitrate[%d]", receivedExp,
             receivedMantissa, bitrate);
 
-    // Set the bitrate to encoder
+    // Set the bitrate to encoder, the estimation does not exceed the bitrate requested
+    mBandwidthEstimator.SetBitrateRange(MIN_ADAPTIVE_BITRATE, bitrate, bitrate);
+    mNotifiedBitrate = bitrate;
     mCallback->SendEvent(kRequestVideoBitrateChange, bitrate);
 
     // Send TMMBN to peer
@@ -299,6 +425,36 @@ void RtcpDecoderNode::ReceiveTmmbr(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* pa
     mCallback->SendEvent(kRequestVideoSendTmmbn, reinterpret_cast<uint64_t>(pParam));
 }
 
+void RtcpDecoderNode::ReceiveNack(const tRtpSvcIndSt_ReceiveRtcpFeedbackInd* payload)
+{
+    if (payload == nullptr || payload->pMsg == nullptr || mCallback == nullptr ||
+            mMediaType != IMS_MEDIA_VIDEO)
+    {
+        return;
+    }
+
+    // pMsg points to the FCI in the received packet, after the sender and media source SSRC
+    const uint32_t kFciOffset = 8;
+    const uint32_t kNackFciSize = 4;
+
+    if (payload->wMsgLen < kFciOffset + kNackFciSize)
+    {
+        IMLOGE1("[ReceiveNack] invalid length[%d]", payload->wMsgLen);
+        return;
+    }
+
+    uint32_t numFci = (payload->wMsgLen - kFciOffset) / kNackFciSize;
+
+    for (uint32_t i = 0; i < numFci; i++)
+    {
+        const uint8_t* fci = payload->pMsg + i * kNackFciSize;
+        uint16_t pid = fci[0] << 8 | fci[1];
+        uint16_t blp = fci[2] << 8 | fci[3];
+        IMLOGD_PACKET2(IM_PACKET_LOG_RTCP, "[ReceiveNack] pid[%u], blp[%04x]", pid, blp);
+        mCallback->SendEvent(kRequestVideoRetransmission, pid, blp);
+    }
+}
+
 void RtcpDecoderNode::RequestIdrFrame()
 {
     IMLOGD0("[RequestIdrFrame]");
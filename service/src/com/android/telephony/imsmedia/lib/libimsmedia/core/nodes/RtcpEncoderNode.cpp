@@ -19,6 +19,8 @@
 #include <VideoConfig.h>
 
 #define RTCPFBMNGR_PLI_FIR_REQUEST_MIN_INTERVAL 1000
+// the maximum number of the generic nack fcis in a feedback message
+#define MAX_NACK_FCI_NUM                        64
 
 RtcpEncoderNode::RtcpEncoderNode(BaseSessionCallback* callback) :
         BaseNode(callback)
@@ -28,6 +30,7 @@ RtcpEncoderNode::RtcpEncoderNode(BaseSessionCallback* callback) :
     mRtcpXrPayload = nullptr;
     mEnableRtcpBye = false;
     mRtcpXrBlockTypes = RtcpConfig::FLAG_RTCPXR_NONE;
+    mRtcpReducedSize = false;
     mRtcpXrCounter = 0;
     mTimer = nullptr;
     mLastTimeSentPli = 0;
@@ -72,6 +75,10 @@ ImsMediaResult RtcpEncoderNode::Start()
             mEnableRtcpBye, mRtcpXrBlockTypes, mRtcpFbTypes);
     mRtpSession->SetRtcpEncoderListener(this);
     mRtpSession->SetRtcpInterval(mRtcpInterval);
+    mRtpSession->SetRtcpReducedSize(mRtcpReducedSize);
+    mRtpSession->SetRtcpXrRttBlocks(
+            mRtcpXrBlockTypes & RtcpConfig::FLAG_RTCPXR_RECEIVER_REFERENCE_TIME_REPORT_BLOCK,
+            mRtcpXrBlockTypes & RtcpConfig::FLAG_RTCPXR_DLRR_REPORT_BLOCK);
 
     if (mRtcpInterval > 0)
     {
@@ -125,10 +132,12 @@ void RtcpEncoderNode::SetConfig(void* config)
     mPeerAddress = RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemotePort());
     mRtcpInterval = pConfig->getRtcpConfig().getIntervalSec();
     mRtcpXrBlockTypes = pConfig->getRtcpConfig().getRtcpXrBlockTypes();
+    mRtcpReducedSize = pConfig->getRtcpConfig().getRtcpReducedSizeEnabled();
     mEnableRtcpBye = false;
 
-    IMLOGD4("[SetConfig] peer Ip[%s], port[%d], interval[%d], rtcpxr[%d]", mPeerAddress.ipAddress,
-            mPeerAddress.port, mRtcpInterval, mRtcpXrBlockTypes);
+    IMLOGD5("[SetConfig] peer Ip[%s], port[%d], interval[%d], rtcpxr[%d], reducedSize[%d]",
+            mPeerAddress.ipAddress, mPeerAddress.port, mRtcpInterval, mRtcpXrBlockTypes,
+            mRtcpReducedSize);
 
     if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -155,13 +164,15 @@ bool RtcpEncoderNode::IsSameConfig(void* config)
         return (mPeerAddress == peerAddress &&
                 mRtcpInterval == videoConfig->getRtcpConfig().getIntervalSec() &&
                 mRtcpXrBlockTypes == videoConfig->getRtcpConfig().getRtcpXrBlockTypes() &&
+                mRtcpReducedSize == videoConfig->getRtcpConfig().getRtcpReducedSizeEnabled() &&
                 mRtcpFbTypes == videoConfig->getRtcpFbType());
     }
     else
     {
         return (mPeerAddress == peerAddress &&
                 mRtcpInterval == pConfig->getRtcpConfig().getIntervalSec() &&
-                mRtcpXrBlockTypes == pConfig->getRtcpConfig().getRtcpXrBlockTypes());
+                mRtcpXrBlockTypes == pConfig->getRtcpConfig().getRtcpXrBlockTypes() &&
+                mRtcpReducedSize == pConfig->getRtcpConfig().getRtcpReducedSizeEnabled());
     }
 }
 
@@ -241,17 +252,17 @@ void RtcpEncoderNode::SetPeerAddress(const RtpAddress& address)
     mPeerAddress = address;
 }
 
-bool RtcpEncoderNode::SendNack(NackParams* param)
+bool RtcpEncoderNode::SendNack(NackParams* param, uint32_t count)
 {
-    if (param == nullptr)
+    if (param == nullptr || count == 0)
     {
         return false;
     }
 
     if (mRtcpFbTypes & VideoConfig::RTP_FB_NACK)
     {
-        IMLOGD3("[SendNack] PID[%d], BLP[%d], nSecNackCnt[%d]", param->PID, param->BLP,
-                param->nSecNackCnt);
+        IMLOGD4("[SendNack] PID[%d], BLP[%d], nSecNackCnt[%d], count[%u]", param->PID, param->BLP,
+                param->nSecNackCnt, count);
 
         /* Generic NACK format
             0                   1                   2                   3
@@ -260,19 +271,37 @@ bool RtcpEncoderNode::SendNack(NackParams* param)
            |            PID                |             BLP               |
            +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+*/
 
-        // create a Nack payload
-        uint8_t pNackBuff[4];
-        mBitWriter.SetBuffer(pNackBuff, 32);
-        mBitWriter.Write(param->PID, 16);  // PID
-        mBitWriter.Write(param->BLP, 16);  // BLP
+        if (mRtpSession == nullptr)
+        {
+            return false;
+        }
 
-        if (param->bNackReport)
+        // create the Nack payloads, the fci over the maximum are sent in the next message
+        uint8_t pNackBuff[4 * MAX_NACK_FCI_NUM];
+        uint32_t numFci = 0;
+        bool sent = false;
+        bool result = true;
+        mBitWriter.SetBuffer(pNackBuff, sizeof(pNackBuff));
+
+        for (uint32_t i = 0; i < count; i++)
         {
-            if (mRtpSession != nullptr)
+            if (param[i].bNackReport)
+            {
+                mBitWriter.Write(param[i].PID, 16);  // PID
+                mBitWriter.Write(param[i].BLP, 16);  // BLP
+                numFci++;
+            }
+
+            if (numFci == MAX_NACK_FCI_NUM || (i == count - 1 && numFci > 0))
             {
-                return mRtpSession->SendRtcpFeedback(kRtpFbNack, pNackBuff, 4);
+                result &= mRtpSession->SendRtcpFeedback(kRtpFbNack, pNackBuff, 4 * numFci);
+                sent = true;
+                numFci = 0;
+                mBitWriter.SetBuffer(pNackBuff, sizeof(pNackBuff));
             }
         }
+
+        return sent && result;
     }
 
     return false;
@@ -373,4 +402,23 @@ bool RtcpEncoderNode::SendRtcpXr(uint8_t* data, uint32_t size)
 
     delete data;
     return true;
+}
+
+bool RtcpEncoderNode::SendTransportFeedback(uint8_t* data, uint32_t size)
+{
+    if (data == nullptr)
+    {
+        return false;
+    }
+
+    bool result = false;
+
+    if (mRtpSession != nullptr && mRtcpFbTypes & VideoConfig::RTP_FB_TRANSPORT_CC)
+    {
+        IMLOGD_PACKET1(IM_PACKET_LOG_RTCP, "[SendTransportFeedback] size[%d]", size);
+        result = mRtpSession->SendRtcpTransportFeedback(data, size);
+    }
+
+    delete[] data;
+    return result;
 }
\ No newline at end of file
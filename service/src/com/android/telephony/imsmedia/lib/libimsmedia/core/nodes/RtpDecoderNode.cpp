@@ -21,6 +21,9 @@
 #include <VideoConfig.h>
 #include <TextConfig.h>
 
+// the interval to send the transport feedback in milliseconds
+#define TRANSPORT_FEEDBACK_INTERVAL 100
+
 #if defined(DEBUG_JITTER_GEN_SIMULATION_DELAY) || defined(DEBUG_JITTER_GEN_SIMULATION_REORDER) || \
         defined(DEBUG_JITTER_GEN_SIMULATION_LOSS)
 #include <ImsMediaTimer.h>
@@ -54,6 +57,9 @@ RtpDecoderNode::RtpDecoderNode(BaseSessionCallback* callback) :
     mRtpRxDtmfPayload = 0;
     mDtmfSamplingRate = 0;
     mCvoValue = CVO_DEFINE_NONE;
+    mTransportSeqValue = 0;
+    mTransportCcEnabled = false;
+    mLastTransportFeedbackTime = 0;
     mRedundantPayload = 0;
     mArrivalTime = 0;
     mSubtype = MEDIASUBTYPE_UNDEFINED;
@@ -110,7 +116,8 @@ ImsMediaResult RtpDecoderNode::Start()
     if (mMediaType == IMS_MEDIA_AUDIO)
     {
         mRtpSession->SetRtpPayloadParam(mRtpPayloadTx, mRtpPayloadRx, mSamplingRate * 1000,
-                mRtpTxDtmfPayload, mRtpRxDtmfPayload, mDtmfSamplingRate * 1000);
+                mRtpTxDtmfPayload, mRtpRxDtmfPayload, mDtmfSamplingRate * 1000,
+                mRedundantPayload);
     }
     else if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -134,6 +141,8 @@ ImsMediaResult RtpDecoderNode::Start()
     mReceivingSSRC = 0;
     mNoRtpTime = 0;
     mSubtype = MEDIASUBTYPE_UNDEFINED;
+    mTransportFeedback.Reset();
+    mLastTransportFeedbackTime = 0;
     mNodeState = kNodeStateRunning;
 #if defined(DEBUG_JITTER_GEN_SIMULATION_LOSS) || defined(DEBUG_JITTER_GEN_SIMULATION_DUPLICATE)
     mPacketCounter = 1;
@@ -319,6 +328,7 @@ void RtpDecoderNode::SetConfig(void* config)
         mRtpTxDtmfPayload = pConfig->getTxDtmfPayloadTypeNumber();
         mRtpRxDtmfPayload = pConfig->getRxDtmfPayloadTypeNumber();
         mDtmfSamplingRate = pConfig->getDtmfsamplingRateKHz();
+        mRedundantPayload = pConfig->getRedPayloadTypeNumber();
     }
     else if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -328,6 +338,19 @@ void RtpDecoderNode::SetConfig(void* config)
         mRtpPayloadTx = pConfig->getTxPayloadTypeNumber();
         mRtpPayloadRx = pConfig->getRxPayloadTypeNumber();
         mCvoValue = pConfig->getCvoValue();
+        mTransportSeqValue = pConfig->getTransportSeqValue();
+        mTransportCcEnabled = pConfig->getRtcpFbType() & VideoConfig::RTP_FB_TRANSPORT_CC;
+        mExtensionRegistry.Clear();
+
+        if (mCvoValue > 0)
+        {
+            mExtensionRegistry.Register(kRtpHeaderExtensionCvo, mCvoValue);
+        }
+
+        if (mTransportSeqValue > 0 && mTransportCcEnabled)
+        {
+            mExtensionRegistry.Register(kRtpHeaderExtensionTransportSeq, mTransportSeqValue);
+        }
     }
     else if (mMediaType == IMS_MEDIA_TEXT)
     {
@@ -359,7 +382,8 @@ bool RtpDecoderNode::IsSameConfig(void* config)
                 mRtpPayloadRx == pConfig->getRxPayloadTypeNumber() &&
                 mRtpTxDtmfPayload == pConfig->getTxDtmfPayloadTypeNumber() &&
                 mRtpRxDtmfPayload == pConfig->getRxDtmfPayloadTypeNumber() &&
-                mDtmfSamplingRate == pConfig->getDtmfsamplingRateKHz());
+                mDtmfSamplingRate == pConfig->getDtmfsamplingRateKHz() &&
+                mRedundantPayload == pConfig->getRedPayloadTypeNumber());
     }
     else if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -369,7 +393,11 @@ bool RtpDecoderNode::IsSameConfig(void* config)
                 mSamplingRate == pConfig->getSamplingRateKHz() &&
                 mRtpPayloadTx == pConfig->getTxPayloadTypeNumber() &&
                 mRtpPayloadRx == pConfig->getRxPayloadTypeNumber() &&
-                mCvoValue == pConfig->getCvoValue());
+                mCvoValue == pConfig->getCvoValue() &&
+                mTransportSeqValue == pConfig->getTransportSeqValue() &&
+                mTransportCcEnabled ==
+                        static_cast<bool>(
+                                pConfig->getRtcpFbType() & VideoConfig::RTP_FB_TRANSPORT_CC));
     }
     else if (mMediaType == IMS_MEDIA_TEXT)
     {
@@ -397,7 +425,8 @@ void RtpDecoderNode::OnMediaDataInd(unsigned char* data, uint32_t datasize, uint
 
     if (mMediaType == IMS_MEDIA_AUDIO && mRtpPayloadRx != payloadType &&
             mRtpPayloadTx != payloadType && payloadType != mRtpRxDtmfPayload &&
-            payloadType != mRtpTxDtmfPayload)
+            payloadType != mRtpTxDtmfPayload &&
+            (mRedundantPayload == 0 || payloadType != mRedundantPayload))
     {
         IMLOGE1("[OnMediaDataInd] media[%d] invalid frame", mMediaType);
         return;
@@ -435,16 +464,20 @@ void RtpDecoderNode::OnMediaDataInd(unsigned char* data, uint32_t datasize, uint
         }
     }
 
-    if (extensionInfo.extensionData != nullptr && extensionInfo.extensionDataSize >= 2 &&
-            mMediaType == IMS_MEDIA_VIDEO && mCvoValue != CVO_DEFINE_NONE)
+    if (extensionInfo.extensionData != nullptr && mMediaType == IMS_MEDIA_VIDEO &&
+            (mCvoValue != CVO_DEFINE_NONE || mTransportCcEnabled))
     {
-        uint16_t extensionId = extensionInfo.extensionData[0] >> 4;
+        RtpHeaderExtensionView views[RtpHeaderExtensionRegistry::kMaxViews];
+        int32_t numViews = RtpHeaderExtensionRegistry::Parse(
+                extensionInfo, views, RtpHeaderExtensionRegistry::kMaxViews);
+        const RtpHeaderExtensionView* cvo =
+                mExtensionRegistry.Find(kRtpHeaderExtensionCvo, views, numViews);
 
-        if (extensionId == mCvoValue)
+        if (cvo != nullptr)
         {
             // 0: Front-facing camera, 1: Back-facing camera
-            uint16_t cameraId = extensionInfo.extensionData[1] >> 3;
-            uint16_t rotation = extensionInfo.extensionData[1] & 0x07;
+            uint16_t cameraId = cvo->data[0] >> 3;
+            uint16_t rotation = cvo->data[0] & 0x07;
 
             switch (rotation)
             {
@@ -469,11 +502,31 @@ void RtpDecoderNode::OnMediaDataInd(unsigned char* data, uint32_t datasize, uint
             }
 
             IMLOGD4("[OnMediaDataInd] extensionId[%d], cameraId[%d], rotation[%d], subtype[%d]",
-                    extensionId, cameraId, rotation, mSubtype);
+                    cvo->id, cameraId, rotation, mSubtype);
+        }
+
+        const RtpHeaderExtensionView* transportSeq =
+                mExtensionRegistry.Find(kRtpHeaderExtensionTransportSeq, views, numViews);
+
+        if (transportSeq != nullptr && transportSeq->size == 2)
+        {
+            mTransportFeedback.OnPacketReceived(
+                    transportSeq->data[0] << 8 | transportSeq->data[1], mArrivalTime);
         }
     }
 
-    if (mMediaType == IMS_MEDIA_TEXT)
+    if (mTransportCcEnabled)
+    {
+        SendTransportFeedback();
+    }
+
+    if (mMediaType == IMS_MEDIA_AUDIO)
+    {
+        mSubtype = (mRedundantPayload != 0 && payloadType == mRedundantPayload)
+                ? MEDIASUBTYPE_AUDIO_RED
+                : MEDIASUBTYPE_UNDEFINED;
+    }
+    else if (mMediaType == IMS_MEDIA_TEXT)
     {
         if (payloadType == mRtpPayloadTx)
         {
@@ -583,65 +636,53 @@ std::list<RtpHeaderExtension>* RtpDecoderNode::DecodeRtpHeaderExtension(
         return nullptr;
     }
 
-    std::list<RtpHeaderExtension>* extensions = new std::list<RtpHeaderExtension>();
+    RtpHeaderExtensionView views[RtpHeaderExtensionRegistry::kMaxViews];
+    int32_t numViews = RtpHeaderExtensionRegistry::Parse(
+            extensionInfo, views, RtpHeaderExtensionRegistry::kMaxViews);
+    IMLOGD2("[DecodeRtpHeaderExtension] profile[%x], count[%d]", extensionInfo.definedByProfile,
+            numViews);
 
-    // header
-    bool useTwoByteHeader =
-            (extensionInfo.definedByProfile == RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader);
-    uint32_t length = extensionInfo.length;  // word size
-    IMLOGD2("[DecodeRtpHeaderExtension] twoByteHeader[%d], len[%d]", useTwoByteHeader, length);
+    if (numViews <= 0)
+    {
+        return nullptr;
+    }
 
-    uint32_t offset = 0;
-    int32_t remainingSize = extensionInfo.extensionDataSize;
+    // the list is delivered to the application, the views are copied only here
+    std::list<RtpHeaderExtension>* extensions = new std::list<RtpHeaderExtension>();
 
-    while (remainingSize > 0)
+    for (int32_t i = 0; i < numViews; i++)
     {
         RtpHeaderExtension extension;
+        extension.setLocalIdentifier(views[i].id);
+        extension.setExtensionData(views[i].data, views[i].size);
+        extensions->push_back(extension);
+    }
 
-        if (useTwoByteHeader)
-        {
-            // header
-            extension.setLocalIdentifier(extensionInfo.extensionData[offset++]);
-            int8_t dataSize = extensionInfo.extensionData[offset++];  // add header
-
-            // payload
-            if (dataSize > 0)
-            {
-                extension.setExtensionData(
-                        reinterpret_cast<const uint8_t*>(extensionInfo.extensionData + offset),
-                        dataSize);
-            }
-
-            offset += dataSize;
-            remainingSize -= (dataSize + 2);  // remove two byte header too
-        }
-        else  // one byte header
-        {
-            // header
-            extension.setLocalIdentifier(extensionInfo.extensionData[offset] >> 4);
-            int8_t dataSize = (extensionInfo.extensionData[offset] & 0x0F) + 1;  // data + header
-            offset++;
+    return extensions;
+}
 
-            // payload
-            if (dataSize > 0)
-            {
-                extension.setExtensionData(
-                        reinterpret_cast<const uint8_t*>(extensionInfo.extensionData + offset),
-                        dataSize);
-            }
+void RtpDecoderNode::SendTransportFeedback()
+{
+    uint32_t numPackets = mTransportFeedback.GetNumPendingPackets();
 
-            offset += dataSize;
-            remainingSize -= (dataSize + 1);  // remove one byte header too
-        }
+    if (numPackets == 0 || mCallback == nullptr ||
+            (mArrivalTime - mLastTransportFeedbackTime < TRANSPORT_FEEDBACK_INTERVAL &&
+                    numPackets < TransportFeedback::kMaxStatusCount))
+    {
+        return;
+    }
 
-        extensions->push_back(extension);
+    // the buffer is deleted by the RtcpEncoderNode after sending
+    uint8_t* data = new uint8_t[TransportFeedback::kMaxFciSize];
+    uint32_t size = mTransportFeedback.Build(data, TransportFeedback::kMaxFciSize);
 
-        while (remainingSize > 0 && extensionInfo.extensionData[offset] == 0x00)  // ignore padding
-        {
-            offset++;
-            remainingSize--;
-        }
+    if (size == 0)
+    {
+        delete[] data;
+        return;
     }
 
-    return extensions;
-}
\ No newline at end of file
+    mLastTransportFeedbackTime = mArrivalTime;
+    mCallback->SendEvent(
+            kRequestVideoSendTransportFeedback, reinterpret_cast<uint64_t>(data), size);
+}
@@ -22,6 +22,10 @@
 #include <VideoConfig.h>
 #include <TextConfig.h>
 #include <string.h>
+#include <algorithm>
+
+// the interval of the retransmissions of a packet until the round trip time is measured
+#define DEFAULT_RETRANSMISSION_INTERVAL 100  // milliseconds
 
 RtpEncoderNode::RtpEncoderNode(BaseSessionCallback* callback) :
         BaseNode(callback)
@@ -30,6 +34,7 @@ RtpEncoderNode::RtpEncoderNode(BaseSessionCallback* callback) :
     mDTMFMode = false;
     mMark = false;
     mPrevTimestamp = 0;
+    mPrevNumOfFrames = 1;
     mSamplingRate = 0;
     mRtpPayloadTx = 0;
     mRtpPayloadRx = 0;
@@ -40,6 +45,8 @@ RtpEncoderNode::RtpEncoderNode(BaseSessionCallback* callback) :
     mCvoValue = CVO_DEFINE_NONE;
     mRedundantLevel = 0;
     mRedundantPayload = 0;
+    mTransportSeqValue = 0;
+    mTransportSeqNum = 0;
 }
 
 RtpEncoderNode::~RtpEncoderNode()
@@ -85,7 +92,8 @@ ImsMediaResult RtpEncoderNode::Start()
     if (mMediaType == IMS_MEDIA_AUDIO)
     {
         mRtpSession->SetRtpPayloadParam(mRtpPayloadTx, mRtpPayloadRx, mSamplingRate * 1000,
-                mRtpTxDtmfPayload, mRtpRxDtmfPayload, mDtmfSamplingRate * 1000);
+                mRtpTxDtmfPayload, mRtpRxDtmfPayload, mDtmfSamplingRate * 1000,
+                mRedundantPayload);
     }
     else if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -105,9 +113,11 @@ ImsMediaResult RtpEncoderNode::Start()
     }
 
     mRtpSession->StartRtp();
+    mPacketHistory.Reset();
     mDTMFMode = false;
     mMark = true;
     mPrevTimestamp = 0;
+    mPrevNumOfFrames = 1;
 #ifdef DEBUG_JITTER_GEN_SIMULATION_DELAY
     mNextTime = 0;
 #endif
@@ -130,6 +140,7 @@ void RtpEncoderNode::Stop()
     }
 
     ClearDataQueue();
+    mListNumOfFrames.clear();
     mNodeState = kNodeStateStopped;
 }
 
@@ -202,6 +213,7 @@ void RtpEncoderNode::SetConfig(void* config)
         mRtpTxDtmfPayload = pConfig->getTxDtmfPayloadTypeNumber();
         mRtpRxDtmfPayload = pConfig->getRxDtmfPayloadTypeNumber();
         mDtmfSamplingRate = pConfig->getDtmfsamplingRateKHz();
+        mRedundantPayload = pConfig->getRedPayloadTypeNumber();
     }
     else if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -210,7 +222,23 @@ void RtpEncoderNode::SetConfig(void* config)
         mSamplingRate = pConfig->getSamplingRateKHz();
         mRtpPayloadTx = pConfig->getTxPayloadTypeNumber();
         mRtpPayloadRx = pConfig->getRxPayloadTypeNumber();
-        mCvoValue = pConfig->getCvoValue();
+
+        if (mCvoValue != pConfig->getCvoValue() ||
+                mTransportSeqValue != pConfig->getTransportSeqValue())
+        {
+            mCvoValue = pConfig->getCvoValue();
+            mTransportSeqValue = pConfig->getTransportSeqValue();
+            mExtensionRegistry.Clear();
+            mTransportSeqRegistry.Clear();
+
+            if (mTransportSeqValue > 0 &&
+                    (!mTransportSeqRegistry.Register(
+                             kRtpHeaderExtensionTransportSeq, mTransportSeqValue) ||
+                            !mTransportSeqRegistry.Compile()))
+            {
+                IMLOGE1("[SetConfig] invalid transport seq id[%d]", mTransportSeqValue);
+            }
+        }
     }
     else if (mMediaType == IMS_MEDIA_TEXT)
     {
@@ -243,7 +271,8 @@ bool RtpEncoderNode::IsSameConfig(void* config)
                 mRtpPayloadRx == pConfig->getRxPayloadTypeNumber() &&
                 mRtpTxDtmfPayload == pConfig->getTxDtmfPayloadTypeNumber() &&
                 mRtpRxDtmfPayload == pConfig->getRxDtmfPayloadTypeNumber() &&
-                mDtmfSamplingRate == pConfig->getDtmfsamplingRateKHz());
+                mDtmfSamplingRate == pConfig->getDtmfsamplingRateKHz() &&
+                mRedundantPayload == pConfig->getRedPayloadTypeNumber());
     }
     else if (mMediaType == IMS_MEDIA_VIDEO)
     {
@@ -253,7 +282,8 @@ bool RtpEncoderNode::IsSameConfig(void* config)
                 mSamplingRate == pConfig->getSamplingRateKHz() &&
                 mRtpPayloadTx == pConfig->getTxPayloadTypeNumber() &&
                 mRtpPayloadRx == pConfig->getRxPayloadTypeNumber() &&
-                mCvoValue == pConfig->getCvoValue());
+                mCvoValue == pConfig->getCvoValue() &&
+                mTransportSeqValue == pConfig->getTransportSeqValue());
     }
     else if (mMediaType == IMS_MEDIA_TEXT)
     {
@@ -272,6 +302,11 @@ bool RtpEncoderNode::IsSameConfig(void* config)
 
 void RtpEncoderNode::OnRtpPacket(unsigned char* data, uint32_t nSize)
 {
+    if (mMediaType == IMS_MEDIA_VIDEO)
+    {
+        mPacketHistory.Add(data, nSize, ImsMediaTimer::GetTimeInMilliSeconds());
+    }
+
     SendDataToRearNode(MEDIASUBTYPE_RTPPACKET, data, nSize, 0, 0, 0);
 }
 
@@ -286,6 +321,12 @@ void RtpEncoderNode::SetPeerAddress(const RtpAddress& address)
 }
 
 bool RtpEncoderNode::SetCvoExtension(const int64_t facing, const int64_t orientation)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return UpdateCvoExtension(facing, orientation);
+}
+
+bool RtpEncoderNode::UpdateCvoExtension(const int64_t facing, const int64_t orientation)
 {
     IMLOGD3("[SetCvoExtension] cvoValue[%d], facing[%ld], orientation[%ld]", mCvoValue, facing,
             orientation);
@@ -329,18 +370,21 @@ bool RtpEncoderNode::SetCvoExtension(const int64_t facing, const int64_t orienta
             }
         }
 
-        int8_t extensionData[4];  // 32bit
         IMLOGD3("[SetCvoExtension] cvoValue[%d], facing[%d], orientation[%d]", mCvoValue, cameraId,
                 rotation);
 
-        extensionData[0] = (mCvoValue << 4) | 1;  // local identifier and data length
-        extensionData[1] = (cameraId << 3) | rotation;
-        extensionData[2] = 0;  // padding
-        extensionData[3] = 0;  // padding
+        // the block is encoded once, only the cvo byte is updated afterwards
+        if (mExtensionRegistry.GetTemplate() == nullptr &&
+                (!mExtensionRegistry.Register(kRtpHeaderExtensionCvo, mCvoValue) ||
+                        (mTransportSeqValue > 0 &&
+                                !mExtensionRegistry.Register(
+                                        kRtpHeaderExtensionTransportSeq, mTransportSeqValue)) ||
+                        !mExtensionRegistry.Compile()))
+        {
+            return false;
+        }
 
-        mListRtpExtension.clear();
-        mListRtpExtension.push_back(RtpHeaderExtensionInfo(
-                RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, 1, extensionData, 4));
+        mExtensionRegistry.SetValue(kRtpHeaderExtensionCvo, (cameraId << 3) | rotation);
         return true;
     }
 
@@ -417,6 +461,54 @@ void RtpEncoderNode::SetRtpHeaderExtension(std::list<RtpHeaderExtension>* listEx
     delete[] extensionData;
 }
 
+void RtpEncoderNode::RetransmitPackets(uint16_t pid, uint16_t blp)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mNodeState != kNodeStateRunning || mMediaType != IMS_MEDIA_VIDEO)
+    {
+        return;
+    }
+
+    // the NACK received within the round trip time after the retransmission was sent by the
+    // peer before the retransmitted packet arrived, it is ignored
+    uint32_t interval = mRtpSession->GetRttEstimator()->GetSmoothedRtt();
+
+    if (interval == 0)
+    {
+        interval = DEFAULT_RETRANSMISSION_INTERVAL;
+    }
+
+    uint32_t currentTime = ImsMediaTimer::GetTimeInMilliSeconds();
+
+    for (int32_t i = -1; i < 16; i++)
+    {
+        if (i >= 0 && (blp & (1 << i)) == 0)
+        {
+            continue;
+        }
+
+        uint16_t seqNum = pid + i + 1;
+        uint32_t size = 0;
+        const uint8_t* packet =
+                mPacketHistory.GetPacketToRetransmit(seqNum, currentTime, interval, &size);
+
+        if (packet != nullptr)
+        {
+            IMLOGD_PACKET2(
+                    IM_PACKET_LOG_RTP, "[RetransmitPackets] seq[%u], size[%u]", seqNum, size);
+            SendDataToRearNode(
+                    MEDIASUBTYPE_RTPPACKET, const_cast<uint8_t*>(packet), size, 0, 0, seqNum);
+        }
+    }
+}
+
+void RtpEncoderNode::SetNumFramesOfNextPayload(uint32_t numFrames)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mListNumOfFrames.push_back(numFrames);
+}
+
 bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, uint32_t size)
 {
     uint32_t currentTimestamp;
@@ -459,8 +551,17 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
             mMark = false;
         }
     }
-    else  // MEDIASUBTYPE_RTPPAYLOAD
+    else  // MEDIASUBTYPE_RTPPAYLOAD or MEDIASUBTYPE_AUDIO_RED
     {
+        // the number is kept as the previous one when the front node does not set it
+        uint32_t numFrames = mPrevNumOfFrames;
+
+        // mMutex is held by ProcessData
+        if (!mListNumOfFrames.empty())
+        {
+            numFrames = std::max(mListNumOfFrames.front(), 1U);
+        }
+
         if (mDTMFMode == false)
         {
             currentTimestamp = ImsMediaTimer::GetTimeInMilliSeconds();
@@ -486,8 +587,21 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
                 {
                     mPrevTimestamp += timeDiff;
                 }
+
+                // the timestamp is of the first frame in the packet, it is kept continuous when
+                // the number of frames per packet is changed
+                int32_t correctedDiff = static_cast<int32_t>(timeDiff) +
+                        (static_cast<int32_t>(mPrevNumOfFrames) - static_cast<int32_t>(numFrames)) *
+                                20;
+
+                if (numFrames != mPrevNumOfFrames && correctedDiff > 0)
+                {
+                    timeDiff = correctedDiff;
+                }
             }
 
+            mPrevNumOfFrames = numFrames;
+
             RtpPacket* packet = new RtpPacket();
             packet->rtpDataType = kRtpDataTypeNormal;
             mCallback->SendEvent(
@@ -497,16 +611,20 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
             IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[ProcessAudioData] size[%u], TS[%u], diff[%d]", size,
                     currentTimestamp, timestampDiff);
 
+            int8_t payloadType =
+                    (subtype == MEDIASUBTYPE_AUDIO_RED && mRedundantPayload > 0) ? mRedundantPayload
+                                                                                 : mRtpPayloadTx;
+
             if (!mListRtpExtension.empty())
             {
-                mRtpSession->SendRtpPacket(mRtpPayloadTx, data, size, currentTimestamp, mMark,
+                mRtpSession->SendRtpPacket(payloadType, data, size, currentTimestamp, mMark,
                         timestampDiff, &mListRtpExtension.front());
                 mListRtpExtension.pop_front();
             }
             else
             {
                 mRtpSession->SendRtpPacket(
-                        mRtpPayloadTx, data, size, currentTimestamp, mMark, timestampDiff);
+                        payloadType, data, size, currentTimestamp, mMark, timestampDiff);
             }
 
             if (mMark)
@@ -514,6 +632,11 @@ bool RtpEncoderNode::ProcessAudioData(ImsMediaSubType subtype, uint8_t* data, ui
                 mMark = false;
             }
         }
+
+        if (!mListNumOfFrames.empty())
+        {
+            mListNumOfFrames.pop_front();
+        }
     }
 
     return true;
@@ -531,19 +654,39 @@ void RtpEncoderNode::ProcessVideoData(
     static int64_t sCount = 0;
     if ((++sCount % 100) == 0)
     {
-        SetCvoExtension(kCameraFacing, (sDeviceOrientation += 90) % 360);
+        // mMutex is held by ProcessData
+        UpdateCvoExtension(kCameraFacing, (sDeviceOrientation += 90) % 360);
     }
 #endif
 
-    if (mCvoValue > 0 && mark && subtype == MEDIASUBTYPE_VIDEO_IDR_FRAME)
+    RtpHeaderExtensionRegistry* registry = nullptr;
+
+    if (mCvoValue > 0 && mark && subtype == MEDIASUBTYPE_VIDEO_IDR_FRAME &&
+            mExtensionRegistry.GetTemplate() != nullptr)
     {
-        mRtpSession->SendRtpPacket(mRtpPayloadTx, data, size, timestamp, mark, 0,
-                mListRtpExtension.empty() ? nullptr : &mListRtpExtension.front());
+        registry = &mExtensionRegistry;
     }
-    else
+    else if (mTransportSeqRegistry.GetTemplate() != nullptr)
+    {
+        registry = &mTransportSeqRegistry;
+    }
+
+    if (registry == nullptr)
     {
         mRtpSession->SendRtpPacket(mRtpPayloadTx, data, size, timestamp, mark, 0);
+        return;
     }
+
+    // the sequence number is consumed only when the extension is written in the packet
+    if (mTransportSeqValue > 0 &&
+            registry->SetValue(kRtpHeaderExtensionTransportSeq, mTransportSeqNum))
+    {
+        mRtpSession->SetTransportSeqSent(mTransportSeqNum, ImsMediaTimer::GetTimeInMilliSeconds());
+        mTransportSeqNum++;
+    }
+
+    mRtpSession->SendRtpPacket(
+            mRtpPayloadTx, data, size, timestamp, mark, 0, registry->GetTemplate());
 }
 
 void RtpEncoderNode::ProcessTextData(
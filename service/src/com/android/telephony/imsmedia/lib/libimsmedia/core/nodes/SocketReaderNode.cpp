@@ -24,6 +24,7 @@ SocketReaderNode::SocketReaderNode(BaseSessionCallback* callback) :
         mLocalFd(0)
 {
     mReceiveTtl = false;
+    mRtcpMuxEnabled = false;
 }
 
 SocketReaderNode::~SocketReaderNode()
@@ -65,7 +66,16 @@ ImsMediaResult SocketReaderNode::Start()
         mReceiveTtl = true;
     }
 
-    mSocket->Listen(this);
+    if (IsRtcpMuxReader())
+    {
+        // the rtp reader of the same socket hands over the rtcp packets
+        mSocket->ListenRtcpMux(this);
+    }
+    else
+    {
+        mSocket->Listen(this);
+    }
+
     mSocketOpened = true;
     mNodeState = kNodeStateRunning;
     return RESULT_SUCCESS;
@@ -78,7 +88,14 @@ void SocketReaderNode::Stop()
 
     if (mSocket != nullptr)
     {
-        mSocket->Listen(nullptr);
+        if (IsRtcpMuxReader())
+        {
+            mSocket->ListenRtcpMux(nullptr);
+        }
+        else
+        {
+            mSocket->Listen(nullptr);
+        }
 
         if (mSocketOpened)
         {
@@ -135,6 +152,7 @@ void SocketReaderNode::SetConfig(void* config)
     }
 
     RtpConfig* pConfig = reinterpret_cast<RtpConfig*>(config);
+    mRtcpMuxEnabled = pConfig->getRtcpConfig().getRtcpMuxEnabled();
 
     if (mProtocolType == kProtocolRtp)
     {
@@ -143,7 +161,7 @@ void SocketReaderNode::SetConfig(void* config)
     else if (mProtocolType == kProtocolRtcp)
     {
         mPeerAddress =
-                RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemotePort() + 1);
+                RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemoteRtcpPort());
     }
 }
 
@@ -163,10 +181,11 @@ bool SocketReaderNode::IsSameConfig(void* config)
     }
     else if (mProtocolType == kProtocolRtcp)
     {
-        peerAddress = RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemotePort() + 1);
+        peerAddress = RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemoteRtcpPort());
     }
 
-    return (mPeerAddress == peerAddress);
+    return (mPeerAddress == peerAddress &&
+            mRtcpMuxEnabled == pConfig->getRtcpConfig().getRtcpMuxEnabled());
 }
 
 void SocketReaderNode::OnReadDataFromSocket()
@@ -189,6 +208,11 @@ void SocketReaderNode::OnReadDataFromSocket()
     }
 }
 
+bool SocketReaderNode::IsRtcpMuxReader()
+{
+    return mProtocolType == kProtocolRtcp && mRtcpMuxEnabled;
+}
+
 void SocketReaderNode::SetLocalFd(int fd)
 {
     mLocalFd = fd;
@@ -111,7 +111,7 @@ void SocketWriterNode::SetConfig(void* config)
     else if (mProtocolType == kProtocolRtcp)
     {
         mPeerAddress =
-                RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemotePort() + 1);
+                RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemoteRtcpPort());
     }
 
     mDscp = pConfig->getDscp();
@@ -133,7 +133,7 @@ bool SocketWriterNode::IsSameConfig(void* config)
     }
     else if (mProtocolType == kProtocolRtcp)
     {
-        peerAddress = RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemotePort() + 1);
+        peerAddress = RtpAddress(pConfig->getRemoteAddress().c_str(), pConfig->getRemoteRtcpPort());
     }
 
     return (mPeerAddress == peerAddress && mDscp == pConfig->getDscp());
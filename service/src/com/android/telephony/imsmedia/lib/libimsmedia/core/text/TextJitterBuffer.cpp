@@ -24,6 +24,11 @@ TextJitterBuffer::TextJitterBuffer() :
 
 TextJitterBuffer::~TextJitterBuffer() {}
 
+uint32_t TextJitterBuffer::GetCount()
+{
+    return mRingQueue.GetCount();
+}
+
 void TextJitterBuffer::Reset()
 {
     mFirstFrameReceived = false;
@@ -59,48 +64,13 @@ void TextJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* buffer, uint32_t si
     currEntry.bValid = true;
     currEntry.arrivalTime = arrivalTime;
 
-    if (mDataQueue.GetCount() == 0)  // jitter buffer is empty
-    {
-        mDataQueue.Add(&currEntry);
-    }
-    else
+    if (mRingQueue.Contains(seqNum))
     {
-        DataEntry* pEntry = nullptr;
-        mDataQueue.GetLast(&pEntry);
-
-        if (pEntry == nullptr)
-        {
-            return;
-        }
-
-        if (USHORT_SEQ_ROUND_COMPARE(pEntry->nSeqNum, seqNum))  // a >= b
-        {
-            uint32_t i = 0;
-            mDataQueue.SetReadPosFirst();
-
-            while (mDataQueue.GetNext(&pEntry))
-            {
-                if (seqNum == pEntry->nSeqNum)
-                {
-                    IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[Add] Redundant seq[%u]", seqNum);
-                    break;
-                }
-                else if (!USHORT_SEQ_ROUND_COMPARE(seqNum, pEntry->nSeqNum))
-                {
-                    IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Add] InsertAt[%u] seq[%u]", i, seqNum);
-                    mDataQueue.InsertAt(i, &currEntry);
-                    break;
-                }
-                i++;
-            }
-        }
-        else  // a < b
-        {
-            IMLOGD_PACKET1(
-                    IM_PACKET_LOG_JITTER, "[Add] current data is the latest seq[%u]", seqNum);
-            mDataQueue.Add(&currEntry);
-        }
+        IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[Add] Redundant seq[%u]", seqNum);
+        return;
     }
+
+    mRingQueue.Insert(&currEntry);
 }
 
 bool TextJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** data, uint32_t* dataSize,
@@ -109,7 +79,7 @@ bool TextJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** data, uint32_t* d
     std::lock_guard<std::mutex> guard(mMutex);
     DataEntry* pEntry;
 
-    if (mDataQueue.Get(&pEntry) == true && pEntry != nullptr)
+    if (mRingQueue.Get(&pEntry) == true && pEntry != nullptr)
     {
         if (subtype)
             *subtype = pEntry->subtype;
@@ -126,7 +96,7 @@ bool TextJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** data, uint32_t* d
 
         IMLOGD_PACKET5(IM_PACKET_LOG_JITTER,
                 "[Get] OK - seq[%u], mark[%u], TS[%u], size[%u], queue[%u]", pEntry->nSeqNum,
-                pEntry->bMark, pEntry->nTimestamp, pEntry->nBufferSize, mDataQueue.GetCount());
+                pEntry->bMark, pEntry->nTimestamp, pEntry->nBufferSize, mRingQueue.GetCount());
 
         return true;
     }
@@ -155,7 +125,7 @@ void TextJitterBuffer::Delete()
 {
     DataEntry* pEntry;
     std::lock_guard<std::mutex> guard(mMutex);
-    mDataQueue.Get(&pEntry);
+    mRingQueue.Get(&pEntry);
 
     if (pEntry == nullptr)
     {
@@ -169,5 +139,5 @@ void TextJitterBuffer::Delete()
 
     mLastPlayedSeqNum = pEntry->nSeqNum;
     mLastPlayedTimestamp = pEntry->nTimestamp;
-    mDataQueue.Delete();
+    mRingQueue.Delete();
 }
\ No newline at end of file
@@ -174,7 +174,8 @@ ImsMediaResult TextSession::startGraph(RtpConfig* config)
     }
     else
     {
-        mGraphRtcp = new TextStreamGraphRtcp(this, mRtcpFd);
+        int rtcpFd = config->getRtcpConfig().getRtcpMuxEnabled() ? mRtpFd : mRtcpFd;
+        mGraphRtcp = new TextStreamGraphRtcp(this, rtcpFd);
         ret = mGraphRtcp->create(config);
 
         if (ret == RESULT_SUCCESS)
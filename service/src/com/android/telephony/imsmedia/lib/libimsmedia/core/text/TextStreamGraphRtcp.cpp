@@ -46,7 +46,8 @@ ImsMediaResult TextStreamGraphRtcp::create(RtpConfig* config)
     char localIp[MAX_IP_LEN];
     uint32_t localPort = 0;
     ImsMediaNetworkUtil::getLocalIpPortFromSocket(mLocalFd, localIp, MAX_IP_LEN, localPort);
-    RtpAddress localAddress(localIp, localPort - 1);
+    uint32_t rtpPort = config->getRtcpConfig().getRtcpMuxEnabled() ? localPort : localPort - 1;
+    RtpAddress localAddress(localIp, rtpPort);
     (static_cast<RtcpEncoderNode*>(pNodeRtcpEncoder))->SetLocalAddress(localAddress);
     pNodeRtcpEncoder->SetConfig(config);
     AddNode(pNodeRtcpEncoder);
@@ -0,0 +1,361 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <BandwidthEstimator.h>
+#include <ImsMediaTrace.h>
+#include <algorithm>
+#include <math.h>
+
+#define DEFAULT_MIN_BITRATE   32000   // bps
+#define DEFAULT_START_BITRATE 384000  // bps
+#define DEFAULT_RTT           200     // msec
+#define BURST_TIME_US         5000    // the packets sent within 5 msec are grouped
+// the trendline filter
+#define TRENDLINE_WINDOW_SIZE 20
+#define SMOOTHING_COEF        0.9
+#define TREND_GAIN            4.0
+#define MAX_NUM_DELTAS        60
+// the overuse detector
+#define INITIAL_THRESHOLD     12.5
+#define MIN_THRESHOLD         6.0
+#define MAX_THRESHOLD         600.0
+#define THRESHOLD_GAIN_UP     0.0087
+#define THRESHOLD_GAIN_DOWN   0.039
+#define MAX_ADAPT_OFFSET      15.0
+#define MAX_TIME_DELTA        100.0  // msec
+#define OVERUSING_TIME        10.0   // msec
+// the rate controller
+#define DECREASE_FACTOR       0.85
+#define INCREASE_RATIO        0.08  // per second
+#define MIN_INCREASE          1000  // bps
+#define PACKET_SIZE_BITS      (1200 * 8)
+#define CONVERGENCE_RATIO     0.9
+#define LOSS_HIGH             0.1
+#define LOSS_LOW              0.02
+#define MAX_UPDATE_INTERVAL   1000  // msec
+
+BandwidthEstimator::BandwidthEstimator()
+{
+    mMinBitrate = DEFAULT_MIN_BITRATE;
+    mMaxBitrate = 0;
+    mStartBitrate = DEFAULT_START_BITRATE;
+    mRoundTripTime = 0;
+    Reset();
+}
+
+BandwidthEstimator::~BandwidthEstimator() {}
+
+void BandwidthEstimator::Reset()
+{
+    mTargetBitrate = ClampBitrate(mStartBitrate);
+    mCurrentGroup = {0, 0, 0};
+    mPreviousGroup = {0, 0, 0};
+    mCurrentGroupValid = false;
+    mPreviousGroupValid = false;
+    mDelayHistory.clear();
+    mFirstArrivalTimeMs = -1;
+    mLastGroupArrivalTimeMs = -1;
+    mAccumulatedDelay = 0;
+    mSmoothedDelay = 0;
+    mNumDeltas = 0;
+    mUsage = kBandwidthNormal;
+    mThreshold = INITIAL_THRESHOLD;
+    mPreviousTrend = 0;
+    mOverusingTime = -1;
+    mOverusingCount = 0;
+    mLastUpdateTime = 0;
+    mLastDecreaseTime = 0;
+    mLastDecreaseBitrate = 0;
+    mNumLostPackets = 0;
+    mNumExpectedPackets = 0;
+}
+
+void BandwidthEstimator::SetBitrateRange(
+        uint32_t minBitrate, uint32_t maxBitrate, uint32_t startBitrate)
+{
+    mMinBitrate = maxBitrate != 0 ? std::min(minBitrate, maxBitrate) : minBitrate;
+    mMaxBitrate = maxBitrate;
+
+    if (startBitrate != 0)
+    {
+        mStartBitrate = startBitrate;
+        mTargetBitrate = startBitrate;
+    }
+
+    mTargetBitrate = ClampBitrate(mTargetBitrate);
+    IMLOGD3("[SetBitrateRange] min[%u], max[%u], target[%u]", mMinBitrate, mMaxBitrate,
+            mTargetBitrate);
+}
+
+void BandwidthEstimator::SetRoundTripTime(uint32_t rtt)
+{
+    mRoundTripTime = rtt;
+}
+
+kBandwidthUsage BandwidthEstimator::OnPacketArrival(int64_t sendTimeUs, int64_t arrivalTimeUs)
+{
+    if (!mCurrentGroupValid)
+    {
+        mCurrentGroup = {sendTimeUs, sendTimeUs, arrivalTimeUs};
+        mCurrentGroupValid = true;
+        return mUsage;
+    }
+
+    // the reordered packet of the previous group
+    if (sendTimeUs < mCurrentGroup.firstSendTimeUs)
+    {
+        return mUsage;
+    }
+
+    if (sendTimeUs - mCurrentGroup.firstSendTimeUs <= BURST_TIME_US)
+    {
+        mCurrentGroup.lastSendTimeUs = std::max(mCurrentGroup.lastSendTimeUs, sendTimeUs);
+        mCurrentGroup.lastArrivalTimeUs = std::max(mCurrentGroup.lastArrivalTimeUs, arrivalTimeUs);
+        return mUsage;
+    }
+
+    // the current group is completed by the first packet of the next group
+    if (mPreviousGroupValid)
+    {
+        double sendDelta =
+                (mCurrentGroup.lastSendTimeUs - mPreviousGroup.lastSendTimeUs) / 1000.0;
+        double arrivalDelta =
+                (mCurrentGroup.lastArrivalTimeUs - mPreviousGroup.lastArrivalTimeUs) / 1000.0;
+        OnGroupComplete(arrivalDelta - sendDelta, mCurrentGroup.lastArrivalTimeUs / 1000);
+    }
+
+    mPreviousGroup = mCurrentGroup;
+    mPreviousGroupValid = true;
+    mCurrentGroup = {sendTimeUs, sendTimeUs, arrivalTimeUs};
+    return mUsage;
+}
+
+void BandwidthEstimator::OnPacketLoss(uint32_t numLost, uint32_t numPackets)
+{
+    mNumLostPackets += numLost;
+    mNumExpectedPackets += numPackets;
+}
+
+uint32_t BandwidthEstimator::Update(uint32_t currentTime, uint32_t incomingBitrate)
+{
+    uint32_t timeDelta = mLastUpdateTime == 0 ? 0 : currentTime - mLastUpdateTime;
+    timeDelta = std::min(timeDelta, static_cast<uint32_t>(MAX_UPDATE_INTERVAL));
+    mLastUpdateTime = currentTime;
+
+    double lossRate = mNumExpectedPackets == 0
+            ? 0
+            : static_cast<double>(mNumLostPackets) / mNumExpectedPackets;
+    mNumLostPackets = 0;
+    mNumExpectedPackets = 0;
+
+    bool canDecrease =
+            mLastDecreaseTime == 0 || currentTime - mLastDecreaseTime >= GetResponseTime();
+    double bitrate = mTargetBitrate;
+
+    if (mUsage == kBandwidthOverusing || lossRate > LOSS_HIGH)
+    {
+        if (canDecrease)
+        {
+            mLastDecreaseBitrate = mTargetBitrate;
+            mLastDecreaseTime = currentTime;
+
+            if (mUsage == kBandwidthOverusing)
+            {
+                // back off below the throughput actually delivered through the bottleneck
+                double base = incomingBitrate != 0 ? incomingBitrate : mTargetBitrate;
+                bitrate = std::min(bitrate, base * DECREASE_FACTOR);
+            }
+            else
+            {
+                bitrate *= (1 - 0.5 * lossRate);
+            }
+        }
+    }
+    else if (mUsage == kBandwidthNormal && lossRate < LOSS_LOW)
+    {
+        double increase;
+
+        if (mLastDecreaseBitrate != 0 && bitrate >= mLastDecreaseBitrate * CONVERGENCE_RATIO)
+        {
+            // close to the bitrate congested last time, a packet per response time
+            increase = static_cast<double>(PACKET_SIZE_BITS) * timeDelta / GetResponseTime();
+        }
+        else
+        {
+            increase = bitrate * INCREASE_RATIO * timeDelta / 1000;
+        }
+
+        bitrate += std::max(increase, static_cast<double>(MIN_INCREASE));
+
+        // do not run away from the bitrate the sender actually uses
+        if (incomingBitrate != 0)
+        {
+            double limit = 1.5 * incomingBitrate + 10000;
+            bitrate = std::max(static_cast<double>(mTargetBitrate), std::min(bitrate, limit));
+        }
+    }
+
+    // hold the bitrate while the queue drains in the underusing state or the loss is moderate
+    mTargetBitrate = ClampBitrate(static_cast<uint32_t>(bitrate));
+
+    IMLOGD_PACKET5(IM_PACKET_LOG_RTCP,
+            "[Update] usage[%d], threshold[%.2f], loss[%.3f], incoming[%u], target[%u]", mUsage,
+            mThreshold, lossRate, incomingBitrate, mTargetBitrate);
+    return mTargetBitrate;
+}
+
+kBandwidthUsage BandwidthEstimator::GetUsage()
+{
+    return mUsage;
+}
+
+uint32_t BandwidthEstimator::GetTargetBitrate()
+{
+    return mTargetBitrate;
+}
+
+void BandwidthEstimator::OnGroupComplete(double delayVariation, int64_t arrivalTimeMs)
+{
+    mNumDeltas = std::min(mNumDeltas + 1, static_cast<uint32_t>(MAX_NUM_DELTAS));
+
+    if (mFirstArrivalTimeMs < 0)
+    {
+        mFirstArrivalTimeMs = arrivalTimeMs;
+    }
+
+    double timeDelta =
+            mLastGroupArrivalTimeMs < 0 ? 0 : arrivalTimeMs - mLastGroupArrivalTimeMs;
+    mLastGroupArrivalTimeMs = arrivalTimeMs;
+
+    mAccumulatedDelay += delayVariation;
+    mSmoothedDelay = SMOOTHING_COEF * mSmoothedDelay + (1 - SMOOTHING_COEF) * mAccumulatedDelay;
+    mDelayHistory.emplace_back(arrivalTimeMs - mFirstArrivalTimeMs, mSmoothedDelay);
+
+    if (mDelayHistory.size() > TRENDLINE_WINDOW_SIZE)
+    {
+        mDelayHistory.pop_front();
+    }
+
+    double trend = mPreviousTrend;
+
+    if (mDelayHistory.size() == TRENDLINE_WINDOW_SIZE)
+    {
+        // the slope of the linear regression of the smoothed delay over the arrival time
+        double sumX = 0;
+        double sumY = 0;
+
+        for (const auto& point : mDelayHistory)
+        {
+            sumX += point.first;
+            sumY += point.second;
+        }
+
+        double avgX = sumX / mDelayHistory.size();
+        double avgY = sumY / mDelayHistory.size();
+        double numerator = 0;
+        double denominator = 0;
+
+        for (const auto& point : mDelayHistory)
+        {
+            numerator += (point.first - avgX) * (point.second - avgY);
+            denominator += (point.first - avgX) * (point.first - avgX);
+        }
+
+        if (denominator != 0)
+        {
+            trend = numerator / denominator;
+        }
+    }
+
+    DetectUsage(trend, timeDelta);
+}
+
+void BandwidthEstimator::DetectUsage(double trend, double timeDelta)
+{
+    if (mNumDeltas < 2)
+    {
+        return;
+    }
+
+    double modifiedTrend = mNumDeltas * trend * TREND_GAIN;
+    kBandwidthUsage usage = mUsage;
+
+    if (modifiedTrend > mThreshold)
+    {
+        mOverusingTime = mOverusingTime < 0 ? timeDelta / 2 : mOverusingTime + timeDelta;
+        mOverusingCount++;
+
+        // the overuse should be sustained and the delay should be still increasing
+        if (mOverusingTime > OVERUSING_TIME && mOverusingCount > 1 && trend >= mPreviousTrend)
+        {
+            mOverusingTime = 0;
+            mOverusingCount = 0;
+            usage = kBandwidthOverusing;
+        }
+    }
+    else if (modifiedTrend < -mThreshold)
+    {
+        mOverusingTime = -1;
+        mOverusingCount = 0;
+        usage = kBandwidthUnderusing;
+    }
+    else
+    {
+        mOverusingTime = -1;
+        mOverusingCount = 0;
+        usage = kBandwidthNormal;
+    }
+
+    if (usage != mUsage)
+    {
+        IMLOGD_PACKET3(IM_PACKET_LOG_RTCP, "[DetectUsage] usage[%d], trend[%.2f], threshold[%.2f]",
+                usage, modifiedTrend, mThreshold);
+        mUsage = usage;
+    }
+
+    mPreviousTrend = trend;
+    UpdateThreshold(modifiedTrend, timeDelta);
+}
+
+void BandwidthEstimator::UpdateThreshold(double modifiedTrend, double timeDelta)
+{
+    double absTrend = fabs(modifiedTrend);
+
+    // ignore the sudden spike not to raise the threshold too much
+    if (absTrend > mThreshold + MAX_ADAPT_OFFSET)
+    {
+        return;
+    }
+
+    double gain = absTrend < mThreshold ? THRESHOLD_GAIN_DOWN : THRESHOLD_GAIN_UP;
+    mThreshold += gain * (absTrend - mThreshold) * std::min(timeDelta, MAX_TIME_DELTA);
+    mThreshold = std::min(std::max(mThreshold, MIN_THRESHOLD), MAX_THRESHOLD);
+}
+
+uint32_t BandwidthEstimator::GetResponseTime()
+{
+    return (mRoundTripTime != 0 ? mRoundTripTime : DEFAULT_RTT) + 100;
+}
+
+uint32_t BandwidthEstimator::ClampBitrate(uint32_t bitrate)
+{
+    if (mMaxBitrate != 0 && bitrate > mMaxBitrate)
+    {
+        bitrate = mMaxBitrate;
+    }
+
+    return std::max(bitrate, mMinBitrate);
+}
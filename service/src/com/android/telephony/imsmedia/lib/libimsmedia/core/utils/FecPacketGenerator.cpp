@@ -0,0 +1,182 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <FecPacketGenerator.h>
+#include <ImsMediaTrace.h>
+
+#define RTP_FIXED_HEADER_SIZE 12
+
+FecPacketGenerator::FecPacketGenerator()
+{
+    mFecRate = 0;
+    mMaskType = kFecMaskInterleaved;
+    Reset();
+}
+
+FecPacketGenerator::~FecPacketGenerator() {}
+
+void FecPacketGenerator::Reset()
+{
+    mMediaPackets.clear();
+    mHasLastSeqNum = false;
+    mLastSeqNum = 0;
+}
+
+void FecPacketGenerator::SetProtection(uint32_t fecRate, kFecMaskType maskType)
+{
+    mFecRate = fecRate > 100 ? 100 : fecRate;
+    mMaskType = maskType;
+}
+
+uint32_t FecPacketGenerator::GetFecRate()
+{
+    return mFecRate;
+}
+
+bool FecPacketGenerator::AddMediaPacket(const uint8_t* packet, uint32_t size)
+{
+    if (packet == nullptr || size < RTP_FIXED_HEADER_SIZE)
+    {
+        return false;
+    }
+
+    uint16_t seqNum = packet[2] << 8 | packet[3];
+
+    if (mHasLastSeqNum && static_cast<int16_t>(seqNum - mLastSeqNum) <= 0)
+    {
+        return false;
+    }
+
+    // the mask covers the consecutive sequence numbers only
+    if (!mMediaPackets.empty() &&
+            (mMediaPackets.size() >= kMaxMediaPackets ||
+                    static_cast<uint16_t>(seqNum - mLastSeqNum) != 1))
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[AddMediaPacket] seq[%u], drop [%u] packets unprotected",
+                seqNum, mMediaPackets.size());
+        mMediaPackets.clear();
+    }
+
+    mHasLastSeqNum = true;
+    mLastSeqNum = seqNum;
+    mMediaPackets.emplace_back(packet, packet + size);
+    return true;
+}
+
+uint32_t FecPacketGenerator::GetNumMediaPackets()
+{
+    return mMediaPackets.size();
+}
+
+uint32_t FecPacketGenerator::Generate(std::list<std::vector<uint8_t>>& fecPackets)
+{
+    uint32_t numMedia = mMediaPackets.size();
+
+    if (numMedia == 0 || mFecRate == 0)
+    {
+        mMediaPackets.clear();
+        return 0;
+    }
+
+    uint32_t numFec = (numMedia * mFecRate + 99) / 100;
+
+    for (uint32_t i = 0; i < numFec; i++)
+    {
+        std::vector<uint32_t> indexes;
+
+        for (uint32_t j = 0; j < numMedia; j++)
+        {
+            bool isProtected = (mMaskType == kFecMaskInterleaved)
+                    ? (j % numFec == i)
+                    : (j * numFec / numMedia == i);
+
+            if (isProtected)
+            {
+                indexes.push_back(j);
+            }
+        }
+
+        fecPackets.emplace_back();
+        GenerateFecPacket(indexes, fecPackets.back());
+    }
+
+    IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[Generate] media[%u], fec[%u], mask[%d]", numMedia, numFec,
+            mMaskType);
+    mMediaPackets.clear();
+    return numFec;
+}
+
+void FecPacketGenerator::GenerateFecPacket(
+        const std::vector<uint32_t>& indexes, std::vector<uint8_t>& fec)
+{
+    const uint8_t* first = mMediaPackets.front().data();
+    uint16_t seqBase = first[2] << 8 | first[3];
+    uint32_t protectionLength = 0;
+
+    for (uint32_t index : indexes)
+    {
+        uint32_t length = mMediaPackets[index].size() - RTP_FIXED_HEADER_SIZE;
+        protectionLength = length > protectionLength ? length : protectionLength;
+    }
+
+    bool longMask = mMediaPackets.size() > kShortMaskBits;
+    uint32_t levelHeaderSize = longMask ? kLongLevelHeaderSize : kShortLevelHeaderSize;
+    uint32_t headerSize = kFecHeaderSize + levelHeaderSize;
+    fec.assign(headerSize + protectionLength, 0);
+    uint64_t mask = 0;
+    uint16_t lengthRecovery = 0;
+
+    for (uint32_t index : indexes)
+    {
+        const std::vector<uint8_t>& media = mMediaPackets[index];
+        uint16_t length = media.size() - RTP_FIXED_HEADER_SIZE;
+
+        // the P, X, CC bits, the M bit and the payload type, the timestamp
+        fec[0] ^= media[0] & 0x3F;
+        fec[1] ^= media[1];
+
+        for (uint32_t i = 4; i < 8; i++)
+        {
+            fec[i] ^= media[i];
+        }
+
+        lengthRecovery ^= length;
+
+        for (uint32_t i = 0; i < length; i++)
+        {
+            fec[headerSize + i] ^= media[RTP_FIXED_HEADER_SIZE + i];
+        }
+
+        mask |= 1ULL << ((longMask ? kMaxMediaPackets : kShortMaskBits) - 1 - index);
+    }
+
+    if (longMask)
+    {
+        fec[0] |= 0x40;
+    }
+
+    fec[2] = seqBase >> 8;
+    fec[3] = seqBase & 0xFF;
+    fec[8] = lengthRecovery >> 8;
+    fec[9] = lengthRecovery & 0xFF;
+    fec[10] = protectionLength >> 8;
+    fec[11] = protectionLength & 0xFF;
+
+    for (uint32_t i = 0; i < levelHeaderSize - 2; i++)
+    {
+        fec[12 + i] = (mask >> (8 * (levelHeaderSize - 3 - i))) & 0xFF;
+    }
+}
@@ -0,0 +1,331 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <FecPacketRecovery.h>
+#include <FecPacketGenerator.h>
+#include <ImsMediaTrace.h>
+
+#define RTP_FIXED_HEADER_SIZE 12
+
+FecPacketRecovery::FecPacketRecovery()
+{
+    Reset();
+}
+
+FecPacketRecovery::~FecPacketRecovery() {}
+
+void FecPacketRecovery::Reset()
+{
+    mMediaPackets.clear();
+    mFecPackets.clear();
+    mRecoveredPackets.clear();
+    mHasNewestSeqNum = false;
+    mNewestSeqNum = 0;
+    mHasMediaSsrc = false;
+    mMediaSsrc = 0;
+    mHasFecSsrc = false;
+    mFecSsrc = 0;
+    mNumRecovered = 0;
+}
+
+void FecPacketRecovery::OnMediaPacket(const uint8_t* packet, uint32_t size)
+{
+    if (packet == nullptr || size < RTP_FIXED_HEADER_SIZE)
+    {
+        return;
+    }
+
+    uint16_t seqNum = packet[2] << 8 | packet[3];
+    uint32_t ssrc = packet[8] << 24 | packet[9] << 16 | packet[10] << 8 | packet[11];
+
+    if (!mHasMediaSsrc || ssrc != mMediaSsrc)
+    {
+        SetMediaSsrc(ssrc);
+    }
+
+    if (FindMediaPacket(seqNum) != nullptr)
+    {
+        return;
+    }
+
+    StoreMediaPacket(seqNum, packet, size);
+    Recover();
+}
+
+bool FecPacketRecovery::OnFecPacket(const uint8_t* fec, uint32_t size, uint32_t ssrc)
+{
+    if (fec == nullptr || size < FecPacketGenerator::kFecHeaderSize + 2)
+    {
+        return false;
+    }
+
+    bool longMask = (fec[0] & 0x40) != 0;
+    uint32_t levelHeaderSize = longMask ? FecPacketGenerator::kLongLevelHeaderSize
+                                        : FecPacketGenerator::kShortLevelHeaderSize;
+    uint32_t headerSize = FecPacketGenerator::kFecHeaderSize + levelHeaderSize;
+
+    if (size < headerSize)
+    {
+        return false;
+    }
+
+    FecPacket packet;
+    packet.seqBase = fec[2] << 8 | fec[3];
+    packet.protectionLength = fec[10] << 8 | fec[11];
+
+    if (size < headerSize + packet.protectionLength)
+    {
+        IMLOGE2("[OnFecPacket] invalid size[%u], protection length[%u]", size,
+                packet.protectionLength);
+        return false;
+    }
+
+    uint32_t maskBits = (levelHeaderSize - 2) * 8;
+
+    for (uint32_t i = 0; i < maskBits; i++)
+    {
+        if (fec[12 + i / 8] & (0x80 >> (i % 8)))
+        {
+            packet.protectedSeqNums.push_back(packet.seqBase + i);
+        }
+    }
+
+    if (packet.protectedSeqNums.empty())
+    {
+        return false;
+    }
+
+    // the media packets too old to be kept are not recovered, not to deliver the duplicates
+    if (mHasNewestSeqNum &&
+            static_cast<int16_t>(mNewestSeqNum - packet.seqBase) >=
+                    static_cast<int32_t>(kMaxMediaPackets - maskBits))
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[OnFecPacket] too old base[%u], newest[%u]",
+                packet.seqBase, mNewestSeqNum);
+        return true;
+    }
+
+    if (!mHasFecSsrc || ssrc != mFecSsrc)
+    {
+        SetFecSsrc(ssrc);
+    }
+
+    packet.data.assign(fec, fec + headerSize + packet.protectionLength);
+
+    if (mFecPackets.size() >= kMaxFecPackets)
+    {
+        mFecPackets.pop_front();
+    }
+
+    mFecPackets.push_back(std::move(packet));
+    Recover();
+    return true;
+}
+
+void FecPacketRecovery::SetMediaSsrc(uint32_t ssrc)
+{
+    // the fec packets received before the first media packet protect the stream
+    if (mHasMediaSsrc)
+    {
+        IMLOGD2("[SetMediaSsrc] media ssrc changed[%x] -> [%x]", mMediaSsrc, ssrc);
+        mMediaPackets.clear();
+        mHasNewestSeqNum = false;
+        mFecPackets.clear();
+        mHasFecSsrc = false;
+    }
+
+    mHasMediaSsrc = true;
+    mMediaSsrc = ssrc;
+}
+
+void FecPacketRecovery::SetFecSsrc(uint32_t ssrc)
+{
+    // the fec packets of the previous fec stream do not follow the sequence numbers of the new one
+    if (mHasFecSsrc)
+    {
+        IMLOGD2("[SetFecSsrc] fec ssrc changed[%x] -> [%x]", mFecSsrc, ssrc);
+        mFecPackets.clear();
+    }
+
+    mHasFecSsrc = true;
+    mFecSsrc = ssrc;
+}
+
+bool FecPacketRecovery::GetRecoveredPacket(std::vector<uint8_t>& packet)
+{
+    if (mRecoveredPackets.empty())
+    {
+        return false;
+    }
+
+    packet = std::move(mRecoveredPackets.front());
+    mRecoveredPackets.pop_front();
+    return true;
+}
+
+uint32_t FecPacketRecovery::GetNumRecovered()
+{
+    return mNumRecovered;
+}
+
+const std::vector<uint8_t>* FecPacketRecovery::FindMediaPacket(uint16_t seqNum)
+{
+    for (auto it = mMediaPackets.rbegin(); it != mMediaPackets.rend(); ++it)
+    {
+        if (it->first == seqNum)
+        {
+            return &it->second;
+        }
+    }
+
+    return nullptr;
+}
+
+void FecPacketRecovery::StoreMediaPacket(uint16_t seqNum, const uint8_t* packet, uint32_t size)
+{
+    if (!mHasNewestSeqNum || static_cast<int16_t>(seqNum - mNewestSeqNum) > 0)
+    {
+        mHasNewestSeqNum = true;
+        mNewestSeqNum = seqNum;
+    }
+
+    if (mMediaPackets.size() >= kMaxMediaPackets)
+    {
+        mMediaPackets.pop_front();
+    }
+
+    mMediaPackets.emplace_back(seqNum, std::vector<uint8_t>(packet, packet + size));
+}
+
+void FecPacketRecovery::Recover()
+{
+    // the ssrc of the packet recovered is the one of the media stream
+    if (!mHasMediaSsrc)
+    {
+        return;
+    }
+
+    bool recovered = true;
+
+    // a recovered packet can make the other fec packet recover one more
+    while (recovered)
+    {
+        recovered = false;
+
+        for (auto it = mFecPackets.begin(); it != mFecPackets.end();)
+        {
+            uint32_t numMissing = 0;
+            uint16_t missingSeqNum = 0;
+
+            for (uint16_t seqNum : it->protectedSeqNums)
+            {
+                if (FindMediaPacket(seqNum) == nullptr)
+                {
+                    numMissing++;
+                    missingSeqNum = seqNum;
+                }
+            }
+
+            if (numMissing == 0)
+            {
+                it = mFecPackets.erase(it);
+            }
+            else if (numMissing == 1)
+            {
+                recovered = RecoverPacket(*it, missingSeqNum) || recovered;
+                it = mFecPackets.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+}
+
+bool FecPacketRecovery::RecoverPacket(const FecPacket& fec, uint16_t seqNum)
+{
+    const uint8_t* fecData = fec.data.data();
+    uint32_t headerSize = fec.data.size() - fec.protectionLength;
+    uint8_t header[RTP_FIXED_HEADER_SIZE] = {0};
+    uint16_t length = fecData[8] << 8 | fecData[9];
+    std::vector<uint8_t> payload(fecData + headerSize, fecData + fec.data.size());
+
+    header[0] = fecData[0] & 0x3F;
+    header[1] = fecData[1];
+
+    for (uint32_t i = 4; i < 8; i++)
+    {
+        header[i] = fecData[i];
+    }
+
+    for (uint16_t protectedSeqNum : fec.protectedSeqNums)
+    {
+        if (protectedSeqNum == seqNum)
+        {
+            continue;
+        }
+
+        const std::vector<uint8_t>* media = FindMediaPacket(protectedSeqNum);
+        uint32_t mediaLength = media->size() - RTP_FIXED_HEADER_SIZE;
+
+        if (mediaLength > fec.protectionLength)
+        {
+            IMLOGE2("[RecoverPacket] seq[%u] longer than the protection length[%u]",
+                    protectedSeqNum, fec.protectionLength);
+            return false;
+        }
+
+        header[0] ^= (*media)[0] & 0x3F;
+        header[1] ^= (*media)[1];
+
+        for (uint32_t i = 4; i < 8; i++)
+        {
+            header[i] ^= (*media)[i];
+        }
+
+        length ^= mediaLength;
+
+        for (uint32_t i = 0; i < mediaLength; i++)
+        {
+            payload[i] ^= (*media)[RTP_FIXED_HEADER_SIZE + i];
+        }
+    }
+
+    if (length > fec.protectionLength)
+    {
+        IMLOGE2("[RecoverPacket] seq[%u] invalid length[%u]", seqNum, length);
+        return false;
+    }
+
+    // the version 2
+    header[0] |= 0x80;
+    header[2] = seqNum >> 8;
+    header[3] = seqNum & 0xFF;
+    header[8] = (mMediaSsrc >> 24) & 0xFF;
+    header[9] = (mMediaSsrc >> 16) & 0xFF;
+    header[10] = (mMediaSsrc >> 8) & 0xFF;
+    header[11] = mMediaSsrc & 0xFF;
+
+    std::vector<uint8_t> packet(header, header + RTP_FIXED_HEADER_SIZE);
+    packet.insert(packet.end(), payload.begin(), payload.begin() + length);
+
+    IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[RecoverPacket] seq[%u], size[%u]", seqNum, packet.size());
+    StoreMediaPacket(seqNum, packet.data(), packet.size());
+    mRecoveredPackets.push_back(std::move(packet));
+    mNumRecovered++;
+    return true;
+}
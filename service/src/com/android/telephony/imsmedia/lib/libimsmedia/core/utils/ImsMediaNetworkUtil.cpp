@@ -210,4 +210,14 @@ void ImsMediaNetworkUtil::closeSocket(int& socketFd)
     shutdown(socketFd, SHUT_RDWR);
     close(socketFd);
     socketFd = -1;
+}
+
+bool ImsMediaNetworkUtil::isRtcpPacket(const uint8_t* data, const uint32_t size)
+{
+    if (data == nullptr || size < 2)
+    {
+        return false;
+    }
+
+    return data[1] >= 192 && data[1] <= 223;
 }
\ No newline at end of file
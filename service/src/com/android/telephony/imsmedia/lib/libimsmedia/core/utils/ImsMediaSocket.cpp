@@ -71,6 +71,7 @@ void ImsMediaSocket::ReleaseInstance(ImsMediaSocket* pSocket)
 ImsMediaSocket::ImsMediaSocket()
 {
     mListener = nullptr;
+    mRtcpMuxListener = nullptr;
     mRefCount = 0;
     mLocalIPVersion = IPV4;
     mPeerIPVersion = IPV4;
@@ -162,9 +163,29 @@ bool ImsMediaSocket::Open(int socketFd)
 void ImsMediaSocket::Listen(ISocketListener* listener)
 {
     IMLOGD0("[Listen]");
+    bool wasListening = mListener != nullptr || mRtcpMuxListener != nullptr;
     mListener = listener;
+    UpdateRxSocketList(wasListening);
+}
 
-    if (listener != nullptr)
+void ImsMediaSocket::ListenRtcpMux(ISocketListener* listener)
+{
+    IMLOGD0("[ListenRtcpMux]");
+    bool wasListening = mListener != nullptr || mRtcpMuxListener != nullptr;
+    mRtcpMuxListener = listener;
+    UpdateRxSocketList(wasListening);
+}
+
+void ImsMediaSocket::UpdateRxSocketList(bool wasListening)
+{
+    bool isListening = mListener != nullptr || mRtcpMuxListener != nullptr;
+
+    if (isListening == wasListening)
+    {
+        return;
+    }
+
+    if (isListening)
     {
         // add socket list, run thread
         sMutexRxSocket.lock();
@@ -181,7 +202,7 @@ void ImsMediaSocket::Listen(ISocketListener* listener)
         }
 
         sRxSocketCount++;
-        IMLOGD1("[Listen] add sRxSocketCount[%d]", sRxSocketCount);
+        IMLOGD1("[UpdateRxSocketList] add sRxSocketCount[%d]", sRxSocketCount);
     }
     else
     {
@@ -200,7 +221,7 @@ void ImsMediaSocket::Listen(ISocketListener* listener)
             mSocketListUpdated = true;
         }
 
-        IMLOGD1("[Listen] remove RxSocketCount[%d]", sRxSocketCount);
+        IMLOGD1("[UpdateRxSocketList] remove RxSocketCount[%d]", sRxSocketCount);
     }
 }
 
@@ -406,6 +427,32 @@ ISocketListener* ImsMediaSocket::GetListener()
     return mListener;
 }
 
+void ImsMediaSocket::NotifyListener()
+{
+    ISocketListener* listener = mListener;
+    uint8_t header[2];
+
+    if (mRtcpMuxListener != nullptr)
+    {
+        int32_t len = recv(mSocketFd, header, sizeof(header), MSG_PEEK);
+
+        if (len > 0 && ImsMediaNetworkUtil::isRtcpPacket(header, len))
+        {
+            listener = mRtcpMuxListener;
+        }
+    }
+
+    if (listener != nullptr)
+    {
+        listener->OnReadDataFromSocket();
+    }
+    else
+    {
+        // nobody reads the packet of the stopped stream, drop it not to be notified again
+        recv(mSocketFd, header, sizeof(header), 0);
+    }
+}
+
 void ImsMediaSocket::StartSocketMonitor()
 {
     if (mTerminateMonitor == true)
@@ -470,10 +517,7 @@ void ImsMediaSocket::ReadDataFromSocket(void* pReadfds)
                 IMLOGD_PACKET1(IM_PACKET_LOG_SOCKET,
                         "[ReadDataFromSocket] send notify to listener %p", rxSocket->GetListener());
 
-                if (rxSocket->GetListener() != nullptr)
-                {
-                    rxSocket->GetListener()->OnReadDataFromSocket();
-                }
+                rxSocket->NotifyListener();
             }
         }
     }
@@ -241,7 +241,9 @@ void ImsMediaTimer::GetNtpTime(IMNtpTime* pNtpTime)
     {
         // To convert a UNIX timestamp (seconds since 1970) to NTP time, add 2,208,988,800 seconds
         pNtpTime->ntpHigh32Bits = stAndrodTp.tv_sec + 2208988800UL;
-        pNtpTime->ntpLow32Bits = (unsigned int)(stAndrodTp.tv_usec * 4294UL);
+        // fraction of second in units of 2^-32 seconds
+        pNtpTime->ntpLow32Bits =
+                static_cast<uint32_t>((static_cast<uint64_t>(stAndrodTp.tv_usec) << 32) / 1000000);
     }
     else
     {
@@ -258,19 +260,18 @@ void ImsMediaTimer::GetNtpTime(IMNtpTime* pNtpTime)
 uint32_t ImsMediaTimer::GetRtpTsFromNtpTs(IMNtpTime* initNtpTimestamp, uint32_t samplingRate)
 {
     IMNtpTime currentNtpTs;
-    int32_t timeDiffHigh32Bits;
-    int32_t timeDiffLow32Bits;
-    uint32_t timeDiff; /*! In Micro seconds: should always be positive */
-
     GetNtpTime(&currentNtpTs);
 
-    /* SPR #1256 BEGIN */
-    timeDiffHigh32Bits = currentNtpTs.ntpHigh32Bits - initNtpTimestamp->ntpHigh32Bits;
-    timeDiffLow32Bits =
-            (currentNtpTs.ntpLow32Bits / 4294) - (initNtpTimestamp->ntpLow32Bits / 4294);
-    /*! timeDiffHigh32Bits should always be positive */
-    timeDiff = (timeDiffHigh32Bits * 1000) + timeDiffLow32Bits / 1000;
-    return timeDiff * (samplingRate / 1000);
+    /*! time difference in NTP 32.32 fixed point format, it should always be positive */
+    uint64_t currentNtp = (static_cast<uint64_t>(currentNtpTs.ntpHigh32Bits) << 32) |
+            currentNtpTs.ntpLow32Bits;
+    uint64_t initNtp = (static_cast<uint64_t>(initNtpTimestamp->ntpHigh32Bits) << 32) |
+            initNtpTimestamp->ntpLow32Bits;
+    uint64_t timeDiff = currentNtp - initNtp;
+
+    /*! seconds and fraction are scaled separately to avoid overflow */
+    return static_cast<uint32_t>(((timeDiff >> 32) * samplingRate) +
+            (((timeDiff & 0xFFFFFFFF) * samplingRate) >> 32));
 }
 
 uint32_t ImsMediaTimer::GetTimeInMilliSeconds(void)
@@ -0,0 +1,294 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <JitterRingQueue.h>
+#include <ImsMediaTrace.h>
+
+// the number of the sequence numbers from b to a including both
+#define SEQ_RANGE(a, b) (static_cast<uint32_t>(static_cast<uint16_t>((a) - (b))) + 1)
+
+JitterRingQueue::JitterRingQueue() :
+        mSlots(kDefaultCapacity)
+{
+    mFirstSeq = 0;
+    mLastSeq = 0;
+    mCount = 0;
+    mReadSeq = 0;
+    mReadIndex = 0;
+    mNumRead = 0;
+}
+
+JitterRingQueue::~JitterRingQueue()
+{
+    Clear();
+}
+
+bool JitterRingQueue::Insert(DataEntry* entry, std::list<uint16_t>* droppedSeqs)
+{
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    uint16_t seq = entry->nSeqNum;
+
+    if (mCount == 0)
+    {
+        mFirstSeq = seq;
+        mLastSeq = seq;
+    }
+    else if (SEQ_DIFF(seq, mFirstSeq) < 0)
+    {
+        if (SEQ_RANGE(mLastSeq, seq) > kMaxCapacity)
+        {
+            IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Insert] too old seq[%u], first[%u]", seq,
+                    mFirstSeq);
+            return false;
+        }
+
+        Grow(SEQ_RANGE(mLastSeq, seq));
+        mFirstSeq = seq;
+    }
+    else if (SEQ_DIFF(seq, mLastSeq) > 0)
+    {
+        // the oldest entries are dropped by the jump of the sequence number
+        while (mCount > 0 && SEQ_RANGE(seq, mFirstSeq) > kMaxCapacity)
+        {
+            IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Insert] drop seq[%u] by seq[%u]", mFirstSeq,
+                    seq);
+
+            if (droppedSeqs != nullptr)
+            {
+                droppedSeqs->push_back(mFirstSeq);
+            }
+
+            DeleteFirst();
+        }
+
+        if (mCount == 0)
+        {
+            mFirstSeq = seq;
+        }
+
+        Grow(SEQ_RANGE(seq, mFirstSeq));
+        mLastSeq = seq;
+    }
+
+    mSlots[GetIndex(seq)].push_back(new DataEntry(*entry));
+    mCount++;
+    return true;
+}
+
+bool JitterRingQueue::Find(uint16_t seq, uint32_t timestamp, DataEntry** entry)
+{
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    *entry = nullptr;
+
+    if (mCount == 0 || SEQ_DIFF(seq, mFirstSeq) < 0 || SEQ_DIFF(seq, mLastSeq) > 0)
+    {
+        return false;
+    }
+
+    for (DataEntry* slotEntry : mSlots[GetIndex(seq)])
+    {
+        if (slotEntry->nTimestamp == timestamp)
+        {
+            *entry = slotEntry;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool JitterRingQueue::Contains(uint16_t seq)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mCount == 0 || SEQ_DIFF(seq, mFirstSeq) < 0 || SEQ_DIFF(seq, mLastSeq) > 0)
+    {
+        return false;
+    }
+
+    return !mSlots[GetIndex(seq)].empty();
+}
+
+bool JitterRingQueue::IsOlderThanFirst(uint16_t seq)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mCount > 0 && SEQ_DIFF(seq, mFirstSeq) < 0;
+}
+
+void JitterRingQueue::Delete()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    DeleteFirst();
+}
+
+void JitterRingQueue::Clear()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    while (mCount > 0)
+    {
+        DeleteFirst();
+    }
+}
+
+bool JitterRingQueue::Get(DataEntry** entry)
+{
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mCount == 0)
+    {
+        *entry = nullptr;
+        return false;
+    }
+
+    *entry = mSlots[GetIndex(mFirstSeq)].front();
+    return true;
+}
+
+bool JitterRingQueue::GetLast(DataEntry** entry)
+{
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (mCount == 0)
+    {
+        *entry = nullptr;
+        return false;
+    }
+
+    *entry = mSlots[GetIndex(mLastSeq)].back();
+    return true;
+}
+
+uint32_t JitterRingQueue::GetCount()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mCount;
+}
+
+uint32_t JitterRingQueue::GetCapacity()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mSlots.size();
+}
+
+void JitterRingQueue::SetReadPosFirst()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    mReadSeq = mFirstSeq;
+    mReadIndex = 0;
+    mNumRead = 0;
+}
+
+bool JitterRingQueue::GetNext(DataEntry** entry)
+{
+    if (entry == nullptr)
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    *entry = nullptr;
+
+    if (mNumRead >= mCount)
+    {
+        return false;
+    }
+
+    // the entries left to read are between the read position and the last sequence number
+    for (;;)
+    {
+        std::deque<DataEntry*>& slot = mSlots[GetIndex(mReadSeq)];
+
+        if (mReadIndex < slot.size())
+        {
+            *entry = slot[mReadIndex++];
+            mNumRead++;
+            return true;
+        }
+
+        mReadSeq++;
+        mReadIndex = 0;
+    }
+}
+
+void JitterRingQueue::Grow(uint32_t range)
+{
+    if (range <= mSlots.size())
+    {
+        return;
+    }
+
+    uint32_t capacity = mSlots.size();
+
+    while (capacity < range)
+    {
+        capacity <<= 1;
+    }
+
+    IMLOGD2("[Grow] capacity[%zu -> %u]", mSlots.size(), capacity);
+    std::vector<std::deque<DataEntry*>> slots(capacity);
+
+    for (std::deque<DataEntry*>& slot : mSlots)
+    {
+        if (!slot.empty())
+        {
+            slots[slot.front()->nSeqNum & (capacity - 1)] = std::move(slot);
+        }
+    }
+
+    mSlots = std::move(slots);
+}
+
+void JitterRingQueue::DeleteFirst()
+{
+    if (mCount == 0)
+    {
+        return;
+    }
+
+    std::deque<DataEntry*>& slot = mSlots[GetIndex(mFirstSeq)];
+    DataEntry* entry = slot.front();
+    entry->deleteBuffer();
+    delete entry;
+    slot.pop_front();
+    mCount--;
+
+    // moves to the next sequence number of the entries, the slots of the lost packets are empty
+    while (mCount > 0 && mSlots[GetIndex(mFirstSeq)].empty())
+    {
+        mFirstSeq++;
+    }
+}
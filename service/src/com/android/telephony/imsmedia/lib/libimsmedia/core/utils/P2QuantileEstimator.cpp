@@ -0,0 +1,173 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <P2QuantileEstimator.h>
+#include <algorithm>
+#include <cmath>
+
+P2QuantileEstimator::P2QuantileEstimator(double quantile)
+{
+    SetQuantile(quantile);
+}
+
+P2QuantileEstimator::~P2QuantileEstimator() {}
+
+void P2QuantileEstimator::SetQuantile(double quantile)
+{
+    mQuantile = std::min(std::max(quantile, 0.0), 1.0);
+    Reset();
+}
+
+double P2QuantileEstimator::GetQuantile()
+{
+    return mQuantile;
+}
+
+void P2QuantileEstimator::Reset()
+{
+    mCount = 0;
+
+    for (int32_t i = 0; i < kNumMarkers; i++)
+    {
+        mHeights[i] = 0;
+        mPositions[i] = i;
+    }
+
+    mDesiredPositions[0] = 0;
+    mDesiredPositions[1] = 2 * mQuantile;
+    mDesiredPositions[2] = 4 * mQuantile;
+    mDesiredPositions[3] = 2 + 2 * mQuantile;
+    mDesiredPositions[4] = 4;
+
+    mIncrements[0] = 0;
+    mIncrements[1] = mQuantile / 2;
+    mIncrements[2] = mQuantile;
+    mIncrements[3] = (1 + mQuantile) / 2;
+    mIncrements[4] = 1;
+}
+
+void P2QuantileEstimator::Add(double value)
+{
+    if (mCount < kNumMarkers)
+    {
+        mHeights[mCount++] = value;
+
+        if (mCount == kNumMarkers)
+        {
+            std::sort(mHeights, mHeights + kNumMarkers);
+        }
+
+        return;
+    }
+
+    mCount++;
+
+    // the cell of the value, the extreme markers follow the minimum and the maximum
+    int32_t cell;
+
+    if (value < mHeights[0])
+    {
+        mHeights[0] = value;
+        cell = 0;
+    }
+    else if (value >= mHeights[kNumMarkers - 1])
+    {
+        mHeights[kNumMarkers - 1] = value;
+        cell = kNumMarkers - 2;
+    }
+    else
+    {
+        cell = 0;
+
+        while (value >= mHeights[cell + 1])
+        {
+            cell++;
+        }
+    }
+
+    for (int32_t i = cell + 1; i < kNumMarkers; i++)
+    {
+        mPositions[i]++;
+    }
+
+    for (int32_t i = 0; i < kNumMarkers; i++)
+    {
+        mDesiredPositions[i] += mIncrements[i];
+    }
+
+    // the middle markers are moved by one position toward the desired ones
+    for (int32_t i = 1; i < kNumMarkers - 1; i++)
+    {
+        double diff = mDesiredPositions[i] - mPositions[i];
+
+        if ((diff >= 1 && mPositions[i + 1] - mPositions[i] > 1) ||
+                (diff <= -1 && mPositions[i - 1] - mPositions[i] < -1))
+        {
+            int32_t d = diff > 0 ? 1 : -1;
+            double height = CalculateParabolic(i, d);
+
+            if (mHeights[i - 1] < height && height < mHeights[i + 1])
+            {
+                mHeights[i] = height;
+            }
+            else
+            {
+                mHeights[i] = CalculateLinear(i, d);
+            }
+
+            mPositions[i] += d;
+        }
+    }
+}
+
+uint32_t P2QuantileEstimator::GetCount()
+{
+    return mCount;
+}
+
+double P2QuantileEstimator::GetEstimation()
+{
+    if (mCount == 0)
+    {
+        return 0;
+    }
+
+    if (mCount < kNumMarkers)
+    {
+        double heights[kNumMarkers];
+        std::copy(mHeights, mHeights + mCount, heights);
+        std::sort(heights, heights + mCount);
+        return heights[static_cast<int32_t>(std::lround((mCount - 1) * mQuantile))];
+    }
+
+    return mHeights[2];
+}
+
+double P2QuantileEstimator::CalculateParabolic(int32_t i, int32_t d)
+{
+    double n = mPositions[i];
+    double nPrev = mPositions[i - 1];
+    double nNext = mPositions[i + 1];
+
+    return mHeights[i] +
+            d / (nNext - nPrev) *
+            ((n - nPrev + d) * (mHeights[i + 1] - mHeights[i]) / (nNext - n) +
+                    (nNext - n - d) * (mHeights[i] - mHeights[i - 1]) / (n - nPrev));
+}
+
+double P2QuantileEstimator::CalculateLinear(int32_t i, int32_t d)
+{
+    return mHeights[i] + d * (mHeights[i + d] - mHeights[i]) / (mPositions[i + d] - mPositions[i]);
+}
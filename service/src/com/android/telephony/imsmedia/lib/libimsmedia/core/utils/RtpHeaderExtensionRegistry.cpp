@@ -0,0 +1,294 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpHeaderExtensionRegistry.h>
+#include <ImsMediaTrace.h>
+#include <string.h>
+
+// the largest block is every type with the two byte header, rounded up to the word size
+#define MAX_TEMPLATE_SIZE (kRtpHeaderExtensionMax * (2 + 4))
+
+RtpHeaderExtensionRegistry::RtpHeaderExtensionRegistry()
+{
+    Clear();
+}
+
+RtpHeaderExtensionRegistry::~RtpHeaderExtensionRegistry() {}
+
+bool RtpHeaderExtensionRegistry::Register(kRtpHeaderExtensionType type, uint8_t id)
+{
+    if (type >= kRtpHeaderExtensionMax || id == 0)
+    {
+        IMLOGE2("[Register] invalid type[%d], id[%d]", type, id);
+        return false;
+    }
+
+    if (mTypes[id] != kRtpHeaderExtensionMax && mTypes[id] != type)
+    {
+        IMLOGE2("[Register] id[%d] is already used by type[%d]", id, mTypes[id]);
+        return false;
+    }
+
+    if (mIds[type] != 0)
+    {
+        mTypes[mIds[type]] = kRtpHeaderExtensionMax;
+    }
+
+    mIds[type] = id;
+    mTypes[id] = type;
+    IMLOGD2("[Register] type[%d], id[%d]", type, id);
+    return true;
+}
+
+void RtpHeaderExtensionRegistry::Clear()
+{
+    for (int32_t i = 0; i < kRtpHeaderExtensionMax; i++)
+    {
+        mIds[i] = 0;
+        mOffsets[i] = -1;
+    }
+
+    for (int32_t i = 0; i <= kMaxId; i++)
+    {
+        mTypes[i] = kRtpHeaderExtensionMax;
+    }
+
+    mTemplate = RtpHeaderExtensionInfo();
+}
+
+uint8_t RtpHeaderExtensionRegistry::GetId(kRtpHeaderExtensionType type)
+{
+    return type < kRtpHeaderExtensionMax ? mIds[type] : 0;
+}
+
+kRtpHeaderExtensionType RtpHeaderExtensionRegistry::GetType(uint8_t id)
+{
+    return mTypes[id];
+}
+
+bool RtpHeaderExtensionRegistry::Compile()
+{
+    bool useTwoByteHeader = false;
+    int32_t count = 0;
+
+    for (int32_t i = 0; i < kRtpHeaderExtensionMax; i++)
+    {
+        mOffsets[i] = -1;
+
+        if (mIds[i] != 0)
+        {
+            count++;
+
+            if (mIds[i] > kMaxOneByteHeaderId)
+            {
+                useTwoByteHeader = true;
+            }
+        }
+    }
+
+    if (count == 0)
+    {
+        mTemplate = RtpHeaderExtensionInfo();
+        return false;
+    }
+
+    int8_t buffer[MAX_TEMPLATE_SIZE];
+    int32_t offset = 0;
+    memset(buffer, 0, sizeof(buffer));
+
+    for (int32_t i = 0; i < kRtpHeaderExtensionMax; i++)
+    {
+        if (mIds[i] == 0)
+        {
+            continue;
+        }
+
+        uint8_t dataSize = GetDataSize(static_cast<kRtpHeaderExtensionType>(i));
+
+        if (useTwoByteHeader)
+        {
+            buffer[offset++] = mIds[i];
+            buffer[offset++] = dataSize;
+        }
+        else
+        {
+            buffer[offset++] = mIds[i] << 4 | (dataSize - 1);
+        }
+
+        mOffsets[i] = offset;
+        offset += dataSize;
+    }
+
+    // the padding is already zero
+    if (offset % IMS_MEDIA_WORD_SIZE != 0)
+    {
+        offset += IMS_MEDIA_WORD_SIZE - offset % IMS_MEDIA_WORD_SIZE;
+    }
+
+    mTemplate.definedByProfile = useTwoByteHeader
+            ? RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader
+            : RtpHeaderExtensionInfo::kBitPatternForOneByteHeader;
+    mTemplate.length = offset / IMS_MEDIA_WORD_SIZE;
+    mTemplate.setExtensionData(buffer, offset);
+
+    IMLOGD3("[Compile] count[%d], twoByte[%d], size[%d]", count, useTwoByteHeader, offset);
+    return true;
+}
+
+RtpHeaderExtensionInfo* RtpHeaderExtensionRegistry::GetTemplate()
+{
+    return mTemplate.extensionData != nullptr ? &mTemplate : nullptr;
+}
+
+bool RtpHeaderExtensionRegistry::SetValue(kRtpHeaderExtensionType type, uint32_t value)
+{
+    if (type >= kRtpHeaderExtensionMax || mOffsets[type] < 0 || mTemplate.extensionData == nullptr)
+    {
+        return false;
+    }
+
+    uint8_t dataSize = GetDataSize(type);
+    int8_t* data = mTemplate.extensionData + mOffsets[type];
+
+    for (int32_t i = dataSize - 1; i >= 0; i--)
+    {
+        data[i] = value & 0xFF;
+        value >>= 8;
+    }
+
+    return true;
+}
+
+const RtpHeaderExtensionView* RtpHeaderExtensionRegistry::Find(
+        kRtpHeaderExtensionType type, const RtpHeaderExtensionView* views, int32_t numViews)
+{
+    uint8_t id = GetId(type);
+
+    if (id == 0 || views == nullptr)
+    {
+        return nullptr;
+    }
+
+    for (int32_t i = 0; i < numViews; i++)
+    {
+        if (views[i].id == id)
+        {
+            return &views[i];
+        }
+    }
+
+    return nullptr;
+}
+
+int32_t RtpHeaderExtensionRegistry::Parse(const RtpHeaderExtensionInfo& extensionInfo,
+        RtpHeaderExtensionView* views, int32_t maxViews)
+{
+    if (extensionInfo.extensionData == nullptr || views == nullptr)
+    {
+        return 0;
+    }
+
+    bool useTwoByteHeader;
+
+    if (extensionInfo.definedByProfile == RtpHeaderExtensionInfo::kBitPatternForOneByteHeader)
+    {
+        useTwoByteHeader = false;
+    }
+    else if ((extensionInfo.definedByProfile & 0xFFF0) ==
+            RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader)
+    {
+        // the lower 4 bits are application specific
+        useTwoByteHeader = true;
+    }
+    else
+    {
+        return 0;
+    }
+
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(extensionInfo.extensionData);
+    int32_t size = extensionInfo.extensionDataSize;
+    int32_t offset = 0;
+    int32_t numViews = 0;
+
+    while (offset < size)
+    {
+        // ignore padding
+        if (data[offset] == 0)
+        {
+            offset++;
+            continue;
+        }
+
+        uint8_t id;
+        uint8_t dataSize;
+
+        if (useTwoByteHeader)
+        {
+            if (offset + 2 > size)
+            {
+                return -1;
+            }
+
+            id = data[offset];
+            dataSize = data[offset + 1];
+            offset += 2;
+        }
+        else
+        {
+            id = data[offset] >> 4;
+
+            // RFC 8285 4.2, the identifier 15 is reserved and terminates the processing
+            if (id == 15)
+            {
+                break;
+            }
+
+            dataSize = (data[offset] & 0x0F) + 1;
+            offset++;
+        }
+
+        if (offset + dataSize > size)
+        {
+            return -1;
+        }
+
+        if (numViews < maxViews)
+        {
+            views[numViews].id = id;
+            views[numViews].size = dataSize;
+            views[numViews].data = data + offset;
+            numViews++;
+        }
+
+        offset += dataSize;
+    }
+
+    return numViews;
+}
+
+uint8_t RtpHeaderExtensionRegistry::GetDataSize(kRtpHeaderExtensionType type)
+{
+    switch (type)
+    {
+        case kRtpHeaderExtensionCvo:
+        case kRtpHeaderExtensionAudioLevel:
+            return 1;
+        case kRtpHeaderExtensionTransportSeq:
+            return 2;
+        default:
+            return 0;
+    }
+}
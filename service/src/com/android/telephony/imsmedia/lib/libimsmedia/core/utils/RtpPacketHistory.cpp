@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpPacketHistory.h>
+#include <ImsMediaTrace.h>
+
+#define RTP_FIXED_HEADER_SIZE 12
+
+RtpPacketHistory::RtpPacketHistory()
+{
+    Reset();
+}
+
+RtpPacketHistory::~RtpPacketHistory() {}
+
+void RtpPacketHistory::Reset()
+{
+    for (auto& entry : mEntries)
+    {
+        entry.valid = false;
+        entry.seqNum = 0;
+        entry.sentTime = 0;
+        entry.retransmitTime = 0;
+        entry.packet.clear();
+    }
+
+    mNumRetransmitted = 0;
+}
+
+void RtpPacketHistory::Add(const uint8_t* packet, uint32_t size, uint32_t sentTime)
+{
+    if (packet == nullptr || size < RTP_FIXED_HEADER_SIZE)
+    {
+        return;
+    }
+
+    uint16_t seqNum = packet[2] << 8 | packet[3];
+    HistoryEntry& entry = mEntries[seqNum & (kMaxHistorySize - 1)];
+    entry.valid = true;
+    entry.seqNum = seqNum;
+    entry.sentTime = sentTime;
+    entry.retransmitTime = 0;
+    entry.packet.assign(packet, packet + size);
+}
+
+const uint8_t* RtpPacketHistory::GetPacketToRetransmit(
+        uint16_t seqNum, uint32_t currentTime, uint32_t interval, uint32_t* size)
+{
+    HistoryEntry& entry = mEntries[seqNum & (kMaxHistorySize - 1)];
+
+    if (!entry.valid || entry.seqNum != seqNum)
+    {
+        IMLOGD_PACKET1(IM_PACKET_LOG_RTP, "[GetPacketToRetransmit] seq[%u] not found", seqNum);
+        return nullptr;
+    }
+
+    if (currentTime - entry.sentTime > kMaxPacketAge)
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[GetPacketToRetransmit] seq[%u] too old[%u]", seqNum,
+                currentTime - entry.sentTime);
+        return nullptr;
+    }
+
+    if (entry.retransmitTime != 0 && currentTime - entry.retransmitTime < interval)
+    {
+        IMLOGD_PACKET2(IM_PACKET_LOG_RTP, "[GetPacketToRetransmit] seq[%u] retransmitted in[%u]",
+                seqNum, currentTime - entry.retransmitTime);
+        return nullptr;
+    }
+
+    // not to be zero to mark the packet retransmitted
+    entry.retransmitTime = currentTime != 0 ? currentTime : 1;
+    mNumRetransmitted++;
+
+    if (size != nullptr)
+    {
+        *size = entry.packet.size();
+    }
+
+    return entry.packet.data();
+}
+
+uint32_t RtpPacketHistory::GetNumRetransmitted()
+{
+    return mNumRetransmitted;
+}
@@ -0,0 +1,91 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RttEstimator.h>
+#include <ImsMediaTrace.h>
+
+// the gains of RFC 6298, alpha 1/8 and beta 1/4
+#define RTT_ALPHA_SHIFT     3
+#define RTTVAR_BETA_SHIFT   2
+#define RTTVAR_MULTIPLIER   4
+
+RttEstimator::RttEstimator()
+{
+    Reset();
+}
+
+RttEstimator::~RttEstimator() {}
+
+void RttEstimator::Reset()
+{
+    mSmoothedRtt = 0;
+    mRttVariation = 0;
+    mLatestRtt = 0;
+}
+
+void RttEstimator::Update(uint32_t rtt)
+{
+    int64_t sample = static_cast<int64_t>(rtt) * 1000;
+    int64_t smoothed = mSmoothedRtt;
+    int64_t variation = mRttVariation;
+
+    if (smoothed == 0)
+    {
+        smoothed = sample;
+        variation = sample / 2;
+    }
+    else
+    {
+        int64_t error = sample > smoothed ? sample - smoothed : smoothed - sample;
+        variation += (error - variation) >> RTTVAR_BETA_SHIFT;
+        smoothed += (sample - smoothed) >> RTT_ALPHA_SHIFT;
+    }
+
+    mLatestRtt = static_cast<uint32_t>(sample);
+    mRttVariation = static_cast<uint32_t>(variation);
+    mSmoothedRtt = static_cast<uint32_t>(smoothed);
+
+    IMLOGD_PACKET3(IM_PACKET_LOG_RTCP, "[Update] rtt[%u], srtt[%u], rttvar[%u]", rtt,
+            GetSmoothedRtt(), GetRttVariation());
+}
+
+uint32_t RttEstimator::GetSmoothedRtt()
+{
+    return mSmoothedRtt / 1000;
+}
+
+uint32_t RttEstimator::GetRttVariation()
+{
+    return mRttVariation / 1000;
+}
+
+uint32_t RttEstimator::GetLatestRtt()
+{
+    return mLatestRtt / 1000;
+}
+
+uint32_t RttEstimator::GetRetransmissionTimeout(uint32_t granularity)
+{
+    uint32_t smoothed = GetSmoothedRtt();
+
+    if (smoothed == 0)
+    {
+        return 0;
+    }
+
+    uint32_t margin = RTTVAR_MULTIPLIER * GetRttVariation();
+    return smoothed + (margin > granularity ? margin : granularity);
+}
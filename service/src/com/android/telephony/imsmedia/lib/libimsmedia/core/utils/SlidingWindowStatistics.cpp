@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <SlidingWindowStatistics.h>
+#include <cmath>
+
+// the drift of the inverse update is cleared by recalculation in this number of samples
+#define RECALCULATION_INTERVAL (1 << 16)
+
+SlidingWindowStatistics::SlidingWindowStatistics(uint32_t windowSize) :
+        mWindowSize(windowSize > 0 ? windowSize : 1)
+{
+    Reset();
+}
+
+SlidingWindowStatistics::~SlidingWindowStatistics() {}
+
+void SlidingWindowStatistics::Reset()
+{
+    mValues.clear();
+    mMaxCandidates.clear();
+    mNumAdded = 0;
+    mMean = 0;
+    mSquaredSum = 0;
+}
+
+void SlidingWindowStatistics::Add(int32_t value)
+{
+    if (mValues.size() >= mWindowSize)
+    {
+        Remove(mValues.front());
+        mValues.pop_front();
+    }
+
+    mValues.push_back(value);
+    double delta = value - mMean;
+    mMean += delta / mValues.size();
+    mSquaredSum += delta * (value - mMean);
+
+    while (!mMaxCandidates.empty() && mMaxCandidates.back().second <= value)
+    {
+        mMaxCandidates.pop_back();
+    }
+
+    mMaxCandidates.emplace_back(mNumAdded, value);
+
+    // the candidate out of the window
+    if (mMaxCandidates.front().first + mWindowSize <= mNumAdded)
+    {
+        mMaxCandidates.pop_front();
+    }
+
+    if (++mNumAdded % RECALCULATION_INTERVAL == 0)
+    {
+        double sum = 0;
+
+        for (int32_t sample : mValues)
+        {
+            sum += sample;
+        }
+
+        mMean = sum / mValues.size();
+        mSquaredSum = 0;
+
+        for (int32_t sample : mValues)
+        {
+            mSquaredSum += (sample - mMean) * (sample - mMean);
+        }
+    }
+}
+
+uint32_t SlidingWindowStatistics::GetCount()
+{
+    return mValues.size();
+}
+
+double SlidingWindowStatistics::GetMean()
+{
+    return mMean;
+}
+
+double SlidingWindowStatistics::GetDeviation()
+{
+    if (mValues.empty() || mSquaredSum <= 0)
+    {
+        return 0;
+    }
+
+    return sqrt(mSquaredSum / mValues.size());
+}
+
+int32_t SlidingWindowStatistics::GetMax()
+{
+    return mMaxCandidates.empty() ? 0 : mMaxCandidates.front().second;
+}
+
+void SlidingWindowStatistics::Remove(int32_t value)
+{
+    uint32_t count = mValues.size() - 1;
+
+    if (count == 0)
+    {
+        mMean = 0;
+        mSquaredSum = 0;
+        return;
+    }
+
+    double delta = value - mMean;
+    mMean -= delta / count;
+    mSquaredSum -= delta * (value - mMean);
+}
@@ -0,0 +1,315 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <TransportFeedback.h>
+#include <ImsMediaDefine.h>
+#include <ImsMediaTrace.h>
+#include <string.h>
+
+// the packet status symbols
+#define STATUS_NOT_RECEIVED  0
+#define STATUS_SMALL_DELTA   1
+#define STATUS_LARGE_DELTA   2
+#define DELTA_UNIT_US        250
+#define REFERENCE_TIME_UNIT  64  // milliseconds
+#define SYMBOLS_PER_CHUNK    7
+
+TransportFeedback::TransportFeedback()
+{
+    Reset();
+}
+
+TransportFeedback::~TransportFeedback() {}
+
+void TransportFeedback::Reset()
+{
+    mPackets.clear();
+    mLastSeqNum = -1;
+    mNextBaseSeqNum = -1;
+    mFeedbackCount = 0;
+}
+
+void TransportFeedback::OnPacketReceived(uint16_t seqNum, uint32_t arrivalTime)
+{
+    int64_t seq = seqNum;
+
+    if (mLastSeqNum >= 0)
+    {
+        seq = mLastSeqNum + static_cast<int16_t>(seqNum - static_cast<uint16_t>(mLastSeqNum));
+    }
+
+    // the packets reordered before the first one across the wrap around are not reported
+    if (seq < 0)
+    {
+        return;
+    }
+
+    if (seq > mLastSeqNum)
+    {
+        mLastSeqNum = seq;
+    }
+
+    // already reported as lost
+    if (mNextBaseSeqNum >= 0 && seq < mNextBaseSeqNum)
+    {
+        return;
+    }
+
+    mPackets.emplace(seq, arrivalTime);
+}
+
+uint32_t TransportFeedback::GetNumPendingPackets()
+{
+    return mPackets.size();
+}
+
+uint32_t TransportFeedback::Build(uint8_t* buffer, uint32_t size)
+{
+    if (buffer == nullptr || mPackets.empty())
+    {
+        return 0;
+    }
+
+    int64_t baseSeq = mPackets.begin()->first;
+
+    // reports the losses after the last feedback unless the gap does not fit in a feedback
+    if (mNextBaseSeqNum >= 0 && baseSeq - mNextBaseSeqNum < kMaxStatusCount)
+    {
+        baseSeq = mNextBaseSeqNum;
+    }
+
+    int64_t lastSeq = mPackets.rbegin()->first;
+
+    if (lastSeq - baseSeq + 1 > kMaxStatusCount)
+    {
+        lastSeq = baseSeq + kMaxStatusCount - 1;
+    }
+
+    uint32_t count = lastSeq - baseSeq + 1;
+    uint32_t referenceTime = mPackets.begin()->second / REFERENCE_TIME_UNIT;
+    int64_t prevTimeUs = static_cast<int64_t>(referenceTime) * REFERENCE_TIME_UNIT * 1000;
+    uint8_t symbols[kMaxStatusCount];
+    int16_t deltas[kMaxStatusCount];
+    uint32_t deltaSize = 0;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        auto iter = mPackets.find(baseSeq + i);
+
+        if (iter == mPackets.end())
+        {
+            symbols[i] = STATUS_NOT_RECEIVED;
+            continue;
+        }
+
+        int64_t delta =
+                (static_cast<int64_t>(iter->second) * 1000 - prevTimeUs) / DELTA_UNIT_US;
+
+        if (delta >= 0 && delta <= UINT8_MAX)
+        {
+            symbols[i] = STATUS_SMALL_DELTA;
+            deltaSize += 1;
+        }
+        else
+        {
+            symbols[i] = STATUS_LARGE_DELTA;
+            deltaSize += 2;
+
+            if (delta > INT16_MAX)
+            {
+                delta = INT16_MAX;
+            }
+            else if (delta < INT16_MIN)
+            {
+                delta = INT16_MIN;
+            }
+        }
+
+        deltas[i] = static_cast<int16_t>(delta);
+        prevTimeUs += delta * DELTA_UNIT_US;
+    }
+
+    uint32_t numChunks = (count + SYMBOLS_PER_CHUNK - 1) / SYMBOLS_PER_CHUNK;
+    uint32_t fciSize = 8 + numChunks * 2 + deltaSize;
+
+    if (fciSize % IMS_MEDIA_WORD_SIZE != 0)
+    {
+        fciSize += IMS_MEDIA_WORD_SIZE - fciSize % IMS_MEDIA_WORD_SIZE;
+    }
+
+    if (fciSize > size)
+    {
+        IMLOGE2("[Build] insufficient buffer size[%u], required[%u]", size, fciSize);
+        return 0;
+    }
+
+    memset(buffer, 0, fciSize);
+    uint16_t baseSeqNum = static_cast<uint16_t>(baseSeq);
+    buffer[0] = baseSeqNum >> 8;
+    buffer[1] = baseSeqNum & 0xFF;
+    buffer[2] = count >> 8;
+    buffer[3] = count & 0xFF;
+    buffer[4] = (referenceTime >> 16) & 0xFF;
+    buffer[5] = (referenceTime >> 8) & 0xFF;
+    buffer[6] = referenceTime & 0xFF;
+    buffer[7] = mFeedbackCount;
+    uint32_t offset = 8;
+
+    // the two bit status vector chunks only, it is simple and good enough for the short interval
+    for (uint32_t i = 0; i < numChunks; i++)
+    {
+        uint16_t chunk = 0xC000;
+
+        for (uint32_t j = 0; j < SYMBOLS_PER_CHUNK; j++)
+        {
+            uint32_t index = i * SYMBOLS_PER_CHUNK + j;
+
+            if (index < count)
+            {
+                chunk |= symbols[index] << (12 - 2 * j);
+            }
+        }
+
+        buffer[offset++] = chunk >> 8;
+        buffer[offset++] = chunk & 0xFF;
+    }
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        if (symbols[i] == STATUS_SMALL_DELTA)
+        {
+            buffer[offset++] = static_cast<uint8_t>(deltas[i]);
+        }
+        else if (symbols[i] == STATUS_LARGE_DELTA)
+        {
+            uint16_t delta = static_cast<uint16_t>(deltas[i]);
+            buffer[offset++] = delta >> 8;
+            buffer[offset++] = delta & 0xFF;
+        }
+    }
+
+    IMLOGD_PACKET4(IM_PACKET_LOG_RTCP, "[Build] base[%u], count[%u], fbCount[%u], size[%u]",
+            baseSeqNum, count, mFeedbackCount, fciSize);
+
+    mPackets.erase(mPackets.begin(), mPackets.upper_bound(lastSeq));
+    mNextBaseSeqNum = lastSeq + 1;
+    mFeedbackCount++;
+    return fciSize;
+}
+
+bool TransportFeedback::Parse(const uint8_t* fci, uint32_t size, TransportFeedbackResult* result)
+{
+    if (fci == nullptr || result == nullptr || size < 8)
+    {
+        return false;
+    }
+
+    uint16_t baseSeqNum = fci[0] << 8 | fci[1];
+    uint16_t count = fci[2] << 8 | fci[3];
+    int32_t referenceTime = fci[4] << 16 | fci[5] << 8 | fci[6];
+
+    // 24 bits signed integer
+    if (referenceTime & 0x800000)
+    {
+        referenceTime -= 0x1000000;
+    }
+
+    std::vector<uint8_t> symbols;
+    symbols.reserve(count);
+    uint32_t offset = 8;
+
+    while (symbols.size() < count)
+    {
+        if (offset + 2 > size)
+        {
+            return false;
+        }
+
+        uint16_t chunk = fci[offset] << 8 | fci[offset + 1];
+        offset += 2;
+
+        if ((chunk & 0x8000) == 0)
+        {
+            // run length chunk
+            uint8_t symbol = (chunk >> 13) & 0x03;
+
+            for (uint32_t i = 0; i < (chunk & 0x1FFFu) && symbols.size() < count; i++)
+            {
+                symbols.push_back(symbol);
+            }
+        }
+        else if ((chunk & 0x4000) == 0)
+        {
+            // status vector chunk of 14 one bit symbols
+            for (int32_t i = 13; i >= 0 && symbols.size() < count; i--)
+            {
+                symbols.push_back((chunk >> i) & 0x01);
+            }
+        }
+        else
+        {
+            // status vector chunk of 7 two bit symbols
+            for (int32_t i = 12; i >= 0 && symbols.size() < count; i -= 2)
+            {
+                symbols.push_back((chunk >> i) & 0x03);
+            }
+        }
+    }
+
+    result->feedbackCount = fci[7];
+    result->packets.clear();
+    result->packets.reserve(count);
+    int64_t timeUs = static_cast<int64_t>(referenceTime) * REFERENCE_TIME_UNIT * 1000;
+
+    for (uint32_t i = 0; i < count; i++)
+    {
+        TransportPacketResult packet = {static_cast<uint16_t>(baseSeqNum + i), false, 0, -1};
+
+        if (symbols[i] == STATUS_SMALL_DELTA)
+        {
+            if (offset + 1 > size)
+            {
+                return false;
+            }
+
+            timeUs += fci[offset++] * DELTA_UNIT_US;
+            packet.received = true;
+            packet.arrivalTimeUs = timeUs;
+        }
+        else if (symbols[i] == STATUS_LARGE_DELTA)
+        {
+            if (offset + 2 > size)
+            {
+                return false;
+            }
+
+            int16_t delta = static_cast<int16_t>(fci[offset] << 8 | fci[offset + 1]);
+            offset += 2;
+            timeUs += delta * DELTA_UNIT_US;
+            packet.received = true;
+            packet.arrivalTimeUs = timeUs;
+        }
+        else if (symbols[i] != STATUS_NOT_RECEIVED)
+        {
+            IMLOGE1("[Parse] reserved symbol at [%u]", i);
+            return false;
+        }
+
+        result->packets.push_back(packet);
+    }
+
+    return true;
+}
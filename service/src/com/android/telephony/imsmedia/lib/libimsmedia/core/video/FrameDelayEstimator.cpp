@@ -0,0 +1,248 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <FrameDelayEstimator.h>
+#include <ImsMediaTrace.h>
+#include <math.h>
+
+#define TRANSIT_WINDOW_SIZE      (60)     // frames, four seconds of 15 fps
+#define STARTUP_FRAME_NUM        (5)      // the frames of the frame size averaged all
+#define FRAME_SIZE_FACTOR        (0.97)   // per frame
+#define MAX_FRAME_SIZE_FACTOR    (0.9999)
+#define NOISE_FACTOR             (0.99)
+#define MIN_NOISE_VARIANCE       (1.0)
+#define NUM_STDDEV_SIZE_OUTLIER  (3.0)    // the key frame
+#define NUM_STDDEV_DELAY_OUTLIER (15.0)
+#define NUM_STDDEV_NOISE         (2.33)   // 99 percent of the noise
+#define INITIAL_CHANNEL_RATE     (64.0)   // bytes per millisecond, 512 kbps
+#define MIN_SLOPE                (1e-6)   // milliseconds per byte
+#define PROCESS_NOISE_SLOPE      (2.5e-10)
+#define PROCESS_NOISE_OFFSET     (1e-10)
+#define DECAY_RATE               (0.05)   // per frame
+#define MAX_FRAME_GAP            (90000)  // one second in 90 kHz
+
+FrameDelayEstimator::FrameDelayEstimator() :
+        mTransitTimes(TRANSIT_WINDOW_SIZE)
+{
+    mMinDelay = 0;
+    mMaxDelay = 0;
+    Reset();
+}
+
+FrameDelayEstimator::~FrameDelayEstimator() {}
+
+void FrameDelayEstimator::SetDelayRange(uint32_t minDelay, uint32_t maxDelay)
+{
+    mMinDelay = minDelay;
+    mMaxDelay = maxDelay < minDelay ? minDelay : maxDelay;
+    IMLOGD2("[SetDelayRange] min[%u], max[%u]", mMinDelay, mMaxDelay);
+}
+
+void FrameDelayEstimator::Reset()
+{
+    mNumFrames = 0;
+    mLastTimestamp = 0;
+    mLastArrivalTime = 0;
+    mLastFrameSize = 0;
+    mUnwrappedTimestamp = 0;
+    mTransitTimes.Reset();
+    mTheta[0] = 1 / INITIAL_CHANNEL_RATE;
+    mTheta[1] = 0;
+    mThetaCov[0][0] = 1e-4;
+    mThetaCov[0][1] = 0;
+    mThetaCov[1][0] = 0;
+    mThetaCov[1][1] = 1e2;
+    mAvgNoise = 0;
+    mVarNoise = 4;
+    mAvgFrameSize = 0;
+    mVarFrameSize = 100;
+    mMaxFrameSize = 0;
+    mTargetDelay = 0;
+}
+
+void FrameDelayEstimator::Update(uint32_t timestamp, uint32_t arrivalTime, uint32_t frameSize)
+{
+    int32_t timestampDiff = timestamp - mLastTimestamp;
+
+    // the frame reordered is older than the last one, its delay is counted in the next one
+    if (mNumFrames > 0 && timestampDiff <= 0)
+    {
+        return;
+    }
+
+    double frameDelay = static_cast<int32_t>(arrivalTime - mLastArrivalTime) -
+            static_cast<double>(timestampDiff) / 90;
+    double deltaSize = static_cast<double>(frameSize) - mLastFrameSize;
+    bool keyFrame = frameSize > mAvgFrameSize + NUM_STDDEV_SIZE_OUTLIER * sqrt(mVarFrameSize);
+
+    mUnwrappedTimestamp = mNumFrames == 0 ? timestamp : mUnwrappedTimestamp + timestampDiff;
+    mTransitTimes.Add(-static_cast<int32_t>(
+            arrivalTime - static_cast<uint32_t>(mUnwrappedTimestamp / 90)));
+    mLastTimestamp = timestamp;
+    mLastArrivalTime = arrivalTime;
+    mLastFrameSize = frameSize;
+    mNumFrames++;
+    UpdateFrameSize(frameSize);
+
+    // the delay across the gap of the frames is not the jitter
+    if (mNumFrames > 1 && timestampDiff <= MAX_FRAME_GAP)
+    {
+        double deviation = frameDelay - (mTheta[0] * deltaSize + mTheta[1]);
+        double maxDeviation = NUM_STDDEV_DELAY_OUTLIER * sqrt(mVarNoise);
+
+        if (fabs(deviation) < maxDeviation || keyFrame)
+        {
+            UpdateNoise(deviation);
+            UpdateKalman(frameDelay, deltaSize);
+        }
+        else
+        {
+            // the outlier moves the noise by the bound only, the slope is not changed
+            UpdateNoise(deviation > 0 ? maxDeviation : -maxDeviation);
+        }
+    }
+
+    double jitter = GetJitter();
+
+    if (mNumFrames == 1 || jitter > mTargetDelay)
+    {
+        mTargetDelay = jitter;
+    }
+    else
+    {
+        mTargetDelay += DECAY_RATE * (jitter - mTargetDelay);
+    }
+
+    IMLOGD_PACKET5(IM_PACKET_LOG_JITTER,
+            "[Update] TS[%u], delay[%.1lf], size[%u], jitter[%.1lf], target[%u]", timestamp,
+            frameDelay, frameSize, jitter, GetTargetDelay());
+}
+
+bool FrameDelayEstimator::IsReady()
+{
+    return mNumFrames > 0;
+}
+
+uint32_t FrameDelayEstimator::GetJitter()
+{
+    double jitter = mTheta[0] * (mMaxFrameSize - mAvgFrameSize) +
+            NUM_STDDEV_NOISE * sqrt(mVarNoise);
+    return jitter > 0 ? static_cast<uint32_t>(jitter + 0.5) : 0;
+}
+
+uint32_t FrameDelayEstimator::GetTargetDelay()
+{
+    uint32_t delay = static_cast<uint32_t>(mTargetDelay + 0.5);
+
+    if (delay < mMinDelay)
+    {
+        return mMinDelay;
+    }
+
+    return (mMaxDelay > 0 && delay > mMaxDelay) ? mMaxDelay : delay;
+}
+
+uint32_t FrameDelayEstimator::GetRenderTime(uint32_t timestamp)
+{
+    if (mNumFrames == 0)
+    {
+        return 0;
+    }
+
+    int64_t unwrapped = mUnwrappedTimestamp + static_cast<int32_t>(timestamp - mLastTimestamp);
+    return static_cast<uint32_t>(unwrapped / 90) - mTransitTimes.GetMax() + GetTargetDelay();
+}
+
+void FrameDelayEstimator::UpdateFrameSize(uint32_t frameSize)
+{
+    if (mNumFrames == 1)
+    {
+        mAvgFrameSize = frameSize;
+    }
+    else if (mNumFrames <= STARTUP_FRAME_NUM ||
+            frameSize <= mAvgFrameSize + NUM_STDDEV_SIZE_OUTLIER * sqrt(mVarFrameSize))
+    {
+        // the key frames are out of the average
+        double diff = frameSize - mAvgFrameSize;
+        mAvgFrameSize += (1 - FRAME_SIZE_FACTOR) * diff;
+        mVarFrameSize = FRAME_SIZE_FACTOR * mVarFrameSize + (1 - FRAME_SIZE_FACTOR) * diff * diff;
+    }
+
+    mMaxFrameSize = fmax(MAX_FRAME_SIZE_FACTOR * mMaxFrameSize, frameSize);
+}
+
+void FrameDelayEstimator::UpdateKalman(double frameDelay, double deltaSize)
+{
+    // prediction
+    mThetaCov[0][0] += PROCESS_NOISE_SLOPE;
+    mThetaCov[1][1] += PROCESS_NOISE_OFFSET;
+
+    // the measurement noise is larger for the small frames which carry less of the slope
+    double sigma = (300 * exp(-fabs(deltaSize) / fmax(mMaxFrameSize, 1)) + 1) * sqrt(mVarNoise);
+
+    if (sigma < 1)
+    {
+        sigma = 1;
+    }
+
+    double mh[2];
+    mh[0] = mThetaCov[0][0] * deltaSize + mThetaCov[0][1];
+    mh[1] = mThetaCov[1][0] * deltaSize + mThetaCov[1][1];
+    double hmh = deltaSize * mh[0] + mh[1] + sigma;
+
+    if (fabs(hmh) < 1e-9)
+    {
+        return;
+    }
+
+    double gain[2] = {mh[0] / hmh, mh[1] / hmh};
+    double residual = frameDelay - (mTheta[0] * deltaSize + mTheta[1]);
+    mTheta[0] += gain[0] * residual;
+    mTheta[1] += gain[1] * residual;
+
+    if (mTheta[0] < MIN_SLOPE)
+    {
+        mTheta[0] = MIN_SLOPE;
+    }
+
+    double cov00 = mThetaCov[0][0];
+    double cov01 = mThetaCov[0][1];
+    mThetaCov[0][0] = (1 - gain[0] * deltaSize) * cov00 - gain[0] * mThetaCov[1][0];
+    mThetaCov[0][1] = (1 - gain[0] * deltaSize) * cov01 - gain[0] * mThetaCov[1][1];
+    mThetaCov[1][0] = mThetaCov[1][0] * (1 - gain[1]) - gain[1] * deltaSize * cov00;
+    mThetaCov[1][1] = mThetaCov[1][1] * (1 - gain[1]) - gain[1] * deltaSize * cov01;
+}
+
+void FrameDelayEstimator::UpdateNoise(double residual)
+{
+    // the average of all the frames until the factor is reached
+    double alpha = 1 - 1.0 / mNumFrames;
+
+    if (alpha > NOISE_FACTOR)
+    {
+        alpha = NOISE_FACTOR;
+    }
+
+    mAvgNoise = alpha * mAvgNoise + (1 - alpha) * residual;
+    double diff = residual - mAvgNoise;
+    mVarNoise = alpha * mVarNoise + (1 - alpha) * diff * diff;
+
+    if (mVarNoise < MIN_NOISE_VARIANCE)
+    {
+        mVarNoise = MIN_NOISE_VARIANCE;
+    }
+}
@@ -0,0 +1,264 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <LostPacketTracker.h>
+#include <ImsMediaTrace.h>
+#include <algorithm>
+#include <string.h>
+
+// the number of the sequence numbers in a generic nack fci, the PID and 16 bits of the BLP
+#define NACK_FCI_RANGE 17
+
+LostPacketTracker::LostPacketTracker()
+{
+    Reset();
+}
+
+LostPacketTracker::~LostPacketTracker() {}
+
+void LostPacketTracker::Reset()
+{
+    mStarted = false;
+    mFirstSeq = 0;
+    mLastSeq = 0;
+    mNumLost = 0;
+    memset(mLostBits, 0, sizeof(mLostBits));
+    memset(mLostTime, 0, sizeof(mLostTime));
+    memset(mNackCount, 0, sizeof(mNackCount));
+}
+
+uint32_t LostPacketTracker::OnPacketReceived(uint16_t seq, uint32_t time)
+{
+    if (!mStarted)
+    {
+        mStarted = true;
+        mFirstSeq = seq + 1;
+        mLastSeq = seq;
+        return 0;
+    }
+
+    int32_t diff = SEQ_DIFF(seq, mLastSeq);
+
+    if (diff <= 0)
+    {
+        // the reordered or the retransmitted packet
+        if (TestBit(seq))
+        {
+            IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[OnPacketReceived] recovered seq[%u]", seq);
+            ClearBit(seq);
+        }
+
+        return 0;
+    }
+
+    if (diff > kMaxLossGap)
+    {
+        IMLOGD2("[OnPacketReceived] restart seq[%u -> %u]", mLastSeq, seq);
+        ClearRange(mFirstSeq, seq);
+        mFirstSeq = seq + 1;
+        mLastSeq = seq;
+        return 0;
+    }
+
+    // the oldest packets moving out of the window are not tracked any more
+    uint16_t windowStart = seq - kWindowSize + 1;
+
+    if (SEQ_DIFF(windowStart, mFirstSeq) > 0)
+    {
+        ClearRange(mFirstSeq, windowStart);
+        mFirstSeq = windowStart;
+    }
+
+    for (uint16_t lostSeq = mLastSeq + 1; lostSeq != seq; lostSeq++)
+    {
+        uint32_t index = GetIndex(lostSeq);
+        SetBit(lostSeq);
+        mLostTime[index] = time;
+        mNackCount[index] = 0;
+    }
+
+    IMLOGD_PACKET3(IM_PACKET_LOG_JITTER, "[OnPacketReceived] lost seq[%u ~ %u], count[%u]",
+            static_cast<uint16_t>(mLastSeq + 1), static_cast<uint16_t>(seq - 1), diff - 1);
+    mLastSeq = seq;
+    return diff - 1;
+}
+
+void LostPacketTracker::RemoveOlderThan(uint16_t seq)
+{
+    if (!mStarted || SEQ_DIFF(seq, mFirstSeq) <= 0)
+    {
+        return;
+    }
+
+    if (SEQ_DIFF(seq, mLastSeq) > 0)
+    {
+        seq = mLastSeq + 1;
+    }
+
+    ClearRange(mFirstSeq, seq);
+    mFirstSeq = seq;
+}
+
+bool LostPacketTracker::IsLost(uint16_t seq)
+{
+    return mStarted && TestBit(seq);
+}
+
+bool LostPacketTracker::IsRequested(uint16_t seq)
+{
+    return IsLost(seq) && mNackCount[GetIndex(seq)] > 0;
+}
+
+uint32_t LostPacketTracker::GetNackRequests(uint32_t time, uint32_t waitTime,
+        uint32_t retryInterval, std::vector<NackParams>* nacks, bool* pictureLost)
+{
+    nacks->clear();
+    *pictureLost = false;
+
+    if (mNumLost == 0)
+    {
+        return 0;
+    }
+
+    uint32_t numRequested = 0;
+    uint16_t seq = mFirstSeq;
+    int32_t remaining = SEQ_DIFF(mLastSeq, mFirstSeq);
+
+    // visits the lost packets only, skipping the words of the bitmap without the loss
+    while (remaining > 0)
+    {
+        uint32_t index = GetIndex(seq);
+        uint32_t offset = index & 63;
+        uint32_t span = std::min<int32_t>(64 - offset, remaining);
+        uint64_t bits = mLostBits[index >> 6] >> offset;
+
+        if (span < 64)
+        {
+            bits &= (1ULL << span) - 1;
+        }
+
+        if (bits == 0)
+        {
+            seq += span;
+            remaining -= span;
+            continue;
+        }
+
+        uint32_t skip = __builtin_ctzll(bits);
+        seq += skip;
+        remaining -= skip;
+        index = GetIndex(seq);
+
+        uint32_t elapsed = time - mLostTime[index];
+
+        if (elapsed >= (mNackCount[index] == 0 ? waitTime : retryInterval))
+        {
+            if (mNackCount[index] < kMaxNackCount)
+            {
+                mNackCount[index]++;
+                mLostTime[index] = time;
+                numRequested++;
+
+                int32_t distance = nacks->empty() ? 0 : SEQ_DIFF(seq, nacks->back().PID);
+
+                if (distance > 0 && distance < NACK_FCI_RANGE)
+                {
+                    nacks->back().BLP |= 1 << (distance - 1);
+                }
+                else
+                {
+                    nacks->push_back(NackParams(seq, 0, 0, true));
+                }
+
+                if (mNackCount[index] > 1)
+                {
+                    nacks->back().nSecNackCnt++;
+                }
+            }
+            else if (mNackCount[index] == kMaxNackCount)
+            {
+                // not recovered by the retransmission, the picture loss is requested once
+                IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[GetNackRequests] picture lost seq[%u]", seq);
+                mNackCount[index]++;
+                *pictureLost = true;
+            }
+        }
+
+        seq++;
+        remaining--;
+    }
+
+    return numRequested;
+}
+
+bool LostPacketTracker::TestBit(uint16_t seq)
+{
+    // only the sequence numbers in the window can be lost
+    if (SEQ_DIFF(seq, mFirstSeq) < 0 || SEQ_DIFF(seq, mLastSeq) >= 0)
+    {
+        return false;
+    }
+
+    uint32_t index = GetIndex(seq);
+    return (mLostBits[index >> 6] >> (index & 63)) & 1;
+}
+
+void LostPacketTracker::SetBit(uint16_t seq)
+{
+    uint32_t index = GetIndex(seq);
+    uint64_t mask = 1ULL << (index & 63);
+
+    if ((mLostBits[index >> 6] & mask) == 0)
+    {
+        mLostBits[index >> 6] |= mask;
+        mNumLost++;
+    }
+}
+
+void LostPacketTracker::ClearBit(uint16_t seq)
+{
+    uint32_t index = GetIndex(seq);
+    uint64_t mask = 1ULL << (index & 63);
+
+    if (mLostBits[index >> 6] & mask)
+    {
+        mLostBits[index >> 6] &= ~mask;
+        mNumLost--;
+    }
+}
+
+void LostPacketTracker::ClearRange(uint16_t from, uint16_t to)
+{
+    if (mNumLost == 0)
+    {
+        return;
+    }
+
+    uint32_t count = static_cast<uint16_t>(to - from);
+
+    if (count >= kWindowSize)
+    {
+        memset(mLostBits, 0, sizeof(mLostBits));
+        mNumLost = 0;
+        return;
+    }
+
+    for (uint16_t seq = from; seq != to && mNumLost > 0; seq++)
+    {
+        ClearBit(seq);
+    }
+}
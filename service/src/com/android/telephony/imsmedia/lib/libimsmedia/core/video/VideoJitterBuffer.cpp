@@ -20,15 +20,13 @@
 #include <ImsMediaTrace.h>
 #include <ImsMediaVideoUtil.h>
 #include <ImsMediaTimer.h>
+#include <vector>
 
 #define DEFAULT_MAX_SAVE_FRAME_NUM          (5)
 #define DEFAULT_IDR_FRAME_CHECK_INTRERVAL   (3)
 #define DEFAULT_VIDEO_JITTER_IDR_WAIT_DELAY (200)
-#define RTCPNACK_SEQ_INCREASE(seq)          ((seq) == 0xffff ? 0 : (seq) + 1)
-#define RTCPNACK_SEQ_ROUND_COMPARE(a, b)    (((a) > (b)) && ((a) > 0xfff0) && ((b) < 0x000f))
 #define DEFAULT_PACKET_LOSS_MONITORING_TIME (5)     // sec
-#define PACKET_LOSS_RATIO                   (2)     // percentage
-#define BITRATE_ADAPTIVE_RATIO              (0.1f)  // ratio
+#define MIN_ADAPTIVE_BITRATE                (64000)  // bps
 
 VideoJitterBuffer::VideoJitterBuffer() :
         BaseJitterBuffer()
@@ -48,8 +46,10 @@ VideoJitterBuffer::VideoJitterBuffer() :
     mMaxSaveFrameNum = DEFAULT_MAX_SAVE_FRAME_NUM;
     mSavedFrameNum = 0;
     mMarkedFrameNum = 0;
-    InitLostPktList();
+    mSavedIdrFrameNum = 0;
+    mLastIdrTimestamp = 0;
     mResponseWaitTime = 0;
+    mRoundTripTime = 0;
     mLastPlayedTime = 0;
     mNumAddedPacket = 0;
     mNumLossPacket = 0;
@@ -59,17 +59,18 @@ VideoJitterBuffer::VideoJitterBuffer() :
     mIDRCheckCnt = DEFAULT_IDR_FRAME_CHECK_INTRERVAL;
     mFirTimeStamp = 0;
     mMaxBitrate = 0;
+    mRequestedBitrate = 0;
     mIncomingBitrate = 0;
     mLossDuration = DEFAULT_PACKET_LOSS_MONITORING_TIME;
     mLossRateThreshold = 0;
     mCountTimerExpired = 0;
     mTimer = nullptr;
+    mUnwrappedTimestamp = -1;
+    mLastEstimatedTimestamp = 0;
 }
 
 VideoJitterBuffer::~VideoJitterBuffer()
 {
-    InitLostPktList();
-
     if (mTimer != nullptr)
     {
         IMLOGD0("[~VideoJitterBuffer] stop timer");
@@ -84,6 +85,8 @@ void VideoJitterBuffer::SetJitterBufferSize(uint32_t nInit, uint32_t nMin, uint3
     mMaxSaveFrameNum = mMaxJitterBufferSize * 20 / mFrameInterval;
     mIDRCheckCnt = DEFAULT_VIDEO_JITTER_IDR_WAIT_DELAY / mFrameInterval;
     mFirTimeStamp = 0;
+    // the half of the frames saved are played out in time as the legacy pacing does
+    mFrameDelay.SetDelayRange(mFrameInterval, mMaxSaveFrameNum * mFrameInterval / 2);
     IMLOGD2("[SetJitterBufferSize] maxSaveFrameNum[%u], IDRCheckCnt[%d]", mMaxSaveFrameNum,
             mIDRCheckCnt);
 }
@@ -100,25 +103,6 @@ void VideoJitterBuffer::SetFramerate(uint32_t framerate)
     IMLOGD2("[SetFramerate] framerate[%u], frameInterval[%d]", mFramerate, mFrameInterval);
 }
 
-void VideoJitterBuffer::InitLostPktList()
-{
-    IMLOGD0("[InitLostPktList]");
-
-    while (!mLostPktList.empty())
-    {
-        LostPacket* entry = mLostPktList.front();
-
-        if (entry != nullptr)
-        {
-            delete entry;
-        }
-
-        mLostPktList.pop_front();
-    }
-
-    mLostPktList.clear();
-}
-
 void VideoJitterBuffer::Reset()
 {
     BaseJitterBuffer::Reset();
@@ -131,8 +115,17 @@ void VideoJitterBuffer::Reset()
     mLastPlayedTimestamp = 0;
     mLastAddedTimestamp = 0;
     mLastAddedSeqNum = 0;
-    InitLostPktList();
+    mLostPackets.Reset();
     mResponseWaitTime = 0;
+    mRequestedBitrate = 0;
+    mUnwrappedTimestamp = -1;
+    mBandwidthEstimator.Reset();
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    mRingQueue.Clear();
+    mFrames.clear();
+    mSavedIdrFrameNum = 0;
+    mFrameDelay.Reset();
 }
 
 void VideoJitterBuffer::StartTimer(uint32_t time, uint32_t rate)
@@ -167,6 +160,14 @@ void VideoJitterBuffer::SetResponseWaitTime(const uint32_t time)
     mResponseWaitTime = time;
 }
 
+void VideoJitterBuffer::SetRoundTripTime(const uint32_t rtt)
+{
+    IMLOGD1("[SetRoundTripTime] rtt[%u]", rtt);
+    std::lock_guard<std::mutex> guard(mMutex);
+    mRoundTripTime = rtt;
+    mBandwidthEstimator.SetRoundTripTime(rtt);
+}
+
 void VideoJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t nBufferSize,
         uint32_t nTimestamp, bool bMark, uint32_t nSeqNum, ImsMediaSubType eDataType,
         uint32_t arrivalTime)
@@ -215,93 +216,64 @@ void VideoJitterBuffer::Add(ImsMediaSubType subtype, uint8_t* pbBuffer, uint32_t
     {
         IMLOGE2("[Add] Receive very old frame!!! Drop Packet. Seq[%u], LastPlayedSeqNum[%u]",
                 nSeqNum, mLastPlayedSeqNum);
+        return;
     }
-    else if (mDataQueue.GetCount() == 0)
-    {  // jitter buffer is empty
-        mDataQueue.Add(&currEntry);
-        mNumAddedPacket++;
-        mAccumulatedPacketSize += nBufferSize;
-        IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
-                "[Add] queue[%u] Seq[%u], LastPlayedSeqNum[%u], LastAddedTimestamp[%u]",
-                mDataQueue.GetCount(), nSeqNum, mLastPlayedSeqNum, mLastAddedTimestamp);
-        mLastAddedTimestamp = nTimestamp;
-        mLastAddedSeqNum = nSeqNum;
+
+    DataEntry* pEntry = nullptr;
+
+    if (mRingQueue.Find(nSeqNum, nTimestamp, &pEntry) && nBufferSize == pEntry->nBufferSize)
+    {
+        IMLOGD1("[Add] drop duplicate Seq[%u]", nSeqNum);
+        return;
     }
-    else
+
+    // the oldest packets are removed by the jump of the sequence number
+    while (mRingQueue.Get(&pEntry) &&
+            SEQ_DIFF(nSeqNum, pEntry->nSeqNum) >= JitterRingQueue::kMaxCapacity)
     {
-        DataEntry* pEntry;
-        mDataQueue.GetLast(&pEntry);
+        DeleteFirst();
+    }
 
-        if (pEntry == nullptr)
-        {
-            return;
-        }
+    bool newSeq = !mRingQueue.Contains(nSeqNum);
 
-        if (USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
-        {
-            // current data is the latest data
-            if (nSeqNum == pEntry->nSeqNum && nBufferSize == pEntry->nBufferSize)
-            {
-                IMLOGD1("[Add] drop duplicate Seq[%u]", nSeqNum);
-                return;
-            }
+    // the marker of the older packet of the frame than the one received is not the end
+    if (bMark && eDataType != MEDIASUBTYPE_VIDEO_CONFIGSTRING)
+    {
+        auto frame = mFrames.find(nTimestamp);
 
-            mDataQueue.Add(&currEntry);
-            mNumAddedPacket++;
-            mAccumulatedPacketSize += nBufferSize;
-            IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
-                    "[Add] queue[%u] Seq[%u], LastPlayedSeqNum[%u], LastAddedTimestamp[%u]",
-                    mDataQueue.GetCount(), nSeqNum, mLastPlayedSeqNum, mLastAddedTimestamp);
-        }
-        else
+        if (frame != mFrames.end() && frame->second.marker &&
+                SEQ_DIFF(nSeqNum, frame->second.markerSeq) < 0)
         {
-            // find the position of current data and insert current data to the correct position
-            uint32_t i;
-            mDataQueue.SetReadPosFirst();
-
-            for (i = 0; mDataQueue.GetNext(&pEntry); i++)
-            {
-                if (nSeqNum == pEntry->nSeqNum && nBufferSize == pEntry->nBufferSize)
-                {
-                    IMLOGD1("[Add] drop duplicate Seq[%u]", nSeqNum);
-                    return;
-                }
-
-                if (!USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
-                {
-                    mDataQueue.InsertAt(i, &currEntry);
-                    break;
-                }
-            }
+            currEntry.bMark = false;
         }
+    }
 
-        // Remove mark of packets with same Timestamp and less SeqNum
-        mDataQueue.SetReadPosFirst();
+    if (!mRingQueue.Insert(&currEntry))
+    {
+        return;
+    }
 
-        while (mDataQueue.GetNext(&pEntry))
-        {
-            if (pEntry->nSeqNum != nSeqNum && pEntry->nTimestamp == nTimestamp &&
-                    pEntry->bMark == true && pEntry->eDataType != MEDIASUBTYPE_VIDEO_CONFIGSTRING &&
-                    USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
-            {
-                IMLOGD_PACKET6(IM_PACKET_LOG_JITTER,
-                        "[Add] Remove marker of Seq/TS/Mark[%u/%u/%u], pEntry "
-                        "Seq/TS/Mark[%u/%u/%u]",
-                        pEntry->nSeqNum, pEntry->nTimestamp, pEntry->bMark, currEntry.nSeqNum,
-                        currEntry.nTimestamp, currEntry.bMark);
-                pEntry->bMark = false;
-                continue;
-            }
-            else if (!USHORT_SEQ_ROUND_COMPARE(nSeqNum, pEntry->nSeqNum))
-            {
-                break;
-            }
-        }
+    mNumAddedPacket++;
+    mAccumulatedPacketSize += nBufferSize;
+    AddToFrame(&currEntry, newSeq);
 
-        mLastAddedTimestamp = nTimestamp;
-        mLastAddedSeqNum = nSeqNum;
+    // the retransmission is delayed by the request, not by the queue of the path
+    if (newSeq && !mLostPackets.IsRequested(nSeqNum))
+    {
+        CheckDelayGradient(nTimestamp, arrivalTime);
     }
 
+    if (mResponseWaitTime > 0)
+    {
+        CheckPacketLoss(nSeqNum,
+                arrivalTime != 0 ? arrivalTime : ImsMediaTimer::GetTimeInMilliSeconds());
+    }
+
+    IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
+            "[Add] queue[%u] Seq[%u], LastPlayedSeqNum[%u], LastAddedTimestamp[%u]",
+            mRingQueue.GetCount(), nSeqNum, mLastPlayedSeqNum, mLastAddedTimestamp);
+    mLastAddedTimestamp = nTimestamp;
+    mLastAddedSeqNum = nSeqNum;
     mNewInputData = true;
 }
 
@@ -312,186 +284,56 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
     bool bValidPacket = false;
     std::lock_guard<std::mutex> guard(mMutex);
 
-    // check validation
+    // the frames are validated when the packets are added
     if (mNewInputData)
     {
-        mSavedFrameNum = 0;
-        mMarkedFrameNum = 0;
-        bool bFoundHeader = false;
-        uint16_t nLastRecvSeq = 0;  // for NACK generation
-        mDataQueue.SetReadPosFirst();
-
-        uint32_t nIndex = 0;
-        uint32_t nHeaderIndex = 0;
-        uint16_t nHeaderSeq = 0;
-        uint32_t nHeaderTimestamp = 0;
-        uint32_t nLastTimeStamp = 0;
-        uint32_t nSavedIdrFrame = 0;
-        for (nIndex = 0; mDataQueue.GetNext(&pEntry); nIndex++)
+        // request the IDR frame again when it is not complete until the next ones arrive
+        if (mSavedIdrFrameNum == mIDRCheckCnt)
         {
-            IMLOGD_PACKET8(IM_PACKET_LOG_JITTER,
-                    "[Get] queue[%u/%u] bValid[%u], Seq[%u], Mark[%u], Header[%u], TS[%u], "
-                    "Size[%u]",
-                    nIndex, mDataQueue.GetCount(), pEntry->bValid, pEntry->nSeqNum, pEntry->bMark,
-                    pEntry->bHeader, pEntry->nTimestamp, pEntry->nBufferSize);
-
-            if (mResponseWaitTime > 0 && nLastTimeStamp != 0)
-            {
-                CheckPacketLoss(pEntry->nSeqNum, nLastRecvSeq);
-            }
-
-            nLastRecvSeq = pEntry->nSeqNum;
-
-            if (pEntry->nTimestamp != nLastTimeStamp || nLastTimeStamp == 0)
-            {
-                if (pEntry->eDataType != MEDIASUBTYPE_VIDEO_CONFIGSTRING)
-                {
-                    if (pEntry->eDataType == MEDIASUBTYPE_VIDEO_IDR_FRAME)
-                    {
-                        nSavedIdrFrame++;
-                    }
-
-                    mSavedFrameNum++;
-                    nLastTimeStamp = pEntry->nTimestamp;
-                }
-            }
-
-            if (pEntry->bMark)
-            {
-                mMarkedFrameNum++;
-            }
-
-            if (nSavedIdrFrame == mIDRCheckCnt && pEntry->eDataType == MEDIASUBTYPE_VIDEO_IDR_FRAME)
-            {
-                /** TODO: improve this logic later */
-                CheckValidIDR(pEntry);
-            }
-
-            IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
-                    "[Get] SavedFrameNum[%u], mMarkedFrameNum[%u], nLastTimeStamp[%u]",
-                    mSavedFrameNum, mMarkedFrameNum, nLastTimeStamp);
-
-            if (pEntry->bHeader)
-            {
-                if (pEntry->bMark)
-                {
-                    pEntry->bValid = true;
-
-                    if (pEntry->nTimestamp > nHeaderTimestamp)
-                    {
-                        bFoundHeader = false;  // make Header false only for new frame
-                    }
-                }
-                else
-                {
-                    // Check Header with new timestamp. Otherwise(duplicated header with
-                    // same timestamp), do not update Header Information
-                    if (bFoundHeader == false || pEntry->nTimestamp < nHeaderTimestamp ||
-                            nHeaderTimestamp == 0)
-                    {
-                        nHeaderTimestamp = pEntry->nTimestamp;
-                        nHeaderIndex = nIndex;
-                        nHeaderSeq = pEntry->nSeqNum;
-                        bFoundHeader = true;
-
-                        IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
-                                "[Get] New Header Found at [%u] - Seq[%u], Timestamp[%u]",
-                                nHeaderIndex, nHeaderSeq, nHeaderTimestamp);
-                    }
-                }
-            }
-
-            if (bFoundHeader)
-            {
-                IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
-                        "[Get] bFoundHeader[%u] - Check Valid of Seq[%u ~ %u], "
-                        "nHeaderTimestamp[%u]",
-                        bFoundHeader, nHeaderSeq, pEntry->nSeqNum, nHeaderTimestamp);
-
-                if (pEntry->bMark)
-                {
-                    uint32_t nMarkIndex = nIndex;
-                    uint16_t nMarkSeq = pEntry->nSeqNum;
-
-                    // make sure type of 16bit unsigned int sequence number
-                    if (nMarkIndex - nHeaderIndex == nMarkSeq - nHeaderSeq)
-                    {
-                        uint32_t i;
-
-                        for (i = nHeaderIndex; i <= nMarkIndex; i++)
-                        {
-                            DataEntry* pValidEntry;
-                            mDataQueue.GetAt(i, &pValidEntry);
-
-                            if (pValidEntry == nullptr)
-                            {
-                                return false;
-                            }
-
-                            pValidEntry->bValid = true;
-
-                            IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
-                                    "[Get] Validation Check for Seq[%u] true :: nHeaderIndex[%u] "
-                                    "to nMarkIndex[%u]",
-                                    pValidEntry->nSeqNum, nHeaderIndex, nMarkIndex);
-                        }
-                    }
-
-                    bFoundHeader = false;
-                }
-            }
+            CheckValidIDR(mLastIdrTimestamp);
         }
 
+        IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
+                "[Get] SavedFrameNum[%u], MarkedFrameNum[%u], queue[%u]", mSavedFrameNum,
+                mMarkedFrameNum, mRingQueue.GetCount());
+
         if (mSavedFrameNum > mMaxSaveFrameNum)
         {
             IMLOGD_PACKET2(IM_PACKET_LOG_JITTER,
                     "[Get] Delete - SavedFrameNum[%u], nMaxFrameNum[%u]", mSavedFrameNum,
                     mMaxSaveFrameNum);
 
-            mDataQueue.Get(&pEntry);
-
-            if (pEntry == nullptr)
+            if (!mRingQueue.Get(&pEntry))
+            {
                 return false;
+            }
 
-            if (pEntry->bValid == false)
+            if (!IsValid(pEntry))
             {
                 uint32_t nDeleteTimeStamp = pEntry->nTimestamp;
                 uint32_t nDeleteSeqNum = pEntry->nSeqNum;
 
-                while (nDeleteTimeStamp == pEntry->nTimestamp)
+                while (mRingQueue.Get(&pEntry) && nDeleteTimeStamp == pEntry->nTimestamp)
                 {
                     IMLOGD_PACKET7(IM_PACKET_LOG_JITTER,
                             "[Get] Delete - Seq[%u], Count[%u], bValid[%u], eDataType[%u], "
                             "bHeader[%u], TimeStamp[%u], Size[%u]",
-                            pEntry->nSeqNum, mDataQueue.GetCount(), pEntry->bValid,
+                            pEntry->nSeqNum, mRingQueue.GetCount(), pEntry->bValid,
                             pEntry->eDataType, pEntry->bHeader, pEntry->nTimestamp,
                             pEntry->nBufferSize);
 
                     nDeleteSeqNum = pEntry->nSeqNum;
-                    mDataQueue.Delete();
-                    mDataQueue.Get(&pEntry);  // next packet
-
-                    if (pEntry == nullptr)
-                    {
-                        break;
-                    }
+                    DeleteFirst();
                 }
 
-                mSavedFrameNum--;
-
                 // remove the packets from NACK / PLI checkList
-                if (mLostPktList.size() > 0)
-                {
-                    RemovePacketFromLostList(nDeleteSeqNum, true);
-                }
+                mLostPackets.RemoveOlderThan(nDeleteSeqNum);
             }
         }
 
         if (mSavedFrameNum >= mMaxSaveFrameNum)
         {
-            mDataQueue.Get(&pEntry);
-
-            if (pEntry == nullptr)
+            if (!mRingQueue.Get(&pEntry))
             {
                 return false;
             }
@@ -502,8 +344,11 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
         mNewInputData = false;
     }
 
-    if (mSavedFrameNum >= (mMaxSaveFrameNum / 2) && mDataQueue.Get(&pEntry) == true &&
-            pEntry->bValid && (mLastPlayedSeqNum == 0 || pEntry->nSeqNum <= mLastPlayedSeqNum + 1))
+    // the frames are paced by the render time when the arrival time of the packets is known,
+    // otherwise by the number of the frames saved
+    if ((mFrameDelay.IsReady() || mSavedFrameNum >= (mMaxSaveFrameNum / 2)) &&
+            mRingQueue.Get(&pEntry) && IsValid(pEntry) &&
+            (mLastPlayedSeqNum == 0 || pEntry->nSeqNum <= mLastPlayedSeqNum + 1))
     {
         IMLOGD_PACKET4(IM_PACKET_LOG_JITTER,
                 "[Get] bValid[%u], LastPlayedTS[%u], Seq[%u], LastPlayedSeq[%u]", pEntry->bValid,
@@ -516,6 +361,18 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
         {
             bValidPacket = true;
         }
+        else if (mFrameDelay.IsReady())
+        {
+            // decoded a frame interval before the render time, the frames over the maximum
+            // are played at once to catch up
+            int32_t timeToRender =
+                    mFrameDelay.GetRenderTime(pEntry->nTimestamp) - mFrameInterval - nCurrTime;
+            bValidPacket = timeToRender <= 0 || mSavedFrameNum >= mMaxSaveFrameNum;
+
+            IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
+                    "[Get] TS[%u], timeToRender[%d], targetDelay[%u]", pEntry->nTimestamp,
+                    timeToRender, mFrameDelay.GetTargetDelay());
+        }
         else
         {
             uint32_t nTimeDiff = nCurrTime - mLastPlayedTime;
@@ -589,7 +446,7 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
                 "[Get] Seq[%u], Mark[%u], TS[%u], Size[%u], SavedFrame[%u], MarkedFrame[%u], "
                 "queue[%u]",
                 pEntry->nSeqNum, pEntry->bMark, pEntry->nTimestamp, pEntry->nBufferSize,
-                mSavedFrameNum, mMarkedFrameNum, mDataQueue.GetCount());
+                mSavedFrameNum, mMarkedFrameNum, mRingQueue.GetCount());
         return true;
     }
     else
@@ -608,288 +465,259 @@ bool VideoJitterBuffer::Get(ImsMediaSubType* subtype, uint8_t** ppData, uint32_t
             *pnSeqNum = 0;
         IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
                 "[Get] false - SavedFrame[%u], MarkedFrame[%u], queue[%u]", mSavedFrameNum,
-                mMarkedFrameNum, mDataQueue.GetCount());
+                mMarkedFrameNum, mRingQueue.GetCount());
         return false;
     }
 }
 
-void VideoJitterBuffer::CheckValidIDR(DataEntry* pIDREntry)
+uint32_t VideoJitterBuffer::GetRenderTime(uint32_t timestamp)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    return mFrameDelay.GetRenderTime(timestamp);
+}
+
+void VideoJitterBuffer::CheckValidIDR(uint32_t timestamp)
 {
-    if (pIDREntry == nullptr)
+    auto frame = mFrames.find(timestamp);
+
+    if (frame == mFrames.end() || frame->second.complete)
     {
         return;
     }
 
-    if (pIDREntry->bValid == false)
-    {
-        IMLOGD2("[CheckValidIDR] mFirTimeStamp[%u] -> nTimestamp[%u]", mFirTimeStamp,
-                pIDREntry->nTimestamp);
+    IMLOGD2("[CheckValidIDR] mFirTimeStamp[%u] -> nTimestamp[%u]", mFirTimeStamp, timestamp);
 
-        if (pIDREntry->nTimestamp == mFirTimeStamp)
-        {
-            return;
-        }
-
-        RequestToSendPictureLost(kPsfbFir);
-        mFirTimeStamp = pIDREntry->nTimestamp;
+    if (timestamp == mFirTimeStamp)
+    {
         return;
     }
+
+    RequestToSendPictureLost(kPsfbFir);
+    mFirTimeStamp = timestamp;
 }
 
 void VideoJitterBuffer::Delete()
 {
     DataEntry* pEntry;
     std::lock_guard<std::mutex> guard(mMutex);
-    mDataQueue.Get(&pEntry);
 
-    if (pEntry == nullptr)
+    if (!mRingQueue.Get(&pEntry))
     {
         return;
     }
 
     IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[Delete] Seq[%u] / BufferCount[%u]", pEntry->nSeqNum,
-            mDataQueue.GetCount());
+            mRingQueue.GetCount());
     mLastPlayedSeqNum = pEntry->nSeqNum;
-    mDataQueue.Delete();
+    DeleteFirst();
     mNewInputData = true;
-
-    if (mLostPktList.size() > 0)
-    {
-        RemovePacketFromLostList(mLastPlayedSeqNum, true);
-    }
+    mLostPackets.RemoveOlderThan(mLastPlayedSeqNum);
 }
 
 uint32_t VideoJitterBuffer::GetCount()
 {
-    return mDataQueue.GetCount();
+    return mRingQueue.GetCount();
 }
 
-bool VideoJitterBuffer::CheckHeader(uint8_t* pbBuffer)
+void VideoJitterBuffer::AddToFrame(DataEntry* entry, bool newSeq)
 {
-    if (pbBuffer == nullptr)
+    if (entry->eDataType == MEDIASUBTYPE_VIDEO_CONFIGSTRING)
     {
-        return false;
+        // the config string is played by itself
+        if (entry->bMark)
+        {
+            mMarkedFrameNum++;
+        }
+
+        return;
     }
 
-    // check start code
-    if ((pbBuffer[0] == 0x00 && pbBuffer[1] == 0x00 && pbBuffer[2] == 0x00) ||
-            (pbBuffer[0] == 0x00 && pbBuffer[1] == 0x00 && pbBuffer[2] == 0x01))
+    auto result = mFrames.emplace(entry->nTimestamp, FrameState());
+    FrameState& frame = result.first->second;
+    uint16_t seq = entry->nSeqNum;
+
+    if (result.second)
     {
-        return true;
+        frame.firstSeq = seq;
+        frame.lastSeq = seq;
+        mSavedFrameNum++;
     }
-    else
+    else if (SEQ_DIFF(seq, frame.firstSeq) < 0)
     {
-        return false;
+        frame.firstSeq = seq;
     }
-}
-
-void VideoJitterBuffer::RemovePacketFromLostList(uint16_t seqNum, bool bRemoveOldPacket)
-{
-    LostPacket* pEntry = nullptr;
-    std::list<LostPacket*>::iterator it = mLostPktList.begin();
-
-    while (it != mLostPktList.end())
+    else if (SEQ_DIFF(seq, frame.lastSeq) > 0)
     {
-        pEntry = *it;
-
-        if (pEntry == nullptr)
-        {
-            mLostPktList.erase(it++);
-            continue;
-        }
-
-        if (bRemoveOldPacket && pEntry->seqNum < seqNum)
-        {
-            IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
-                    "[RemovePacketFromLostList] delete lost seq[%u], target seq[%u], "
-                    "bRemoveOldPacket[%u]",
-                    pEntry->seqNum, seqNum, bRemoveOldPacket);
+        frame.lastSeq = seq;
+    }
 
-            it = mLostPktList.erase(it);
-            delete pEntry;
-        }
-        else if (pEntry->seqNum == seqNum)
-        {
-            IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[RemovePacketFromLostList] remove lost seq[%u]",
-                    pEntry->seqNum);
+    frame.numPackets++;
+    frame.size += entry->nBufferSize;
+    frame.arrivalTime = entry->arrivalTime;
 
-            it = mLostPktList.erase(it);
-            delete pEntry;
-        }
-        else
-        {
-            it++;
-        }
+    if (newSeq)
+    {
+        frame.numReceived++;
     }
-}
 
-void VideoJitterBuffer::CheckPacketLoss(uint16_t seqNum, uint16_t nLastRecvPkt)
-{
-    if (mLostPktList.size() > 0)
+    if (entry->eDataType == MEDIASUBTYPE_VIDEO_IDR_FRAME && !frame.idr)
     {
-        RemovePacketFromLostList(seqNum);
+        frame.idr = true;
+        mSavedIdrFrameNum++;
+        mLastIdrTimestamp = entry->nTimestamp;
     }
 
-    // normal case : no packet loss
-    if (RTCPNACK_SEQ_INCREASE(nLastRecvPkt) == seqNum)
+    // the oldest header of the frame is the start of the frame
+    if (entry->bHeader && (!frame.header || SEQ_DIFF(seq, frame.headerSeq) < 0))
     {
-        return;
+        frame.header = true;
+        frame.headerSeq = seq;
     }
 
-    if (nLastRecvPkt == seqNum)
+    // the newer packet of the frame than the marker takes the marker away
+    if (frame.marker && SEQ_DIFF(seq, frame.markerSeq) > 0)
     {
-        return;  // same packet should be removed in STAP-A type case.
-    }
+        DataEntry* marked = nullptr;
 
-    // the first lost packet.
-    uint16_t PID = RTCPNACK_SEQ_INCREASE(nLastRecvPkt);
+        if (mRingQueue.Find(frame.markerSeq, entry->nTimestamp, &marked) && marked->bMark)
+        {
+            IMLOGD_PACKET3(IM_PACKET_LOG_JITTER,
+                    "[AddToFrame] Remove marker of Seq[%u] by Seq[%u], TS[%u]", marked->nSeqNum,
+                    seq, entry->nTimestamp);
+            marked->bMark = false;
+            mMarkedFrameNum--;
+        }
 
-    // the number of lost packets
-    uint16_t nLossGap = RTCPNACK_SEQ_ROUND_COMPARE(nLastRecvPkt, seqNum)
-            ? ((0xffff - nLastRecvPkt) + seqNum)
-            : (seqNum - PID);
+        frame.marker = false;
+    }
 
-    if (nLossGap > 0x000f)
+    if (entry->bMark)
     {
-        nLossGap = 0x000f;
+        frame.marker = true;
+        frame.markerSeq = seq;
+        mMarkedFrameNum++;
     }
 
-    uint16_t countNackPacketNum = 0;
-    uint16_t countSecondNack = 0;
-    uint16_t nPLIPkt = 0;
-    bool bPLIPkt = false;
-    bool bSentPLI = false;
+    bool completed = frame.complete;
+    frame.complete = frame.header && frame.marker && frame.headerSeq == frame.firstSeq &&
+            frame.markerSeq == frame.lastSeq &&
+            frame.numReceived == static_cast<uint16_t>(frame.lastSeq - frame.firstSeq) + 1u;
 
-    for (int32_t index = 0; index < nLossGap; index++)
+    // the frame delay is measured when the last packet of the frame arrives
+    if (!completed && frame.complete && frame.arrivalTime != 0)
     {
-        if (UpdateLostPacketList(PID + index, &countSecondNack, &nPLIPkt, &bPLIPkt))
-        {
-            countNackPacketNum++;
-        }
-
-        // request PLI Message
-        if (bPLIPkt && !bSentPLI)
-        {
-            IMLOGD1("[CheckPacketLoss] nPLI pkt[%u]", nPLIPkt);
-            RequestToSendPictureLost(kPsfbPli);
-            bSentPLI = true;
-        }
+        mFrameDelay.Update(entry->nTimestamp, frame.arrivalTime, frame.size);
     }
 
-    if (nPLIPkt > PID)
-    {
-        PID = nPLIPkt + 1;
-    }
+    IMLOGD_PACKET6(IM_PACKET_LOG_JITTER,
+            "[AddToFrame] TS[%u], Seq[%u ~ %u], received[%u], idr[%u], complete[%u]",
+            entry->nTimestamp, frame.firstSeq, frame.lastSeq, frame.numReceived, frame.idr,
+            frame.complete);
+}
+
+void VideoJitterBuffer::DeleteFirst()
+{
+    DataEntry* entry = nullptr;
 
-    // return if PID is same as the current seq.
-    if (PID == seqNum)
+    if (!mRingQueue.Get(&entry))
     {
         return;
     }
 
-    // request NACK Message
-    if (countNackPacketNum > 0)
+    if (entry->bMark && mMarkedFrameNum > 0)
     {
-        RequestSendNack(countNackPacketNum, PID, countSecondNack);
+        mMarkedFrameNum--;
     }
-}
 
-bool VideoJitterBuffer::UpdateLostPacketList(
-        uint16_t lostSeq, uint16_t* countSecondNack, uint16_t* nPLIPkt, bool* bPLIPkt)
-{
-    LostPacket* foundLostPacket = nullptr;
-    auto result = std::find_if(mLostPktList.begin(), mLostPktList.end(),
-            [lostSeq, &foundLostPacket](LostPacket* entry)
+    if (entry->eDataType != MEDIASUBTYPE_VIDEO_CONFIGSTRING)
+    {
+        auto frame = mFrames.find(entry->nTimestamp);
+
+        if (frame != mFrames.end() && --frame->second.numPackets == 0)
+        {
+            if (frame->second.idr)
             {
-                foundLostPacket = entry;
-                return (entry->seqNum == lostSeq);
-            });
+                mSavedIdrFrameNum--;
+            }
 
-    if (result != mLostPktList.end() && foundLostPacket != nullptr)
-    {
-        return UpdateNackStatus(foundLostPacket, lostSeq, countSecondNack, nPLIPkt, bPLIPkt);
+            mFrames.erase(frame);
+            mSavedFrameNum--;
+        }
     }
 
-    IMLOGD_PACKET2(IM_PACKET_LOG_JITTER, "[UpdateLostPacketList] add lost seq[%u], queue size[%d]",
-            lostSeq, mLostPktList.size());
-
-    LostPacket* entry =
-            new LostPacket(lostSeq, ImsMediaTimer::GetTimeInMilliSeconds(), kRequestSendNackNone);
-    mLostPktList.push_back(entry);
-    mNumLossPacket++;
-    return false;
+    mRingQueue.Delete();
 }
 
-bool VideoJitterBuffer::UpdateNackStatus(LostPacket* pEntry, uint16_t lostSeq,
-        uint16_t* countSecondNack, uint16_t* nPLIPkt, bool* bPLIPkt)
+bool VideoJitterBuffer::IsValid(DataEntry* entry)
 {
-    /**
-     * Send initial NACK if there is error in decoding frame due to packet loss
-     */
-    if (pEntry->option == kRequestSendNackNone)
+    // the single nal unit packet and the config string are played by itself
+    if (entry->bHeader && entry->bMark)
     {
-        if ((ImsMediaTimer::GetTimeInMilliSeconds() - pEntry->markedTime) < mFrameInterval)
-        {
-            return false;
-        }
-
-        pEntry->markedTime = ImsMediaTimer::GetTimeInMilliSeconds();
-        pEntry->option = kRequestInitialNack;
-        IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[UpdateNackStatus] initial NACK, seq[%u]", lostSeq);
-        return true;
+        entry->bValid = true;
+    }
+    else if (entry->eDataType != MEDIASUBTYPE_VIDEO_CONFIGSTRING)
+    {
+        auto frame = mFrames.find(entry->nTimestamp);
+        entry->bValid = frame != mFrames.end() && frame->second.complete;
     }
 
-    if ((ImsMediaTimer::GetTimeInMilliSeconds() - pEntry->markedTime) < mResponseWaitTime)
+    return entry->bValid;
+}
+
+bool VideoJitterBuffer::CheckHeader(uint8_t* pbBuffer)
+{
+    if (pbBuffer == nullptr)
     {
         return false;
     }
 
-    /**
-     * Send Second NACK if there is first packet still not arrived within RWT duration
-     */
-    if (pEntry->option == kRequestInitialNack)
+    // check start code
+    if ((pbBuffer[0] == 0x00 && pbBuffer[1] == 0x00 && pbBuffer[2] == 0x00) ||
+            (pbBuffer[0] == 0x00 && pbBuffer[1] == 0x00 && pbBuffer[2] == 0x01))
     {
-        (*countSecondNack)++;
-        pEntry->markedTime = ImsMediaTimer::GetTimeInMilliSeconds();
-        pEntry->option = kRequestSecondNack;
-        IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[UpdateNackStatus] second NACK, seq[%u]", lostSeq);
         return true;
     }
-    else if (pEntry->option == kRequestSecondNack)
+    else
     {
-        /**
-         * Send PLI if the recovery picture does not arrived within two RWT duration
-         */
-        *nPLIPkt = lostSeq;
-        *bPLIPkt = true;
-        pEntry->markedTime = ImsMediaTimer::GetTimeInMilliSeconds();
-        pEntry->option = kRequestPli;
-        IMLOGD_PACKET1(IM_PACKET_LOG_JITTER, "[UpdateNackStatus] request PLI seq[%u]", lostSeq);
+        return false;
     }
-    else if (pEntry->option == kRequestPli)
+}
+
+void VideoJitterBuffer::CheckPacketLoss(uint16_t seqNum, uint32_t currentTime)
+{
+    mNumLossPacket += mLostPackets.OnPacketReceived(seqNum, currentTime);
+
+    if (mLostPackets.GetNumLost() == 0)
     {
-        *nPLIPkt = lostSeq;
-        pEntry->markedTime = ImsMediaTimer::GetTimeInMilliSeconds();
+        return;
     }
 
-    return false;
-}
+    // wait for the reordered packet in a frame interval, and the retransmission in a round trip
+    uint32_t retryInterval =
+            mRoundTripTime > 0 ? mRoundTripTime + mFrameInterval : mResponseWaitTime;
+    bool pictureLost = false;
 
-void VideoJitterBuffer::RequestSendNack(
-        uint16_t nLossGap, uint16_t PID, uint16_t countSecondNack, bool bNACK)
-{
-    uint32_t BLP = 0x0;  // bitmask of following lost packets
+    if (mLostPackets.GetNackRequests(
+                currentTime, mFrameInterval, retryInterval, &mNacks, &pictureLost) > 0)
+    {
+        RequestSendNack(mNacks);
+    }
 
-    if (nLossGap > 1)
+    if (pictureLost)
     {
-        BLP = (0x01 << (nLossGap - 1)) - 1;
+        RequestToSendPictureLost(kPsfbPli);
     }
+}
 
-    InternalRequestEventParam* pParam = new InternalRequestEventParam(
-            kRequestVideoSendNack, NackParams(PID, BLP, countSecondNack, bNACK));
+void VideoJitterBuffer::RequestSendNack(const std::vector<NackParams>& nacks)
+{
+    // the generic nack fcis are sent in a rtcp feedback message
+    NackParams* params = new NackParams[nacks.size()];
+    std::copy(nacks.begin(), nacks.end(), params);
 
-    IMLOGD0("[RequestSendNack]");
-    mCallback->SendEvent(kRequestVideoSendNack, reinterpret_cast<uint64_t>(pParam));
+    IMLOGD3("[RequestSendNack] fci[%zu], PID[%u], BLP[%x]", nacks.size(), nacks.front().PID,
+            nacks.front().BLP);
+    mCallback->SendEvent(kRequestVideoSendNack, reinterpret_cast<uint64_t>(params), nacks.size());
 }
 
 void VideoJitterBuffer::RequestToSendPictureLost(uint32_t type)
@@ -949,7 +777,7 @@ void VideoJitterBuffer::ProcessTimer()
 
     if (mIncomingBitrate > 0)
     {
-        CheckBitrateAdaptation(lossRate);
+        CheckBitrateAdaptation();
     }
 
     /** compare loss rate with threshold */
@@ -966,24 +794,70 @@ void VideoJitterBuffer::ProcessTimer()
     }
 }
 
-void VideoJitterBuffer::CheckBitrateAdaptation(double lossRate)
+void VideoJitterBuffer::CheckBitrateAdaptation()
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    // the incoming bitrate measured first is the starting point of the estimation
+    mBandwidthEstimator.SetBitrateRange(
+            MIN_ADAPTIVE_BITRATE, mMaxBitrate, mRequestedBitrate == 0 ? mIncomingBitrate : 0);
+
+    // the loss counters are accumulated in the monitoring duration, the estimator takes the ratio
+    mBandwidthEstimator.OnPacketLoss(mNumLossPacket, mNumAddedPacket + mNumLossPacket);
+    uint32_t bitrate =
+            mBandwidthEstimator.Update(ImsMediaTimer::GetTimeInMilliSeconds(), mIncomingBitrate);
+
+    if (mRequestedBitrate == 0)
+    {
+        mRequestedBitrate = bitrate;
+        return;
+    }
+
+    // request the decrease at once and the increase in every monitoring duration
+    if (bitrate < mRequestedBitrate ||
+            (bitrate > mRequestedBitrate &&
+                    mCountTimerExpired % DEFAULT_PACKET_LOSS_MONITORING_TIME == 0))
+    {
+        mRequestedBitrate = bitrate;
+        RequestToSendTmmbr(mRequestedBitrate);
+    }
+}
+
+void VideoJitterBuffer::CheckDelayGradient(uint32_t timestamp, uint32_t arrivalTime)
 {
-    if (mCountTimerExpired % DEFAULT_PACKET_LOSS_MONITORING_TIME == 0)
+    if (arrivalTime == 0)
     {
-        if (lossRate >= PACKET_LOSS_RATIO)
-        {
-            RequestToSendTmmbr(mIncomingBitrate);
-        }
-        else if (lossRate == 0)
-        {
-            mRequestedBitrate = mIncomingBitrate + mIncomingBitrate * BITRATE_ADAPTIVE_RATIO;
+        return;
+    }
 
-            if (mRequestedBitrate > mMaxBitrate)
-            {
-                mRequestedBitrate = mMaxBitrate;
-            }
+    if (mUnwrappedTimestamp < 0)
+    {
+        mUnwrappedTimestamp = timestamp;
+    }
+    else
+    {
+        mUnwrappedTimestamp += static_cast<int32_t>(timestamp - mLastEstimatedTimestamp);
+    }
 
-            RequestToSendTmmbr(mRequestedBitrate);
-        }
+    mLastEstimatedTimestamp = timestamp;
+    kBandwidthUsage usage = mBandwidthEstimator.GetUsage();
+
+    // the rtp timestamp of the video is in 90 kHz, the frame is sent at its capture time
+    if (mBandwidthEstimator.OnPacketArrival(mUnwrappedTimestamp * 1000 / 90,
+                static_cast<int64_t>(arrivalTime) * 1000) != kBandwidthOverusing ||
+            usage == kBandwidthOverusing || mRequestedBitrate == 0)
+    {
+        return;
     }
-}
\ No newline at end of file
+
+    // request the lower bitrate as soon as the queue starts building up, not waiting for the loss
+    uint32_t bitrate =
+            mBandwidthEstimator.Update(ImsMediaTimer::GetTimeInMilliSeconds(), mIncomingBitrate);
+
+    if (bitrate < mRequestedBitrate)
+    {
+        IMLOGD2("[CheckDelayGradient] overusing, bitrate[%u] -> [%u]", mRequestedBitrate, bitrate);
+        mRequestedBitrate = bitrate;
+        RequestToSendTmmbr(mRequestedBitrate);
+    }
+}
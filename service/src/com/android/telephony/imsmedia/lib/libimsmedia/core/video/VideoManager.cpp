@@ -345,6 +345,9 @@ void VideoManager::RequestHandler::processEvent(
         case kRequestVideoSendPictureLost:
         case kRequestVideoSendTmmbr:
         case kRequestVideoSendTmmbn:
+        case kRequestVideoSendTransportFeedback:
+        case kRequestVideoRetransmission:
+        case kRequestVideoLossFractionUpdate:
         case kRequestRoundTripTimeDelayUpdate:
             VideoManager::getInstance()->SendInternalEvent(event, sessionId, paramA, paramB);
             break;
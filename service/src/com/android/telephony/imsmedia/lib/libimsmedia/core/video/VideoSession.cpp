@@ -214,7 +214,8 @@ ImsMediaResult VideoSession::startGraph(RtpConfig* config)
     }
     else
     {
-        mGraphRtcp = new VideoStreamGraphRtcp(this, mRtcpFd);
+        int rtcpFd = config->getRtcpConfig().getRtcpMuxEnabled() ? mRtpFd : mRtcpFd;
+        mGraphRtcp = new VideoStreamGraphRtcp(this, rtcpFd);
         ret = mGraphRtcp->create(config);
 
         if (ret == RESULT_SUCCESS)
@@ -278,6 +279,9 @@ void VideoSession::onEvent(int32_t type, uint64_t param1, uint64_t param2)
         case kRequestVideoSendPictureLost:
         case kRequestVideoSendTmmbr:
         case kRequestVideoSendTmmbn:
+        case kRequestVideoSendTransportFeedback:
+        case kRequestVideoRetransmission:
+        case kRequestVideoLossFractionUpdate:
         case kRequestRoundTripTimeDelayUpdate:
             ImsMediaEventHandler::SendEvent(
                     "VIDEO_REQUEST_EVENT", type, mSessionId, param1, param2);
@@ -330,6 +334,8 @@ void VideoSession::SendInternalEvent(int32_t type, uint64_t param1, uint64_t par
         case kRequestVideoCvoUpdate:
         case kRequestVideoBitrateChange:
         case kRequestVideoIdrFrame:
+        case kRequestVideoRetransmission:
+        case kRequestVideoLossFractionUpdate:
             if (mGraphRtpTx != nullptr)
             {
                 if (!mGraphRtpTx->OnEvent(type, param1, param2))
@@ -342,6 +348,7 @@ void VideoSession::SendInternalEvent(int32_t type, uint64_t param1, uint64_t par
         case kRequestVideoSendPictureLost:
         case kRequestVideoSendTmmbr:
         case kRequestVideoSendTmmbn:
+        case kRequestVideoSendTransportFeedback:
             if (mGraphRtcp != nullptr)
             {
                 if (!mGraphRtcp->OnEvent(type, param1, param2))
@@ -46,7 +46,8 @@ ImsMediaResult VideoStreamGraphRtcp::create(RtpConfig* config)
     char localIp[MAX_IP_LEN];
     uint32_t localPort = 0;
     ImsMediaNetworkUtil::getLocalIpPortFromSocket(mLocalFd, localIp, MAX_IP_LEN, localPort);
-    RtpAddress localAddress(localIp, localPort - 1);
+    uint32_t rtpPort = config->getRtcpConfig().getRtcpMuxEnabled() ? localPort : localPort - 1;
+    RtpAddress localAddress(localIp, rtpPort);
     (static_cast<RtcpEncoderNode*>(pNodeRtcpEncoder))->SetLocalAddress(localAddress);
     pNodeRtcpEncoder->SetConfig(config);
     AddNode(pNodeRtcpEncoder);
@@ -191,6 +192,19 @@ bool VideoStreamGraphRtcp::OnEvent(int32_t type, uint64_t param1, uint64_t param
     switch (type)
     {
         case kRequestVideoSendNack:
+        {
+            BaseNode* node = findNode(kNodeIdRtcpEncoder);
+            NackParams* params = reinterpret_cast<NackParams*>(param1);
+
+            if (node != nullptr && params != nullptr)
+            {
+                RtcpEncoderNode* encoder = reinterpret_cast<RtcpEncoderNode*>(node);
+                ret = encoder->SendNack(params, static_cast<uint32_t>(param2));
+            }
+
+            delete[] params;
+        }
+        break;
         case kRequestVideoSendPictureLost:
         case kRequestVideoSendTmmbr:
         case kRequestVideoSendTmmbn:
@@ -202,11 +216,7 @@ bool VideoStreamGraphRtcp::OnEvent(int32_t type, uint64_t param1, uint64_t param
             {
                 RtcpEncoderNode* encoder = reinterpret_cast<RtcpEncoderNode*>(node);
 
-                if (type == kRequestVideoSendNack)
-                {
-                    ret = encoder->SendNack(&param->nackParams);
-                }
-                else if (type == kRequestVideoSendPictureLost)
+                if (type == kRequestVideoSendPictureLost)
                 {
                     ret = encoder->SendPictureLost(param->value);
                 }
@@ -219,6 +229,22 @@ bool VideoStreamGraphRtcp::OnEvent(int32_t type, uint64_t param1, uint64_t param
             }
         }
         break;
+        case kRequestVideoSendTransportFeedback:
+        {
+            BaseNode* node = findNode(kNodeIdRtcpEncoder);
+            uint8_t* data = reinterpret_cast<uint8_t*>(param1);
+
+            if (node != nullptr)
+            {
+                RtcpEncoderNode* encoder = reinterpret_cast<RtcpEncoderNode*>(node);
+                ret = encoder->SendTransportFeedback(data, static_cast<uint32_t>(param2));
+            }
+            else
+            {
+                delete[] data;
+            }
+        }
+        break;
     }
 
     return ret;
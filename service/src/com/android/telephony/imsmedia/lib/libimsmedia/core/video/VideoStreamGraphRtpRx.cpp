@@ -20,6 +20,7 @@
 #include <VideoConfig.h>
 #include <RtpDecoderNode.h>
 #include <SocketReaderNode.h>
+#include <VideoFecDecoderNode.h>
 #include <VideoRtpPayloadDecoderNode.h>
 #include <IVideoRendererNode.h>
 
@@ -55,12 +56,18 @@ ImsMediaResult VideoStreamGraphRtpRx::create(RtpConfig* config)
     pNodeSocketReader->SetConfig(config);
     AddNode(pNodeSocketReader);
 
+    BaseNode* pNodeFecDecoder = new VideoFecDecoderNode(mCallback);
+    pNodeFecDecoder->SetMediaType(IMS_MEDIA_VIDEO);
+    pNodeFecDecoder->SetConfig(mConfig);
+    AddNode(pNodeFecDecoder);
+    pNodeSocketReader->ConnectRearNode(pNodeFecDecoder);
+
     BaseNode* pNodeRtpDecoder = new RtpDecoderNode(mCallback);
     pNodeRtpDecoder->SetMediaType(IMS_MEDIA_VIDEO);
     pNodeRtpDecoder->SetConfig(mConfig);
     (static_cast<RtpDecoderNode*>(pNodeRtpDecoder))->SetLocalAddress(localAddress);
     AddNode(pNodeRtpDecoder);
-    pNodeSocketReader->ConnectRearNode(pNodeRtpDecoder);
+    pNodeFecDecoder->ConnectRearNode(pNodeRtpDecoder);
 
     BaseNode* pNodeRtpPayloadDecoder = new VideoRtpPayloadDecoderNode(mCallback);
     pNodeRtpPayloadDecoder->SetMediaType(IMS_MEDIA_VIDEO);
@@ -272,7 +279,7 @@ bool VideoStreamGraphRtpRx::OnEvent(int32_t type, uint64_t param1, uint64_t para
             if (node != nullptr)
             {
                 IVideoRendererNode* pNode = reinterpret_cast<IVideoRendererNode*>(node);
-                pNode->UpdateRoundTripTimeDelay(param1);
+                pNode->UpdateRoundTripTimeDelay(param1, param2);
                 return true;
             }
         }
@@ -21,6 +21,7 @@
 #include <RtpEncoderNode.h>
 #include <SocketWriterNode.h>
 #include <VideoRtpPayloadEncoderNode.h>
+#include <VideoFecEncoderNode.h>
 #include <IVideoSourceNode.h>
 
 VideoStreamGraphRtpTx::VideoStreamGraphRtpTx(BaseSessionCallback* callback, int localFd) :
@@ -79,6 +80,12 @@ ImsMediaResult VideoStreamGraphRtpTx::create(RtpConfig* config)
     AddNode(pNodeRtpEncoder);
     pNodeRtpPayloadEncoder->ConnectRearNode(pNodeRtpEncoder);
 
+    BaseNode* pNodeFecEncoder = new VideoFecEncoderNode(mCallback);
+    pNodeFecEncoder->SetMediaType(IMS_MEDIA_VIDEO);
+    pNodeFecEncoder->SetConfig(mConfig);
+    AddNode(pNodeFecEncoder);
+    pNodeRtpEncoder->ConnectRearNode(pNodeFecEncoder);
+
     BaseNode* pNodeSocketWriter = new SocketWriterNode(mCallback);
     pNodeSocketWriter->SetMediaType(IMS_MEDIA_VIDEO);
     (static_cast<SocketWriterNode*>(pNodeSocketWriter))->SetLocalFd(mLocalFd);
@@ -86,7 +93,7 @@ ImsMediaResult VideoStreamGraphRtpTx::create(RtpConfig* config)
     (static_cast<SocketWriterNode*>(pNodeSocketWriter))->SetProtocolType(kProtocolRtp);
     pNodeSocketWriter->SetConfig(config);
     AddNode(pNodeSocketWriter);
-    pNodeRtpEncoder->ConnectRearNode(pNodeSocketWriter);
+    pNodeFecEncoder->ConnectRearNode(pNodeSocketWriter);
 
     setState(kStreamStateCreated);
     mVideoMode = pConfig->getVideoMode();
@@ -373,6 +380,34 @@ bool VideoStreamGraphRtpTx::OnEvent(int32_t type, uint64_t param1, uint64_t para
             return false;
         }
         break;
+        case kRequestVideoRetransmission:
+        {
+            BaseNode* node = findNode(kNodeIdRtpEncoder);
+
+            if (node != nullptr)
+            {
+                RtpEncoderNode* pNode = reinterpret_cast<RtpEncoderNode*>(node);
+                pNode->RetransmitPackets(param1, param2);
+                return true;
+            }
+
+            return false;
+        }
+        break;
+        case kRequestVideoLossFractionUpdate:
+        {
+            BaseNode* node = findNode(kNodeIdVideoFecEncoder);
+
+            if (node != nullptr)
+            {
+                VideoFecEncoderNode* pNode = reinterpret_cast<VideoFecEncoderNode*>(node);
+                pNode->UpdateLossFraction(param1);
+                return true;
+            }
+
+            return false;
+        }
+        break;
         case kRequestVideoBitrateChange:
         case kRequestVideoIdrFrame:
         {
@@ -22,6 +22,7 @@
 
 #define CODEC_TIMEOUT_NANO 100000
 #define INTERVAL_MILLIS    10
+#define MAX_RENDER_WAIT    1000  // milliseconds, the render time further is not trusted
 
 ImsMediaVideoRenderer::ImsMediaVideoRenderer()
 {
@@ -146,6 +147,7 @@ void ImsMediaVideoRenderer::Stop()
     mMutex.lock();
     mStopped = true;
     mMutex.unlock();
+    mConditionFrame.signal();
     mConditionExit.wait_timeout(MAX_WAIT_RESTART);
 
     if (mCodec != nullptr)
@@ -168,31 +170,32 @@ void ImsMediaVideoRenderer::Stop()
     }
 }
 
-void ImsMediaVideoRenderer::OnDataFrame(
-        uint8_t* buffer, uint32_t size, uint32_t timestamp, const bool isConfigFrame)
+void ImsMediaVideoRenderer::OnDataFrame(uint8_t* buffer, uint32_t size, uint32_t timestamp,
+        const bool isConfigFrame, uint32_t renderTime)
 {
     if (size == 0 || buffer == nullptr)
     {
         return;
     }
 
-    IMLOGD_PACKET2(IM_PACKET_LOG_VIDEO, "[OnDataFrame] frame size[%u], list[%d]", size,
-            mFrameDatas.size());
+    IMLOGD_PACKET3(IM_PACKET_LOG_VIDEO, "[OnDataFrame] frame size[%u], list[%d], renderTime[%u]",
+            size, mFrameDatas.size(), renderTime);
     std::lock_guard<std::mutex> guard(mMutex);
     if (mCodec == nullptr)
     {
         return;
     }
 
-    mFrameDatas.push_back(new FrameData(buffer, size, timestamp, isConfigFrame));
+    mFrameDatas.push_back(new FrameData(buffer, size, timestamp, isConfigFrame, renderTime));
+    mConditionFrame.signal();
 }
 
 void ImsMediaVideoRenderer::processBuffers()
 {
-    uint32_t nextTime = ImsMediaTimer::GetTimeInMilliSeconds();
-    uint32_t timeDiff = 0;
+    int32_t outputIndex = -1;
+    uint32_t renderTime = 0;
 
-    IMLOGD1("[processBuffers] enter time[%u]", nextTime);
+    IMLOGD1("[processBuffers] enter time[%u]", ImsMediaTimer::GetTimeInMilliSeconds());
 
     while (true)
     {
@@ -204,86 +207,158 @@ void ImsMediaVideoRenderer::processBuffers()
         }
         mMutex.unlock();
 
-        if (mFrameDatas.size() == 0)
+        bool framesLeft = QueueInputBuffer();
+
+        if (outputIndex < 0)
         {
-            continue;
+            outputIndex = DequeueOutputBuffer(&renderTime);
         }
 
-        auto index = AMediaCodec_dequeueInputBuffer(mCodec, CODEC_TIMEOUT_NANO);
+        // the decoder is polled again soon when it has no input buffer for the frames left
+        uint32_t waitTime = framesLeft ? 1 : INTERVAL_MILLIS;
 
-        if (index >= 0)
+        if (outputIndex >= 0)
         {
-            size_t bufferSize = 0;
-            uint8_t* inputBuffer = AMediaCodec_getInputBuffer(mCodec, index, &bufferSize);
+            int32_t timeToRender = renderTime - ImsMediaTimer::GetTimeInMilliSeconds();
 
-            if (inputBuffer != nullptr)
+            if (renderTime == 0 || timeToRender <= 0 || timeToRender > MAX_RENDER_WAIT)
             {
-                FrameData* frame = mFrameDatas.front();
-                memcpy(inputBuffer, frame->data, frame->size);
-                IMLOGD_PACKET4(IM_PACKET_LOG_VIDEO,
-                        "[processBuffers] queue input buffer index[%d], size[%d], TS[%d], "
-                        "config[%d]",
-                        index, frame->size, frame->timestamp, frame->isConfig);
-
-                media_status_t err = AMediaCodec_queueInputBuffer(
-                        mCodec, index, 0, frame->size, frame->timestamp * 1000, 0);
-
-                if (err != AMEDIA_OK)
-                {
-                    IMLOGE1("[processBuffers] Unable to queue input buffers - err[%d]", err);
-                }
-
-                delete frame;
-                mFrameDatas.pop_front();
+                IMLOGD_PACKET2(IM_PACKET_LOG_VIDEO, "[processBuffers] render index[%d], late[%d]",
+                        outputIndex, renderTime == 0 ? 0 : -timeToRender);
+                AMediaCodec_releaseOutputBuffer(mCodec, outputIndex, true);
+                outputIndex = -1;
+                continue;
+            }
+
+            if (static_cast<uint32_t>(timeToRender) < waitTime)
+            {
+                waitTime = timeToRender;
             }
         }
 
-        AMediaCodecBufferInfo info;
-        index = AMediaCodec_dequeueOutputBuffer(mCodec, &info, CODEC_TIMEOUT_NANO);
+        // wakes up at the render time of the frame decoded or by the next frame
+        mConditionFrame.wait_timeout(waitTime);
+    }
 
-        if (index >= 0)
-        {
-            IMLOGD_PACKET5(IM_PACKET_LOG_VIDEO,
-                    "[processBuffers] index[%d], size[%d], offset[%d], time[%ld], flags[%d]", index,
-                    info.size, info.offset, info.presentationTimeUs, info.flags);
+    if (outputIndex >= 0)
+    {
+        AMediaCodec_releaseOutputBuffer(mCodec, outputIndex, false);
+    }
 
-            AMediaCodec_releaseOutputBuffer(mCodec, index, true);
-        }
-        else if (index == AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED)
-        {
-            IMLOGD0("[processBuffers] output buffer changed");
-        }
-        else if (index == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED)
+    mRenderTimes.clear();
+    mConditionExit.signal();
+    IMLOGD0("[processBuffers] exit");
+}
+
+bool ImsMediaVideoRenderer::QueueInputBuffer()
+{
+    mMutex.lock();
+
+    if (mFrameDatas.empty())
+    {
+        mMutex.unlock();
+        return false;
+    }
+
+    FrameData* frame = mFrameDatas.front();
+    mMutex.unlock();
+
+    auto index = AMediaCodec_dequeueInputBuffer(mCodec, CODEC_TIMEOUT_NANO);
+
+    if (index < 0)
+    {
+        return true;
+    }
+
+    size_t bufferSize = 0;
+    uint8_t* inputBuffer = AMediaCodec_getInputBuffer(mCodec, index, &bufferSize);
+
+    if (inputBuffer == nullptr)
+    {
+        return true;
+    }
+
+    memcpy(inputBuffer, frame->data, frame->size);
+    IMLOGD_PACKET4(IM_PACKET_LOG_VIDEO,
+            "[processBuffers] queue input buffer index[%d], size[%d], TS[%d], config[%d]", index,
+            frame->size, frame->timestamp, frame->isConfig);
+
+    int64_t presentationTime = static_cast<int64_t>(frame->timestamp) * 1000;
+    media_status_t err =
+            AMediaCodec_queueInputBuffer(mCodec, index, 0, frame->size, presentationTime, 0);
+
+    if (err != AMEDIA_OK)
+    {
+        IMLOGE1("[processBuffers] Unable to queue input buffers - err[%d]", err);
+    }
+    else if (!frame->isConfig)
+    {
+        mRenderTimes.push_back(std::make_pair(presentationTime, frame->renderTime));
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+    delete frame;
+    mFrameDatas.pop_front();
+    return !mFrameDatas.empty();
+}
+
+int32_t ImsMediaVideoRenderer::DequeueOutputBuffer(uint32_t* renderTime)
+{
+    AMediaCodecBufferInfo info;
+    auto index = AMediaCodec_dequeueOutputBuffer(mCodec, &info, CODEC_TIMEOUT_NANO);
+
+    if (index >= 0)
+    {
+        IMLOGD_PACKET5(IM_PACKET_LOG_VIDEO,
+                "[processBuffers] index[%d], size[%d], offset[%d], time[%ld], flags[%d]", index,
+                info.size, info.offset, info.presentationTimeUs, info.flags);
+
+        *renderTime = 0;
+
+        // the frames before the one decoded are dropped by the decoder
+        while (!mRenderTimes.empty())
         {
-            if (mFormat != nullptr)
+            std::pair<int64_t, uint32_t> frame = mRenderTimes.front();
+
+            if (frame.first > info.presentationTimeUs)
             {
-                AMediaFormat_delete(mFormat);
+                break;
             }
-            mFormat = AMediaCodec_getOutputFormat(mCodec);
-            IMLOGD1("[processBuffers] format changed, format[%s]", AMediaFormat_toString(mFormat));
-        }
-        else if (index == AMEDIACODEC_INFO_TRY_AGAIN_LATER)
-        {
-            IMLOGD0("[processBuffers] no output buffer");
-        }
-        else
-        {
-            IMLOGD1("[processBuffers] unexpected index[%d]", index);
-        }
 
-        nextTime += INTERVAL_MILLIS;
-        uint32_t nCurrTime = ImsMediaTimer::GetTimeInMilliSeconds();
+            mRenderTimes.pop_front();
 
-        if (nextTime > nCurrTime)
+            if (frame.first == info.presentationTimeUs)
+            {
+                *renderTime = frame.second;
+                break;
+            }
+        }
+
+        return index;
+    }
+    else if (index == AMEDIACODEC_INFO_OUTPUT_BUFFERS_CHANGED)
+    {
+        IMLOGD0("[processBuffers] output buffer changed");
+    }
+    else if (index == AMEDIACODEC_INFO_OUTPUT_FORMAT_CHANGED)
+    {
+        if (mFormat != nullptr)
         {
-            timeDiff = nextTime - nCurrTime;
-            IMLOGD_PACKET1(IM_PACKET_LOG_VIDEO, "[processBuffers] timeDiff[%u]", timeDiff);
-            ImsMediaTimer::Sleep(timeDiff);
+            AMediaFormat_delete(mFormat);
         }
+        mFormat = AMediaCodec_getOutputFormat(mCodec);
+        IMLOGD1("[processBuffers] format changed, format[%s]", AMediaFormat_toString(mFormat));
+    }
+    else if (index == AMEDIACODEC_INFO_TRY_AGAIN_LATER)
+    {
+        IMLOGD_PACKET0(IM_PACKET_LOG_VIDEO, "[processBuffers] no output buffer");
+    }
+    else
+    {
+        IMLOGD1("[processBuffers] unexpected index[%d]", index);
     }
 
-    mConditionExit.signal();
-    IMLOGD0("[processBuffers] exit");
+    return -1;
 }
 
 void ImsMediaVideoRenderer::UpdateDeviceOrientation(uint32_t degree)
@@ -23,6 +23,7 @@
 #include <ImsMediaVideoUtil.h>
 #include <VideoJitterBuffer.h>
 #include <string.h>
+#include <algorithm>
 
 using namespace android::telephony::imsmedia;
 
@@ -317,7 +318,16 @@ void IVideoRendererNode::ProcessData()
         QueueConfigFrame(timestamp);
     }
 
-    mVideoRenderer->OnDataFrame(buffer, size, timestamp, false);
+    // the renderer holds the frame decoded until the render time of the jitter buffer
+    uint32_t renderTime = 0;
+
+    if (mJitterBuffer != nullptr)
+    {
+        VideoJitterBuffer* jitter = reinterpret_cast<VideoJitterBuffer*>(mJitterBuffer);
+        renderTime = jitter->GetRenderTime(timestamp);
+    }
+
+    mVideoRenderer->OnDataFrame(buffer, size, timestamp, false, renderTime);
 }
 
 void IVideoRendererNode::UpdateSurface(ANativeWindow* window)
@@ -326,16 +336,20 @@ void IVideoRendererNode::UpdateSurface(ANativeWindow* window)
     mWindow = window;
 }
 
-void IVideoRendererNode::UpdateRoundTripTimeDelay(int32_t delay)
+void IVideoRendererNode::UpdateRoundTripTimeDelay(int32_t delay, int32_t variation)
 {
-    IMLOGD1("[UpdateRoundTripTimeDelay] delay[%d]", delay);
+    IMLOGD2("[UpdateRoundTripTimeDelay] delay[%d], variation[%d]", delay, variation);
 
     if (mJitterBuffer != nullptr)
     {
         VideoJitterBuffer* jitter = reinterpret_cast<VideoJitterBuffer*>(mJitterBuffer);
+        uint32_t rtt = delay / DEMON_NTP2MSEC;
+        uint32_t margin = 4 * (variation / DEMON_NTP2MSEC);
 
-        // calculate Response wait time : RWT = RTTD (mm) + 2 * frame duration
-        jitter->SetResponseWaitTime((delay / DEMON_NTP2MSEC) + 2 * (1000 / mFramerate));
+        // calculate Response wait time as the retransmission timeout of RFC 6298 :
+        // RWT = SRTT (ms) + max(2 * frame duration, 4 * RTTVAR (ms))
+        jitter->SetResponseWaitTime(rtt + std::max(margin, 2 * (1000 / mFramerate)));
+        jitter->SetRoundTripTime(rtt);
     }
 }
 
@@ -0,0 +1,131 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VideoFecDecoderNode.h>
+#include <ImsMediaTrace.h>
+#include <VideoConfig.h>
+#include <vector>
+
+#define RTP_FIXED_HEADER_SIZE 12
+
+using namespace android::telephony::imsmedia;
+
+VideoFecDecoderNode::VideoFecDecoderNode(BaseSessionCallback* callback) :
+        BaseNode(callback)
+{
+    mFecPayloadType = 0;
+}
+
+VideoFecDecoderNode::~VideoFecDecoderNode() {}
+
+kBaseNodeId VideoFecDecoderNode::GetNodeId()
+{
+    return kNodeIdVideoFecDecoder;
+}
+
+ImsMediaResult VideoFecDecoderNode::Start()
+{
+    IMLOGD1("[Start] fec payload type[%d]", mFecPayloadType);
+    mRecovery.Reset();
+    mNodeState = kNodeStateRunning;
+    return RESULT_SUCCESS;
+}
+
+void VideoFecDecoderNode::Stop()
+{
+    IMLOGD1("[Stop] recovered[%u]", mRecovery.GetNumRecovered());
+    mRecovery.Reset();
+    mNodeState = kNodeStateStopped;
+}
+
+bool VideoFecDecoderNode::IsRunTime()
+{
+    return true;
+}
+
+bool VideoFecDecoderNode::IsSourceNode()
+{
+    return false;
+}
+
+void VideoFecDecoderNode::SetConfig(void* config)
+{
+    if (config == nullptr)
+    {
+        return;
+    }
+
+    VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(config);
+    mFecPayloadType = pConfig->getFecPayloadType();
+}
+
+bool VideoFecDecoderNode::IsSameConfig(void* config)
+{
+    if (config == nullptr)
+    {
+        return true;
+    }
+
+    VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(config);
+    return mFecPayloadType == pConfig->getFecPayloadType();
+}
+
+void VideoFecDecoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData,
+        uint32_t nDataSize, uint32_t nTimeStamp, bool bMark, uint32_t nSeqNum,
+        ImsMediaSubType nDataType, uint32_t arrivalTime)
+{
+    if (mFecPayloadType <= 0 || pData == nullptr || nDataSize < RTP_FIXED_HEADER_SIZE)
+    {
+        SendDataToRearNode(
+                subtype, pData, nDataSize, nTimeStamp, bMark, nSeqNum, nDataType, arrivalTime);
+        return;
+    }
+
+    if ((pData[1] & 0x7F) == mFecPayloadType)
+    {
+        // skips the csrc list and the header extension of the fec packet
+        uint32_t headerSize = RTP_FIXED_HEADER_SIZE + (pData[0] & 0x0F) * 4;
+
+        if ((pData[0] & 0x10) != 0 && nDataSize >= headerSize + 4)
+        {
+            headerSize += 4 + (pData[headerSize + 2] << 8 | pData[headerSize + 3]) * 4;
+        }
+
+        if (nDataSize <= headerSize)
+        {
+            return;
+        }
+
+        uint32_t ssrc = pData[8] << 24 | pData[9] << 16 | pData[10] << 8 | pData[11];
+        mRecovery.OnFecPacket(pData + headerSize, nDataSize - headerSize, ssrc);
+    }
+    else
+    {
+        SendDataToRearNode(
+                subtype, pData, nDataSize, nTimeStamp, bMark, nSeqNum, nDataType, arrivalTime);
+        mRecovery.OnMediaPacket(pData, nDataSize);
+    }
+
+    std::vector<uint8_t> packet;
+
+    while (mRecovery.GetRecoveredPacket(packet))
+    {
+        IMLOGD_PACKET1(IM_PACKET_LOG_RTP, "[OnDataFromFrontNode] recovered seq[%u]",
+                packet[2] << 8 | packet[3]);
+        SendDataToRearNode(subtype, packet.data(), packet.size(), nTimeStamp, false, 0, nDataType,
+                arrivalTime);
+    }
+}
@@ -0,0 +1,188 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <VideoFecEncoderNode.h>
+#include <ImsMediaTrace.h>
+#include <VideoConfig.h>
+#include <stdlib.h>
+#include <list>
+#include <vector>
+
+#define RTP_FIXED_HEADER_SIZE 12
+#define MIN_FEC_RATE          10  // percent
+#define MAX_FEC_RATE          50  // percent
+
+using namespace android::telephony::imsmedia;
+
+VideoFecEncoderNode::VideoFecEncoderNode(BaseSessionCallback* callback) :
+        BaseNode(callback)
+{
+    mFecPayloadType = 0;
+    mFecSeqNum = 0;
+    mFecSsrc = 0;
+}
+
+VideoFecEncoderNode::~VideoFecEncoderNode() {}
+
+kBaseNodeId VideoFecEncoderNode::GetNodeId()
+{
+    return kNodeIdVideoFecEncoder;
+}
+
+ImsMediaResult VideoFecEncoderNode::Start()
+{
+    IMLOGD1("[Start] fec payload type[%d]", mFecPayloadType);
+    std::lock_guard<std::mutex> guard(mMutex);
+    mGenerator.Reset();
+    // protects with the minimum rate until the loss is reported
+    mGenerator.SetProtection(MIN_FEC_RATE, kFecMaskInterleaved);
+    // the fec stream has the own ssrc and the random initial sequence number as RFC 3550
+    mFecSeqNum = rand() & 0xFFFF;
+    mFecSsrc = (rand() & 0xFFFF) << 16 | (rand() & 0xFFFF);
+    mNodeState = kNodeStateRunning;
+    return RESULT_SUCCESS;
+}
+
+void VideoFecEncoderNode::Stop()
+{
+    IMLOGD0("[Stop]");
+    std::lock_guard<std::mutex> guard(mMutex);
+    mGenerator.Reset();
+    mNodeState = kNodeStateStopped;
+}
+
+bool VideoFecEncoderNode::IsRunTime()
+{
+    return true;
+}
+
+bool VideoFecEncoderNode::IsSourceNode()
+{
+    return false;
+}
+
+void VideoFecEncoderNode::SetConfig(void* config)
+{
+    if (config == nullptr)
+    {
+        return;
+    }
+
+    VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(config);
+    mFecPayloadType = pConfig->getFecPayloadType();
+}
+
+bool VideoFecEncoderNode::IsSameConfig(void* config)
+{
+    if (config == nullptr)
+    {
+        return true;
+    }
+
+    VideoConfig* pConfig = reinterpret_cast<VideoConfig*>(config);
+    return mFecPayloadType == pConfig->getFecPayloadType();
+}
+
+void VideoFecEncoderNode::OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* pData,
+        uint32_t nDataSize, uint32_t nTimeStamp, bool bMark, uint32_t nSeqNum,
+        ImsMediaSubType nDataType, uint32_t arrivalTime)
+{
+    SendDataToRearNode(
+            subtype, pData, nDataSize, nTimeStamp, bMark, nSeqNum, nDataType, arrivalTime);
+
+    if (mFecPayloadType <= 0 || subtype != MEDIASUBTYPE_RTPPACKET || pData == nullptr ||
+            nDataSize < RTP_FIXED_HEADER_SIZE)
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> guard(mMutex);
+
+    if (!mGenerator.AddMediaPacket(pData, nDataSize))
+    {
+        return;
+    }
+
+    // protects the packets of a frame together, the marker bit is set at the last packet
+    if ((pData[1] & 0x80) != 0 ||
+            mGenerator.GetNumMediaPackets() == FecPacketGenerator::kMaxMediaPackets)
+    {
+        SendFecPackets(pData);
+    }
+}
+
+void VideoFecEncoderNode::UpdateLossFraction(uint32_t fractionLost)
+{
+    std::lock_guard<std::mutex> guard(mMutex);
+    uint32_t lossRate = fractionLost * 100 / 256;
+    uint32_t fecRate = 0;
+
+    // protects with twice of the loss rate, to recover the most of the losses in the frame
+    if (lossRate > 0)
+    {
+        fecRate = lossRate * 2;
+        fecRate = fecRate < MIN_FEC_RATE ? MIN_FEC_RATE : fecRate;
+        fecRate = fecRate > MAX_FEC_RATE ? MAX_FEC_RATE : fecRate;
+    }
+
+    if (fecRate != mGenerator.GetFecRate())
+    {
+        IMLOGD3("[UpdateLossFraction] fractionLost[%u], fec rate[%u] -> [%u]", fractionLost,
+                mGenerator.GetFecRate(), fecRate);
+        mGenerator.SetProtection(fecRate, kFecMaskInterleaved);
+    }
+}
+
+void VideoFecEncoderNode::SendFecPackets(const uint8_t* mediaPacket)
+{
+    std::list<std::vector<uint8_t>> fecPackets;
+
+    if (mGenerator.Generate(fecPackets) == 0)
+    {
+        return;
+    }
+
+    uint32_t timestamp = mediaPacket[4] << 24 | mediaPacket[5] << 16 | mediaPacket[6] << 8 |
+            mediaPacket[7];
+    uint32_t mediaSsrc = mediaPacket[8] << 24 | mediaPacket[9] << 16 | mediaPacket[10] << 8 |
+            mediaPacket[11];
+
+    if (mFecSsrc == mediaSsrc)
+    {
+        mFecSsrc++;
+    }
+
+    for (auto& fec : fecPackets)
+    {
+        // the rtp header with the payload type and the ssrc of the fec stream
+        std::vector<uint8_t> packet(mediaPacket, mediaPacket + RTP_FIXED_HEADER_SIZE);
+        packet[0] = 0x80;
+        packet[1] = mFecPayloadType & 0x7F;
+        packet[2] = mFecSeqNum >> 8;
+        packet[3] = mFecSeqNum & 0xFF;
+        packet[8] = (mFecSsrc >> 24) & 0xFF;
+        packet[9] = (mFecSsrc >> 16) & 0xFF;
+        packet[10] = (mFecSsrc >> 8) & 0xFF;
+        packet[11] = mFecSsrc & 0xFF;
+        packet.insert(packet.end(), fec.begin(), fec.end());
+
+        IMLOGD_PACKET3(IM_PACKET_LOG_RTP, "[SendFecPackets] seq[%u], TS[%u], size[%u]",
+                mFecSeqNum, timestamp, packet.size());
+        SendDataToRearNode(MEDIASUBTYPE_RTPPACKET, packet.data(), packet.size(), timestamp,
+                false, mFecSeqNum);
+        mFecSeqNum++;
+    }
+}
@@ -0,0 +1,243 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup  RTP_Stack
+ *  @{
+ */
+
+#ifndef __RTCP_COMPOUND_ITERATOR_H__
+#define __RTCP_COMPOUND_ITERATOR_H__
+
+#include <RtpGlobal.h>
+
+/**
+ * Sender information of a RTCP SR packet decoded in place.
+ */
+typedef struct _tRTCP_SENDER_INFO
+{
+    tRTP_NTP_TIME stNtpTimestamp;
+    RtpDt_UInt32 uiRtpTimestamp;
+    RtpDt_UInt32 uiSendPktCount;
+    RtpDt_UInt32 uiSendOctCount;
+} tRTCP_SENDER_INFO;
+
+/**
+ * Reception report block of a RTCP SR/RR packet decoded in place.
+ */
+typedef struct _tRTCP_REPORT_BLOCK_INFO
+{
+    RtpDt_UInt32 uiSsrc;
+    RtpDt_UChar ucFracLost;
+    RtpDt_UInt32 uiCumNumPktLost;
+    RtpDt_UInt32 uiExtHighSeqRcv;
+    RtpDt_UInt32 uiJitter;
+    RtpDt_UInt32 uiLastSR;
+    RtpDt_UInt32 uiDelayLastSR;
+} tRTCP_REPORT_BLOCK_INFO;
+
+/**
+ * @class    RtcpBlockView
+ * @brief    Read-only view of one RTCP packet inside a compound RTCP packet.
+ *           It does not own or copy the buffer, the fields are decoded on demand from the
+ *           received packet. The view is valid only as long as the received buffer is.
+ */
+class RtcpBlockView
+{
+private:
+    // start of the RTCP packet, points to the common header
+    RtpDt_UChar* m_pucBuffer;
+
+    // length of the RTCP packet after the 8 bytes of header and sender SSRC
+    RtpDt_UInt16 m_usBodyLen;
+
+    RtpDt_UChar m_ucVersion;
+    eRtp_Bool m_bPadding;
+    RtpDt_UChar m_ucCount;
+    RtpDt_UChar m_ucPacketType;
+    RtpDt_UInt32 m_uiSsrc;
+
+public:
+    RtcpBlockView();
+
+    ~RtcpBlockView();
+
+    /**
+     * Binds the view to a RTCP packet. The caller shall make sure the buffer holds at least
+     * RTCP_FIXED_HDR_LEN + usBodyLen bytes.
+     *
+     * @param pucBuffer start of the RTCP packet
+     * @param usBodyLen number of bytes after the sender SSRC
+     */
+    RtpDt_Void setBlock(IN RtpDt_UChar* pucBuffer, IN RtpDt_UInt16 usBodyLen);
+
+    RtpDt_UChar getVersion();
+
+    eRtp_Bool getPadding();
+
+    /**
+     * get method for the 5 bits count field. It is the reception report count for SR/RR,
+     * the source count for SDES/BYE and the FMT for RTPFB/PSFB.
+     */
+    RtpDt_UChar getCount();
+
+    RtpDt_UChar getPacketType();
+
+    /**
+     * get method for the SSRC of the packet sender
+     */
+    RtpDt_UInt32 getSsrc();
+
+    /**
+     * get method for the start of the RTCP packet including the common header
+     */
+    RtpDt_UChar* getBuffer();
+
+    /**
+     * get method for the body of the RTCP packet, the bytes after the sender SSRC
+     */
+    RtpDt_UChar* getBody();
+
+    /**
+     * get method for the length of the body in bytes
+     */
+    RtpDt_UInt16 getBodyLength();
+
+    /**
+     * get method for the length of the RTCP packet in bytes excluding the first word.
+     * This is the same value RtcpHeader::getLength() returns.
+     */
+    RtpDt_UInt16 getLength();
+
+    /**
+     * Decodes the sender info of a SR packet.
+     *
+     * @param[out] pstSenderInfo decoded sender info
+     * @return eRTP_FALSE if it is not a SR packet or the packet is too short
+     */
+    eRtp_Bool getSenderInfo(OUT tRTCP_SENDER_INFO* pstSenderInfo);
+
+    /**
+     * get method for the number of report blocks present in a SR/RR packet. It is bound by both
+     * the reception report count and the length of the packet.
+     */
+    RtpDt_UInt16 getReportBlockCount();
+
+    /**
+     * Decodes the report block at the given position of a SR/RR packet.
+     *
+     * @param[in] usIndex zero based index of the report block
+     * @param[out] pstReportBlock decoded report block
+     * @return eRTP_FALSE if the report block is not present
+     */
+    eRtp_Bool getReportBlock(IN RtpDt_UInt16 usIndex, OUT tRTCP_REPORT_BLOCK_INFO* pstReportBlock);
+
+    /**
+     * get method for the media source SSRC of a RTPFB/PSFB packet
+     */
+    RtpDt_UInt32 getMediaSsrc();
+
+    /**
+     * get method for the feedback control information of a RTPFB/PSFB packet.
+     *
+     * @return nullptr if the packet does not carry FCI
+     */
+    RtpDt_UChar* getFci();
+
+    /**
+     * get method for the length of the feedback control information in bytes
+     */
+    RtpDt_UInt16 getFciLength();
+
+    /**
+     * get method for the number of SSRC/CSRC listed in a BYE packet
+     */
+    RtpDt_UInt16 getByeSsrcCount();
+
+    /**
+     * get method for the SSRC/CSRC listed in a BYE packet. Index zero is the SSRC in the
+     * fixed header.
+     */
+    RtpDt_UInt32 getByeSsrc(IN RtpDt_UInt16 usIndex);
+
+    /**
+     * Walks the report blocks of a XR packet.
+     *
+     * @param[in,out] usOffset offset of the report block in the body. Set it to zero to get the
+     *                first block, it is moved to the next block on return.
+     * @param[out] ucBlockType block type, BT field of the report block
+     * @param[out] pucBlock start of the report block including its 4 bytes header
+     * @param[out] usBlockLen length of the report block in bytes including its header
+     * @return eRTP_FALSE when there is no more valid report block
+     */
+    eRtp_Bool getNextXrBlock(IN_OUT RtpDt_UInt16& usOffset, OUT RtpDt_UChar& ucBlockType,
+            OUT RtpDt_UChar*& pucBlock, OUT RtpDt_UInt16& usBlockLen);
+};  // end of RtcpBlockView
+
+/**
+ * @class    RtcpCompoundIterator
+ * @brief    It walks the RTCP packets of a received compound RTCP packet in place.
+ *           The validation follows RtcpPacket::decodeRtcpPacket but nothing is allocated and
+ *           nothing is copied, each packet is exposed through a RtcpBlockView.
+ */
+class RtcpCompoundIterator
+{
+private:
+    RtpDt_UChar* m_pucBuffer;
+    RtpDt_UInt32 m_uiLength;
+    RtpDt_UInt32 m_uiCurPos;
+    eRTP_STATUS_CODE m_eStatus;
+
+public:
+    /**
+     * @param pucBuffer received compound RTCP packet
+     * @param uiLength length of the compound RTCP packet
+     */
+    RtcpCompoundIterator(IN RtpDt_UChar* pucBuffer, IN RtpDt_UInt32 uiLength);
+
+    ~RtcpCompoundIterator();
+
+    /**
+     * Moves the iterator back to the first RTCP packet
+     */
+    RtpDt_Void reset();
+
+    /**
+     * Binds objView to the next RTCP packet of the compound packet.
+     *
+     * @param[out] objView view of the next RTCP packet
+     * @return eRTP_FALSE at the end of the compound packet or when a malformed packet is found.
+     *         getStatus() tells both cases apart.
+     */
+    eRtp_Bool next(OUT RtcpBlockView& objView);
+
+    /**
+     * get method for the result of the last iteration. It is RTP_INVALID_MSG if a malformed packet
+     * stopped the iteration.
+     */
+    eRTP_STATUS_CODE getStatus();
+
+    /**
+     * Walks the whole compound packet and validates it the same way
+     * RtcpPacket::decodeRtcpPacket does. The iterator is reset on return.
+     *
+     * @return RTP_SUCCESS if the packet is valid
+     */
+    eRTP_STATUS_CODE validate();
+};  // end of RtcpCompoundIterator
+
+#endif  //__RTCP_COMPOUND_ITERATOR_H__
+
+/** @}*/
@@ -163,6 +163,17 @@ public:
      */
     eRTP_STATUS_CODE formRtcpPacket(OUT RtpBuffer* pobjRtcpPktBuf);
 
+    /**
+     * Performs the encoding of the reduced-size RTCP packet (RFC 5506) which carries only the
+     * feedback packets without SR, RR and SDES.
+     * This function does not allocate memory required for encoding.
+     *
+     * @param pobjRtcpPktBuf    Memory for the buffer is pre-allocated by caller
+     *
+     * @return RTP_SUCCESS on successful encoding
+     */
+    eRTP_STATUS_CODE formReducedSizeRtcpPacket(OUT RtpBuffer* pobjRtcpPktBuf);
+
 };  // end of RtcpPacket
 
 #endif  //__RTCP_PACKET_H__
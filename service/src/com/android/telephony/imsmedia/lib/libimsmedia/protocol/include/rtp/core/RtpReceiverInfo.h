@@ -79,6 +79,12 @@ class RtpReceiverInfo
     // previous SR NtpTimestamp
     RtpDt_UInt32 m_stLastSrNtpTimestamp;
 
+    // the middle 32 bits of the NTP timestamp in the last XR receiver reference time block
+    RtpDt_UInt32 m_uiLastRrtTimestamp;
+
+    // the middle 32 bits of the local NTP time when the last reference time block was received
+    RtpDt_UInt32 m_uiLastRrtRcvdTime;
+
     // check for first RTP packet
     eRtp_Bool m_bIsFirstRtp;
 
@@ -138,6 +144,27 @@ public:
 
     RtpDt_Void setLastSrNtpTimestamp(IN tRTP_NTP_TIME* pstNtpTs);
 
+    /**
+     * It keeps the NTP timestamp of the XR receiver reference time block (RFC 3611) received
+     * from this source and the local time of the reception.
+     *
+     * @param[in] pstRrtTs NTP timestamp in the receiver reference time block
+     * @param[in] pstRcvdTs local NTP time when the block is received
+     */
+    RtpDt_Void setLastRrtTimestamp(IN tRTP_NTP_TIME* pstRrtTs, IN tRTP_NTP_TIME* pstRcvdTs);
+
+    /**
+     * It returns the middle 32 bits of the last receiver reference time, RTP_ZERO when no
+     * reference time block is received.
+     */
+    RtpDt_UInt32 getLastRrtTimestamp();
+
+    /**
+     * It calculates the delay since the last receiver reference time block in the unit of
+     * 1/65536 seconds for the DLRR sub-block.
+     */
+    RtpDt_UInt32 delaySinceLastRrt();
+
     RtpDt_Void setprevRtpTimestamp(IN RtpDt_UInt32 pstRtpTs);
 
     RtpDt_Void setprevNtpTimestamp(IN tRTP_NTP_TIME* pstNtpTs);
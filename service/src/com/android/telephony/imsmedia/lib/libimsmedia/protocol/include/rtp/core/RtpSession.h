@@ -30,7 +30,10 @@
 #include <RtpTimerInfo.h>
 #include <RtpReceiverInfo.h>
 #include <RtcpPacket.h>
+#include <RtcpCompoundIterator.h>
+#include <RtpTimestampEngine.h>
 #include <mutex>
+#include <atomic>
 #include <list>
 
 class RtpStack;
@@ -48,7 +51,19 @@ class RtpStack;
  */
 class RtpSession
 {
-    std::mutex m_objRtpSessionLock;
+    /**
+     * The session state is split in three partitions so that sending and receiving RTP packets
+     * do not block each other.
+     * - m_objTxLock guards the Tx state: sequence number, RTP/NTP timestamps and send counters.
+     * - m_objRxLock guards the Rx state: the receiver list and the statistics kept in it.
+     * - m_objRtcpLock guards the RTCP scheduling state: timer info, timer id, RTCP flags and
+     *   the snapshot of the Tx state used for the next sender report.
+     * When more than one lock is required they are taken in the order RTCP, Rx, Tx.
+     * SSRC, collision flag and RTT are single word values and they are kept atomic.
+     */
+    std::mutex m_objRtcpLock;
+    std::mutex m_objRxLock;
+    std::mutex m_objTxLock;
 
     // Ip address assigned to RTP session
     RtpBuffer* m_pobjTransAddr;
@@ -98,7 +113,7 @@ class RtpSession
     IRtpAppInterface* m_pobjAppInterface;
 
     // our SSRC for this session
-    RtpDt_UInt32 m_uiSsrc;
+    std::atomic<RtpDt_UInt32> m_uiSsrc;
 
     // contains the state variables required for calculating RTCP Transmission Timer
     RtpTimerInfo m_objTimerInfo;
@@ -131,7 +146,7 @@ class RtpSession
     and then ignore the received packets if they continue to loop back to us
     due to a faulty mixer/translator implementation.
     */
-    eRtp_Bool m_bSelfCollisionByeSent;
+    std::atomic<eRtp_Bool> m_bSelfCollisionByeSent;
 
     // Timer Id
     RtpDt_Void* m_pTimerId; /* Storing Timer Id to stop while deleting
@@ -149,6 +164,12 @@ class RtpSession
     // Previous Ntp Timestamp
     tRTP_NTP_TIME m_stPrevNtpTimestamp;
 
+    // monotonic time in nanoseconds when m_curRtpTimestamp was taken
+    RtpDt_UInt64 m_ulCurRtpTime;
+
+    // maps the monotonic clock to the NTP time and to the RTP media clock of the session
+    RtpTimestampEngine m_objTsEngine;
+
     // it tells RTP packet has been sent after timer expiry
     eRtp_Bool m_bRtpSendPkt;
 
@@ -170,11 +191,20 @@ class RtpSession
     // it tells RTCP packet has been sent
     eRtp_Bool m_bRtcpSendPkt;
 
+    // snapshot of m_bRtpSendPkt taken when the RTCP timestamp is set. SR is sent if it is true
+    eRtp_Bool m_bRtcpSrPending;
+
+    // snapshot of m_uiRtpSendPktCount for the sender info of the next SR
+    RtpDt_UInt32 m_uiRtcpSrPktCount;
+
+    // snapshot of m_uiRtpSendOctCount for the sender info of the next SR
+    RtpDt_UInt32 m_uiRtcpSrOctCount;
+
     // It will be enabled @ delete session
     eRtp_Bool m_bSndRtcpByePkt;
 
     // it will store RTTD value
-    RtpDt_UInt32 m_lastRTTDelay;
+    std::atomic<RtpDt_UInt32> m_lastRTTDelay;
 
     // RTCP-XR data
     tRTCP_XR_DATA m_stRtcpXr;
@@ -185,6 +215,20 @@ class RtpSession
     // it will check if first RTP packet received
     eRtp_Bool m_bFirstRtpRecvd;
 
+    // negotiated reduced-size RTCP (RFC 5506), the feedback is sent without SR, RR and SDES
+    eRtp_Bool m_bReducedSizeRtcp;
+
+    // RTCP XR receiver reference time and DLRR blocks (RFC 3611) sent with every report
+    eRtp_Bool m_bXrRrtBlock;
+    eRtp_Bool m_bXrDlrrBlock;
+
+    // feedback packets appended to the next regular report when early feedback is not allowed
+    std::list<RtcpFbPacket*> m_objPendingFbPktList;
+
+    // sequence numbers requested by the NACK sent indexed by the sequence number modulo
+    // RTCP_MAX_NACK_RECORDS, guarded by m_objRxLock
+    tRTCP_NACK_RECORD m_stNackRecords[RTCP_MAX_NACK_RECORDS];
+
     /**
      * It checks SSRC is present in the receiver list
      */
@@ -209,17 +253,22 @@ class RtpSession
 
     /**
      * It processes the Received RTCP BYE packet. Deletes entry from Receiver list.
+     * The caller shall hold m_objRtcpLock and m_objRxLock.
+     *
+     * @param[out] uiTimerVal RTCP timer value in milliseconds when the report shall be
+     *             rescheduled, zero otherwise. The timer is restarted by the caller after the
+     *             locks are released since the timer callback waits for m_objRtcpLock.
      */
-    eRTP_STATUS_CODE processByePacket(
-            IN RtcpByePacket* pobjByePkt, IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort);
+    eRTP_STATUS_CODE processByePacket(IN RtcpBlockView& objByePkt, IN RtpBuffer* pobjRtcpAddr,
+            IN RtpDt_UInt16 usPort, OUT RtpDt_UInt32& uiTimerVal);
 
     /**
      * It processes the Received SDES packet
      */
-    eRTP_STATUS_CODE processSdesPacket(IN RtcpSdesPacket* pobjSdesPkt);
+    eRTP_STATUS_CODE processSdesPacket(IN RtcpBlockView& objSdesPkt);
 
     /**
-     * Calculate the timer interval for RTCP
+     * Calculate the timer interval for RTCP. The caller shall hold m_objRtcpLock and m_objRxLock.
      */
     RtpDt_Double rtcp_interval(IN RtpDt_UInt16 usMembers);
 
@@ -246,7 +295,7 @@ class RtpSession
             IN RtpHeader* pobjRtpHdr, IN eRtp_Bool eSetMarker, IN RtpDt_UChar ucPayloadType);
 
     /**
-     * It calculates number of senders in the receiver list
+     * It calculates number of senders in the receiver list. The caller shall hold m_objRxLock.
      */
     RtpDt_UInt32 getSenderCount();
 
@@ -275,6 +324,32 @@ class RtpSession
             IN RtpDt_Char* pcBuff, IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSSRC,
             IN RtpDt_UInt32 uiPayloadType);
 
+    /**
+     * It creates RTCP feedback packet with the FCI copied from pcBuff
+     */
+    RtcpFbPacket* createRtcpFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff,
+            IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSSRC, IN RtpDt_UInt32 uiPayloadType);
+
+    /**
+     * It sends RTPFB or PSFB feedback packet. In reduced-size mode the feedback packet is sent
+     * alone as an early packet when RFC 4585 allows it, otherwise it is appended to the next
+     * regular report. Without reduced-size mode it is sent in a compound packet immediately.
+     */
+    eRtp_Bool sendRtcpFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff,
+            IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSsrc, IN RtpDt_UInt32 uiPayloadType);
+
+    /**
+     * It moves the pending feedback packets to the regular report. The caller shall hold
+     * m_objRtcpLock.
+     */
+    RtpDt_Void appendPendingFbPackets(IN_OUT RtcpPacket* pobjRtcpPkt);
+
+    /**
+     * It records the sequence numbers requested by the generic NACK FCI entries of PID and BLP
+     * to measure the retransmission latency. The caller shall hold m_objRxLock.
+     */
+    RtpDt_Void addNackRecords(IN RtpDt_Char* pcBuff, IN RtpDt_UInt32 uiLen);
+
     /**
      * It constructs SR packet list
      */
@@ -320,12 +395,17 @@ class RtpSession
     /**
      * method for sending rtcp packet
      */
-    eRTP_STATUS_CODE rtpSendRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt);
+    eRTP_STATUS_CODE rtpSendRtcpPacket(
+            IN_OUT RtcpPacket* objRtcpPkt, IN eRtp_Bool bReducedSize);
 
     /**
-     * method for setting timestamp for RTCP packet
+     * method for setting timestamp for RTCP packet. It takes a snapshot of the Tx state under
+     * m_objTxLock, the caller shall hold m_objRtcpLock.
+     *
+     * @param bNewInterval eRTP_TRUE for the regular report, it starts the next reporting interval
+     * of the sent RTP packets. The feedback and BYE packets keep the interval.
      */
-    RtpDt_Void rtpSetTimestamp();
+    RtpDt_Void rtpSetTimestamp(IN eRtp_Bool bNewInterval);
 
     /**
      * method for making compound rtcp packet
@@ -345,8 +425,22 @@ class RtpSession
 
     eRTP_STATUS_CODE constructSdesPkt(IN_OUT RtcpPacket* pobjRtcpPkt);
 
+    /**
+     * It populates the XR packet with the receiver reference time block, the DLRR block for
+     * the sources which sent the reference time and the report blocks set by sendRtcpXrPacket.
+     * No XR packet is added when there is no block to send.
+     */
     eRTP_STATUS_CODE populateRtcpXrPacket(IN_OUT RtcpPacket* pobjRtcpPkt);
 
+    /**
+     * It processes the receiver reference time and the DLRR blocks of the received XR packet.
+     * The round trip time is calculated from the DLRR sub-block addressed to this session.
+     *
+     * @param[in] objBlock view of the XR packet in the compound packet
+     * @param[in] currentTime middle 32 bits of the NTP time when the packet is received
+     */
+    RtpDt_Void processXrPacket(IN RtcpBlockView& objBlock, IN RtpDt_UInt32 currentTime);
+
     /**
      * Check of the received RTP packet payload type is matching with the expected payload types.
      *
@@ -402,6 +496,25 @@ public:
 
     eRTP_STATUS_CODE setRTCPTimerValue(IN RtpDt_UInt16 usRTCPTimerVal);
 
+    /**
+     * It enables the reduced-size RTCP (RFC 5506) negotiated with the peer. The feedback
+     * packets are sent without SR, RR and SDES as early packets following RFC 4585 timing rules.
+     *
+     * @param bReducedSize eRTP_TRUE to enable the reduced-size RTCP
+     */
+    RtpDt_Void setReducedSizeRtcp(IN eRtp_Bool bReducedSize);
+
+    eRtp_Bool isReducedSizeRtcp();
+
+    /**
+     * It enables the RTCP XR receiver reference time and DLRR blocks (RFC 3611), the round trip
+     * time is measured with them when the peer does not send the sender report.
+     *
+     * @param bRrt eRTP_TRUE to send the receiver reference time block
+     * @param bDlrr eRTP_TRUE to send the DLRR block for the reference time received
+     */
+    RtpDt_Void setRtcpXrRttBlocks(IN eRtp_Bool bRrt, IN eRtp_Bool bDlrr);
+
     /**
      * calls the delete stream of RTP stack.
      */
@@ -448,6 +561,7 @@ public:
      *
      * @param[in] pobjPayload Rtp payload with length
      * @param[in] eSetMarker if marker flag is set, marker bit will be set in RTP header.
+     * @param[in] pobjXHdr Rtp header extension block, it is owned by the caller.
      * @param[out] pRtpPkt Rtp packet with length.
      */
     eRTP_STATUS_CODE createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_Bool eSetMarker,
@@ -461,13 +575,13 @@ public:
      * - update list of members.
      * - update total number of active senders.
      * - update list of active senders.
+     * The compound packet is read in place with RtcpCompoundIterator, nothing is copied.
      * @param[in] pobjRtcpAddr Ip address from which packet is received
      * @param[in] usPort port number from which packet is received.
      * @param[in] pobjRTCPPacket Buffer from network and the number of bytes in the buffer
-     * @param[out] pobjRtcpPkt Decoded RTCP packet
      */
-    eRTP_STATUS_CODE processRcvdRtcpPkt(IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort,
-            IN RtpBuffer* pobjRTCPPacket, OUT RtcpPacket* pobjRtcpPkt);
+    eRTP_STATUS_CODE processRcvdRtcpPkt(
+            IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort, IN RtpBuffer* pobjRTCPPacket);
 
     eRtp_Bool sendRtcpByePacket();
 
@@ -477,6 +591,16 @@ public:
     eRtp_Bool sendRtcpPayloadFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff,
             IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSsrc);
 
+    /**
+     * It checks whether the received sequence number was requested by the NACK sent and not
+     * yet received. The record is looked up by the sequence number and cleared when it matches.
+     *
+     * @param[in] usSeqNum sequence number of the received RTP packet
+     * @param[out] uiLatency milliseconds from sending the NACK to receiving the packet
+     * @return eRTP_TRUE when the packet is the retransmission of the NACK sent
+     */
+    eRtp_Bool checkNackRetransmission(IN RtpDt_UInt16 usSeqNum, OUT RtpDt_UInt32& uiLatency);
+
     /**
      * It sets the m_bRtcpTxFlag to control the RTCP data transmission.
      * @param[in] bRtcpTxFlag
@@ -518,6 +642,11 @@ public:
      */
     eRtp_Bool compareRtpSessions(IN RtpSession* pobjSession);
 
+    /**
+     * get method for the stack instance to which this session belongs
+     */
+    RtpStack* getRtpStack();
+
     /**
      * Handling of RTCP timer expiry.
      * It constructs the RTCP compound packet after rtcp timer expiry.
@@ -32,6 +32,7 @@
 #include <RtpStackProfile.h>
 #include <RtpSession.h>
 #include <list>
+#include <mutex>
 
 class RtpSession;
 
@@ -42,6 +43,11 @@ class RtpStack
      */
     std::list<RtpSession*> m_objRtpSessionList;
 
+    /**
+     * lock of m_objRtpSessionList, it is only shared by the sessions of this stack
+     */
+    std::mutex m_objRtpSessionLock;
+
     /**
      * Profile for this stack
      */
@@ -71,7 +77,8 @@ public:
     RtpSession* createRtpSession();
 
     /**
-     * @brief finds whether pobjSession exists in RtpSessionList or not
+     * @brief finds whether pobjSession exists in RtpSessionList or not. pobjSession is compared
+     * without being dereferenced, so the pointer of a deleted session can be checked.
      * @param pobjSession pointer to RtpSession that has to be searched
      * @return eRTP_SUCCESS if RTP session present in the m_objRtpSessionList
      */
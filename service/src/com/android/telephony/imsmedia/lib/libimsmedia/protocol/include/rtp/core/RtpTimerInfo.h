@@ -67,6 +67,10 @@ class RtpTimerInfo
     /** Flag that is true if the application has not yet sent
     an RTCP packet.*/
     eRtp_Bool m_bInitial;
+    /** RFC 4585 allow_early. Flag that is true if an early feedback packet may be sent before
+    the next regular RTCP report. It is cleared by an early packet and set again by the next
+    regular report.*/
+    eRtp_Bool m_bAllowEarly;
 
     // increment sender count by uiIncrVal
     RtpDt_Void incrSndrCount(IN RtpDt_UInt32 uiIncrVal);
@@ -118,6 +122,11 @@ public:
     // set method for m_uiInitial
     RtpDt_Void setInitial(IN eRtp_Bool bSetInitial);
 
+    // get method for m_bAllowEarly
+    eRtp_Bool isAllowEarly();
+    // set method for m_bAllowEarly
+    RtpDt_Void setAllowEarly(IN eRtp_Bool bAllowEarly);
+
     // It updates AVG RTCP SIZE
     RtpDt_Void updateAvgRtcpSize(IN RtpDt_UInt32 uiRcvdPktSize);
 
@@ -0,0 +1,115 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** \addtogroup  RTP_Stack
+ *  @{
+ */
+
+#ifndef __RTP_TIMESTAMP_ENGINE_H__
+#define __RTP_TIMESTAMP_ENGINE_H__
+
+#include <RtpGlobal.h>
+
+/**
+ * @class    RtpTimestampEngine
+ * @brief    It maps the monotonic clock of the device to NTP time and to the RTP media clock of a
+ *           session. Both mappings are anchored once and every timestamp is computed from the
+ *           anchor with exact 64-bit integer arithmetic, so rounding errors do not accumulate
+ *           over the call and the RTP and NTP timestamps of a SR always describe the same instant.
+ *           Times passed to this class are monotonic clock values in nanoseconds as returned by
+ *           RtpOsUtil::GetMonotonicTime().
+ */
+class RtpTimestampEngine
+{
+private:
+    // monotonic time of the NTP anchor in nanoseconds
+    RtpDt_UInt64 m_ulNtpAnchorTime;
+
+    // NTP time of the anchor in 32.32 fixed point format
+    RtpDt_UInt64 m_ulNtpAnchor;
+
+    // monotonic time of the RTP anchor in nanoseconds
+    RtpDt_UInt64 m_ulRtpAnchorTime;
+
+    // RTP timestamp of the anchor
+    RtpDt_UInt32 m_uiRtpAnchor;
+
+    // RTP media clock rate in Hz
+    RtpDt_UInt32 m_uiSamplingRate;
+
+public:
+    RtpTimestampEngine();
+
+    ~RtpTimestampEngine();
+
+    /**
+     * Anchors the NTP and the RTP mapping at the given time.
+     *
+     * @param ulTime monotonic time of the anchor in nanoseconds
+     * @param pstNtpTime wall clock NTP time at ulTime
+     * @param uiRtpTimestamp RTP timestamp at ulTime
+     * @param uiSamplingRate RTP media clock rate in Hz
+     */
+    RtpDt_Void init(IN RtpDt_UInt64 ulTime, IN tRTP_NTP_TIME* pstNtpTime,
+            IN RtpDt_UInt32 uiRtpTimestamp, IN RtpDt_UInt32 uiSamplingRate);
+
+    /**
+     * Moves the RTP anchor. It is used when the application drives the media clock itself, the
+     * NTP anchor is not affected.
+     *
+     * @param ulTime monotonic time in nanoseconds
+     * @param uiRtpTimestamp RTP timestamp at ulTime
+     */
+    RtpDt_Void setRtpAnchor(IN RtpDt_UInt64 ulTime, IN RtpDt_UInt32 uiRtpTimestamp);
+
+    /**
+     * Changes the media clock rate. The RTP anchor is moved to ulTime first so that the RTP
+     * timestamps stay continuous.
+     */
+    RtpDt_Void setSamplingRate(IN RtpDt_UInt64 ulTime, IN RtpDt_UInt32 uiSamplingRate);
+
+    RtpDt_UInt32 getSamplingRate();
+
+    /**
+     * get method for the NTP time corresponding to the given monotonic time
+     */
+    RtpDt_Void getNtpTime(IN RtpDt_UInt64 ulTime, OUT tRTP_NTP_TIME* pstNtpTime);
+
+    /**
+     * get method for the RTP timestamp corresponding to the given monotonic time
+     */
+    RtpDt_UInt32 getRtpTimestamp(IN RtpDt_UInt64 ulTime);
+
+    /**
+     * Converts a duration to a number of media clock ticks, rounded down.
+     *
+     * @param ulDuration duration in nanoseconds
+     * @param uiSamplingRate RTP media clock rate in Hz
+     */
+    static RtpDt_UInt64 convertToRtpTicks(
+            IN RtpDt_UInt64 ulDuration, IN RtpDt_UInt32 uiSamplingRate);
+
+    /**
+     * Converts a duration to NTP 32.32 fixed point format, rounded down.
+     *
+     * @param ulDuration duration in nanoseconds
+     */
+    static RtpDt_UInt64 convertToNtp(IN RtpDt_UInt64 ulDuration);
+};  // end of RtpTimestampEngine
+
+#endif  //__RTP_TIMESTAMP_ENGINE_H__
+
+/** @}*/
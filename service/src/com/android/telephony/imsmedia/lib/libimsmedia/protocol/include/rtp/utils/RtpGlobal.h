@@ -65,12 +65,29 @@
 #define RTP_MAX_RECEP_REP_CNT    31
 
 #define RTP_CVO_XHDR_LEN         8
+#define RTP_MAX_XHDR_LEN         1024
 
 #define RTCP_RC_SHIFT_VAL        8  // 12
 #define RTCP_PT_SHIFT_VAL        0  // 7
 #define RTCP_FIXED_HDR_LEN       8
 
-#define RTP_MAX_PAYLOAD_TYPE     4
+#define RTP_MAX_PAYLOAD_TYPE     5
+
+// RFC 4585 generic NACK feedback message type of RTPFB
+#define RTCP_FB_GENERIC_NACK     1
+// feedback packets waiting for the next regular RTCP report in reduced-size mode
+#define RTCP_MAX_PENDING_FB_PKTS 8
+// sequence numbers waiting for the retransmission after sending NACK, the record of a sequence
+// number is indexed by its modulo
+#define RTCP_MAX_NACK_RECORDS    64
+// the NACK record is discarded when the retransmission does not arrive within it
+#define RTCP_NACK_RECORD_TIMEOUT 3000
+
+// RFC 3611 receiver reference time and DLRR report blocks of RTCP XR
+#define RTCP_XR_RRT_BLOCK_TYPE      4
+#define RTCP_XR_DLRR_BLOCK_TYPE     5
+#define RTCP_XR_RRT_BLOCK_LEN       12
+#define RTCP_XR_DLRR_SUB_BLOCK_LEN  12
 
 /* RTP error codes*/
 typedef enum
@@ -164,6 +181,15 @@ typedef struct
     RtpDt_UInt16 nlength;
 } tRTCP_XR_DATA;
 
+// It describes a sequence number requested by the generic NACK
+typedef struct
+{
+    RtpDt_UInt16 usSeqNum;
+    // monotonic time in milliseconds when the NACK was sent
+    RtpDt_UInt32 uiSentTime;
+    eRtp_Bool bPending;
+} tRTCP_NACK_RECORD;
+
 // RTP parser
 #define RTP_WORD_SIZE        4
 #define RTP_FIXED_HDR_LEN    12
@@ -42,12 +42,20 @@ public:
     static RtpDt_Void GetNtpTime(tRTP_NTP_TIME& pstNtpTime);
 
     /**
-     *  Initializes pseudo-random number generator using system time as seed
+     * It gets the monotonic clock which is not affected by changes of the wall clock
+     *
+     * @return Monotonic time in nanoseconds
+     */
+    static RtpDt_UInt64 GetMonotonicTime();
+
+    /**
+     *  Initializes pseudo-random number generator of the calling thread using system time as seed
      */
     static RtpDt_Void Srand();
 
     /**
-     * Generates a pseudo-random integral number using a new seed.
+     * Generates a pseudo-random integral number from the generator of the calling thread. The
+     * generator is seeded at the first call in the thread.
      *
      * @return Random number
      */
@@ -114,6 +114,8 @@ typedef uint16_t RtpDt_UInt16;
 typedef int16_t RtpDt_Int16;
 typedef uint32_t RtpDt_UInt32;
 typedef int32_t RtpDt_Int32;
+typedef uint64_t RtpDt_UInt64;
+typedef int64_t RtpDt_Int64;
 typedef double RtpDt_Double;
 
 typedef struct
@@ -58,10 +58,30 @@ GLOBAL eRtp_Bool IMS_RtpSvc_Initialize();
  */
 GLOBAL eRtp_Bool IMS_RtpSvc_Deinitialize();
 
+/**
+ * Creates an RTP Protocol Stack instance with its own profile and session list. Sessions created
+ * in different instances share no mutable state, so the sessions of independent calls or worker
+ * threads do not contend with each other. It does not need IMS_RtpSvc_Initialize().
+ *
+ * @param hRtpStack handle of the newly created stack.
+ */
+GLOBAL eRtp_Bool IMS_RtpSvc_CreateStack(OUT RTPSTACKID* hRtpStack);
+
+/**
+ * Deletes the RTP Protocol Stack instance created by IMS_RtpSvc_CreateStack(). The sessions of
+ * the stack shall be deleted by IMS_RtpSvc_DeleteSession() before.
+ *
+ * @param hRtpStack handle of the stack to delete.
+ */
+GLOBAL eRtp_Bool IMS_RtpSvc_DeleteStack(IN RTPSTACKID hRtpStack);
+
 /**
  * API should be used to create RTP Sessions. One RTP session per stream.
  * Same RTP Session can be used for both sending and receiving a given payload type.
  *
+ * @param hRtpStack Stack in which the session is created. If it is nullptr, the session is created
+ * in the default stack of IMS_RtpSvc_Initialize().
+ *
  * @param szLocalIP LocalIP address on which RTP packets will be received.
  *
  * @param uiPort RTP port on which packets will be received.
@@ -70,10 +90,12 @@ GLOBAL eRtp_Bool IMS_RtpSvc_Deinitialize();
  *
  * @param puSsrc SSRC of the newly created session
  *
- * @param hRtpSession handle of the newly created session.
+ * @param hRtpSession handle of the newly created session. It refers to the stack of the session
+ * and is rejected by the other APIs once the session is deleted.
  */
-GLOBAL eRtp_Bool IMS_RtpSvc_CreateSession(IN RtpDt_Char* szLocalIP, IN RtpDt_UInt32 port,
-        IN RtpDt_Void* pAppData, OUT RtpDt_UInt32* puSsrc, OUT RTPSESSIONID* hRtpSession);
+GLOBAL eRtp_Bool IMS_RtpSvc_CreateSession(IN RTPSTACKID hRtpStack, IN RtpDt_Char* szLocalIP,
+        IN RtpDt_UInt32 port, IN RtpDt_Void* pAppData, OUT RtpDt_UInt32* puSsrc,
+        OUT RTPSESSIONID* hRtpSession);
 
 /**
  * This API should be called to set payload info of the RTP packets to be processed but
@@ -102,6 +124,31 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SetPayload(IN RTPSESSIONID hRtpSession,
  */
 GLOBAL eRtp_Bool IMS_RtpSvc_SetRTCPInterval(IN RTPSESSIONID hRtpSession, IN RtpDt_UInt32 nInterval);
 
+/**
+ * This API can be used to enable the reduced-size RTCP (RFC 5506) negotiated with the peer.
+ * The feedback packets are sent without SR, RR and SDES following RFC 4585 early feedback rules.
+ *
+ * @param hRtpSession A session handled to which reduced-size RTCP to be set.
+ *
+ * @param bReducedSize eRTP_TRUE to enable reduced-size RTCP.
+ */
+GLOBAL eRtp_Bool IMS_RtpSvc_SetRtcpReducedSize(
+        IN RTPSESSIONID hRtpSession, IN eRtp_Bool bReducedSize);
+
+/**
+ * This API can be used to send the RTCP XR receiver reference time and DLRR blocks (RFC 3611)
+ * with the regular reports. The round trip time is measured with them even when the peer only
+ * receives the media and never sends the sender report.
+ *
+ * @param hRtpSession A session handled to which the XR blocks to be set.
+ *
+ * @param bRrt eRTP_TRUE to send the receiver reference time block.
+ *
+ * @param bDlrr eRTP_TRUE to send the DLRR block for the reference time received.
+ */
+GLOBAL eRtp_Bool IMS_RtpSvc_SetRtcpXrRttBlocks(
+        IN RTPSESSIONID hRtpSession, IN eRtp_Bool bRrt, IN eRtp_Bool bDlrr);
+
 /**
  * API to delete RTP session.
  *
@@ -29,7 +29,14 @@
 
 #include <RtpPfDatatypes.h>
 
-typedef void* RTPSESSIONID;
+typedef void* RTPSTACKID;
+
+// opaque session handle, it is validated against the stack which created the session
+typedef struct
+{
+    RTPSTACKID hRtpStack;
+    RtpDt_Void* pvRtpSession;
+} RTPSESSIONID;
 
 typedef enum
 {
@@ -48,6 +55,7 @@ typedef enum
     RTPSVC_UNKNOWN_ERR_IND,
     RTPSVC_RECEIVE_RTCP_FB_IND,
     RTPSVC_RECEIVE_RTCP_PAYLOAD_FB_IND,
+    RTPSVC_NACK_RETRANSMISSION_IND,
     RTPSVC_LAST_IND_FROM_STACK = 0x7fff
 } tRtpSvc_IndicationFromStack;
 
@@ -166,6 +174,13 @@ typedef struct
     tRtpSvcRecvReport stRecvRpt;  // only one RR block is supported.
 } tNotifyReceiveRtcpRrInd;
 
+typedef struct
+{
+    RtpDt_UInt16 wSeqNum;
+    // milliseconds from sending the NACK to receiving the retransmitted packet
+    RtpDt_UInt32 dwLatency;
+} tRtpSvcIndSt_NackRetransmissionInd;
+
 #endif /* End of _RTP_SERVICE_TYPES_H_*/
 
 /** @}*/
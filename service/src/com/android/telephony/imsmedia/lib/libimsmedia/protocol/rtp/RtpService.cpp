@@ -20,9 +20,30 @@
 #include <RtpStack.h>
 #include <RtpTrace.h>
 #include <RtpError.h>
+#include <RtcpCompoundIterator.h>
 
+// the default stack shared by the sessions created without their own stack
 RtpStack* g_pobjRtpStack = nullptr;
 
+/**
+ * Returns the session of the handle if it is alive in the stack which created it, nullptr
+ * otherwise. The session is looked up in its stack without being dereferenced, only the sessions
+ * of the same stack share the lock.
+ */
+RtpSession* getRtpSession(IN RTPSESSIONID hRtpSession)
+{
+    RtpStack* pobjRtpStack = reinterpret_cast<RtpStack*>(hRtpSession.hRtpStack);
+    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession.pvRtpSession);
+
+    if (pobjRtpStack == nullptr ||
+            pobjRtpStack->isValidRtpSession(pobjRtpSession) != eRTP_SUCCESS)
+    {
+        return nullptr;
+    }
+
+    return pobjRtpSession;
+}
+
 RtpDt_Void addSdesItem(
         OUT RtcpConfigInfo* pobjRtcpCfgInfo, IN RtpDt_UChar* sdesName, IN RtpDt_UInt32 uiLength)
 {
@@ -86,24 +107,19 @@ RtpDt_Void populateReceiveRtpIndInfo(
 }
 
 eRtp_Bool populateRcvdReportFromStk(
-        IN std::list<RtcpReportBlock*>& pobjRepBlkList, OUT tRtpSvcRecvReport* pstRcvdReport)
+        IN RtcpBlockView& objReportPkt, OUT tRtpSvcRecvReport* pstRcvdReport)
 {
-    if (pobjRepBlkList.size() > RTP_ZERO)
+    // application supports one RR
+    tRTCP_REPORT_BLOCK_INFO stRepBlk;
+    if (objReportPkt.getReportBlock(RTP_ZERO, &stRepBlk) == eRTP_TRUE)
     {
-        // application supports one RR
-        RtcpReportBlock* pobjRepBlkElm = pobjRepBlkList.front();
-        if (pobjRepBlkElm == nullptr)
-        {
-            return eRTP_FALSE;
-        }
-
-        pstRcvdReport->ssrc = pobjRepBlkElm->getSsrc();
-        pstRcvdReport->fractionLost = pobjRepBlkElm->getFracLost();
-        pstRcvdReport->cumPktsLost = pobjRepBlkElm->getCumNumPktLost();
-        pstRcvdReport->extHighSeqNum = pobjRepBlkElm->getExtHighSeqRcv();
-        pstRcvdReport->jitter = pobjRepBlkElm->getJitter();
-        pstRcvdReport->lsr = pobjRepBlkElm->getLastSR();
-        pstRcvdReport->delayLsr = pobjRepBlkElm->getDelayLastSR();
+        pstRcvdReport->ssrc = stRepBlk.uiSsrc;
+        pstRcvdReport->fractionLost = stRepBlk.ucFracLost;
+        pstRcvdReport->cumPktsLost = stRepBlk.uiCumNumPktLost;
+        pstRcvdReport->extHighSeqNum = stRepBlk.uiExtHighSeqRcv;
+        pstRcvdReport->jitter = stRepBlk.uiJitter;
+        pstRcvdReport->lsr = stRepBlk.uiLastSR;
+        pstRcvdReport->delayLsr = stRepBlk.uiDelayLastSR;
 
         RTP_TRACE_MESSAGE("Received RR info :  [SSRC = %u] [FRAC LOST = %u]", pstRcvdReport->ssrc,
                 pstRcvdReport->fractionLost);
@@ -132,43 +148,27 @@ eRtp_Bool populateRcvdReportFromStk(
 }  // populateRcvdReportFromStk
 
 eRtp_Bool populateRcvdRrInfoFromStk(
-        IN std::list<RtcpRrPacket*>& pobjRrList, OUT tNotifyReceiveRtcpRrInd* pstRrInfo)
+        IN RtcpBlockView& objRrPkt, OUT tNotifyReceiveRtcpRrInd* pstRrInfo)
 {
-    if (pobjRrList.empty())
-    {
-        return eRTP_FALSE;
-    }
-    // application supports one RR
-    RtcpRrPacket* pobjRrPkt = pobjRrList.front();
-    if (pobjRrPkt == nullptr)
-    {
-        return eRTP_FALSE;
-    }
-
     tRtpSvcRecvReport* pstRcvdReport = &(pstRrInfo->stRecvRpt);
-    std::list<RtcpReportBlock*>& pobjRepBlkList = pobjRrPkt->getReportBlockList();
-    return populateRcvdReportFromStk(pobjRepBlkList, pstRcvdReport);
+    return populateRcvdReportFromStk(objRrPkt, pstRcvdReport);
 }  // populateRcvdRrInfoFromStk
 
 eRtp_Bool populateRcvdSrInfoFromStk(
-        IN std::list<RtcpSrPacket*>& pobjSrList, OUT tNotifyReceiveRtcpSrInd* pstSrInfo)
+        IN RtcpBlockView& objSrPkt, OUT tNotifyReceiveRtcpSrInd* pstSrInfo)
 {
-    if (pobjSrList.empty())
-    {
-        return eRTP_FALSE;
-    }
     // get SR packet data
-    RtcpSrPacket* pobjSrPkt = pobjSrList.front();
-    if (pobjSrPkt == nullptr)
+    tRTCP_SENDER_INFO stSenderInfo;
+    if (objSrPkt.getSenderInfo(&stSenderInfo) == eRTP_FALSE)
     {
         return eRTP_FALSE;
     }
 
-    pstSrInfo->ntpTimestampMsw = pobjSrPkt->getNtpTime()->m_uiNtpHigh32Bits;
-    pstSrInfo->ntpTimestampLsw = pobjSrPkt->getNtpTime()->m_uiNtpLow32Bits;
-    pstSrInfo->rtpTimestamp = pobjSrPkt->getRtpTimestamp();
-    pstSrInfo->sendPktCount = pobjSrPkt->getSendPktCount();
-    pstSrInfo->sendOctCount = pobjSrPkt->getSendOctetCount();
+    pstSrInfo->ntpTimestampMsw = stSenderInfo.stNtpTimestamp.m_uiNtpHigh32Bits;
+    pstSrInfo->ntpTimestampLsw = stSenderInfo.stNtpTimestamp.m_uiNtpLow32Bits;
+    pstSrInfo->rtpTimestamp = stSenderInfo.uiRtpTimestamp;
+    pstSrInfo->sendPktCount = stSenderInfo.uiSendPktCount;
+    pstSrInfo->sendOctCount = stSenderInfo.uiSendOctCount;
 
     RTP_TRACE_MESSAGE("Received SR info :  [NTP High 32 = %u] [NTP LOW 32 = %u]",
             pstSrInfo->ntpTimestampMsw, pstSrInfo->ntpTimestampLsw);
@@ -181,28 +181,20 @@ eRtp_Bool populateRcvdSrInfoFromStk(
 
     // populate tRtpSvcRecvReport
     tRtpSvcRecvReport* pstRcvdReport = &(pstSrInfo->stRecvRpt);
-    RtcpRrPacket* pobjRepBlk = pobjSrPkt->getRrPktInfo();
-    std::list<RtcpReportBlock*>& pobjRepBlkList = pobjRepBlk->getReportBlockList();
-    return populateRcvdReportFromStk(pobjRepBlkList, pstRcvdReport);
+    return populateRcvdReportFromStk(objSrPkt, pstRcvdReport);
 }
 
 eRtp_Bool populateRcvdFbInfoFromStk(
-        IN RtcpFbPacket* m_pobjRtcpFbPkt, OUT tRtpSvcIndSt_ReceiveRtcpFeedbackInd* stFbRtcpMsg)
+        IN RtcpBlockView& objFbPkt, OUT tRtpSvcIndSt_ReceiveRtcpFeedbackInd* stFbRtcpMsg)
 {
-    if (m_pobjRtcpFbPkt != nullptr)
-    {
-        stFbRtcpMsg->wPayloadType = m_pobjRtcpFbPkt->getRtcpHdrInfo()->getPacketType();
-        stFbRtcpMsg->wFmt = m_pobjRtcpFbPkt->getRtcpHdrInfo()->getReceptionReportCount();
-        stFbRtcpMsg->dwMediaSsrc = m_pobjRtcpFbPkt->getMediaSsrc();
-        stFbRtcpMsg->wMsgLen = m_pobjRtcpFbPkt->getRtcpHdrInfo()->getLength();
-        if (m_pobjRtcpFbPkt->getFCI() != nullptr)
-        {
-            stFbRtcpMsg->pMsg = m_pobjRtcpFbPkt->getFCI()->getBuffer();
-        }
-        return eRTP_TRUE;
-    }
+    stFbRtcpMsg->wPayloadType = objFbPkt.getPacketType();
+    stFbRtcpMsg->wFmt = objFbPkt.getCount();
+    stFbRtcpMsg->dwMediaSsrc = objFbPkt.getMediaSsrc();
+    stFbRtcpMsg->wMsgLen = objFbPkt.getLength();
+    // FCI is not copied, it points into the received packet
+    stFbRtcpMsg->pMsg = objFbPkt.getFci();
 
-    return eRTP_FALSE;
+    return eRTP_TRUE;
 }
 
 RtpDt_Void populateRtpProfile(OUT RtpStackProfile* pobjStackProfile)
@@ -212,16 +204,16 @@ RtpDt_Void populateRtpProfile(OUT RtpStackProfile* pobjStackProfile)
     pobjStackProfile->setTermNumber(RTP_CONF_SSRC_SEED);
 }
 
-RtpBuffer* SetRtpHeaderExtension(IN tRtpSvc_SendRtpPacketParam* pstRtpParam)
+RtpDt_Void SetRtpHeaderExtension(IN tRtpSvc_SendRtpPacketParam* pstRtpParam,
+        IN RtpDt_UChar* pucXHdrBuf, OUT RtpBuffer* pobjXHdr)
 {
-    RtpBuffer* pobjXHdr = new RtpBuffer();
+    pobjXHdr->setBufferInfo(0, nullptr);
 
-    // HDR extension
+    // HDR extension, it is formed in the buffer of the caller to avoid allocation per packet
     if (pstRtpParam->bXbit)
     {
         const RtpDt_Int32 headerSize = 4;
         RtpDt_Int32 nBufferSize = headerSize + pstRtpParam->wExtLen * sizeof(int32_t);
-        RtpDt_UChar* pBuf = new RtpDt_UChar[nBufferSize];
 
         if (pstRtpParam->wExtLen * sizeof(int32_t) != pstRtpParam->nExtDataSize)
         {
@@ -229,23 +221,26 @@ RtpBuffer* SetRtpHeaderExtension(IN tRtpSvc_SendRtpPacketParam* pstRtpParam)
                     pstRtpParam->wExtLen, pstRtpParam->nExtDataSize);
         }
 
+        if (nBufferSize > RTP_MAX_XHDR_LEN || pstRtpParam->nExtDataSize > nBufferSize - headerSize)
+        {
+            RTP_TRACE_WARNING("SetRtpHeaderExtension too large len[%d], size[%d]",
+                    pstRtpParam->wExtLen, pstRtpParam->nExtDataSize);
+            return;
+        }
+
         // define by profile
-        pBuf[0] = (((unsigned)pstRtpParam->wDefinedByProfile) >> 8) & 0x00ff;
-        pBuf[1] = pstRtpParam->wDefinedByProfile & 0x00ff;
+        pucXHdrBuf[0] = (((unsigned)pstRtpParam->wDefinedByProfile) >> 8) & 0x00ff;
+        pucXHdrBuf[1] = pstRtpParam->wDefinedByProfile & 0x00ff;
 
         // number of the extension data set
-        pBuf[2] = (((unsigned)pstRtpParam->wExtLen) >> 8) & 0x00ff;
-        pBuf[3] = (pstRtpParam->wExtLen) & 0x00ff;
+        pucXHdrBuf[2] = (((unsigned)pstRtpParam->wExtLen) >> 8) & 0x00ff;
+        pucXHdrBuf[3] = (pstRtpParam->wExtLen) & 0x00ff;
 
-        memcpy(pBuf + 4, pstRtpParam->pExtData, pstRtpParam->nExtDataSize);
-        pobjXHdr->setBufferInfo(nBufferSize, pBuf);
-    }
-    else
-    {
-        pobjXHdr->setBufferInfo(0, nullptr);
+        memcpy(pucXHdrBuf + 4, pstRtpParam->pExtData, pstRtpParam->nExtDataSize);
+        memset(pucXHdrBuf + 4 + pstRtpParam->nExtDataSize, 0,
+                nBufferSize - headerSize - pstRtpParam->nExtDataSize);
+        pobjXHdr->setBufferInfo(nBufferSize, pucXHdrBuf);
     }
-
-    return pobjXHdr;
 }
 
 RtpDt_UInt16 GetRtpHeaderExtensionSize(eRtp_Bool bEnableCVO)
@@ -256,24 +251,20 @@ RtpDt_UInt16 GetRtpHeaderExtensionSize(eRtp_Bool bEnableCVO)
     return 0;
 }
 
+RtpStack* createRtpStack()
+{
+    RtpStackProfile* pobjStackProfile = new RtpStackProfile();
+    populateRtpProfile(pobjStackProfile);
+
+    // the stack owns the profile
+    return new RtpStack(pobjStackProfile);
+}
+
 GLOBAL eRtp_Bool IMS_RtpSvc_Initialize()
 {
     if (g_pobjRtpStack == nullptr)
     {
-        g_pobjRtpStack = new RtpStack();
-        if (g_pobjRtpStack == nullptr)
-        {
-            return eRTP_FALSE;
-        }
-
-        RtpStackProfile* pobjStackProfile = new RtpStackProfile();
-        if (pobjStackProfile == nullptr)
-        {
-            return eRTP_FALSE;
-        }
-
-        populateRtpProfile(pobjStackProfile);
-        g_pobjRtpStack->setStackProfile(pobjStackProfile);
+        g_pobjRtpStack = createRtpStack();
     }
 
     return eRTP_TRUE;
@@ -290,15 +281,43 @@ GLOBAL eRtp_Bool IMS_RtpSvc_Deinitialize()
     return eRTP_TRUE;
 }
 
-GLOBAL eRtp_Bool IMS_RtpSvc_CreateSession(IN RtpDt_Char* szLocalIP, IN RtpDt_UInt32 port,
-        IN RtpDt_Void* pAppData, OUT RtpDt_UInt32* puSsrc, OUT RTPSESSIONID* hRtpSession)
+GLOBAL eRtp_Bool IMS_RtpSvc_CreateStack(OUT RTPSTACKID* hRtpStack)
+{
+    if (hRtpStack == nullptr)
+    {
+        return eRTP_FALSE;
+    }
+
+    *hRtpStack = reinterpret_cast<RtpDt_Void*>(createRtpStack());
+    return eRTP_TRUE;
+}
+
+GLOBAL eRtp_Bool IMS_RtpSvc_DeleteStack(IN RTPSTACKID hRtpStack)
+{
+    RtpStack* pobjRtpStack = reinterpret_cast<RtpStack*>(hRtpStack);
+
+    if (pobjRtpStack == nullptr || pobjRtpStack == g_pobjRtpStack)
+    {
+        return eRTP_FALSE;
+    }
+
+    delete pobjRtpStack;
+    return eRTP_TRUE;
+}
+
+GLOBAL eRtp_Bool IMS_RtpSvc_CreateSession(IN RTPSTACKID hRtpStack, IN RtpDt_Char* szLocalIP,
+        IN RtpDt_UInt32 port, IN RtpDt_Void* pAppData, OUT RtpDt_UInt32* puSsrc,
+        OUT RTPSESSIONID* hRtpSession)
 {
-    if (g_pobjRtpStack == nullptr || szLocalIP == nullptr)
+    RtpStack* pobjRtpStack =
+            hRtpStack != nullptr ? reinterpret_cast<RtpStack*>(hRtpStack) : g_pobjRtpStack;
+
+    if (pobjRtpStack == nullptr || szLocalIP == nullptr)
     {
         return eRTP_FALSE;
     }
 
-    RtpSession* pobjRtpSession = g_pobjRtpStack->createRtpSession();
+    RtpSession* pobjRtpSession = pobjRtpStack->createRtpSession();
     if (pobjRtpSession == nullptr)
     {
         return eRTP_FALSE;
@@ -315,7 +334,8 @@ GLOBAL eRtp_Bool IMS_RtpSvc_CreateSession(IN RtpDt_Char* szLocalIP, IN RtpDt_UIn
     pobjRtpSession->setRtpPort((RtpDt_UInt16)port);
 
     *puSsrc = pobjRtpSession->getSsrc();
-    *hRtpSession = reinterpret_cast<RtpDt_Void*>(pobjRtpSession);
+    hRtpSession->hRtpStack = reinterpret_cast<RTPSTACKID>(pobjRtpStack);
+    hRtpSession->pvRtpSession = reinterpret_cast<RtpDt_Void*>(pobjRtpSession);
 
     RtpImpl* pobjRtpImpl = new RtpImpl();
     if (pobjRtpImpl == nullptr)
@@ -355,10 +375,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SetPayload(IN RTPSESSIONID hRtpSession,
         return eRTP_FALSE;
     }
 
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
     {
         delete pobjlPayloadInfo;
         return eRTP_FALSE;
@@ -377,24 +396,46 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SetPayload(IN RTPSESSIONID hRtpSession,
 
 GLOBAL eRtp_Bool IMS_RtpSvc_SetRTCPInterval(IN RTPSESSIONID hRtpSession, IN RtpDt_UInt32 nInterval)
 {
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(reinterpret_cast<RtpSession*>(hRtpSession)) ==
-                    eRTP_FAILURE)
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
+    if (pobjRtpSession == nullptr)
+        return eRTP_FALSE;
+
+    pobjRtpSession->setRTCPTimerValue(nInterval);
+    return eRTP_TRUE;
+}
+
+GLOBAL eRtp_Bool IMS_RtpSvc_SetRtcpReducedSize(
+        IN RTPSESSIONID hRtpSession, IN eRtp_Bool bReducedSize)
+{
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
-    (reinterpret_cast<RtpSession*>(hRtpSession))->setRTCPTimerValue(nInterval);
+    pobjRtpSession->setReducedSizeRtcp(bReducedSize);
+    return eRTP_TRUE;
+}
+
+GLOBAL eRtp_Bool IMS_RtpSvc_SetRtcpXrRttBlocks(
+        IN RTPSESSIONID hRtpSession, IN eRtp_Bool bRrt, IN eRtp_Bool bDlrr)
+{
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
+    if (pobjRtpSession == nullptr)
+        return eRTP_FALSE;
+
+    pobjRtpSession->setRtcpXrRttBlocks(bRrt, bDlrr);
     return eRTP_TRUE;
 }
 
 GLOBAL eRtp_Bool IMS_RtpSvc_DeleteSession(IN RTPSESSIONID hRtpSession)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpStack* pobjRtpStack = reinterpret_cast<RtpStack*>(hRtpSession.hRtpStack);
+    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession.pvRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpStack == nullptr)
         return eRTP_FALSE;
 
-    eRTP_STATUS_CODE eDelRtpStrm = g_pobjRtpStack->deleteRtpSession(pobjRtpSession);
+    // the stack removes the session only if it is alive, so the session is deleted only once
+    eRTP_STATUS_CODE eDelRtpStrm = pobjRtpStack->deleteRtpSession(pobjRtpSession);
     if (eDelRtpStrm != RTP_SUCCESS)
     {
         return eRTP_FALSE;
@@ -408,10 +449,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtpPacket(IN RtpServiceListener* pobjRtpServiceL
         IN RTPSESSIONID hRtpSession, IN RtpDt_Char* pBuffer, IN RtpDt_UInt16 wBufferLength,
         IN tRtpSvc_SendRtpPacketParam* pstRtpParam)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     if (pobjRtpSession->isRtpEnabled() == eRTP_FALSE)
@@ -448,13 +488,20 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtpPacket(IN RtpServiceListener* pobjRtpServiceL
     // 2. Set Payload
     pobjRtpPayload->setBufferInfo(wBufferLength, reinterpret_cast<RtpDt_UChar*>(pBuffer));
     eRtp_Bool bUseLastTimestamp = pstRtpParam->bUseLastTimestamp ? eRTP_TRUE : eRTP_FALSE;
+
+    // 3. Set header extension
+    RtpDt_UChar pucXHdrBuf[RTP_MAX_XHDR_LEN];
+    RtpBuffer objXHdr;
+    SetRtpHeaderExtension(pstRtpParam, pucXHdrBuf, &objXHdr);
+
     eRTP_STATUS_CODE eRtpCreateStat = pobjRtpSession->createRtpPacket(pobjRtpPayload, bMbit,
             pstRtpParam->byPayLoadType, bUseLastTimestamp, pstRtpParam->diffFromLastRtpTimestamp,
-            SetRtpHeaderExtension(pstRtpParam), pobjRtpBuf);
+            &objXHdr, pobjRtpBuf);
 
-    // 3. de-init and free the temp variable both in success and failure case
+    // 4. de-init and free the temp variable both in success and failure case
     pobjRtpPayload->setBufferInfo(RTP_ZERO, nullptr);
     delete pobjRtpPayload;
+    objXHdr.setBufferInfo(RTP_ZERO, nullptr);
 
     if (eRtpCreateStat != RTP_SUCCESS)
     {
@@ -490,10 +537,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtpPacket(IN RtpServiceListener* pvIRtpSession,
         IN RtpDt_Char* pPeerIp, IN RtpDt_UInt16 uiPeerPort, OUT RtpDt_UInt32& uiPeerSsrc)
 {
     tRtpSvc_IndicationFromStack stackInd = RTPSVC_RECEIVE_RTP_IND;
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
     {
         return eRTP_FALSE;
     }
@@ -547,16 +593,24 @@ GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtpPacket(IN RtpServiceListener* pvIRtpSession,
 
     pvIRtpSession->OnPeerInd(stackInd, (RtpDt_Void*)&stRtpIndMsg);
 
+    tRtpSvcIndSt_NackRetransmissionInd stNackInd;
+    stNackInd.wSeqNum = stRtpIndMsg.dwSeqNum;
+
+    if (pobjRtpSession->checkNackRetransmission(stNackInd.wSeqNum, stNackInd.dwLatency) ==
+            eRTP_TRUE)
+    {
+        pvIRtpSession->OnPeerInd(RTPSVC_NACK_RETRANSMISSION_IND, (RtpDt_Void*)&stNackInd);
+    }
+
     delete pobjRtpPkt;
     return eRTP_TRUE;
 }
 
 GLOBAL eRtp_Bool IMS_RtpSvc_SessionEnableRTP(IN RTPSESSIONID rtpSessionId)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(rtpSessionId);
+    RtpSession* pobjRtpSession = getRtpSession(rtpSessionId);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     if (pobjRtpSession->enableRtp() == RTP_SUCCESS)
@@ -567,10 +621,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SessionEnableRTP(IN RTPSESSIONID rtpSessionId)
 
 GLOBAL eRtp_Bool IMS_RtpSvc_SessionDisableRTP(IN RTPSESSIONID rtpSessionId)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(rtpSessionId);
+    RtpSession* pobjRtpSession = getRtpSession(rtpSessionId);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     if (pobjRtpSession->disableRtp() == RTP_SUCCESS)
@@ -582,10 +635,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SessionDisableRTP(IN RTPSESSIONID rtpSessionId)
 GLOBAL eRtp_Bool IMS_RtpSvc_SessionEnableRTCP(
         IN RTPSESSIONID hRtpSession, IN eRtp_Bool enableRTCPBye)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     eRTP_STATUS_CODE eRtcpStatus = pobjRtpSession->enableRtcp((eRtp_Bool)enableRTCPBye);
@@ -598,11 +650,10 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SessionEnableRTCP(
 
 GLOBAL eRtp_Bool IMS_RtpSvc_SessionDisableRTCP(IN RTPSESSIONID hRtpSession)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
     eRTP_STATUS_CODE eRtcpStatus = RTP_SUCCESS;
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     eRtcpStatus = pobjRtpSession->disableRtcp();
@@ -616,10 +667,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SessionDisableRTCP(IN RTPSESSIONID hRtpSession)
 
 GLOBAL eRtp_Bool IMS_RtpSvc_SendRtcpByePacket(IN RTPSESSIONID hRtpSession)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     pobjRtpSession->sendRtcpByePacket();
@@ -630,9 +680,8 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtcpRtpFbPacket(IN RTPSESSIONID hRtpSession,
         IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff, IN RtpDt_UInt32 uiLen,
         IN RtpDt_UInt32 uiMediaSsrc)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     pobjRtpSession->sendRtcpRtpFbPacket(uiFbType, pcBuff, uiLen, uiMediaSsrc);
@@ -644,9 +693,8 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtcpPayloadFbPacket(IN RTPSESSIONID hRtpSession,
         IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff, IN RtpDt_UInt32 uiLen,
         IN RtpDt_UInt32 uiMediaSsrc)
 {
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     pobjRtpSession->sendRtcpPayloadFbPacket(uiFbType, pcBuff, uiLen, uiMediaSsrc);
@@ -660,10 +708,9 @@ GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtcpPacket(IN RtpServiceListener* pobjRtpService
 {
     (RtpDt_Void) uiPeerSsrc;
 
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
 
-    if (g_pobjRtpStack == nullptr ||
-            g_pobjRtpStack->isValidRtpSession(pobjRtpSession) == eRTP_FAILURE)
+    if (pobjRtpSession == nullptr)
         return eRTP_FALSE;
 
     if (pMsg == nullptr || uiMsgLength == RTP_ZERO || pcIpAddr == nullptr)
@@ -680,15 +727,12 @@ GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtcpPacket(IN RtpServiceListener* pobjRtpService
     objRtcpBuf.setBufferInfo(uiMsgLength, pMsg);
 
     // process RTCP message
-    RtcpPacket objRtcpPkt;
     eRTP_STATUS_CODE eProcRtcpSta =
-            pobjRtpSession->processRcvdRtcpPkt(&objRmtAddr, uiRtcpPort, &objRtcpBuf, &objRtcpPkt);
+            pobjRtpSession->processRcvdRtcpPkt(&objRmtAddr, uiRtcpPort, &objRtcpBuf);
 
     // clean the data
     objRtcpBuf.setBufferInfo(RTP_ZERO, nullptr);
     objRmtAddr.setBufferInfo(RTP_ZERO, nullptr);
-    RtpBuffer objRtpPayload;
-    objRtpPayload.setBufferInfo(RTP_ZERO, nullptr);
 
     if (eProcRtcpSta != RTP_SUCCESS)
     {
@@ -696,14 +740,31 @@ GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtcpPacket(IN RtpServiceListener* pobjRtpService
         return eRTP_FALSE;
     }
 
-    // inform to application
-    std::list<RtcpSrPacket*>& pobjSrList = objRtcpPkt.getSrPacketList();
-    if (pobjSrList.size() > RTP_ZERO)
+    // inform to application, the packet is already validated by the session
+    RtcpCompoundIterator objIterator(pMsg, uiMsgLength);
+    RtcpBlockView objBlock;
+    RtcpBlockView objSrBlock;
+    RtcpBlockView objRrBlock;
+
+    // application supports the first SR or RR of the compound packet
+    while (objIterator.next(objBlock) == eRTP_TRUE)
+    {
+        if (objBlock.getPacketType() == RTCP_SR && objSrBlock.getBuffer() == nullptr)
+        {
+            objSrBlock = objBlock;
+        }
+        else if (objBlock.getPacketType() == RTCP_RR && objRrBlock.getBuffer() == nullptr)
+        {
+            objRrBlock = objBlock;
+        }
+    }
+
+    if (objSrBlock.getBuffer() != nullptr)
     {
         tRtpSvc_IndicationFromStack stackInd = RTPSVC_RECEIVE_RTCP_SR_IND;
         tNotifyReceiveRtcpSrInd stSrRtcpMsg;
 
-        if (populateRcvdSrInfoFromStk(pobjSrList, &stSrRtcpMsg) == eRTP_TRUE)
+        if (populateRcvdSrInfoFromStk(objSrBlock, &stSrRtcpMsg) == eRTP_TRUE)
         {
             pobjRtpServiceListener->OnPeerInd(stackInd, (RtpDt_Void*)&stSrRtcpMsg);
         }
@@ -711,43 +772,39 @@ GLOBAL eRtp_Bool IMS_RtpSvc_ProcRtcpPacket(IN RtpServiceListener* pobjRtpService
         RtpDt_UInt32 rttd = pobjRtpSession->getRTTD();
         pobjRtpServiceListener->OnPeerRtcpComponents((RtpDt_Void*)&rttd);
     }
-    else
+    else if (objRrBlock.getBuffer() != nullptr)
     {
-        std::list<RtcpRrPacket*>& pobjRrList = objRtcpPkt.getRrPacketList();
-        if (pobjRrList.size() > RTP_ZERO)
-        {
-            tRtpSvc_IndicationFromStack stackInd = RTPSVC_RECEIVE_RTCP_RR_IND;
-            tNotifyReceiveRtcpRrInd stRrRtcpMsg;
-
-            if (populateRcvdRrInfoFromStk(pobjRrList, &stRrRtcpMsg) == eRTP_TRUE)
-            {
-                pobjRtpServiceListener->OnPeerInd(stackInd, (RtpDt_Void*)&stRrRtcpMsg);
-            }
+        tRtpSvc_IndicationFromStack stackInd = RTPSVC_RECEIVE_RTCP_RR_IND;
+        tNotifyReceiveRtcpRrInd stRrRtcpMsg;
 
-            RtpDt_UInt32 rttd = pobjRtpSession->getRTTD();
-            pobjRtpServiceListener->OnPeerRtcpComponents((RtpDt_Void*)&rttd);
+        if (populateRcvdRrInfoFromStk(objRrBlock, &stRrRtcpMsg) == eRTP_TRUE)
+        {
+            pobjRtpServiceListener->OnPeerInd(stackInd, (RtpDt_Void*)&stRrRtcpMsg);
         }
+
+        RtpDt_UInt32 rttd = pobjRtpSession->getRTTD();
+        pobjRtpServiceListener->OnPeerRtcpComponents((RtpDt_Void*)&rttd);
     }  // end else
 
     // process rtcp fb packet and inform to application
-    std::list<RtcpFbPacket*>& pobjFbList = objRtcpPkt.getFbPacketList();
+    objIterator.reset();
 
-    for (auto& pobjFbPkt : pobjFbList)
+    while (objIterator.next(objBlock) == eRTP_TRUE)
     {
-        // get Fb packet data
-        if (pobjFbPkt == nullptr)
+        if (objBlock.getPacketType() != RTCP_RTPFB && objBlock.getPacketType() != RTCP_PSFB)
         {
-            return eRTP_FALSE;
+            continue;
         }
+
         tRtpSvc_IndicationFromStack stackInd = RTPSVC_RECEIVE_RTCP_FB_IND;
-        if (pobjFbPkt->getRtcpHdrInfo()->getPacketType() == RTCP_PSFB)
+        if (objBlock.getPacketType() == RTCP_PSFB)
         {
             stackInd = RTPSVC_RECEIVE_RTCP_PAYLOAD_FB_IND;
         }
         tRtpSvcIndSt_ReceiveRtcpFeedbackInd stFbRtcpMsg;
-        if (populateRcvdFbInfoFromStk(pobjFbPkt, &stFbRtcpMsg) == eRTP_TRUE)
+        if (populateRcvdFbInfoFromStk(objBlock, &stFbRtcpMsg) == eRTP_TRUE)
             pobjRtpServiceListener->OnPeerInd(stackInd, (RtpDt_Void*)&stFbRtcpMsg);
-    }  // pobjFbList End
+    }  // Fb packets End
 
     return eRTP_TRUE;
 }
@@ -757,7 +814,10 @@ GLOBAL eRtp_Bool IMS_RtpSvc_SendRtcpXrPacket(
 {
     RTP_TRACE_MESSAGE("IMS_RtpSvc_SendRtcpXrPacket", 0, 0);
 
-    RtpSession* pobjRtpSession = reinterpret_cast<RtpSession*>(hRtpSession);
+    RtpSession* pobjRtpSession = getRtpSession(hRtpSession);
+    if (pobjRtpSession == nullptr)
+        return eRTP_FALSE;
+
     pobjRtpSession->sendRtcpXrPacket(m_pBlockBuffer, nblockLength);
 
     return eRTP_TRUE;
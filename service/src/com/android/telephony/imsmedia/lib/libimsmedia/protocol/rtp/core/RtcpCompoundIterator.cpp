@@ -0,0 +1,383 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtcpCompoundIterator.h>
+#include <RtpOsUtil.h>
+#include <RtpTrace.h>
+
+RtcpBlockView::RtcpBlockView() :
+        m_pucBuffer(nullptr),
+        m_usBodyLen(RTP_ZERO),
+        m_ucVersion(RTP_ZERO),
+        m_bPadding(eRTP_FALSE),
+        m_ucCount(RTP_ZERO),
+        m_ucPacketType(RTP_ZERO),
+        m_uiSsrc(RTP_ZERO)
+{
+}
+
+RtcpBlockView::~RtcpBlockView() {}
+
+RtpDt_Void RtcpBlockView::setBlock(IN RtpDt_UChar* pucBuffer, IN RtpDt_UInt16 usBodyLen)
+{
+    m_pucBuffer = pucBuffer;
+    m_usBodyLen = usBodyLen;
+
+    RtpDt_UInt32 uiByte4Data = RtpOsUtil::Ntohl(*(reinterpret_cast<RtpDt_UInt32*>(pucBuffer)));
+    m_ucPacketType = (uiByte4Data >> RTP_16) & 0x000000FF;
+    uiByte4Data = uiByte4Data >> RTP_24;
+    m_ucVersion = (RtpDt_UChar)(uiByte4Data >> RTP_SIX) & 0x00000003;
+    m_bPadding = ((uiByte4Data >> RTP_FIVE) & 0x00000001) ? eRTP_TRUE : eRTP_FALSE;
+    m_ucCount = (RtpDt_UChar)(uiByte4Data & 0x0000001F);
+
+    m_uiSsrc = RtpOsUtil::Ntohl(*(reinterpret_cast<RtpDt_UInt32*>(pucBuffer + RTP_WORD_SIZE)));
+}
+
+RtpDt_UChar RtcpBlockView::getVersion()
+{
+    return m_ucVersion;
+}
+
+eRtp_Bool RtcpBlockView::getPadding()
+{
+    return m_bPadding;
+}
+
+RtpDt_UChar RtcpBlockView::getCount()
+{
+    return m_ucCount;
+}
+
+RtpDt_UChar RtcpBlockView::getPacketType()
+{
+    return m_ucPacketType;
+}
+
+RtpDt_UInt32 RtcpBlockView::getSsrc()
+{
+    return m_uiSsrc;
+}
+
+RtpDt_UChar* RtcpBlockView::getBuffer()
+{
+    return m_pucBuffer;
+}
+
+RtpDt_UChar* RtcpBlockView::getBody()
+{
+    return m_pucBuffer == nullptr ? nullptr : m_pucBuffer + RTCP_FIXED_HDR_LEN;
+}
+
+RtpDt_UInt16 RtcpBlockView::getBodyLength()
+{
+    return m_usBodyLen;
+}
+
+RtpDt_UInt16 RtcpBlockView::getLength()
+{
+    return m_usBodyLen + RTP_WORD_SIZE;
+}
+
+eRtp_Bool RtcpBlockView::getSenderInfo(OUT tRTCP_SENDER_INFO* pstSenderInfo)
+{
+    if (pstSenderInfo == nullptr || m_ucPacketType != RTCP_SR ||
+            m_usBodyLen < RTCP_SR_PACKET_LENGTH)
+    {
+        return eRTP_FALSE;
+    }
+
+    RtpDt_UInt32* puiBody = reinterpret_cast<RtpDt_UInt32*>(getBody());
+    pstSenderInfo->stNtpTimestamp.m_uiNtpHigh32Bits = RtpOsUtil::Ntohl(puiBody[0]);
+    pstSenderInfo->stNtpTimestamp.m_uiNtpLow32Bits = RtpOsUtil::Ntohl(puiBody[1]);
+    pstSenderInfo->uiRtpTimestamp = RtpOsUtil::Ntohl(puiBody[2]);
+    pstSenderInfo->uiSendPktCount = RtpOsUtil::Ntohl(puiBody[3]);
+    pstSenderInfo->uiSendOctCount = RtpOsUtil::Ntohl(puiBody[4]);
+
+    return eRTP_TRUE;
+}
+
+RtpDt_UInt16 RtcpBlockView::getReportBlockCount()
+{
+    RtpDt_UInt16 usRepBlkLen = m_usBodyLen;
+
+    if (m_ucPacketType == RTCP_SR)
+    {
+        if (usRepBlkLen < RTCP_SR_PACKET_LENGTH)
+        {
+            return RTP_ZERO;
+        }
+        usRepBlkLen -= RTCP_SR_PACKET_LENGTH;
+    }
+    else if (m_ucPacketType != RTCP_RR)
+    {
+        return RTP_ZERO;
+    }
+
+    RtpDt_UInt16 usCount = usRepBlkLen / RTP_DEF_REP_BLK_SIZE;
+    return usCount < m_ucCount ? usCount : m_ucCount;
+}
+
+eRtp_Bool RtcpBlockView::getReportBlock(
+        IN RtpDt_UInt16 usIndex, OUT tRTCP_REPORT_BLOCK_INFO* pstReportBlock)
+{
+    if (pstReportBlock == nullptr || usIndex >= getReportBlockCount())
+    {
+        return eRTP_FALSE;
+    }
+
+    RtpDt_UChar* pucRepBlk = getBody() + (usIndex * RTP_DEF_REP_BLK_SIZE);
+    if (m_ucPacketType == RTCP_SR)
+    {
+        pucRepBlk += RTCP_SR_PACKET_LENGTH;
+    }
+
+    RtpDt_UInt32* puiRepBlk = reinterpret_cast<RtpDt_UInt32*>(pucRepBlk);
+    pstReportBlock->uiSsrc = RtpOsUtil::Ntohl(puiRepBlk[0]);
+
+    RtpDt_UInt32 uiByte4Data = RtpOsUtil::Ntohl(puiRepBlk[1]);
+    pstReportBlock->uiCumNumPktLost = uiByte4Data & 0x00FFFFFF;
+    pstReportBlock->ucFracLost = (RtpDt_UChar)((uiByte4Data >> RTP_24) & 0x000000FF);
+
+    pstReportBlock->uiExtHighSeqRcv = RtpOsUtil::Ntohl(puiRepBlk[2]);
+    pstReportBlock->uiJitter = RtpOsUtil::Ntohl(puiRepBlk[3]);
+    pstReportBlock->uiLastSR = RtpOsUtil::Ntohl(puiRepBlk[4]);
+    pstReportBlock->uiDelayLastSR = RtpOsUtil::Ntohl(puiRepBlk[5]);
+
+    return eRTP_TRUE;
+}
+
+RtpDt_UInt32 RtcpBlockView::getMediaSsrc()
+{
+    if (m_usBodyLen < RTP_WORD_SIZE)
+    {
+        return RTP_ZERO;
+    }
+
+    return RtpOsUtil::Ntohl(*(reinterpret_cast<RtpDt_UInt32*>(getBody())));
+}
+
+RtpDt_UChar* RtcpBlockView::getFci()
+{
+    if (m_usBodyLen <= RTP_WORD_SIZE)
+    {
+        return nullptr;
+    }
+
+    return getBody() + RTP_WORD_SIZE;
+}
+
+RtpDt_UInt16 RtcpBlockView::getFciLength()
+{
+    return m_usBodyLen > RTP_WORD_SIZE ? m_usBodyLen - RTP_WORD_SIZE : RTP_ZERO;
+}
+
+RtpDt_UInt16 RtcpBlockView::getByeSsrcCount()
+{
+    if (m_ucPacketType != RTCP_BYE || m_ucCount == RTP_ZERO)
+    {
+        return RTP_ZERO;
+    }
+
+    // the first SSRC is the one in the fixed header
+    RtpDt_UInt16 usCount = (m_usBodyLen / RTP_WORD_SIZE) + RTP_ONE;
+    return usCount < m_ucCount ? usCount : m_ucCount;
+}
+
+RtpDt_UInt32 RtcpBlockView::getByeSsrc(IN RtpDt_UInt16 usIndex)
+{
+    if (usIndex >= getByeSsrcCount())
+    {
+        return RTP_ZERO;
+    }
+
+    if (usIndex == RTP_ZERO)
+    {
+        return m_uiSsrc;
+    }
+
+    RtpDt_UInt32* puiSsrcList = reinterpret_cast<RtpDt_UInt32*>(getBody());
+    return RtpOsUtil::Ntohl(puiSsrcList[usIndex - RTP_ONE]);
+}
+
+eRtp_Bool RtcpBlockView::getNextXrBlock(IN_OUT RtpDt_UInt16& usOffset,
+        OUT RtpDt_UChar& ucBlockType, OUT RtpDt_UChar*& pucBlock, OUT RtpDt_UInt16& usBlockLen)
+{
+    if (m_ucPacketType != RTCP_XR || usOffset + RTP_WORD_SIZE > m_usBodyLen)
+    {
+        return eRTP_FALSE;
+    }
+
+    /*
+        0                   1                   2                   3
+        0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
+       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+       |      BT       | type-specific |         block length          |
+       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+       :             type-specific block contents                      :
+       +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
+    */
+    RtpDt_UChar* pucXrBlk = getBody() + usOffset;
+    RtpDt_UInt32 uiByte4Data = RtpOsUtil::Ntohl(*(reinterpret_cast<RtpDt_UInt32*>(pucXrBlk)));
+    RtpDt_UInt32 uiBlockLen = ((uiByte4Data & 0x0000FFFF) + RTP_ONE) * RTP_WORD_SIZE;
+
+    if (usOffset + uiBlockLen > m_usBodyLen)
+    {
+        RTP_TRACE_WARNING("[getNextXrBlock] invalid block length[%d], remaining[%d]", uiBlockLen,
+                m_usBodyLen - usOffset);
+        return eRTP_FALSE;
+    }
+
+    ucBlockType = (RtpDt_UChar)(uiByte4Data >> RTP_24);
+    pucBlock = pucXrBlk;
+    usBlockLen = (RtpDt_UInt16)uiBlockLen;
+    usOffset += usBlockLen;
+
+    return eRTP_TRUE;
+}
+
+RtcpCompoundIterator::RtcpCompoundIterator(IN RtpDt_UChar* pucBuffer, IN RtpDt_UInt32 uiLength) :
+        m_pucBuffer(pucBuffer),
+        m_uiLength(pucBuffer == nullptr ? RTP_ZERO : uiLength),
+        m_uiCurPos(RTP_ZERO),
+        m_eStatus(RTP_SUCCESS)
+{
+}
+
+RtcpCompoundIterator::~RtcpCompoundIterator() {}
+
+RtpDt_Void RtcpCompoundIterator::reset()
+{
+    m_uiCurPos = RTP_ZERO;
+    m_eStatus = RTP_SUCCESS;
+}
+
+eRtp_Bool RtcpCompoundIterator::next(OUT RtcpBlockView& objView)
+{
+    if (m_eStatus != RTP_SUCCESS || m_uiCurPos + RTCP_FIXED_HDR_LEN > m_uiLength)
+    {
+        return eRTP_FALSE;
+    }
+
+    RtpDt_UChar* pucBuffer = m_pucBuffer + m_uiCurPos;
+    RtpDt_UInt32 uiByte4Data = RtpOsUtil::Ntohl(*(reinterpret_cast<RtpDt_UInt32*>(pucBuffer)));
+
+    RtpDt_UChar ucVersion = (RtpDt_UChar)(uiByte4Data >> (RTP_24 + RTP_SIX)) & 0x00000003;
+    if (ucVersion != RTP_VERSION_NUM)
+    {
+        RTP_TRACE_ERROR("[RtcpCompoundIterator] RTCP version[%d] is Invalid.", ucVersion, RTP_ZERO);
+        m_eStatus = RTP_INVALID_MSG;
+        return eRTP_FALSE;
+    }
+
+    // length in 32-bit words minus one, the sender SSRC is counted in it
+    RtpDt_UInt32 uiPktLen = (uiByte4Data & 0x0000FFFF) * RTP_WORD_SIZE;
+    RtpDt_UInt32 uiRemaining = m_uiLength - m_uiCurPos - RTCP_FIXED_HDR_LEN;
+    if (uiPktLen < RTP_WORD_SIZE || uiPktLen - RTP_WORD_SIZE > uiRemaining)
+    {
+        RTP_TRACE_ERROR("[RtcpCompoundIterator] Report length is Invalid. ReportLen:%d, "
+                        "RtcpLen:%d",
+                uiPktLen, uiRemaining);
+        m_eStatus = RTP_INVALID_MSG;
+        return eRTP_FALSE;
+    }
+
+    objView.setBlock(pucBuffer, uiPktLen - RTP_WORD_SIZE);
+    m_uiCurPos += uiPktLen + RTP_WORD_SIZE;
+
+    return eRTP_TRUE;
+}
+
+eRTP_STATUS_CODE RtcpCompoundIterator::getStatus()
+{
+    return m_eStatus;
+}
+
+eRTP_STATUS_CODE RtcpCompoundIterator::validate()
+{
+    if (m_pucBuffer == nullptr || m_uiLength < RTP_WORD_SIZE)
+    {
+        return RTP_INVALID_PARAMS;
+    }
+
+    // RTCP with only common header case.
+    if (m_uiLength == RTP_WORD_SIZE)
+    {
+        return RTP_SUCCESS;
+    }
+
+    reset();
+
+    eRtp_Bool bKnownPkt = eRTP_FALSE;
+    eRTP_STATUS_CODE eResult = RTP_SUCCESS;
+    RtcpBlockView objView;
+
+    while (next(objView) == eRTP_TRUE)
+    {
+        switch (objView.getPacketType())
+        {
+            case RTCP_SR:
+                if (objView.getBodyLength() < RTCP_SR_PACKET_LENGTH)
+                {
+                    RTP_TRACE_ERROR("[RtcpCompoundIterator] SR length[%d] is Invalid.",
+                            objView.getBodyLength(), RTP_ZERO);
+                    eResult = RTP_FAILURE;
+                }
+                bKnownPkt = eRTP_TRUE;
+                break;
+            case RTCP_RTPFB:
+            case RTCP_PSFB:
+                if (objView.getBodyLength() < RTP_WORD_SIZE)
+                {
+                    RTP_TRACE_ERROR("[RtcpCompoundIterator] FB length[%d] is Invalid.",
+                            objView.getBodyLength(), RTP_ZERO);
+                    eResult = RTP_INVALID_MSG;
+                }
+                bKnownPkt = eRTP_TRUE;
+                break;
+            case RTCP_RR:
+            case RTCP_SDES:
+            case RTCP_BYE:
+            case RTCP_APP:
+            case RTCP_XR:
+                bKnownPkt = eRTP_TRUE;
+                break;
+            default:
+                // unknown packets are skipped as RtcpPacket::decodeRtcpPacket does
+                RTP_TRACE_WARNING("[RtcpCompoundIterator] Invalid RTCP MSG type[%d] received",
+                        objView.getPacketType(), RTP_ZERO);
+                break;
+        }
+
+        if (eResult != RTP_SUCCESS)
+        {
+            break;
+        }
+    }
+
+    if (eResult == RTP_SUCCESS)
+    {
+        eResult = getStatus();
+    }
+
+    if (eResult == RTP_SUCCESS && bKnownPkt == eRTP_FALSE)
+    {
+        RTP_TRACE_ERROR("[RtcpCompoundIterator] no rtcp sr,rr,fb packets", RTP_ZERO, RTP_ZERO);
+        eResult = RTP_DECODE_ERROR;
+    }
+
+    reset();
+    return eResult;
+}
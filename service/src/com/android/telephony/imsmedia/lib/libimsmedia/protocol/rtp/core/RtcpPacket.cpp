@@ -452,9 +452,8 @@ eRTP_STATUS_CODE RtcpPacket::formRtcpPacket(OUT RtpBuffer* pobjRtcpPktBuf)
         }
     }
 
-    if (m_objFbPktList.size() != RTP_ZERO)
+    for (auto& pobjRtcpFbPkt : m_objFbPktList)
     {
-        RtcpFbPacket* pobjRtcpFbPkt = m_objFbPktList.front();
         eEncodeRes = pobjRtcpFbPkt->formRtcpFbPacket(pobjRtcpPktBuf);
         if (eEncodeRes != RTP_SUCCESS)
         {
@@ -475,3 +474,28 @@ eRTP_STATUS_CODE RtcpPacket::formRtcpPacket(OUT RtpBuffer* pobjRtcpPktBuf)
 
     return RTP_SUCCESS;
 }  // formRtcpPacket
+
+eRTP_STATUS_CODE RtcpPacket::formReducedSizeRtcpPacket(OUT RtpBuffer* pobjRtcpPktBuf)
+{
+    RTP_TRACE_MESSAGE("formReducedSizeRtcpPacket", 0, 0);
+    pobjRtcpPktBuf->setLength(RTP_ZERO);
+
+    if (m_objFbPktList.size() == RTP_ZERO)
+    {
+        RTP_TRACE_WARNING("[formReducedSizeRtcpPacket] no Fb pkt", RTP_ZERO, RTP_ZERO);
+        return RTP_FAILURE;
+    }
+
+    for (auto& pobjRtcpFbPkt : m_objFbPktList)
+    {
+        eRTP_STATUS_CODE eEncodeRes = pobjRtcpFbPkt->formRtcpFbPacket(pobjRtcpPktBuf);
+        if (eEncodeRes != RTP_SUCCESS)
+        {
+            RTP_TRACE_WARNING(
+                    "[formReducedSizeRtcpPacket] Error in Fb pkt encoding.", RTP_ZERO, RTP_ZERO);
+            return eEncodeRes;
+        }
+    }
+
+    return RTP_SUCCESS;
+}  // formReducedSizeRtcpPacket
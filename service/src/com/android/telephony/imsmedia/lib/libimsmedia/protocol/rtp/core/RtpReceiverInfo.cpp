@@ -30,6 +30,8 @@ RtpReceiverInfo::RtpReceiverInfo() :
         m_prevRtpTimestamp(RTP_ZERO),
         m_stPreSrTimestamp(RTP_ZERO),
         m_stLastSrNtpTimestamp(RTP_ZERO),
+        m_uiLastRrtTimestamp(RTP_ZERO),
+        m_uiLastRrtRcvdTime(RTP_ZERO),
         m_bIsFirstRtp(eRTP_TRUE)
 
 {
@@ -299,6 +301,31 @@ RtpDt_Void RtpReceiverInfo::setLastSrNtpTimestamp(IN tRTP_NTP_TIME* pstNtpTs)
     m_stLastSrNtpTimestamp = RtpStackUtil::getMidFourOctets(pstNtpTs);
 }
 
+RtpDt_Void RtpReceiverInfo::setLastRrtTimestamp(
+        IN tRTP_NTP_TIME* pstRrtTs, IN tRTP_NTP_TIME* pstRcvdTs)
+{
+    m_uiLastRrtTimestamp = RtpStackUtil::getMidFourOctets(pstRrtTs);
+    m_uiLastRrtRcvdTime = RtpStackUtil::getMidFourOctets(pstRcvdTs);
+}
+
+RtpDt_UInt32 RtpReceiverInfo::getLastRrtTimestamp()
+{
+    return m_uiLastRrtTimestamp;
+}
+
+RtpDt_UInt32 RtpReceiverInfo::delaySinceLastRrt()
+{
+    tRTP_NTP_TIME stCurNtpTimestamp = {RTP_ZERO, RTP_ZERO};
+
+    if (m_uiLastRrtTimestamp == RTP_ZERO)
+    {
+        return RTP_ZERO;
+    }
+
+    RtpOsUtil::GetNtpTime(stCurNtpTimestamp);
+    return RtpStackUtil::getMidFourOctets(&stCurNtpTimestamp) - m_uiLastRrtRcvdTime;
+}  // delaySinceLastRrt
+
 RtpDt_Void RtpReceiverInfo::setprevRtpTimestamp(IN RtpDt_UInt32 pstRtpTs)
 {
     m_prevRtpTimestamp = pstRtpTs;
@@ -22,7 +22,6 @@
 #include <RtpReceiverInfo.h>
 #include <RtcpPacket.h>
 #include <RtcpChunk.h>
-#include <RtpSessionManager.h>
 #include <RtcpFbPacket.h>
 
 extern RtpDt_Void Rtp_RtcpTimerCb(IN RtpDt_Void* pvTimerId, IN RtpDt_Void* pvData);
@@ -50,17 +49,26 @@ RtpSession::RtpSession() :
         m_uiRtcpSendOctCount(RTP_ZERO),
         m_bSelfCollisionByeSent(eRTP_FAILURE),
         m_pTimerId(nullptr),
+        m_ulCurRtpTime(RTP_ZERO),
+        m_bRtpSendPkt(eRTP_FALSE),
         m_bRtcpSendPkt(eRTP_FALSE),
+        m_bRtcpSrPending(eRTP_FALSE),
+        m_uiRtcpSrPktCount(RTP_ZERO),
+        m_uiRtcpSrOctCount(RTP_ZERO),
         m_bSndRtcpByePkt(eRTP_FALSE),
         m_lastRTTDelay(RTP_ZERO),
         m_bisXr(eRTP_FALSE),
-        m_bFirstRtpRecvd(eRTP_FALSE)
+        m_bFirstRtpRecvd(eRTP_FALSE),
+        m_bReducedSizeRtcp(eRTP_FALSE),
+        m_bXrRrtBlock(eRTP_FALSE),
+        m_bXrDlrrBlock(eRTP_FALSE)
 {
     m_pobjRtcpCfgInfo = new RtcpConfigInfo();
     m_pobjRtpRcvrInfoList = new std::list<RtpReceiverInfo*>();
     m_pobjPayloadInfo = new RtpPayloadInfo();
     m_pobjUtlRcvrList = nullptr;
     m_stRtcpXr.m_pBlockBuffer = nullptr;
+    memset(m_stNackRecords, RTP_ZERO, sizeof(m_stNackRecords));
 }
 
 RtpSession::RtpSession(IN RtpStack* pobjStack) :
@@ -86,22 +94,33 @@ RtpSession::RtpSession(IN RtpStack* pobjStack) :
         m_uiRtcpSendOctCount(RTP_ZERO),
         m_bSelfCollisionByeSent(eRTP_FAILURE),
         m_pTimerId(nullptr),
+        m_ulCurRtpTime(RTP_ZERO),
+        m_bRtpSendPkt(eRTP_FALSE),
         m_bRtcpSendPkt(eRTP_FALSE),
+        m_bRtcpSrPending(eRTP_FALSE),
+        m_uiRtcpSrPktCount(RTP_ZERO),
+        m_uiRtcpSrOctCount(RTP_ZERO),
         m_bSndRtcpByePkt(eRTP_FALSE),
         m_lastRTTDelay(RTP_ZERO),
         m_bisXr(eRTP_FALSE),
-        m_bFirstRtpRecvd(eRTP_FALSE)
+        m_bFirstRtpRecvd(eRTP_FALSE),
+        m_bReducedSizeRtcp(eRTP_FALSE),
+        m_bXrRrtBlock(eRTP_FALSE),
+        m_bXrDlrrBlock(eRTP_FALSE)
 {
     m_pobjRtcpCfgInfo = new RtcpConfigInfo();
     m_pobjPayloadInfo = new RtpPayloadInfo();
     m_pobjRtpRcvrInfoList = new std::list<RtpReceiverInfo*>();
     m_pobjUtlRcvrList = nullptr;
     m_stRtcpXr.m_pBlockBuffer = nullptr;
+    memset(m_stNackRecords, RTP_ZERO, sizeof(m_stNackRecords));
 }
 
 RtpSession::~RtpSession()
 {
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    std::lock_guard<std::mutex> rxGuard(m_objRxLock);
+    std::lock_guard<std::mutex> txGuard(m_objTxLock);
 
     if (m_pobjTransAddr != nullptr)
     {
@@ -139,6 +158,12 @@ RtpSession::~RtpSession()
         delete pobjRcvrElm;
     }  // for
 
+    for (auto& pobjFbPkt : m_objPendingFbPktList)
+    {
+        delete pobjFbPkt;
+    }
+    m_objPendingFbPktList.clear();
+
     delete m_pobjRtpRcvrInfoList;
     delete m_pobjAppInterface;
     m_pobjRtpRcvrInfoList = nullptr;
@@ -183,6 +208,11 @@ RtpBuffer* RtpSession::getRtpTransAddr()
     return m_pobjTransAddr;
 }
 
+RtpStack* RtpSession::getRtpStack()
+{
+    return m_pobjRtpStack;
+}
+
 eRtp_Bool RtpSession::compareRtpSessions(IN RtpSession* pobjSession)
 {
     if (pobjSession == nullptr)
@@ -226,7 +256,6 @@ eRtp_Bool RtpSession::compareRtpSessions(IN RtpSession* pobjSession)
 
 RtpDt_Void Rtp_RtcpTimerCb(IN RtpDt_Void* pvTimerId, IN RtpDt_Void* pvData)
 {
-    RtpSessionManager* pobjActSesDb = RtpSessionManager::getInstance();
     RtpSession* pobjRtpSession = static_cast<RtpSession*>(pvData);
     if (pobjRtpSession == nullptr)
     {
@@ -234,8 +263,10 @@ RtpDt_Void Rtp_RtcpTimerCb(IN RtpDt_Void* pvTimerId, IN RtpDt_Void* pvData)
         return;
     }
 
-    eRtp_Bool bResult = pobjActSesDb->isValidRtpSession(pvData);
-    if (bResult != eRTP_TRUE)
+    // stopping the timer waits for its callback, the session is checked in its own stack
+    RtpStack* pobjRtpStack = pobjRtpSession->getRtpStack();
+    if (pobjRtpStack == nullptr ||
+            pobjRtpStack->isValidRtpSession(pobjRtpSession) != eRTP_SUCCESS)
     {
         return;
     }
@@ -438,15 +469,25 @@ RtpDt_UInt32 RtpSession::calculateTotalRtcpSize(
     return uiTotalRtcpSize;
 }
 
-RtpDt_Void RtpSession::rtpSetTimestamp()
+RtpDt_Void RtpSession::rtpSetTimestamp(IN eRtp_Bool bNewInterval)
 {
-    RtpOsUtil::GetNtpTime(m_stCurNtpRtcpTs);
+    RtpDt_UInt64 ulCurTime = RtpOsUtil::GetMonotonicTime();
     if (m_bRtcpSendPkt == eRTP_FALSE)
     {
         m_bRtcpSendPkt = eRTP_TRUE;
     }
 
-    RtpDt_UInt32 uiSamplingRate = m_pobjPayloadInfo->getSamplingRate();
+    // take a snapshot of the Tx state, RTP packets sent from now on belong to the next report
+    std::lock_guard<std::mutex> txGuard(m_objTxLock);
+    m_bRtcpSrPending = m_bRtpSendPkt;
+    if (bNewInterval == eRTP_TRUE)
+    {
+        m_bRtpSendPkt = eRTP_FALSE;
+    }
+    m_uiRtcpSrPktCount = m_uiRtpSendPktCount;
+    m_uiRtcpSrOctCount = m_uiRtpSendOctCount;
+
+    m_objTsEngine.getNtpTime(ulCurTime, &m_stCurNtpRtcpTs);
 
     // The RTP timestamp corresponds to the same instant as the NTP timestamp,
     // but it is expressed inthe units of the RTP media clock.
@@ -454,8 +495,9 @@ RtpDt_Void RtpSession::rtpSetTimestamp()
     // because some time will have elapsed since the data in that packet was samples
     // RTP Timestamp = Last RTP Pkt timestamp
     //                 + timegap between last RTP packet and current RTCP packet
-    m_curRtcpTimestamp = RtpStackUtil::calcRtpTimestamp(
-            m_curRtpTimestamp, &m_stCurNtpRtcpTs, &m_stCurNtpTimestamp, uiSamplingRate);
+    m_curRtcpTimestamp = m_curRtpTimestamp +
+            static_cast<RtpDt_UInt32>(RtpTimestampEngine::convertToRtpTicks(
+                    ulCurTime - m_ulCurRtpTime, m_objTsEngine.getSamplingRate()));
 }
 
 eRTP_STATUS_CODE RtpSession::rtpMakeCompoundRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt)
@@ -472,7 +514,7 @@ eRTP_STATUS_CODE RtpSession::rtpMakeCompoundRtcpPacket(IN_OUT RtcpPacket* objRtc
 
     eRTP_STATUS_CODE eEncRes = RTP_FAILURE;
     // check number of packets are sent
-    if ((m_bRtpSendPkt == eRTP_TRUE) || (m_bSelfCollisionByeSent == eRTP_TRUE) ||
+    if ((m_bRtcpSrPending == eRTP_TRUE) || (m_bSelfCollisionByeSent == eRTP_TRUE) ||
             (m_bSndRtcpByePkt == eRTP_TRUE))
     {
         RtpDt_UInt32 uiTotalRtcpSize = RTP_ZERO;
@@ -559,7 +601,7 @@ eRTP_STATUS_CODE RtpSession::rtpMakeCompoundRtcpPacket(IN_OUT RtcpPacket* objRtc
         }
     }
 
-    if (m_bisXr == eRTP_TRUE)
+    if (m_bisXr == eRTP_TRUE || m_bXrRrtBlock == eRTP_TRUE || m_bXrDlrrBlock == eRTP_TRUE)
     {
         eRTP_STATUS_CODE eStatus = RTP_SUCCESS;
         eStatus = populateRtcpXrPacket(objRtcpPkt);
@@ -577,7 +619,8 @@ eRTP_STATUS_CODE RtpSession::rtpMakeCompoundRtcpPacket(IN_OUT RtcpPacket* objRtc
     return RTP_SUCCESS;
 }
 
-eRTP_STATUS_CODE RtpSession::rtpSendRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt)
+eRTP_STATUS_CODE RtpSession::rtpSendRtcpPacket(
+        IN_OUT RtcpPacket* objRtcpPkt, IN eRtp_Bool bReducedSize)
 {
     RtpBuffer* pRtcpBuf = new RtpBuffer();
 
@@ -602,7 +645,15 @@ eRTP_STATUS_CODE RtpSession::rtpSendRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt)
 
     // construct the packet
     eRTP_STATUS_CODE eEncRes = RTP_FAILURE;
-    eEncRes = objRtcpPkt->formRtcpPacket(pRtcpBuf);
+    if (bReducedSize == eRTP_TRUE)
+    {
+        eEncRes = objRtcpPkt->formReducedSizeRtcpPacket(pRtcpBuf);
+    }
+    else
+    {
+        eEncRes = objRtcpPkt->formRtcpPacket(pRtcpBuf);
+    }
+
     if (eEncRes == RTP_SUCCESS)
     {
         // pass the RTCP buffer to application.
@@ -619,11 +670,12 @@ eRTP_STATUS_CODE RtpSession::rtpSendRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt)
         m_pobjAppInterface->rtcpTimerHdlErrorInd(eEncRes);
     }
 
-    // update average rtcp size
+    // update average rtcp size, RFC 5506 counts the reduced-size packets as well
     m_objTimerInfo.updateAvgRtcpSize(pRtcpBuf->getLength());
     delete pRtcpBuf;
 
-    if (m_stRtcpXr.m_pBlockBuffer != nullptr)
+    // the XR block is kept for the next compound packet
+    if (bReducedSize == eRTP_FALSE && m_stRtcpXr.m_pBlockBuffer != nullptr)
     {
         delete m_stRtcpXr.m_pBlockBuffer;
         m_stRtcpXr.m_pBlockBuffer = nullptr;
@@ -635,21 +687,29 @@ eRTP_STATUS_CODE RtpSession::rtpSendRtcpPacket(IN_OUT RtcpPacket* objRtcpPkt)
 RtpDt_Void RtpSession::rtcpTimerExpiry(IN RtpDt_Void* pvTimerId)
 {
     // RtpDt_UInt32 uiSamplingRate = RTP_ZERO;
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
-
-    eRtp_Bool bSessAlive = eRTP_FALSE;
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    std::lock_guard<std::mutex> rxGuard(m_objRxLock);
 
-    RtpSessionManager* pobjActSesDb = RtpSessionManager::getInstance();
-    bSessAlive = pobjActSesDb->isValidRtpSession(this);
+    if (m_bEnableRTCP == eRTP_FALSE)
+    {
+        return;
+    }
 
-    if (!bSessAlive)
+    // the timer was replaced while its callback was waiting for the lock
+    if (m_pTimerId != nullptr && m_pTimerId != pvTimerId)
     {
         return;
     }
 
-    if (m_pTimerId == pvTimerId)
+    m_pTimerId = nullptr;
+
     {
-        m_pTimerId = nullptr;
+        // RTP packets sent since the last report make us a sender for the interval calculation
+        std::lock_guard<std::mutex> txGuard(m_objTxLock);
+        if (m_bRtpSendPkt == eRTP_TRUE)
+        {
+            m_objTimerInfo.setWeSent(RTP_TWO);
+        }
     }
 
     RtpDt_UInt16 usMembers = m_pobjRtpRcvrInfoList->size();
@@ -713,7 +773,7 @@ RtpDt_Void RtpSession::rtcpTimerExpiry(IN RtpDt_Void* pvTimerId)
     }
 
     // set timestamp
-    rtpSetTimestamp();
+    rtpSetTimestamp(eRTP_TRUE);
 
     RtcpPacket objRtcpPkt;
     eRTP_STATUS_CODE eEncRes = RTP_FAILURE;
@@ -725,8 +785,10 @@ RtpDt_Void RtpSession::rtcpTimerExpiry(IN RtpDt_Void* pvTimerId)
         return;
     }
 
+    appendPendingFbPackets(&objRtcpPkt);
+
     // check number of packets are sent
-    eEncRes = rtpSendRtcpPacket(&objRtcpPkt);
+    eEncRes = rtpSendRtcpPacket(&objRtcpPkt, eRTP_FALSE);
     if (eEncRes != RTP_SUCCESS)
     {
         RTP_TRACE_ERROR("rtpSendRtcpPacket Error: %d", eEncRes, RTP_ZERO);
@@ -739,10 +801,33 @@ RtpDt_Void RtpSession::rtcpTimerExpiry(IN RtpDt_Void* pvTimerId)
     dTempT = rtcp_interval(usMembers);
     dTempT = dTempT * RTP_SEC_TO_MILLISEC;
     uiRoundDiff = (RtpDt_UInt32)dTempT;
+
+    // RFC 4585 3.5.3, the regular report following an early packet is scheduled after 2 * T
+    if (m_objTimerInfo.isAllowEarly() == eRTP_FALSE)
+    {
+        uiRoundDiff = uiRoundDiff * RTP_TWO;
+        m_objTimerInfo.setAllowEarly(eRTP_TRUE);
+    }
     uiTempTn = uiTempTc + uiRoundDiff;
     // uiTempTn = uiTempTc + dTempT;
     m_objTimerInfo.setTn(uiTempTn);
 
+    // the report is sent, so the state is updated even if the timer fails to restart
+    m_objTimerInfo.setInitial(eRTP_FALSE);
+
+    // update we_sent
+    if (m_objTimerInfo.getWeSent() == RTP_TWO)
+    {
+        m_objTimerInfo.setWeSent(RTP_ONE);
+    }
+    else
+    {
+        m_objTimerInfo.setWeSent(RTP_ZERO);
+    }
+
+    // set pmembers with members
+    m_objTimerInfo.setPmembers(usMembers);
+
     // restart the timer
     // uiTimerVal = m_objTimerInfo.getTn() - uiTempTc;
     if (m_usRTCPTimerVal > RTP_ZERO)
@@ -781,25 +866,6 @@ RtpDt_Void RtpSession::rtcpTimerExpiry(IN RtpDt_Void* pvTimerId)
         m_pTimerId = pvSTRes;
     }
 
-    // set m_bInitial = false
-    m_objTimerInfo.setInitial(eRTP_FALSE);
-
-    // update we_sent
-    if (m_objTimerInfo.getWeSent() == RTP_TWO)
-    {
-        m_objTimerInfo.setWeSent(RTP_ONE);
-    }
-    else
-    {
-        m_objTimerInfo.setWeSent(RTP_ZERO);
-    }
-
-    // set pmembers with members
-    m_objTimerInfo.setPmembers(usMembers);
-
-    // set m_bRtpSendPkt to false
-    m_bRtpSendPkt = eRTP_FALSE;
-
     return;
 }  // rtcpTimerExpiry
 
@@ -815,9 +881,9 @@ eRTP_STATUS_CODE RtpSession::populateSrpacket(
     // RTCP timestamp
     pobjSrPkt->setRtpTimestamp(m_curRtcpTimestamp);
     // sender's packet count
-    pobjSrPkt->setSendPktCount(m_uiRtpSendPktCount);
+    pobjSrPkt->setSendPktCount(m_uiRtcpSrPktCount);
     // sender's octet count
-    pobjSrPkt->setSendOctetCount(m_uiRtpSendOctCount);
+    pobjSrPkt->setSendOctetCount(m_uiRtcpSrOctCount);
 
     eRTP_STATUS_CODE eRepPktSta = RTP_FAILURE;
     eRepPktSta = populateReportPacket(pobjSrPkt->getRrPktInfo(), eRTP_FALSE, uiRecepCount);
@@ -997,6 +1063,16 @@ eRTP_STATUS_CODE RtpSession::populateAppPacket(IN_OUT RtcpPacket* pobjRtcpPkt)
 eRTP_STATUS_CODE RtpSession::populateRtcpFbPacket(IN_OUT RtcpPacket* pobjRtcpPkt,
         IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff, IN RtpDt_UInt32 uiLen,
         IN RtpDt_UInt32 uiMediaSSRC, IN RtpDt_UInt32 uiPayloadType)
+{
+    // set the RTCP packet
+    pobjRtcpPkt->addFbPacketData(
+            createRtcpFbPacket(uiFbType, pcBuff, uiLen, uiMediaSSRC, uiPayloadType));
+
+    return RTP_SUCCESS;
+}
+
+RtcpFbPacket* RtpSession::createRtcpFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff,
+        IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSSRC, IN RtpDt_UInt32 uiPayloadType)
 {
     // create RtcpFbPacket
     RtcpFbPacket* pobjRtcpRtpFbPacket = new RtcpFbPacket();
@@ -1013,15 +1089,12 @@ eRTP_STATUS_CODE RtpSession::populateRtcpFbPacket(IN_OUT RtcpPacket* pobjRtcpPkt
     // set feedback type
     pobjRtcpRtpFbPacket->setPayloadType((eRTCP_TYPE)uiPayloadType);
 
-    // set the RTCP packet
-    pobjRtcpPkt->addFbPacketData(pobjRtcpRtpFbPacket);
-
     // get and populate the RTCP header
     RtcpHeader* pRtcpHdr = pobjRtcpRtpFbPacket->getRtcpHdrInfo();
 
     pRtcpHdr->populateRtcpHeader((RtpDt_UChar)uiFbType, uiPayloadType, m_uiSsrc);
 
-    return RTP_SUCCESS;
+    return pobjRtcpRtpFbPacket;
 }
 
 eRTP_STATUS_CODE RtpSession::constructSdesPkt(IN_OUT RtcpPacket* pobjRtcpPkt)
@@ -1138,8 +1211,6 @@ eRTP_STATUS_CODE RtpSession::enableRtcp(eRtp_Bool enableRTCPBye)
     m_bEnableRTCP = eRTP_TRUE;
     m_bEnableRTCPBye = enableRTCPBye;
 
-    RtpSessionManager* pobjActSesDb = RtpSessionManager::getInstance();
-    pobjActSesDb->addRtpSession(reinterpret_cast<RtpDt_Void*>(this));
     RtpDt_Void* pvData = nullptr;
 
     if (m_pTimerId != nullptr && m_pobjAppInterface != nullptr)
@@ -1187,9 +1258,6 @@ eRTP_STATUS_CODE RtpSession::disableRtcp()
 {
     RtpDt_Void* pvData = nullptr;
 
-    RtpSessionManager* pobjActSesDb = RtpSessionManager::getInstance();
-    pobjActSesDb->removeRtpSession(this);
-
     m_bEnableRTCP = eRTP_FALSE;
     m_bEnableRTCPBye = eRTP_FALSE;
     if (m_pTimerId != nullptr && m_pobjAppInterface != nullptr)
@@ -1232,9 +1300,15 @@ eRTP_STATUS_CODE RtpSession::initSession(
 
     // m_usExtHdrLen = usExtHdrLen;
     // generate sequence number
+    std::lock_guard<std::mutex> guard(m_objTxLock);
     m_usSeqNum = (RtpDt_UInt16)RtpOsUtil::Rand();
     m_curRtpTimestamp = (RtpDt_UInt16)RtpOsUtil::Rand();
+
+    // anchor the NTP and RTP clocks of the session
+    m_ulCurRtpTime = RtpOsUtil::GetMonotonicTime();
     RtpOsUtil::GetNtpTime(m_stCurNtpTimestamp);
+    m_objTsEngine.init(m_ulCurRtpTime, &m_stCurNtpTimestamp, m_curRtpTimestamp,
+            m_pobjPayloadInfo->getSamplingRate());
     return RTP_SUCCESS;
 }  // initSession
 
@@ -1251,6 +1325,10 @@ eRTP_STATUS_CODE RtpSession::setPayload(
             return RTP_INVALID_PARAMS;
         }
         m_pobjPayloadInfo->setRtpPayloadInfo(pstPayloadInfo);
+
+        std::lock_guard<std::mutex> guard(m_objTxLock);
+        m_objTsEngine.setSamplingRate(
+                RtpOsUtil::GetMonotonicTime(), m_pobjPayloadInfo->getSamplingRate());
     }
     else
     {
@@ -1268,6 +1346,10 @@ eRTP_STATUS_CODE RtpSession::updatePayload(IN RtpPayloadInfo* pstPayloadInfo)
 {
     m_pobjPayloadInfo->setRtpPayloadInfo(pstPayloadInfo);
 
+    std::lock_guard<std::mutex> guard(m_objTxLock);
+    m_objTsEngine.setSamplingRate(
+            RtpOsUtil::GetMonotonicTime(), m_pobjPayloadInfo->getSamplingRate());
+
     return RTP_SUCCESS;
 }  // updatePayload
 
@@ -1277,14 +1359,33 @@ eRTP_STATUS_CODE RtpSession::setRTCPTimerValue(IN RtpDt_UInt16 usRTCPTimerVal)
     return RTP_SUCCESS;
 }
 
+RtpDt_Void RtpSession::setReducedSizeRtcp(IN eRtp_Bool bReducedSize)
+{
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    m_bReducedSizeRtcp = bReducedSize;
+}
+
+eRtp_Bool RtpSession::isReducedSizeRtcp()
+{
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    return m_bReducedSizeRtcp;
+}
+
+RtpDt_Void RtpSession::setRtcpXrRttBlocks(IN eRtp_Bool bRrt, IN eRtp_Bool bDlrr)
+{
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    m_bXrRrtBlock = bRrt;
+    m_bXrDlrrBlock = bDlrr;
+}
+
 eRTP_STATUS_CODE RtpSession::deleteRtpSession()
 {
     RtpDt_Void* pvData = nullptr;
 
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    std::lock_guard<std::mutex> rxGuard(m_objRxLock);
 
-    RtpSessionManager* pobjActSesDb = RtpSessionManager::getInstance();
-    pobjActSesDb->removeRtpSession(this);
+    m_bEnableRTCP = eRTP_FALSE;
 
     if (m_pTimerId != nullptr)
     {
@@ -1445,7 +1546,7 @@ eRTP_STATUS_CODE RtpSession::processCsrcList(
 eRTP_STATUS_CODE RtpSession::processRcvdRtpPkt(IN RtpBuffer* pobjRtpAddr, IN RtpDt_UInt16 usPort,
         IN RtpBuffer* pobjRTPPacket, OUT RtpPacket* pobjRtpPkt)
 {
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    std::lock_guard<std::mutex> guard(m_objRxLock);
 
     // validation
     if ((pobjRTPPacket == nullptr) || (pobjRtpPkt == nullptr) || (pobjRtpAddr == nullptr))
@@ -1496,9 +1597,15 @@ eRTP_STATUS_CODE RtpSession::processRcvdRtpPkt(IN RtpBuffer* pobjRtpAddr, IN Rtp
         RtpDt_UInt32 uiTermNum = pobjRtpProfile->getTermNumber();
         eRTP_STATUS_CODE eByeRes = RTP_SUCCESS;
 
+        eRtp_Bool bRtpSendPkt = eRTP_FALSE;
+        {
+            std::lock_guard<std::mutex> txGuard(m_objTxLock);
+            bRtpSendPkt = m_bRtpSendPkt;
+        }
+
         // collision happened.
         if ((m_bEnableRTCP == eRTP_TRUE) && (m_bEnableRTCPBye == eRTP_TRUE) &&
-                (m_bRtpSendPkt == eRTP_TRUE))
+                (bRtpSendPkt == eRTP_TRUE))
         {
             eByeRes = collisionSendRtcpByePkt(uiReceivedSsrc);
             if (eByeRes != RTP_SUCCESS)
@@ -1563,9 +1670,11 @@ eRTP_STATUS_CODE RtpSession::processRcvdRtpPkt(IN RtpBuffer* pobjRtpAddr, IN Rtp
         // m_bSender
         pobjRcvInfo->setSenderFlag(eRTP_TRUE);
 
-        pobjRcvInfo->setprevRtpTimestamp(m_curRtpTimestamp);
-
-        pobjRcvInfo->setprevNtpTimestamp(&m_stCurNtpTimestamp);
+        {
+            std::lock_guard<std::mutex> txGuard(m_objTxLock);
+            pobjRcvInfo->setprevRtpTimestamp(m_curRtpTimestamp);
+            pobjRcvInfo->setprevNtpTimestamp(&m_stCurNtpTimestamp);
+        }
 
         m_pobjRtpRcvrInfoList->push_back(pobjRcvInfo);
         RTP_TRACE_MESSAGE("processRcvdRtpPkt - added ssrc[%x] from port[%d] to receiver list",
@@ -1663,6 +1772,8 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
         IN RtpDt_UChar ucPayloadType, IN eRtp_Bool bUseLastTimestamp,
         IN RtpDt_UInt32 uiRtpTimestampDiff, IN RtpBuffer* pobjXHdr, OUT RtpBuffer* pRtpPkt)
 {
+    std::lock_guard<std::mutex> guard(m_objTxLock);
+
     RtpPacket objRtpPacket;
     RtpHeader* pobjRtpHdr = objRtpPacket.getRtpHeader();
 
@@ -1676,13 +1787,11 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
     // set timestamp
     m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
     m_prevRtpTimestamp = m_curRtpTimestamp;
-    RtpDt_UInt32 uiSamplingRate = RTP_ZERO;
 
     if (!bUseLastTimestamp)
     {
-        m_stPrevNtpTimestamp = m_stCurNtpTimestamp;
-        m_prevRtpTimestamp = m_curRtpTimestamp;
-        RtpOsUtil::GetNtpTime(m_stCurNtpTimestamp);
+        RtpDt_UInt64 ulCurTime = RtpOsUtil::GetMonotonicTime();
+        m_objTsEngine.getNtpTime(ulCurTime, &m_stCurNtpTimestamp);
 
         if (m_uiRtpSendPktCount == RTP_ZERO)
         {
@@ -1691,14 +1800,16 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
 
         if (uiRtpTimestampDiff)
         {
+            // the media clock is driven by the application, move the anchor along with it
             m_curRtpTimestamp += uiRtpTimestampDiff;
+            m_objTsEngine.setRtpAnchor(ulCurTime, m_curRtpTimestamp);
         }
         else
         {
-            uiSamplingRate = m_pobjPayloadInfo->getSamplingRate();
-            m_curRtpTimestamp = RtpStackUtil::calcRtpTimestamp(m_prevRtpTimestamp,
-                    &m_stCurNtpTimestamp, &m_stPrevNtpTimestamp, uiSamplingRate);
+            m_curRtpTimestamp = m_objTsEngine.getRtpTimestamp(ulCurTime);
         }
+
+        m_ulCurRtpTime = ulCurTime;
     }
 
     pobjRtpHdr->setRtpTimestamp(m_curRtpTimestamp);
@@ -1740,17 +1851,14 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
     {
         objRtpPacket.setExtHeader(pobjXHdr);
     }
-    else
-    {
-        delete pobjXHdr;
-    }
 
     // encode the Rtp packet.
     eRtp_Bool bPackRes = eRTP_TRUE;
     bPackRes = objRtpPacket.formPacket(pRtpPkt);
 
-    // set pobjPayload to NULL in both success and failure case
+    // set pobjPayload and pobjXHdr to NULL in both success and failure case
     objRtpPacket.setRtpPayload(nullptr);
+    objRtpPacket.setExtHeader(nullptr);
 
     if (bPackRes != eRTP_TRUE)
     {
@@ -1763,10 +1871,7 @@ eRTP_STATUS_CODE RtpSession::createRtpPacket(IN RtpBuffer* pobjPayload, IN eRtp_
     m_uiRtpSendPktCount++;
     m_uiRtpSendOctCount += pobjPayload->getLength();
 
-    // set we_sent flag as true
-    m_objTimerInfo.setWeSent(RTP_TWO);
-
-    // set m_bRtpSendPkt to true
+    // set m_bRtpSendPkt to true, we_sent flag is updated from it at the next timer expiry
     m_bRtpSendPkt = eRTP_TRUE;
 
     return RTP_SUCCESS;
@@ -1829,36 +1934,18 @@ RtpDt_Void RtpSession::delEntryFromRcvrList(IN RtpDt_UInt32* puiSsrc)
     }
 }  // delEntryFromRcvrList
 
-eRTP_STATUS_CODE RtpSession::processByePacket(
-        IN RtcpByePacket* pobjByePkt, IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort)
+eRTP_STATUS_CODE RtpSession::processByePacket(IN RtcpBlockView& objByePkt,
+        IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort, OUT RtpDt_UInt32& uiTimerVal)
 {
     (RtpDt_Void) pobjRtcpAddr, (RtpDt_Void)usPort;
-
-    RtcpHeader* pobjHdrInfo = pobjByePkt->getRtcpHdrInfo();
-    RtpDt_UInt16 usNumSsrc = pobjHdrInfo->getReceptionReportCount();
-    std::list<RtpDt_UInt32*>& pobjSsrcList = pobjByePkt->getSsrcList();
-    RtpDt_UInt16 usPos = RTP_ZERO;
+    uiTimerVal = RTP_ZERO;
 
     // delete entry from receiver list
-    for (std::list<RtpDt_UInt32*>::iterator listIterator = pobjSsrcList.begin();
-            (usPos < usNumSsrc && listIterator != pobjSsrcList.end()); usPos = usPos + RTP_ONE)
+    RtpDt_UInt16 usNumSsrc = objByePkt.getByeSsrcCount();
+    for (RtpDt_UInt16 usPos = RTP_ZERO; usPos < usNumSsrc; usPos++)
     {
-        if (usPos == RTP_ZERO)
-        {
-            RtpDt_UInt32 uiSsrc = pobjHdrInfo->getSsrc();
-            delEntryFromRcvrList(&uiSsrc);
-        }
-        else
-        {
-            RtpDt_UInt32* puiSsrc = nullptr;
-            // get element from list
-            puiSsrc = (*listIterator);
-            if (puiSsrc != nullptr)
-            {
-                delEntryFromRcvrList(puiSsrc);
-            }
-            ++listIterator;
-        }
+        RtpDt_UInt32 uiSsrc = objByePkt.getByeSsrc(usPos);
+        delEntryFromRcvrList(&uiSsrc);
     }  // for
 
     // get size of the pobjSsrcList
@@ -1880,8 +1967,6 @@ eRTP_STATUS_CODE RtpSession::processByePacket(
         RtpDt_Double dTempT = rtcp_interval(usMembers);
 
         // convert uiTempT to milliseconds
-        RtpDt_UInt32 uiTimerVal = RTP_ZERO;
-
         dTempT = dTempT * RTP_SEC_TO_MILLISEC;
         RtpDt_UInt32 uiRoundDiff = (RtpDt_UInt32)dTempT;
         uiRoundDiff = ((uiRoundDiff / 100) * 100);
@@ -1900,38 +1985,19 @@ eRTP_STATUS_CODE RtpSession::processByePacket(
         }
 
         RTP_TRACE_MESSAGE("processByePacket [uiTimerVal : %u]", uiTimerVal, RTP_ZERO);
-        RtpDt_Void* pvData = nullptr;
-        eRtp_Bool bTSres = eRTP_FALSE;
-
-        if (m_pTimerId != nullptr)
-        {
-            bTSres = m_pobjAppInterface->RtpStopTimer(m_pTimerId, &pvData);
-            m_pTimerId = nullptr;
-            if (bTSres == eRTP_FALSE)
-            {
-                return RTP_TIMER_PROC_ERR;
-            }
-        }
-        RtpDt_Void* pvSTRes =
-                m_pobjAppInterface->RtpStartTimer(uiTimerVal, eRTP_FALSE, m_pfnTimerCb, this);
-        if (pvSTRes == nullptr)
-        {
-            return RTP_TIMER_PROC_ERR;
-        }
-        m_pTimerId = pvSTRes;
     }
 
     return RTP_SUCCESS;
 }  // processByePacket
 
-eRTP_STATUS_CODE RtpSession::processSdesPacket(IN RtcpSdesPacket* pobjSdesPkt)
+eRTP_STATUS_CODE RtpSession::processSdesPacket(IN RtcpBlockView& objSdesPkt)
 {
-    (RtpDt_Void) pobjSdesPkt;
+    (RtpDt_Void) objSdesPkt;
     return RTP_SUCCESS;
 }
 
-eRTP_STATUS_CODE RtpSession::processRcvdRtcpPkt(IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort,
-        IN RtpBuffer* pobjRTCPBuf, OUT RtcpPacket* pobjRtcpPkt)
+eRTP_STATUS_CODE RtpSession::processRcvdRtcpPkt(
+        IN RtpBuffer* pobjRtcpAddr, IN RtpDt_UInt16 usPort, IN RtpBuffer* pobjRTCPBuf)
 {
     if (m_bEnableRTCP != eRTP_TRUE)
     {
@@ -1941,108 +2007,124 @@ eRTP_STATUS_CODE RtpSession::processRcvdRtcpPkt(IN RtpBuffer* pobjRtcpAddr, IN R
     }
 
     // validity checking
-    if (pobjRtcpAddr == nullptr || pobjRTCPBuf == nullptr || pobjRtcpPkt == nullptr)
+    if (pobjRtcpAddr == nullptr || pobjRTCPBuf == nullptr)
     {
         RTP_TRACE_ERROR("[ProcessRcvdRtcpPkt] Invalid params. pobjRtcpAddr[%x] pobjRTCPBuf[%x]",
                 pobjRtcpAddr, pobjRTCPBuf);
         return RTP_INVALID_PARAMS;
     }
 
-    RtpDt_UInt16 usExtHdrLen = RTP_ZERO;
-    eRTP_STATUS_CODE eDecodeStatus = RTP_FAILURE;
-
     tRTP_NTP_TIME stNtpTs = {RTP_ZERO, RTP_ZERO};
     RtpOsUtil::GetNtpTime(stNtpTs);
     RtpDt_UInt32 currentTime = RtpStackUtil::getMidFourOctets(&stNtpTs);
-    // decode compound packet
-    eDecodeStatus = pobjRtcpPkt->decodeRtcpPacket(pobjRTCPBuf, usExtHdrLen, m_pobjRtcpCfgInfo);
-    if (eDecodeStatus != RTP_SUCCESS)
+
+    RtpDt_UInt32 uiTimerVal = RTP_ZERO;
     {
-        RTP_TRACE_ERROR(
-                "[ProcessRcvdRtcpPkt], Error Decoding compound RTCP packet!", RTP_ZERO, RTP_ZERO);
-        return eDecodeStatus;
-    }
+        std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+        std::lock_guard<std::mutex> rxGuard(m_objRxLock);
 
-    // update average rtcp size
-    RtpDt_UInt32 uiRcvdPktSize = pobjRTCPBuf->getLength();
-    m_objTimerInfo.updateAvgRtcpSize(uiRcvdPktSize);
+        // validate compound packet, the packets are read in place afterwards
+        RtcpCompoundIterator objIterator(pobjRTCPBuf->getBuffer(), pobjRTCPBuf->getLength());
+        eRTP_STATUS_CODE eDecodeStatus = objIterator.validate();
+        if (eDecodeStatus != RTP_SUCCESS)
+        {
+            RTP_TRACE_ERROR("[ProcessRcvdRtcpPkt], Error Decoding compound RTCP packet!",
+                    RTP_ZERO, RTP_ZERO);
+            return eDecodeStatus;
+        }
 
-    std::list<RtcpSrPacket*>& pobjSrList = pobjRtcpPkt->getSrPacketList();
+        // update average rtcp size
+        RtpDt_UInt32 uiRcvdPktSize = pobjRTCPBuf->getLength();
+        m_objTimerInfo.updateAvgRtcpSize(uiRcvdPktSize);
 
-    if (pobjSrList.size() > RTP_ZERO)
-    {
-        // get key material element from list.
-        RtcpSrPacket* pobjSrPkt = pobjSrList.front();
+        // decrement rtcp port by one
+        usPort = usPort - RTP_ONE;
 
-        RtcpRrPacket* pobjRRPkt = pobjSrPkt->getRrPktInfo();
-        RtcpHeader* pobjRtcpHdr = pobjRRPkt->getRtcpHdrInfo();
-        RtpDt_UInt32 uiRcvdSsrc = pobjRtcpHdr->getSsrc();
+        eRtp_Bool bSrProcessed = eRTP_FALSE;
+        eRtp_Bool bRrProcessed = eRTP_FALSE;
+        RtcpBlockView objBlock;
 
-        // calculate RTTD
-        std::list<RtcpReportBlock*>& pobjReportBlkList = pobjRRPkt->getReportBlockList();
-        if (pobjReportBlkList.size() > RTP_ZERO)
+        while (objIterator.next(objBlock) == eRTP_TRUE)
         {
-            RtcpReportBlock* pobjReportBlk = pobjReportBlkList.front();
-            if (pobjReportBlk != nullptr)
+            RtpDt_UChar ucPktType = objBlock.getPacketType();
+
+            // only the first SR and the first RR of the compound packet are processed
+            if ((ucPktType == RTCP_SR && bSrProcessed == eRTP_FALSE) ||
+                    (ucPktType == RTCP_RR && bRrProcessed == eRTP_FALSE))
+            {
+                // calculate RTTD
+                tRTCP_REPORT_BLOCK_INFO stReportBlk;
+                if (objBlock.getReportBlock(RTP_ZERO, &stReportBlk) == eRTP_TRUE)
+                {
+                    calculateAndSetRTTD(
+                            currentTime, stReportBlk.uiLastSR, stReportBlk.uiDelayLastSR);
+                }
+
+                RtpReceiverInfo* pobjRcvInfo =
+                        processRtcpPkt(objBlock.getSsrc(), pobjRtcpAddr, usPort);
+
+                tRTCP_SENDER_INFO stSenderInfo;
+                if (pobjRcvInfo != nullptr && objBlock.getSenderInfo(&stSenderInfo) == eRTP_TRUE)
+                {
+                    stNtpTs = {RTP_ZERO, RTP_ZERO};
+                    pobjRcvInfo->setpreSrTimestamp(&stSenderInfo.stNtpTimestamp);
+                    RtpOsUtil::GetNtpTime(stNtpTs);
+                    pobjRcvInfo->setLastSrNtpTimestamp(&stNtpTs);
+                }
+
+                if (ucPktType == RTCP_SR)
+                {
+                    bSrProcessed = eRTP_TRUE;
+                }
+                else
+                {
+                    bRrProcessed = eRTP_TRUE;
+                }
+            }
+            else if (ucPktType == RTCP_SDES)
             {
-                calculateAndSetRTTD(
-                        currentTime, pobjReportBlk->getLastSR(), pobjReportBlk->getDelayLastSR());
+                processSdesPacket(objBlock);
+            }
+            else if (ucPktType == RTCP_BYE)
+            {
+                processByePacket(objBlock, pobjRtcpAddr, usPort, uiTimerVal);
+            }
+            else if (ucPktType == RTCP_XR)
+            {
+                processXrPacket(objBlock, currentTime);
             }
         }
-        // decrement rtcp port by one
-        usPort = usPort - RTP_ONE;
-        RtpReceiverInfo* pobjRcvInfo = processRtcpPkt(uiRcvdSsrc, pobjRtcpAddr, usPort);
-        if (pobjRcvInfo != nullptr)
-        {
-            stNtpTs = {RTP_ZERO, RTP_ZERO};
-            pobjRcvInfo->setpreSrTimestamp(pobjSrPkt->getNtpTime());
-            RtpOsUtil::GetNtpTime(stNtpTs);
-            pobjRcvInfo->setLastSrNtpTimestamp(&stNtpTs);
-        }
-    }  // RTCP SR
-
-    // RTCP RR packet
-    std::list<RtcpRrPacket*>& pobjRrList = pobjRtcpPkt->getRrPacketList();
+    }
 
-    if (pobjRrList.size() > RTP_ZERO)
+    // reschedule the next report after the BYE. m_pTimerId is replaced under m_objRtcpLock like
+    // the timer callback does, the previous timer is stopped after the lock is released because
+    // its callback may be waiting for the lock with the timer lock held.
+    if (uiTimerVal > RTP_ZERO)
     {
-        // get key material element from list.
-        RtcpRrPacket* pobjRrPkt = pobjRrList.front();
+        RtpDt_Void* pvPrevTimerId = nullptr;
 
-        // calculate RTTD
-        std::list<RtcpReportBlock*>& pobjReportBlkList = pobjRrPkt->getReportBlockList();
-        if (pobjReportBlkList.size() > RTP_ZERO)
         {
-            RtcpReportBlock* pobjReportBlk = pobjReportBlkList.front();
-            if (pobjReportBlk != nullptr)
+            std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+            RtpDt_Void* pvSTRes =
+                    m_pobjAppInterface->RtpStartTimer(uiTimerVal, eRTP_FALSE, m_pfnTimerCb, this);
+            if (pvSTRes == nullptr)
             {
-                calculateAndSetRTTD(
-                        currentTime, pobjReportBlk->getLastSR(), pobjReportBlk->getDelayLastSR());
+                return RTP_TIMER_PROC_ERR;
             }
-        }
 
-        RtcpHeader* pobjRtcpHdr = pobjRrPkt->getRtcpHdrInfo();
-        RtpDt_UInt32 uiRcvdSsrc = pobjRtcpHdr->getSsrc();
-
-        // decrement rtcp port by one
-        usPort = usPort - RTP_ONE;
-        processRtcpPkt(uiRcvdSsrc, pobjRtcpAddr, usPort);
-    }  // RTCP RR
+            pvPrevTimerId = m_pTimerId;
+            m_pTimerId = pvSTRes;
+        }
 
-    // RTCP SDES packet
-    RtcpSdesPacket* pobjSdesPkt = pobjRtcpPkt->getSdesPacket();
-    if (pobjSdesPkt != nullptr)
-    {
-        // sdes
-        processSdesPacket(pobjSdesPkt);
-    }
+        RtpDt_Void* pvData = nullptr;
 
-    // RTCP BYE packet
-    RtcpByePacket* pobjByePkt = pobjRtcpPkt->getByePacket();
-    if (pobjByePkt != nullptr)
-    {
-        // bye
-        processByePacket(pobjByePkt, pobjRtcpAddr, usPort);
+        // the packet is processed and the new timer is running, the failure is not returned
+        if (pvPrevTimerId != nullptr &&
+                m_pobjAppInterface->RtpStopTimer(pvPrevTimerId, &pvData) == eRTP_FALSE)
+        {
+            RTP_TRACE_WARNING("processRcvdRtcpPkt, failed to stop the previous timer", RTP_ZERO,
+                    RTP_ZERO);
+        }
     }
 
     return RTP_SUCCESS;
@@ -2051,21 +2133,22 @@ eRTP_STATUS_CODE RtpSession::processRcvdRtcpPkt(IN RtpBuffer* pobjRtcpAddr, IN R
 eRtp_Bool RtpSession::sendRtcpByePacket()
 {
     RtcpPacket objRtcpPkt;
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    std::lock_guard<std::mutex> rxGuard(m_objRxLock);
 
     if (m_bEnableRTCP == eRTP_TRUE && m_bEnableRTCPBye == eRTP_TRUE)
     {
         m_bSndRtcpByePkt = eRTP_TRUE;
 
         // set timestamp
-        rtpSetTimestamp();
+        rtpSetTimestamp(eRTP_FALSE);
 
         if (rtpMakeCompoundRtcpPacket(&objRtcpPkt) != RTP_SUCCESS)
         {
             return eRTP_FALSE;
         }
 
-        if (rtpSendRtcpPacket(&objRtcpPkt) == RTP_SUCCESS)
+        if (rtpSendRtcpPacket(&objRtcpPkt, eRTP_FALSE) == RTP_SUCCESS)
         {
             if (m_bSelfCollisionByeSent == eRTP_TRUE)
             {
@@ -2076,7 +2159,7 @@ eRtp_Bool RtpSession::sendRtcpByePacket()
                 uiNewSsrc = RtpStackUtil::generateNewSsrc(uiTermNum);
                 m_uiSsrc = uiNewSsrc;
                 RTP_TRACE_WARNING(
-                        "sendRtcpByePacket::SSRC after collision: %x", m_uiSsrc, RTP_ZERO);
+                        "sendRtcpByePacket::SSRC after collision: %x", uiNewSsrc, RTP_ZERO);
             }
 
             return eRTP_TRUE;
@@ -2088,20 +2171,77 @@ eRtp_Bool RtpSession::sendRtcpByePacket()
 
 eRtp_Bool RtpSession::sendRtcpRtpFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcbuff,
         IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSsrc)
+{
+    return sendRtcpFbPacket(uiFbType, pcbuff, uiLen, uiMediaSsrc, RTCP_RTPFB);
+}
+
+eRtp_Bool RtpSession::sendRtcpPayloadFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcbuff,
+        IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSsrc)
+{
+    return sendRtcpFbPacket(uiFbType, pcbuff, uiLen, uiMediaSsrc, RTCP_PSFB);
+}
+
+eRtp_Bool RtpSession::sendRtcpFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcBuff,
+        IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSsrc, IN RtpDt_UInt32 uiPayloadType)
 {
     RtcpPacket objRtcpPkt;
 
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    std::lock_guard<std::mutex> rtcpGuard(m_objRtcpLock);
+    std::lock_guard<std::mutex> rxGuard(m_objRxLock);
+
+    if (uiPayloadType == RTCP_RTPFB && uiFbType == RTCP_FB_GENERIC_NACK)
+    {
+        addNackRecords(pcBuff, uiLen);
+    }
+
+    // RFC 5506 4.1, the reduced-size packets are sent only after the first full compound packet.
+    // The feedback is sent in a compound packet until the first regular report is sent and when
+    // no regular report is scheduled to carry the pending feedback.
+    if (m_bReducedSizeRtcp == eRTP_TRUE && m_bEnableRTCP == eRTP_TRUE &&
+            m_objTimerInfo.isInitial() == eRTP_FALSE)
+    {
+        // RFC 4585 3.5.2, only one early packet is allowed until the next regular report
+        if (m_objTimerInfo.isAllowEarly() == eRTP_FALSE &&
+                m_objPendingFbPktList.size() >= RTCP_MAX_PENDING_FB_PKTS)
+        {
+            RTP_TRACE_WARNING("sendRtcpFbPacket, pending feedback is full[%d]",
+                    m_objPendingFbPktList.size(), RTP_ZERO);
+            return eRTP_FALSE;
+        }
+
+        RtcpFbPacket* pobjFbPkt =
+                createRtcpFbPacket(uiFbType, pcBuff, uiLen, uiMediaSsrc, uiPayloadType);
+
+        if (m_objTimerInfo.isAllowEarly() == eRTP_FALSE)
+        {
+            m_objPendingFbPktList.push_back(pobjFbPkt);
+            RTP_TRACE_MESSAGE("sendRtcpFbPacket, early feedback not allowed. pending[%d]",
+                    m_objPendingFbPktList.size(), RTP_ZERO);
+            return eRTP_TRUE;
+        }
+
+        objRtcpPkt.addFbPacketData(pobjFbPkt);
+
+        if (rtpSendRtcpPacket(&objRtcpPkt, eRTP_TRUE) != RTP_SUCCESS)
+        {
+            return eRTP_FALSE;
+        }
+
+        m_objTimerInfo.setAllowEarly(eRTP_FALSE);
+        return eRTP_TRUE;
+    }
+
     // set timestamp
-    rtpSetTimestamp();
+    rtpSetTimestamp(eRTP_FALSE);
 
     if (rtpMakeCompoundRtcpPacket(&objRtcpPkt) != RTP_SUCCESS)
     {
         return eRTP_FALSE;
     }
-    populateRtcpFbPacket(&objRtcpPkt, uiFbType, pcbuff, uiLen, uiMediaSsrc, RTCP_RTPFB);
 
-    if (rtpSendRtcpPacket(&objRtcpPkt) == RTP_SUCCESS)
+    populateRtcpFbPacket(&objRtcpPkt, uiFbType, pcBuff, uiLen, uiMediaSsrc, uiPayloadType);
+
+    if (rtpSendRtcpPacket(&objRtcpPkt, eRTP_FALSE) == RTP_SUCCESS)
     {
         return eRTP_TRUE;
     }
@@ -2109,28 +2249,65 @@ eRtp_Bool RtpSession::sendRtcpRtpFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Cha
     return eRTP_FALSE;
 }
 
-eRtp_Bool RtpSession::sendRtcpPayloadFbPacket(IN RtpDt_UInt32 uiFbType, IN RtpDt_Char* pcbuff,
-        IN RtpDt_UInt32 uiLen, IN RtpDt_UInt32 uiMediaSsrc)
+RtpDt_Void RtpSession::appendPendingFbPackets(IN_OUT RtcpPacket* pobjRtcpPkt)
 {
-    RtcpPacket objRtcpPkt;
+    // the packet takes the ownership of the feedback packets
+    for (auto& pobjFbPkt : m_objPendingFbPktList)
+    {
+        pobjRtcpPkt->addFbPacketData(pobjFbPkt);
+    }
 
-    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
-    // set timestamp
-    rtpSetTimestamp();
+    m_objPendingFbPktList.clear();
+}
 
-    if (rtpMakeCompoundRtcpPacket(&objRtcpPkt) != RTP_SUCCESS)
+RtpDt_Void RtpSession::addNackRecords(IN RtpDt_Char* pcBuff, IN RtpDt_UInt32 uiLen)
+{
+    RtpDt_UInt32 uiSentTime = (RtpDt_UInt32)(RtpOsUtil::GetMonotonicTime() / 1000000);
+    RtpDt_UChar* pucFci = reinterpret_cast<RtpDt_UChar*>(pcBuff);
+
+    // RFC 4585 6.2.1, each FCI entry has PID of 16 bits and BLP of 16 bits
+    for (RtpDt_UInt32 uiPos = RTP_ZERO; uiPos + RTP_WORD_SIZE <= uiLen; uiPos += RTP_WORD_SIZE)
+    {
+        RtpDt_UInt16 usPid = (pucFci[uiPos] << RTP_BYTE_BIT_SIZE) | pucFci[uiPos + 1];
+        RtpDt_UInt16 usBlp = (pucFci[uiPos + 2] << RTP_BYTE_BIT_SIZE) | pucFci[uiPos + 3];
+
+        for (RtpDt_UInt32 uiBit = RTP_ZERO; uiBit <= RTP_SIXTEEN; uiBit++)
+        {
+            if (uiBit > RTP_ZERO && (usBlp & (RTP_ONE << (uiBit - RTP_ONE))) == RTP_ZERO)
+            {
+                continue;
+            }
+
+            RtpDt_UInt16 usSeqNum = usPid + uiBit;
+            tRTCP_NACK_RECORD& stRecord = m_stNackRecords[usSeqNum % RTCP_MAX_NACK_RECORDS];
+            stRecord.usSeqNum = usSeqNum;
+            stRecord.uiSentTime = uiSentTime;
+            stRecord.bPending = eRTP_TRUE;
+        }
+    }
+}
+
+eRtp_Bool RtpSession::checkNackRetransmission(
+        IN RtpDt_UInt16 usSeqNum, OUT RtpDt_UInt32& uiLatency)
+{
+    std::lock_guard<std::mutex> rxGuard(m_objRxLock);
+    tRTCP_NACK_RECORD& stRecord = m_stNackRecords[usSeqNum % RTCP_MAX_NACK_RECORDS];
+
+    if (stRecord.bPending == eRTP_FALSE || stRecord.usSeqNum != usSeqNum)
     {
         return eRTP_FALSE;
     }
 
-    populateRtcpFbPacket(&objRtcpPkt, uiFbType, pcbuff, uiLen, uiMediaSsrc, RTCP_PSFB);
+    RtpDt_UInt32 uiCurTime = (RtpDt_UInt32)(RtpOsUtil::GetMonotonicTime() / 1000000);
+    stRecord.bPending = eRTP_FALSE;
 
-    if (rtpSendRtcpPacket(&objRtcpPkt) == RTP_SUCCESS)
+    if (uiCurTime - stRecord.uiSentTime > RTCP_NACK_RECORD_TIMEOUT)
     {
-        return eRTP_TRUE;
+        return eRTP_FALSE;
     }
 
-    return eRTP_FALSE;
+    uiLatency = uiCurTime - stRecord.uiSentTime;
+    return eRTP_TRUE;
 }
 
 RtpDt_Double RtpSession::rtcp_interval(IN RtpDt_UInt16 usMembers)
@@ -2253,18 +2430,45 @@ RtpDt_UInt32 RtpSession::getSenderCount()
 RtpDt_Void RtpSession::calculateAndSetRTTD(
         RtpDt_UInt32 currentTime, RtpDt_UInt32 lsr, RtpDt_UInt32 dlsr)
 {
-    if (lsr == 0 || dlsr == 0)
-    {
-        m_lastRTTDelay = 0;
-    }
-    else
+    RtpDt_UInt32 uiRttd = RTP_ZERO;
+    if (lsr != 0 && dlsr != 0)
     {
-        m_lastRTTDelay = (currentTime - lsr - dlsr);
+        uiRttd = (currentTime - lsr - dlsr);
     }
-    RTP_TRACE_MESSAGE("calculateAndSetRTTD = %d", m_lastRTTDelay, nullptr);
+    m_lastRTTDelay = uiRttd;
+    RTP_TRACE_MESSAGE("calculateAndSetRTTD = %d", uiRttd, nullptr);
 }
 eRTP_STATUS_CODE RtpSession::populateRtcpXrPacket(IN_OUT RtcpPacket* pobjRtcpPkt)
 {
+    RtpDt_UInt32 uiRrtLen = (m_bXrRrtBlock == eRTP_TRUE) ? RTCP_XR_RRT_BLOCK_LEN : RTP_ZERO;
+    RtpDt_UInt32 uiNumDlrr = RTP_ZERO;
+
+    if (m_bXrDlrrBlock == eRTP_TRUE)
+    {
+        for (auto& pobjRcvrElm : *m_pobjRtpRcvrInfoList)
+        {
+            if (pobjRcvrElm != nullptr && pobjRcvrElm->getLastRrtTimestamp() != RTP_ZERO)
+            {
+                uiNumDlrr++;
+            }
+        }
+    }
+
+    RtpDt_UInt32 uiDlrrLen = RTP_ZERO;
+
+    if (uiNumDlrr > RTP_ZERO)
+    {
+        uiDlrrLen = RTP_WORD_SIZE + uiNumDlrr * RTCP_XR_DLRR_SUB_BLOCK_LEN;
+    }
+
+    RtpDt_UInt32 uiAppLen = (m_bisXr == eRTP_TRUE) ? m_stRtcpXr.nlength : RTP_ZERO;
+    RtpDt_UInt32 uiXrLen = uiRrtLen + uiDlrrLen + uiAppLen;
+
+    if (uiXrLen == RTP_ZERO)
+    {
+        return RTP_SUCCESS;
+    }
+
     // create RtcpXrPacket
     RtcpXrPacket* pobjRtcpXrPacket = new RtcpXrPacket();
     if (pobjRtcpXrPacket == nullptr)
@@ -2273,13 +2477,46 @@ eRTP_STATUS_CODE RtpSession::populateRtcpXrPacket(IN_OUT RtcpPacket* pobjRtcpPkt
         return RTP_FAILURE;
     }
     // set extended report block data
-    RtpBuffer* pobjPayload = new RtpBuffer(m_stRtcpXr.nlength, m_stRtcpXr.m_pBlockBuffer);
+    RtpBuffer* pobjPayload = new RtpBuffer(uiXrLen, nullptr);
     if (pobjPayload == nullptr)
     {
         RTP_TRACE_ERROR("[Memory Error] new returned NULL.", RTP_ZERO, RTP_ZERO);
         delete pobjRtcpXrPacket;
         return RTP_FAILURE;
     }
+
+    RtpDt_UInt32* puiBlock = reinterpret_cast<RtpDt_UInt32*>(pobjPayload->getBuffer());
+
+    if (uiRrtLen > RTP_ZERO)
+    {
+        // receiver reference time report block with the NTP time of this report
+        *puiBlock++ = RtpOsUtil::Ntohl((RTCP_XR_RRT_BLOCK_TYPE << RTP_24) | RTP_TWO);
+        *puiBlock++ = RtpOsUtil::Ntohl(m_stCurNtpRtcpTs.m_uiNtpHigh32Bits);
+        *puiBlock++ = RtpOsUtil::Ntohl(m_stCurNtpRtcpTs.m_uiNtpLow32Bits);
+    }
+
+    if (uiDlrrLen > RTP_ZERO)
+    {
+        // DLRR report block with a sub-block per source which sent the reference time
+        RtpDt_UInt32 uiDlrrHdr = (RTCP_XR_DLRR_BLOCK_TYPE << RTP_24) | (uiNumDlrr * RTP_THREE);
+        *puiBlock++ = RtpOsUtil::Ntohl(uiDlrrHdr);
+
+        for (auto& pobjRcvrElm : *m_pobjRtpRcvrInfoList)
+        {
+            if (pobjRcvrElm != nullptr && pobjRcvrElm->getLastRrtTimestamp() != RTP_ZERO)
+            {
+                *puiBlock++ = RtpOsUtil::Ntohl(pobjRcvrElm->getSsrc());
+                *puiBlock++ = RtpOsUtil::Ntohl(pobjRcvrElm->getLastRrtTimestamp());
+                *puiBlock++ = RtpOsUtil::Ntohl(pobjRcvrElm->delaySinceLastRrt());
+            }
+        }
+    }
+
+    if (uiAppLen > RTP_ZERO)
+    {
+        memcpy(puiBlock, m_stRtcpXr.m_pBlockBuffer, uiAppLen);
+    }
+
     pobjRtcpXrPacket->setReportBlk(pobjPayload);
 
     // set the RTCP packet
@@ -2294,10 +2531,59 @@ eRTP_STATUS_CODE RtpSession::populateRtcpXrPacket(IN_OUT RtcpPacket* pobjRtcpPkt
     return RTP_SUCCESS;
 }
 
+RtpDt_Void RtpSession::processXrPacket(IN RtcpBlockView& objBlock, IN RtpDt_UInt32 currentTime)
+{
+    RtpDt_UInt16 usOffset = RTP_ZERO;
+    RtpDt_UChar ucBlockType = RTP_ZERO;
+    RtpDt_UChar* pucBlock = nullptr;
+    RtpDt_UInt16 usBlockLen = RTP_ZERO;
+
+    while (objBlock.getNextXrBlock(usOffset, ucBlockType, pucBlock, usBlockLen) == eRTP_TRUE)
+    {
+        RtpDt_UInt32* puiBlock = reinterpret_cast<RtpDt_UInt32*>(pucBlock);
+
+        if (ucBlockType == RTCP_XR_RRT_BLOCK_TYPE && usBlockLen >= RTCP_XR_RRT_BLOCK_LEN)
+        {
+            RtpDt_UInt32 uiSsrc = objBlock.getSsrc();
+
+            for (auto& pobjRcvrElm : *m_pobjRtpRcvrInfoList)
+            {
+                if (pobjRcvrElm != nullptr && pobjRcvrElm->getSsrc() == uiSsrc)
+                {
+                    tRTP_NTP_TIME stRrtTs = {
+                            RtpOsUtil::Ntohl(puiBlock[1]), RtpOsUtil::Ntohl(puiBlock[2])};
+                    tRTP_NTP_TIME stRcvdTs = {RTP_ZERO, RTP_ZERO};
+                    RtpOsUtil::GetNtpTime(stRcvdTs);
+                    pobjRcvrElm->setLastRrtTimestamp(&stRrtTs, &stRcvdTs);
+                    break;
+                }
+            }
+        }
+        else if (ucBlockType == RTCP_XR_DLRR_BLOCK_TYPE)
+        {
+            // the sub-blocks follow the block header
+            for (RtpDt_UInt16 usPos = RTP_WORD_SIZE;
+                    usPos + RTCP_XR_DLRR_SUB_BLOCK_LEN <= usBlockLen;
+                    usPos += RTCP_XR_DLRR_SUB_BLOCK_LEN)
+            {
+                RtpDt_UInt32* puiSubBlock = reinterpret_cast<RtpDt_UInt32*>(pucBlock + usPos);
+
+                if (RtpOsUtil::Ntohl(puiSubBlock[0]) == m_uiSsrc)
+                {
+                    calculateAndSetRTTD(currentTime, RtpOsUtil::Ntohl(puiSubBlock[1]),
+                            RtpOsUtil::Ntohl(puiSubBlock[2]));
+                    break;
+                }
+            }
+        }
+    }
+}
+
 eRTP_STATUS_CODE RtpSession::sendRtcpXrPacket(
         IN RtpDt_UChar* m_pBlockBuffer, IN RtpDt_UInt16 nblockLength)
 {
-    // set timestamp
+    std::lock_guard<std::mutex> guard(m_objRtcpLock);
+
     m_stRtcpXr.m_pBlockBuffer = new RtpDt_UChar[nblockLength];
     if (m_stRtcpXr.m_pBlockBuffer == nullptr)
     {
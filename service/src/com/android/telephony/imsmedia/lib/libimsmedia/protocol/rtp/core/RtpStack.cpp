@@ -17,6 +17,7 @@
 #include <RtpStack.h>
 #include <RtpStackUtil.h>
 #include <RtpTrace.h>
+#include <algorithm>
 
 RtpStack::RtpStack() :
         m_objRtpSessionList(std::list<RtpSession*>()),
@@ -32,12 +33,17 @@ RtpStack::~RtpStack()
         delete m_pobjStackProfile;
     }
 
+    std::list<RtpSession*> objRtpSessionList;
+    {
+        std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+        objRtpSessionList.swap(m_objRtpSessionList);
+    }
+
     // delete all RTP session objects.
-    for (auto& pobjRtpSession : m_objRtpSessionList)
+    for (auto& pobjRtpSession : objRtpSessionList)
     {
         pobjRtpSession->deleteRtpSession();
     }
-    m_objRtpSessionList.clear();
 }
 
 RtpStack::RtpStack(IN RtpStackProfile* pobjStackProfile)
@@ -57,7 +63,10 @@ RtpSession* RtpStack::createRtpSession()
     }
 
     // add session into m_objRtpSessionList
-    m_objRtpSessionList.push_back(pobjRtpSession);
+    {
+        std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+        m_objRtpSessionList.push_back(pobjRtpSession);
+    }
 
     // generate SSRC
     RtpDt_UInt32 uiSsrc = RtpStackUtil::generateNewSsrc(uiTermNum);
@@ -68,16 +77,9 @@ RtpSession* RtpStack::createRtpSession()
 
 eRtp_Bool RtpStack::isValidRtpSession(IN RtpSession* pobjSession)
 {
-    for (auto& pobjRtpSesItem : m_objRtpSessionList)
-    {
-        // get Rtp Session from list
-        if (pobjRtpSesItem->compareRtpSessions(pobjSession) == eRTP_SUCCESS)
-        {
-            return eRTP_SUCCESS;
-        }
-    }
-
-    return eRTP_FAILURE;
+    std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+    auto iter = std::find(m_objRtpSessionList.begin(), m_objRtpSessionList.end(), pobjSession);
+    return iter != m_objRtpSessionList.end() ? eRTP_SUCCESS : eRTP_FAILURE;
 }
 
 eRTP_STATUS_CODE RtpStack::deleteRtpSession(IN RtpSession* pobjRtpSession)
@@ -88,18 +90,22 @@ eRTP_STATUS_CODE RtpStack::deleteRtpSession(IN RtpSession* pobjRtpSession)
         return RTP_INVALID_PARAMS;
     }
 
-    eRtp_Bool bisRtpSes = eRTP_SUCCESS;
-    bisRtpSes = isValidRtpSession(pobjRtpSession);
-
-    if (bisRtpSes == eRTP_SUCCESS)
     {
-        pobjRtpSession->deleteRtpSession();
-        m_objRtpSessionList.remove(pobjRtpSession);
+        std::lock_guard<std::mutex> guard(m_objRtpSessionLock);
+        auto iter =
+                std::find(m_objRtpSessionList.begin(), m_objRtpSessionList.end(), pobjRtpSession);
+
+        if (iter == m_objRtpSessionList.end())
+        {
+            return RTP_FAILURE;
+        }
 
-        return RTP_SUCCESS;
+        m_objRtpSessionList.erase(iter);
     }
 
-    return RTP_FAILURE;
+    // the session stops its timer out of the lock, the timer callback checks the session
+    pobjRtpSession->deleteRtpSession();
+    return RTP_SUCCESS;
 }
 
 RtpStackProfile* RtpStack::getStackProfile()
@@ -98,38 +98,31 @@ RtpDt_UInt32 RtpStackUtil::calcRtpTimestamp(IN RtpDt_UInt32 uiPrevRtpTs,
         return RTP_ZERO;
     }
 
-    RtpDt_Int32 iTimeDiffHigh32Bits = RTP_ZERO;
-    RtpDt_Int32 iTimeDiffLow32Bits = RTP_ZERO;
-
-    if ((RTP_ZERO != pstPrevNtpTs->m_uiNtpHigh32Bits) ||
-            (RTP_ZERO != pstPrevNtpTs->m_uiNtpLow32Bits))
-    {
-        iTimeDiffHigh32Bits = pstCurNtpTs->m_uiNtpHigh32Bits - pstPrevNtpTs->m_uiNtpHigh32Bits;
-        iTimeDiffLow32Bits = (pstCurNtpTs->m_uiNtpLow32Bits / 4294UL) -
-                (pstPrevNtpTs->m_uiNtpLow32Bits / 4294UL);
-    }
-    else
+    if ((RTP_ZERO == pstPrevNtpTs->m_uiNtpHigh32Bits) &&
+            (RTP_ZERO == pstPrevNtpTs->m_uiNtpLow32Bits))
     {
-        iTimeDiffHigh32Bits = RTP_ZERO;
-        iTimeDiffLow32Bits = RTP_ZERO;
+        return uiPrevRtpTs;
     }
 
-    // calc iTimeDiff in millisec
-    RtpDt_Int32 iTimeDiff = (iTimeDiffHigh32Bits * 1000 * 1000) + iTimeDiffLow32Bits;
-
-    /* the time diff high bit is in seconds and
-       the time diff low bit is in micro seconds */
-
-    RtpDt_UInt32 uiNewRtpTs = RTP_ZERO;
-
-    if (RTP_ZERO == iTimeDiff)
-    {
-        uiNewRtpTs = uiPrevRtpTs;
-    }
-    else
+    // time difference in NTP 32.32 fixed point format
+    RtpDt_UInt64 ulCurNtpTs =
+            (static_cast<RtpDt_UInt64>(pstCurNtpTs->m_uiNtpHigh32Bits) << RTP_32) |
+            pstCurNtpTs->m_uiNtpLow32Bits;
+    RtpDt_UInt64 ulPrevNtpTs =
+            (static_cast<RtpDt_UInt64>(pstPrevNtpTs->m_uiNtpHigh32Bits) << RTP_32) |
+            pstPrevNtpTs->m_uiNtpLow32Bits;
+    eRtp_Bool bNegative = (ulCurNtpTs < ulPrevNtpTs) ? eRTP_TRUE : eRTP_FALSE;
+    RtpDt_UInt64 ulTimeDiff =
+            (bNegative == eRTP_TRUE) ? (ulPrevNtpTs - ulCurNtpTs) : (ulCurNtpTs - ulPrevNtpTs);
+
+    // convert to media clock ticks, seconds and fraction are scaled separately to avoid overflow
+    RtpDt_UInt64 ulTicks = ((ulTimeDiff >> RTP_32) * uiSamplingRate) +
+            (((ulTimeDiff & 0xFFFFFFFFULL) * uiSamplingRate) >> RTP_32);
+
+    if (bNegative == eRTP_TRUE)
     {
-        RtpDt_Int32 temp = uiSamplingRate / 1000;
-        uiNewRtpTs = uiPrevRtpTs + (temp * iTimeDiff / 1000);
+        return uiPrevRtpTs - static_cast<RtpDt_UInt32>(ulTicks);
     }
-    return uiNewRtpTs;
+
+    return uiPrevRtpTs + static_cast<RtpDt_UInt32>(ulTicks);
 }
@@ -35,7 +35,8 @@ RtpTimerInfo::RtpTimerInfo() :
         m_uiRtcpBw(RTP_ZERO),
         m_uiWeSent(RTP_ZERO),
         m_ulAvgRtcpSize(RTP_ZERO),
-        m_bInitial(eRTP_TRUE)
+        m_bInitial(eRTP_TRUE),
+        m_bAllowEarly(eRTP_TRUE)
 {
 }
 
@@ -69,6 +70,7 @@ RtpDt_Void RtpTimerInfo::cleanUp()
     m_uiWeSent = RTP_ZERO;
     m_ulAvgRtcpSize = RTP_ZERO;
     m_bInitial = eRTP_TRUE;
+    m_bAllowEarly = eRTP_TRUE;
 }
 
 /*********************************************************
@@ -336,3 +338,29 @@ RtpDt_Void RtpTimerInfo::setInitial(IN eRtp_Bool bSetInitial)
 {
     m_bInitial = bSetInitial;
 }
+
+/*********************************************************
+ * Function name        : isAllowEarly
+ * Description          : get method for m_bAllowEarly
+ * Return type          : eRtp_Bool
+ * Argument             : None
+ * Preconditions        : None
+ * Side Effects            : None
+ ********************************************************/
+eRtp_Bool RtpTimerInfo::isAllowEarly()
+{
+    return m_bAllowEarly;
+}
+
+/*********************************************************
+ * Function name        : setAllowEarly
+ * Description          : set method for m_bAllowEarly
+ * Return type          : RtpDt_Void
+ * Argument             : eRtp_Bool : In
+ * Preconditions        : None
+ * Side Effects            : None
+ ********************************************************/
+RtpDt_Void RtpTimerInfo::setAllowEarly(IN eRtp_Bool bAllowEarly)
+{
+    m_bAllowEarly = bAllowEarly;
+}
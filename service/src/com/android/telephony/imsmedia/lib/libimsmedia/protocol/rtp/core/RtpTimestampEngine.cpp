@@ -0,0 +1,125 @@
+/**
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpTimestampEngine.h>
+
+#define RTP_SEC_TO_NANOSEC 1000000000ULL
+
+RtpTimestampEngine::RtpTimestampEngine() :
+        m_ulNtpAnchorTime(RTP_ZERO),
+        m_ulNtpAnchor(RTP_ZERO),
+        m_ulRtpAnchorTime(RTP_ZERO),
+        m_uiRtpAnchor(RTP_ZERO),
+        m_uiSamplingRate(RTP_ZERO)
+{
+}
+
+RtpTimestampEngine::~RtpTimestampEngine() {}
+
+RtpDt_Void RtpTimestampEngine::init(IN RtpDt_UInt64 ulTime, IN tRTP_NTP_TIME* pstNtpTime,
+        IN RtpDt_UInt32 uiRtpTimestamp, IN RtpDt_UInt32 uiSamplingRate)
+{
+    m_ulNtpAnchorTime = ulTime;
+    m_ulNtpAnchor = RTP_ZERO;
+
+    if (pstNtpTime != nullptr)
+    {
+        m_ulNtpAnchor = (static_cast<RtpDt_UInt64>(pstNtpTime->m_uiNtpHigh32Bits) << RTP_32) |
+                pstNtpTime->m_uiNtpLow32Bits;
+    }
+
+    m_ulRtpAnchorTime = ulTime;
+    m_uiRtpAnchor = uiRtpTimestamp;
+    m_uiSamplingRate = uiSamplingRate;
+}
+
+RtpDt_Void RtpTimestampEngine::setRtpAnchor(IN RtpDt_UInt64 ulTime, IN RtpDt_UInt32 uiRtpTimestamp)
+{
+    m_ulRtpAnchorTime = ulTime;
+    m_uiRtpAnchor = uiRtpTimestamp;
+}
+
+RtpDt_Void RtpTimestampEngine::setSamplingRate(
+        IN RtpDt_UInt64 ulTime, IN RtpDt_UInt32 uiSamplingRate)
+{
+    if (uiSamplingRate == m_uiSamplingRate)
+    {
+        return;
+    }
+
+    setRtpAnchor(ulTime, getRtpTimestamp(ulTime));
+    m_uiSamplingRate = uiSamplingRate;
+}
+
+RtpDt_UInt32 RtpTimestampEngine::getSamplingRate()
+{
+    return m_uiSamplingRate;
+}
+
+RtpDt_Void RtpTimestampEngine::getNtpTime(IN RtpDt_UInt64 ulTime, OUT tRTP_NTP_TIME* pstNtpTime)
+{
+    if (pstNtpTime == nullptr)
+    {
+        return;
+    }
+
+    RtpDt_UInt64 ulNtpTime = m_ulNtpAnchor;
+
+    if (ulTime >= m_ulNtpAnchorTime)
+    {
+        ulNtpTime += convertToNtp(ulTime - m_ulNtpAnchorTime);
+    }
+    else
+    {
+        ulNtpTime -= convertToNtp(m_ulNtpAnchorTime - ulTime);
+    }
+
+    pstNtpTime->m_uiNtpHigh32Bits = static_cast<RtpDt_UInt32>(ulNtpTime >> RTP_32);
+    pstNtpTime->m_uiNtpLow32Bits = static_cast<RtpDt_UInt32>(ulNtpTime);
+}
+
+RtpDt_UInt32 RtpTimestampEngine::getRtpTimestamp(IN RtpDt_UInt64 ulTime)
+{
+    // RTP timestamps wrap around, the truncation to 32 bits is intended
+    if (ulTime >= m_ulRtpAnchorTime)
+    {
+        return m_uiRtpAnchor +
+                static_cast<RtpDt_UInt32>(
+                        convertToRtpTicks(ulTime - m_ulRtpAnchorTime, m_uiSamplingRate));
+    }
+
+    return m_uiRtpAnchor -
+            static_cast<RtpDt_UInt32>(
+                    convertToRtpTicks(m_ulRtpAnchorTime - ulTime, m_uiSamplingRate));
+}
+
+RtpDt_UInt64 RtpTimestampEngine::convertToRtpTicks(
+        IN RtpDt_UInt64 ulDuration, IN RtpDt_UInt32 uiSamplingRate)
+{
+    // split in seconds and the remainder so that the products can not overflow 64 bits
+    RtpDt_UInt64 ulSec = ulDuration / RTP_SEC_TO_NANOSEC;
+    RtpDt_UInt64 ulNanoSec = ulDuration % RTP_SEC_TO_NANOSEC;
+
+    return (ulSec * uiSamplingRate) + ((ulNanoSec * uiSamplingRate) / RTP_SEC_TO_NANOSEC);
+}
+
+RtpDt_UInt64 RtpTimestampEngine::convertToNtp(IN RtpDt_UInt64 ulDuration)
+{
+    RtpDt_UInt64 ulSec = ulDuration / RTP_SEC_TO_NANOSEC;
+    RtpDt_UInt64 ulNanoSec = ulDuration % RTP_SEC_TO_NANOSEC;
+
+    return (ulSec << RTP_32) + ((ulNanoSec << RTP_32) / RTP_SEC_TO_NANOSEC);
+}
@@ -15,6 +15,7 @@
  */
 
 #include <sys/time.h>
+#include <time.h>
 #include <stdlib.h>
 #include <netinet/in.h>
 #include <RtpOsUtil.h>
@@ -31,22 +32,51 @@ RtpDt_Void RtpOsUtil::GetNtpTime(tRTP_NTP_TIME& pstNtpTime)
     {
         // To convert a UNIX timestamp (seconds since 1970) to NTP time, add 2,208,988,800 seconds
         pstNtpTime.m_uiNtpHigh32Bits = stAndrodTp.tv_sec + 2208988800UL;
-        pstNtpTime.m_uiNtpLow32Bits = (RtpDt_UInt32)(stAndrodTp.tv_usec * 4294UL);
+        // fraction of second in units of 2^-32 seconds
+        pstNtpTime.m_uiNtpLow32Bits = static_cast<RtpDt_UInt32>(
+                (static_cast<RtpDt_UInt64>(stAndrodTp.tv_usec) << 32) / 1000000ULL);
     }
 }
 
+RtpDt_UInt64 RtpOsUtil::GetMonotonicTime()
+{
+    struct timespec stTime;
+
+    if (clock_gettime(CLOCK_MONOTONIC, &stTime) != 0)
+    {
+        return RTP_ZERO;
+    }
+
+    return (static_cast<RtpDt_UInt64>(stTime.tv_sec) * 1000000000ULL) + stTime.tv_nsec;
+}
+
+// the generator state is kept per thread, so that threads do not share the state of rand()
+static thread_local RtpDt_UInt32 s_uiRandSeed = RTP_ZERO;
+
 RtpDt_Void RtpOsUtil::Srand()
 {
     struct timeval stSysTime;
     gettimeofday(&stSysTime, nullptr);
-    RtpDt_UInt32 uiSeed = stSysTime.tv_usec * 1000;
-    srand(uiSeed);
+    RtpDt_UInt64 ulTime = GetMonotonicTime();
+
+    // mix the address of the thread local state in to differ the threads seeded at the same time
+    s_uiRandSeed = (stSysTime.tv_usec * 1000) ^ static_cast<RtpDt_UInt32>(ulTime) ^
+            static_cast<RtpDt_UInt32>(reinterpret_cast<uintptr_t>(&s_uiRandSeed));
+
+    if (s_uiRandSeed == RTP_ZERO)
+    {
+        s_uiRandSeed = RTP_ONE;
+    }
 }
 
 RtpDt_UInt32 RtpOsUtil::Rand()
 {
-    RtpOsUtil::Srand();
-    return rand();
+    if (s_uiRandSeed == RTP_ZERO)
+    {
+        RtpOsUtil::Srand();
+    }
+
+    return rand_r(&s_uiRandSeed);
 }
 
 RtpDt_UInt32 RtpOsUtil::Ntohl(RtpDt_UInt32 uiNetlong)
@@ -57,8 +87,8 @@ RtpDt_UInt32 RtpOsUtil::Ntohl(RtpDt_UInt32 uiNetlong)
 RtpDt_Double RtpOsUtil::RRand()
 {
     tRTP_NTP_TIME stNtpTs = {0, 0};
-    RtpOsUtil::Srand();
-    RtpDt_Double dRandNum = static_cast<RtpDt_Double>(rand()) / static_cast<RtpDt_Double>(RAND_MAX);
+    RtpDt_Double dRandNum =
+            static_cast<RtpDt_Double>(RtpOsUtil::Rand()) / static_cast<RtpDt_Double>(RAND_MAX);
     RtpOsUtil::GetNtpTime(stNtpTs);
     RtpDt_Double dTemp = ((dRandNum * stNtpTs.m_uiNtpHigh32Bits) +
             (stNtpTs.m_uiNtpLow32Bits / static_cast<RtpDt_Double>(RTP_MILLISEC_MICRO)));
@@ -42,6 +42,10 @@ const bool kDtxEnabled = true;
 const int32_t kCodecType = AudioConfig::CODEC_AMR_WB;
 const int8_t kDtmfPayloadTypeNumber = 100;
 const int8_t kDtmfsamplingRateKHz = 16;
+const int8_t kRedPayloadTypeNumber = 101;
+const int8_t kRedundancyLevel = 2;
+const int8_t kRedundancyDistance = 1;
+const int8_t kPlayoutDelayPercentile = 97;
 
 // AmrParam
 const int32_t kAmrMode = 8;
@@ -97,6 +101,10 @@ protected:
         config1.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
         config1.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
         config1.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+        config1.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+        config1.setRedundancyLevel(kRedundancyLevel);
+        config1.setRedundancyDistance(kRedundancyDistance);
+        config1.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
         config1.setAmrParams(amr);
         config1.setEvsParams(evs);
     }
@@ -113,6 +121,10 @@ TEST_F(AudioConfigTest, TestGetterSetter)
     EXPECT_EQ(config1.getTxDtmfPayloadTypeNumber(), kDtmfPayloadTypeNumber);
     EXPECT_EQ(config1.getRxDtmfPayloadTypeNumber(), kDtmfPayloadTypeNumber);
     EXPECT_EQ(config1.getDtmfsamplingRateKHz(), kDtmfsamplingRateKHz);
+    EXPECT_EQ(config1.getRedPayloadTypeNumber(), kRedPayloadTypeNumber);
+    EXPECT_EQ(config1.getRedundancyLevel(), kRedundancyLevel);
+    EXPECT_EQ(config1.getRedundancyDistance(), kRedundancyDistance);
+    EXPECT_EQ(config1.getPlayoutDelayPercentile(), kPlayoutDelayPercentile);
     EXPECT_EQ(config1.getAmrParams(), amr);
     EXPECT_EQ(config1.getEvsParams(), evs);
 }
@@ -155,6 +167,10 @@ TEST_F(AudioConfigTest, TestEqual)
     config2.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     config2.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     config2.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+    config2.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    config2.setRedundancyLevel(kRedundancyLevel);
+    config2.setRedundancyDistance(kRedundancyDistance);
+    config2.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
     config2.setAmrParams(amr);
     config2.setEvsParams(evs);
     EXPECT_EQ(config2, config1);
@@ -177,6 +193,10 @@ TEST_F(AudioConfigTest, TestNotEqual)
     config2.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     config2.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     config2.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+    config2.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    config2.setRedundancyLevel(kRedundancyLevel);
+    config2.setRedundancyDistance(kRedundancyDistance);
+    config2.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
     config2.setAmrParams(amr);
     config2.setEvsParams(evs);
 
@@ -195,11 +215,19 @@ TEST_F(AudioConfigTest, TestNotEqual)
     config3.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     config3.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     config3.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+    config3.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    config3.setRedundancyLevel(kRedundancyLevel);
+    config3.setRedundancyDistance(kRedundancyDistance);
+    config3.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
     config3.setAmrParams(amr);
     config3.setEvsParams(evs);
 
     EXPECT_NE(config2, config1);
     EXPECT_NE(config3, config1);
+
+    config3 = config1;
+    config3.setRedundancyLevel(kRedundancyLevel + 1);
+    EXPECT_NE(config3, config1);
 }
 
 TEST_F(AudioConfigTest, TestParcelWithoutRtcp)
@@ -221,6 +249,10 @@ TEST_F(AudioConfigTest, TestParcelWithoutRtcp)
     configWrite.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     configWrite.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     configWrite.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+    configWrite.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    configWrite.setRedundancyLevel(kRedundancyLevel);
+    configWrite.setRedundancyDistance(kRedundancyDistance);
+    configWrite.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
     configWrite.setAmrParams(amr);
     configWrite.setEvsParams(evs);
     configWrite.writeToParcel(&parcel);
@@ -256,6 +288,10 @@ TEST_F(AudioConfigTest, TestParcelWithoutAmrParams)
     configWrite.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     configWrite.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     configWrite.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+    configWrite.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    configWrite.setRedundancyLevel(kRedundancyLevel);
+    configWrite.setRedundancyDistance(kRedundancyDistance);
+    configWrite.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
     configWrite.setEvsParams(evs);
     configWrite.writeToParcel(&parcel);
     parcel.setDataPosition(0);
@@ -289,6 +325,10 @@ TEST_F(AudioConfigTest, TestParcelWithoutEvsParams)
     configWrite.setTxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     configWrite.setRxDtmfPayloadTypeNumber(kDtmfPayloadTypeNumber);
     configWrite.setDtmfsamplingRateKHz(kDtmfsamplingRateKHz);
+    configWrite.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    configWrite.setRedundancyLevel(kRedundancyLevel);
+    configWrite.setRedundancyDistance(kRedundancyDistance);
+    configWrite.setPlayoutDelayPercentile(kPlayoutDelayPercentile);
     configWrite.setAmrParams(amr);
     configWrite.writeToParcel(&parcel);
     parcel.setDataPosition(0);
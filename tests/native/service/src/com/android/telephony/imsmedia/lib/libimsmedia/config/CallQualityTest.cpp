@@ -41,6 +41,7 @@ const int64_t kMinPlayoutDelayMillis = 100;
 const int64_t kMaxPlayoutDelayMillis = 180;
 const int32_t kNumRtpSidPacketsReceived = 10;
 const int32_t kNumRtpDuplicatePackets = 1;
+const int32_t kNumHeaderBytesSaved = 400;
 
 class CallQualityTest : public ::testing::Test
 {
@@ -78,7 +79,11 @@ protected:
     virtual void TearDown() override {}
 };
 
-TEST_F(CallQualityTest, TestGetterSetter) {}
+TEST_F(CallQualityTest, TestGetterSetter)
+{
+    quality2.setNumHeaderBytesSaved(kNumHeaderBytesSaved);
+    EXPECT_EQ(quality2.getNumHeaderBytesSaved(), kNumHeaderBytesSaved);
+}
 
 TEST_F(CallQualityTest, TestParcel)
 {
@@ -170,4 +175,8 @@ TEST_F(CallQualityTest, TestNotEqual)
     quality3.setNumRtpSidPacketsReceived(kNumRtpSidPacketsReceived);
     quality3.setNumRtpDuplicatePackets(kNumRtpDuplicatePackets);
     EXPECT_NE(quality3, quality1);
+
+    quality3 = quality1;
+    quality3.setNumHeaderBytesSaved(kNumHeaderBytesSaved);
+    EXPECT_NE(quality3, quality1);
 }
@@ -24,6 +24,8 @@ const int32_t kTransmitPort = 1000;
 const int32_t kIntervalSec = 1500;
 const int32_t kRtcpXrBlockTypes = RtcpConfig::FLAG_RTCPXR_STATISTICS_SUMMARY_REPORT_BLOCK |
         RtcpConfig::FLAG_RTCPXR_VOIP_METRICS_REPORT_BLOCK;
+const bool kRtcpMuxEnabled = true;
+const bool kRtcpReducedSizeEnabled = true;
 
 TEST(RtcpConfigTest, TestGetterSetter)
 {
@@ -32,10 +34,14 @@ TEST(RtcpConfigTest, TestGetterSetter)
     rtcp->setTransmitPort(kTransmitPort);
     rtcp->setIntervalSec(kIntervalSec);
     rtcp->setRtcpXrBlockTypes(kRtcpXrBlockTypes);
+    rtcp->setRtcpMuxEnabled(kRtcpMuxEnabled);
+    rtcp->setRtcpReducedSizeEnabled(kRtcpReducedSizeEnabled);
     EXPECT_EQ(rtcp->getCanonicalName(), kCanonicalName);
     EXPECT_EQ(rtcp->getTransmitPort(), kTransmitPort);
     EXPECT_EQ(rtcp->getIntervalSec(), kIntervalSec);
     EXPECT_EQ(rtcp->getRtcpXrBlockTypes(), kRtcpXrBlockTypes);
+    EXPECT_EQ(rtcp->getRtcpMuxEnabled(), kRtcpMuxEnabled);
+    EXPECT_EQ(rtcp->getRtcpReducedSizeEnabled(), kRtcpReducedSizeEnabled);
     delete rtcp;
 }
 
@@ -46,6 +52,8 @@ TEST(RtcpConfigTest, TestParcel)
     rtcp->setTransmitPort(kTransmitPort);
     rtcp->setIntervalSec(kIntervalSec);
     rtcp->setRtcpXrBlockTypes(kRtcpXrBlockTypes);
+    rtcp->setRtcpMuxEnabled(kRtcpMuxEnabled);
+    rtcp->setRtcpReducedSizeEnabled(kRtcpReducedSizeEnabled);
 
     android::Parcel parcel;
     rtcp->writeToParcel(&parcel);
@@ -114,6 +122,14 @@ TEST(RtcpConfigTest, TestNotEqual)
     EXPECT_NE(*rtcp, *rtcp2);
     EXPECT_NE(*rtcp, *rtcp3);
 
+    RtcpConfig rtcp4(*rtcp);
+    rtcp4.setRtcpMuxEnabled(kRtcpMuxEnabled);
+    EXPECT_NE(*rtcp, rtcp4);
+
+    RtcpConfig rtcp5(*rtcp);
+    rtcp5.setRtcpReducedSizeEnabled(kRtcpReducedSizeEnabled);
+    EXPECT_NE(*rtcp, rtcp5);
+
     delete rtcp;
     delete rtcp2;
     delete rtcp3;
@@ -52,6 +52,8 @@ const android::String8 kPauseImagePath("data/user_de/0/com.android.telephony.ims
 const int32_t kDeviceOrientationDegree = 0;
 const int32_t kCvoValue = 1;
 const int32_t kRtcpFbTypes = VideoConfig::RTP_FB_NONE;
+const int32_t kTransportSeqValue = 2;
+const int32_t kFecPayloadType = 120;
 
 // for encoder
 const char* kMimeType = "video/avc";
@@ -96,6 +98,8 @@ protected:
         config1.setDeviceOrientationDegree(kDeviceOrientationDegree);
         config1.setCvoValue(kCvoValue);
         config1.setRtcpFbType(kRtcpFbTypes);
+        config1.setTransportSeqValue(kTransportSeqValue);
+    config1.setFecPayloadType(kFecPayloadType);
     }
 
     virtual void TearDown() override {}
@@ -128,6 +132,8 @@ TEST_F(VideoConfigTest, TestGetterSetter)
     EXPECT_EQ(config1.getDeviceOrientationDegree(), kDeviceOrientationDegree);
     EXPECT_EQ(config1.getCvoValue(), kCvoValue);
     EXPECT_EQ(config1.getRtcpFbType(), kRtcpFbTypes);
+    EXPECT_EQ(config1.getTransportSeqValue(), kTransportSeqValue);
+    EXPECT_EQ(config1.getFecPayloadType(), kFecPayloadType);
 }
 
 TEST_F(VideoConfigTest, TestParcel)
@@ -180,6 +186,8 @@ TEST_F(VideoConfigTest, TestEqual)
     config2.setDeviceOrientationDegree(kDeviceOrientationDegree);
     config2.setCvoValue(kCvoValue);
     config2.setRtcpFbType(kRtcpFbTypes);
+    config2.setTransportSeqValue(kTransportSeqValue);
+    config2.setFecPayloadType(kFecPayloadType);
     EXPECT_EQ(config2, config1);
 }
 
@@ -210,6 +218,8 @@ TEST_F(VideoConfigTest, TestNotEqual)
     config2.setDeviceOrientationDegree(kDeviceOrientationDegree);
     config2.setCvoValue(kCvoValue);
     config2.setRtcpFbType(kRtcpFbTypes);
+    config2.setTransportSeqValue(kTransportSeqValue);
+    config2.setFecPayloadType(kFecPayloadType);
 
     config3.setMediaDirection(kMediaDirection);
     config3.setRemoteAddress(kRemoteAddress);
@@ -236,7 +246,17 @@ TEST_F(VideoConfigTest, TestNotEqual)
     config3.setDeviceOrientationDegree(kDeviceOrientationDegree);
     config3.setCvoValue(kCvoValue);
     config3.setRtcpFbType(kRtcpFbTypes);
+    config3.setTransportSeqValue(kTransportSeqValue);
+    config3.setFecPayloadType(kFecPayloadType);
 
     EXPECT_NE(config2, config1);
     EXPECT_NE(config3, config1);
+
+    config3 = config1;
+    config3.setTransportSeqValue(kTransportSeqValue + 1);
+    EXPECT_NE(config3, config1);
+
+    config3 = config1;
+    config3.setFecPayloadType(kFecPayloadType + 1);
+    EXPECT_NE(config3, config1);
 }
@@ -16,6 +16,8 @@
 
 #include <gtest/gtest.h>
 #include <AudioJitterBuffer.h>
+#include <algorithm>
+#include <vector>
 
 #define TEST_BUFFER_SIZE    10
 #define TEST_FRAME_INTERVAL 20
@@ -29,6 +31,12 @@ public:
         numLost = 0;
         numDuplicated = 0;
         numDiscarded = 0;
+        numLate = 0;
+        numPartialCopy = 0;
+        jitterBufferSize = 0;
+        numCatchUp = 0;
+        catchUpDuration = 0;
+        catchUpRecovered = 0;
     }
     virtual ~AudioJitterBufferCallback() {}
 
@@ -50,6 +58,10 @@ public:
                     break;
                 case kRtpStatusDiscarded:
                     numDiscarded++;
+                    discardedSeqs.push_back(param->type);
+                    break;
+                case kRtpStatusLate:
+                    numLate++;
                     break;
                 case kRtpStatusNormal:
                     numNormal++;
@@ -73,21 +85,49 @@ public:
             {
                 numLost += param->param2;
             }
+            else if (param->type == kReportPartialCopyRecovered)
+            {
+                numPartialCopy += param->param2;
+            }
+            else if (param->type == kReportCatchUp)
+            {
+                numCatchUp++;
+                catchUpDuration = param->param1;
+                catchUpRecovered = param->param2;
+            }
 
             delete param;
         }
+        else if (type == kCollectJitterBufferSize)
+        {
+            jitterBufferSize = param1;
+        }
     }
 
     int32_t getNumNormal() { return numNormal; }
     int32_t getNumLost() { return numLost; }
     int32_t getNumDuplicated() { return numDuplicated; }
     int32_t getNumDiscarded() { return numDiscarded; }
+    const std::vector<int32_t>& getDiscardedSeqs() { return discardedSeqs; }
+    int32_t getNumLate() { return numLate; }
+    int32_t getNumPartialCopy() { return numPartialCopy; }
+    int32_t getJitterBufferSize() { return jitterBufferSize; }
+    int32_t getNumCatchUp() { return numCatchUp; }
+    int32_t getCatchUpDuration() { return catchUpDuration; }
+    int32_t getCatchUpRecovered() { return catchUpRecovered; }
 
 private:
     int32_t numNormal;
     int32_t numLost;
     int32_t numDuplicated;
     int32_t numDiscarded;
+    std::vector<int32_t> discardedSeqs;
+    int32_t numLate;
+    int32_t numPartialCopy;
+    int32_t jitterBufferSize;
+    int32_t numCatchUp;
+    int32_t catchUpDuration;
+    int32_t catchUpRecovered;
 };
 
 class AudioJitterBufferTest : public ::testing::Test
@@ -402,6 +442,147 @@ TEST_F(AudioJitterBufferTest, TestAddGetDuplicatedSeqDetection)
     EXPECT_EQ(mCallback.getNumNormal(), kNumFrames);
 }
 
+TEST_F(AudioJitterBufferTest, TestDiscardBySequenceJump)
+{
+    const uint16_t kNumFrames = 3;
+    const uint16_t kJumpSeq = JitterRingQueue::kMaxCapacity + 10;
+    char buffer[TEST_BUFFER_SIZE] = {"\x1"};
+
+    for (uint16_t i = 0; i < kNumFrames; i++)
+    {
+        mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                i * TEST_FRAME_INTERVAL, false, i, MEDIASUBTYPE_UNDEFINED, i * TEST_FRAME_INTERVAL);
+    }
+
+    // the frames not played are dropped by the jump of the sequence number
+    mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+            kNumFrames * TEST_FRAME_INTERVAL, false, kJumpSeq, MEDIASUBTYPE_UNDEFINED,
+            kNumFrames * TEST_FRAME_INTERVAL);
+    EXPECT_EQ(mJitterBuffer->GetCount(), 1);
+    EXPECT_EQ(mCallback.getNumDiscarded(), kNumFrames);
+
+    // the frame older than the range kept is rejected
+    mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+            (kNumFrames + 1) * TEST_FRAME_INTERVAL, false, kNumFrames, MEDIASUBTYPE_UNDEFINED,
+            (kNumFrames + 1) * TEST_FRAME_INTERVAL);
+    EXPECT_EQ(mJitterBuffer->GetCount(), 1);
+    EXPECT_EQ(mCallback.getNumDiscarded(), kNumFrames + 1);
+}
+
+TEST_F(AudioJitterBufferTest, TestAddGetRecoveredFrame)
+{
+    const int32_t kNumFrames = 20;
+    char buffer[TEST_BUFFER_SIZE] = {"\x1"};
+    int32_t countGet = 0;
+    int32_t countGetFrame = 0;
+    int32_t getTime = 0;
+
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        int32_t addTime = i * TEST_FRAME_INTERVAL;
+
+        if (i == 5)
+        {
+            // the frame recovered from the redundant data arrives before the late primary frame
+            mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                    i * TEST_FRAME_INTERVAL, false, i, MEDIASUBTYPE_AUDIO_RED, addTime);
+        }
+
+        mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                i * TEST_FRAME_INTERVAL, false, i, MEDIASUBTYPE_UNDEFINED, addTime);
+    }
+
+    while (mJitterBuffer->GetCount() > 0)
+    {
+        getTime = countGet * TEST_FRAME_INTERVAL;
+
+        if (mJitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq, getTime))
+        {
+            EXPECT_EQ(timestamp, countGetFrame * TEST_FRAME_INTERVAL);
+            EXPECT_EQ(seq, countGetFrame);
+            mJitterBuffer->Delete();
+            countGetFrame++;
+        }
+
+        countGet++;
+    }
+
+    EXPECT_EQ(countGetFrame, kNumFrames);
+    EXPECT_EQ(mCallback.getNumLost(), 0);
+    EXPECT_EQ(mCallback.getNumDuplicated(), 0);
+    EXPECT_EQ(mCallback.getNumDiscarded(), 0);
+}
+
+TEST_F(AudioJitterBufferTest, TestEvsPartialCopyRecovery)
+{
+    const int32_t kNumFrames = 20;
+    const int32_t kLostSeq = 5;
+    const int32_t kOffset = 2;
+    uint8_t buffer[kNumFrames][TEST_BUFFER_SIZE] = {};
+    int32_t countGet = 0;
+    int32_t countGetFrame = 0;
+
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+
+    mJitterBuffer->SetCodecType(kAudioCodecEvs);
+    mJitterBuffer->SetEvsRedundantFrameOffset(kOffset);
+
+    for (int32_t i = 0; i < kNumFrames || mJitterBuffer->GetCount() > 0; i++)
+    {
+        if (i < kNumFrames && i != kLostSeq)
+        {
+            buffer[i][0] = i;
+            mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, buffer[i], TEST_BUFFER_SIZE,
+                    i * TEST_FRAME_INTERVAL, false, i, MEDIASUBTYPE_UNDEFINED,
+                    i * TEST_FRAME_INTERVAL);
+        }
+
+        if (mJitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq,
+                    countGet * TEST_FRAME_INTERVAL))
+        {
+            EXPECT_EQ(timestamp, countGetFrame * TEST_FRAME_INTERVAL);
+
+            if (countGetFrame == kLostSeq)
+            {
+                // the partial copy is carried in the frame of the offset later
+                EXPECT_EQ(subtype, MEDIASUBTYPE_AUDIO_PARTIAL_COPY);
+                EXPECT_EQ(seq, kLostSeq + kOffset);
+                EXPECT_EQ(data[0], kLostSeq + kOffset);
+            }
+            else
+            {
+                EXPECT_EQ(subtype, MEDIASUBTYPE_UNDEFINED);
+                EXPECT_EQ(seq, countGetFrame);
+                EXPECT_EQ(data[0], countGetFrame);
+            }
+
+            mJitterBuffer->Delete();
+            countGetFrame++;
+        }
+
+        countGet++;
+    }
+
+    EXPECT_EQ(countGetFrame, kNumFrames);
+    // the recovery is reported by the player when the partial copy is decoded
+    EXPECT_EQ(mCallback.getNumPartialCopy(), 0);
+    // the packet is still reported as lost
+    EXPECT_EQ(mCallback.getNumLost(), 1);
+    EXPECT_EQ(mCallback.getNumNormal(), kNumFrames - 1);
+}
+
 TEST_F(AudioJitterBufferTest, TestAddGetInBurstIncoming)
 {
     const int32_t kNumFrames = 20;
@@ -491,4 +672,366 @@ TEST_F(AudioJitterBufferTest, TestAddGetInBurstIncoming)
     EXPECT_EQ(mCallback.getNumDiscarded(), 0);
     EXPECT_EQ(countNotGet, mStartJitterBufferSize);
     EXPECT_EQ(mCallback.getNumNormal(), kNumFrames);
-}
\ No newline at end of file
+}
+TEST_F(AudioJitterBufferTest, TestPlayoutDelayPercentile)
+{
+    const int32_t kNumFrames = 2000;
+    char buffer[TEST_BUFFER_SIZE] = {"\x1"};
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    int32_t countGet = 0;
+
+    mJitterBuffer->SetJitterBufferSize(4, 3, 9);
+    mJitterBuffer->SetPlayoutDelayOptions(0.97, 0.5, 0.02);
+
+    // the packets are delayed 70 ms for two seconds and return to the low jitter
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        int32_t delay = (i >= 200 && i < 300) ? 70 : (i % 3) * 5;
+        mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                i * TEST_FRAME_INTERVAL, false, i, MEDIASUBTYPE_UNDEFINED,
+                i * TEST_FRAME_INTERVAL + delay);
+
+        if (mJitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq,
+                    countGet++ * TEST_FRAME_INTERVAL))
+        {
+            mJitterBuffer->Delete();
+        }
+
+        if (i == 299)
+        {
+            // 80 ms of the target delay and the frame playing
+            EXPECT_EQ(mCallback.getJitterBufferSize(), 5 * TEST_FRAME_INTERVAL);
+        }
+    }
+
+    // the delayed packets fade out of the histogram
+    EXPECT_EQ(mCallback.getJitterBufferSize(), 3 * TEST_FRAME_INTERVAL);
+}
+
+TEST_F(AudioJitterBufferTest, TestDepthError)
+{
+    char buffer[TEST_BUFFER_SIZE] = {"\x1"};
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    int32_t countGet = 0;
+    uint16_t addSeq = 0;
+
+    auto addFrame = [&](int32_t addTime)
+    {
+        mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                addSeq * TEST_FRAME_INTERVAL, false, addSeq, MEDIASUBTYPE_UNDEFINED, addTime);
+        addSeq++;
+    };
+
+    auto getFrame = [&]()
+    {
+        if (mJitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq,
+                    countGet++ * TEST_FRAME_INTERVAL))
+        {
+            mJitterBuffer->Delete();
+        }
+    };
+
+    EXPECT_EQ(mJitterBuffer->GetDepthError(), 0);
+
+    for (int32_t i = 0; i < 50; i++)
+    {
+        addFrame(i * TEST_FRAME_INTERVAL);
+        getFrame();
+    }
+
+    EXPECT_EQ(mJitterBuffer->GetDepthError(), 0);
+
+    // the burst of the delayed frames
+    for (int32_t i = 0; i < 3; i++)
+    {
+        addFrame(50 * TEST_FRAME_INTERVAL);
+    }
+
+    EXPECT_EQ(mJitterBuffer->GetDepthError(), 3);
+
+    // the frames are not arriving
+    for (int32_t i = 0; i < 5; i++)
+    {
+        getFrame();
+    }
+
+    EXPECT_EQ(mJitterBuffer->GetDepthError(), -2);
+}
+
+/**
+ * @brief Plays the frames across the outage of the handover, the frames held in the outage arrive
+ * at once after it. The frames after the first silent one of the held frames are the SID.
+ *
+ * @return The playout delay of the last frame played
+ */
+static uint32_t playHandover(AudioJitterBuffer* jitterBuffer, int32_t firstSilentFrame,
+        int32_t* numPlayed)
+{
+    const int32_t kFramesBefore = 50;
+    const int32_t kOutageFrames = 50;
+    const int32_t kNumFrames = 300;
+    char speech[TEST_BUFFER_SIZE] = {"\x1"};
+    char sid[TEST_BUFFER_SIZE] = {"\x2"};
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    uint32_t lastDelay = 0;
+
+    auto addFrame = [&](int32_t i, int32_t addTime)
+    {
+        bool silence = i >= kFramesBefore + firstSilentFrame && i < kFramesBefore + kOutageFrames;
+        jitterBuffer->Add(MEDIASUBTYPE_UNDEFINED,
+                reinterpret_cast<uint8_t*>(silence ? sid : speech), silence ? 6 : 1,
+                i * TEST_FRAME_INTERVAL, false, i, MEDIASUBTYPE_UNDEFINED, addTime);
+    };
+
+    auto getFrame = [&](int32_t getTime)
+    {
+        if (jitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq, getTime))
+        {
+            lastDelay = getTime - timestamp;
+            (*numPlayed)++;
+            jitterBuffer->Delete();
+        }
+    };
+
+    for (int32_t i = 0; i < kFramesBefore + kOutageFrames; i++)
+    {
+        if (i < kFramesBefore)
+        {
+            addFrame(i, i * TEST_FRAME_INTERVAL);
+        }
+
+        getFrame(i * TEST_FRAME_INTERVAL);
+    }
+
+    for (int32_t i = kFramesBefore; i < kFramesBefore + kOutageFrames; i++)
+    {
+        addFrame(i, (kFramesBefore + kOutageFrames) * TEST_FRAME_INTERVAL);
+    }
+
+    for (int32_t i = kFramesBefore + kOutageFrames; i < kNumFrames; i++)
+    {
+        addFrame(i, i * TEST_FRAME_INTERVAL);
+        getFrame(i * TEST_FRAME_INTERVAL);
+    }
+
+    return lastDelay;
+}
+
+TEST_F(AudioJitterBufferTest, TestHandoverCatchUp)
+{
+    int32_t numPlayed = 0;
+    // the second half of the frames held is the silence
+    uint32_t lastDelay = playHandover(mJitterBuffer, 25, &numPlayed);
+
+    // the delay of the outage is not kept after the frames held arrive
+    EXPECT_EQ(mCallback.getNumCatchUp(), 1);
+    EXPECT_LT(lastDelay, 200);
+    EXPECT_GT(mCallback.getCatchUpRecovered(), 800);
+    EXPECT_LE(mCallback.getCatchUpDuration(), 2000 + TEST_FRAME_INTERVAL);
+    // the buffer is not reset, the frames after the outage are played
+    EXPECT_GT(numPlayed, 200);
+}
+
+TEST_F(AudioJitterBufferTest, TestHandoverCatchUpInSilence)
+{
+    int32_t numPlayed = 0;
+    uint32_t lastDelay = playHandover(mJitterBuffer, 0, &numPlayed);
+
+    // the silence is dropped without waiting the speech to be compressed
+    EXPECT_EQ(mCallback.getNumCatchUp(), 1);
+    EXPECT_LT(lastDelay, 200);
+    EXPECT_LT(mCallback.getCatchUpDuration(), 200);
+    EXPECT_GT(numPlayed, 200);
+}
+
+TEST_F(AudioJitterBufferTest, TestHandoverCatchUpKeepSpeech)
+{
+    int32_t numPlayed = 0;
+    // the silence of the last 40 frames held covers the excess delay
+    uint32_t lastDelay = playHandover(mJitterBuffer, 10, &numPlayed);
+
+    // the speech frames held before the silence are not discarded
+    EXPECT_EQ(mCallback.getNumCatchUp(), 1);
+    EXPECT_LT(lastDelay, 200);
+    EXPECT_GT(numPlayed, 200);
+
+    for (int32_t seq : mCallback.getDiscardedSeqs())
+    {
+        EXPECT_FALSE(seq >= 50 && seq < 60) << "speech discarded seq " << seq;
+    }
+}
+
+TEST_F(AudioJitterBufferTest, TestSingleLatePacketNoCatchUp)
+{
+    const int32_t kNumFrames = 200;
+    const int32_t kLateSeq = 60;
+    const uint32_t kLateDelay = 250;
+    const uint32_t kBaseTime = 100000;
+    char buffer[TEST_BUFFER_SIZE] = {"\x1"};
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    uint32_t lastDelay = 0;
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        uint32_t frameTime = kBaseTime + i * TEST_FRAME_INTERVAL;
+
+        if (i != kLateSeq)
+        {
+            mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                    frameTime, false, i, MEDIASUBTYPE_UNDEFINED, frameTime);
+        }
+
+        // the packet delayed alone arrives after the packets sent later
+        if (i == kLateSeq + kLateDelay / TEST_FRAME_INTERVAL)
+        {
+            uint32_t lateTime = kBaseTime + kLateSeq * TEST_FRAME_INTERVAL;
+            mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, reinterpret_cast<uint8_t*>(buffer), 1,
+                    lateTime, false, kLateSeq, MEDIASUBTYPE_UNDEFINED, lateTime + kLateDelay);
+        }
+
+        if (mJitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq, frameTime))
+        {
+            lastDelay = frameTime - timestamp;
+            mJitterBuffer->Delete();
+        }
+    }
+
+    // the late packet is the jitter, not the step of the delay in the new path
+    EXPECT_EQ(mCallback.getNumCatchUp(), 0);
+    EXPECT_EQ(mCallback.getNumLate(), 1);
+    EXPECT_LE(lastDelay, mStartJitterBufferSize * TEST_FRAME_INTERVAL);
+}
+
+TEST_F(AudioJitterBufferTest, TestDtxTalkSpurt)
+{
+    const int32_t kNumCycles = 12;
+    const int32_t kSpurtFrames = 50;
+    const int32_t kSilenceFrames = 50;
+    const int32_t kSidInterval = 8;
+    const uint32_t kBaseTime = 100000;
+    const int32_t kNumFrames = kNumCycles * (kSpurtFrames + kSilenceFrames);
+    char speech[TEST_BUFFER_SIZE] = {"\x1"};
+    char sid[TEST_BUFFER_SIZE] = {"\x2"};
+    ImsMediaSubType subtype = MEDIASUBTYPE_UNDEFINED;
+    uint8_t* data = nullptr;
+    uint32_t size = 0;
+    uint32_t timestamp = 0;
+    bool mark = false;
+    uint32_t seq = 0;
+    int32_t numSpeechPlayed = 0;
+    int64_t sumSpeechDelay = 0;
+    int32_t numDelayChangesInSpurt = 0;
+    uint32_t spurtDelay = 0;
+    std::vector<uint32_t> spurtStartDelays;
+
+    struct TestPacket
+    {
+        uint32_t timestamp;
+        uint16_t seq;
+        bool sid;
+        bool mark;
+        uint32_t arrival;
+    };
+
+    std::vector<TestPacket> packets;
+    uint16_t addSeq = 0;
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        int32_t cycle = i / (kSpurtFrames + kSilenceFrames);
+        int32_t pos = i % (kSpurtFrames + kSilenceFrames);
+        uint32_t frameTime = kBaseTime + i * TEST_FRAME_INTERVAL;
+
+        if (pos < kSpurtFrames)
+        {
+            // the jitter of the speech goes up in the middle of the call
+            int32_t delay = (cycle >= 4 && cycle < 8) ? (pos * 7 % 5) * 20 : (pos % 3) * 5;
+            packets.push_back({frameTime, addSeq++, false, pos == 0, frameTime + delay});
+        }
+        else if ((pos - kSpurtFrames) % kSidInterval == 0)
+        {
+            // the SID packets are delayed more than the speech, they are not the jitter samples
+            packets.push_back({frameTime, addSeq++, true, false, frameTime + 150});
+        }
+    }
+
+    std::stable_sort(packets.begin(), packets.end(),
+            [](const TestPacket& a, const TestPacket& b)
+            {
+                return a.arrival < b.arrival;
+            });
+
+    mJitterBuffer->SetJitterBufferSize(4, 3, 9);
+    mJitterBuffer->SetPlayoutDelayOptions(0.97, 0.5, 0.02);
+    size_t next = 0;
+
+    for (int32_t i = 0; i < kNumFrames + 20; i++)
+    {
+        uint32_t currentTime = kBaseTime + i * TEST_FRAME_INTERVAL;
+
+        for (; next < packets.size() && packets[next].arrival <= currentTime; next++)
+        {
+            const TestPacket& packet = packets[next];
+            mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED,
+                    reinterpret_cast<uint8_t*>(packet.sid ? sid : speech), packet.sid ? 6 : 1,
+                    packet.timestamp, packet.mark, packet.seq, MEDIASUBTYPE_UNDEFINED,
+                    packet.arrival);
+        }
+
+        if (mJitterBuffer->Get(&subtype, &data, &size, &timestamp, &mark, &seq, currentTime))
+        {
+            if (size == 1)
+            {
+                uint32_t delay = currentTime - timestamp;
+
+                if (mark)
+                {
+                    spurtDelay = delay;
+                    spurtStartDelays.push_back(delay);
+                }
+                else if (delay != spurtDelay)
+                {
+                    numDelayChangesInSpurt++;
+                    spurtDelay = delay;
+                }
+
+                numSpeechPlayed++;
+                sumSpeechDelay += delay;
+            }
+
+            mJitterBuffer->Delete();
+        }
+    }
+
+    ASSERT_EQ(spurtStartDelays.size(), static_cast<size_t>(kNumCycles));
+    // the delayed SID packets do not raise the delay of the talk spurts
+    EXPECT_LE(spurtStartDelays[1], 3 * TEST_FRAME_INTERVAL);
+    // the delay goes up in the silence after the first talk spurt of the high jitter
+    EXPECT_LE(spurtStartDelays[4], 3 * TEST_FRAME_INTERVAL);
+    EXPECT_GE(spurtStartDelays[5], 5 * TEST_FRAME_INTERVAL);
+    // the delay is not changed in the talk spurts
+    EXPECT_EQ(numDelayChangesInSpurt, 0);
+    // the frames late in the first talk spurt of the high jitter only
+    EXPECT_GE(numSpeechPlayed, kNumCycles * kSpurtFrames - kSpurtFrames / 2);
+    EXPECT_LT(sumSpeechDelay / numSpeechPlayed, 5 * TEST_FRAME_INTERVAL);
+}
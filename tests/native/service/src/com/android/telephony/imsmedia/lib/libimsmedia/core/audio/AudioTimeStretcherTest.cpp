@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <AudioTimeStretcher.h>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <vector>
+
+#define TEST_SAMPLING_RATE 8000
+#define TEST_FRAME_SIZE    160  // 20 ms
+
+class AudioTimeStretcherTest : public ::testing::Test
+{
+public:
+    AudioTimeStretcher stretcher;
+    std::vector<int16_t> pcm;
+    std::vector<int16_t> output;
+
+protected:
+    virtual void SetUp() override
+    {
+        stretcher.SetSamplingRate(TEST_SAMPLING_RATE);
+
+        // two seconds of the voiced speech like signal, a 200 Hz pitch with harmonics
+        for (int32_t i = 0; i < TEST_SAMPLING_RATE * 2; i++)
+        {
+            double t = static_cast<double>(i) / TEST_SAMPLING_RATE;
+            pcm.push_back(static_cast<int16_t>(6000 * sin(2 * M_PI * 200 * t) +
+                    3000 * sin(2 * M_PI * 400 * t + 1) + 1500 * sin(2 * M_PI * 600 * t + 2)));
+        }
+    }
+
+    virtual void TearDown() override {}
+
+    void process()
+    {
+        int16_t buffer[TEST_FRAME_SIZE * 2];
+
+        for (size_t i = 0; i + TEST_FRAME_SIZE <= pcm.size(); i += TEST_FRAME_SIZE)
+        {
+            uint32_t numOutput = stretcher.Process(
+                    &pcm[i], TEST_FRAME_SIZE, buffer, sizeof(buffer) / sizeof(int16_t));
+            output.insert(output.end(), buffer, buffer + numOutput);
+        }
+    }
+
+    int32_t getMaxStep(const std::vector<int16_t>& samples)
+    {
+        int32_t maxStep = 0;
+
+        for (size_t i = 1; i < samples.size(); i++)
+        {
+            maxStep = std::max(maxStep, std::abs(samples[i] - samples[i - 1]));
+        }
+
+        return maxStep;
+    }
+
+    int32_t getNumZeroCrossings(const std::vector<int16_t>& samples)
+    {
+        int32_t count = 0;
+
+        for (size_t i = 1; i < samples.size(); i++)
+        {
+            if ((samples[i - 1] < 0) != (samples[i] < 0))
+            {
+                count++;
+            }
+        }
+
+        return count;
+    }
+};
+
+TEST_F(AudioTimeStretcherTest, TestSameRate)
+{
+    process();
+
+    // the output is the input delayed
+    ASSERT_GT(output.size(), pcm.size() - TEST_FRAME_SIZE * 2);
+    EXPECT_EQ(output.size() + stretcher.GetNumBuffered(), pcm.size());
+
+    for (size_t i = 0; i < output.size(); i++)
+    {
+        ASSERT_EQ(output[i], pcm[i]) << "sample " << i;
+    }
+}
+
+TEST_F(AudioTimeStretcherTest, TestSlowDown)
+{
+    stretcher.SetRate(0.5);
+    EXPECT_DOUBLE_EQ(stretcher.GetRate(), 0.9);
+    process();
+
+    double expected = (pcm.size() - stretcher.GetNumBuffered()) / 0.9;
+    EXPECT_NEAR(output.size(), expected, TEST_FRAME_SIZE);
+
+    // no click at the joints and the pitch is kept
+    EXPECT_LE(getMaxStep(output), getMaxStep(pcm) * 1.2);
+    double crossingRate = static_cast<double>(getNumZeroCrossings(output)) / output.size();
+    double expectedRate = static_cast<double>(getNumZeroCrossings(pcm)) / pcm.size();
+    EXPECT_NEAR(crossingRate, expectedRate, expectedRate * 0.05);
+}
+
+TEST_F(AudioTimeStretcherTest, TestSpeedUp)
+{
+    stretcher.SetRate(1.1);
+    process();
+
+    double expected = (pcm.size() - stretcher.GetNumBuffered()) / 1.1;
+    EXPECT_NEAR(output.size(), expected, TEST_FRAME_SIZE);
+    EXPECT_LE(getMaxStep(output), getMaxStep(pcm) * 1.2);
+
+    double crossingRate = static_cast<double>(getNumZeroCrossings(output)) / output.size();
+    double expectedRate = static_cast<double>(getNumZeroCrossings(pcm)) / pcm.size();
+    EXPECT_NEAR(crossingRate, expectedRate, expectedRate * 0.05);
+
+    stretcher.Reset();
+    EXPECT_EQ(stretcher.GetNumBuffered(), 0);
+}
+
+TEST_F(AudioTimeStretcherTest, TestOutputBufferLimit)
+{
+    int16_t buffer[TEST_FRAME_SIZE];
+    stretcher.SetRate(0.9);
+
+    // the output not fitting in the buffer is kept for the next call
+    uint32_t numOutput = 0;
+
+    for (int32_t i = 0; i < 10; i++)
+    {
+        numOutput += stretcher.Process(&pcm[i * TEST_FRAME_SIZE], TEST_FRAME_SIZE, buffer, 40);
+    }
+
+    EXPECT_EQ(numOutput % 80, 0);
+    EXPECT_GT(stretcher.GetNumBuffered(), TEST_FRAME_SIZE * 5);
+    EXPECT_GT(stretcher.Process(nullptr, 0, buffer, sizeof(buffer) / sizeof(int16_t)), 0);
+}
+
+/**
+ * Microbenchmark of the time stretching of the wideband PCM, the elapsed time per 20 ms frame is
+ * reported as a test property.
+ */
+TEST_F(AudioTimeStretcherTest, TestProcessingCost)
+{
+    const int32_t kSamplingRate = 16000;
+    const int32_t kFrameSize = kSamplingRate / 50;
+    const int32_t kNumFrames = 500;
+    std::vector<int16_t> frame(kFrameSize);
+    std::vector<int16_t> buffer(kFrameSize * 2);
+    stretcher.SetSamplingRate(kSamplingRate);
+    stretcher.SetRate(0.9);
+    srand(1);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        for (int32_t j = 0; j < kFrameSize; j++)
+        {
+            frame[j] = static_cast<int16_t>(rand() % 8192 - 4096);
+        }
+
+        stretcher.Process(frame.data(), kFrameSize, buffer.data(), buffer.size());
+    }
+
+    auto elapsedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+                             .count();
+    RecordProperty("NsPerFrame", std::to_string(elapsedNs / kNumFrames));
+    EXPECT_LT(stretcher.GetNumBuffered(), static_cast<uint32_t>(kFrameSize * 2));
+}
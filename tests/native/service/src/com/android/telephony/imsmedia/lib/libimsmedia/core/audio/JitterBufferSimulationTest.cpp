@@ -0,0 +1,637 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <AudioJitterBuffer.h>
+#include <TextJitterBuffer.h>
+#include <VideoJitterBuffer.h>
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * The jitter buffers are replayed by the packet arrival traces with the virtual clock to evaluate
+ * the changes of them offline. The trace is the records of (seq, ts, arrival) in the arrival
+ * order, it is generated by the network profile or loaded from the file given by the environment
+ * variable IMSMEDIA_JITTER_TRACE, one record per line and '#' for the comment. The media of the
+ * trace file is given by IMSMEDIA_JITTER_TRACE_MEDIA, audio, video or text.
+ *
+ * The playout delay is from the sending of the packet assumed by its timestamp and the minimum
+ * transit time of the trace. The late loss is the packets arrived but not played nor discarded.
+ */
+
+// the sending of the trace starts after the rtp timestamp of 16 bits in milliseconds
+#define SIM_START_TIME       100000
+// the time to play the packets queued after the last arrival
+#define SIM_DRAIN_TIME       2000
+#define SIM_BASE_DELAY       50
+#define SIM_START_SEQ        65000
+#define AUDIO_FRAME_INTERVAL 20
+#define VIDEO_FRAME_INTERVAL 66
+#define TEXT_PACKET_INTERVAL 300
+// RFC4103 5.4, the text renderer waits the packet lost for one second
+#define TEXT_LOSS_WAIT_TIME  1000
+
+enum SimulationMedia
+{
+    kSimulationAudio,
+    kSimulationVideo,
+    kSimulationText,
+};
+
+struct TracePacket
+{
+    uint16_t seq;
+    uint32_t timestamp;
+    uint32_t arrival;
+};
+
+struct NetworkProfile
+{
+    const char* name;
+    // the mean of the exponential delay over the base delay in milliseconds
+    uint32_t meanJitter;
+    uint32_t lossPercent;
+    // the packets sent in the outage arrive at its end at once, 0 for no outage
+    uint32_t outageStart;
+    uint32_t outageDuration;
+};
+
+static const NetworkProfile kProfiles[] = {
+        {"Good", 5, 0, 0, 0},
+        {"Jittery", 30, 1, 0, 0},
+        {"Lossy", 10, 5, 0, 0},
+        {"Handover", 5, 0, 20000, 1000},
+};
+
+struct SimulationResult
+{
+    uint32_t numArrived = 0;
+    uint32_t numPlayed = 0;
+    uint32_t numDiscarded = 0;
+    uint32_t numResets = 0;
+    uint64_t cpuTimeNs = 0;
+    // the playout delay of the frames played in milliseconds
+    std::vector<int32_t> delays;
+
+    uint32_t getNumLate() const
+    {
+        return numArrived > numPlayed + numDiscarded ? numArrived - numPlayed - numDiscarded : 0;
+    }
+
+    double getLateLossRate() const
+    {
+        return numArrived == 0 ? 0 : static_cast<double>(getNumLate()) / numArrived;
+    }
+
+    double getMeanDelay() const
+    {
+        int64_t sum = 0;
+
+        for (int32_t delay : delays)
+        {
+            sum += delay;
+        }
+
+        return delays.empty() ? 0 : static_cast<double>(sum) / delays.size();
+    }
+
+    int32_t getPercentileDelay(double percentile) const
+    {
+        if (delays.empty())
+        {
+            return 0;
+        }
+
+        std::vector<int32_t> sorted(delays);
+        std::sort(sorted.begin(), sorted.end());
+        size_t index = static_cast<size_t>(percentile * sorted.size());
+        return sorted[std::min(index, sorted.size() - 1)];
+    }
+
+    uint64_t getCpuTimePerPacket() const { return numArrived == 0 ? 0 : cpuTimeNs / numArrived; }
+};
+
+/**
+ * @brief Counts the resets of the jitter buffer by the packets, the reset in the constructor is
+ * not counted.
+ */
+template <class T>
+class ResetCountingJitterBuffer : public T
+{
+public:
+    virtual void Reset() override
+    {
+        numResets++;
+        T::Reset();
+    }
+
+    uint32_t numResets = 0;
+};
+
+class JitterBufferSimulationCallback : public BaseSessionCallback
+{
+public:
+    JitterBufferSimulationCallback() { numDiscarded = 0; }
+    virtual ~JitterBufferSimulationCallback() {}
+
+    virtual void onEvent(int32_t type, uint64_t param1, uint64_t param2)
+    {
+        switch (type)
+        {
+            case kCollectRxRtpStatus:
+            {
+                SessionCallbackParameter* param =
+                        reinterpret_cast<SessionCallbackParameter*>(param1);
+
+                if (param != nullptr && param->param1 == kRtpStatusDiscarded)
+                {
+                    numDiscarded++;
+                }
+
+                delete param;
+                break;
+            }
+            case kCollectOptionalInfo:
+                delete reinterpret_cast<SessionCallbackParameter*>(param1);
+                break;
+            case kCollectPacketInfo:
+                delete reinterpret_cast<RtpPacket*>(param2);
+                break;
+            case kRequestVideoSendNack:
+                delete[] reinterpret_cast<NackParams*>(param1);
+                break;
+            case kRequestVideoSendPictureLost:
+            case kRequestVideoSendTmmbr:
+                delete reinterpret_cast<InternalRequestEventParam*>(param1);
+                break;
+            default:
+                break;
+        }
+    }
+
+    uint32_t numDiscarded;
+};
+
+static uint32_t getPlayTime(BaseJitterBuffer* /*jitterBuffer*/, uint32_t /*timestamp*/,
+        uint32_t currentTime)
+{
+    return currentTime;
+}
+
+/**
+ * @brief Gets the time the frame is played, the renderer holds the frame decoded until the render
+ * time
+ */
+static uint32_t getPlayTime(VideoJitterBuffer* jitterBuffer, uint32_t timestamp,
+        uint32_t currentTime)
+{
+    uint32_t renderTime = jitterBuffer->GetRenderTime(timestamp);
+    return static_cast<int32_t>(renderTime - currentTime) > 0 ? renderTime : currentTime;
+}
+
+/**
+ * @brief Generates the trace of the packets sent at the interval and delayed by the network
+ * profile, in the arrival order. The packets of a frame are sent at once.
+ */
+static std::vector<TracePacket> makeTrace(const NetworkProfile& profile, uint32_t numFrames,
+        uint32_t interval, uint32_t tsPerMs, uint32_t packetsPerFrame, uint32_t seed)
+{
+    std::mt19937 random(seed);
+    std::exponential_distribution<double> jitter(
+            profile.meanJitter > 0 ? 1.0 / profile.meanJitter : 1.0);
+    std::uniform_int_distribution<uint32_t> loss(0, 99);
+    std::vector<TracePacket> trace;
+    uint16_t seq = SIM_START_SEQ;
+
+    for (uint32_t i = 0; i < numFrames; i++)
+    {
+        uint32_t sendTime = SIM_START_TIME + i * interval;
+
+        for (uint32_t j = 0; j < packetsPerFrame; j++, seq++)
+        {
+            uint32_t arrival = sendTime + SIM_BASE_DELAY;
+
+            if (profile.meanJitter > 0)
+            {
+                arrival += static_cast<uint32_t>(jitter(random));
+            }
+
+            uint32_t outageEnd = SIM_START_TIME + profile.outageStart + profile.outageDuration;
+
+            if (profile.outageDuration > 0 && sendTime >= SIM_START_TIME + profile.outageStart &&
+                    arrival < outageEnd)
+            {
+                arrival = outageEnd;
+            }
+
+            if (loss(random) < profile.lossPercent)
+            {
+                continue;
+            }
+
+            trace.push_back({seq, sendTime * tsPerMs, arrival});
+        }
+    }
+
+    std::stable_sort(trace.begin(), trace.end(),
+            [](const TracePacket& a, const TracePacket& b)
+            {
+                return static_cast<int32_t>(a.arrival - b.arrival) < 0;
+            });
+    return trace;
+}
+
+/**
+ * @brief Loads the trace of the (seq, ts, arrival) records in the arrival order
+ *
+ * @return false when a record is malformed
+ */
+static bool loadTrace(std::istream& in, std::vector<TracePacket>* trace)
+{
+    std::string line;
+
+    while (std::getline(in, line))
+    {
+        size_t start = line.find_first_not_of(" \t\r");
+
+        if (start == std::string::npos || line[start] == '#')
+        {
+            continue;
+        }
+
+        std::istringstream record(line);
+        uint32_t seq = 0;
+        uint32_t timestamp = 0;
+        uint32_t arrival = 0;
+
+        if (!(record >> seq >> timestamp >> arrival) || seq > 0xffff)
+        {
+            return false;
+        }
+
+        trace->push_back({static_cast<uint16_t>(seq), timestamp, arrival});
+    }
+
+    std::stable_sort(trace->begin(), trace->end(),
+            [](const TracePacket& a, const TracePacket& b)
+            {
+                return static_cast<int32_t>(a.arrival - b.arrival) < 0;
+            });
+    return true;
+}
+
+class JitterBufferSimulationTest : public ::testing::Test
+{
+public:
+    JitterBufferSimulationTest() {}
+    virtual ~JitterBufferSimulationTest() {}
+
+protected:
+    JitterBufferSimulationCallback mCallback;
+    uint8_t mPayload[32];
+    uint8_t mVideoHeader[20];
+
+    virtual void SetUp() override
+    {
+        memset(mPayload, 0x41, sizeof(mPayload));
+        memset(mVideoHeader, 0, sizeof(mVideoHeader));
+        mVideoHeader[3] = 0x01;
+    }
+
+    virtual void TearDown() override {}
+
+    SimulationResult runAudio(const std::vector<TracePacket>& trace, double percentile)
+    {
+        ResetCountingJitterBuffer<AudioJitterBuffer> jitterBuffer;
+        jitterBuffer.SetCodecType(kAudioCodecAmrWb);
+        jitterBuffer.SetSessionCallback(&mCallback);
+        // the sizes and the options of the audio player
+        jitterBuffer.SetJitterBufferSize(3, 3, 9);
+        jitterBuffer.SetJitterOptions(80, 1, 2.5, false);
+
+        if (percentile > 0)
+        {
+            jitterBuffer.SetPlayoutDelayOptions(percentile, 0.5, 0.02);
+        }
+
+        return replay(&jitterBuffer, trace, kSimulationAudio);
+    }
+
+    SimulationResult runVideo(const std::vector<TracePacket>& trace)
+    {
+        ResetCountingJitterBuffer<VideoJitterBuffer> jitterBuffer;
+        jitterBuffer.SetCodecType(kVideoCodecAvc);
+        jitterBuffer.SetSessionCallback(&mCallback);
+        // the sizes of the video renderer
+        jitterBuffer.SetFramerate(15);
+        jitterBuffer.SetJitterBufferSize(15, 15, 25);
+        return replay(&jitterBuffer, trace, kSimulationVideo);
+    }
+
+    SimulationResult runText(const std::vector<TracePacket>& trace)
+    {
+        ResetCountingJitterBuffer<TextJitterBuffer> jitterBuffer;
+        jitterBuffer.SetSessionCallback(&mCallback);
+        return replay(&jitterBuffer, trace, kSimulationText);
+    }
+
+    /**
+     * @brief Adds the packets of the trace at their arrival and plays the frames by the virtual
+     * clock at the interval of the renderer of the media
+     */
+    template <class T>
+    SimulationResult replay(ResetCountingJitterBuffer<T>* jitterBuffer,
+            const std::vector<TracePacket>& trace, SimulationMedia media)
+    {
+        SimulationResult result;
+
+        if (trace.empty())
+        {
+            return result;
+        }
+
+        uint32_t tick = media == kSimulationVideo ? 5 : (media == kSimulationText ? 10 : 20);
+        uint32_t tsPerMs = media == kSimulationVideo ? 90 : 1;
+        uint32_t firstTs = trace[0].timestamp;
+        int32_t minTransit = INT32_MAX;
+        // the first and the last packets of the frames by the timestamp of the neighbours
+        std::map<uint16_t, uint32_t> timestamps;
+        std::map<uint16_t, bool> headers;
+        std::map<uint16_t, bool> marks;
+
+        auto getSendTime = [&](uint32_t timestamp)
+        {
+            return static_cast<int32_t>(timestamp - firstTs) / static_cast<int32_t>(tsPerMs);
+        };
+
+        for (const TracePacket& packet : trace)
+        {
+            minTransit = std::min(minTransit,
+                    static_cast<int32_t>(packet.arrival - trace[0].arrival) -
+                            getSendTime(packet.timestamp));
+            timestamps[packet.seq] = packet.timestamp;
+        }
+
+        for (const TracePacket& packet : trace)
+        {
+            auto prev = timestamps.find(static_cast<uint16_t>(packet.seq - 1));
+            auto next = timestamps.find(static_cast<uint16_t>(packet.seq + 1));
+            headers[packet.seq] = prev == timestamps.end() || prev->second != packet.timestamp;
+            marks[packet.seq] = next == timestamps.end() || next->second != packet.timestamp;
+        }
+
+        auto recordDelay = [&](uint32_t playTime, uint32_t timestamp)
+        {
+            result.delays.push_back(static_cast<int32_t>(playTime - trace[0].arrival) -
+                    getSendTime(timestamp) - minTransit);
+        };
+
+        mCallback.numDiscarded = 0;
+        jitterBuffer->numResets = 0;
+        size_t next = 0;
+        bool firstPlayed = false;
+        uint16_t lastPlayedSeq = 0;
+        uint32_t lossWaitTime = 0;
+        uint32_t endTime = trace.back().arrival + SIM_DRAIN_TIME;
+
+        for (uint32_t currentTime = trace[0].arrival;
+                static_cast<int32_t>(currentTime - endTime) < 0; currentTime += tick)
+        {
+            auto start = std::chrono::steady_clock::now();
+
+            for (; next < trace.size() &&
+                    static_cast<int32_t>(trace[next].arrival - currentTime) <= 0;
+                    next++)
+            {
+                const TracePacket& packet = trace[next];
+                bool header = headers[packet.seq];
+
+                if (media == kSimulationVideo)
+                {
+                    jitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, header ? mVideoHeader : mPayload,
+                            header ? sizeof(mVideoHeader) : sizeof(mPayload), packet.timestamp,
+                            marks[packet.seq], packet.seq,
+                            packet.timestamp == firstTs ? MEDIASUBTYPE_VIDEO_IDR_FRAME
+                                                        : MEDIASUBTYPE_VIDEO_NON_IDR_FRAME,
+                            packet.arrival);
+                }
+                else
+                {
+                    jitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, mPayload, sizeof(mPayload),
+                            packet.timestamp, false, packet.seq, MEDIASUBTYPE_UNDEFINED,
+                            packet.arrival);
+                }
+
+                result.numArrived++;
+            }
+
+            uint32_t timestamp = 0;
+            uint32_t seq = 0;
+
+            while (jitterBuffer->Get(nullptr, nullptr, nullptr, &timestamp, nullptr, &seq,
+                    currentTime))
+            {
+                if (media == kSimulationText && firstPlayed &&
+                        static_cast<uint16_t>(seq - lastPlayedSeq) > 1)
+                {
+                    // the renderer waits the packets lost before playing the later one
+                    if (lossWaitTime == 0)
+                    {
+                        lossWaitTime = currentTime;
+                    }
+
+                    if (currentTime - lossWaitTime <= TEXT_LOSS_WAIT_TIME)
+                    {
+                        break;
+                    }
+                }
+
+                lossWaitTime = 0;
+                firstPlayed = true;
+                lastPlayedSeq = seq;
+                result.numPlayed++;
+
+                if (media == kSimulationVideo)
+                {
+                    if (headers[seq])
+                    {
+                        recordDelay(getPlayTime(jitterBuffer, timestamp, currentTime), timestamp);
+                    }
+                }
+                else
+                {
+                    recordDelay(currentTime, timestamp);
+                }
+
+                jitterBuffer->Delete();
+
+                if (media == kSimulationAudio)
+                {
+                    // one frame per interval
+                    break;
+                }
+            }
+
+            result.cpuTimeNs += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start)
+                                        .count();
+        }
+
+        result.numDiscarded = mCallback.numDiscarded;
+        result.numResets = jitterBuffer->numResets;
+        return result;
+    }
+
+    void recordResult(const std::string& name, const SimulationResult& result)
+    {
+        char lateLoss[16];
+        snprintf(lateLoss, sizeof(lateLoss), "%.2f", result.getLateLossRate() * 100);
+        RecordProperty(name + "MeanDelayMs",
+                std::to_string(static_cast<int32_t>(result.getMeanDelay() + 0.5)));
+        RecordProperty(name + "P50DelayMs", std::to_string(result.getPercentileDelay(0.5)));
+        RecordProperty(name + "P95DelayMs", std::to_string(result.getPercentileDelay(0.95)));
+        RecordProperty(name + "P99DelayMs", std::to_string(result.getPercentileDelay(0.99)));
+        RecordProperty(name + "LateLossPercent", lateLoss);
+        RecordProperty(name + "Discards", std::to_string(result.numDiscarded));
+        RecordProperty(name + "Resets", std::to_string(result.numResets));
+        RecordProperty(name + "CpuNsPerPacket", std::to_string(result.getCpuTimePerPacket()));
+    }
+
+    static void expectValid(const SimulationResult& result)
+    {
+        EXPECT_GT(result.numArrived, 0);
+        EXPECT_LE(result.numPlayed + result.numDiscarded, result.numArrived);
+        ASSERT_FALSE(result.delays.empty());
+        EXPECT_LE(result.getPercentileDelay(0.5), result.getPercentileDelay(0.95));
+        EXPECT_LE(result.getPercentileDelay(0.95), result.getPercentileDelay(0.99));
+    }
+};
+
+TEST_F(JitterBufferSimulationTest, TestLoadTrace)
+{
+    std::istringstream in("# seq ts arrival\n"
+                          "1 100020 100090\n"
+                          "\n"
+                          "0 100000 100100\n"
+                          "  2 100040 100110\n");
+    std::vector<TracePacket> trace;
+
+    ASSERT_TRUE(loadTrace(in, &trace));
+    ASSERT_EQ(trace.size(), 3);
+    // in the arrival order
+    EXPECT_EQ(trace[0].seq, 1);
+    EXPECT_EQ(trace[1].seq, 0);
+    EXPECT_EQ(trace[1].timestamp, 100000);
+    EXPECT_EQ(trace[2].arrival, 100110);
+
+    std::istringstream malformed("1 100020\n");
+    trace.clear();
+    EXPECT_FALSE(loadTrace(malformed, &trace));
+}
+
+TEST_F(JitterBufferSimulationTest, TestAudioSyntheticTraces)
+{
+    for (const NetworkProfile& profile : kProfiles)
+    {
+        std::vector<TracePacket> trace =
+                makeTrace(profile, 3000, AUDIO_FRAME_INTERVAL, 1, 1, 1);
+        SimulationResult legacy = runAudio(trace, 0);
+        SimulationResult percentile = runAudio(trace, 0.97);
+
+        SCOPED_TRACE(profile.name);
+        expectValid(legacy);
+        expectValid(percentile);
+        recordResult(std::string("Audio") + profile.name, legacy);
+        recordResult(std::string("AudioPercentile") + profile.name, percentile);
+
+        // the delay step of the handover is caught up without the reset
+        EXPECT_EQ(legacy.numResets, 0);
+        EXPECT_EQ(percentile.numResets, 0);
+    }
+
+    // the replay is reproducible
+    std::vector<TracePacket> trace = makeTrace(kProfiles[1], 3000, AUDIO_FRAME_INTERVAL, 1, 1, 1);
+    SimulationResult first = runAudio(trace, 0.97);
+    SimulationResult second = runAudio(trace, 0.97);
+    EXPECT_EQ(first.delays, second.delays);
+    EXPECT_EQ(first.numPlayed, second.numPlayed);
+    EXPECT_EQ(first.numDiscarded, second.numDiscarded);
+}
+
+TEST_F(JitterBufferSimulationTest, TestVideoSyntheticTraces)
+{
+    for (const NetworkProfile& profile : kProfiles)
+    {
+        std::vector<TracePacket> trace = makeTrace(profile, 900, VIDEO_FRAME_INTERVAL, 90, 3, 1);
+        SimulationResult result = runVideo(trace);
+
+        SCOPED_TRACE(profile.name);
+        expectValid(result);
+        recordResult(std::string("Video") + profile.name, result);
+    }
+}
+
+TEST_F(JitterBufferSimulationTest, TestTextSyntheticTraces)
+{
+    for (const NetworkProfile& profile : kProfiles)
+    {
+        std::vector<TracePacket> trace = makeTrace(profile, 200, TEXT_PACKET_INTERVAL, 1, 1, 1);
+        SimulationResult result = runText(trace);
+
+        SCOPED_TRACE(profile.name);
+        expectValid(result);
+        recordResult(std::string("Text") + profile.name, result);
+        EXPECT_EQ(result.numResets, 0);
+    }
+}
+
+TEST_F(JitterBufferSimulationTest, TestReplayTraceFile)
+{
+    const char* path = getenv("IMSMEDIA_JITTER_TRACE");
+
+    if (path == nullptr)
+    {
+        GTEST_SKIP();
+    }
+
+    std::ifstream in(path);
+    std::vector<TracePacket> trace;
+    ASSERT_TRUE(in.is_open());
+    ASSERT_TRUE(loadTrace(in, &trace));
+
+    const char* media = getenv("IMSMEDIA_JITTER_TRACE_MEDIA");
+    std::string mediaName = media == nullptr ? "audio" : media;
+
+    if (mediaName == "video")
+    {
+        recordResult("Video", runVideo(trace));
+    }
+    else if (mediaName == "text")
+    {
+        recordResult("Text", runText(trace));
+    }
+    else
+    {
+        recordResult("Audio", runAudio(trace, 0));
+        recordResult("AudioPercentile", runAudio(trace, 0.97));
+    }
+}
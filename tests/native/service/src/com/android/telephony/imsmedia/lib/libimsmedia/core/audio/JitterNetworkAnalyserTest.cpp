@@ -16,9 +16,107 @@
 
 #include <gtest/gtest.h>
 #include <JitterNetworkAnalyser.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <list>
+#include <numeric>
+#include <random>
 
 #define TEST_FRAME_INTERVAL 20
 
+/**
+ * The jitter buffer size decision calculating the statistics by scanning the jitters in the window
+ * every time, the reference of the streaming statistics of JitterNetworkAnalyser.
+ */
+class ReferenceJitterAnalyser
+{
+public:
+    ReferenceJitterAnalyser(uint32_t minSize, uint32_t maxSize, uint32_t reduceTH,
+            uint32_t stepSize, double zValue) :
+            mMinSize(minSize),
+            mMaxSize(maxSize),
+            mReduceTH(reduceTH),
+            mStepSize(stepSize),
+            mZValue(zValue),
+            mGood(false),
+            mGoodEnteringTime(0),
+            mBadChangedTime(0)
+    {
+    }
+
+    void Add(int32_t jitter)
+    {
+        mJitters.push_back(jitter);
+
+        if (mJitters.size() > 500)
+        {
+            mJitters.pop_front();
+        }
+    }
+
+    uint32_t GetNextJitterBufferSize(uint32_t currSize, uint32_t currentTime)
+    {
+        double mean = std::accumulate(mJitters.begin(), mJitters.end(), 0.0) / mJitters.size();
+        double dev = sqrt(std::accumulate(mJitters.begin(), mJitters.end(), 0.0,
+                                  [mean](double x, int32_t y)
+                                  {
+                                      return x + (y - mean) * (y - mean);
+                                  }) /
+                mJitters.size());
+        int32_t maxJitter = *std::max_element(mJitters.begin(), mJitters.end());
+        double size = mean + mZValue * dev;
+        uint32_t nextSize = currSize;
+        bool good = false;
+
+        if (size >= currSize * TEST_FRAME_INTERVAL)
+        {
+            if (mBadChangedTime == 0 || currentTime - mBadChangedTime >= 1000)
+            {
+                if (currSize < mMaxSize)
+                {
+                    nextSize = currSize + mStepSize;
+                }
+
+                mBadChangedTime = currentTime;
+            }
+        }
+        else if (size < ((currSize - 1) * TEST_FRAME_INTERVAL - 10) &&
+                maxJitter < static_cast<int32_t>((currSize - 1) * TEST_FRAME_INTERVAL - 10))
+        {
+            good = true;
+
+            if (!mGood)
+            {
+                mGoodEnteringTime = currentTime;
+            }
+            else if (currentTime - mGoodEnteringTime >= mReduceTH)
+            {
+                if (currSize > mMinSize)
+                {
+                    nextSize = currSize - mStepSize;
+                }
+
+                good = false;
+            }
+        }
+
+        mGood = good;
+        return nextSize;
+    }
+
+private:
+    std::list<int32_t> mJitters;
+    uint32_t mMinSize;
+    uint32_t mMaxSize;
+    uint32_t mReduceTH;
+    uint32_t mStepSize;
+    double mZValue;
+    bool mGood;
+    uint32_t mGoodEnteringTime;
+    uint32_t mBadChangedTime;
+};
+
 class JitterNetworkAnalyserTest : public ::testing::Test
 {
 public:
@@ -169,3 +267,124 @@ TEST_F(JitterNetworkAnalyserTest, TestJitterBufferDecrease)
         EXPECT_EQ(currentJitterBufferSize, nextJitterSizeTruth);
     }
 }
+
+TEST_F(JitterNetworkAnalyserTest, TestEquivalenceWithReference)
+{
+    const int32_t kNumFrames = 20000;
+    ReferenceJitterAnalyser reference(
+            mMinJitterBufferSize, mMaxJitterBufferSize, mReduceThreshold, mStepSize, 2.5f);
+    std::mt19937 generator(3);
+    std::uniform_int_distribution<int32_t> jitter(0, 60);
+    uint32_t timestamp = 0;
+    uint32_t currentJitterBufferSize = mMinJitterBufferSize;
+    uint32_t referenceJitterBufferSize = mMinJitterBufferSize;
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        timestamp += TEST_FRAME_INTERVAL;
+        // the jitter level changes every few seconds to move the jitter buffer size both ways
+        uint32_t arrivalTime = timestamp + jitter(generator) * ((i / 3000) % 3);
+
+        int32_t transit = mAnalyzer->CalculateTransitTimeDifference(timestamp, arrivalTime);
+
+        if (i > 0)
+        {
+            reference.Add(transit);
+        }
+
+        mAnalyzer->UpdateBaseTimestamp(timestamp, arrivalTime);
+
+        if (i == 0)
+        {
+            continue;
+        }
+
+        currentJitterBufferSize =
+                mAnalyzer->GetNextJitterBufferSize(currentJitterBufferSize, timestamp);
+        referenceJitterBufferSize =
+                reference.GetNextJitterBufferSize(referenceJitterBufferSize, timestamp);
+        ASSERT_EQ(currentJitterBufferSize, referenceJitterBufferSize) << "frame " << i;
+    }
+}
+
+/**
+ * Microbenchmark of the jitter buffer size decision with the full window, the elapsed time per
+ * decision of the streaming statistics and the scanning reference are reported as test properties.
+ */
+TEST_F(JitterNetworkAnalyserTest, TestStatisticsCost)
+{
+    const int32_t kNumFrames = 20000;
+    ReferenceJitterAnalyser reference(
+            mMinJitterBufferSize, mMaxJitterBufferSize, mReduceThreshold, mStepSize, 2.5f);
+    std::mt19937 generator(5);
+    std::uniform_int_distribution<int32_t> jitter(0, 40);
+    uint32_t timestamp = 0;
+    uint32_t currentJitterBufferSize = mMinJitterBufferSize;
+    std::chrono::nanoseconds streamingTime(0);
+    std::chrono::nanoseconds referenceTime(0);
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        timestamp += TEST_FRAME_INTERVAL;
+        uint32_t arrivalTime = timestamp + jitter(generator);
+        int32_t transit = mAnalyzer->CalculateTransitTimeDifference(timestamp, arrivalTime);
+        reference.Add(transit);
+        mAnalyzer->UpdateBaseTimestamp(timestamp, arrivalTime);
+
+        auto start = std::chrono::steady_clock::now();
+        currentJitterBufferSize =
+                mAnalyzer->GetNextJitterBufferSize(currentJitterBufferSize, timestamp);
+        auto end = std::chrono::steady_clock::now();
+        streamingTime += end - start;
+
+        start = std::chrono::steady_clock::now();
+        reference.GetNextJitterBufferSize(currentJitterBufferSize, timestamp);
+        end = std::chrono::steady_clock::now();
+        referenceTime += end - start;
+    }
+
+    RecordProperty("StreamingNsPerDecision", std::to_string(streamingTime.count() / kNumFrames));
+    RecordProperty("ScanningNsPerDecision", std::to_string(referenceTime.count() / kNumFrames));
+    EXPECT_GE(currentJitterBufferSize, mMinJitterBufferSize);
+    EXPECT_LE(currentJitterBufferSize, mMaxJitterBufferSize);
+}
+
+TEST_F(JitterNetworkAnalyserTest, TestJitterQuantile)
+{
+    const int32_t kNumFrames = 50;
+    uint32_t timestamp = 0;
+    uint32_t statusInterval = 0;
+    uint32_t currentJitterBufferSize = mMinJitterBufferSize;
+    mAnalyzer->SetJitterQuantile(0.9);
+
+    // one packet of ten is delayed by 100 ms, the deviation grows the buffer but the 90th
+    // percentile does not
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        timestamp += TEST_FRAME_INTERVAL;
+        uint32_t arrivalTime = timestamp + (i % 10 == 9 ? 100 : 0);
+        mAnalyzer->CalculateTransitTimeDifference(timestamp, arrivalTime);
+        mAnalyzer->UpdateBaseTimestamp(timestamp, timestamp);
+        currentJitterBufferSize =
+                mAnalyzer->GetNextJitterBufferSize(currentJitterBufferSize, statusInterval);
+        statusInterval += 1000;
+    }
+
+    EXPECT_EQ(currentJitterBufferSize, mMinJitterBufferSize);
+
+    mAnalyzer->Reset();
+    mAnalyzer->SetJitterQuantile(0);
+
+    for (int32_t i = 0; i < kNumFrames; i++)
+    {
+        timestamp += TEST_FRAME_INTERVAL;
+        uint32_t arrivalTime = timestamp + (i % 10 == 9 ? 100 : 0);
+        mAnalyzer->CalculateTransitTimeDifference(timestamp, arrivalTime);
+        mAnalyzer->UpdateBaseTimestamp(timestamp, timestamp);
+        currentJitterBufferSize =
+                mAnalyzer->GetNextJitterBufferSize(currentJitterBufferSize, statusInterval);
+        statusInterval += 1000;
+    }
+
+    EXPECT_GT(currentJitterBufferSize, mMinJitterBufferSize);
+}
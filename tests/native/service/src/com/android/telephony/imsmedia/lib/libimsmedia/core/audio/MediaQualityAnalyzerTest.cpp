@@ -502,6 +502,85 @@ TEST_F(MediaQualityAnalyzerTest, TestCallQualityLevelChanged)
             CallQuality::kCallQualityBad);
 }
 
+TEST_F(MediaQualityAnalyzerTest, TestPartialCopyRecovered)
+{
+    EXPECT_CALL(mCallback, onEvent(kAudioCallQualityChangedInd, _, _)).Times(1);
+    mAnalyzer->start();
+
+    for (int32_t i = 0; i < 2; i++)
+    {
+        SessionCallbackParameter* param =
+                new SessionCallbackParameter(kReportPartialCopyRecovered, i * 5, 1);
+        mAnalyzer->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+    }
+
+    mAnalyzer->testProcessCycle(1);
+
+    EXPECT_EQ(mAnalyzer->getPartialCopyRecoveredSize(), 2);
+    EXPECT_EQ(mAnalyzer->getLostPacketSize(), 0);
+    mAnalyzer->stop();
+
+    EXPECT_EQ(mAnalyzer->getPartialCopyRecoveredSize(), 0);
+}
+
+TEST_F(MediaQualityAnalyzerTest, TestCatchUp)
+{
+    EXPECT_CALL(mCallback, onEvent(kAudioCallQualityChangedInd, _, _)).Times(1);
+    mAnalyzer->start();
+
+    // the duration of the catch up and the latency recovered
+    SessionCallbackParameter* param = new SessionCallbackParameter(kReportCatchUp, 1500, 800);
+    mAnalyzer->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+    param = new SessionCallbackParameter(kReportCatchUp, 200, 300);
+    mAnalyzer->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+
+    mAnalyzer->testProcessCycle(1);
+
+    EXPECT_EQ(mAnalyzer->getCatchUpCount(), 2);
+    EXPECT_EQ(mAnalyzer->getCatchUpLatencyRecovered(), 1100);
+    mAnalyzer->stop();
+
+    EXPECT_EQ(mAnalyzer->getCatchUpCount(), 0);
+    EXPECT_EQ(mAnalyzer->getCatchUpLatencyRecovered(), 0);
+}
+
+TEST_F(MediaQualityAnalyzerTest, TestFrameAggregation)
+{
+    EXPECT_CALL(mCallback, onEvent(kAudioCallQualityChangedInd, _, _)).Times(2);
+    EXPECT_CALL(mCallback, onEvent(kRequestAudioFrameAggregation, 2, _)).Times(1);
+    EXPECT_CALL(mCallback, onEvent(kRequestAudioFrameAggregation, 3, _)).Times(1);
+    EXPECT_CALL(mCallback, onEvent(kRequestAudioFrameAggregation, 1, _)).Times(1);
+    mAnalyzer->start();
+    EXPECT_EQ(mAnalyzer->getFramesPerPacket(), 1);
+
+    // about 10 % of the uplink packets are lost
+    SessionCallbackParameter* param = new SessionCallbackParameter(kReportFractionLost, 0, 26);
+    mAnalyzer->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+    mAnalyzer->testProcessCycle(1);
+    EXPECT_EQ(mAnalyzer->getFramesPerPacket(), 2);
+
+    mAnalyzer->testProcessCycle(1);
+    EXPECT_EQ(mAnalyzer->getFramesPerPacket(), 3);
+
+    // the high round trip time and the jitter buffer delay limit the packetization delay
+    mAnalyzer->SendEvent(kRequestRoundTripTimeDelayUpdate, 200 * 65536 / 1000);
+    mAnalyzer->SendEvent(kCollectJitterBufferSize, 40, 200);
+    mAnalyzer->testProcessCycle(1);
+    EXPECT_EQ(mAnalyzer->getFramesPerPacket(), 1);
+
+    for (int32_t i = 0; i < 2; i++)
+    {
+        param = new SessionCallbackParameter(kReportHeaderBytesSaved, 0, 40);
+        mAnalyzer->SendEvent(kCollectOptionalInfo, reinterpret_cast<uint64_t>(param), 0);
+    }
+
+    mAnalyzer->testProcessCycle(1);
+    mAnalyzer->stop();
+
+    EXPECT_EQ(mFakeCallback.getCallQuality().getNumHeaderBytesSaved(), 80);
+    EXPECT_EQ(mAnalyzer->getFramesPerPacket(), 1);
+}
+
 TEST_F(MediaQualityAnalyzerTest, TestJitterInd)
 {
     EXPECT_CALL(mCallback, onEvent(kImsMediaEventMediaQualityStatus, _, _)).Times(1);
@@ -544,6 +623,52 @@ TEST_F(MediaQualityAnalyzerTest, TestJitterInd)
     EXPECT_EQ(status.getRtpJitterMillis(), jitter);
 }
 
+TEST_F(MediaQualityAnalyzerTest, TestJitterIndWithSid)
+{
+    EXPECT_CALL(mCallback, onEvent(kImsMediaEventMediaQualityStatus, _, _)).Times(1);
+    EXPECT_CALL(mCallback, onEvent(kAudioCallQualityChangedInd, _, _)).Times(1);
+    MediaQualityThreshold threshold;
+    threshold.setRtpHysteresisTimeInMillis(kRtpHysteresisTimeInMillis);
+    threshold.setRtpJitterMillis(kRtpJitterMillis);
+    mAnalyzer->setMediaQualityThreshold(threshold);
+    mAnalyzer->start();
+
+    const int32_t numPackets = 20;
+    const int32_t jitter = 20;
+    const uint32_t ssrc = 10000;
+
+    for (int32_t i = 0; i < numPackets; i++)
+    {
+        RtpPacket* packet = new RtpPacket();
+        packet->seqNum = i;
+        packet->ssrc = ssrc;
+
+        // the SID packets in the silence are not the samples of the jitter
+        if (i % 4 == 3)
+        {
+            packet->rtpDataType = kRtpDataTypeSid;
+            packet->jitter = 200;
+        }
+        else
+        {
+            packet->jitter = jitter;
+        }
+
+        mAnalyzer->SendEvent(kCollectPacketInfo, kStreamRtpRx, reinterpret_cast<uint64_t>(packet));
+    }
+
+    mAnalyzer->testProcessCycle(1);
+    mAnalyzer->stop();
+
+    EXPECT_EQ(mFakeCallback.getCallQuality().getNumRtpPacketsReceived(), numPackets);
+    EXPECT_EQ(mFakeCallback.getCallQuality().getNumRtpSidPacketsReceived(), numPackets / 4);
+    EXPECT_EQ(mFakeCallback.getCallQuality().getAverageRelativeJitter(), jitter);
+    EXPECT_EQ(mFakeCallback.getCallQuality().getMaxRelativeJitter(), jitter);
+
+    MediaQualityStatus status = mFakeCallback.getMediaQualityStatus();
+    EXPECT_EQ(status.getRtpJitterMillis(), jitter);
+}
+
 TEST_F(MediaQualityAnalyzerTest, TestSsrcChange)
 {
     mAnalyzer->start();
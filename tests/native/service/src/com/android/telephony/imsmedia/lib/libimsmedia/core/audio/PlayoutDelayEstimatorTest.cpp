@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <PlayoutDelayEstimator.h>
+#include <random>
+
+#define TEST_FRAME_INTERVAL 20
+
+class PlayoutDelayEstimatorTest : public ::testing::Test
+{
+public:
+    PlayoutDelayEstimator estimator;
+    uint32_t timestamp = 0;
+
+protected:
+    virtual void SetUp() override { estimator.SetOptions(0.97, 0.5, 0.02); }
+    virtual void TearDown() override {}
+
+    void addPacket(uint32_t delay)
+    {
+        timestamp += TEST_FRAME_INTERVAL;
+        estimator.Update(timestamp, timestamp + 1000 + delay);
+    }
+};
+
+TEST_F(PlayoutDelayEstimatorTest, DisabledTest)
+{
+    EXPECT_TRUE(estimator.IsEnabled());
+    estimator.SetOptions(0, 0.5, 0.02);
+    EXPECT_FALSE(estimator.IsEnabled());
+    EXPECT_EQ(estimator.GetTargetDelay(), 0);
+    EXPECT_EQ(estimator.GetPercentileDelay(), 0);
+}
+
+TEST_F(PlayoutDelayEstimatorTest, PercentileTest)
+{
+    // 5 percent of the packets are delayed by 200 ms, 97 percent of them are covered by 50 ms
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<int32_t> jitter(0, 40);
+    std::uniform_int_distribution<int32_t> spike(0, 99);
+
+    for (int32_t i = 0; i < 3000; i++)
+    {
+        addPacket(spike(generator) < 2 ? 200 : jitter(generator));
+    }
+
+    EXPECT_GE(estimator.GetPercentileDelay(), 40);
+    EXPECT_LE(estimator.GetPercentileDelay(), 50);
+    EXPECT_NEAR(estimator.GetTargetDelay(), estimator.GetPercentileDelay(), 10);
+
+    estimator.SetOptions(0.99, 0.5, 0.02);
+
+    for (int32_t i = 0; i < 3000; i++)
+    {
+        addPacket(spike(generator) < 2 ? 200 : jitter(generator));
+    }
+
+    EXPECT_EQ(estimator.GetPercentileDelay(), 210);
+}
+
+TEST_F(PlayoutDelayEstimatorTest, AttackDecayTest)
+{
+    for (int32_t i = 0; i < 500; i++)
+    {
+        addPacket(0);
+    }
+
+    EXPECT_EQ(estimator.GetTargetDelay(), 10);
+
+    // the target follows the step up of the delay in a few packets
+    for (int32_t i = 0; i < 100; i++)
+    {
+        addPacket(i % 2 == 0 ? 0 : 100);
+    }
+
+    EXPECT_EQ(estimator.GetTargetDelay(), 110);
+
+    // and comes down slowly
+    for (int32_t i = 0; i < 50; i++)
+    {
+        addPacket(0);
+    }
+
+    EXPECT_GT(estimator.GetTargetDelay(), 10);
+
+    for (int32_t i = 0; i < 3000; i++)
+    {
+        addPacket(0);
+    }
+
+    EXPECT_EQ(estimator.GetTargetDelay(), 10);
+
+    estimator.Reset();
+    EXPECT_EQ(estimator.GetTargetDelay(), 0);
+}
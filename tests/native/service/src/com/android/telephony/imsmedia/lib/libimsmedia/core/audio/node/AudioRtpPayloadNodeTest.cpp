@@ -19,6 +19,7 @@
 #include <AudioRtpPayloadEncoderNode.h>
 #include <AudioRtpPayloadDecoderNode.h>
 #include <string.h>
+#include <vector>
 
 using namespace android::telephony::imsmedia;
 using namespace android;
@@ -44,6 +45,7 @@ const int32_t kMaxPtimeMillis = 100;
 const bool kDtxEnabled = true;
 const int8_t kDtmfPayloadTypeNumber = 103;
 const int8_t kDtmfsamplingRateKHz = 16;
+const int8_t kRedPayloadTypeNumber = 104;
 
 // AmrParam
 const int32_t kAmrMode = AmrParams::AMR_MODE_8;
@@ -72,15 +74,17 @@ public:
     virtual bool IsRunTime() { return true; }
     virtual bool IsSourceNode() { return false; }
     virtual void SetConfig(void* config) { (void)config; }
-    virtual void OnDataFromFrontNode(ImsMediaSubType /*IMS_MEDIA_AUDIO*/, uint8_t* data,
-            uint32_t size, uint32_t /*timestamp*/, bool /*mark*/, uint32_t /*seq*/,
-            ImsMediaSubType /*dataType*/, uint32_t /*arrivalTime*/)
+    virtual void OnDataFromFrontNode(ImsMediaSubType subtype, uint8_t* data, uint32_t size,
+            uint32_t timestamp, bool /*mark*/, uint32_t seq, ImsMediaSubType dataType,
+            uint32_t /*arrivalTime*/)
     {
         if (data != nullptr && size > 0)
         {
             memset(dataFrame, 0, sizeof(dataFrame));
             memcpy(dataFrame, data, size);
             frameSize = size;
+            frames.push_back({subtype, std::vector<uint8_t>(data, data + size), timestamp, seq,
+                    dataType});
         }
     }
 
@@ -89,6 +93,17 @@ public:
     uint32_t GetFrameSize() { return frameSize; }
     uint8_t* GetDataFrame() { return dataFrame; }
 
+    struct Frame
+    {
+        ImsMediaSubType subtype;
+        std::vector<uint8_t> data;
+        uint32_t timestamp;
+        uint32_t seq;
+        ImsMediaSubType dataType;
+    };
+
+    std::vector<Frame> frames;
+
 private:
     uint32_t frameSize;
     uint8_t dataFrame[DEFAULT_MTU];
@@ -244,6 +259,56 @@ TEST_F(AudioRtpPayloadNodeTest, testAmrOctetAlignedDataProcess)
     EXPECT_EQ(memcmp(fakeNode->GetDataFrame(), testFrame, fakeNode->GetFrameSize()), 0);
 }
 
+TEST_F(AudioRtpPayloadNodeTest, testAmrFrameAggregation)
+{
+    EXPECT_EQ(encoder->Start(), RESULT_SUCCESS);
+    EXPECT_EQ(decoder->Start(), RESULT_SUCCESS);
+
+    // AMR-WB mode 8 audio frame with toc field
+    uint8_t testFrame[] = {0x44, 0xe6, 0x6e, 0x84, 0x8a, 0xa4, 0xda, 0xc8, 0xf2, 0x6c, 0xeb, 0x87,
+            0xe4, 0x56, 0x0f, 0x49, 0x47, 0xfa, 0xdc, 0xa7, 0x9d, 0xbb, 0xcf, 0xda, 0xda, 0x67,
+            0x80, 0xc2, 0x7f, 0x8d, 0x5b, 0xab, 0xd9, 0xbb, 0xd7, 0x1e, 0x60, 0x96, 0x5d, 0xdd,
+            0x28, 0x65, 0x5f, 0x43, 0xf4, 0xb9, 0x0d, 0x7d, 0x05, 0x4e, 0x30, 0x50, 0xe1, 0x98,
+            0x03, 0xed, 0xee, 0x8a, 0xa8, 0x34, 0x40};
+    uint8_t frame[sizeof(testFrame)];
+    uint32_t timestamp = 0;
+
+    auto encode = [&]()
+    {
+        memcpy(frame, testFrame, sizeof(testFrame));
+        encoder->OnDataFromFrontNode(
+                MEDIASUBTYPE_UNDEFINED, frame, sizeof(frame), timestamp, false, 0);
+        timestamp += 20;
+    };
+
+    encode();
+    ASSERT_EQ(fakeNode->frames.size(), 1);
+
+    // two frames are packed from the next packet
+    encoder->SetNumFramesPerPacket(2);
+    encode();
+    EXPECT_EQ(fakeNode->frames.size(), 1);
+    encode();
+    ASSERT_EQ(fakeNode->frames.size(), 3);
+
+    // the change is applied after the packet being packed is sent
+    encode();
+    encoder->SetNumFramesPerPacket(1);
+    EXPECT_EQ(fakeNode->frames.size(), 3);
+    encode();
+    ASSERT_EQ(fakeNode->frames.size(), 5);
+    encode();
+    ASSERT_EQ(fakeNode->frames.size(), 6);
+
+    // the timestamps of the frames are continuous over the changes
+    for (uint32_t i = 0; i < fakeNode->frames.size(); i++)
+    {
+        EXPECT_EQ(fakeNode->frames[i].timestamp, i * 20);
+        EXPECT_EQ(fakeNode->frames[i].data,
+                std::vector<uint8_t>(testFrame, testFrame + sizeof(testFrame)));
+    }
+}
+
 TEST_F(AudioRtpPayloadNodeTest, testEvsCompactModeDataProcess)
 {
     evs.setEvsBandwidth(kEvsBandwidth);
@@ -293,4 +358,163 @@ TEST_F(AudioRtpPayloadNodeTest, testEvsHeaderFullModeDataProcess)
     EXPECT_EQ(fakeNode->GetFrameSize(), sizeof(testFrame));
     EXPECT_EQ(memcmp(fakeNode->GetDataFrame(), testFrame, fakeNode->GetFrameSize()), 0);
 }
+TEST_F(AudioRtpPayloadNodeTest, testAmrRedundantDataProcess)
+{
+    audioConfig.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    audioConfig.setRedundancyLevel(1);
+    audioConfig.setRedundancyDistance(1);
+    encoder->SetConfig(&audioConfig);
+    decoder->SetConfig(&audioConfig);
+    EXPECT_EQ(encoder->Start(), RESULT_SUCCESS);
+    EXPECT_EQ(decoder->Start(), RESULT_SUCCESS);
+
+    // AMR-WB mode 8 audio frame with toc field
+    uint8_t testFrame[] = {0x44, 0xe6, 0x6e, 0x84, 0x8a, 0xa4, 0xda, 0xc8, 0xf2, 0x6c, 0xeb, 0x87,
+            0xe4, 0x56, 0x0f, 0x49, 0x47, 0xfa, 0xdc, 0xa7, 0x9d, 0xbb, 0xcf, 0xda, 0xda, 0x67,
+            0x80, 0xc2, 0x7f, 0x8d, 0x5b, 0xab, 0xd9, 0xbb, 0xd7, 0x1e, 0x60, 0x96, 0x5d, 0xdd,
+            0x28, 0x65, 0x5f, 0x43, 0xf4, 0xb9, 0x0d, 0x7d, 0x05, 0x4e, 0x30, 0x50, 0xe1, 0x98,
+            0x03, 0xed, 0xee, 0x8a, 0xa8, 0x34, 0x40};
+
+    // the redundant blocks are not used when there is no loss
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        encoder->OnDataFromFrontNode(
+                MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), i * 20, false, 0);
+    }
+
+    ASSERT_EQ(fakeNode->frames.size(), 3);
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(fakeNode->frames[i].timestamp, i * 20);
+        EXPECT_EQ(fakeNode->frames[i].dataType, MEDIASUBTYPE_UNDEFINED);
+        ASSERT_EQ(fakeNode->frames[i].data.size(), sizeof(testFrame));
+        EXPECT_EQ(memcmp(fakeNode->frames[i].data.data(), testFrame, sizeof(testFrame)), 0);
+    }
+}
+
+TEST_F(AudioRtpPayloadNodeTest, testAmrRedundantDataRecovery)
+{
+    audioConfig.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    audioConfig.setRedundancyLevel(2);
+    audioConfig.setRedundancyDistance(1);
+    decoder->SetConfig(&audioConfig);
+    EXPECT_EQ(decoder->Start(), RESULT_SUCCESS);
+
+    AudioRtpPayloadEncoderNode redEncoder;
+    FakeNode packets;
+    redEncoder.SetMediaType(IMS_MEDIA_AUDIO);
+    redEncoder.SetConfig(&audioConfig);
+    redEncoder.ConnectRearNode(&packets);
+    EXPECT_EQ(redEncoder.Start(), RESULT_SUCCESS);
+
+    uint8_t testFrame[] = {0x44, 0xe6, 0x6e, 0x84, 0x8a, 0xa4, 0xda, 0xc8, 0xf2, 0x6c, 0xeb, 0x87,
+            0xe4, 0x56, 0x0f, 0x49, 0x47, 0xfa, 0xdc, 0xa7, 0x9d, 0xbb, 0xcf, 0xda, 0xda, 0x67,
+            0x80, 0xc2, 0x7f, 0x8d, 0x5b, 0xab, 0xd9, 0xbb, 0xd7, 0x1e, 0x60, 0x96, 0x5d, 0xdd,
+            0x28, 0x65, 0x5f, 0x43, 0xf4, 0xb9, 0x0d, 0x7d, 0x05, 0x4e, 0x30, 0x50, 0xe1, 0x98,
+            0x03, 0xed, 0xee, 0x8a, 0xa8, 0x34, 0x40};
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        redEncoder.OnDataFromFrontNode(
+                MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), i * 20, false, 0);
+    }
+
+    ASSERT_EQ(packets.frames.size(), 4);
+    EXPECT_EQ(packets.frames[0].subtype, MEDIASUBTYPE_AUDIO_RED);
+    // the primary header only
+    EXPECT_EQ(packets.frames[0].data[0], kTxPayload);
+    // the two redundant blocks with the timestamp offset of 40 and 20 msec in 16 kHz
+    const std::vector<uint8_t>& packet = packets.frames[3].data;
+    ASSERT_GT(packet.size(), 9);
+    EXPECT_EQ(packet[0], 0x80 | kTxPayload);
+    EXPECT_EQ((packet[1] << 6) | (packet[2] >> 2), 640);
+    EXPECT_EQ(packet[4], 0x80 | kTxPayload);
+    EXPECT_EQ((packet[5] << 6) | (packet[6] >> 2), 320);
+    EXPECT_EQ(packet[8], kTxPayload);
+
+    // the second and the third packets are lost
+    decoder->OnDataFromFrontNode(MEDIASUBTYPE_AUDIO_RED, packets.frames[0].data.data(),
+            packets.frames[0].data.size(), 0, false, 10);
+    decoder->OnDataFromFrontNode(MEDIASUBTYPE_AUDIO_RED, packets.frames[3].data.data(),
+            packets.frames[3].data.size(), 60, false, 13);
+
+    const uint32_t expectedSeq[] = {10, 11, 12, 13};
+    const ImsMediaSubType expectedType[] = {MEDIASUBTYPE_UNDEFINED, MEDIASUBTYPE_AUDIO_RED,
+            MEDIASUBTYPE_AUDIO_RED, MEDIASUBTYPE_UNDEFINED};
+    ASSERT_EQ(fakeNode->frames.size(), 4);
+
+    for (uint32_t i = 0; i < 4; i++)
+    {
+        EXPECT_EQ(fakeNode->frames[i].timestamp, i * 20);
+        EXPECT_EQ(fakeNode->frames[i].seq, expectedSeq[i]);
+        EXPECT_EQ(fakeNode->frames[i].dataType, expectedType[i]);
+        ASSERT_EQ(fakeNode->frames[i].data.size(), sizeof(testFrame));
+        EXPECT_EQ(memcmp(fakeNode->frames[i].data.data(), testFrame, sizeof(testFrame)), 0);
+    }
+
+    // the late packet does not recover the frames already received
+    decoder->OnDataFromFrontNode(MEDIASUBTYPE_AUDIO_RED, packets.frames[2].data.data(),
+            packets.frames[2].data.size(), 40, false, 12);
+    ASSERT_EQ(fakeNode->frames.size(), 5);
+    EXPECT_EQ(fakeNode->frames[4].timestamp, 40);
+    EXPECT_EQ(fakeNode->frames[4].dataType, MEDIASUBTYPE_UNDEFINED);
+
+    redEncoder.Stop();
+}
+
+TEST_F(AudioRtpPayloadNodeTest, testAmrRedundantDataWithDtmf)
+{
+    audioConfig.setRedPayloadTypeNumber(kRedPayloadTypeNumber);
+    audioConfig.setRedundancyLevel(1);
+    audioConfig.setRedundancyDistance(1);
+
+    AudioRtpPayloadEncoderNode redEncoder;
+    FakeNode packets;
+    redEncoder.SetMediaType(IMS_MEDIA_AUDIO);
+    redEncoder.SetConfig(&audioConfig);
+    redEncoder.ConnectRearNode(&packets);
+    EXPECT_EQ(redEncoder.Start(), RESULT_SUCCESS);
+
+    uint8_t testFrame[] = {0x44, 0xe6, 0x6e, 0x84, 0x8a, 0xa4, 0xda, 0xc8, 0xf2, 0x6c, 0xeb, 0x87,
+            0xe4, 0x56, 0x0f, 0x49, 0x47, 0xfa, 0xdc, 0xa7, 0x9d, 0xbb, 0xcf, 0xda, 0xda, 0x67,
+            0x80, 0xc2, 0x7f, 0x8d, 0x5b, 0xab, 0xd9, 0xbb, 0xd7, 0x1e, 0x60, 0x96, 0x5d, 0xdd,
+            0x28, 0x65, 0x5f, 0x43, 0xf4, 0xb9, 0x0d, 0x7d, 0x05, 0x4e, 0x30, 0x50, 0xe1, 0x98,
+            0x03, 0xed, 0xee, 0x8a, 0xa8, 0x34, 0x40};
+
+    redEncoder.OnDataFromFrontNode(
+            MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 0, false, 0);
+
+    // the payloads in the dtmf mode are dropped by the rtp encoder
+    redEncoder.OnDataFromFrontNode(MEDIASUBTYPE_DTMFSTART, nullptr, 0, 0, false, 0);
+    uint8_t dtmfPayload[] = {0x01, 0x0a, 0x00, 0xa0};
+    redEncoder.OnDataFromFrontNode(
+            MEDIASUBTYPE_DTMF_PAYLOAD, dtmfPayload, sizeof(dtmfPayload), 20, false, 0);
+    redEncoder.OnDataFromFrontNode(
+            MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 20, false, 0);
+    redEncoder.OnDataFromFrontNode(
+            MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), 40, false, 0);
+    redEncoder.OnDataFromFrontNode(MEDIASUBTYPE_DTMFEND, nullptr, 0, 0, false, 0);
+
+    for (uint32_t i = 3; i < 5; i++)
+    {
+        redEncoder.OnDataFromFrontNode(
+                MEDIASUBTYPE_UNDEFINED, testFrame, sizeof(testFrame), i * 20, false, 0);
+    }
+
+    ASSERT_EQ(packets.frames.size(), 5);
+
+    // the payloads before the end of the dtmf are not carried as the redundant blocks
+    EXPECT_EQ(packets.frames[3].subtype, MEDIASUBTYPE_AUDIO_RED);
+    EXPECT_EQ(packets.frames[3].data[0], kTxPayload);
+    EXPECT_EQ(packets.frames[3].data.size(), sizeof(testFrame) + 1);
+
+    const std::vector<uint8_t>& packet = packets.frames[4].data;
+    ASSERT_GT(packet.size(), 5);
+    EXPECT_EQ(packet[0], 0x80 | kTxPayload);
+    EXPECT_EQ((packet[1] << 6) | (packet[2] >> 2), 320);
+    EXPECT_EQ(packet[4], kTxPayload);
+
+    redEncoder.Stop();
+}
 }  // namespace
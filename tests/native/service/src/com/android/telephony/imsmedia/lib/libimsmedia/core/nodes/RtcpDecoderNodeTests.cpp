@@ -247,6 +247,7 @@ TEST_F(RtcpDecoderNodeTests, TestOnRtcpFbInd)
     payload.wFmt = kRtpFbTmmbr;
     uint8_t fbMsgData[64];
     payload.pMsg = fbMsgData;
+    payload.wMsgLen = 16;
     pRtcpDecNode->OnRtcpInd(RTPSVC_RECEIVE_RTCP_FB_IND, &payload);
     EXPECT_EQ(pCallback->mOnEventCalled, true);
     EXPECT_EQ(pCallback->mType, kRequestVideoSendTmmbn);
@@ -289,11 +290,93 @@ TEST_F(RtcpDecoderNodeTests, TestReceiveTmmbr)
     memset(&payload, 0x00, sizeof(payload));
     uint8_t fbMsgData[64];
     payload.pMsg = fbMsgData;
+    payload.wMsgLen = 16;
     pRtcpDecNode->ReceiveTmmbr(&payload);
     EXPECT_EQ(pCallback->mOnEventCalled, true);
     EXPECT_EQ(pCallback->mType, kRequestVideoSendTmmbn);
 }
 
+TEST_F(RtcpDecoderNodeTests, TestReceiveNack)
+{
+    tRtpSvcIndSt_ReceiveRtcpFeedbackInd payload;
+    memset(&payload, 0x00, sizeof(payload));
+    payload.wFmt = kRtpFbNack;
+    // PID 100 with BLP 0x8001, PID 200 with no BLP
+    uint8_t fbMsgData[] = {0x00, 0x64, 0x80, 0x01, 0x00, 0xc8, 0x00, 0x00};
+    payload.pMsg = fbMsgData;
+    payload.wMsgLen = 8 + sizeof(fbMsgData);
+
+    // the retransmission is only for the video
+    pRtcpDecNode->SetMediaType(IMS_MEDIA_AUDIO);
+    pRtcpDecNode->OnRtcpInd(RTPSVC_RECEIVE_RTCP_FB_IND, &payload);
+    EXPECT_EQ(pCallback->mOnEventCalled, false);
+
+    pRtcpDecNode->SetMediaType(IMS_MEDIA_VIDEO);
+    pRtcpDecNode->OnRtcpInd(RTPSVC_RECEIVE_RTCP_FB_IND, &payload);
+    EXPECT_EQ(pCallback->mOnEventCalled, true);
+    EXPECT_EQ(pCallback->mType, kRequestVideoRetransmission);
+    EXPECT_EQ(pCallback->mParam1, 200);
+    EXPECT_EQ(pCallback->mParam2, 0);
+}
+
+TEST_F(RtcpDecoderNodeTests, TestReceiveTmmbrWithShortFci)
+{
+    pRtcpDecNode->SetMediaType(IMS_MEDIA_AUDIO);
+    tRtpSvcIndSt_ReceiveRtcpFeedbackInd payload;
+    memset(&payload, 0x00, sizeof(payload));
+    uint8_t fbMsgData[4];
+    payload.pMsg = fbMsgData;
+    payload.wMsgLen = 12;
+    pRtcpDecNode->ReceiveTmmbr(&payload);
+    EXPECT_EQ(pCallback->mOnEventCalled, false);
+}
+
+TEST_F(RtcpDecoderNodeTests, TestTransportFeedbackBitrateChange)
+{
+    TransportFeedbackResult feedback;
+    int64_t sendTimeMs = 0;
+    int64_t queueDelayUs = 0;
+
+    // stable delay, a frame of 2 packets in every 33 msec and a feedback in every 3 frames
+    for (int32_t i = 0; i < 30 && !pCallback->mOnEventCalled; i++)
+    {
+        feedback.packets.clear();
+
+        for (int32_t j = 0; j < 6; j++)
+        {
+            int64_t sendTime = sendTimeMs + (j / 2) * 33 + (j % 2);
+            feedback.packets.push_back({static_cast<uint16_t>(i * 6 + j), true,
+                    (sendTime + 50) * 1000 + queueDelayUs, sendTime});
+        }
+
+        pRtcpDecNode->OnTransportFeedback(feedback);
+        sendTimeMs += 99;
+    }
+
+    EXPECT_EQ(pCallback->mOnEventCalled, false);
+
+    // the queue builds up without any loss
+    for (int32_t i = 30; i < 60 && !pCallback->mOnEventCalled; i++)
+    {
+        feedback.packets.clear();
+
+        for (int32_t j = 0; j < 6; j++)
+        {
+            int64_t sendTime = sendTimeMs + (j / 2) * 33 + (j % 2);
+            queueDelayUs += j % 2 == 0 ? 3000 : 0;
+            feedback.packets.push_back({static_cast<uint16_t>(i * 6 + j), true,
+                    (sendTime + 50) * 1000 + queueDelayUs, sendTime});
+        }
+
+        pRtcpDecNode->OnTransportFeedback(feedback);
+        sendTimeMs += 99;
+    }
+
+    EXPECT_EQ(pCallback->mOnEventCalled, true);
+    EXPECT_EQ(pCallback->mType, kRequestVideoBitrateChange);
+    EXPECT_LT(pCallback->mParam1, static_cast<uint64_t>(kBitrate * 1000));
+}
+
 TEST_F(RtcpDecoderNodeTests, TestRequestIdrFrame)
 {
     pRtcpDecNode->RequestIdrFrame();
@@ -17,6 +17,7 @@
 #include <gtest/gtest.h>
 #include <condition_variable>
 #include <mutex>
+#include <vector>
 #include <RtcpConfig.h>
 #include <AudioConfig.h>
 #include <VideoConfig.h>
@@ -280,6 +281,11 @@ TEST_F(RtcpEncoderNodeTests, TestSendNack)
     EXPECT_EQ(pRtcpEncNode->Start(), RESULT_SUCCESS);
     bRet = pRtcpEncNode->SendNack(&param);
     EXPECT_EQ(bRet, true);
+
+    // the fcis over the maximum of a feedback message are sent in the next message
+    std::vector<NackParams> params(70, param);
+    bRet = pRtcpEncNode->SendNack(params.data(), params.size());
+    EXPECT_EQ(bRet, true);
     pRtcpEncNode->Stop();
     delete pRtcpEncNode;
 }
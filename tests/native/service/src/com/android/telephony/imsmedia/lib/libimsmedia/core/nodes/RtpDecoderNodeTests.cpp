@@ -76,6 +76,7 @@ const android::String8 kPauseImagePath("data/user_de/0/com.android.telephony.ims
 const int32_t kDeviceOrientationDegree = 0;
 const int32_t kCvoValue = 1;
 const int32_t kRtcpFbTypes = VideoConfig::RTP_FB_NONE;
+const int32_t kTransportSeqValue = 2;
 
 // TextConfig
 const int8_t kRedundantPayload = 102;
@@ -90,6 +91,7 @@ public:
         dtmfDigit = 0;
         dtmfDuration = 0;
         listExtensions = nullptr;
+        numTransportFeedback = 0;
     }
     virtual ~FakeRtpDecoderCallback()
     {
@@ -114,15 +116,26 @@ public:
 
             listExtensions = reinterpret_cast<std::list<RtpHeaderExtension>*>(param1);
         }
+        else if (type == kRequestVideoSendTransportFeedback)
+        {
+            uint8_t* data = reinterpret_cast<uint8_t*>(param1);
+            TransportFeedback::Parse(data, static_cast<uint32_t>(param2), &transportFeedback);
+            numTransportFeedback++;
+            delete[] data;
+        }
     }
     uint8_t GetDtmfDigit() { return dtmfDigit; }
     uint32_t GetDtmfDuration() { return dtmfDuration; }
     std::list<RtpHeaderExtension>* GetListExtension() { return listExtensions; }
+    uint32_t GetNumTransportFeedback() { return numTransportFeedback; }
+    TransportFeedbackResult& GetTransportFeedback() { return transportFeedback; }
 
 private:
     uint8_t dtmfDigit;
     uint32_t dtmfDuration;
     std::list<RtpHeaderExtension>* listExtensions;
+    uint32_t numTransportFeedback;
+    TransportFeedbackResult transportFeedback;
 };
 
 class FakeRtpDecoderNode : public BaseNode
@@ -463,6 +476,45 @@ TEST_F(RtpDecoderNodeTest, testVideoDataProcess)
     EXPECT_EQ(fakeNode->GetSubType(), MEDIASUBTYPE_ROT270);
 }
 
+TEST_F(RtpDecoderNodeTest, testVideoTransportFeedback)
+{
+    setupVideoConfig();
+    videoConfig.setTransportSeqValue(kTransportSeqValue);
+    videoConfig.setRtcpFbType(VideoConfig::RTP_FB_TRANSPORT_CC);
+    encoder->SetConfig(&videoConfig);
+    decoder->SetConfig(&videoConfig);
+    EXPECT_EQ(encoder->Start(), RESULT_SUCCESS);
+    EXPECT_EQ(decoder->Start(), RESULT_SUCCESS);
+
+    uint8_t testFrame[] = {0x41, 0x9a, 0x02, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+    // cvo and the transport wide sequence number in the same block
+    EXPECT_TRUE(encoder->SetCvoExtension(0, 90));
+    encoder->OnDataFromFrontNode(
+            MEDIASUBTYPE_VIDEO_IDR_FRAME, testFrame, sizeof(testFrame), 0, true, 0);
+    encoder->ProcessData();
+    EXPECT_EQ(fakeNode->GetSubType(), MEDIASUBTYPE_ROT270);
+    EXPECT_EQ(callback.GetNumTransportFeedback(), 0);
+
+    // the feedback is sent when the number of the pending packets reaches the limit
+    for (uint32_t i = 1; i < TransportFeedback::kMaxStatusCount; i++)
+    {
+        encoder->OnDataFromFrontNode(
+                MEDIASUBTYPE_RTPPAYLOAD, testFrame, sizeof(testFrame), i * 10, false, 0);
+        encoder->ProcessData();
+    }
+
+    EXPECT_EQ(callback.GetNumTransportFeedback(), 1);
+    TransportFeedbackResult& result = callback.GetTransportFeedback();
+    ASSERT_EQ(result.packets.size(), TransportFeedback::kMaxStatusCount);
+
+    for (uint32_t i = 0; i < result.packets.size(); i++)
+    {
+        EXPECT_EQ(result.packets[i].seqNum, i);
+        EXPECT_TRUE(result.packets[i].received);
+    }
+}
+
 TEST_F(RtpDecoderNodeTest, startTextAndUpdate)
 {
     setupTextConfig();
@@ -19,6 +19,7 @@
 #include <VideoConfig.h>
 #include <TextConfig.h>
 #include <RtpEncoderNode.h>
+#include <vector>
 
 using namespace android::telephony::imsmedia;
 using namespace android;
@@ -116,21 +117,26 @@ public:
             uint32_t arrivalTime)
     {
         (void)subtype;
-        (void)data;
         (void)timestamp;
         (void)mark;
         (void)seq;
         (void)dataType;
         (void)arrivalTime;
         mFrameSize = size;
+        mNumFrames++;
+        mLastFrame.assign(data, data + size);
     }
 
     virtual kBaseNodeState GetState() { return kNodeStateRunning; }
 
     uint32_t GetFrameSize() { return mFrameSize; }
+    uint32_t GetNumFrames() { return mNumFrames; }
+    std::vector<uint8_t>& GetLastFrame() { return mLastFrame; }
 
 private:
     uint32_t mFrameSize;
+    uint32_t mNumFrames = 0;
+    std::vector<uint8_t> mLastFrame;
 };
 
 class RtpEncoderNodeTest : public ::testing::Test
@@ -349,6 +355,33 @@ TEST_F(RtpEncoderNodeTest, testVideoDataProcess)
     EXPECT_EQ(mFakeNode->GetFrameSize(), sizeof(testFrame) + kRtpHeaderSizeWithExtension);
 }
 
+TEST_F(RtpEncoderNodeTest, testVideoRetransmission)
+{
+    setupVideoConfig();
+    EXPECT_EQ(mNode->Start(), RESULT_SUCCESS);
+
+    uint8_t testFrame[] = {0x41, 0x9a, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+    mNode->OnDataFromFrontNode(MEDIASUBTYPE_RTPPAYLOAD, testFrame, sizeof(testFrame), 0, true, 0);
+    mNode->ProcessData();
+    ASSERT_EQ(mFakeNode->GetNumFrames(), 1);
+
+    std::vector<uint8_t> sentPacket = mFakeNode->GetLastFrame();
+    uint16_t seqNum = sentPacket[2] << 8 | sentPacket[3];
+
+    // the lost packet and the next one not sent yet
+    mNode->RetransmitPackets(seqNum, 0x0001);
+    EXPECT_EQ(mFakeNode->GetNumFrames(), 2);
+    EXPECT_EQ(mFakeNode->GetLastFrame(), sentPacket);
+
+    // the NACK repeated within the round trip time is ignored
+    mNode->RetransmitPackets(seqNum, 0);
+    EXPECT_EQ(mFakeNode->GetNumFrames(), 2);
+
+    // the packet not in the history
+    mNode->RetransmitPackets(seqNum - 1, 0);
+    EXPECT_EQ(mFakeNode->GetNumFrames(), 2);
+}
+
 TEST_F(RtpEncoderNodeTest, startTextAndUpdate)
 {
     setupTextConfig();
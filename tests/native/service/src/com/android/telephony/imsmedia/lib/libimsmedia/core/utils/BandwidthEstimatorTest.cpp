@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <BandwidthEstimator.h>
+
+const uint32_t kMinBitrate = 100000;
+const uint32_t kMaxBitrate = 1000000;
+const uint32_t kStartBitrate = 500000;
+const int64_t kFrameIntervalUs = 33000;
+const int32_t kPacketsPerFrame = 3;
+
+class BandwidthEstimatorTest : public ::testing::Test
+{
+public:
+    BandwidthEstimator estimator;
+    int64_t sendTimeUs;
+    int64_t queueDelayUs;
+
+protected:
+    virtual void SetUp() override
+    {
+        estimator.SetBitrateRange(kMinBitrate, kMaxBitrate, kStartBitrate);
+        sendTimeUs = 0;
+        queueDelayUs = 0;
+    }
+
+    virtual void TearDown() override {}
+
+    // sends the frames of the packets in 1 msec apart, the queue delay grows by delayStepUs
+    void sendFrames(int32_t numFrames, int64_t delayStepUs)
+    {
+        for (int32_t i = 0; i < numFrames; i++)
+        {
+            queueDelayUs = std::max(queueDelayUs + delayStepUs, static_cast<int64_t>(0));
+
+            for (int32_t j = 0; j < kPacketsPerFrame; j++)
+            {
+                int64_t sendTime = sendTimeUs + j * 1000;
+                estimator.OnPacketArrival(sendTime, sendTime + 50000 + queueDelayUs);
+            }
+
+            sendTimeUs += kFrameIntervalUs;
+        }
+    }
+};
+
+TEST_F(BandwidthEstimatorTest, StableDelayIncreaseTest)
+{
+    EXPECT_EQ(estimator.GetTargetBitrate(), kStartBitrate);
+
+    uint32_t time = 1000;
+    uint32_t previousBitrate = estimator.GetTargetBitrate();
+
+    for (int32_t i = 0; i < 5; i++)
+    {
+        sendFrames(30, 0);
+        EXPECT_EQ(estimator.GetUsage(), kBandwidthNormal);
+
+        uint32_t bitrate = estimator.Update(time, 0);
+        EXPECT_GE(bitrate, previousBitrate);
+        previousBitrate = bitrate;
+        time += 1000;
+    }
+
+    EXPECT_GT(previousBitrate, kStartBitrate);
+    EXPECT_LE(previousBitrate, kMaxBitrate);
+}
+
+TEST_F(BandwidthEstimatorTest, OveruseBeforeLossTest)
+{
+    sendFrames(60, 0);
+    EXPECT_EQ(estimator.GetUsage(), kBandwidthNormal);
+
+    // the queue builds up by 2 msec every frame without any loss
+    sendFrames(30, 2000);
+    EXPECT_EQ(estimator.GetUsage(), kBandwidthOverusing);
+
+    uint32_t bitrate = estimator.Update(1000, 400000);
+    EXPECT_EQ(bitrate, static_cast<uint32_t>(400000 * 0.85));
+
+    // the decrease is paced by the response time
+    EXPECT_EQ(estimator.Update(1100, 300000), bitrate);
+}
+
+TEST_F(BandwidthEstimatorTest, UnderuseHoldTest)
+{
+    sendFrames(60, 3000);
+    EXPECT_EQ(estimator.GetUsage(), kBandwidthOverusing);
+    uint32_t bitrate = estimator.Update(1000, 0);
+    EXPECT_LT(bitrate, kStartBitrate);
+
+    // the queue drains
+    sendFrames(20, -6000);
+    EXPECT_EQ(estimator.GetUsage(), kBandwidthUnderusing);
+    EXPECT_EQ(estimator.Update(2000, 0), bitrate);
+}
+
+TEST_F(BandwidthEstimatorTest, LossBasedControlTest)
+{
+    sendFrames(60, 0);
+
+    // the moderate loss holds the bitrate
+    estimator.OnPacketLoss(5, 100);
+    EXPECT_EQ(estimator.Update(1000, 0), kStartBitrate);
+
+    // the high loss decreases the bitrate
+    estimator.OnPacketLoss(20, 100);
+    EXPECT_EQ(estimator.Update(2000, 0), static_cast<uint32_t>(kStartBitrate * 0.9));
+
+    // the loss is cleared after the update
+    EXPECT_GT(estimator.Update(3000, 0), static_cast<uint32_t>(kStartBitrate * 0.9));
+}
+
+TEST_F(BandwidthEstimatorTest, BitrateRangeTest)
+{
+    estimator.SetBitrateRange(kMinBitrate, kMaxBitrate, kMinBitrate + 10000);
+    estimator.OnPacketLoss(90, 100);
+    EXPECT_EQ(estimator.Update(1000, 0), kMinBitrate);
+
+    estimator.SetBitrateRange(kMinBitrate, kMaxBitrate, kMaxBitrate * 2);
+    EXPECT_EQ(estimator.GetTargetBitrate(), kMaxBitrate);
+    EXPECT_EQ(estimator.Update(5000, 0), kMaxBitrate);
+
+    // the increase is limited by the incoming bitrate
+    estimator.SetBitrateRange(kMinBitrate, 0, kStartBitrate);
+    EXPECT_EQ(estimator.Update(6000, 200000), kStartBitrate);
+
+    estimator.Reset();
+    EXPECT_EQ(estimator.GetTargetBitrate(), kStartBitrate);
+    EXPECT_EQ(estimator.GetUsage(), kBandwidthNormal);
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <FecPacketGenerator.h>
+
+const uint32_t kPayloadSize = 20;
+
+class FecPacketGeneratorTest : public ::testing::Test
+{
+public:
+    FecPacketGenerator generator;
+    std::list<std::vector<uint8_t>> fecPackets;
+
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+
+    void addPackets(uint16_t seqNum, uint32_t numPackets)
+    {
+        for (uint32_t i = 0; i < numPackets; i++)
+        {
+            uint8_t packet[12 + kPayloadSize] = {0x80, 0x60};
+            packet[2] = (seqNum + i) >> 8;
+            packet[3] = (seqNum + i) & 0xFF;
+            EXPECT_TRUE(generator.AddMediaPacket(packet, sizeof(packet)));
+        }
+    }
+
+    // the media packets protected by the fec packet, in the offset from the base
+    uint64_t getMask(const std::vector<uint8_t>& fec)
+    {
+        uint64_t mask = fec[12] << 8 | fec[13];
+
+        if (fec[0] & 0x40)
+        {
+            mask = mask << 32 | static_cast<uint32_t>(fec[14]) << 24 | fec[15] << 16 |
+                    fec[16] << 8 | fec[17];
+        }
+
+        return mask;
+    }
+};
+
+TEST_F(FecPacketGeneratorTest, InterleavedMaskTest)
+{
+    generator.SetProtection(50, kFecMaskInterleaved);
+    addPackets(100, 4);
+    EXPECT_EQ(generator.GetNumMediaPackets(), 4);
+    EXPECT_EQ(generator.Generate(fecPackets), 2);
+    EXPECT_EQ(generator.GetNumMediaPackets(), 0);
+
+    ASSERT_EQ(fecPackets.size(), 2);
+    const std::vector<uint8_t>& fec = fecPackets.front();
+    EXPECT_EQ(fec.size(),
+            FecPacketGenerator::kFecHeaderSize + FecPacketGenerator::kShortLevelHeaderSize +
+                    kPayloadSize);
+    EXPECT_EQ(fec[2] << 8 | fec[3], 100);
+    EXPECT_EQ(fec[10] << 8 | fec[11], kPayloadSize);
+    EXPECT_EQ(getMask(fec), 0xA000);
+    EXPECT_EQ(getMask(fecPackets.back()), 0x5000);
+}
+
+TEST_F(FecPacketGeneratorTest, ConsecutiveMaskTest)
+{
+    generator.SetProtection(50, kFecMaskConsecutive);
+    addPackets(65534, 4);
+    EXPECT_EQ(generator.Generate(fecPackets), 2);
+    ASSERT_EQ(fecPackets.size(), 2);
+    EXPECT_EQ(fecPackets.front()[2] << 8 | fecPackets.front()[3], 65534);
+    EXPECT_EQ(getMask(fecPackets.front()), 0xC000);
+    EXPECT_EQ(getMask(fecPackets.back()), 0x3000);
+}
+
+TEST_F(FecPacketGeneratorTest, LongMaskTest)
+{
+    generator.SetProtection(10, kFecMaskInterleaved);
+    addPackets(0, 20);
+    EXPECT_EQ(generator.Generate(fecPackets), 2);
+    ASSERT_EQ(fecPackets.size(), 2);
+    EXPECT_NE(fecPackets.front()[0] & 0x40, 0);
+    EXPECT_EQ(getMask(fecPackets.front()), 0xAAAAA0000000ULL);
+}
+
+TEST_F(FecPacketGeneratorTest, AddMediaPacketTest)
+{
+    uint8_t packet[12 + kPayloadSize] = {0x80, 0x60, 0x00, 0x0A};
+    EXPECT_FALSE(generator.AddMediaPacket(nullptr, sizeof(packet)));
+    EXPECT_FALSE(generator.AddMediaPacket(packet, 8));
+    EXPECT_TRUE(generator.AddMediaPacket(packet, sizeof(packet)));
+
+    // the retransmitted packet is not protected again
+    EXPECT_FALSE(generator.AddMediaPacket(packet, sizeof(packet)));
+    EXPECT_EQ(generator.GetNumMediaPackets(), 1);
+
+    // no fec packet without the protection
+    EXPECT_EQ(generator.GetFecRate(), 0);
+    EXPECT_EQ(generator.Generate(fecPackets), 0);
+    EXPECT_EQ(generator.GetNumMediaPackets(), 0);
+}
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <FecPacketGenerator.h>
+#include <FecPacketRecovery.h>
+
+const uint32_t kFecSsrc = 0x55667788;
+const uint16_t kBaseSeqNum = 65530;
+
+class FecPacketRecoveryTest : public ::testing::Test
+{
+public:
+    FecPacketGenerator generator;
+    FecPacketRecovery recovery;
+    std::vector<std::vector<uint8_t>> mediaPackets;
+    std::list<std::vector<uint8_t>> fecPackets;
+
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+
+    // generates the media packets in the different size and the fec packets protecting them
+    void generate(uint32_t numPackets, uint32_t fecRate, kFecMaskType maskType)
+    {
+        generator.SetProtection(fecRate, maskType);
+
+        for (uint32_t i = 0; i < numPackets; i++)
+        {
+            uint16_t seqNum = kBaseSeqNum + i;
+            std::vector<uint8_t> packet = {0x80, 0x60, static_cast<uint8_t>(seqNum >> 8),
+                    static_cast<uint8_t>(seqNum & 0xFF), 0x00, 0x00, 0x0B, 0xB8, 0x11, 0x22,
+                    0x33, 0x44};
+
+            // the marker bit at the last packet
+            if (i == numPackets - 1)
+            {
+                packet[1] |= 0x80;
+            }
+
+            for (uint32_t j = 0; j < 10 + i * 3; j++)
+            {
+                packet.push_back(static_cast<uint8_t>(i * 7 + j));
+            }
+
+            mediaPackets.push_back(packet);
+            generator.AddMediaPacket(packet.data(), packet.size());
+        }
+
+        generator.Generate(fecPackets);
+    }
+};
+
+TEST_F(FecPacketRecoveryTest, RecoverSingleLossTest)
+{
+    generate(5, 20, kFecMaskInterleaved);
+    ASSERT_EQ(fecPackets.size(), 1);
+
+    for (uint32_t i = 0; i < mediaPackets.size(); i++)
+    {
+        if (i != 4)
+        {
+            recovery.OnMediaPacket(mediaPackets[i].data(), mediaPackets[i].size());
+        }
+    }
+
+    std::vector<uint8_t> packet;
+    EXPECT_FALSE(recovery.GetRecoveredPacket(packet));
+
+    const std::vector<uint8_t>& fec = fecPackets.front();
+    EXPECT_TRUE(recovery.OnFecPacket(fec.data(), fec.size(), kFecSsrc));
+    ASSERT_TRUE(recovery.GetRecoveredPacket(packet));
+    EXPECT_EQ(packet, mediaPackets[4]);
+    EXPECT_FALSE(recovery.GetRecoveredPacket(packet));
+    EXPECT_EQ(recovery.GetNumRecovered(), 1);
+}
+
+TEST_F(FecPacketRecoveryTest, RecoverBurstLossTest)
+{
+    generate(6, 50, kFecMaskInterleaved);
+    ASSERT_EQ(fecPackets.size(), 3);
+
+    // the fec packets arrive before the media packets, three consecutive packets are lost
+    for (auto& fec : fecPackets)
+    {
+        EXPECT_TRUE(recovery.OnFecPacket(fec.data(), fec.size(), kFecSsrc));
+    }
+
+    for (uint32_t i = 3; i < mediaPackets.size(); i++)
+    {
+        recovery.OnMediaPacket(mediaPackets[i].data(), mediaPackets[i].size());
+    }
+
+    std::vector<uint8_t> packet;
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        ASSERT_TRUE(recovery.GetRecoveredPacket(packet));
+        EXPECT_EQ(packet, mediaPackets[i]);
+    }
+
+    EXPECT_EQ(recovery.GetNumRecovered(), 3);
+}
+
+TEST_F(FecPacketRecoveryTest, RecoverInTurnTest)
+{
+    generate(4, 50, kFecMaskConsecutive);
+    ASSERT_EQ(fecPackets.size(), 2);
+
+    // two losses in the first group can not be recovered
+    recovery.OnMediaPacket(mediaPackets[2].data(), mediaPackets[2].size());
+    recovery.OnFecPacket(fecPackets.front().data(), fecPackets.front().size(), kFecSsrc);
+
+    std::vector<uint8_t> packet;
+    EXPECT_FALSE(recovery.GetRecoveredPacket(packet));
+
+    recovery.OnMediaPacket(mediaPackets[1].data(), mediaPackets[1].size());
+    ASSERT_TRUE(recovery.GetRecoveredPacket(packet));
+    EXPECT_EQ(packet, mediaPackets[0]);
+
+    // the second group is recovered with the other fec packet
+    recovery.OnFecPacket(fecPackets.back().data(), fecPackets.back().size(), kFecSsrc);
+    ASSERT_TRUE(recovery.GetRecoveredPacket(packet));
+    EXPECT_EQ(packet, mediaPackets[3]);
+
+    recovery.Reset();
+    EXPECT_EQ(recovery.GetNumRecovered(), 0);
+}
+
+TEST_F(FecPacketRecoveryTest, InvalidFecPacketTest)
+{
+    generate(2, 50, kFecMaskInterleaved);
+    std::vector<uint8_t> fec = fecPackets.front();
+
+    EXPECT_FALSE(recovery.OnFecPacket(nullptr, fec.size(), kFecSsrc));
+    EXPECT_FALSE(recovery.OnFecPacket(fec.data(), 8, kFecSsrc));
+    EXPECT_FALSE(recovery.OnFecPacket(fec.data(), fec.size() - 1, kFecSsrc));
+
+    // no packet protected
+    fec[12] = 0;
+    fec[13] = 0;
+    EXPECT_FALSE(recovery.OnFecPacket(fec.data(), fec.size(), kFecSsrc));
+}
+
+TEST_F(FecPacketRecoveryTest, SsrcChangeTest)
+{
+    generate(5, 20, kFecMaskInterleaved);
+    ASSERT_EQ(fecPackets.size(), 1);
+    const std::vector<uint8_t>& fec = fecPackets.front();
+    std::vector<uint8_t> packet;
+
+    // the fec packet waits for one more media packet
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        recovery.OnMediaPacket(mediaPackets[i].data(), mediaPackets[i].size());
+    }
+
+    EXPECT_TRUE(recovery.OnFecPacket(fec.data(), fec.size(), kFecSsrc));
+
+    // the fec packets of the previous fec stream are dropped when the fec ssrc changes
+    std::vector<uint8_t> otherFec = fec;
+    otherFec[2] += 10;
+    EXPECT_TRUE(recovery.OnFecPacket(otherFec.data(), otherFec.size(), kFecSsrc + 1));
+    recovery.OnMediaPacket(mediaPackets[3].data(), mediaPackets[3].size());
+    EXPECT_FALSE(recovery.GetRecoveredPacket(packet));
+
+    // the fec packets are dropped when the media ssrc changes
+    recovery.Reset();
+
+    for (uint32_t i = 0; i < 3; i++)
+    {
+        recovery.OnMediaPacket(mediaPackets[i].data(), mediaPackets[i].size());
+    }
+
+    EXPECT_TRUE(recovery.OnFecPacket(fec.data(), fec.size(), kFecSsrc));
+    std::vector<uint8_t> otherPacket = mediaPackets[3];
+    otherPacket[11]++;
+    recovery.OnMediaPacket(otherPacket.data(), otherPacket.size());
+    EXPECT_FALSE(recovery.GetRecoveredPacket(packet));
+    EXPECT_EQ(recovery.GetNumRecovered(), 0);
+}
@@ -94,4 +94,24 @@ TEST(ImsMediaNetworkUtilTest, GetIPPortFromSocketFDUsingIpv6Address)
     ASSERT_EQ(res, false);
     res = ImsMediaNetworkUtil::getRemoteIpPortFromSocket(nTestSocFD, peerIPAddr, 32, peerPort);
     ASSERT_EQ(res, false);
-}
\ No newline at end of file
+}
+TEST(ImsMediaNetworkUtilTest, IsRtcpPacket)
+{
+    // rtp with the payload type 96 and the marker bit
+    const uint8_t rtp[] = {0x80, 0xE0, 0x00, 0x01};
+    // rtcp sender report and receiver report
+    const uint8_t sr[] = {0x80, 200, 0x00, 0x06};
+    const uint8_t rr[] = {0x81, 201, 0x00, 0x07};
+    // rtcp feedback in the upper bound of the range
+    const uint8_t fb[] = {0x81, 223, 0x00, 0x02};
+    // rtp with the payload type 96 and without the marker bit
+    const uint8_t rtpNoMark[] = {0x80, 0x60, 0x00, 0x01};
+
+    EXPECT_FALSE(ImsMediaNetworkUtil::isRtcpPacket(rtp, sizeof(rtp)));
+    EXPECT_TRUE(ImsMediaNetworkUtil::isRtcpPacket(sr, sizeof(sr)));
+    EXPECT_TRUE(ImsMediaNetworkUtil::isRtcpPacket(rr, sizeof(rr)));
+    EXPECT_TRUE(ImsMediaNetworkUtil::isRtcpPacket(fb, sizeof(fb)));
+    EXPECT_FALSE(ImsMediaNetworkUtil::isRtcpPacket(rtpNoMark, sizeof(rtpNoMark)));
+    EXPECT_FALSE(ImsMediaNetworkUtil::isRtcpPacket(sr, 1));
+    EXPECT_FALSE(ImsMediaNetworkUtil::isRtcpPacket(nullptr, 0));
+}
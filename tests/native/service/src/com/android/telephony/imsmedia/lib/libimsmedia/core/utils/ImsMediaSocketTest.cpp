@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <ISocket.h>
+#include <ImsMediaCondition.h>
+#include <ImsMediaNetworkUtil.h>
+
+static const char kLocalIp[] = "127.0.0.1";
+static const uint32_t kLocalPort = 12360;
+
+class FakeSocketListener : public ISocketListener
+{
+public:
+    FakeSocketListener() :
+            mSocket(nullptr),
+            mCount(0),
+            mLastSecondByte(0)
+    {
+    }
+
+    virtual ~FakeSocketListener() {}
+
+    virtual void OnReadDataFromSocket()
+    {
+        uint8_t buffer[DEFAULT_MTU];
+        int32_t len = mSocket->ReceiveFrom(buffer, DEFAULT_MTU);
+
+        if (len > 1)
+        {
+            mLastSecondByte = buffer[1];
+        }
+
+        mCount++;
+        mCondition.signal();
+    }
+
+    ISocket* mSocket;
+    int32_t mCount;
+    uint8_t mLastSecondByte;
+    ImsMediaCondition mCondition;
+};
+
+class ImsMediaSocketTest : public ::testing::Test
+{
+public:
+    int socketFd;
+    ISocket* socket;
+    FakeSocketListener rtpListener;
+    FakeSocketListener rtcpListener;
+
+protected:
+    virtual void SetUp() override
+    {
+        socketFd = ImsMediaNetworkUtil::openSocket(kLocalIp, kLocalPort, AF_INET);
+        ASSERT_NE(socketFd, -1);
+
+        // send to itself
+        socket = ISocket::GetInstance(kLocalPort, kLocalIp, kLocalPort);
+        ASSERT_TRUE(socket != nullptr);
+        socket->SetLocalEndpoint(kLocalIp, kLocalPort);
+        socket->SetPeerEndpoint(kLocalIp, kLocalPort);
+        ASSERT_TRUE(socket->Open(socketFd));
+        rtpListener.mSocket = socket;
+        rtcpListener.mSocket = socket;
+    }
+
+    virtual void TearDown() override
+    {
+        socket->Listen(nullptr);
+        socket->ListenRtcpMux(nullptr);
+        socket->Close();
+        ISocket::ReleaseInstance(socket);
+        ImsMediaNetworkUtil::closeSocket(socketFd);
+    }
+};
+
+TEST_F(ImsMediaSocketTest, TestRtcpMuxDemultiplexing)
+{
+    socket->Listen(&rtpListener);
+    socket->ListenRtcpMux(&rtcpListener);
+
+    uint8_t rtp[] = {0x80, 0xE0, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+    uint8_t rtcp[] = {0x81, 201, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+
+    EXPECT_EQ(socket->SendTo(rtp, sizeof(rtp)), sizeof(rtp));
+    EXPECT_FALSE(rtpListener.mCondition.wait_timeout(1000));
+    EXPECT_EQ(socket->SendTo(rtcp, sizeof(rtcp)), sizeof(rtcp));
+    EXPECT_FALSE(rtcpListener.mCondition.wait_timeout(1000));
+
+    EXPECT_EQ(rtpListener.mCount, 1);
+    EXPECT_EQ(rtpListener.mLastSecondByte, 0xE0);
+    EXPECT_EQ(rtcpListener.mCount, 1);
+    EXPECT_EQ(rtcpListener.mLastSecondByte, 201);
+}
+
+TEST_F(ImsMediaSocketTest, TestRtcpMuxWithoutRtpListener)
+{
+    socket->ListenRtcpMux(&rtcpListener);
+
+    uint8_t rtp[] = {0x80, 0xE0, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+    uint8_t rtcp[] = {0x81, 201, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00};
+
+    // the rtp packet is dropped, the rtcp packet behind it is still notified
+    EXPECT_EQ(socket->SendTo(rtp, sizeof(rtp)), sizeof(rtp));
+    EXPECT_EQ(socket->SendTo(rtcp, sizeof(rtcp)), sizeof(rtcp));
+    EXPECT_FALSE(rtcpListener.mCondition.wait_timeout(1000));
+
+    EXPECT_EQ(rtpListener.mCount, 0);
+    EXPECT_EQ(rtcpListener.mCount, 1);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <JitterRingQueue.h>
+#include <vector>
+
+class JitterRingQueueTest : public ::testing::Test
+{
+public:
+    JitterRingQueue queue;
+    uint8_t buffer[4] = {1, 2, 3, 4};
+
+protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+
+    bool insert(uint16_t seqNum, uint32_t timestamp)
+    {
+        DataEntry entry;
+        entry.pbBuffer = buffer;
+        entry.nBufferSize = sizeof(buffer);
+        entry.nSeqNum = seqNum;
+        entry.nTimestamp = timestamp;
+        return queue.Insert(&entry);
+    }
+
+    std::vector<uint16_t> readAll()
+    {
+        std::vector<uint16_t> seqs;
+        DataEntry* entry = nullptr;
+        queue.SetReadPosFirst();
+
+        while (queue.GetNext(&entry))
+        {
+            seqs.push_back(entry->nSeqNum);
+        }
+
+        return seqs;
+    }
+};
+
+TEST_F(JitterRingQueueTest, ReorderTest)
+{
+    DataEntry* entry = nullptr;
+    EXPECT_FALSE(queue.Get(&entry));
+    EXPECT_FALSE(queue.GetNext(&entry));
+
+    uint16_t order[] = {3, 1, 5, 2, 4};
+
+    for (uint16_t seq : order)
+    {
+        EXPECT_TRUE(insert(seq, seq * 20));
+    }
+
+    EXPECT_EQ(queue.GetCount(), 5);
+    EXPECT_EQ(readAll(), std::vector<uint16_t>({1, 2, 3, 4, 5}));
+
+    ASSERT_TRUE(queue.Get(&entry));
+    EXPECT_EQ(entry->nSeqNum, 1);
+    EXPECT_EQ(memcmp(entry->pbBuffer, buffer, sizeof(buffer)), 0);
+    EXPECT_NE(entry->pbBuffer, buffer);
+
+    ASSERT_TRUE(queue.GetLast(&entry));
+    EXPECT_EQ(entry->nSeqNum, 5);
+
+    queue.Delete();
+    queue.Delete();
+    ASSERT_TRUE(queue.Get(&entry));
+    EXPECT_EQ(entry->nSeqNum, 3);
+    EXPECT_EQ(queue.GetCount(), 3);
+
+    // the older one than the first is inserted at the front
+    EXPECT_TRUE(queue.IsOlderThanFirst(2));
+    EXPECT_TRUE(insert(2, 40));
+    EXPECT_EQ(readAll(), std::vector<uint16_t>({2, 3, 4, 5}));
+
+    queue.Clear();
+    EXPECT_EQ(queue.GetCount(), 0);
+    EXPECT_FALSE(queue.Get(&entry));
+}
+
+TEST_F(JitterRingQueueTest, WrapAroundTest)
+{
+    uint16_t order[] = {65534, 1, 65535, 0, 3};
+
+    for (uint16_t seq : order)
+    {
+        EXPECT_TRUE(insert(seq, 0));
+    }
+
+    EXPECT_EQ(readAll(), std::vector<uint16_t>({65534, 65535, 0, 1, 3}));
+    EXPECT_TRUE(queue.Contains(0));
+    EXPECT_FALSE(queue.Contains(2));
+    EXPECT_FALSE(queue.Contains(4));
+
+    // the slot of the lost packet is skipped
+    for (int32_t i = 0; i < 4; i++)
+    {
+        queue.Delete();
+    }
+
+    DataEntry* entry = nullptr;
+    ASSERT_TRUE(queue.Get(&entry));
+    EXPECT_EQ(entry->nSeqNum, 3);
+}
+
+TEST_F(JitterRingQueueTest, SameSequenceTest)
+{
+    // the frames of a packet share the sequence number
+    EXPECT_TRUE(insert(10, 200));
+    EXPECT_TRUE(insert(10, 220));
+    EXPECT_TRUE(insert(9, 180));
+
+    DataEntry* entry = nullptr;
+    ASSERT_TRUE(queue.Find(10, 220, &entry));
+    EXPECT_EQ(entry->nTimestamp, 220);
+    EXPECT_FALSE(queue.Find(10, 240, &entry));
+    EXPECT_FALSE(queue.Find(11, 200, &entry));
+
+    ASSERT_TRUE(queue.GetLast(&entry));
+    EXPECT_EQ(entry->nTimestamp, 220);
+
+    queue.Delete();
+    queue.Delete();
+    ASSERT_TRUE(queue.Get(&entry));
+    EXPECT_EQ(entry->nTimestamp, 220);
+    EXPECT_EQ(queue.GetCount(), 1);
+}
+
+TEST_F(JitterRingQueueTest, GrowAndJumpTest)
+{
+    for (uint16_t i = 0; i < 100; i++)
+    {
+        EXPECT_TRUE(insert(i * 2, 0));
+    }
+
+    EXPECT_EQ(queue.GetCount(), 100);
+    EXPECT_EQ(queue.GetCapacity(), 256);
+
+    // too old to keep the range
+    EXPECT_FALSE(insert(198 - JitterRingQueue::kMaxCapacity, 0));
+
+    // the jump of the sequence number drops the old entries
+    DataEntry jumpEntry;
+    jumpEntry.pbBuffer = buffer;
+    jumpEntry.nBufferSize = sizeof(buffer);
+    jumpEntry.nSeqNum = 100 + JitterRingQueue::kMaxCapacity;
+    std::list<uint16_t> droppedSeqs;
+    EXPECT_TRUE(queue.Insert(&jumpEntry, &droppedSeqs));
+    EXPECT_EQ(queue.GetCount(), 50);
+    ASSERT_EQ(droppedSeqs.size(), 51);
+    EXPECT_EQ(droppedSeqs.front(), 0);
+    EXPECT_EQ(droppedSeqs.back(), 100);
+
+    DataEntry* entry = nullptr;
+    ASSERT_TRUE(queue.Get(&entry));
+    EXPECT_EQ(entry->nSeqNum, 102);
+    EXPECT_EQ(queue.GetCapacity(), static_cast<uint32_t>(JitterRingQueue::kMaxCapacity));
+}
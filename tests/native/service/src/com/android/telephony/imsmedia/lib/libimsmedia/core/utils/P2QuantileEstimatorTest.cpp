@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <P2QuantileEstimator.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+class P2QuantileEstimatorTest : public ::testing::Test
+{
+public:
+    P2QuantileEstimatorTest() :
+            estimator(0.95)
+    {
+    }
+
+    P2QuantileEstimator estimator;
+
+protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+
+    double getExactQuantile(std::vector<double> samples, double quantile)
+    {
+        std::sort(samples.begin(), samples.end());
+        return samples[static_cast<size_t>((samples.size() - 1) * quantile)];
+    }
+};
+
+TEST_F(P2QuantileEstimatorTest, FewSamplesTest)
+{
+    EXPECT_EQ(estimator.GetEstimation(), 0);
+
+    estimator.Add(30);
+    estimator.Add(10);
+    estimator.Add(20);
+    EXPECT_EQ(estimator.GetCount(), 3);
+    EXPECT_EQ(estimator.GetEstimation(), 30);
+
+    estimator.SetQuantile(0.5);
+    EXPECT_EQ(estimator.GetCount(), 0);
+    estimator.Add(30);
+    estimator.Add(10);
+    estimator.Add(20);
+    EXPECT_EQ(estimator.GetEstimation(), 20);
+}
+
+TEST_F(P2QuantileEstimatorTest, DistributionTest)
+{
+    std::mt19937 generator(11);
+    std::exponential_distribution<double> jitter(1.0 / 30);
+    std::vector<double> samples;
+
+    for (int32_t i = 0; i < 20000; i++)
+    {
+        samples.push_back(jitter(generator));
+        estimator.Add(samples.back());
+    }
+
+    double exact = getExactQuantile(samples, 0.95);
+    EXPECT_NEAR(estimator.GetEstimation(), exact, exact * 0.05);
+
+    std::uniform_real_distribution<double> uniform(0, 100);
+    estimator.SetQuantile(0.5);
+    samples.clear();
+
+    for (int32_t i = 0; i < 20000; i++)
+    {
+        samples.push_back(uniform(generator));
+        estimator.Add(samples.back());
+    }
+
+    EXPECT_NEAR(estimator.GetEstimation(), getExactQuantile(samples, 0.5), 2);
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <RtpHeaderExtensionRegistry.h>
+#include <string.h>
+
+class RtpHeaderExtensionRegistryTest : public ::testing::Test
+{
+public:
+    RtpHeaderExtensionRegistry registry;
+
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+};
+
+TEST_F(RtpHeaderExtensionRegistryTest, RegisterTest)
+{
+    EXPECT_FALSE(registry.Register(kRtpHeaderExtensionCvo, 0));
+    EXPECT_FALSE(registry.Register(kRtpHeaderExtensionMax, 1));
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionCvo, 1));
+    EXPECT_FALSE(registry.Register(kRtpHeaderExtensionAudioLevel, 1));
+    EXPECT_EQ(registry.GetId(kRtpHeaderExtensionCvo), 1);
+    EXPECT_EQ(registry.GetType(1), kRtpHeaderExtensionCvo);
+
+    // move to other id
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionCvo, 3));
+    EXPECT_EQ(registry.GetType(1), kRtpHeaderExtensionMax);
+    EXPECT_EQ(registry.GetType(3), kRtpHeaderExtensionCvo);
+
+    registry.Clear();
+    EXPECT_EQ(registry.GetId(kRtpHeaderExtensionCvo), 0);
+    EXPECT_FALSE(registry.Compile());
+    EXPECT_EQ(registry.GetTemplate(), nullptr);
+}
+
+TEST_F(RtpHeaderExtensionRegistryTest, CompileOneByteHeaderTest)
+{
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionCvo, 1));
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionTransportSeq, 5));
+    EXPECT_FALSE(registry.SetValue(kRtpHeaderExtensionCvo, 0x0B));
+    EXPECT_TRUE(registry.Compile());
+
+    RtpHeaderExtensionInfo* info = registry.GetTemplate();
+    ASSERT_TRUE(info != nullptr);
+    EXPECT_EQ(info->definedByProfile, RtpHeaderExtensionInfo::kBitPatternForOneByteHeader);
+    EXPECT_EQ(info->length, 2);
+    EXPECT_EQ(info->extensionDataSize, 8);
+
+    EXPECT_TRUE(registry.SetValue(kRtpHeaderExtensionCvo, 0x0B));
+    EXPECT_TRUE(registry.SetValue(kRtpHeaderExtensionTransportSeq, 0x1234));
+    EXPECT_FALSE(registry.SetValue(kRtpHeaderExtensionAudioLevel, 0x10));
+
+    const uint8_t expected[] = {0x10, 0x0B, 0x51, 0x12, 0x34, 0x00, 0x00, 0x00};
+    EXPECT_EQ(memcmp(info->extensionData, expected, sizeof(expected)), 0);
+
+    // patched in place
+    EXPECT_TRUE(registry.SetValue(kRtpHeaderExtensionTransportSeq, 0x1235));
+    EXPECT_EQ(registry.GetTemplate(), info);
+    EXPECT_EQ(static_cast<uint8_t>(info->extensionData[4]), 0x35);
+}
+
+TEST_F(RtpHeaderExtensionRegistryTest, CompileTwoByteHeaderTest)
+{
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionAudioLevel, 20));
+    EXPECT_TRUE(registry.Compile());
+    EXPECT_TRUE(registry.SetValue(kRtpHeaderExtensionAudioLevel, 0x85));
+
+    RtpHeaderExtensionInfo* info = registry.GetTemplate();
+    ASSERT_TRUE(info != nullptr);
+    EXPECT_EQ(info->definedByProfile, RtpHeaderExtensionInfo::kBitPatternForTwoByteHeader);
+    EXPECT_EQ(info->length, 1);
+
+    const uint8_t expected[] = {20, 0x01, 0x85, 0x00};
+    EXPECT_EQ(memcmp(info->extensionData, expected, sizeof(expected)), 0);
+}
+
+TEST_F(RtpHeaderExtensionRegistryTest, ParseTest)
+{
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionCvo, 1));
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionAudioLevel, 2));
+    EXPECT_TRUE(registry.Register(kRtpHeaderExtensionTransportSeq, 3));
+    EXPECT_TRUE(registry.Compile());
+    EXPECT_TRUE(registry.SetValue(kRtpHeaderExtensionCvo, 0x03));
+    EXPECT_TRUE(registry.SetValue(kRtpHeaderExtensionTransportSeq, 0xABCD));
+
+    RtpHeaderExtensionView views[RtpHeaderExtensionRegistry::kMaxViews];
+    int32_t numViews = RtpHeaderExtensionRegistry::Parse(
+            *registry.GetTemplate(), views, RtpHeaderExtensionRegistry::kMaxViews);
+    EXPECT_EQ(numViews, 3);
+
+    const RtpHeaderExtensionView* view =
+            registry.Find(kRtpHeaderExtensionTransportSeq, views, numViews);
+    ASSERT_TRUE(view != nullptr);
+    EXPECT_EQ(view->size, 2);
+    EXPECT_EQ(view->data[0], 0xAB);
+    EXPECT_EQ(view->data[1], 0xCD);
+
+    view = registry.Find(kRtpHeaderExtensionCvo, views, numViews);
+    ASSERT_TRUE(view != nullptr);
+    EXPECT_EQ(view->size, 1);
+    EXPECT_EQ(view->data[0], 0x03);
+
+    // the views point into the extension data
+    EXPECT_EQ(view->data, reinterpret_cast<uint8_t*>(registry.GetTemplate()->extensionData) + 1);
+
+    // the number of views is limited
+    EXPECT_EQ(RtpHeaderExtensionRegistry::Parse(*registry.GetTemplate(), views, 1), 1);
+}
+
+TEST_F(RtpHeaderExtensionRegistryTest, ParseInvalidTest)
+{
+    RtpHeaderExtensionView views[RtpHeaderExtensionRegistry::kMaxViews];
+
+    // the length of the element exceeds the block
+    int8_t overflow[] = {0x13, 0x01, 0x00, 0x00};
+    RtpHeaderExtensionInfo info(
+            RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, 1, overflow, sizeof(overflow));
+    EXPECT_EQ(RtpHeaderExtensionRegistry::Parse(info, views, RtpHeaderExtensionRegistry::kMaxViews),
+            -1);
+
+    // not a RFC 8285 block
+    info.definedByProfile = 0x1234;
+    EXPECT_EQ(RtpHeaderExtensionRegistry::Parse(info, views, RtpHeaderExtensionRegistry::kMaxViews),
+            0);
+
+    // the identifier 15 stops the parsing
+    int8_t stop[] = {0x10, 0x01, static_cast<int8_t>(0xF0), 0x20};
+    info = RtpHeaderExtensionInfo(
+            RtpHeaderExtensionInfo::kBitPatternForOneByteHeader, 1, stop, sizeof(stop));
+    EXPECT_EQ(RtpHeaderExtensionRegistry::Parse(info, views, RtpHeaderExtensionRegistry::kMaxViews),
+            1);
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <RtpPacketHistory.h>
+#include <string.h>
+
+class RtpPacketHistoryTest : public ::testing::Test
+{
+public:
+    RtpPacketHistory history;
+    uint8_t packet[20];
+
+protected:
+    virtual void SetUp() override
+    {
+        memset(packet, 0, sizeof(packet));
+        packet[0] = 0x80;
+    }
+
+    virtual void TearDown() override {}
+
+    void addPacket(uint16_t seqNum, uint32_t sentTime)
+    {
+        packet[2] = seqNum >> 8;
+        packet[3] = seqNum & 0xff;
+        history.Add(packet, sizeof(packet), sentTime);
+    }
+};
+
+TEST_F(RtpPacketHistoryTest, RetransmitTest)
+{
+    uint32_t size = 0;
+    EXPECT_EQ(history.GetPacketToRetransmit(10, 100, 50, &size), nullptr);
+
+    addPacket(10, 100);
+    const uint8_t* data = history.GetPacketToRetransmit(10, 120, 50, &size);
+    ASSERT_NE(data, nullptr);
+    EXPECT_EQ(size, sizeof(packet));
+    EXPECT_EQ(data[3], 10);
+
+    // not again within the interval
+    EXPECT_EQ(history.GetPacketToRetransmit(10, 160, 50, &size), nullptr);
+    EXPECT_NE(history.GetPacketToRetransmit(10, 170, 50, &size), nullptr);
+    EXPECT_EQ(history.GetNumRetransmitted(), 2);
+
+    // too old
+    EXPECT_EQ(history.GetPacketToRetransmit(10, 100 + RtpPacketHistory::kMaxPacketAge + 1, 50,
+                      &size),
+            nullptr);
+
+    history.Reset();
+    EXPECT_EQ(history.GetPacketToRetransmit(10, 120, 50, &size), nullptr);
+    EXPECT_EQ(history.GetNumRetransmitted(), 0);
+}
+
+TEST_F(RtpPacketHistoryTest, OverwriteTest)
+{
+    uint32_t size = 0;
+    uint16_t seqNum = 65535 - RtpPacketHistory::kMaxHistorySize / 2;
+
+    for (uint32_t i = 0; i <= RtpPacketHistory::kMaxHistorySize; i++)
+    {
+        addPacket(seqNum + i, 100);
+    }
+
+    // the oldest one is overwritten across the wrap around
+    EXPECT_EQ(history.GetPacketToRetransmit(seqNum, 100, 0, &size), nullptr);
+    EXPECT_NE(history.GetPacketToRetransmit(seqNum + 1, 100, 0, &size), nullptr);
+    EXPECT_NE(history.GetPacketToRetransmit(0, 100, 0, &size), nullptr);
+
+    // the packet shorter than the rtp header is not kept
+    history.Add(packet, 8, 100);
+    EXPECT_EQ(history.GetNumRetransmitted(), 2);
+}
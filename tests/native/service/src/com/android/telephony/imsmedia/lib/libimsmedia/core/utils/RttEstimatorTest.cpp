@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <RttEstimator.h>
+
+class RttEstimatorTest : public ::testing::Test
+{
+public:
+    RttEstimator estimator;
+
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+};
+
+TEST_F(RttEstimatorTest, FirstSampleTest)
+{
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 0);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(66), 0);
+
+    estimator.Update(200);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 200);
+    EXPECT_EQ(estimator.GetRttVariation(), 100);
+    EXPECT_EQ(estimator.GetLatestRtt(), 200);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(66), 600);
+
+    estimator.Reset();
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 0);
+    EXPECT_EQ(estimator.GetLatestRtt(), 0);
+}
+
+TEST_F(RttEstimatorTest, SmoothingTest)
+{
+    estimator.Update(100);
+
+    // srtt = 7/8 * 100 + 1/8 * 180, rttvar = 3/4 * 50 + 1/4 * 80
+    estimator.Update(180);
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 110);
+    EXPECT_EQ(estimator.GetRttVariation(), 57);
+    EXPECT_EQ(estimator.GetLatestRtt(), 180);
+
+    // the stable samples converge and the variation decays to the granularity
+    for (int32_t i = 0; i < 100; i++)
+    {
+        estimator.Update(150);
+    }
+
+    EXPECT_EQ(estimator.GetSmoothedRtt(), 149);
+    EXPECT_LE(estimator.GetRttVariation(), 1);
+    EXPECT_EQ(estimator.GetRetransmissionTimeout(66), 149 + 66);
+}
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include <gtest/gtest.h>
+#include <SlidingWindowStatistics.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <random>
+
+class SlidingWindowStatisticsTest : public ::testing::Test
+{
+public:
+    SlidingWindowStatisticsTest() :
+            stats(kWindowSize)
+    {
+    }
+
+    enum
+    {
+        kWindowSize = 50,
+    };
+
+    SlidingWindowStatistics stats;
+    std::deque<int32_t> window;
+
+protected:
+    virtual void SetUp() override {}
+    virtual void TearDown() override {}
+
+    void add(int32_t value)
+    {
+        stats.Add(value);
+        window.push_back(value);
+
+        if (window.size() > kWindowSize)
+        {
+            window.pop_front();
+        }
+    }
+
+    void verify()
+    {
+        double mean = 0;
+
+        for (int32_t value : window)
+        {
+            mean += value;
+        }
+
+        mean /= window.size();
+        double variance = 0;
+
+        for (int32_t value : window)
+        {
+            variance += (value - mean) * (value - mean);
+        }
+
+        ASSERT_EQ(stats.GetCount(), window.size());
+        EXPECT_NEAR(stats.GetMean(), mean, 1e-6);
+        EXPECT_NEAR(stats.GetDeviation(), sqrt(variance / window.size()), 1e-6);
+        EXPECT_EQ(stats.GetMax(), *std::max_element(window.begin(), window.end()));
+    }
+};
+
+TEST_F(SlidingWindowStatisticsTest, EmptyTest)
+{
+    EXPECT_EQ(stats.GetCount(), 0);
+    EXPECT_EQ(stats.GetMean(), 0);
+    EXPECT_EQ(stats.GetDeviation(), 0);
+    EXPECT_EQ(stats.GetMax(), 0);
+
+    add(-30);
+    verify();
+
+    stats.Reset();
+    EXPECT_EQ(stats.GetCount(), 0);
+    EXPECT_EQ(stats.GetMax(), 0);
+}
+
+TEST_F(SlidingWindowStatisticsTest, WindowEvictionTest)
+{
+    // the maximum leaves the window
+    add(500);
+
+    for (int32_t i = 0; i < kWindowSize - 1; i++)
+    {
+        add(i % 7);
+    }
+
+    EXPECT_EQ(stats.GetMax(), 500);
+    add(3);
+    EXPECT_EQ(stats.GetMax(), 6);
+    verify();
+
+    // the constant jitter has no deviation
+    for (int32_t i = 0; i < kWindowSize; i++)
+    {
+        add(20);
+    }
+
+    EXPECT_NEAR(stats.GetMean(), 20, 1e-6);
+    EXPECT_NEAR(stats.GetDeviation(), 0, 1e-3);
+    EXPECT_EQ(stats.GetMax(), 20);
+}
+
+TEST_F(SlidingWindowStatisticsTest, RandomEquivalenceTest)
+{
+    std::mt19937 generator(7);
+    std::normal_distribution<double> jitter(30, 40);
+
+    for (int32_t i = 0; i < 100000; i++)
+    {
+        add(static_cast<int32_t>(jitter(generator)));
+
+        if (i % 997 == 0)
+        {
+            verify();
+        }
+    }
+
+    verify();
+}
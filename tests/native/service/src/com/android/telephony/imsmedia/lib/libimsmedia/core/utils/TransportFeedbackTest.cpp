@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <TransportFeedback.h>
+
+class TransportFeedbackTest : public ::testing::Test
+{
+public:
+    TransportFeedback feedback;
+    TransportFeedbackResult result;
+    uint8_t buffer[TransportFeedback::kMaxFciSize];
+
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+};
+
+TEST_F(TransportFeedbackTest, BuildAndParseTest)
+{
+    EXPECT_EQ(feedback.Build(buffer, sizeof(buffer)), 0);
+
+    feedback.OnPacketReceived(10, 1000);
+    feedback.OnPacketReceived(11, 1005);
+    feedback.OnPacketReceived(13, 1030);
+    feedback.OnPacketReceived(14, 1031);
+    EXPECT_EQ(feedback.GetNumPendingPackets(), 4);
+
+    uint32_t size = feedback.Build(buffer, sizeof(buffer));
+    EXPECT_GT(size, 0);
+    EXPECT_EQ(size % 4, 0);
+    EXPECT_EQ(feedback.GetNumPendingPackets(), 0);
+
+    ASSERT_TRUE(TransportFeedback::Parse(buffer, size, &result));
+    EXPECT_EQ(result.feedbackCount, 0);
+    ASSERT_EQ(result.packets.size(), 5);
+
+    const bool expectedReceived[] = {true, true, false, true, true};
+    const int64_t expectedArrival[] = {1000000, 1005000, 0, 1030000, 1031000};
+
+    for (uint32_t i = 0; i < result.packets.size(); i++)
+    {
+        EXPECT_EQ(result.packets[i].seqNum, 10 + i);
+        EXPECT_EQ(result.packets[i].received, expectedReceived[i]);
+        EXPECT_EQ(result.packets[i].sendTimeMs, -1);
+
+        if (expectedReceived[i])
+        {
+            EXPECT_EQ(result.packets[i].arrivalTimeUs, expectedArrival[i]);
+        }
+    }
+}
+
+TEST_F(TransportFeedbackTest, LargeAndNegativeDeltaTest)
+{
+    // the packets arrive in reverse order with the large interval
+    feedback.OnPacketReceived(1, 2000);
+    feedback.OnPacketReceived(0, 2100);
+
+    uint32_t size = feedback.Build(buffer, sizeof(buffer));
+    ASSERT_TRUE(TransportFeedback::Parse(buffer, size, &result));
+    ASSERT_EQ(result.packets.size(), 2);
+    EXPECT_TRUE(result.packets[0].received);
+    EXPECT_TRUE(result.packets[1].received);
+    EXPECT_EQ(result.packets[0].arrivalTimeUs, 2100000);
+    EXPECT_EQ(result.packets[1].arrivalTimeUs, 2000000);
+}
+
+TEST_F(TransportFeedbackTest, ReportLossAfterLastFeedbackTest)
+{
+    feedback.OnPacketReceived(0, 100);
+    feedback.OnPacketReceived(1, 120);
+    EXPECT_GT(feedback.Build(buffer, sizeof(buffer)), 0);
+
+    // the late packet already reported as lost is ignored
+    feedback.OnPacketReceived(4, 200);
+    feedback.OnPacketReceived(1, 210);
+    EXPECT_EQ(feedback.GetNumPendingPackets(), 1);
+
+    uint32_t size = feedback.Build(buffer, sizeof(buffer));
+    ASSERT_TRUE(TransportFeedback::Parse(buffer, size, &result));
+    EXPECT_EQ(result.feedbackCount, 1);
+    ASSERT_EQ(result.packets.size(), 3);
+    EXPECT_EQ(result.packets[0].seqNum, 2);
+    EXPECT_FALSE(result.packets[0].received);
+    EXPECT_FALSE(result.packets[1].received);
+    EXPECT_TRUE(result.packets[2].received);
+}
+
+TEST_F(TransportFeedbackTest, WrapAroundTest)
+{
+    feedback.OnPacketReceived(65534, 0);
+    feedback.OnPacketReceived(65535, 1);
+    feedback.OnPacketReceived(0, 2);
+    feedback.OnPacketReceived(1, 3);
+
+    uint32_t size = feedback.Build(buffer, sizeof(buffer));
+    ASSERT_TRUE(TransportFeedback::Parse(buffer, size, &result));
+    ASSERT_EQ(result.packets.size(), 4);
+    EXPECT_EQ(result.packets[0].seqNum, 65534);
+    EXPECT_EQ(result.packets[3].seqNum, 1);
+    EXPECT_EQ(result.packets[3].arrivalTimeUs - result.packets[0].arrivalTimeUs, 3000);
+}
+
+TEST_F(TransportFeedbackTest, MaxStatusCountTest)
+{
+    const uint32_t kNumPackets = TransportFeedback::kMaxStatusCount + 10;
+
+    for (uint32_t i = 0; i < kNumPackets; i++)
+    {
+        feedback.OnPacketReceived(i, i * 20);
+    }
+
+    uint32_t size = feedback.Build(buffer, sizeof(buffer));
+    ASSERT_TRUE(TransportFeedback::Parse(buffer, size, &result));
+    EXPECT_EQ(result.packets.size(), TransportFeedback::kMaxStatusCount);
+    EXPECT_EQ(feedback.GetNumPendingPackets(), 10);
+
+    size = feedback.Build(buffer, sizeof(buffer));
+    ASSERT_TRUE(TransportFeedback::Parse(buffer, size, &result));
+    ASSERT_EQ(result.packets.size(), 10);
+    EXPECT_EQ(result.packets[0].seqNum, TransportFeedback::kMaxStatusCount);
+
+    // the buffer is not enough
+    feedback.OnPacketReceived(kNumPackets, 5000);
+    EXPECT_EQ(feedback.Build(buffer, 8), 0);
+}
+
+TEST_F(TransportFeedbackTest, ParseRunLengthAndOneBitChunkTest)
+{
+    const uint8_t fci[] = {
+            0x00, 0x64,  // base sequence number 100
+            0x00, 0x14,  // packet status count 20
+            0x00, 0x00, 0x01,  // reference time 64 ms
+            0x07,              // feedback packet count
+            0x20, 0x0E,  // run length chunk, 14 small deltas
+            0xA8, 0x00,  // one bit status vector chunk, received, lost, received
+            0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,  // 1 ms deltas
+            0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04,
+    };
+
+    ASSERT_TRUE(TransportFeedback::Parse(fci, sizeof(fci), &result));
+    EXPECT_EQ(result.feedbackCount, 7);
+    ASSERT_EQ(result.packets.size(), 20);
+    EXPECT_EQ(result.packets[0].seqNum, 100);
+    EXPECT_EQ(result.packets[0].arrivalTimeUs, 65000);
+    EXPECT_TRUE(result.packets[14].received);
+    EXPECT_FALSE(result.packets[15].received);
+    EXPECT_TRUE(result.packets[16].received);
+    EXPECT_EQ(result.packets[16].arrivalTimeUs, 80000);
+    EXPECT_FALSE(result.packets[19].received);
+
+    // the deltas are truncated
+    EXPECT_FALSE(TransportFeedback::Parse(fci, sizeof(fci) - 1, &result));
+    // the chunks are truncated
+    EXPECT_FALSE(TransportFeedback::Parse(fci, 10, &result));
+    EXPECT_FALSE(TransportFeedback::Parse(fci, 4, &result));
+    EXPECT_FALSE(TransportFeedback::Parse(nullptr, sizeof(fci), &result));
+}
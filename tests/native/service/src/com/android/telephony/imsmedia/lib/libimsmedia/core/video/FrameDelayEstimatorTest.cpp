@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <FrameDelayEstimator.h>
+#include <random>
+
+#define TEST_FRAME_INTERVAL 66
+#define TEST_TS_INTERVAL    5940  // 66 ms in 90 kHz
+#define TEST_FRAME_SIZE     1000
+
+class FrameDelayEstimatorTest : public ::testing::Test
+{
+public:
+    FrameDelayEstimator estimator;
+
+protected:
+    virtual void SetUp() override { estimator.SetDelayRange(0, 500); }
+
+    virtual void TearDown() override {}
+
+    // updates the frames sent at the interval and delayed by the random jitter up to maxJitter
+    void updateFrames(uint32_t* timestamp, uint32_t* sendTime, uint32_t numFrames,
+            uint32_t maxJitter, std::mt19937* random)
+    {
+        std::uniform_int_distribution<uint32_t> jitter(0, maxJitter);
+
+        for (uint32_t i = 0; i < numFrames; i++)
+        {
+            estimator.Update(*timestamp, *sendTime + 100 + jitter(*random), TEST_FRAME_SIZE);
+            *timestamp += TEST_TS_INTERVAL;
+            *sendTime += TEST_FRAME_INTERVAL;
+        }
+    }
+};
+
+TEST_F(FrameDelayEstimatorTest, ConstantDelayTest)
+{
+    EXPECT_FALSE(estimator.IsReady());
+    EXPECT_EQ(estimator.GetRenderTime(0), 0);
+
+    estimator.SetDelayRange(40, 500);
+    uint32_t timestamp = 0;
+    uint32_t sendTime = 1000;
+    std::mt19937 random(1);
+    updateFrames(&timestamp, &sendTime, 100, 0, &random);
+
+    // the frames arriving in time are rendered at the minimum delay after the arrival
+    EXPECT_TRUE(estimator.IsReady());
+    EXPECT_LT(estimator.GetJitter(), 10);
+    EXPECT_EQ(estimator.GetTargetDelay(), 40);
+    EXPECT_EQ(estimator.GetRenderTime(timestamp), sendTime + 100 + 40);
+
+    estimator.Reset();
+    EXPECT_FALSE(estimator.IsReady());
+}
+
+TEST_F(FrameDelayEstimatorTest, JitterTest)
+{
+    uint32_t timestamp = 0;
+    uint32_t sendTime = 1000;
+    std::mt19937 random(1);
+    updateFrames(&timestamp, &sendTime, 50, 0, &random);
+    uint32_t calmDelay = estimator.GetTargetDelay();
+
+    // the target covers the most of the jitter
+    updateFrames(&timestamp, &sendTime, 300, 60, &random);
+    uint32_t jitterDelay = estimator.GetTargetDelay();
+    EXPECT_GT(jitterDelay, calmDelay + 30);
+    EXPECT_LT(jitterDelay, 150);
+
+    // the delay goes down slowly when the network becomes calm
+    updateFrames(&timestamp, &sendTime, 5, 0, &random);
+    EXPECT_GT(estimator.GetTargetDelay(), jitterDelay / 2);
+    updateFrames(&timestamp, &sendTime, 1000, 0, &random);
+    EXPECT_LT(estimator.GetTargetDelay(), jitterDelay / 2);
+
+    // limited by the range
+    estimator.SetDelayRange(0, 20);
+    updateFrames(&timestamp, &sendTime, 300, 60, &random);
+    EXPECT_EQ(estimator.GetTargetDelay(), 20);
+}
+
+TEST_F(FrameDelayEstimatorTest, FrameSizeTest)
+{
+    const double kBytesPerMs = 50;
+    uint32_t timestamp = 0;
+    uint32_t sendTime = 1000;
+
+    // the key frame of every second takes the time to send in the channel
+    for (uint32_t i = 0; i < 600; i++)
+    {
+        uint32_t size = (i % 15 == 0) ? TEST_FRAME_SIZE * 4 : TEST_FRAME_SIZE;
+        estimator.Update(timestamp, sendTime + size / kBytesPerMs, size);
+        timestamp += TEST_TS_INTERVAL;
+        sendTime += TEST_FRAME_INTERVAL;
+    }
+
+    // the jitter is the time to send the key frame over the average one
+    uint32_t expected = TEST_FRAME_SIZE * 3 / kBytesPerMs;
+    EXPECT_GT(estimator.GetJitter(), expected / 2);
+    EXPECT_LT(estimator.GetJitter(), expected * 2);
+}
+
+TEST_F(FrameDelayEstimatorTest, WrapAroundTest)
+{
+    uint32_t timestamp = 0xffffffff - TEST_TS_INTERVAL * 10;
+    uint32_t sendTime = 0xffffffff - TEST_FRAME_INTERVAL * 5;
+    std::mt19937 random(1);
+    updateFrames(&timestamp, &sendTime, 20, 0, &random);
+
+    // the render time follows the timestamp across the wrap around of the both
+    uint32_t renderTime = estimator.GetRenderTime(timestamp);
+    EXPECT_EQ(estimator.GetRenderTime(timestamp + TEST_TS_INTERVAL) - renderTime,
+            TEST_TS_INTERVAL / 90);
+    EXPECT_EQ(renderTime, sendTime + 100 + estimator.GetTargetDelay());
+
+    // the reordered frame does not change the estimation
+    estimator.Update(timestamp - TEST_TS_INTERVAL * 3, sendTime + 500, TEST_FRAME_SIZE);
+    EXPECT_EQ(estimator.GetRenderTime(timestamp), renderTime);
+}
@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <LostPacketTracker.h>
+#include <chrono>
+#include <string>
+
+#define TEST_WAIT_TIME  66
+#define TEST_RETRY_TIME 100
+
+class LostPacketTrackerTest : public ::testing::Test
+{
+public:
+    LostPacketTracker tracker;
+    std::vector<NackParams> nacks;
+    bool pictureLost;
+
+protected:
+    virtual void SetUp() override { pictureLost = false; }
+    virtual void TearDown() override {}
+
+    uint32_t getRequests(uint32_t time)
+    {
+        return tracker.GetNackRequests(
+                time, TEST_WAIT_TIME, TEST_RETRY_TIME, &nacks, &pictureLost);
+    }
+};
+
+TEST_F(LostPacketTrackerTest, LossAndRecoveryTest)
+{
+    EXPECT_EQ(tracker.OnPacketReceived(10, 0), 0);
+    EXPECT_EQ(tracker.OnPacketReceived(13, 0), 2);
+    EXPECT_TRUE(tracker.IsLost(11));
+    EXPECT_TRUE(tracker.IsLost(12));
+    EXPECT_FALSE(tracker.IsLost(13));
+    EXPECT_EQ(tracker.GetNumLost(), 2);
+
+    // the reordered packet is not lost any more
+    EXPECT_EQ(tracker.OnPacketReceived(11, 0), 0);
+    EXPECT_FALSE(tracker.IsLost(11));
+    EXPECT_EQ(tracker.GetNumLost(), 1);
+
+    // the played packets are not tracked
+    tracker.RemoveOlderThan(13);
+    EXPECT_FALSE(tracker.IsLost(12));
+    EXPECT_EQ(tracker.GetNumLost(), 0);
+
+    tracker.Reset();
+    EXPECT_EQ(tracker.OnPacketReceived(100, 0), 0);
+    EXPECT_EQ(tracker.GetNumLost(), 0);
+}
+
+TEST_F(LostPacketTrackerTest, WrapAroundTest)
+{
+    tracker.OnPacketReceived(65533, 0);
+    EXPECT_EQ(tracker.OnPacketReceived(2, 0), 4);
+    EXPECT_TRUE(tracker.IsLost(65535));
+    EXPECT_TRUE(tracker.IsLost(0));
+
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME), 4);
+    ASSERT_EQ(nacks.size(), 1);
+    EXPECT_EQ(nacks[0].PID, 65534);
+    EXPECT_EQ(nacks[0].BLP, 0x7);
+}
+
+TEST_F(LostPacketTrackerTest, WindowTest)
+{
+    tracker.OnPacketReceived(0, 0);
+    tracker.OnPacketReceived(2, 0);
+    EXPECT_TRUE(tracker.IsLost(1));
+
+    // the old packets move out of the window
+    for (uint32_t seq = 3; seq <= LostPacketTracker::kWindowSize; seq++)
+    {
+        tracker.OnPacketReceived(seq, 0);
+    }
+
+    EXPECT_TRUE(tracker.IsLost(1));
+    tracker.OnPacketReceived(LostPacketTracker::kWindowSize + 1, 0);
+    EXPECT_FALSE(tracker.IsLost(1));
+    EXPECT_EQ(tracker.GetNumLost(), 0);
+
+    // the large gap is the restart of the stream
+    uint16_t seq = LostPacketTracker::kWindowSize + 2 + LostPacketTracker::kMaxLossGap;
+    EXPECT_EQ(tracker.OnPacketReceived(seq, 0), 0);
+    EXPECT_EQ(tracker.GetNumLost(), 0);
+}
+
+TEST_F(LostPacketTrackerTest, RetryTest)
+{
+    tracker.OnPacketReceived(0, 0);
+    tracker.OnPacketReceived(2, 0);
+
+    // wait for the reordered packet
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME - 1), 0);
+    EXPECT_TRUE(nacks.empty());
+
+    EXPECT_FALSE(tracker.IsRequested(1));
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME), 1);
+    ASSERT_EQ(nacks.size(), 1);
+    EXPECT_EQ(nacks[0].PID, 1);
+    EXPECT_EQ(nacks[0].nSecNackCnt, 0);
+    EXPECT_TRUE(nacks[0].bNackReport);
+    EXPECT_TRUE(tracker.IsRequested(1));
+
+    // wait for the retransmission
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME + TEST_RETRY_TIME - 1), 0);
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME + TEST_RETRY_TIME), 1);
+    ASSERT_EQ(nacks.size(), 1);
+    EXPECT_EQ(nacks[0].nSecNackCnt, 1);
+    EXPECT_FALSE(pictureLost);
+
+    // the picture loss is requested once
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME + TEST_RETRY_TIME * 2), 0);
+    EXPECT_TRUE(pictureLost);
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME + TEST_RETRY_TIME * 3), 0);
+    EXPECT_FALSE(pictureLost);
+}
+
+TEST_F(LostPacketTrackerTest, PackingTest)
+{
+    // the lost packets 1, 3, 20, 21 and 40
+    tracker.OnPacketReceived(0, 0);
+    tracker.OnPacketReceived(2, 0);
+    tracker.OnPacketReceived(19, 0);
+
+    for (uint16_t seq = 4; seq < 19; seq++)
+    {
+        tracker.OnPacketReceived(seq, 0);
+    }
+
+    tracker.OnPacketReceived(22, 0);
+    tracker.OnPacketReceived(41, 0);
+
+    for (uint16_t seq = 23; seq < 40; seq++)
+    {
+        tracker.OnPacketReceived(seq, 0);
+    }
+
+    EXPECT_EQ(tracker.GetNumLost(), 5);
+    EXPECT_EQ(getRequests(TEST_WAIT_TIME), 5);
+    ASSERT_EQ(nacks.size(), 3);
+    EXPECT_EQ(nacks[0].PID, 1);
+    EXPECT_EQ(nacks[0].BLP, 1 << 1);
+    EXPECT_EQ(nacks[1].PID, 20);
+    EXPECT_EQ(nacks[1].BLP, 1 << 0);
+    EXPECT_EQ(nacks[2].PID, 40);
+    EXPECT_EQ(nacks[2].BLP, 0);
+}
+
+/**
+ * Microbenchmark of the loss tracking and the NACK generation in the burst loss of 10 packets in
+ * every 100 packets, the requests are collected at every packet received.
+ */
+TEST_F(LostPacketTrackerTest, BurstLossCostTest)
+{
+    const uint32_t kNumPackets = 200000;
+    uint32_t numRequested = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < kNumPackets; i++)
+    {
+        if (i % 100 >= 90)
+        {
+            continue;
+        }
+
+        tracker.OnPacketReceived(i, i);
+        numRequested += getRequests(i);
+        tracker.RemoveOlderThan(i - 200);
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+                           .count();
+
+    EXPECT_GT(numRequested, 0);
+    RecordProperty("LostPacketTrackerNsPerPacket", std::to_string(elapsed / kNumPackets));
+}
@@ -0,0 +1,385 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <gtest/gtest.h>
+#include <VideoJitterBuffer.h>
+#include <chrono>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#define TEST_FRAME_INTERVAL 66
+#define TEST_TS_INTERVAL    6000
+
+class VideoJitterBufferCallback : public BaseSessionCallback
+{
+public:
+    VideoJitterBufferCallback()
+    {
+        numNack = 0;
+        numPictureLost = 0;
+    }
+    virtual ~VideoJitterBufferCallback() {}
+
+    virtual void onEvent(int32_t type, uint64_t param1, uint64_t param2)
+    {
+        if (type == kRequestVideoSendNack)
+        {
+            NackParams* params = reinterpret_cast<NackParams*>(param1);
+            numNack++;
+            lastNacks.assign(params, params + param2);
+            delete[] params;
+        }
+        else if (type == kRequestVideoSendPictureLost || type == kRequestVideoSendTmmbr)
+        {
+            if (type == kRequestVideoSendPictureLost)
+            {
+                numPictureLost++;
+            }
+
+            delete reinterpret_cast<InternalRequestEventParam*>(param1);
+        }
+    }
+
+    int32_t numNack;
+    int32_t numPictureLost;
+    std::vector<NackParams> lastNacks;
+};
+
+class VideoJitterBufferTest : public ::testing::Test
+{
+public:
+    VideoJitterBufferTest() {}
+    virtual ~VideoJitterBufferTest() {}
+
+protected:
+    VideoJitterBuffer* mJitterBuffer;
+    VideoJitterBufferCallback mCallback;
+    uint8_t mHeader[20];
+    uint8_t mFragment[20];
+    uint32_t mCurrentTime;
+
+    virtual void SetUp() override
+    {
+        memset(mHeader, 0, sizeof(mHeader));
+        mHeader[3] = 0x01;
+        memset(mFragment, 0x7c, sizeof(mFragment));
+        mCurrentTime = 0;
+
+        mJitterBuffer = new VideoJitterBuffer();
+        mJitterBuffer->SetCodecType(kVideoCodecAvc);
+        mJitterBuffer->SetSessionCallback(&mCallback);
+        mJitterBuffer->SetFramerate(15);
+        // keeps 4 frames at most and starts to play with 2 frames
+        mJitterBuffer->SetJitterBufferSize(10, 10, 15);
+    }
+
+    virtual void TearDown() override { delete mJitterBuffer; }
+
+    void addPacket(uint16_t seq, uint32_t timestamp, bool header, bool mark,
+            ImsMediaSubType type = MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, uint32_t arrivalTime = 0)
+    {
+        mJitterBuffer->Add(MEDIASUBTYPE_UNDEFINED, header ? mHeader : mFragment,
+                header ? sizeof(mHeader) : sizeof(mFragment), timestamp, mark, seq, type,
+                arrivalTime);
+    }
+
+    // adds the packets of the frame from the header to the marker in the order given
+    void addFrame(uint16_t firstSeq, uint32_t numPackets, uint32_t timestamp,
+            const std::vector<uint32_t>& order, ImsMediaSubType type)
+    {
+        for (uint32_t i : order)
+        {
+            addPacket(firstSeq + i, timestamp, i == 0, i == numPackets - 1, type);
+        }
+    }
+
+    // gets and deletes the packets playable now, returns the sequence numbers in the order
+    std::vector<uint16_t> getPackets()
+    {
+        std::vector<uint16_t> seqs;
+        uint32_t seq = 0;
+
+        while (mJitterBuffer->Get(
+                nullptr, nullptr, nullptr, nullptr, nullptr, &seq, mCurrentTime))
+        {
+            seqs.push_back(seq);
+            mJitterBuffer->Delete();
+        }
+
+        return seqs;
+    }
+
+    // plays the frames sent at the interval and delayed by the random jitter, the buffer is
+    // checked every 5 ms. Returns the number of the stutters, the gaps between the frames played
+    // longer than one and a half of the interval, and the average delay from the sending.
+    uint32_t playJitteryFrames(bool withArrivalTime, uint32_t maxJitter, uint32_t* avgDelay)
+    {
+        const uint32_t kNumFrames = 1000;
+        std::mt19937 random(1);
+        std::uniform_int_distribution<uint32_t> jitter(0, maxJitter);
+        std::multimap<uint32_t, uint16_t> arrivals;
+
+        for (uint16_t i = 0; i < kNumFrames; i++)
+        {
+            arrivals.emplace(1000 + i * TEST_TS_INTERVAL / 90 + jitter(random), i);
+        }
+
+        uint32_t numStutters = 0;
+        uint32_t numPlayed = 0;
+        uint32_t lastPlayedTime = 0;
+        uint64_t sumDelay = 0;
+
+        for (mCurrentTime = 1000; numPlayed < kNumFrames - 1; mCurrentTime += 5)
+        {
+            while (!arrivals.empty() && arrivals.begin()->first <= mCurrentTime)
+            {
+                uint16_t seq = arrivals.begin()->second;
+                addPacket(seq, seq * TEST_TS_INTERVAL, true, true,
+                        seq == 0 ? MEDIASUBTYPE_VIDEO_IDR_FRAME : MEDIASUBTYPE_VIDEO_NON_IDR_FRAME,
+                        withArrivalTime ? arrivals.begin()->first : 0);
+                arrivals.erase(arrivals.begin());
+            }
+
+            for (uint16_t seq : getPackets())
+            {
+                // the renderer holds the frame decoded until the render time
+                uint32_t playedTime = mCurrentTime;
+                uint32_t renderTime = mJitterBuffer->GetRenderTime(seq * TEST_TS_INTERVAL);
+
+                if (renderTime > playedTime)
+                {
+                    playedTime = renderTime;
+                }
+
+                if (lastPlayedTime != 0 &&
+                        playedTime - lastPlayedTime > TEST_FRAME_INTERVAL * 3 / 2)
+                {
+                    numStutters++;
+                }
+
+                lastPlayedTime = playedTime;
+                sumDelay += playedTime - (1000 + seq * TEST_TS_INTERVAL / 90);
+                numPlayed++;
+            }
+        }
+
+        *avgDelay = sumDelay / numPlayed;
+        return numStutters;
+    }
+};
+
+TEST_F(VideoJitterBufferTest, TestOutOfOrderIdrFrame)
+{
+    const uint32_t kNumFragments = 120;
+    const uint16_t kLostSeq = 60;
+    std::vector<uint32_t> order;
+
+    // the fragments arrive in the reverse order except the one delayed
+    for (uint32_t i = kNumFragments; i > 0; i--)
+    {
+        if (i - 1 + 2 != kLostSeq)
+        {
+            order.push_back(i - 1);
+        }
+    }
+
+    addPacket(0, 0, true, true, MEDIASUBTYPE_VIDEO_CONFIGSTRING);
+    addPacket(1, 0, true, true, MEDIASUBTYPE_VIDEO_CONFIGSTRING);
+    addFrame(2, kNumFragments, 0, order, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    addPacket(2 + kNumFragments, TEST_TS_INTERVAL, true, true);
+    EXPECT_EQ(mJitterBuffer->GetCount(), kNumFragments + 2);
+
+    // the config strings are played, the incomplete frame is not
+    std::vector<uint16_t> seqs = getPackets();
+    ASSERT_EQ(seqs.size(), 2);
+    EXPECT_EQ(seqs[0], 0);
+    EXPECT_EQ(seqs[1], 1);
+
+    addPacket(kLostSeq, 0, false, false, MEDIASUBTYPE_VIDEO_IDR_FRAME);
+    seqs = getPackets();
+    ASSERT_EQ(seqs.size(), kNumFragments);
+
+    for (uint32_t i = 0; i < kNumFragments; i++)
+    {
+        EXPECT_EQ(seqs[i], i + 2);
+    }
+
+    // the last frame waits for the next one
+    EXPECT_EQ(mJitterBuffer->GetCount(), 1);
+    mCurrentTime += TEST_FRAME_INTERVAL;
+    addPacket(3 + kNumFragments, TEST_TS_INTERVAL * 2, true, true);
+    seqs = getPackets();
+    ASSERT_EQ(seqs.size(), 1);
+    EXPECT_EQ(seqs[0], 2 + kNumFragments);
+}
+
+TEST_F(VideoJitterBufferTest, TestIncompleteFrameDiscarded)
+{
+    // the frame of the lost header is not played and discarded when the buffer is full
+    addPacket(1, 0, false, false);
+    addPacket(2, 0, false, true);
+
+    for (uint32_t i = 1; i <= 2; i++)
+    {
+        addPacket(2 + i, TEST_TS_INTERVAL * i, true, true);
+    }
+
+    EXPECT_EQ(mJitterBuffer->GetCount(), 4);
+    std::vector<uint16_t> seqs = getPackets();
+    EXPECT_TRUE(seqs.empty());
+
+    addPacket(5, TEST_TS_INTERVAL * 3, true, true);
+    addPacket(6, TEST_TS_INTERVAL * 4, true, true);
+    seqs = getPackets();
+    ASSERT_FALSE(seqs.empty());
+    EXPECT_EQ(seqs[0], 3);
+}
+
+TEST_F(VideoJitterBufferTest, TestPacketLossNack)
+{
+    const uint32_t kRoundTripTime = 50;
+    mJitterBuffer->SetResponseWaitTime(200);
+    mJitterBuffer->SetRoundTripTime(kRoundTripTime);
+    uint32_t time = 1000;
+
+    for (uint16_t seq = 0; seq < 3; seq++)
+    {
+        addPacket(seq, 0, seq == 0, seq == 2, MEDIASUBTYPE_VIDEO_IDR_FRAME, time);
+    }
+
+    // the loss of seq 4 is found by seq 5 and requested after a frame interval for the reorder
+    addPacket(3, TEST_TS_INTERVAL, true, false, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    addPacket(5, TEST_TS_INTERVAL, false, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    EXPECT_EQ(mCallback.numNack, 0);
+
+    time += TEST_FRAME_INTERVAL;
+    addPacket(6, TEST_TS_INTERVAL * 2, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    EXPECT_EQ(mCallback.numNack, 1);
+    ASSERT_EQ(mCallback.lastNacks.size(), 1);
+    EXPECT_EQ(mCallback.lastNacks[0].PID, 4);
+    EXPECT_EQ(mCallback.lastNacks[0].BLP, 0);
+    EXPECT_EQ(mCallback.lastNacks[0].nSecNackCnt, 0);
+
+    // requested again when not received in the round trip time and a frame interval
+    time += kRoundTripTime;
+    addPacket(7, TEST_TS_INTERVAL * 3, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    EXPECT_EQ(mCallback.numNack, 1);
+
+    time += TEST_FRAME_INTERVAL;
+    addPacket(8, TEST_TS_INTERVAL * 4, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    EXPECT_EQ(mCallback.numNack, 2);
+    ASSERT_EQ(mCallback.lastNacks.size(), 1);
+    EXPECT_EQ(mCallback.lastNacks[0].nSecNackCnt, 1);
+
+    // the picture loss is requested when the retransmission is not received
+    time += kRoundTripTime + TEST_FRAME_INTERVAL;
+    addPacket(9, TEST_TS_INTERVAL * 5, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    EXPECT_EQ(mCallback.numNack, 2);
+    EXPECT_EQ(mCallback.numPictureLost, 1);
+
+    // the retransmitted packet completes the frame
+    addPacket(4, TEST_TS_INTERVAL, false, false, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    time += kRoundTripTime + TEST_FRAME_INTERVAL;
+    addPacket(10, TEST_TS_INTERVAL * 6, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    EXPECT_EQ(mCallback.numNack, 2);
+    EXPECT_EQ(mCallback.numPictureLost, 1);
+
+    std::vector<uint16_t> seqs = getPackets();
+    ASSERT_GE(seqs.size(), 6);
+
+    for (uint32_t i = 0; i < 6; i++)
+    {
+        EXPECT_EQ(seqs[i], i);
+    }
+}
+
+TEST_F(VideoJitterBufferTest, TestBurstLossNack)
+{
+    mJitterBuffer->SetResponseWaitTime(200);
+    uint32_t time = 1000;
+
+    // the burst loss of 39 packets is requested in a feedback message of 3 fcis
+    addPacket(0, 0, true, true, MEDIASUBTYPE_VIDEO_IDR_FRAME, time);
+    addPacket(40, TEST_TS_INTERVAL, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+    time += TEST_FRAME_INTERVAL;
+    addPacket(41, TEST_TS_INTERVAL * 2, true, true, MEDIASUBTYPE_VIDEO_NON_IDR_FRAME, time);
+
+    EXPECT_EQ(mCallback.numNack, 1);
+    ASSERT_EQ(mCallback.lastNacks.size(), 3);
+    EXPECT_EQ(mCallback.lastNacks[0].PID, 1);
+    EXPECT_EQ(mCallback.lastNacks[0].BLP, 0xffff);
+    EXPECT_EQ(mCallback.lastNacks[1].PID, 18);
+    EXPECT_EQ(mCallback.lastNacks[1].BLP, 0xffff);
+    EXPECT_EQ(mCallback.lastNacks[2].PID, 35);
+    EXPECT_EQ(mCallback.lastNacks[2].BLP, 0x000f);
+}
+
+/**
+ * Microbenchmark of the insertion and the playout of the large IDR frames arriving in the reverse
+ * order. The cost per packet does not grow with the number of the fragments in the frame.
+ */
+TEST_F(VideoJitterBufferTest, TestLargeFrameCost)
+{
+    const uint32_t kNumFrames = 50;
+    const uint32_t kNumFragments = 200;
+    std::vector<uint32_t> order;
+
+    for (uint32_t i = kNumFragments; i > 0; i--)
+    {
+        order.push_back(i - 1);
+    }
+
+    uint32_t numPlayed = 0;
+    auto start = std::chrono::steady_clock::now();
+
+    for (uint32_t i = 0; i < kNumFrames; i++)
+    {
+        addFrame(i * kNumFragments, kNumFragments, i * TEST_TS_INTERVAL, order,
+                MEDIASUBTYPE_VIDEO_IDR_FRAME);
+        mCurrentTime += TEST_FRAME_INTERVAL;
+        numPlayed += getPackets().size();
+    }
+
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start)
+                           .count();
+
+    // the last frame waits for the next one
+    EXPECT_EQ(numPlayed, (kNumFrames - 1) * kNumFragments);
+    RecordProperty("VideoJitterBufferNsPerPacket",
+            std::to_string(elapsed / (kNumFrames * kNumFragments)));
+}
+
+TEST_F(VideoJitterBufferTest, TestAdaptivePlayoutDelay)
+{
+    uint32_t legacyDelay = 0;
+    uint32_t legacyStutters = playJitteryFrames(false, 60, &legacyDelay);
+
+    mJitterBuffer->Reset();
+    uint32_t adaptiveDelay = 0;
+    uint32_t adaptiveStutters = playJitteryFrames(true, 60, &adaptiveDelay);
+
+    // the frames are played smoothly by the render delay covering the jitter
+    EXPECT_LT(adaptiveStutters * 10, legacyStutters);
+    EXPECT_LT(adaptiveDelay, 150);
+    RecordProperty("LegacyStutters", std::to_string(legacyStutters));
+    RecordProperty("LegacyDelayMs", std::to_string(legacyDelay));
+    RecordProperty("AdaptiveStutters", std::to_string(adaptiveStutters));
+    RecordProperty("AdaptiveDelayMs", std::to_string(adaptiveDelay));
+}
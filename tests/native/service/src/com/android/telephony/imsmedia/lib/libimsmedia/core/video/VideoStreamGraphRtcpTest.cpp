@@ -182,10 +182,10 @@ TEST_F(VideoStreamGraphRtcpTest, TestRtcpStreamInternalEvent)
     EXPECT_EQ(graph->start(), RESULT_SUCCESS);
     EXPECT_EQ(graph->getState(), kStreamStateRunning);
 
-    InternalRequestEventParam* nackEvent =
-            new InternalRequestEventParam(kRequestVideoSendNack, NackParams(0, 0, 0, true));
+    NackParams* nackEvent = new NackParams[1];
+    nackEvent[0] = NackParams(0, 0, 0, true);
     EXPECT_EQ(
-            graph->OnEvent(kRequestVideoSendNack, reinterpret_cast<uint64_t>(nackEvent), 0), true);
+            graph->OnEvent(kRequestVideoSendNack, reinterpret_cast<uint64_t>(nackEvent), 1), true);
 
     InternalRequestEventParam* pliEvent =
             new InternalRequestEventParam(kRequestVideoSendPictureLost, kPsfbPli);
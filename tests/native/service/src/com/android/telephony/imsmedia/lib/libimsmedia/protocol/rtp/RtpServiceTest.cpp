@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpService.h>
+#include <gtest/gtest.h>
+
+class RtpServiceTest : public ::testing::Test
+{
+public:
+    RTPSTACKID hRtpStack = nullptr;
+    RtpDt_Char szLocalIp[10] = "127.0.0.1";
+
+protected:
+    virtual void SetUp() override { ASSERT_EQ(IMS_RtpSvc_CreateStack(&hRtpStack), eRTP_TRUE); }
+
+    virtual void TearDown() override { IMS_RtpSvc_DeleteStack(hRtpStack); }
+};
+
+TEST_F(RtpServiceTest, TestDeletedSessionIsRejected)
+{
+    RTPSESSIONID hRtpSession = {};
+    RtpDt_UInt32 uiSsrc = 0;
+    ASSERT_EQ(IMS_RtpSvc_CreateSession(hRtpStack, szLocalIp, 10000, nullptr, &uiSsrc, &hRtpSession),
+            eRTP_TRUE);
+    EXPECT_EQ(hRtpSession.hRtpStack, hRtpStack);
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(hRtpSession), eRTP_TRUE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteSession(hRtpSession), eRTP_TRUE);
+
+    // the handle of the deleted session is not dereferenced
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(hRtpSession), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_SetRTCPInterval(hRtpSession, 5), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteSession(hRtpSession), eRTP_FALSE);
+}
+
+TEST_F(RtpServiceTest, TestUnknownSessionIsRejected)
+{
+    RtpDt_UInt32 uiUnknown = 0;
+    RTPSESSIONID hRtpSession = {hRtpStack, &uiUnknown};
+    RTPSESSIONID hNoStackSession = {nullptr, &uiUnknown};
+
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(RTPSESSIONID{}), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(hRtpSession), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(hNoStackSession), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteSession(hRtpSession), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteSession(hNoStackSession), eRTP_FALSE);
+}
+
+TEST_F(RtpServiceTest, TestSessionOfOtherStackIsRejected)
+{
+    RTPSTACKID hRtpStack2 = nullptr;
+    RTPSESSIONID hRtpSession = {};
+    RtpDt_UInt32 uiSsrc = 0;
+    ASSERT_EQ(IMS_RtpSvc_CreateStack(&hRtpStack2), eRTP_TRUE);
+    ASSERT_EQ(IMS_RtpSvc_CreateSession(
+                      hRtpStack2, szLocalIp, 10000, nullptr, &uiSsrc, &hRtpSession),
+            eRTP_TRUE);
+
+    // the session is validated against the stack which created it
+    RTPSESSIONID hOtherStackSession = {hRtpStack, hRtpSession.pvRtpSession};
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(hOtherStackSession), eRTP_FALSE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteSession(hOtherStackSession), eRTP_FALSE);
+
+    EXPECT_EQ(IMS_RtpSvc_SessionEnableRTP(hRtpSession), eRTP_TRUE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteSession(hRtpSession), eRTP_TRUE);
+    EXPECT_EQ(IMS_RtpSvc_DeleteStack(hRtpStack2), eRTP_TRUE);
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtcpCompoundIterator.h>
+#include <gtest/gtest.h>
+
+class RtcpCompoundIteratorTest : public ::testing::Test
+{
+public:
+protected:
+    virtual void SetUp() override {}
+
+    virtual void TearDown() override {}
+};
+
+/**
+ * Test compound RTCP packet with one Sender-Report and SDES.
+ * SR has zero reports and SDES has one CNAME item.
+ */
+TEST_F(RtcpCompoundIteratorTest, IterateSrSdesPacket)
+{
+    uint8_t bufSrSdesPacket[] = {0x80, 0xc8, 0x00, 0x06, 0xb1, 0xc8, 0xcb, 0x02, 0xe6, 0x5f, 0xa5,
+            0x31, 0x53, 0x91, 0x24, 0xc2, 0x00, 0x04, 0x01, 0x85, 0x00, 0x00, 0x00, 0x41, 0x00,
+            0x00, 0xc8, 0x53, 0x81, 0xca, 0x00, 0x0a, 0xb1, 0xc8, 0xcb, 0x02, 0x01, 0x1f, 0x32,
+            0x36, 0x30, 0x30, 0x3a, 0x31, 0x30, 0x30, 0x65, 0x3a, 0x31, 0x30, 0x30, 0x38, 0x3a,
+            0x61, 0x66, 0x34, 0x66, 0x3a, 0x3a, 0x31, 0x65, 0x62, 0x65, 0x3a, 0x36, 0x38, 0x35,
+            0x31, 0x00, 0x00, 0x00, 0x00};
+
+    RtcpCompoundIterator iterator(bufSrSdesPacket, sizeof(bufSrSdesPacket));
+    EXPECT_EQ(iterator.validate(), RTP_SUCCESS);
+
+    RtcpBlockView block;
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getVersion(), RTP_VERSION_NUM);
+    EXPECT_EQ(block.getPadding(), eRTP_FALSE);
+    EXPECT_EQ(block.getCount(), 0);
+    EXPECT_EQ(block.getPacketType(), RTCP_SR);
+    EXPECT_EQ(block.getLength(), 6 * RTP_WORD_SIZE);
+    EXPECT_EQ(block.getSsrc(), 0xb1c8cb02);
+    EXPECT_EQ(block.getBuffer(), bufSrSdesPacket);
+    EXPECT_EQ(block.getReportBlockCount(), 0);
+
+    tRTCP_SENDER_INFO senderInfo;
+    ASSERT_EQ(block.getSenderInfo(&senderInfo), eRTP_TRUE);
+    EXPECT_EQ(senderInfo.stNtpTimestamp.m_uiNtpHigh32Bits, 0xe65fa531);
+    EXPECT_EQ(senderInfo.stNtpTimestamp.m_uiNtpLow32Bits, 0x539124c2);
+    EXPECT_EQ(senderInfo.uiRtpTimestamp, 0x00040185);
+    EXPECT_EQ(senderInfo.uiSendPktCount, 65);
+    EXPECT_EQ(senderInfo.uiSendOctCount, 0x0000c853);
+
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_SDES);
+    EXPECT_EQ(block.getCount(), 1);
+    EXPECT_EQ(block.getLength(), 10 * RTP_WORD_SIZE);
+    EXPECT_EQ(block.getBuffer(), bufSrSdesPacket + 28);
+
+    EXPECT_EQ(iterator.next(block), eRTP_FALSE);
+    EXPECT_EQ(iterator.getStatus(), RTP_SUCCESS);
+}
+
+/**
+ * Test compound RTCP packet with one Receiver-Report with one report block and TMMBR.
+ */
+TEST_F(RtcpCompoundIteratorTest, IterateRrTmmbrPacket)
+{
+    /*
+     * Real-time Transport Control Protocol (Receiver Report)
+     * 10.. .... = Version: RFC 1889 Version (2)
+     * ..0. .... = Padding: False
+     * ...0 0001 = Reception report count: 1
+     * Packet type: Receiver Report (201)
+     * Length: 7 (32 bytes)
+     * Sender SSRC: 0xb1c8cb01
+     * Source 1
+     *    Identifier: 0xd2bd4e3e
+     *    Fraction lost: 2 / 256
+     *    Cumulative number of packets lost: 5
+     *    Extended highest sequence number received: 0x00010064
+     *    Interarrival jitter: 0x20
+     *    Last SR timestamp: 0x0a0b0c0d
+     *    Delay since last SR timestamp: 0x00010000
+     *
+     * Real-time Transport Control Protocol (Generic RTP Feedback)
+     * 10.. .... = Version: RFC 1889 Version (2)
+     * ..0. .... = Padding: False
+     * ...0 0011 = RTCP Feedback message type (FMT): TMMBR (3)
+     * Packet type: Generic RTP Feedback (205)
+     * Length: 4 (20 bytes)
+     * Sender SSRC: 0xb1c8cb01
+     * Media source SSRC: 0x00000000
+     * FCI: SSRC 0xd2bd4e3e, MxTBR Exp 2, Mantissa 16000, Measured Overhead 40
+     */
+    uint8_t bufRrTmmbrPacket[] = {0x81, 0xc9, 0x00, 0x07, 0xb1, 0xc8, 0xcb, 0x01, 0xd2, 0xbd, 0x4e,
+            0x3e, 0x02, 0x00, 0x00, 0x05, 0x00, 0x01, 0x00, 0x64, 0x00, 0x00, 0x00, 0x20, 0x0a,
+            0x0b, 0x0c, 0x0d, 0x00, 0x01, 0x00, 0x00, 0x83, 0xcd, 0x00, 0x04, 0xb1, 0xc8, 0xcb,
+            0x01, 0x00, 0x00, 0x00, 0x00, 0xd2, 0xbd, 0x4e, 0x3e, 0x08, 0xfa, 0x00, 0x28};
+
+    RtcpCompoundIterator iterator(bufRrTmmbrPacket, sizeof(bufRrTmmbrPacket));
+    EXPECT_EQ(iterator.validate(), RTP_SUCCESS);
+
+    RtcpBlockView block;
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_RR);
+    EXPECT_EQ(block.getSsrc(), 0xb1c8cb01);
+    EXPECT_EQ(block.getSenderInfo(nullptr), eRTP_FALSE);
+    ASSERT_EQ(block.getReportBlockCount(), 1);
+
+    tRTCP_REPORT_BLOCK_INFO reportBlock;
+    ASSERT_EQ(block.getReportBlock(0, &reportBlock), eRTP_TRUE);
+    EXPECT_EQ(reportBlock.uiSsrc, 0xd2bd4e3e);
+    EXPECT_EQ(reportBlock.ucFracLost, 2);
+    EXPECT_EQ(reportBlock.uiCumNumPktLost, 5);
+    EXPECT_EQ(reportBlock.uiExtHighSeqRcv, 0x00010064);
+    EXPECT_EQ(reportBlock.uiJitter, 0x20);
+    EXPECT_EQ(reportBlock.uiLastSR, 0x0a0b0c0d);
+    EXPECT_EQ(reportBlock.uiDelayLastSR, 0x00010000);
+    EXPECT_EQ(block.getReportBlock(1, &reportBlock), eRTP_FALSE);
+
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_RTPFB);
+    EXPECT_EQ(block.getCount(), 3);
+    EXPECT_EQ(block.getLength(), 4 * RTP_WORD_SIZE);
+    EXPECT_EQ(block.getMediaSsrc(), 0);
+    EXPECT_EQ(block.getFciLength(), 8);
+    // FCI is not copied
+    EXPECT_EQ(block.getFci(), bufRrTmmbrPacket + 44);
+
+    EXPECT_EQ(iterator.next(block), eRTP_FALSE);
+
+    // iterate again after reset
+    iterator.reset();
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_RR);
+}
+
+TEST_F(RtcpCompoundIteratorTest, IterateByePacket)
+{
+    // BYE with two sources and RR without report blocks
+    uint8_t bufRrByePacket[] = {0x80, 0xc9, 0x00, 0x01, 0xb1, 0xc8, 0xcb, 0x01, 0x82, 0xcb, 0x00,
+            0x02, 0xb1, 0xc8, 0xcb, 0x01, 0x01, 0x02, 0x03, 0x04};
+
+    RtcpCompoundIterator iterator(bufRrByePacket, sizeof(bufRrByePacket));
+    EXPECT_EQ(iterator.validate(), RTP_SUCCESS);
+
+    RtcpBlockView block;
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_RR);
+    EXPECT_EQ(block.getReportBlockCount(), 0);
+    EXPECT_EQ(block.getByeSsrcCount(), 0);
+
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_BYE);
+    ASSERT_EQ(block.getByeSsrcCount(), 2);
+    EXPECT_EQ(block.getByeSsrc(0), 0xb1c8cb01);
+    EXPECT_EQ(block.getByeSsrc(1), 0x01020304);
+    EXPECT_EQ(block.getByeSsrc(2), 0);
+}
+
+TEST_F(RtcpCompoundIteratorTest, IterateXrPacket)
+{
+    // XR with a receiver reference time report block and a DLRR report block
+    uint8_t bufXrPacket[] = {0x80, 0xcf, 0x00, 0x08, 0xb1, 0xc8, 0xcb, 0x01, 0x04, 0x00, 0x00,
+            0x02, 0xe6, 0x5f, 0xa5, 0x31, 0x53, 0x91, 0x24, 0xc2, 0x05, 0x00, 0x00, 0x03, 0xd2,
+            0xbd, 0x4e, 0x3e, 0x0a, 0x0b, 0x0c, 0x0d, 0x00, 0x01, 0x00, 0x00};
+
+    RtcpCompoundIterator iterator(bufXrPacket, sizeof(bufXrPacket));
+    EXPECT_EQ(iterator.validate(), RTP_SUCCESS);
+
+    RtcpBlockView block;
+    ASSERT_EQ(iterator.next(block), eRTP_TRUE);
+    EXPECT_EQ(block.getPacketType(), RTCP_XR);
+
+    RtpDt_UInt16 offset = 0;
+    RtpDt_UChar blockType = 0;
+    RtpDt_UChar* xrBlock = nullptr;
+    RtpDt_UInt16 blockLen = 0;
+
+    ASSERT_EQ(block.getNextXrBlock(offset, blockType, xrBlock, blockLen), eRTP_TRUE);
+    EXPECT_EQ(blockType, 4);
+    EXPECT_EQ(blockLen, 12);
+    EXPECT_EQ(xrBlock, bufXrPacket + 8);
+
+    ASSERT_EQ(block.getNextXrBlock(offset, blockType, xrBlock, blockLen), eRTP_TRUE);
+    EXPECT_EQ(blockType, 5);
+    EXPECT_EQ(blockLen, 16);
+    EXPECT_EQ(xrBlock, bufXrPacket + 20);
+
+    EXPECT_EQ(block.getNextXrBlock(offset, blockType, xrBlock, blockLen), eRTP_FALSE);
+}
+
+TEST_F(RtcpCompoundIteratorTest, ValidateInvalidPackets)
+{
+    RtcpCompoundIterator nullIterator(nullptr, 10);
+    EXPECT_EQ(nullIterator.validate(), RTP_INVALID_PARAMS);
+
+    // common header only
+    uint8_t bufHeaderOnly[] = {0x80, 0xc9, 0x00, 0x00};
+    RtcpCompoundIterator headerIterator(bufHeaderOnly, sizeof(bufHeaderOnly));
+    EXPECT_EQ(headerIterator.validate(), RTP_SUCCESS);
+
+    // invalid version
+    uint8_t bufInvalidVersion[] = {0x40, 0xc9, 0x00, 0x01, 0xb1, 0xc8, 0xcb, 0x01};
+    RtcpCompoundIterator versionIterator(bufInvalidVersion, sizeof(bufInvalidVersion));
+    EXPECT_EQ(versionIterator.validate(), RTP_INVALID_MSG);
+
+    RtcpBlockView block;
+    EXPECT_EQ(versionIterator.next(block), eRTP_FALSE);
+    EXPECT_EQ(versionIterator.getStatus(), RTP_INVALID_MSG);
+
+    // length exceeds the compound packet
+    uint8_t bufInvalidLength[] = {0x80, 0xc9, 0x00, 0x07, 0xb1, 0xc8, 0xcb, 0x01, 0x00, 0x00};
+    RtcpCompoundIterator lengthIterator(bufInvalidLength, sizeof(bufInvalidLength));
+    EXPECT_EQ(lengthIterator.validate(), RTP_INVALID_MSG);
+
+    // SR without sender info
+    uint8_t bufShortSr[] = {0x80, 0xc8, 0x00, 0x01, 0xb1, 0xc8, 0xcb, 0x01};
+    RtcpCompoundIterator srIterator(bufShortSr, sizeof(bufShortSr));
+    EXPECT_EQ(srIterator.validate(), RTP_FAILURE);
+
+    // unknown packet type only
+    uint8_t bufUnknown[] = {0x80, 0xd0, 0x00, 0x01, 0xb1, 0xc8, 0xcb, 0x01};
+    RtcpCompoundIterator unknownIterator(bufUnknown, sizeof(bufUnknown));
+    EXPECT_EQ(unknownIterator.validate(), RTP_DECODE_ERROR);
+}
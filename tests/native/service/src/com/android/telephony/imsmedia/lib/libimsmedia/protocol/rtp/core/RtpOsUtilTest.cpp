@@ -16,6 +16,7 @@
 
 #include <RtpOsUtil.h>
 #include <gtest/gtest.h>
+#include <thread>
 
 TEST(RtpOsUtilTest, TestGetNtpTime)
 {
@@ -54,4 +55,30 @@ TEST(RtpOsUtilTest, TestRRand)
     RtpDt_Double ulRRand2 = RtpOsUtil::RRand();
 
     EXPECT_NE(ulRRand1, ulRRand2);
-}
\ No newline at end of file
+}
+
+TEST(RtpOsUtilTest, TestGetMonotonicTime)
+{
+    RtpDt_UInt64 ulTime1 = RtpOsUtil::GetMonotonicTime();
+    usleep(RTP_MILLISEC_MICRO);
+    RtpDt_UInt64 ulTime2 = RtpOsUtil::GetMonotonicTime();
+
+    EXPECT_GE(ulTime2 - ulTime1, 1000000ULL);
+}
+
+TEST(RtpOsUtilTest, TestRandPerThread)
+{
+    RtpDt_UInt32 uiRand1 = RtpOsUtil::Rand();
+    RtpDt_UInt32 uiRand2 = RtpOsUtil::Rand();
+    EXPECT_NE(uiRand1, uiRand2);
+
+    // a thread started at the same time does not repeat the sequence of this thread
+    RtpDt_UInt32 uiRand3 = RTP_ZERO;
+    std::thread objThread(
+            [&uiRand3]()
+            {
+                uiRand3 = RtpOsUtil::Rand();
+            });
+    objThread.join();
+    EXPECT_NE(uiRand1, uiRand3);
+}
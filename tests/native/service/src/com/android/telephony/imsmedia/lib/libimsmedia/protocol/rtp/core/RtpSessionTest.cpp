@@ -0,0 +1,448 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpSession.h>
+#include <RtpStack.h>
+#include <RtcpCompoundIterator.h>
+#include <RtpOsUtil.h>
+#include <RtpStackUtil.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+const RtpDt_UInt32 kPayloadType = 96;
+const RtpDt_UInt32 kSamplingRate = 16000;
+const RtpDt_UInt32 kRemoteSsrc = 0x11223344;
+const RtpDt_UInt32 kPayloadSize = 32;
+const RtpDt_UInt32 kNumPackets = 20000;
+const RtpDt_UChar kCname[] = "ims@127.0.0.1";
+
+class FakeRtpAppInterface : public IRtpAppInterface
+{
+public:
+    std::mutex mLock;
+    std::vector<RtpDt_UChar> mLastRtcp;
+    std::atomic<RtpDt_UInt32> mRtcpCount{0};
+
+    eRtp_Bool rtpSsrcCollisionInd(IN RtpDt_Int32, IN RtpDt_Int32) override { return eRTP_TRUE; }
+    RtpDt_Void setAppdata(IN RtpDt_Void*) override {}
+    RtpDt_Void* getAppdata() override { return nullptr; }
+    eRtp_Bool rtpNewMemberJoinInd(IN RtpDt_Int32) override { return eRTP_TRUE; }
+    eRtp_Bool rtpMemberLeaveInd(IN eRTP_LEAVE_REASON, IN RtpDt_Int32) override
+    {
+        return eRTP_TRUE;
+    }
+    eRtp_Bool rtcpPacketSendInd(IN RtpBuffer* pobjRtcpBuf, IN RtpSession*) override
+    {
+        std::lock_guard<std::mutex> guard(mLock);
+        mLastRtcp.assign(pobjRtcpBuf->getBuffer(),
+                pobjRtcpBuf->getBuffer() + pobjRtcpBuf->getLength());
+        mRtcpCount++;
+        return eRTP_TRUE;
+    }
+    eRtp_Bool rtcpAppPayloadReqInd(OUT RtpDt_UInt16&, OUT RtpDt_UInt32&, OUT RtpBuffer*) override
+    {
+        return eRTP_FALSE;
+    }
+    eRtp_Bool getRtpHdrExtInfo(OUT RtpBuffer*) override { return eRTP_FALSE; }
+    eRtp_Bool deleteRcvrInfo(IN RtpDt_UInt32, IN RtpBuffer*, IN RtpDt_UInt16) override
+    {
+        return eRTP_TRUE;
+    }
+    eRtp_Bool rtcpTimerHdlErrorInd(IN eRTP_STATUS_CODE) override { return eRTP_TRUE; }
+    RtpDt_Void* RtpStartTimer(
+            IN RtpDt_UInt32, IN eRtp_Bool, IN RTPCB_TIMERHANDLER, IN RtpDt_Void*) override
+    {
+        return nullptr;
+    }
+    eRtp_Bool RtpStopTimer(IN RtpDt_Void*, OUT RtpDt_Void**) override { return eRTP_TRUE; }
+};
+}  // namespace
+
+class RtpSessionTest : public ::testing::Test
+{
+public:
+    RtpStack rtpStack;
+    RtpSession* pobjRtpSession = nullptr;
+    FakeRtpAppInterface* pobjAppInterface = nullptr;
+    RtpDt_UChar szRemoteIp[10] = "127.0.0.1";
+    RtpDt_UChar pucPayload[kPayloadSize] = {0};
+
+protected:
+    virtual void SetUp() override
+    {
+        rtpStack.setStackProfile(new RtpStackProfile());
+        pobjRtpSession = rtpStack.createRtpSession();
+        pobjAppInterface = new FakeRtpAppInterface();
+        RtcpConfigInfo* pobjRtcpConfigInfo = new RtcpConfigInfo();
+        tRTCP_SDES_ITEM stSdesItem = {};
+        stSdesItem.ucType = RTP_ONE;
+        stSdesItem.ucLength = sizeof(kCname) - 1;
+        stSdesItem.pValue = const_cast<RtpDt_UChar*>(kCname);
+        pobjRtcpConfigInfo->addRtcpSdesItem(&stSdesItem, RTP_ZERO);
+        pobjRtpSession->initSession(pobjAppInterface, pobjRtcpConfigInfo);
+
+        RtpDt_UInt32 uiPayloadType[RTP_MAX_PAYLOAD_TYPE] = {kPayloadType};
+        RtpPayloadInfo objPayloadInfo(uiPayloadType, kSamplingRate, RTP_ONE);
+        pobjRtpSession->setPayload(&objPayloadInfo, RTP_ZERO);
+        pobjRtpSession->setSsrc(0xAABBCCDD);
+    }
+
+    virtual void TearDown() override { rtpStack.deleteRtpSession(pobjRtpSession); }
+
+    eRTP_STATUS_CODE sendRtp()
+    {
+        RtpBuffer objPayload;
+        objPayload.setBufferInfo(kPayloadSize, pucPayload);
+        RtpBuffer objRtpPkt;
+        eRTP_STATUS_CODE eStatus = pobjRtpSession->createRtpPacket(
+                &objPayload, eRTP_FALSE, kPayloadType, eRTP_FALSE, 320, nullptr, &objRtpPkt);
+        objPayload.setBufferInfo(RTP_ZERO, nullptr);
+        return eStatus;
+    }
+
+    eRTP_STATUS_CODE receiveRtp(RtpDt_UInt16 usSeqNum)
+    {
+        RtpDt_UChar pucPacket[RTP_FIXED_HDR_LEN + kPayloadSize] = {0};
+        RtpDt_UInt32 uiTimestamp = usSeqNum * 320;
+        pucPacket[0] = 0x80;
+        pucPacket[1] = kPayloadType;
+        pucPacket[2] = usSeqNum >> 8;
+        pucPacket[3] = usSeqNum & 0xff;
+        pucPacket[4] = uiTimestamp >> 24;
+        pucPacket[5] = (uiTimestamp >> 16) & 0xff;
+        pucPacket[6] = (uiTimestamp >> 8) & 0xff;
+        pucPacket[7] = uiTimestamp & 0xff;
+        pucPacket[8] = kRemoteSsrc >> 24;
+        pucPacket[9] = (kRemoteSsrc >> 16) & 0xff;
+        pucPacket[10] = (kRemoteSsrc >> 8) & 0xff;
+        pucPacket[11] = kRemoteSsrc & 0xff;
+
+        RtpBuffer objRtpBuf;
+        objRtpBuf.setBufferInfo(sizeof(pucPacket), pucPacket);
+        RtpBuffer objRmtAddr;
+        objRmtAddr.setBufferInfo(sizeof(szRemoteIp), szRemoteIp);
+        RtpPacket objRtpPkt;
+
+        eRTP_STATUS_CODE eStatus =
+                pobjRtpSession->processRcvdRtpPkt(&objRmtAddr, 30000, &objRtpBuf, &objRtpPkt);
+        objRtpBuf.setBufferInfo(RTP_ZERO, nullptr);
+        objRmtAddr.setBufferInfo(RTP_ZERO, nullptr);
+        return eStatus;
+    }
+
+    eRtp_Bool sendRtcp()
+    {
+        RtpDt_Char pcFci[8] = {0};
+        return pobjRtpSession->sendRtcpRtpFbPacket(RTP_ONE, pcFci, sizeof(pcFci), kRemoteSsrc);
+    }
+
+    RtpDt_UChar getFirstRtcpPacketType(tRTCP_SENDER_INFO* pstSenderInfo)
+    {
+        std::lock_guard<std::mutex> guard(pobjAppInterface->mLock);
+        std::vector<RtpDt_UChar>& objRtcp = pobjAppInterface->mLastRtcp;
+        RtcpCompoundIterator objIterator(objRtcp.data(), objRtcp.size());
+        RtcpBlockView objBlock;
+
+        if (objIterator.next(objBlock) == eRTP_FALSE)
+        {
+            return RTP_ZERO;
+        }
+
+        objBlock.getSenderInfo(pstSenderInfo);
+        return objBlock.getPacketType();
+    }
+};
+
+TEST_F(RtpSessionTest, TestSenderReportCountsPacketsSentBeforeReport)
+{
+    for (RtpDt_UInt32 i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(sendRtp(), RTP_SUCCESS);
+    }
+
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+
+    tRTCP_SENDER_INFO stSenderInfo = {};
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_SR);
+    EXPECT_EQ(stSenderInfo.uiSendPktCount, 10);
+    EXPECT_EQ(stSenderInfo.uiSendOctCount, 10 * kPayloadSize);
+
+    // the feedback packet does not start the next reporting interval
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_SR);
+    EXPECT_EQ(stSenderInfo.uiSendPktCount, 10);
+
+    pobjRtpSession->enableRtcp(eRTP_FALSE);
+    pobjRtpSession->rtcpTimerExpiry(nullptr);
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_SR);
+
+    // no RTP packet sent since the last regular report
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_RR);
+
+    EXPECT_EQ(sendRtp(), RTP_SUCCESS);
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_SR);
+    EXPECT_EQ(stSenderInfo.uiSendPktCount, 11);
+}
+
+TEST_F(RtpSessionTest, TestReceiverReportBlockFromReceivedPackets)
+{
+    for (RtpDt_UInt16 i = 0; i < 10; i++)
+    {
+        receiveRtp(i);
+    }
+
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+
+    std::lock_guard<std::mutex> guard(pobjAppInterface->mLock);
+    std::vector<RtpDt_UChar>& objRtcp = pobjAppInterface->mLastRtcp;
+    RtcpCompoundIterator objIterator(objRtcp.data(), objRtcp.size());
+    RtcpBlockView objBlock;
+    ASSERT_EQ(objIterator.next(objBlock), eRTP_TRUE);
+    EXPECT_EQ(objBlock.getPacketType(), RTCP_RR);
+    ASSERT_EQ(objBlock.getReportBlockCount(), 1);
+
+    tRTCP_REPORT_BLOCK_INFO stReportBlock = {};
+    EXPECT_EQ(objBlock.getReportBlock(RTP_ZERO, &stReportBlock), eRTP_TRUE);
+    EXPECT_EQ(stReportBlock.uiSsrc, kRemoteSsrc);
+    EXPECT_EQ(stReportBlock.uiExtHighSeqRcv, 9);
+}
+
+TEST_F(RtpSessionTest, TestReducedSizeFeedbackFollowsEarlyFeedbackRule)
+{
+    pobjRtpSession->setReducedSizeRtcp(eRTP_TRUE);
+    EXPECT_EQ(pobjRtpSession->isReducedSizeRtcp(), eRTP_TRUE);
+
+    // the feedback is sent in a compound packet when no regular report is scheduled
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(pobjAppInterface->mRtcpCount, 1);
+    tRTCP_SENDER_INFO stSenderInfo = {};
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_RR);
+
+    // and before the first regular report
+    pobjRtpSession->enableRtcp(eRTP_FALSE);
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(pobjAppInterface->mRtcpCount, 2);
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_RR);
+
+    pobjRtpSession->rtcpTimerExpiry(nullptr);
+    EXPECT_EQ(pobjAppInterface->mRtcpCount, 3);
+
+    // the first feedback is sent alone as an early packet
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(pobjAppInterface->mRtcpCount, 4);
+
+    {
+        std::lock_guard<std::mutex> guard(pobjAppInterface->mLock);
+        std::vector<RtpDt_UChar>& objRtcp = pobjAppInterface->mLastRtcp;
+        EXPECT_EQ(objRtcp.size(), RTCP_FIXED_HDR_LEN + RTP_WORD_SIZE + 8);
+        RtcpCompoundIterator objIterator(objRtcp.data(), objRtcp.size());
+        RtcpBlockView objBlock;
+        ASSERT_EQ(objIterator.next(objBlock), eRTP_TRUE);
+        EXPECT_EQ(objBlock.getPacketType(), RTCP_RTPFB);
+        EXPECT_EQ(objIterator.next(objBlock), eRTP_FALSE);
+    }
+
+    // no more early packet until the next regular report
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    EXPECT_EQ(pobjAppInterface->mRtcpCount, 4);
+}
+
+TEST_F(RtpSessionTest, TestReducedSizeFeedbackFailsWhenPendingIsFull)
+{
+    pobjRtpSession->setReducedSizeRtcp(eRTP_TRUE);
+    pobjRtpSession->enableRtcp(eRTP_FALSE);
+    pobjRtpSession->rtcpTimerExpiry(nullptr);
+
+    // the early packet
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+
+    for (RtpDt_UInt32 i = 0; i < RTCP_MAX_PENDING_FB_PKTS; i++)
+    {
+        EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    }
+
+    // the feedback is not dropped silently
+    EXPECT_EQ(sendRtcp(), eRTP_FALSE);
+}
+
+TEST_F(RtpSessionTest, TestNackRetransmissionLatency)
+{
+    // PID 100 and BLP requesting 101 and 116
+    RtpDt_Char pcFci[RTP_WORD_SIZE] = {0, 100, static_cast<RtpDt_Char>(0x80), 0x01};
+    EXPECT_EQ(pobjRtpSession->sendRtcpRtpFbPacket(
+                      RTCP_FB_GENERIC_NACK, pcFci, sizeof(pcFci), kRemoteSsrc),
+            eRTP_TRUE);
+
+    RtpDt_UInt32 uiLatency = RTP_ZERO;
+    EXPECT_EQ(pobjRtpSession->checkNackRetransmission(102, uiLatency), eRTP_FALSE);
+    EXPECT_EQ(pobjRtpSession->checkNackRetransmission(101, uiLatency), eRTP_TRUE);
+    EXPECT_LT(uiLatency, RTCP_NACK_RECORD_TIMEOUT);
+    EXPECT_EQ(pobjRtpSession->checkNackRetransmission(101, uiLatency), eRTP_FALSE);
+    EXPECT_EQ(pobjRtpSession->checkNackRetransmission(100, uiLatency), eRTP_TRUE);
+    EXPECT_EQ(pobjRtpSession->checkNackRetransmission(116, uiLatency), eRTP_TRUE);
+
+    // the picture loss indication is not recorded
+    EXPECT_EQ(pobjRtpSession->sendRtcpPayloadFbPacket(RTP_ONE, pcFci, sizeof(pcFci), kRemoteSsrc),
+            eRTP_TRUE);
+    EXPECT_EQ(pobjRtpSession->checkNackRetransmission(100, uiLatency), eRTP_FALSE);
+}
+
+TEST_F(RtpSessionTest, TestXrRoundTripTimeBlocks)
+{
+    pobjRtpSession->setRtcpXrRttBlocks(eRTP_TRUE, eRTP_TRUE);
+    pobjRtpSession->enableRtcp(eRTP_FALSE);
+    receiveRtp(0);
+
+    // RR without report block and XR with the receiver reference time from the remote
+    RtpDt_UChar pucRrt[] = {0x80, 0xc9, 0x00, 0x01, 0x11, 0x22, 0x33, 0x44, 0x80, 0xcf, 0x00,
+            0x04, 0x11, 0x22, 0x33, 0x44, 0x04, 0x00, 0x00, 0x02, 0x12, 0x34, 0x56, 0x78, 0x9a,
+            0xbc, 0x00, 0x00};
+    RtpBuffer objRtcpBuf;
+    objRtcpBuf.setBufferInfo(sizeof(pucRrt), pucRrt);
+    RtpBuffer objRmtAddr;
+    objRmtAddr.setBufferInfo(sizeof(szRemoteIp), szRemoteIp);
+    EXPECT_EQ(pobjRtpSession->processRcvdRtcpPkt(&objRmtAddr, 30001, &objRtcpBuf), RTP_SUCCESS);
+
+    // the report carries the reference time of this session and the DLRR for the remote
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+
+    {
+        std::lock_guard<std::mutex> guard(pobjAppInterface->mLock);
+        std::vector<RtpDt_UChar>& objRtcp = pobjAppInterface->mLastRtcp;
+        RtcpCompoundIterator objIterator(objRtcp.data(), objRtcp.size());
+        RtcpBlockView objBlock;
+        RtpDt_UInt32 uiNumRrt = RTP_ZERO;
+        RtpDt_UInt32 uiNumDlrr = RTP_ZERO;
+
+        while (objIterator.next(objBlock) == eRTP_TRUE)
+        {
+            RtpDt_UInt16 usOffset = RTP_ZERO;
+            RtpDt_UChar ucBlockType = RTP_ZERO;
+            RtpDt_UChar* pucBlock = nullptr;
+            RtpDt_UInt16 usBlockLen = RTP_ZERO;
+
+            while (objBlock.getNextXrBlock(usOffset, ucBlockType, pucBlock, usBlockLen) ==
+                    eRTP_TRUE)
+            {
+                RtpDt_UInt32* puiBlock = reinterpret_cast<RtpDt_UInt32*>(pucBlock);
+
+                if (ucBlockType == RTCP_XR_RRT_BLOCK_TYPE)
+                {
+                    EXPECT_EQ(usBlockLen, RTCP_XR_RRT_BLOCK_LEN);
+                    uiNumRrt++;
+                }
+                else if (ucBlockType == RTCP_XR_DLRR_BLOCK_TYPE)
+                {
+                    ASSERT_EQ(usBlockLen, RTP_WORD_SIZE + RTCP_XR_DLRR_SUB_BLOCK_LEN);
+                    EXPECT_EQ(RtpOsUtil::Ntohl(puiBlock[1]), kRemoteSsrc);
+                    EXPECT_EQ(RtpOsUtil::Ntohl(puiBlock[2]), 0x56789abc);
+                    uiNumDlrr++;
+                }
+            }
+        }
+
+        EXPECT_EQ(uiNumRrt, 1);
+        EXPECT_EQ(uiNumDlrr, 1);
+    }
+
+    // the DLRR from the remote, the reference time was sent 1 second ago and held 0.5 seconds
+    tRTP_NTP_TIME stNtpTs = {RTP_ZERO, RTP_ZERO};
+    RtpOsUtil::GetNtpTime(stNtpTs);
+    RtpDt_UInt32 uiLrr = RtpStackUtil::getMidFourOctets(&stNtpTs) - 0x10000;
+    RtpDt_UInt32 uiDlrr = 0x8000;
+    RtpDt_UChar pucDlrr[] = {0x80, 0xc9, 0x00, 0x01, 0x11, 0x22, 0x33, 0x44, 0x80, 0xcf, 0x00,
+            0x05, 0x11, 0x22, 0x33, 0x44, 0x05, 0x00, 0x00, 0x03, 0xaa, 0xbb, 0xcc, 0xdd,
+            static_cast<RtpDt_UChar>(uiLrr >> 24), static_cast<RtpDt_UChar>(uiLrr >> 16),
+            static_cast<RtpDt_UChar>(uiLrr >> 8), static_cast<RtpDt_UChar>(uiLrr), 0x00, 0x00,
+            static_cast<RtpDt_UChar>(uiDlrr >> 8), 0x00};
+    objRtcpBuf.setBufferInfo(sizeof(pucDlrr), pucDlrr);
+    EXPECT_EQ(pobjRtpSession->processRcvdRtcpPkt(&objRmtAddr, 30001, &objRtcpBuf), RTP_SUCCESS);
+    EXPECT_NEAR(pobjRtpSession->getRTTD(), 0x8000, 0x1000);
+
+    objRtcpBuf.setBufferInfo(RTP_ZERO, nullptr);
+    objRmtAddr.setBufferInfo(RTP_ZERO, nullptr);
+}
+
+/**
+ * Contention benchmark. RTP packets are sent and received from two threads while a third
+ * thread keeps sending RTCP reports, the elapsed time is compared with running the same send
+ * and receive load back to back. The timings are reported as test properties.
+ */
+TEST_F(RtpSessionTest, TestConcurrentSendReceiveContention)
+{
+    auto sendLoop = [this]()
+    {
+        for (RtpDt_UInt32 i = 0; i < kNumPackets; i++)
+        {
+            EXPECT_EQ(sendRtp(), RTP_SUCCESS);
+        }
+    };
+
+    auto receiveLoop = [this](RtpDt_UInt16 usFirstSeq)
+    {
+        for (RtpDt_UInt32 i = 0; i < kNumPackets; i++)
+        {
+            receiveRtp(usFirstSeq + i);
+        }
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    sendLoop();
+    receiveLoop(0);
+    auto sequentialUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+                                .count();
+
+    std::atomic<bool> bRunning(true);
+    std::thread rtcpThread(
+            [this, &bRunning]()
+            {
+                while (bRunning)
+                {
+                    sendRtcp();
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                }
+            });
+
+    start = std::chrono::steady_clock::now();
+    std::thread txThread(sendLoop);
+    std::thread rxThread(receiveLoop, kNumPackets);
+    txThread.join();
+    rxThread.join();
+    auto concurrentUs = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start)
+                                .count();
+    bRunning = false;
+    rtcpThread.join();
+
+    RecordProperty("SequentialUs", std::to_string(sequentialUs));
+    RecordProperty("ConcurrentUs", std::to_string(concurrentUs));
+    EXPECT_GT(pobjAppInterface->mRtcpCount, 0);
+
+    // every packet sent is accounted for in the sender report
+    EXPECT_EQ(sendRtp(), RTP_SUCCESS);
+    EXPECT_EQ(sendRtcp(), eRTP_TRUE);
+    tRTCP_SENDER_INFO stSenderInfo = {};
+    EXPECT_EQ(getFirstRtcpPacketType(&stSenderInfo), RTCP_SR);
+    EXPECT_EQ(stSenderInfo.uiSendPktCount, 2 * kNumPackets + 1);
+}
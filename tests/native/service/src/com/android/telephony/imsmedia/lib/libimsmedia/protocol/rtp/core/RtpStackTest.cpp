@@ -63,6 +63,8 @@ TEST_F(RtpStackTest, TestCreateCheckDeleteRtpSession)
 
     EXPECT_EQ(rtpStack.isValidRtpSession(pobjRtpSession), eRTP_SUCCESS);
     EXPECT_EQ(rtpStack.deleteRtpSession(pobjRtpSession), RTP_SUCCESS);
+    EXPECT_EQ(rtpStack.isValidRtpSession(pobjRtpSession), eRTP_FAILURE);
+    EXPECT_EQ(rtpStack.deleteRtpSession(pobjRtpSession), RTP_FAILURE);
 }
 
 TEST_F(RtpStackTest, TestDeleteRtpSessionFailures)
@@ -82,4 +84,24 @@ TEST_F(RtpStackTest, TestDeleteRtpSessionFailures)
     // delete Rtp Sessions
     EXPECT_EQ(rtpStack.deleteRtpSession(pobjRtpSession1), RTP_SUCCESS);
     EXPECT_EQ(rtpStack2.deleteRtpSession(pobjRtpSession2), RTP_SUCCESS);
-}
\ No newline at end of file
+}
+
+TEST_F(RtpStackTest, TestRtpSessionsInSeparateStacks)
+{
+    RtpStackProfile* pobjStackProfile2 = new RtpStackProfile();
+    RtpStack rtpStack2(pobjStackProfile2);
+
+    RtpSession* pobjRtpSession1 = rtpStack.createRtpSession();
+    RtpSession* pobjRtpSession2 = rtpStack2.createRtpSession();
+
+    // each session refers to the stack which created it
+    EXPECT_EQ(pobjRtpSession1->getRtpStack(), &rtpStack);
+    EXPECT_EQ(pobjRtpSession2->getRtpStack(), &rtpStack2);
+    EXPECT_EQ(rtpStack2.isValidRtpSession(pobjRtpSession1), eRTP_FAILURE);
+    EXPECT_EQ(rtpStack2.isValidRtpSession(pobjRtpSession2), eRTP_SUCCESS);
+
+    EXPECT_EQ(rtpStack.deleteRtpSession(pobjRtpSession1), RTP_SUCCESS);
+    EXPECT_EQ(rtpStack2.deleteRtpSession(pobjRtpSession2), RTP_SUCCESS);
+    delete pobjRtpSession1;
+    delete pobjRtpSession2;
+}
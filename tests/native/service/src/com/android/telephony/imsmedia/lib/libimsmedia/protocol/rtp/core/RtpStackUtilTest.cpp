@@ -110,4 +110,25 @@ TEST(RtpStackUtilTest, TestcalcRtpTsWithNoPrevTs)
 
     rtpTs = RtpStackUtil::calcRtpTimestamp(uiPrevRtpTimestamp, nullptr, nullptr, 16000);
     EXPECT_EQ(rtpTs, 0);
-}
\ No newline at end of file
+}
+
+TEST(RtpStackUtilTest, TestcalcRtpTsLongDuration)
+{
+    tRTP_NTP_TIME stPrevNtpTimestamp;
+    stPrevNtpTimestamp.m_uiNtpHigh32Bits = 3867661587;
+    stPrevNtpTimestamp.m_uiNtpLow32Bits = 0x80000000;
+
+    // three hours and a half second later
+    tRTP_NTP_TIME stCurNtpTimestamp;
+    stCurNtpTimestamp.m_uiNtpHigh32Bits = 3867661587 + 3 * 3600;
+    stCurNtpTimestamp.m_uiNtpLow32Bits = 0;
+
+    RtpDt_UInt32 rtpTs =
+            RtpStackUtil::calcRtpTimestamp(1000, &stCurNtpTimestamp, &stPrevNtpTimestamp, 48000);
+    EXPECT_EQ(rtpTs, 1000 + (3 * 3600 - 1) * 48000 + 24000);
+
+    // the current time is before the previous one
+    rtpTs = RtpStackUtil::calcRtpTimestamp(
+            1000000, &stPrevNtpTimestamp, &stCurNtpTimestamp, 16000);
+    EXPECT_EQ(rtpTs, 1000000 - ((3 * 3600 - 1) * 16000 + 8000));
+}
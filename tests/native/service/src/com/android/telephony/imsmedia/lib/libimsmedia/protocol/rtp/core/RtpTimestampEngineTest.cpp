@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2022 The Android Open Source Project
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <RtpTimestampEngine.h>
+#include <gtest/gtest.h>
+
+const RtpDt_UInt64 kSecToNanoSec = 1000000000ULL;
+
+class RtpTimestampEngineTest : public ::testing::Test
+{
+public:
+    RtpTimestampEngine engine;
+    tRTP_NTP_TIME stAnchorNtp = {3867661587, 0x80000000};
+    RtpDt_UInt64 ulAnchorTime = 5 * kSecToNanoSec;
+
+protected:
+    virtual void SetUp() override { engine.init(ulAnchorTime, &stAnchorNtp, 1000, 16000); }
+
+    virtual void TearDown() override {}
+};
+
+TEST_F(RtpTimestampEngineTest, TestAnchor)
+{
+    tRTP_NTP_TIME stNtp;
+    engine.getNtpTime(ulAnchorTime, &stNtp);
+    EXPECT_EQ(stNtp.m_uiNtpHigh32Bits, stAnchorNtp.m_uiNtpHigh32Bits);
+    EXPECT_EQ(stNtp.m_uiNtpLow32Bits, stAnchorNtp.m_uiNtpLow32Bits);
+    EXPECT_EQ(engine.getRtpTimestamp(ulAnchorTime), 1000);
+    EXPECT_EQ(engine.getSamplingRate(), 16000);
+}
+
+TEST_F(RtpTimestampEngineTest, TestGetNtpTime)
+{
+    tRTP_NTP_TIME stNtp;
+
+    // half a second later the fraction wraps to the next second
+    engine.getNtpTime(ulAnchorTime + kSecToNanoSec / 2, &stNtp);
+    EXPECT_EQ(stNtp.m_uiNtpHigh32Bits, stAnchorNtp.m_uiNtpHigh32Bits + 1);
+    EXPECT_EQ(stNtp.m_uiNtpLow32Bits, 0);
+
+    // 250 ms before the anchor
+    engine.getNtpTime(ulAnchorTime - kSecToNanoSec / 4, &stNtp);
+    EXPECT_EQ(stNtp.m_uiNtpHigh32Bits, stAnchorNtp.m_uiNtpHigh32Bits);
+    EXPECT_EQ(stNtp.m_uiNtpLow32Bits, 0x40000000);
+
+    engine.getNtpTime(ulAnchorTime, nullptr);
+}
+
+TEST_F(RtpTimestampEngineTest, TestGetRtpTimestamp)
+{
+    EXPECT_EQ(engine.getRtpTimestamp(ulAnchorTime + 20000000), 1000 + 320);
+    EXPECT_EQ(engine.getRtpTimestamp(ulAnchorTime - 20000000), 1000 - 320);
+
+    // a frame of 20 ms at a time does not accumulate rounding error over a long call
+    RtpDt_UInt64 ulTime = ulAnchorTime;
+    for (RtpDt_UInt32 i = 0; i < 3 * 3600 * 50; i++)
+    {
+        ulTime += 20000000;
+    }
+    EXPECT_EQ(engine.getRtpTimestamp(ulTime), 1000 + 3 * 3600 * 16000);
+
+    // wraps around 32 bits
+    engine.setRtpAnchor(ulAnchorTime, 0xFFFFFF00);
+    EXPECT_EQ(engine.getRtpTimestamp(ulAnchorTime + 20000000), 0x40);
+}
+
+TEST_F(RtpTimestampEngineTest, TestSetSamplingRate)
+{
+    RtpDt_UInt64 ulTime = ulAnchorTime + kSecToNanoSec;
+    engine.setSamplingRate(ulTime, 48000);
+    EXPECT_EQ(engine.getSamplingRate(), 48000);
+
+    // continuous at the change and the new rate applies afterwards
+    EXPECT_EQ(engine.getRtpTimestamp(ulTime), 1000 + 16000);
+    EXPECT_EQ(engine.getRtpTimestamp(ulTime + kSecToNanoSec), 1000 + 16000 + 48000);
+
+    // the NTP mapping is not affected
+    tRTP_NTP_TIME stNtp;
+    engine.getNtpTime(ulTime, &stNtp);
+    EXPECT_EQ(stNtp.m_uiNtpHigh32Bits, stAnchorNtp.m_uiNtpHigh32Bits + 1);
+    EXPECT_EQ(stNtp.m_uiNtpLow32Bits, stAnchorNtp.m_uiNtpLow32Bits);
+}
+
+TEST_F(RtpTimestampEngineTest, TestConversions)
+{
+    EXPECT_EQ(RtpTimestampEngine::convertToRtpTicks(kSecToNanoSec, 90000), 90000);
+    EXPECT_EQ(RtpTimestampEngine::convertToRtpTicks(1, 90000), 0);
+    EXPECT_EQ(RtpTimestampEngine::convertToRtpTicks(11111, 90000), 0);
+    EXPECT_EQ(RtpTimestampEngine::convertToRtpTicks(11112, 90000), 1);
+    EXPECT_EQ(RtpTimestampEngine::convertToRtpTicks(30 * 24 * 3600 * kSecToNanoSec, 48000),
+            30ULL * 24 * 3600 * 48000);
+
+    EXPECT_EQ(RtpTimestampEngine::convertToNtp(kSecToNanoSec), 1ULL << 32);
+    EXPECT_EQ(RtpTimestampEngine::convertToNtp(1000000), 4294967ULL);
+    EXPECT_EQ(RtpTimestampEngine::convertToNtp(kSecToNanoSec - 1), 0xFFFFFFFBULL);
+}
@@ -61,6 +61,10 @@ public class AudioConfigTest {
     private static final boolean DTX_ENABLED = true;
     private static final byte DTMF_PAYLOAD = 126;
     private static final byte DTMF_SAMPLING_RATE = 127;
+    private static final byte RED_PAYLOAD = 125;
+    private static final byte REDUNDANCY_LEVEL = 2;
+    private static final byte REDUNDANCY_DISTANCE = 1;
+    private static final byte PLAYOUT_DELAY_PERCENTILE = 97;
 
     private static final RtcpConfig rtcp = new RtcpConfig.Builder()
             .setCanonicalName(CANONICAL_NAME)
@@ -95,6 +99,10 @@ public class AudioConfigTest {
         assertThat(config.getTxDtmfPayloadTypeNumber()).isEqualTo(DTMF_PAYLOAD);
         assertThat(config.getRxDtmfPayloadTypeNumber()).isEqualTo(DTMF_PAYLOAD);
         assertThat(config.getDtmfSamplingRateKHz()).isEqualTo(DTMF_SAMPLING_RATE);
+        assertThat(config.getRedPayloadTypeNumber()).isEqualTo(RED_PAYLOAD);
+        assertThat(config.getRedundancyLevel()).isEqualTo(REDUNDANCY_LEVEL);
+        assertThat(config.getRedundancyDistance()).isEqualTo(REDUNDANCY_DISTANCE);
+        assertThat(config.getPlayoutDelayPercentile()).isEqualTo(PLAYOUT_DELAY_PERCENTILE);
         assertThat(config.getAmrParams()).isEqualTo(null);
         assertThat(config.getEvsParams()).isEqualTo(evs);
         assertThat(config.getAccessNetwork()).isEqualTo(AccessNetworkType.EUTRAN);
@@ -149,6 +157,10 @@ public class AudioConfigTest {
                 .setTxDtmfPayloadTypeNumber(DTMF_PAYLOAD)
                 .setRxDtmfPayloadTypeNumber(DTMF_PAYLOAD)
                 .setDtmfSamplingRateKHz(DTMF_SAMPLING_RATE)
+                .setRedPayloadTypeNumber(RED_PAYLOAD)
+                .setRedundancyLevel(REDUNDANCY_LEVEL)
+                .setRedundancyDistance(REDUNDANCY_DISTANCE)
+                .setPlayoutDelayPercentile(PLAYOUT_DELAY_PERCENTILE)
                 .setAmrParams(amr)
                 .setEvsParams(evs)
                 .build();
@@ -174,6 +186,10 @@ public class AudioConfigTest {
                 .setTxDtmfPayloadTypeNumber(DTMF_PAYLOAD)
                 .setRxDtmfPayloadTypeNumber(DTMF_PAYLOAD)
                 .setDtmfSamplingRateKHz(DTMF_SAMPLING_RATE)
+                .setRedPayloadTypeNumber(RED_PAYLOAD)
+                .setRedundancyLevel(REDUNDANCY_LEVEL)
+                .setRedundancyDistance(REDUNDANCY_DISTANCE)
+                .setPlayoutDelayPercentile(PLAYOUT_DELAY_PERCENTILE)
                 .setEvsParams(evs)
                 .build();
     }
@@ -40,12 +40,16 @@ public class RtcpConfigTest {
                 .setTransmitPort(PORT)
                 .setIntervalSec(INTERVAL)
                 .setRtcpXrBlockTypes(BLOCK_TYPES)
+                .setRtcpMuxEnabled(true)
+                .setRtcpReducedSizeEnabled(true)
                 .build();
 
         assertThat(rtcp.getCanonicalName()).isEqualTo(NAME);
         assertThat(rtcp.getTransmitPort()).isEqualTo(PORT);
         assertThat(rtcp.getIntervalSec()).isEqualTo(INTERVAL);
         assertThat(rtcp.getRtcpXrBlockTypes()).isEqualTo(BLOCK_TYPES);
+        assertThat(rtcp.getRtcpMuxEnabled()).isTrue();
+        assertThat(rtcp.getRtcpReducedSizeEnabled()).isTrue();
     }
 
     @Test
@@ -55,6 +59,8 @@ public class RtcpConfigTest {
                 .setTransmitPort(PORT)
                 .setIntervalSec(INTERVAL)
                 .setRtcpXrBlockTypes(BLOCK_TYPES)
+                .setRtcpMuxEnabled(true)
+                .setRtcpReducedSizeEnabled(true)
                 .build();
 
         Parcel parcel = Parcel.obtain();
@@ -128,5 +134,25 @@ public class RtcpConfigTest {
                 .build();
 
         assertThat(rtcp1).isNotEqualTo(rtcp5);
+
+        RtcpConfig rtcp6 = new RtcpConfig.Builder()
+                .setCanonicalName(NAME)
+                .setTransmitPort(PORT)
+                .setIntervalSec(INTERVAL)
+                .setRtcpXrBlockTypes(BLOCK_TYPES)
+                .setRtcpMuxEnabled(true)
+                .build();
+
+        assertThat(rtcp1).isNotEqualTo(rtcp6);
+
+        RtcpConfig rtcp7 = new RtcpConfig.Builder()
+                .setCanonicalName(NAME)
+                .setTransmitPort(PORT)
+                .setIntervalSec(INTERVAL)
+                .setRtcpXrBlockTypes(BLOCK_TYPES)
+                .setRtcpReducedSizeEnabled(true)
+                .build();
+
+        assertThat(rtcp1).isNotEqualTo(rtcp7);
     }
 }
@@ -57,6 +57,8 @@ public class VideoConfigTest {
     private static final String IMAGE_PATH =
             "data/user_de/0/com.android.telephony.imsmedia/test.jpg";
     private static final int CVO_VALUE = 1;
+    private static final int TRANSPORT_SEQ_VALUE = 2;
+    private static final int FEC_PAYLOAD_TYPE = 120;
     private static final int DEVICE_ORIENTATION = 0;
     private static final int RTCP_FB_TYPES =
             VideoConfig.RTPFB_NACK | VideoConfig.RTPFB_TMMBR | VideoConfig.RTPFB_TMMBN;
@@ -148,6 +150,8 @@ public class VideoConfigTest {
                 .setDeviceOrientationDegree(DEVICE_ORIENTATION)
                 .setCvoValue(CVO_VALUE)
                 .setRtcpFbTypes(RTCP_FB_TYPES)
+                .setTransportSeqValue(TRANSPORT_SEQ_VALUE)
+                .setFecPayloadType(FEC_PAYLOAD_TYPE)
                 .build();
 
         assertThat(config1).isNotEqualTo(config2);
@@ -181,6 +185,8 @@ public class VideoConfigTest {
                 .setDeviceOrientationDegree(DEVICE_ORIENTATION)
                 .setCvoValue(CVO_VALUE)
                 .setRtcpFbTypes(RTCP_FB_TYPES)
+                .setTransportSeqValue(TRANSPORT_SEQ_VALUE)
+                .setFecPayloadType(FEC_PAYLOAD_TYPE)
                 .build();
     }
 }